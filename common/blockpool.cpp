@@ -0,0 +1,120 @@
+/*
+    Block Pool
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "blockpool.h"
+
+#include <algorithm>
+
+BlockPool::BlockPool(unsigned threads)
+{
+    if (threads == 0)
+        threads = std::min(MAX_THREADS, std::max(1u, std::thread::hardware_concurrency()));
+    m_threads = threads;
+}
+
+BlockPool::~BlockPool()
+{
+    stop();
+}
+
+void BlockPool::run(size_t count, const Job &job, size_t grain)
+{
+    grain = std::max<size_t>(1, grain);
+    size_t blocks = (count + grain - 1) / grain;
+    if (m_threads <= 1 || blocks <= 1)
+    {
+        job(0, count);
+        return;
+    }
+
+    if (m_workers.empty())
+    {
+        m_quit = false;
+        m_generation = 0;
+        for (unsigned i = 1; i < m_threads; i++)
+            m_workers.emplace_back(&BlockPool::workerLoop, this);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &job;
+        m_count = count;
+        m_grain = grain;
+        m_blocks = blocks;
+        m_nextBlock = 0;
+        m_busy = m_workers.size();
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    runBlocks();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this]
+    {
+        return m_busy == 0;
+    });
+    m_job = nullptr;
+}
+
+void BlockPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_wake.notify_all();
+
+    for (auto &worker : m_workers)
+        worker.join();
+    m_workers.clear();
+}
+
+void BlockPool::runBlocks()
+{
+    for (size_t block = m_nextBlock++; block < m_blocks; block = m_nextBlock++)
+    {
+        size_t begin = block * m_grain;
+        (*m_job)(begin, std::min(begin + m_grain, m_count));
+    }
+}
+
+void BlockPool::workerLoop()
+{
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        m_wake.wait(lock, [&]
+        {
+            return m_quit || m_generation != seen;
+        });
+        if (m_quit)
+            return;
+        seen = m_generation;
+
+        lock.unlock();
+        runBlocks();
+        lock.lock();
+
+        if (--m_busy == 0)
+            m_done.notify_one();
+    }
+}
@@ -0,0 +1,80 @@
+/*
+    Block Pool
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Splits a range in blocks across a few worker threads and the calling thread.
+ *
+ * The workers start on the first run() and sleep between runs. run() is not
+ * reentrant, one thread hands out work at a time.
+ */
+class BlockPool
+{
+    public:
+        using Job = std::function<void(size_t begin, size_t end)>;
+
+        static constexpr unsigned MAX_THREADS = 8;
+
+        /** @param threads total threads including the caller, 0 for one per core up to MAX_THREADS. */
+        explicit BlockPool(unsigned threads = 0);
+        ~BlockPool();
+
+        BlockPool(const BlockPool &) = delete;
+        BlockPool &operator=(const BlockPool &) = delete;
+
+        /** Run job over [0, count) in blocks of grain items, return when all are done. */
+        void run(size_t count, const Job &job, size_t grain = 1);
+
+        /** Join the workers, e.g. on disconnect. The next run() starts them again. */
+        void stop();
+
+        unsigned threads() const
+        {
+            return m_threads;
+        }
+
+    private:
+        void runBlocks();
+        void workerLoop();
+
+        unsigned m_threads {1};
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+        const Job *m_job {nullptr};
+        size_t m_count {0};
+        size_t m_grain {1};
+        size_t m_blocks {0};
+        std::atomic<size_t> m_nextBlock {0};
+        size_t m_busy {0};
+        uint64_t m_generation {0};
+        bool m_quit {false};
+};
@@ -0,0 +1,450 @@
+/*
+    Camera Driver Benchmark Harness
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "camerabench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <numeric>
+#include <sys/resource.h>
+#include <thread>
+#include <unistd.h>
+
+namespace CameraBench
+{
+
+void printUsage(const char *prog)
+{
+    fprintf(stderr, "Usage: %s [options]\n\n", prog);
+    fprintf(stderr, "  --width    <px>    Sensor width (default: 1920)\n");
+    fprintf(stderr, "  --height   <px>    Sensor height (default: 1080)\n");
+    fprintf(stderr, "  --bin      <n>     Binning (default: 1)\n");
+    fprintf(stderr, "  --color            Colour sensor with RGB output\n");
+    fprintf(stderr, "  --bits     <8|16>  Sample depth (default: 16)\n");
+    fprintf(stderr, "  --frames   <N>     Timed exposures (default: 10)\n");
+    fprintf(stderr, "  --exposure <s>     Exposure duration (default: 0.01)\n");
+    fprintf(stderr, "  --stream   <s>     Streaming duration, 0 to skip (default: 3)\n");
+    fprintf(stderr, "  --usb      <MB/s>  Simulated link bandwidth, 0 for unlimited (default: 0)\n");
+    fprintf(stderr, "  --json     <path>  Write the JSON report to path instead of stdout\n");
+}
+
+bool parseOptions(int argc, char *argv[], Options &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--width") && hasValue)
+            options.width = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--height") && hasValue)
+            options.height = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--bin") && hasValue)
+            options.bin = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--color"))
+            options.color = true;
+        else if (!strcmp(argv[i], "--bits") && hasValue)
+            options.bitDepth = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--frames") && hasValue)
+            options.frames = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--exposure") && hasValue)
+            options.exposure = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--stream") && hasValue)
+            options.streamSeconds = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--usb") && hasValue)
+            options.usbMBps = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--json") && hasValue)
+            options.json = argv[++i];
+        else
+        {
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+
+    if (options.width <= 0 || options.height <= 0 || options.bin <= 0 || options.frames <= 0 ||
+            options.exposure < 0 || options.streamSeconds < 0 || (options.bitDepth != 8 && options.bitDepth != 16))
+    {
+        printUsage(argv[0]);
+        return false;
+    }
+
+    return true;
+}
+
+double nowMs()
+{
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+long peakRSSKiB()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+void Stats::add(double value)
+{
+    mValues.push_back(value);
+}
+
+double Stats::mean() const
+{
+    if (mValues.empty())
+        return 0;
+    return std::accumulate(mValues.begin(), mValues.end(), 0.0) / mValues.size();
+}
+
+double Stats::min() const
+{
+    return mValues.empty() ? 0 : *std::min_element(mValues.begin(), mValues.end());
+}
+
+double Stats::max() const
+{
+    return mValues.empty() ? 0 : *std::max_element(mValues.begin(), mValues.end());
+}
+
+double Stats::stddev() const
+{
+    if (mValues.empty())
+        return 0;
+    double m = mean();
+    double sq = 0;
+    for (double x : mValues)
+        sq += (x - m) * (x - m);
+    return std::sqrt(sq / mValues.size());
+}
+
+double Stats::percentile(double p) const
+{
+    if (mValues.empty())
+        return 0;
+    std::vector<double> sorted = mValues;
+    std::sort(sorted.begin(), sorted.end());
+    size_t index = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+    return sorted[std::min(sorted.size() - 1, index > 0 ? index - 1 : 0)];
+}
+
+void Recorder::add(const std::string &stage, double ms)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStages[stage].add(ms);
+}
+
+void Recorder::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStages.clear();
+}
+
+std::map<std::string, Stats> Recorder::snapshot() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mStages;
+}
+
+Recorder &recorder()
+{
+    static Recorder instance;
+    return instance;
+}
+
+void Completion::signal()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mSignalled++;
+    }
+    mCondition.notify_all();
+}
+
+bool Completion::wait(double timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    bool done = mCondition.wait_for(lock, std::chrono::duration<double, std::milli>(timeoutMs), [this]
+    {
+        return mSignalled > mConsumed;
+    });
+    if (done)
+        mConsumed++;
+    return done;
+}
+
+void FakeSensor::configure(const Options &options)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mOptions = options;
+    mExposureMs = options.exposure * 1000;
+}
+
+Options FakeSensor::options() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mOptions;
+}
+
+void FakeSensor::setFrameBytes(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mPattern.size() == bytes)
+        return;
+
+    mPattern.resize(bytes);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < bytes; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        mPattern[i] = static_cast<uint8_t>((i / 64) + (seed >> 24));
+    }
+}
+
+size_t FakeSensor::frameBytes() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mPattern.size();
+}
+
+void FakeSensor::setExposureMs(double ms)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mExposureMs = std::max(ms, 0.0);
+}
+
+double FakeSensor::exposureMs() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mExposureMs;
+}
+
+void FakeSensor::startExposure()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mExposureStart = nowMs();
+    mExposing = true;
+}
+
+void FakeSensor::stopExposure()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mExposing = false;
+}
+
+bool FakeSensor::exposing() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mExposing;
+}
+
+bool FakeSensor::exposureDone() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mExposing && nowMs() - mExposureStart >= mExposureMs;
+}
+
+bool FakeSensor::waitExposure(double timeoutMs)
+{
+    double left;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        left = mExposing ? mExposureStart + mExposureMs - nowMs() : timeoutMs + 1;
+    }
+    if (left > timeoutMs)
+    {
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(timeoutMs));
+        return false;
+    }
+    if (left > 0)
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(left));
+    return exposing();
+}
+
+void FakeSensor::startVideo()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCapturing = true;
+    mNextFrame = nowMs() + mExposureMs;
+    mVideoFrames = 0;
+}
+
+void FakeSensor::stopVideo()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCapturing = false;
+}
+
+bool FakeSensor::capturing() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mCapturing;
+}
+
+bool FakeSensor::videoFrameReady() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mCapturing && nowMs() >= mNextFrame;
+}
+
+bool FakeSensor::waitVideoFrame(double timeoutMs)
+{
+    double frameTime;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mCapturing)
+            return false;
+        frameTime = mNextFrame;
+    }
+
+    double wait = frameTime - nowMs();
+    if (wait > timeoutMs)
+    {
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(timeoutMs));
+        return false;
+    }
+    if (wait > 0)
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(wait));
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mCapturing)
+        return false;
+    // A reader that falls behind gets the latest frame, not a backlog
+    mNextFrame = std::max(mNextFrame + mExposureMs, nowMs());
+    return true;
+}
+
+size_t FakeSensor::pull(void *buffer, size_t size, const char *stage)
+{
+    StageTimer timer(stage);
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (size < mPattern.size())
+        return 0;
+
+    double start = nowMs();
+    memcpy(buffer, mPattern.data(), mPattern.size());
+
+    if (mOptions.usbMBps > 0)
+    {
+        double linkMs = mPattern.size() / (mOptions.usbMBps * 1000.0);
+        double left = linkMs - (nowMs() - start);
+        if (left > 0)
+            std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(left));
+    }
+
+    if (mCapturing)
+        mVideoFrames++;
+    mExposing = false;
+    mLastPullEnd = nowMs();
+    return mPattern.size();
+}
+
+double FakeSensor::lastPullEnd() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mLastPullEnd;
+}
+
+uint64_t FakeSensor::videoFrames() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mVideoFrames;
+}
+
+FILE *reportStream(const Options &options)
+{
+    FILE *fp = nullptr;
+    if (options.json.empty())
+    {
+        int fd = dup(STDOUT_FILENO);
+        fp = (fd >= 0) ? fdopen(fd, "w") : nullptr;
+    }
+    else
+        fp = fopen(options.json.c_str(), "w");
+
+    fflush(stdout);
+    int null = open("/dev/null", O_WRONLY);
+    if (null >= 0)
+    {
+        dup2(null, STDOUT_FILENO);
+        close(null);
+    }
+
+    return fp;
+}
+
+static void writeStats(FILE *fp, const char *name, const Stats &stats, bool last)
+{
+    fprintf(fp, "    \"%s\": {\"count\": %zu, \"mean\": %.3f, \"min\": %.3f, \"max\": %.3f, \"stddev\": %.3f, \"p95\": %.3f}%s\n",
+            name, stats.count(), stats.mean(), stats.min(), stats.max(), stats.stddev(), stats.percentile(95),
+            last ? "" : ",");
+}
+
+static std::string escape(const std::string &text)
+{
+    std::string out;
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20)
+            out += c;
+    }
+    return out;
+}
+
+void writeReport(FILE *fp, const Options &options, const Report &report)
+{
+    if (fp == nullptr)
+        return;
+
+    double fps = report.stream.seconds > 0 ? (report.stream.frames - report.stream.dropped) / report.stream.seconds : 0;
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"driver\": \"%s\",\n", escape(report.driver).c_str());
+    fprintf(fp, "  \"camera\": \"%s\",\n", escape(report.camera).c_str());
+    fprintf(fp, "  \"config\": {\"width\": %d, \"height\": %d, \"bin\": %d, \"color\": %s, \"bits\": %d, "
+            "\"exposure_s\": %.6f, \"usb_mbps\": %.1f},\n",
+            options.width, options.height, options.bin, options.color ? "true" : "false", options.bitDepth,
+            options.exposure, options.usbMBps);
+    fprintf(fp, "  \"latency_ms\": {\"count\": %zu, \"mean\": %.3f, \"min\": %.3f, \"max\": %.3f, \"stddev\": %.3f, \"p95\": %.3f},\n",
+            report.latency.count(), report.latency.mean(), report.latency.min(), report.latency.max(),
+            report.latency.stddev(), report.latency.percentile(95));
+    fprintf(fp, "  \"stages_ms\": {\n");
+    size_t n = 0;
+    for (const auto &it : report.stages)
+        writeStats(fp, it.first.c_str(), it.second, ++n == report.stages.size());
+    fprintf(fp, "  },\n");
+    fprintf(fp, "  \"stream\": {\"seconds\": %.3f, \"frames\": %llu, \"dropped\": %llu, \"fps\": %.2f},\n",
+            report.stream.seconds, static_cast<unsigned long long>(report.stream.frames),
+            static_cast<unsigned long long>(report.stream.dropped), fps);
+    fprintf(fp, "  \"peak_rss_kib\": %ld\n", peakRSSKiB());
+    fprintf(fp, "}\n");
+    fflush(fp);
+}
+
+}
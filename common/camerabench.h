@@ -0,0 +1,214 @@
+/*
+    Camera Driver Benchmark Harness
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Offline benchmark harness for the camera drivers.
+//
+// A driver benchmark links the real INDI driver class against a synthetic
+// stand-in for the vendor SDK, runs exposures and a streaming session through
+// the same entry points a client would use, and reports the results as JSON.
+// Fake SDKs and drivers feed per-stage timings into the global recorder().
+namespace CameraBench
+{
+
+struct Options
+{
+    int    width         {1920};
+    int    height        {1080};
+    int    bin           {1};
+    bool   color         {false};
+    int    bitDepth      {16};
+    int    frames        {10};
+    double exposure      {0.01};   // seconds
+    double streamSeconds {3.0};
+    double usbMBps       {0.0};    // simulated link bandwidth, 0 means unlimited
+    std::string json;              // report path, stdout if empty
+};
+
+/** Parse the common command line options. Returns false and prints usage on error. */
+bool parseOptions(int argc, char *argv[], Options &options);
+void printUsage(const char *prog);
+
+/** Milliseconds on a monotonic clock. */
+double nowMs();
+
+/** Peak resident set size of the process in KiB. */
+long peakRSSKiB();
+
+class Stats
+{
+    public:
+        void add(double value);
+
+        size_t count() const
+        {
+            return mValues.size();
+        }
+        double mean() const;
+        double min() const;
+        double max() const;
+        double stddev() const;
+        double percentile(double p) const;
+
+    private:
+        std::vector<double> mValues;
+};
+
+/** Thread-safe collection of named stage durations in milliseconds. */
+class Recorder
+{
+    public:
+        void add(const std::string &stage, double ms);
+        void clear();
+        std::map<std::string, Stats> snapshot() const;
+
+    private:
+        mutable std::mutex mMutex;
+        std::map<std::string, Stats> mStages;
+};
+
+Recorder &recorder();
+
+/** Adds the lifetime of the object to a stage of recorder(). */
+class StageTimer
+{
+    public:
+        explicit StageTimer(const char *stage) : mStage(stage), mStart(nowMs()) {}
+        ~StageTimer()
+        {
+            recorder().add(mStage, nowMs() - mStart);
+        }
+
+    private:
+        const char *mStage;
+        double mStart;
+};
+
+/** Lets the benchmark thread wait for completions signalled from driver threads. */
+class Completion
+{
+    public:
+        void signal();
+        /** Wait for the next signal, false on timeout. */
+        bool wait(double timeoutMs);
+
+    private:
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        uint64_t mSignalled {0};
+        uint64_t mConsumed {0};
+};
+
+/**
+ * Simulated sensor behind the fake vendor SDKs.
+ *
+ * Every frame is the same test pattern, generated once per frame size, so a
+ * pull is a plain copy like a DMA'd USB transfer, paced to the simulated link
+ * bandwidth. Single exposures and free running video are timed against nowMs().
+ * All members are thread-safe.
+ */
+class FakeSensor
+{
+    public:
+        void configure(const Options &options);
+        Options options() const;
+
+        /** Bytes in one frame. The pattern is regenerated when this changes. */
+        void setFrameBytes(size_t bytes);
+        size_t frameBytes() const;
+
+        /** Exposure of a single frame, or the frame period of video, in ms. */
+        void setExposureMs(double ms);
+        double exposureMs() const;
+
+        void startExposure();
+        void stopExposure();
+        bool exposing() const;
+        /** An exposure was started and its time is up. */
+        bool exposureDone() const;
+        /** Wait up to timeoutMs for the running exposure. False on timeout or when none is running. */
+        bool waitExposure(double timeoutMs);
+
+        void startVideo();
+        void stopVideo();
+        bool capturing() const;
+        /** The next video frame is due. */
+        bool videoFrameReady() const;
+        /** Wait up to timeoutMs for the next video frame and take it. False on timeout or when not capturing. */
+        bool waitVideoFrame(double timeoutMs);
+
+        /**
+         * Copy a frame to buffer, paced to the link bandwidth, and add the time to stage.
+         * Ends a single exposure. Returns the bytes copied, 0 if buffer is smaller than a frame.
+         */
+        size_t pull(void *buffer, size_t size, const char *stage);
+        /** When the last pull returned, in nowMs() units. */
+        double lastPullEnd() const;
+        /** Video frames pulled since startVideo(). */
+        uint64_t videoFrames() const;
+
+    private:
+        mutable std::mutex mMutex;
+        Options mOptions;
+        std::vector<uint8_t> mPattern;
+        double mExposureMs {10};
+        double mExposureStart {0};
+        bool mExposing {false};
+        bool mCapturing {false};
+        double mNextFrame {0};
+        double mLastPullEnd {0};
+        uint64_t mVideoFrames {0};
+};
+
+/**
+ * INDI drivers write their XML, including image BLOBs, to stdout. Point
+ * stdout at /dev/null so that output does not mix with the report, and
+ * return a stream for the report itself.
+ */
+FILE *reportStream(const Options &options);
+
+struct StreamResult
+{
+    double seconds {0};
+    uint64_t frames {0};
+    uint64_t dropped {0};
+};
+
+struct Report
+{
+    std::string driver;
+    std::string camera;
+    Stats latency;                          // exposure start to ExposureComplete, ms
+    std::map<std::string, Stats> stages;
+    StreamResult stream;
+};
+
+void writeReport(FILE *fp, const Options &options, const Report &report);
+
+}
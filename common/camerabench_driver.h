@@ -0,0 +1,108 @@
+/*
+    Camera Driver Benchmark Client
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include "camerabench.h"
+
+#include <defaultdevice.h>
+
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// Client side of the driver benchmarks: drives an INDI::CCD the way a client
+// would, through its property handlers, and times the round trips.
+namespace CameraBench
+{
+
+inline bool setNumber(INDI::DefaultDevice &device, const char *property, std::vector<const char *> names,
+                      std::vector<double> values)
+{
+    return device.ISNewNumber(device.getDeviceName(), property, values.data(), const_cast<char **>(names.data()),
+                              static_cast<int>(names.size()));
+}
+
+inline bool setSwitch(INDI::DefaultDevice &device, const char *property, const char *name)
+{
+    ISState state = ISS_ON;
+    char *names[] = {const_cast<char *>(name)};
+    return device.ISNewSwitch(device.getDeviceName(), property, &state, names, 1);
+}
+
+/** Connect the driver and apply the binning of options. */
+inline bool connect(INDI::DefaultDevice &device, const Options &options)
+{
+    device.ISGetProperties(nullptr);
+    if (!device.Connect())
+    {
+        fprintf(stderr, "Failed to connect to the simulated camera.\n");
+        return false;
+    }
+    device.setConnected(true, IPS_OK);
+    device.updateProperties();
+
+    if (options.bin > 1)
+        setNumber(device, "CCD_BINNING", {"HOR_BIN", "VER_BIN"}, {double(options.bin), double(options.bin)});
+    return true;
+}
+
+/**
+ * Take options.frames exposures, each timed from the client request to the end of
+ * ExposureComplete, which the driver reports through completion.
+ */
+inline bool runExposures(INDI::DefaultDevice &device, const Options &options, Completion &completion, Stats &latency)
+{
+    for (int i = 0; i < options.frames; i++)
+    {
+        double start = nowMs();
+        setNumber(device, "CCD_EXPOSURE", {"CCD_EXPOSURE_VALUE"}, {options.exposure});
+        if (!completion.wait(options.exposure * 1000 + 30000))
+        {
+            fprintf(stderr, "Exposure %d timed out.\n", i + 1);
+            return false;
+        }
+        latency.add(nowMs() - start);
+    }
+    return true;
+}
+
+/**
+ * Stream for options.streamSeconds. frames and dropped are read after the stream
+ * is stopped, from the driver or the fake SDK, whichever counts them.
+ */
+inline void runStream(INDI::DefaultDevice &device, const Options &options, StreamResult &result,
+                      const std::function<uint64_t()> &frames, const std::function<uint64_t()> &dropped = nullptr)
+{
+    if (options.streamSeconds <= 0)
+        return;
+
+    double start = nowMs();
+    setSwitch(device, "CCD_VIDEO_STREAM", "STREAM_ON");
+    std::this_thread::sleep_for(std::chrono::duration<double>(options.streamSeconds));
+    setSwitch(device, "CCD_VIDEO_STREAM", "STREAM_OFF");
+
+    result.seconds = (nowMs() - start) / 1000.0;
+    result.frames  = frames();
+    result.dropped = dropped ? dropped() : 0;
+}
+
+}
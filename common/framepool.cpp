@@ -0,0 +1,106 @@
+/*
+    Camera Frame Pool
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "framepool.h"
+
+#include <algorithm>
+#include <unistd.h>
+
+// Weight of the newest frame in the smoothed frame rate and dead time
+#define TIMING_SMOOTHING 0.2
+
+bool FramePool::Frame::reserve(size_t bytes)
+{
+    if (bytes <= m_capacity)
+        return true;
+
+    long pageSize = sysconf(_SC_PAGESIZE);
+    if (pageSize <= 0)
+        pageSize = 4096;
+
+    // Round up so every buffer spans whole pages
+    size_t alignedSize = ((bytes + pageSize - 1) / pageSize) * pageSize;
+    void *buffer = nullptr;
+    if (posix_memalign(&buffer, pageSize, alignedSize) != 0)
+        return false;
+
+    m_data.reset(static_cast<uint8_t *>(buffer));
+    m_capacity = alignedSize;
+    return true;
+}
+
+bool FramePool::reset(size_t frames, size_t frameSize)
+{
+    if (frames != m_frames.size())
+    {
+        m_frames.clear();
+        for (size_t i = 0; i < frames; i++)
+            m_frames.emplace_back(new Frame);
+    }
+
+    // A slot that cannot be allocated stays out of the free list
+    bool allocated = true;
+    std::vector<Frame *> slots;
+    for (auto &frame : m_frames)
+    {
+        if (frame->reserve(frameSize))
+            slots.push_back(frame.get());
+        else
+            allocated = false;
+    }
+    m_queue.reset(slots);
+    m_frameSize = frameSize;
+    return allocated;
+}
+
+void FramePool::clear()
+{
+    m_queue.reset({});
+    m_frames.clear();
+    m_frameSize = 0;
+}
+
+void FrameTiming::reset()
+{
+    m_last = 0;
+    m_interval = 0;
+    m_deadTime = 0;
+    m_frames = 0;
+}
+
+void FrameTiming::add(double timestamp, double exposure)
+{
+    if (m_frames++ > 0 && timestamp > m_last)
+    {
+        double interval = timestamp - m_last;
+        double deadTime = std::max(0.0, interval - exposure);
+        if (m_frames == 2)
+        {
+            m_interval = interval;
+            m_deadTime = deadTime;
+        }
+        else
+        {
+            m_interval += TIMING_SMOOTHING * (interval - m_interval);
+            m_deadTime += TIMING_SMOOTHING * (deadTime - m_deadTime);
+        }
+    }
+    m_last = timestamp;
+}
@@ -0,0 +1,329 @@
+/*
+    Camera Frame Pool
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Which frame acquire() gives up when no slot is free, see FrameQueue
+class FramePolicy
+{
+    public:
+        enum Policy
+        {
+            DROP_NEWEST,
+            DROP_OLDEST
+        };
+};
+
+// Frame hand-off between the stages of a camera driver, shared by the drivers.
+//
+// The producer takes a free slot with acquire(), fills it and publish()es it.
+// The consumer takes the oldest published slot with next() and recycle()s it
+// when done. When no slot is free, the policy decides which frame is lost:
+// DROP_OLDEST takes back the oldest published slot, so a stream shows the
+// newest frames and the producer never stalls; DROP_NEWEST waits up to the
+// given timeout, then gives up on the new frame.
+template <typename T>
+class FrameQueue : public FramePolicy
+{
+    public:
+        explicit FrameQueue(Policy policy = DROP_NEWEST) : m_policy(policy) {}
+
+        /** Hand the slots to the queue, all of them start out free. */
+        void reset(const std::vector<T> &slots)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_free.assign(slots.begin(), slots.end());
+            m_ready.clear();
+            m_closed = false;
+            m_aborted = false;
+            m_published = 0;
+            m_dropped = 0;
+        }
+
+        /** Producer: a slot to fill. @return false when the frame has to be dropped. */
+        bool acquire(T &slot, int timeoutMs = 0)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (m_policy == DROP_NEWEST && timeoutMs > 0)
+                m_freeCV.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]
+            {
+                return !m_free.empty();
+            });
+
+            if (!m_free.empty())
+            {
+                slot = m_free.front();
+                m_free.pop_front();
+                return true;
+            }
+            m_dropped++;
+            if (m_policy == DROP_OLDEST && !m_ready.empty())
+            {
+                slot = m_ready.front();
+                m_ready.pop_front();
+                return true;
+            }
+            return false;
+        }
+
+        /** Producer: queue a filled slot. */
+        void publish(T slot)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_ready.push_back(slot);
+                m_published++;
+            }
+            m_readyCV.notify_one();
+        }
+
+        /** Return a slot to the free list, used or not. */
+        void recycle(T slot)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_free.push_back(slot);
+            }
+            m_freeCV.notify_one();
+        }
+
+        /**
+         * Consumer: the oldest published slot.
+         * @param timeoutMs negative waits until a slot is published or the queue is stopped.
+         * @return false after the timeout, or once the queue is closed and drained, or aborted.
+         */
+        bool next(T &slot, int timeoutMs = -1)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            auto ready = [this]
+            {
+                return m_aborted || m_closed || !m_ready.empty();
+            };
+            if (timeoutMs < 0)
+                m_readyCV.wait(lock, ready);
+            else
+                m_readyCV.wait_for(lock, std::chrono::milliseconds(timeoutMs), ready);
+
+            if (m_aborted || m_ready.empty())
+                return false;
+            slot = m_ready.front();
+            m_ready.pop_front();
+            return true;
+        }
+
+        /** Let the consumer drain the published slots, then make next() fail. */
+        void close()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_closed = true;
+            }
+            m_readyCV.notify_all();
+        }
+
+        /** Take back the published slots and make next() fail right away. */
+        void abort()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_aborted = true;
+                for (auto &slot : m_ready)
+                    m_free.push_back(slot);
+                m_ready.clear();
+            }
+            m_readyCV.notify_all();
+            m_freeCV.notify_all();
+        }
+
+        /** Published slots waiting for the consumer. */
+        size_t depth() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_ready.size();
+        }
+        /** Frames published since reset(). */
+        uint64_t published() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_published;
+        }
+        /** Frames lost in acquire() since reset(). */
+        uint64_t dropped() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_dropped;
+        }
+
+    private:
+        Policy m_policy;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_readyCV;
+        std::condition_variable m_freeCV;
+        std::deque<T> m_free;
+        std::deque<T> m_ready;
+        bool m_closed {false};
+        bool m_aborted {false};
+        uint64_t m_published {0};
+        uint64_t m_dropped {0};
+};
+
+/**
+ * Page-aligned frame buffers owned by the pool and passed through a FrameQueue.
+ *
+ * Frames are never copied between stages: the producer reads straight into a
+ * pool buffer and the consumer publishes that same buffer before recycling it.
+ */
+class FramePool : public FramePolicy
+{
+    public:
+        class Frame
+        {
+            public:
+                uint8_t *data()
+                {
+                    return m_data.get();
+                }
+                size_t capacity() const
+                {
+                    return m_capacity;
+                }
+                /** Grow to at least bytes, the content is not kept. @return false if out of memory. */
+                bool reserve(size_t bytes);
+
+                size_t size {0};
+                // Time the frame started or completed, see the producer
+                double timestamp {0};
+                // Latency of the exposure download and of the hand-off to the pool, in seconds
+                double download {0};
+                double handoff {0};
+                // Unbinned subframe and binning the frame was taken with, when they may change before it is sent
+                int subX {0}, subY {0}, subW {0}, subH {0}, binX {1}, binY {1};
+
+            private:
+                std::unique_ptr<uint8_t, void (*)(void *)> m_data {nullptr, free};
+                size_t m_capacity {0};
+        };
+
+        explicit FramePool(Policy policy = DROP_NEWEST) : m_queue(policy) {}
+
+        /**
+         * Make frames slots of at least frameSize bytes available, dropping queued frames.
+         * Frames of a previous reset() with the same count are reused.
+         * @return false if a slot could not be allocated, the others are still usable.
+         */
+        bool reset(size_t frames, size_t frameSize);
+        /** Free the memory of every slot, nothing may hold a frame. */
+        void clear();
+
+        /** @return a free slot to fill, or nullptr when the frame has to be dropped. */
+        Frame *acquire(int timeoutMs = 0)
+        {
+            Frame *frame = nullptr;
+            return m_queue.acquire(frame, timeoutMs) ? frame : nullptr;
+        }
+        void publish(Frame *frame)
+        {
+            m_queue.publish(frame);
+        }
+        void recycle(Frame *frame)
+        {
+            m_queue.recycle(frame);
+        }
+        /** @return the oldest published frame, nullptr after timeoutMs or once stopped, see FrameQueue::next(). */
+        Frame *next(int timeoutMs = -1)
+        {
+            Frame *frame = nullptr;
+            return m_queue.next(frame, timeoutMs) ? frame : nullptr;
+        }
+        void close()
+        {
+            m_queue.close();
+        }
+        void abort()
+        {
+            m_queue.abort();
+        }
+
+        size_t frameSize() const
+        {
+            return m_frameSize;
+        }
+        size_t depth() const
+        {
+            return m_queue.depth();
+        }
+        uint64_t published() const
+        {
+            return m_queue.published();
+        }
+        uint64_t dropped() const
+        {
+            return m_queue.dropped();
+        }
+
+    private:
+        std::vector<std::unique_ptr<Frame>> m_frames;
+        FrameQueue<Frame *> m_queue;
+        size_t m_frameSize {0};
+};
+
+/**
+ * Frame rate and dead time of a stream or a sequence of exposures.
+ *
+ * add() takes the time each frame completed and its exposure. The dead time is
+ * the part of the interval between two frames that was not spent integrating.
+ * Both values are smoothed over the last few frames.
+ */
+class FrameTiming
+{
+    public:
+        void reset();
+        void add(double timestamp, double exposure);
+
+        double frameRate() const
+        {
+            return m_interval > 0 ? 1.0 / m_interval : 0;
+        }
+        /** Dead time between frames in seconds. */
+        double deadTime() const
+        {
+            return m_deadTime;
+        }
+        uint64_t frames() const
+        {
+            return m_frames;
+        }
+
+    private:
+        double m_last {0};
+        double m_interval {0};
+        double m_deadTime {0};
+        uint64_t m_frames {0};
+};
@@ -0,0 +1,302 @@
+/*
+    Background HTTP Poller
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "httppoller.h"
+
+#include <curl/curl.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <strings.h>
+
+// curl_multi_poll() and curl_multi_wakeup() arrived in 7.68, older versions wait in short slices
+#if LIBCURL_VERSION_NUM >= 0x074400
+#define HTTPPOLLER_HAVE_WAKEUP
+#endif
+
+namespace
+{
+
+std::once_flag curlInitOnce;
+
+std::string trim(const char *data, size_t len)
+{
+    size_t start = 0;
+    while (start < len && isspace(static_cast<unsigned char>(data[start])))
+        start++;
+    while (len > start && isspace(static_cast<unsigned char>(data[len - 1])))
+        len--;
+    return std::string(data + start, len - start);
+}
+
+// Value of header line if it is the named header, compared without regard to case
+bool headerValue(const char *line, size_t len, const char *name, std::string &value)
+{
+    size_t nameLen = strlen(name);
+    if (len <= nameLen || line[nameLen] != ':' || strncasecmp(line, name, nameLen) != 0)
+        return false;
+    value = trim(line + nameLen + 1, len - nameLen - 1);
+    return true;
+}
+
+}
+
+HttpPoller::HttpPoller(Handler handler, long timeoutMs) : mHandler(std::move(handler)), mTimeoutMs(timeoutMs)
+{
+    std::call_once(curlInitOnce, []()
+    {
+        curl_global_init(CURL_GLOBAL_DEFAULT);
+    });
+}
+
+HttpPoller::~HttpPoller()
+{
+    stop();
+}
+
+void HttpPoller::start()
+{
+    if (mThread.joinable())
+        return;
+
+    CURL *easy = curl_easy_init();
+    curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, mTimeoutMs);
+    curl_easy_setopt(easy, CURLOPT_CONNECTTIMEOUT_MS, std::min(mTimeoutMs, 5000L));
+    curl_easy_setopt(easy, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(easy, CURLOPT_ACCEPT_ENCODING, "");
+    curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, writeCallback);
+    curl_easy_setopt(easy, CURLOPT_WRITEDATA, this);
+    curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION, headerCallback);
+    curl_easy_setopt(easy, CURLOPT_HEADERDATA, this);
+    mEasy = easy;
+    mMulti = curl_multi_init();
+
+    mRunning = true;
+    mThread = std::thread(&HttpPoller::workerLoop, this);
+}
+
+void HttpPoller::stop()
+{
+    if (!mThread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mRunning = false;
+    }
+    mCondition.notify_all();
+#ifdef HTTPPOLLER_HAVE_WAKEUP
+    curl_multi_wakeup(static_cast<CURLM *>(mMulti));
+#endif
+    mThread.join();
+
+    curl_multi_cleanup(static_cast<CURLM *>(mMulti));
+    curl_easy_cleanup(static_cast<CURL *>(mEasy));
+    mMulti = nullptr;
+    mEasy = nullptr;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPending.clear();
+    mBusy = false;
+}
+
+bool HttpPoller::request(const std::string &url)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mRunning || mBusy)
+            return false;
+        mPending = url;
+        mBusy = true;
+    }
+    mCondition.notify_one();
+    return true;
+}
+
+bool HttpPoller::busy() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mBusy;
+}
+
+HttpPoller::Stats HttpPoller::stats() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mStats;
+}
+
+void HttpPoller::workerLoop()
+{
+    while (true)
+    {
+        std::string url;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this]()
+            {
+                return !mRunning || !mPending.empty();
+            });
+            if (!mRunning)
+                return;
+            url.swap(mPending);
+        }
+
+        Response response;
+        response.url = url;
+        perform(url, response);
+        // Stopped in the middle of the request, nobody is waiting for the result
+        if (!mRunning)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStats.requests++;
+            if (!response.error.empty())
+                mStats.failures++;
+            else if (!response.modified)
+                mStats.notModified++;
+            if (response.status != 0 && !response.reused)
+                mStats.connections++;
+            mStats.lastMs = response.latencyMs;
+            mStats.averageMs += (response.latencyMs - mStats.averageMs) / mStats.requests;
+            mStats.maxMs = std::max(mStats.maxMs, response.latencyMs);
+        }
+
+        // Deliver before clearing busy, so the result is there once the poller reports idle
+        mHandler(response);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mBusy = false;
+    }
+}
+
+void HttpPoller::perform(const std::string &url, Response &response)
+{
+    CURL *easy = static_cast<CURL *>(mEasy);
+    CURLM *multi = static_cast<CURLM *>(mMulti);
+    Validators &known = mValidators[url];
+
+    struct curl_slist *headers = nullptr;
+    if (known.valid && !known.etag.empty())
+        headers = curl_slist_append(headers, ("If-None-Match: " + known.etag).c_str());
+    if (known.valid && !known.lastModified.empty())
+        headers = curl_slist_append(headers, ("If-Modified-Since: " + known.lastModified).c_str());
+
+    curl_easy_setopt(easy, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(easy, CURLOPT_HTTPHEADER, headers);
+    mBody.clear();
+    mReply = Validators();
+
+    curl_multi_add_handle(multi, easy);
+    int running = 1;
+    while (running > 0 && mRunning)
+    {
+        CURLMcode code = curl_multi_perform(multi, &running);
+        if (code != CURLM_OK)
+        {
+            response.error = curl_multi_strerror(code);
+            break;
+        }
+        if (running > 0)
+#ifdef HTTPPOLLER_HAVE_WAKEUP
+            curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+#else
+            curl_multi_wait(multi, nullptr, 0, 100, nullptr);
+#endif
+    }
+
+    bool done = false;
+    CURLcode result = CURLE_OK;
+    int queued = 0;
+    while (CURLMsg *message = curl_multi_info_read(multi, &queued))
+    {
+        if (message->msg == CURLMSG_DONE)
+        {
+            done = true;
+            result = message->data.result;
+        }
+    }
+    curl_multi_remove_handle(multi, easy);
+    curl_easy_setopt(easy, CURLOPT_HTTPHEADER, nullptr);
+    curl_slist_free_all(headers);
+
+    if (!done)
+    {
+        if (response.error.empty())
+            response.error = "Request aborted";
+        return;
+    }
+
+    curl_off_t totalUs = 0;
+    long connects = 0;
+    curl_easy_getinfo(easy, CURLINFO_TOTAL_TIME_T, &totalUs);
+    curl_easy_getinfo(easy, CURLINFO_NUM_CONNECTS, &connects);
+    curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &response.status);
+    response.latencyMs = totalUs / 1000.0;
+    response.reused = connects == 0;
+
+    if (result != CURLE_OK)
+    {
+        response.error = curl_easy_strerror(result);
+        return;
+    }
+    if (response.status == 304)
+        return;
+    if (response.status < 200 || response.status >= 300)
+    {
+        response.error = "HTTP status " + std::to_string(response.status);
+        return;
+    }
+
+    // Servers without validators still get the unchanged body detected
+    size_t hash = std::hash<std::string>()(mBody);
+    response.modified = !known.valid || known.bodyHash != hash;
+    known = mReply;
+    known.bodyHash = hash;
+    known.valid = true;
+    if (response.modified)
+        response.body.swap(mBody);
+}
+
+size_t HttpPoller::writeCallback(char *data, size_t size, size_t nmemb, void *userp)
+{
+    HttpPoller *poller = static_cast<HttpPoller *>(userp);
+    poller->mBody.append(data, size * nmemb);
+    return size * nmemb;
+}
+
+size_t HttpPoller::headerCallback(char *data, size_t size, size_t nmemb, void *userp)
+{
+    HttpPoller *poller = static_cast<HttpPoller *>(userp);
+    size_t len = size * nmemb;
+
+    // A new status line starts the headers of a redirect target or final reply
+    if (len >= 5 && strncmp(data, "HTTP/", 5) == 0)
+        poller->mReply = Validators();
+    else
+    {
+        headerValue(data, len, "ETag", poller->mReply.etag);
+        headerValue(data, len, "Last-Modified", poller->mReply.lastModified);
+    }
+    return len;
+}
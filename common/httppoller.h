@@ -0,0 +1,212 @@
+/*
+    Background HTTP Poller
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Non-blocking HTTP polling shared by the network weather drivers.
+//
+// Requests run on a worker thread through the libcurl multi interface, so the
+// INDI event loop never waits on the network. One easy handle is kept for the
+// lifetime of the poller and libcurl reuses its connection between requests.
+// Each URL remembers the ETag and Last-Modified validators of its last reply
+// and sends them back as If-None-Match / If-Modified-Since; a 304 reply, or a
+// 200 reply with the same body as before, is reported as not modified so the
+// driver can skip parsing it.
+class HttpPoller
+{
+    public:
+        struct Response
+        {
+            std::string url;
+            long status {0};            // HTTP status, 0 if no reply was received
+            bool modified {false};      // false for 304 or an unchanged body
+            bool reused {false};        // served over an already open connection
+            double latencyMs {0};       // request start to last byte
+            std::string error;          // empty on success
+            std::string body;           // only filled when modified
+        };
+
+        struct Stats
+        {
+            uint64_t requests {0};
+            uint64_t notModified {0};
+            uint64_t failures {0};
+            uint64_t connections {0};   // connections opened
+            double lastMs {0};
+            double averageMs {0};
+            double maxMs {0};
+        };
+
+        /** Called on the worker thread for every finished request. */
+        using Handler = std::function<void(Response &response)>;
+
+        explicit HttpPoller(Handler handler, long timeoutMs = 10000);
+        ~HttpPoller();
+
+        void start();
+        /** Abort the running request, if any, and join the worker thread. */
+        void stop();
+
+        /**
+         * @brief request Queue a GET of url.
+         * @return false if the poller is not running or a request is already queued or running.
+         */
+        bool request(const std::string &url);
+
+        /** @return true while a request is queued or running. */
+        bool busy() const;
+
+        Stats stats() const;
+
+    private:
+        void workerLoop();
+        void perform(const std::string &url, Response &response);
+        static size_t writeCallback(char *data, size_t size, size_t nmemb, void *userp);
+        static size_t headerCallback(char *data, size_t size, size_t nmemb, void *userp);
+
+        struct Validators
+        {
+            std::string etag;
+            std::string lastModified;
+            size_t bodyHash {0};
+            bool valid {false};
+        };
+
+        Handler mHandler;
+        long mTimeoutMs;
+
+        void *mMulti {nullptr};
+        void *mEasy {nullptr};
+        std::map<std::string, Validators> mValidators;
+
+        // Reply being received, only touched by the worker thread
+        std::string mBody;
+        Validators mReply;
+
+        std::thread mThread;
+        std::atomic<bool> mRunning {false};
+        mutable std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::string mPending;
+        bool mBusy {false};
+        Stats mStats;
+};
+
+/**
+ * Typed view on an HttpPoller.
+ *
+ * Modified bodies are parsed on the worker thread and the latest result is kept
+ * until the driver collects it with take() on its own thread.
+ */
+template <typename T>
+class HttpFeed
+{
+    public:
+        /** Fill value from body, or set error and return false. Runs on the worker thread. */
+        using Parser = std::function<bool(const std::string &body, T &value, std::string &error)>;
+
+        struct Result
+        {
+            long status {0};
+            bool modified {false};
+            double latencyMs {0};
+            std::string error;
+            std::shared_ptr<const T> value;     // set when modified and parsed
+        };
+
+        explicit HttpFeed(Parser parser, long timeoutMs = 10000)
+            : mParser(std::move(parser)), mPoller([this](HttpPoller::Response & response)
+        {
+            onResponse(response);
+        }, timeoutMs)
+        {
+        }
+
+        void start()
+        {
+            mPoller.start();
+        }
+        void stop()
+        {
+            mPoller.stop();
+            std::lock_guard<std::mutex> lock(mMutex);
+            mReady = false;
+        }
+        bool request(const std::string &url)
+        {
+            return mPoller.request(url);
+        }
+        bool busy() const
+        {
+            return mPoller.busy();
+        }
+        HttpPoller::Stats stats() const
+        {
+            return mPoller.stats();
+        }
+
+        /** @return true and the latest result if one arrived since the last call. */
+        bool take(Result &result)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (!mReady)
+                return false;
+            result = std::move(mResult);
+            mReady = false;
+            return true;
+        }
+
+    private:
+        void onResponse(HttpPoller::Response &response)
+        {
+            Result result;
+            result.status = response.status;
+            result.modified = response.modified;
+            result.latencyMs = response.latencyMs;
+            result.error = response.error;
+            if (result.error.empty() && result.modified)
+            {
+                auto value = std::make_shared<T>();
+                if (mParser(response.body, *value, result.error))
+                    result.value = value;
+            }
+
+            std::lock_guard<std::mutex> lock(mMutex);
+            mResult = std::move(result);
+            mReady = true;
+        }
+
+        Parser mParser;
+        std::mutex mMutex;
+        Result mResult;
+        bool mReady {false};
+        // Last, so the worker thread is stopped before the members above go away
+        HttpPoller mPoller;
+};
@@ -0,0 +1,223 @@
+/*
+    Scaled JPEG Decoder
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "jpegdecode.h"
+#include "pixelconvert.h"
+
+#include <csetjmp>
+#include <cstdio>
+
+#ifdef HAVE_TURBOJPEG
+#include <turbojpeg.h>
+#else
+#include <jpeglib.h>
+#endif
+
+#ifdef HAVE_TURBOJPEG
+
+struct JpegDecoder::Private
+{
+    tjhandle handle {nullptr};
+};
+
+JpegDecoder::JpegDecoder() : d(new Private)
+{
+    d->handle = tjInitDecompress();
+}
+
+JpegDecoder::~JpegDecoder()
+{
+    if (d->handle)
+        tjDestroy(d->handle);
+}
+
+bool JpegDecoder::readHeader(const uint8_t *data, size_t size, int scale, Info &info)
+{
+    int width = 0, height = 0, subsampling = 0, colorspace = 0;
+    if (d->handle == nullptr)
+    {
+        m_Error = "TurboJPEG decompressor is not available";
+        return false;
+    }
+    if (tjDecompressHeader3(d->handle, data, size, &width, &height, &subsampling, &colorspace) != 0)
+    {
+        m_Error = tjGetErrorStr2(d->handle);
+        return false;
+    }
+
+    tjscalingfactor factor = { 1, scale };
+    info.width    = TJSCALED(width, factor);
+    info.height   = TJSCALED(height, factor);
+    info.channels = colorspace == TJCS_GRAY ? 1 : 3;
+    return true;
+}
+
+bool JpegDecoder::decode(const uint8_t *data, size_t size, int scale, Layout layout, uint8_t *dst)
+{
+    Info info;
+    if (!readHeader(data, size, scale, info))
+        return false;
+
+    bool planar = layout == PLANAR && info.channels == 3;
+    if (planar)
+        m_Scratch.resize(info.size());
+
+    uint8_t *out = planar ? m_Scratch.data() : dst;
+    // TurboJPEG picks the DCT scaling factor that yields the requested size
+    if (tjDecompress2(d->handle, data, size, out, info.width, 0, info.height, info.channels == 1 ? TJPF_GRAY : TJPF_RGB,
+                      0) != 0)
+    {
+        m_Error = tjGetErrorStr2(d->handle);
+        return false;
+    }
+
+    if (planar)
+        PixelConvert::deinterleave8(out, dst, static_cast<size_t>(info.width) * info.height, 3, PixelConvert::ORDER_RGB);
+    return true;
+}
+
+const char *JpegDecoder::backend()
+{
+    return "TurboJPEG";
+}
+
+#else
+
+namespace
+{
+// libjpeg reports fatal errors through error_exit, which must not return
+struct ErrorManager
+{
+    jpeg_error_mgr pub;
+    jmp_buf jump;
+    char message[JMSG_LENGTH_MAX];
+};
+
+void errorExit(j_common_ptr cinfo)
+{
+    ErrorManager *err = reinterpret_cast<ErrorManager *>(cinfo->err);
+    (*cinfo->err->format_message)(cinfo, err->message);
+    longjmp(err->jump, 1);
+}
+
+// Corrupt data warnings are not printed to stderr, a damaged frame is still shown
+void outputMessage(j_common_ptr)
+{
+}
+}
+
+struct JpegDecoder::Private
+{
+    jpeg_decompress_struct cinfo;
+    ErrorManager err;
+    std::vector<JSAMPROW> rows;
+};
+
+JpegDecoder::JpegDecoder() : d(new Private)
+{
+    d->cinfo.err = jpeg_std_error(&d->err.pub);
+    d->err.pub.error_exit     = errorExit;
+    d->err.pub.output_message = outputMessage;
+    jpeg_create_decompress(&d->cinfo);
+}
+
+JpegDecoder::~JpegDecoder()
+{
+    jpeg_destroy_decompress(&d->cinfo);
+}
+
+bool JpegDecoder::readHeader(const uint8_t *data, size_t size, int scale, Info &info)
+{
+    jpeg_decompress_struct *cinfo = &d->cinfo;
+    if (setjmp(d->err.jump))
+    {
+        m_Error = d->err.message;
+        jpeg_abort_decompress(cinfo);
+        return false;
+    }
+
+    // Back to the start state, also after a previous readHeader() without decode()
+    jpeg_abort_decompress(cinfo);
+    jpeg_mem_src(cinfo, const_cast<unsigned char *>(data), size);
+    jpeg_read_header(cinfo, TRUE);
+    cinfo->scale_num   = 1;
+    cinfo->scale_denom = scale;
+    if (cinfo->jpeg_color_space != JCS_GRAYSCALE)
+        cinfo->out_color_space = JCS_RGB;
+    jpeg_calc_output_dimensions(cinfo);
+
+    info.width    = cinfo->output_width;
+    info.height   = cinfo->output_height;
+    info.channels = cinfo->output_components;
+    return true;
+}
+
+bool JpegDecoder::decode(const uint8_t *data, size_t size, int scale, Layout layout, uint8_t *dst)
+{
+    Info info;
+    if (!readHeader(data, size, scale, info))
+        return false;
+
+    jpeg_decompress_struct *cinfo = &d->cinfo;
+    bool planar = layout == PLANAR && info.channels == 3;
+    if (planar)
+        m_Scratch.resize(info.size());
+    uint8_t *out = planar ? m_Scratch.data() : dst;
+
+    if (setjmp(d->err.jump))
+    {
+        m_Error = d->err.message;
+        jpeg_abort_decompress(cinfo);
+        return false;
+    }
+
+    jpeg_start_decompress(cinfo);
+
+    // Scanlines go straight to their place in the output, as many per call as libjpeg hands out
+    size_t stride = static_cast<size_t>(cinfo->output_width) * cinfo->output_components;
+    d->rows.resize(cinfo->output_height);
+    for (JDIMENSION row = 0; row < cinfo->output_height; row++)
+        d->rows[row] = out + row * stride;
+    while (cinfo->output_scanline < cinfo->output_height)
+        jpeg_read_scanlines(cinfo, d->rows.data() + cinfo->output_scanline, cinfo->output_height - cinfo->output_scanline);
+
+    jpeg_finish_decompress(cinfo);
+
+    if (planar)
+        PixelConvert::deinterleave8(out, dst, static_cast<size_t>(info.width) * info.height, 3, PixelConvert::ORDER_RGB);
+    return true;
+}
+
+const char *JpegDecoder::backend()
+{
+    return "libjpeg";
+}
+
+#endif
+
+int JpegDecoder::scaleFor(int width, int targetWidth)
+{
+    int scale = 1;
+    if (targetWidth <= 0)
+        return scale;
+    while (scale < 8 && (width + scale * 2 - 1) / (scale * 2) >= targetWidth)
+        scale *= 2;
+    return scale;
+}
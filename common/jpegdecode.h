@@ -0,0 +1,107 @@
+/*
+    Scaled JPEG Decoder
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// JPEG decoding shared by the DSLR drivers.
+//
+// A JPEG held in memory is decoded straight into the caller's buffer, either
+// interleaved for streaming or split into the R, G, B planes that FITS
+// expects, and may be scaled down by 2, 4 or 8 in the DCT domain, which costs
+// a fraction of a full decode. The TurboJPEG API is used when the build found
+// it (HAVE_TURBOJPEG), libjpeg otherwise. Keep one decoder per stream: the
+// decompressor and its scratch buffer are reused from frame to frame.
+class JpegDecoder
+{
+    public:
+        enum Layout
+        {
+            INTERLEAVED,        // RGBRGB...
+            PLANAR              // RR...GG...BB...
+        };
+
+        struct Info
+        {
+            int width {0};      // after scaling
+            int height {0};
+            int channels {0};   // 1 for grayscale, otherwise 3
+
+            size_t size() const
+            {
+                return static_cast<size_t>(width) * height * channels;
+            }
+        };
+
+        JpegDecoder();
+        ~JpegDecoder();
+        JpegDecoder(const JpegDecoder &) = delete;
+        JpegDecoder &operator=(const JpegDecoder &) = delete;
+
+        /**
+         * @brief readHeader Get the size of data once decoded at scale.
+         * @param scale 1, 2, 4 or 8, the image is decoded at 1/scale of its size.
+         */
+        bool readHeader(const uint8_t *data, size_t size, int scale, Info &info);
+
+        /**
+         * @brief decode Decode data into dst.
+         * @param dst holds at least the size() given by readHeader() for the same scale.
+         */
+        bool decode(const uint8_t *data, size_t size, int scale, Layout layout, uint8_t *dst);
+
+        /** @brief scaleFor Largest of 1, 2, 4, 8 that keeps width at least targetWidth, 1 if targetWidth is not positive. */
+        static int scaleFor(int width, int targetWidth);
+
+        /** @brief backend "TurboJPEG" or "libjpeg". */
+        static const char *backend();
+
+        /** @brief lastError Reason the last readHeader() or decode() failed. */
+        const std::string &lastError() const
+        {
+            return m_Error;
+        }
+
+    private:
+        struct Private;
+        std::unique_ptr<Private> d;
+        std::vector<uint8_t> m_Scratch;
+        std::string m_Error;
+};
+
+// Decoding into INDI shared blob buffers for the DSLR drivers, in jpegdecode_blob.cpp.
+// *memptr is reallocated to the decoded size, the functions return 0 on success.
+
+/** @brief jpeg_set_debug Device the decoding errors are logged for. */
+void jpeg_set_debug(const char *name);
+/** @brief read_jpeg Decode a JPEG file into R, G, B planes. */
+int read_jpeg(const char *filename, uint8_t **memptr, size_t *memsize, int *naxis, int *w, int *h);
+/** @brief read_jpeg_buffer Same as read_jpeg() for a JPEG file held in memory. */
+int read_jpeg_buffer(const uint8_t *data, size_t size, uint8_t **memptr, size_t *memsize, int *naxis, int *w, int *h);
+/** @brief read_jpeg_mem Decode a JPEG held in memory, interleaved for streaming. */
+int read_jpeg_mem(unsigned char *inBuffer, unsigned long inSize, uint8_t **memptr, size_t *memsize, int *naxis, int *w,
+                  int *h);
+/** @brief read_jpeg_size Size of a JPEG held in memory. */
+int read_jpeg_size(unsigned char *inBuffer, unsigned long inSize, int *w, int *h);
@@ -0,0 +1,271 @@
+/*
+ JPEG Decode Benchmark
+
+ Compares JpegDecoder with the scanline loops of gphoto_readimage.cpp that
+ the gphoto and pentax drivers used before: read_jpeg_mem() for live view
+ (interleaved, one malloc'd row per frame) and read_jpeg() for captures
+ (planar, split by hand pixel by pixel). A synthetic JPEG is encoded once and
+ decoded repeatedly; JpegDecoder is also run at the 1/2, 1/4 and 1/8 DCT
+ scales. Full size output is checked against the old code.
+
+ Usage:
+   ./jpegdecode_bench [--width <px>] [--height <px>] [--quality <q>] [--iterations <N>]
+
+ Options:
+   --width      <px>  Image width (default: 1024, a typical live view frame)
+   --height     <px>  Image height (default: 680)
+   --quality    <q>   JPEG quality of the synthetic image (default: 90)
+   --iterations <N>   Decodes per case, best time is reported (default: 50)
+
+ Exit status is non-zero if full size output differs from the old code.
+
+ Copyright (C) 2026 agent (agent@local)
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "jpegdecode.h"
+
+#include <jpeglib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+static void printUsage(const char *prog)
+{
+    printf("Usage: %s [--width <px>] [--height <px>] [--quality <q>] [--iterations <N>]\n\n", prog);
+    printf("  --width      <px>  Image width (default: 1024)\n");
+    printf("  --height     <px>  Image height (default: 680)\n");
+    printf("  --quality    <q>   JPEG quality of the synthetic image (default: 90)\n");
+    printf("  --iterations <N>   Decodes per case (default: 50)\n");
+}
+
+// Best wall time of fn over iterations runs, in milliseconds.
+static double bestOf(int iterations, const std::function<void()> &fn)
+{
+    double best = 1e12;
+    for (int i = 0; i < iterations; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+// Smooth gradients with some texture, so the DCT has work to do.
+static std::vector<uint8_t> encodeSynthetic(int width, int height, int quality)
+{
+    std::vector<uint8_t> rgb(static_cast<size_t>(width) * height * 3);
+    for (int y = 0; y < height; y++)
+        for (int x = 0; x < width; x++)
+        {
+            uint8_t *p = &rgb[(static_cast<size_t>(y) * width + x) * 3];
+            unsigned noise = (x * 2654435761u ^ y * 40503u) >> 27;
+            p[0] = static_cast<uint8_t>(x * 255 / width + noise);
+            p[1] = static_cast<uint8_t>(y * 255 / height + noise);
+            p[2] = static_cast<uint8_t>(((x / 16 + y / 16) % 2) * 128 + noise);
+        }
+
+    jpeg_compress_struct cinfo;
+    jpeg_error_mgr jerr;
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_compress(&cinfo);
+    unsigned char *out = nullptr;
+    unsigned long outSize = 0;
+    jpeg_mem_dest(&cinfo, &out, &outSize);
+    cinfo.image_width      = width;
+    cinfo.image_height     = height;
+    cinfo.input_components = 3;
+    cinfo.in_color_space   = JCS_RGB;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, quality, TRUE);
+    jpeg_start_compress(&cinfo, TRUE);
+    while (cinfo.next_scanline < cinfo.image_height)
+    {
+        JSAMPROW row = &rgb[static_cast<size_t>(cinfo.next_scanline) * width * 3];
+        jpeg_write_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+
+    std::vector<uint8_t> jpeg(out, out + outSize);
+    free(out);
+    return jpeg;
+}
+
+// read_jpeg_mem() as it was, with realloc standing in for IDSharedBlobRealloc
+static void legacyInterleaved(const uint8_t *data, size_t size, uint8_t **memptr, size_t *memsize)
+{
+    jpeg_decompress_struct cinfo;
+    jpeg_error_mgr jerr;
+    JSAMPROW row_pointer[1] = { nullptr };
+
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, const_cast<unsigned char *>(data), size);
+    jpeg_read_header(&cinfo, TRUE);
+    jpeg_start_decompress(&cinfo);
+
+    *memsize = cinfo.output_width * cinfo.output_height * cinfo.num_components;
+    *memptr  = static_cast<uint8_t *>(realloc(*memptr, *memsize));
+    uint8_t *destmem = *memptr;
+
+    row_pointer[0] = (unsigned char *)malloc(cinfo.output_width * cinfo.num_components);
+    for (unsigned int row = 0; row < cinfo.image_height; row++)
+    {
+        jpeg_read_scanlines(&cinfo, row_pointer, 1);
+        memcpy(destmem, row_pointer[0], cinfo.output_width * cinfo.num_components);
+        destmem += cinfo.output_width * cinfo.num_components;
+    }
+
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+    free(row_pointer[0]);
+}
+
+// read_jpeg() as it was, reading from memory instead of a file
+static void legacyPlanar(const uint8_t *data, size_t size, uint8_t **memptr, size_t *memsize)
+{
+    jpeg_decompress_struct cinfo;
+    jpeg_error_mgr jerr;
+    JSAMPROW row_pointer[1] = { nullptr };
+
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, const_cast<unsigned char *>(data), size);
+    jpeg_read_header(&cinfo, TRUE);
+    jpeg_start_decompress(&cinfo);
+
+    *memsize = cinfo.output_width * cinfo.output_height * cinfo.num_components;
+    *memptr  = static_cast<uint8_t *>(realloc(*memptr, *memsize));
+
+    row_pointer[0] = (unsigned char *)malloc(cinfo.output_width * cinfo.num_components);
+    unsigned char *r_data = *memptr;
+    unsigned char *g_data = r_data + cinfo.output_width * cinfo.output_height;
+    unsigned char *b_data = r_data + 2 * cinfo.output_width * cinfo.output_height;
+    for (unsigned int row = 0; row < cinfo.image_height; row++)
+    {
+        unsigned char *ppm8 = row_pointer[0];
+        jpeg_read_scanlines(&cinfo, row_pointer, 1);
+        for (unsigned int i = 0; i < cinfo.output_width; i++)
+        {
+            *r_data++ = *ppm8++;
+            *g_data++ = *ppm8++;
+            *b_data++ = *ppm8++;
+        }
+    }
+
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+    free(row_pointer[0]);
+}
+
+static void report(const char *name, int width, int height, double ms, double baselineMs, const char *check)
+{
+    printf("%-22s %5dx%-5d %9.3f ms %8.1f fps %7.2fx  %s\n", name, width, height, ms, 1000.0 / ms, baselineMs / ms, check);
+}
+
+int main(int argc, char *argv[])
+{
+    int width = 1024, height = 680, quality = 90, iterations = 50;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--width") && i + 1 < argc)
+            width = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--height") && i + 1 < argc)
+            height = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--quality") && i + 1 < argc)
+            quality = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--iterations") && i + 1 < argc)
+            iterations = atoi(argv[++i]);
+        else
+        {
+            printUsage(argv[0]);
+            return strcmp(argv[i], "--help") ? 1 : 0;
+        }
+    }
+    if (width <= 0 || height <= 0 || quality <= 0 || quality > 100 || iterations <= 0)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<uint8_t> jpeg = encodeSynthetic(width, height, quality);
+    printf("Image %dx%d, %zu bytes at quality %d, %d iterations, decoder: %s\n\n", width, height, jpeg.size(), quality,
+           iterations, JpegDecoder::backend());
+
+    bool ok = true;
+    uint8_t *legacy = nullptr;
+    size_t legacySize = 0;
+    JpegDecoder decoder;
+    JpegDecoder::Info info;
+    std::vector<uint8_t> out;
+
+    struct Case
+    {
+        const char *legacyName;
+        void (*legacyDecode)(const uint8_t *, size_t, uint8_t **, size_t *);
+        JpegDecoder::Layout layout;
+        const char *name;
+    };
+    const Case cases[] =
+    {
+        { "read_jpeg_mem", legacyInterleaved, JpegDecoder::INTERLEAVED, "interleaved" },
+        { "read_jpeg", legacyPlanar, JpegDecoder::PLANAR, "planar" },
+    };
+
+    for (const Case &c : cases)
+    {
+        double legacyMs = bestOf(iterations, [&] { c.legacyDecode(jpeg.data(), jpeg.size(), &legacy, &legacySize); });
+        report(c.legacyName, width, height, legacyMs, legacyMs, "");
+
+        for (int scale : { 1, 2, 4, 8 })
+        {
+            if (!decoder.readHeader(jpeg.data(), jpeg.size(), scale, info))
+            {
+                printf("%s\n", decoder.lastError().c_str());
+                return 1;
+            }
+            out.resize(info.size());
+            bool decoded = true;
+            double ms = bestOf(iterations, [&] { decoded &= decoder.decode(jpeg.data(), jpeg.size(), scale, c.layout, out.data()); });
+
+            const char *check = decoded ? "" : "FAILED";
+            if (decoded && scale == 1)
+            {
+                bool match = out.size() == legacySize && !memcmp(out.data(), legacy, legacySize);
+                check = match ? "OK" : "MISMATCH";
+                ok &= match;
+            }
+            ok &= decoded;
+
+            char name[64];
+            snprintf(name, sizeof(name), "%s 1/%d", c.name, scale);
+            report(name, info.width, info.height, ms, legacyMs, check);
+        }
+        printf("\n");
+    }
+
+    free(legacy);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+/*
+    JPEG Decoding into Shared Blobs
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "jpegdecode.h"
+
+#include <indilogger.h>
+#include <sharedblob.h>
+
+#include <cstdio>
+
+static char device[64];
+
+void jpeg_set_debug(const char *name)
+{
+    snprintf(device, sizeof(device), "%s", name);
+}
+
+// Decode a JPEG held in memory into a shared blob buffer
+static int decode_jpeg(const uint8_t *data, size_t size, JpegDecoder::Layout layout, uint8_t **memptr, size_t *memsize,
+                       int *naxis, int *w, int *h)
+{
+    JpegDecoder decoder;
+    JpegDecoder::Info info;
+    if (!decoder.readHeader(data, size, 1, info))
+    {
+        DEBUGFDEVICE(device, INDI::Logger::DBG_ERROR, "Cannot read jpeg: %s", decoder.lastError().c_str());
+        return -1;
+    }
+
+    *memsize = info.size();
+    *memptr  = static_cast<uint8_t *>(IDSharedBlobRealloc(*memptr, *memsize));
+    if (*memptr == nullptr)
+        *memptr = static_cast<uint8_t *>(IDSharedBlobAlloc(*memsize));
+    if (*memptr == nullptr)
+    {
+        DEBUGFDEVICE(device, INDI::Logger::DBG_ERROR, "%s: Failed to allocate %zu bytes of memory!", __PRETTY_FUNCTION__, *memsize);
+        return -1;
+    }
+
+    if (!decoder.decode(data, size, 1, layout, *memptr))
+    {
+        DEBUGFDEVICE(device, INDI::Logger::DBG_ERROR, "Cannot decode jpeg: %s", decoder.lastError().c_str());
+        return -1;
+    }
+
+    *naxis = info.channels;
+    *w     = info.width;
+    *h     = info.height;
+    return 0;
+}
+
+int read_jpeg(const char *filename, uint8_t **memptr, size_t *memsize, int *naxis, int *w, int *h)
+{
+    FILE *infile = fopen(filename, "rb");
+    if (!infile)
+    {
+        DEBUGFDEVICE(device, INDI::Logger::DBG_DEBUG, "Error opening jpeg file %s!", filename);
+        return -1;
+    }
+
+    std::vector<uint8_t> data;
+    if (fseek(infile, 0, SEEK_END) == 0)
+    {
+        long length = ftell(infile);
+        rewind(infile);
+        if (length > 0)
+        {
+            data.resize(length);
+            if (fread(data.data(), 1, data.size(), infile) != data.size())
+                data.clear();
+        }
+    }
+    fclose(infile);
+
+    if (data.empty())
+    {
+        DEBUGFDEVICE(device, INDI::Logger::DBG_DEBUG, "Error reading jpeg file %s!", filename);
+        return -1;
+    }
+
+    return decode_jpeg(data.data(), data.size(), JpegDecoder::PLANAR, memptr, memsize, naxis, w, h);
+}
+
+int read_jpeg_buffer(const uint8_t *data, size_t size, uint8_t **memptr, size_t *memsize, int *naxis, int *w, int *h)
+{
+    return decode_jpeg(data, size, JpegDecoder::PLANAR, memptr, memsize, naxis, w, h);
+}
+
+int read_jpeg_mem(unsigned char *inBuffer, unsigned long inSize, uint8_t **memptr, size_t *memsize, int *naxis, int *w,
+                  int *h)
+{
+    return decode_jpeg(inBuffer, inSize, JpegDecoder::INTERLEAVED, memptr, memsize, naxis, w, h);
+}
+
+int read_jpeg_size(unsigned char *inBuffer, unsigned long inSize, int *w, int *h)
+{
+    JpegDecoder decoder;
+    JpegDecoder::Info info;
+    if (!decoder.readHeader(inBuffer, inSize, 1, info))
+        return -1;
+
+    *w = info.width;
+    *h = info.height;
+    return 0;
+}
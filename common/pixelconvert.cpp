@@ -0,0 +1,755 @@
+/*
+    Colour Channel Conversion
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "pixelconvert.h"
+
+#include <algorithm>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PIXELCONVERT_X86
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#define PIXELCONVERT_NEON
+#include <arm_neon.h>
+#endif
+
+namespace PixelConvert
+{
+
+namespace
+{
+
+// Both x86 kernels work on blocks of 16 pixels. A block spans channels * bytes
+// per sample 16-byte registers on input and the same number on output, so
+// any of the supported conversions is a fixed byte permutation of the block,
+// done with one shuffle per (output register, contributing input register).
+constexpr size_t BLOCK_PIXELS = 16;
+constexpr int MAX_REGS = 8;
+
+struct Permutation
+{
+    int regs {0};
+    // For each output register, the input registers contributing to it and the shuffle mask applied to each.
+    int sources[MAX_REGS] {};
+    int sourceReg[MAX_REGS][MAX_REGS] {};
+    alignas(16) uint8_t mask[MAX_REGS][MAX_REGS][16] {};
+    // Byte offset of each output register within its destination block, per plane when planar.
+    size_t outOffset[MAX_REGS] {};
+    bool planar {false};
+};
+
+enum Operation
+{
+    OP_DEINTERLEAVE,
+    OP_SWAP
+};
+
+constexpr int sourceChannel(int channel, ChannelOrder order)
+{
+    if (order == ORDER_BGR && channel != 1 && channel < 3)
+        return 2 - channel;
+    return channel;
+}
+
+constexpr Permutation buildPermutation(Operation op, int channels, int sampleBytes, ChannelOrder order)
+{
+    Permutation perm {};
+    perm.regs   = channels * sampleBytes;
+    perm.planar = (op == OP_DEINTERLEAVE);
+
+    for (int o = 0; o < perm.regs; o++)
+    {
+        uint8_t mask[MAX_REGS][16] {};
+        bool used[MAX_REGS] {};
+
+        for (int i = 0; i < perm.regs; i++)
+            for (int b = 0; b < 16; b++)
+                mask[i][b] = 0x80;
+
+        for (int b = 0; b < 16; b++)
+        {
+            int pixel = 0, channel = 0, byte = 0;
+            if (op == OP_DEINTERLEAVE)
+            {
+                // Output register o holds part (o % sampleBytes) of plane (o / sampleBytes).
+                int q   = (o % sampleBytes) * 16 + b;
+                pixel   = q / sampleBytes;
+                byte    = q % sampleBytes;
+                channel = sourceChannel(o / sampleBytes, order);
+            }
+            else
+            {
+                int q   = o * 16 + b;
+                int w   = q % (channels * sampleBytes);
+                pixel   = q / (channels * sampleBytes);
+                byte    = w % sampleBytes;
+                channel = sourceChannel(w / sampleBytes, ORDER_BGR);
+            }
+
+            int pos = (pixel * channels + channel) * sampleBytes + byte;
+            mask[pos / 16][b] = pos % 16;
+            used[pos / 16] = true;
+        }
+
+        for (int i = 0; i < perm.regs; i++)
+        {
+            if (!used[i])
+                continue;
+            int n = perm.sources[o]++;
+            perm.sourceReg[o][n] = i;
+            for (int b = 0; b < 16; b++)
+                perm.mask[o][n][b] = mask[i][b];
+        }
+
+        if (op == OP_DEINTERLEAVE)
+            perm.outOffset[o] = (o % sampleBytes) * 16;
+        else
+            perm.outOffset[o] = o * 16;
+    }
+
+    return perm;
+}
+
+template <typename T>
+void deinterleaveTail(const T *src, T *dst, size_t pixels, size_t begin, int channels, ChannelOrder order)
+{
+    T *r = dst;
+    T *g = dst + pixels;
+    T *b = dst + pixels * 2;
+    T *a = dst + pixels * 3;
+
+    if (order == ORDER_BGR)
+        std::swap(r, b);
+
+    if (channels == 4)
+    {
+        for (size_t i = begin; i < pixels; i++)
+        {
+            r[i] = src[i * 4 + 0];
+            g[i] = src[i * 4 + 1];
+            b[i] = src[i * 4 + 2];
+            a[i] = src[i * 4 + 3];
+        }
+    }
+    else
+    {
+        for (size_t i = begin; i < pixels; i++)
+        {
+            r[i] = src[i * 3 + 0];
+            g[i] = src[i * 3 + 1];
+            b[i] = src[i * 3 + 2];
+        }
+    }
+}
+
+template <typename T>
+void swapTail(T *data, size_t pixels, size_t begin, int channels)
+{
+    for (size_t i = begin; i < pixels; i++)
+        std::swap(data[i * channels], data[i * channels + 2]);
+}
+
+// CSI-2 packed rows. The SIMD kernels expand 8 pixels per 16-byte load, which
+// covers 10 (RAW10) or 12 (RAW12) bytes of input. They stop while a full load
+// still fits inside the packed row and the scalar loops below finish it.
+constexpr size_t UNPACK_PIXELS = 8;
+
+void unpackRaw10Tail(const uint8_t *src, uint16_t *dst, size_t pixels, size_t begin)
+{
+    for (size_t i = begin; i < pixels; i++)
+    {
+        const uint8_t *group = src + (i / 4) * 5;
+        dst[i] = static_cast<uint16_t>((group[i % 4] << 2) | ((group[4] >> ((i % 4) * 2)) & 0x3));
+    }
+}
+
+void unpackRaw12Tail(const uint8_t *src, uint16_t *dst, size_t pixels, size_t begin)
+{
+    for (size_t i = begin; i < pixels; i++)
+    {
+        const uint8_t *group = src + (i / 2) * 3;
+        dst[i] = static_cast<uint16_t>((group[i % 2] << 4) | ((group[2] >> ((i % 2) * 4)) & 0xF));
+    }
+}
+
+// Number of pixels the vector loop may expand without reading past the packed row.
+size_t unpackLimit(size_t pixels, size_t groupPixels, size_t groupBytes)
+{
+    size_t bytes = (pixels + groupPixels - 1) / groupPixels * groupBytes;
+    size_t inBytes = UNPACK_PIXELS / groupPixels * groupBytes;
+    if (bytes < 16)
+        return 0;
+    size_t loads = (bytes - 16) / inBytes + 1;
+    return std::min(loads * UNPACK_PIXELS, pixels - pixels % UNPACK_PIXELS);
+}
+
+#ifdef PIXELCONVERT_X86
+
+// One instance per conversion, so the permutation is a compile time constant
+// and the register loops below unroll into a straight run of shuffles.
+template <Operation OP, int C, int E, ChannelOrder ORDER>
+struct Kernel
+{
+    static constexpr Permutation perm = buildPermutation(OP, C, E, ORDER);
+    static constexpr int REGS = C * E;
+    static constexpr size_t IN_STRIDE = REGS * 16;
+    static constexpr size_t OUT_STRIDE = (OP == OP_DEINTERLEAVE) ? 16 * E : REGS * 16;
+
+    static void outputBases(uint8_t *dst, size_t pixels, uint8_t *base[REGS])
+    {
+        for (int o = 0; o < REGS; o++)
+        {
+            size_t plane = (OP == OP_DEINTERLEAVE) ? (o / E) * pixels * E : 0;
+            base[o] = dst + plane + perm.outOffset[o];
+        }
+    }
+
+    // Process blocks [firstBlock, pixels / BLOCK_PIXELS) and return the number of pixels done in total.
+    __attribute__((target("ssse3")))
+    static size_t ssse3(const uint8_t *src, uint8_t *dst, size_t pixels, size_t firstBlock)
+    {
+        size_t blocks = pixels / BLOCK_PIXELS;
+        uint8_t *base[REGS];
+        outputBases(dst, pixels, base);
+
+        for (size_t blk = firstBlock; blk < blocks; blk++)
+        {
+            __m128i in[REGS], out[REGS];
+
+#pragma GCC unroll 8
+            for (int i = 0; i < REGS; i++)
+                in[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + blk * IN_STRIDE + i * 16));
+
+#pragma GCC unroll 8
+            for (int o = 0; o < REGS; o++)
+            {
+                __m128i acc = _mm_setzero_si128();
+#pragma GCC unroll 8
+                for (int n = 0; n < perm.sources[o]; n++)
+                {
+                    __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i *>(perm.mask[o][n]));
+                    acc = _mm_or_si128(acc, _mm_shuffle_epi8(in[perm.sourceReg[o][n]], mask));
+                }
+                out[o] = acc;
+            }
+
+            // All registers are loaded before any store, which makes in place swaps safe.
+#pragma GCC unroll 8
+            for (int o = 0; o < REGS; o++)
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(base[o] + blk * OUT_STRIDE), out[o]);
+        }
+
+        return blocks * BLOCK_PIXELS;
+    }
+
+    // vpshufb only shuffles within 128-bit lanes, so two consecutive blocks
+    // are processed side by side, one per lane, with the same masks.
+    __attribute__((target("avx2")))
+    static size_t avx2(const uint8_t *src, uint8_t *dst, size_t pixels)
+    {
+        size_t pairs = pixels / (BLOCK_PIXELS * 2);
+        uint8_t *base[REGS];
+        outputBases(dst, pixels, base);
+
+        for (size_t pair = 0; pair < pairs; pair++)
+        {
+            size_t blk = pair * 2;
+            __m256i in[REGS], out[REGS];
+
+#pragma GCC unroll 8
+            for (int i = 0; i < REGS; i++)
+            {
+                __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + blk * IN_STRIDE + i * 16));
+                __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + (blk + 1) * IN_STRIDE + i * 16));
+                in[i] = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+            }
+
+#pragma GCC unroll 8
+            for (int o = 0; o < REGS; o++)
+            {
+                __m256i acc = _mm256_setzero_si256();
+#pragma GCC unroll 8
+                for (int n = 0; n < perm.sources[o]; n++)
+                {
+                    __m256i mask = _mm256_broadcastsi128_si256(
+                                       _mm_load_si128(reinterpret_cast<const __m128i *>(perm.mask[o][n])));
+                    acc = _mm256_or_si256(acc, _mm256_shuffle_epi8(in[perm.sourceReg[o][n]], mask));
+                }
+                out[o] = acc;
+            }
+
+#pragma GCC unroll 8
+            for (int o = 0; o < REGS; o++)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(base[o] + blk * OUT_STRIDE), _mm256_castsi256_si128(out[o]));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(base[o] + (blk + 1) * OUT_STRIDE), _mm256_extracti128_si256(out[o], 1));
+            }
+        }
+
+        return pairs * BLOCK_PIXELS * 2;
+    }
+};
+
+// Each 16-bit lane is built as (high byte << 8 | byte holding the low bits), then
+// the low bits of that lane's pixel are moved into place with a per-lane multiply.
+alignas(16) constexpr uint8_t RAW10_SHUFFLE[16] = {4, 0, 4, 1, 4, 2, 4, 3, 9, 5, 9, 6, 9, 7, 9, 8};
+alignas(16) constexpr uint8_t RAW12_SHUFFLE[16] = {2, 0, 2, 1, 5, 3, 5, 4, 8, 6, 8, 7, 11, 9, 11, 10};
+
+__attribute__((target("ssse3")))
+size_t unpackRaw10SSSE3(const uint8_t *src, uint16_t *dst, size_t pixels, size_t begin)
+{
+    const __m128i shuffle = _mm_load_si128(reinterpret_cast<const __m128i *>(RAW10_SHUFFLE));
+    const __m128i scale   = _mm_setr_epi16(64, 16, 4, 1, 64, 16, 4, 1);
+    const __m128i highMask = _mm_set1_epi16(0x3FC), lowMask = _mm_set1_epi16(0x3), byteMask = _mm_set1_epi16(0xFF);
+
+    size_t limit = unpackLimit(pixels, 4, 5), i = begin;
+    for (; i < limit; i += UNPACK_PIXELS)
+    {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i / 4 * 5)), shuffle);
+        __m128i high = _mm_and_si128(_mm_srli_epi16(v, 6), highMask);
+        __m128i low  = _mm_and_si128(_mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(v, byteMask), scale), 6), lowMask);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_or_si128(high, low));
+    }
+    return i;
+}
+
+__attribute__((target("ssse3")))
+size_t unpackRaw12SSSE3(const uint8_t *src, uint16_t *dst, size_t pixels, size_t begin)
+{
+    const __m128i shuffle = _mm_load_si128(reinterpret_cast<const __m128i *>(RAW12_SHUFFLE));
+    const __m128i scale   = _mm_setr_epi16(16, 1, 16, 1, 16, 1, 16, 1);
+    const __m128i highMask = _mm_set1_epi16(0xFF0), lowMask = _mm_set1_epi16(0xF), byteMask = _mm_set1_epi16(0xFF);
+
+    size_t limit = unpackLimit(pixels, 2, 3), i = begin;
+    for (; i < limit; i += UNPACK_PIXELS)
+    {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i / 2 * 3)), shuffle);
+        __m128i high = _mm_and_si128(_mm_srli_epi16(v, 4), highMask);
+        __m128i low  = _mm_and_si128(_mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(v, byteMask), scale), 4), lowMask);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_or_si128(high, low));
+    }
+    return i;
+}
+
+// Same as above with two 8-pixel groups per iteration, one per 128-bit lane.
+__attribute__((target("avx2")))
+size_t unpackRaw10AVX2(const uint8_t *src, uint16_t *dst, size_t pixels)
+{
+    const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(RAW10_SHUFFLE)));
+    const __m256i scale   = _mm256_setr_epi16(64, 16, 4, 1, 64, 16, 4, 1, 64, 16, 4, 1, 64, 16, 4, 1);
+    const __m256i highMask = _mm256_set1_epi16(0x3FC), lowMask = _mm256_set1_epi16(0x3), byteMask = _mm256_set1_epi16(0xFF);
+
+    size_t limit = unpackLimit(pixels, 4, 5), i = 0;
+    for (; i + 2 * UNPACK_PIXELS <= limit; i += 2 * UNPACK_PIXELS)
+    {
+        const uint8_t *in = src + i / 4 * 5;
+        __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in))),
+                                            _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 10)), 1);
+        v = _mm256_shuffle_epi8(v, shuffle);
+        __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 6), highMask);
+        __m256i low  = _mm256_and_si256(_mm256_srli_epi16(_mm256_mullo_epi16(_mm256_and_si256(v, byteMask), scale), 6), lowMask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_or_si256(high, low));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+size_t unpackRaw12AVX2(const uint8_t *src, uint16_t *dst, size_t pixels)
+{
+    const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(RAW12_SHUFFLE)));
+    const __m256i scale   = _mm256_setr_epi16(16, 1, 16, 1, 16, 1, 16, 1, 16, 1, 16, 1, 16, 1, 16, 1);
+    const __m256i highMask = _mm256_set1_epi16(0xFF0), lowMask = _mm256_set1_epi16(0xF), byteMask = _mm256_set1_epi16(0xFF);
+
+    size_t limit = unpackLimit(pixels, 2, 3), i = 0;
+    for (; i + 2 * UNPACK_PIXELS <= limit; i += 2 * UNPACK_PIXELS)
+    {
+        const uint8_t *in = src + i / 2 * 3;
+        __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in))),
+                                            _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 12)), 1);
+        v = _mm256_shuffle_epi8(v, shuffle);
+        __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), highMask);
+        __m256i low  = _mm256_and_si256(_mm256_srli_epi16(_mm256_mullo_epi16(_mm256_and_si256(v, byteMask), scale), 4), lowMask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_or_si256(high, low));
+    }
+    return i;
+}
+
+#endif
+
+#ifdef PIXELCONVERT_NEON
+
+size_t deinterleaveNEON8(const uint8_t *src, uint8_t *dst, size_t pixels, int channels, ChannelOrder order)
+{
+    uint8_t *r = dst, *g = dst + pixels, *b = dst + pixels * 2, *a = dst + pixels * 3;
+    if (order == ORDER_BGR)
+        std::swap(r, b);
+
+    size_t done = pixels - pixels % 16;
+    for (size_t i = 0; i < done; i += 16)
+    {
+        if (channels == 4)
+        {
+            uint8x16x4_t px = vld4q_u8(src + i * 4);
+            vst1q_u8(r + i, px.val[0]);
+            vst1q_u8(g + i, px.val[1]);
+            vst1q_u8(b + i, px.val[2]);
+            vst1q_u8(a + i, px.val[3]);
+        }
+        else
+        {
+            uint8x16x3_t px = vld3q_u8(src + i * 3);
+            vst1q_u8(r + i, px.val[0]);
+            vst1q_u8(g + i, px.val[1]);
+            vst1q_u8(b + i, px.val[2]);
+        }
+    }
+    return done;
+}
+
+size_t deinterleaveNEON16(const uint16_t *src, uint16_t *dst, size_t pixels, int channels, ChannelOrder order)
+{
+    uint16_t *r = dst, *g = dst + pixels, *b = dst + pixels * 2, *a = dst + pixels * 3;
+    if (order == ORDER_BGR)
+        std::swap(r, b);
+
+    size_t done = pixels - pixels % 8;
+    for (size_t i = 0; i < done; i += 8)
+    {
+        if (channels == 4)
+        {
+            uint16x8x4_t px = vld4q_u16(src + i * 4);
+            vst1q_u16(r + i, px.val[0]);
+            vst1q_u16(g + i, px.val[1]);
+            vst1q_u16(b + i, px.val[2]);
+            vst1q_u16(a + i, px.val[3]);
+        }
+        else
+        {
+            uint16x8x3_t px = vld3q_u16(src + i * 3);
+            vst1q_u16(r + i, px.val[0]);
+            vst1q_u16(g + i, px.val[1]);
+            vst1q_u16(b + i, px.val[2]);
+        }
+    }
+    return done;
+}
+
+size_t swapNEON8(uint8_t *data, size_t pixels, int channels)
+{
+    size_t done = pixels - pixels % 16;
+    for (size_t i = 0; i < done; i += 16)
+    {
+        if (channels == 4)
+        {
+            uint8x16x4_t px = vld4q_u8(data + i * 4);
+            std::swap(px.val[0], px.val[2]);
+            vst4q_u8(data + i * 4, px);
+        }
+        else
+        {
+            uint8x16x3_t px = vld3q_u8(data + i * 3);
+            std::swap(px.val[0], px.val[2]);
+            vst3q_u8(data + i * 3, px);
+        }
+    }
+    return done;
+}
+
+size_t swapNEON16(uint16_t *data, size_t pixels, int channels)
+{
+    size_t done = pixels - pixels % 8;
+    for (size_t i = 0; i < done; i += 8)
+    {
+        if (channels == 4)
+        {
+            uint16x8x4_t px = vld4q_u16(data + i * 4);
+            std::swap(px.val[0], px.val[2]);
+            vst4q_u16(data + i * 4, px);
+        }
+        else
+        {
+            uint16x8x3_t px = vld3q_u16(data + i * 3);
+            std::swap(px.val[0], px.val[2]);
+            vst3q_u16(data + i * 3, px);
+        }
+    }
+    return done;
+}
+
+// Byte shuffle of a 16-byte register, tbl on AArch64 and two vtbl2 lookups on ARMv7.
+inline uint8x16_t shuffleNEON(uint8x16_t v, uint8x16_t mask)
+{
+#ifdef __aarch64__
+    return vqtbl1q_u8(v, mask);
+#else
+    uint8x8x2_t table = {{vget_low_u8(v), vget_high_u8(v)}};
+    return vcombine_u8(vtbl2_u8(table, vget_low_u8(mask)), vtbl2_u8(table, vget_high_u8(mask)));
+#endif
+}
+
+// Lanes are built as in the x86 kernels, NEON shifts each lane's low bits into place directly.
+size_t unpackRaw10NEON(const uint8_t *src, uint16_t *dst, size_t pixels)
+{
+    static const uint8_t shuffleBytes[16] = {4, 0, 4, 1, 4, 2, 4, 3, 9, 5, 9, 6, 9, 7, 9, 8};
+    static const int16_t shiftLanes[8] = {0, -2, -4, -6, 0, -2, -4, -6};
+    const uint8x16_t shuffle = vld1q_u8(shuffleBytes);
+    const int16x8_t shift = vld1q_s16(shiftLanes);
+
+    size_t limit = unpackLimit(pixels, 4, 5), i = 0;
+    for (; i < limit; i += UNPACK_PIXELS)
+    {
+        uint16x8_t v = vreinterpretq_u16_u8(shuffleNEON(vld1q_u8(src + i / 4 * 5), shuffle));
+        uint16x8_t high = vandq_u16(vshrq_n_u16(v, 6), vdupq_n_u16(0x3FC));
+        uint16x8_t low  = vandq_u16(vshlq_u16(vandq_u16(v, vdupq_n_u16(0xFF)), shift), vdupq_n_u16(0x3));
+        vst1q_u16(dst + i, vorrq_u16(high, low));
+    }
+    return i;
+}
+
+size_t unpackRaw12NEON(const uint8_t *src, uint16_t *dst, size_t pixels)
+{
+    static const uint8_t shuffleBytes[16] = {2, 0, 2, 1, 5, 3, 5, 4, 8, 6, 8, 7, 11, 9, 11, 10};
+    static const int16_t shiftLanes[8] = {0, -4, 0, -4, 0, -4, 0, -4};
+    const uint8x16_t shuffle = vld1q_u8(shuffleBytes);
+    const int16x8_t shift = vld1q_s16(shiftLanes);
+
+    size_t limit = unpackLimit(pixels, 2, 3), i = 0;
+    for (; i < limit; i += UNPACK_PIXELS)
+    {
+        uint16x8_t v = vreinterpretq_u16_u8(shuffleNEON(vld1q_u8(src + i / 2 * 3), shuffle));
+        uint16x8_t high = vandq_u16(vshrq_n_u16(v, 4), vdupq_n_u16(0xFF0));
+        uint16x8_t low  = vandq_u16(vshlq_u16(vandq_u16(v, vdupq_n_u16(0xFF)), shift), vdupq_n_u16(0xF));
+        vst1q_u16(dst + i, vorrq_u16(high, low));
+    }
+    return i;
+}
+
+#endif
+
+enum Level
+{
+    LEVEL_SCALAR,
+    LEVEL_SSSE3,
+    LEVEL_AVX2,
+    LEVEL_NEON
+};
+
+Level detectLevel()
+{
+#if defined(PIXELCONVERT_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return LEVEL_AVX2;
+    if (__builtin_cpu_supports("ssse3"))
+        return LEVEL_SSSE3;
+#elif defined(PIXELCONVERT_NEON)
+    return LEVEL_NEON;
+#endif
+    return LEVEL_SCALAR;
+}
+
+Level level()
+{
+    static const Level current = detectLevel();
+    return current;
+}
+
+// Run the SIMD kernel over as many whole blocks as possible and return the number of pixels done.
+template <Operation OP, int C, int E, ChannelOrder ORDER>
+size_t permute(const uint8_t *src, uint8_t *dst, size_t pixels)
+{
+#ifdef PIXELCONVERT_X86
+    using K = Kernel<OP, C, E, ORDER>;
+    switch (level())
+    {
+        case LEVEL_AVX2:
+            // Finish an odd trailing block with the 128-bit kernel.
+            return K::ssse3(src, dst, pixels, K::avx2(src, dst, pixels) / BLOCK_PIXELS);
+        case LEVEL_SSSE3:
+            return K::ssse3(src, dst, pixels, 0);
+        default:
+            return 0;
+    }
+#else
+    (void)src;
+    (void)dst;
+    (void)pixels;
+    return 0;
+#endif
+}
+
+template <Operation OP, int E>
+size_t permute(const uint8_t *src, uint8_t *dst, size_t pixels, int channels, ChannelOrder order)
+{
+    if (channels == 4)
+        return order == ORDER_BGR ? permute<OP, 4, E, ORDER_BGR>(src, dst, pixels) : permute<OP, 4, E, ORDER_RGB>(src, dst, pixels);
+    return order == ORDER_BGR ? permute<OP, 3, E, ORDER_BGR>(src, dst, pixels) : permute<OP, 3, E, ORDER_RGB>(src, dst, pixels);
+}
+
+bool supported(int channels)
+{
+    return channels == 3 || channels == 4;
+}
+
+}
+
+void deinterleave8(const uint8_t *src, uint8_t *dst, size_t pixels, int channels, ChannelOrder order)
+{
+    if (!supported(channels))
+        return;
+
+    size_t done = 0;
+#if defined(PIXELCONVERT_X86)
+    done = permute<OP_DEINTERLEAVE, 1>(src, dst, pixels, channels, order);
+#elif defined(PIXELCONVERT_NEON)
+    done = deinterleaveNEON8(src, dst, pixels, channels, order);
+#endif
+    deinterleaveTail(src, dst, pixels, done, channels, order);
+}
+
+void deinterleave16(const uint16_t *src, uint16_t *dst, size_t pixels, int channels, ChannelOrder order)
+{
+    if (!supported(channels))
+        return;
+
+    size_t done = 0;
+#if defined(PIXELCONVERT_X86)
+    const uint8_t *in = reinterpret_cast<const uint8_t *>(src);
+    uint8_t *out = reinterpret_cast<uint8_t *>(dst);
+    done = permute<OP_DEINTERLEAVE, 2>(in, out, pixels, channels, order);
+#elif defined(PIXELCONVERT_NEON)
+    done = deinterleaveNEON16(src, dst, pixels, channels, order);
+#endif
+    deinterleaveTail(src, dst, pixels, done, channels, order);
+}
+
+void swapRB8(uint8_t *data, size_t pixels, int channels)
+{
+    if (!supported(channels))
+        return;
+
+    size_t done = 0;
+#if defined(PIXELCONVERT_X86)
+    done = permute<OP_SWAP, 1>(data, data, pixels, channels, ORDER_RGB);
+#elif defined(PIXELCONVERT_NEON)
+    done = swapNEON8(data, pixels, channels);
+#endif
+    swapTail(data, pixels, done, channels);
+}
+
+void swapRB16(uint16_t *data, size_t pixels, int channels)
+{
+    if (!supported(channels))
+        return;
+
+    size_t done = 0;
+#if defined(PIXELCONVERT_X86)
+    uint8_t *bytes = reinterpret_cast<uint8_t *>(data);
+    done = permute<OP_SWAP, 2>(bytes, bytes, pixels, channels, ORDER_RGB);
+#elif defined(PIXELCONVERT_NEON)
+    done = swapNEON16(data, pixels, channels);
+#endif
+    swapTail(data, pixels, done, channels);
+}
+
+void unpackRaw10(const uint8_t *src, uint16_t *dst, size_t pixels)
+{
+    size_t done = 0;
+#if defined(PIXELCONVERT_X86)
+    if (level() == LEVEL_AVX2)
+        done = unpackRaw10SSSE3(src, dst, pixels, unpackRaw10AVX2(src, dst, pixels));
+    else if (level() == LEVEL_SSSE3)
+        done = unpackRaw10SSSE3(src, dst, pixels, 0);
+#elif defined(PIXELCONVERT_NEON)
+    done = unpackRaw10NEON(src, dst, pixels);
+#endif
+    unpackRaw10Tail(src, dst, pixels, done);
+}
+
+void unpackRaw12(const uint8_t *src, uint16_t *dst, size_t pixels)
+{
+    size_t done = 0;
+#if defined(PIXELCONVERT_X86)
+    if (level() == LEVEL_AVX2)
+        done = unpackRaw12SSSE3(src, dst, pixels, unpackRaw12AVX2(src, dst, pixels));
+    else if (level() == LEVEL_SSSE3)
+        done = unpackRaw12SSSE3(src, dst, pixels, 0);
+#elif defined(PIXELCONVERT_NEON)
+    done = unpackRaw12NEON(src, dst, pixels);
+#endif
+    unpackRaw12Tail(src, dst, pixels, done);
+}
+
+const char *simdLevel()
+{
+    switch (level())
+    {
+        case LEVEL_AVX2:
+            return "AVX2";
+        case LEVEL_SSSE3:
+            return "SSSE3";
+        case LEVEL_NEON:
+            return "NEON";
+        default:
+            return "Scalar";
+    }
+}
+
+namespace Scalar
+{
+
+void deinterleave8(const uint8_t *src, uint8_t *dst, size_t pixels, int channels, ChannelOrder order)
+{
+    if (supported(channels))
+        deinterleaveTail(src, dst, pixels, 0, channels, order);
+}
+
+void deinterleave16(const uint16_t *src, uint16_t *dst, size_t pixels, int channels, ChannelOrder order)
+{
+    if (supported(channels))
+        deinterleaveTail(src, dst, pixels, 0, channels, order);
+}
+
+void swapRB8(uint8_t *data, size_t pixels, int channels)
+{
+    if (supported(channels))
+        swapTail(data, pixels, 0, channels);
+}
+
+void swapRB16(uint16_t *data, size_t pixels, int channels)
+{
+    if (supported(channels))
+        swapTail(data, pixels, 0, channels);
+}
+
+void unpackRaw10(const uint8_t *src, uint16_t *dst, size_t pixels)
+{
+    unpackRaw10Tail(src, dst, pixels, 0);
+}
+
+void unpackRaw12(const uint8_t *src, uint16_t *dst, size_t pixels)
+{
+    unpackRaw12Tail(src, dst, pixels, 0);
+}
+
+}
+
+}
@@ -0,0 +1,94 @@
+/*
+    Colour Channel Conversion
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Colour channel shuffling shared by the camera drivers.
+//
+// Interleaved frames (RGB, BGR, RGBA, BGRA) coming from vendor SDKs are
+// split into the R, G, B (and A) planes that FITS expects, or have their
+// R and B channels swapped in place for streaming. Packed raw sensor rows
+// are expanded to 16-bit samples. The best kernel for the running CPU
+// (AVX2, SSSE3, NEON or plain C++) is selected on first use.
+namespace PixelConvert
+{
+
+enum ChannelOrder
+{
+    ORDER_RGB,
+    ORDER_BGR
+};
+
+/**
+ * @brief deinterleave8 Split interleaved 8-bit pixels into planes.
+ * @param src interleaved pixels, channels bytes per pixel.
+ * @param dst destination holding channels planes of pixels bytes each, always written as R, G, B(, A).
+ * @param pixels number of pixels.
+ * @param channels 3 or 4.
+ * @param order channel order of the source.
+ * @note src and dst must not overlap.
+ */
+void deinterleave8(const uint8_t *src, uint8_t *dst, size_t pixels, int channels, ChannelOrder order);
+
+/** @brief deinterleave16 Same as deinterleave8 for 16-bit samples. */
+void deinterleave16(const uint16_t *src, uint16_t *dst, size_t pixels, int channels, ChannelOrder order);
+
+/** @brief swapRB8 Swap the first and third channel of interleaved 8-bit pixels in place. */
+void swapRB8(uint8_t *data, size_t pixels, int channels);
+
+/** @brief swapRB16 Swap the first and third channel of interleaved 16-bit pixels in place. */
+void swapRB16(uint16_t *data, size_t pixels, int channels);
+
+/**
+ * @brief unpackRaw10 Unpack one row of MIPI CSI-2 packed 10-bit samples.
+ * Every 4 pixels are stored in 5 bytes: the 8 high bits of each pixel, then a byte with the 2 low bits of all four.
+ * @param src packed row, at least (pixels + 3) / 4 * 5 bytes.
+ * @param dst pixels 16-bit samples in the range 0..1023.
+ * @param pixels number of pixels.
+ */
+void unpackRaw10(const uint8_t *src, uint16_t *dst, size_t pixels);
+
+/**
+ * @brief unpackRaw12 Unpack one row of MIPI CSI-2 packed 12-bit samples.
+ * Every 2 pixels are stored in 3 bytes: the 8 high bits of each pixel, then a byte with the 4 low bits of both.
+ * @param src packed row, at least (pixels + 1) / 2 * 3 bytes.
+ * @param dst pixels 16-bit samples in the range 0..4095.
+ * @param pixels number of pixels.
+ */
+void unpackRaw12(const uint8_t *src, uint16_t *dst, size_t pixels);
+
+/** @return name of the kernel set in use, e.g. "AVX2". */
+const char *simdLevel();
+
+// Plain C++ reference kernels, used as the fallback and by the benchmark.
+namespace Scalar
+{
+void deinterleave8(const uint8_t *src, uint8_t *dst, size_t pixels, int channels, ChannelOrder order);
+void deinterleave16(const uint16_t *src, uint16_t *dst, size_t pixels, int channels, ChannelOrder order);
+void swapRB8(uint8_t *data, size_t pixels, int channels);
+void swapRB16(uint16_t *data, size_t pixels, int channels);
+void unpackRaw10(const uint8_t *src, uint16_t *dst, size_t pixels);
+void unpackRaw12(const uint8_t *src, uint16_t *dst, size_t pixels);
+}
+
+}
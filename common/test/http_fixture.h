@@ -0,0 +1,278 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/**
+ * Local HTTP/1.1 server standing in for a device's web server in unit tests.
+ *
+ * Serves the documents set with setDocument() on 127.0.0.1 and a random port, so
+ * HTTP clients can be tested without the hardware. Each connection is served on
+ * its own thread. The mode picks how responses are framed and whether documents
+ * carry a validator; a conditional request for an unchanged document then gets
+ * 304 Not Modified.
+ */
+class HttpFixture
+{
+public:
+    enum Mode
+    {
+        KEEP_ALIVE,         // Content-Length, connection kept open
+        CLOSE,              // Content-Length, then "Connection: close"
+        CHUNKED,            // chunked transfer encoding
+        DROP_IDLE,          // close every connection after one response, without saying so
+        ETAG,               // as KEEP_ALIVE with an ETag, answers If-None-Match
+        LAST_MODIFIED       // as KEEP_ALIVE with Last-Modified, answers If-Modified-Since
+    };
+
+    explicit HttpFixture(Mode mode = KEEP_ALIVE) : m_mode(mode)
+    {
+        m_listen = socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(m_listen, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(m_listen, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+        listen(m_listen, 8);
+
+        socklen_t len = sizeof(addr);
+        getsockname(m_listen, reinterpret_cast<sockaddr *>(&addr), &len);
+        m_port = ntohs(addr.sin_port);
+
+        m_running = true;
+        m_acceptThread = std::thread(&HttpFixture::acceptLoop, this);
+    }
+
+    ~HttpFixture()
+    {
+        m_running = false;
+        m_acceptThread.join();
+        for (auto &thread : m_connectionThreads)
+            thread.join();
+        close(m_listen);
+    }
+
+    /** Set or replace a document, each change gets a new version tag. */
+    void setDocument(const std::string &path, const std::string &content)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        Document &document = m_documents[path];
+        document.content = content;
+        document.version++;
+    }
+
+    void setDocument(const std::string &path, const std::vector<uint8_t> &content)
+    {
+        setDocument(path, std::string(content.begin(), content.end()));
+    }
+
+    /** Delay every reply, to keep a request running. */
+    void setDelay(int ms)
+    {
+        m_delayMs = ms;
+    }
+
+    int port() const
+    {
+        return m_port;
+    }
+    std::string url(const std::string &path) const
+    {
+        return "http://127.0.0.1:" + std::to_string(m_port) + path;
+    }
+    int accepted() const
+    {
+        return m_accepted;
+    }
+    int requests() const
+    {
+        return m_requests;
+    }
+    int notModified() const
+    {
+        return m_notModified;
+    }
+
+private:
+    struct Document
+    {
+        std::string content;
+        int version {0};
+    };
+
+    void acceptLoop()
+    {
+        while (m_running)
+        {
+            pollfd pfd { m_listen, POLLIN, 0 };
+            if (poll(&pfd, 1, 50) <= 0)
+                continue;
+            int fd = accept(m_listen, nullptr, nullptr);
+            if (fd < 0)
+                continue;
+            m_accepted++;
+            m_connectionThreads.emplace_back(&HttpFixture::serve, this, fd);
+        }
+    }
+
+    // Read up to the end of the request headers, false if the client went away
+    bool readRequest(int fd, std::string &request)
+    {
+        request.clear();
+        char buffer[1024];
+        while (request.find("\r\n\r\n") == std::string::npos)
+        {
+            pollfd pfd { fd, POLLIN, 0 };
+            if (!m_running)
+                return false;
+            if (poll(&pfd, 1, 50) <= 0)
+                continue;
+            ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+            if (n <= 0)
+                return false;
+            request.append(buffer, n);
+        }
+        return true;
+    }
+
+    static std::string header(const std::string &request, const std::string &name)
+    {
+        size_t start = request.find("\r\n" + name + ": ");
+        if (start == std::string::npos)
+            return "";
+        start += name.size() + 4;
+        return request.substr(start, request.find("\r\n", start) - start);
+    }
+
+    void sendAll(int fd, const char *data, size_t len)
+    {
+        while (len > 0)
+        {
+            ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+            if (n <= 0)
+                return;
+            data += n;
+            len -= n;
+        }
+    }
+
+    void sendString(int fd, const std::string &s)
+    {
+        sendAll(fd, s.data(), s.size());
+    }
+
+    void serve(int fd)
+    {
+        std::string request;
+        while (readRequest(fd, request))
+        {
+            m_requests++;
+            for (int slept = 0; slept < m_delayMs && m_running; slept += 10)
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+            size_t start = request.find(' ') + 1;
+            std::string path = request.substr(start, request.find(' ', start) - start);
+
+            Document document;
+            bool found;
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                auto entry = m_documents.find(path);
+                found = entry != m_documents.end();
+                if (found)
+                    document = entry->second;
+            }
+
+            if (!found)
+            {
+                sendString(fd, "HTTP/1.1 404 Not Found\r\nContent-Length: 9\r\n\r\nNot Found");
+                continue;
+            }
+
+            const std::string &content = document.content;
+            if (m_mode == CHUNKED)
+            {
+                sendString(fd, "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n");
+                const size_t chunk = 100000;
+                for (size_t offset = 0; offset < content.size(); offset += chunk)
+                {
+                    size_t n = std::min(chunk, content.size() - offset);
+                    char size[32];
+                    snprintf(size, sizeof(size), "%zx\r\n", n);
+                    sendString(fd, size);
+                    sendAll(fd, content.data() + offset, n);
+                    sendString(fd, "\r\n");
+                }
+                sendString(fd, "0\r\n\r\n");
+                continue;
+            }
+
+            // The version stands in for both the entity tag and the modification date
+            std::string etag = "\"v" + std::to_string(document.version) + "\"";
+            std::string modified = "Mon, 0" + std::to_string(document.version % 10) + " Jun 2026 12:00:00 GMT";
+            std::string validator;
+            bool unchanged = false;
+            if (m_mode == ETAG)
+            {
+                validator = "ETag: " + etag + "\r\n";
+                unchanged = header(request, "If-None-Match") == etag;
+            }
+            else if (m_mode == LAST_MODIFIED)
+            {
+                validator = "Last-Modified: " + modified + "\r\n";
+                unchanged = header(request, "If-Modified-Since") == modified;
+            }
+
+            if (unchanged)
+            {
+                m_notModified++;
+                sendString(fd, "HTTP/1.1 304 Not Modified\r\n" + validator + "\r\n");
+                continue;
+            }
+
+            std::string headers = "HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\nContent-Length: " +
+                                  std::to_string(content.size()) + "\r\n" + validator;
+            headers += m_mode == CLOSE ? "Connection: close\r\n\r\n" : "\r\n";
+            // Headers and the start of the body in one segment, as real servers often do
+            size_t head = std::min<size_t>(content.size(), 1000);
+            sendString(fd, headers + content.substr(0, head));
+            sendAll(fd, content.data() + head, content.size() - head);
+
+            if (m_mode == CLOSE || m_mode == DROP_IDLE)
+                break;
+        }
+        close(fd);
+    }
+
+    Mode m_mode;
+    int m_listen {-1};
+    int m_port {0};
+    std::atomic<bool> m_running {false};
+    std::atomic<int> m_delayMs {0};
+    std::atomic<int> m_accepted {0};
+    std::atomic<int> m_requests {0};
+    std::atomic<int> m_notModified {0};
+    std::thread m_acceptThread;
+    std::vector<std::thread> m_connectionThreads;
+
+    std::mutex m_lock;
+    std::map<std::string, Document> m_documents;
+};
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include "blockpool.h"
+
+#include <atomic>
+#include <vector>
+
+TEST(BlockPool, CoversEveryItemOnce)
+{
+    BlockPool pool(4);
+    std::vector<std::atomic<int>> hits(1000);
+
+    for (size_t grain : {1u, 7u, 64u, 1000u, 5000u})
+    {
+        for (auto &hit : hits)
+            hit = 0;
+
+        pool.run(hits.size(), [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+                hits[i]++;
+        }, grain);
+
+        for (size_t i = 0; i < hits.size(); i++)
+            ASSERT_EQ(hits[i], 1) << "item " << i << ", grain " << grain;
+    }
+}
+
+TEST(BlockPool, RestartsAfterStop)
+{
+    BlockPool pool(3);
+    std::atomic<size_t> sum {0};
+    auto job = [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+            sum += i;
+    };
+
+    pool.run(100, job, 10);
+    pool.stop();
+    pool.run(100, job, 10);
+    EXPECT_EQ(sum, 2u * 4950u);
+    EXPECT_EQ(pool.threads(), 3u);
+}
+
+TEST(BlockPool, SingleThreadRunsOnCaller)
+{
+    BlockPool pool(1);
+    size_t calls = 0;
+    pool.run(100, [&](size_t begin, size_t end)
+    {
+        calls++;
+        EXPECT_EQ(begin, 0u);
+        EXPECT_EQ(end, 100u);
+    }, 10);
+    EXPECT_EQ(calls, 1u);
+}
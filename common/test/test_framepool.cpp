@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include "framepool.h"
+
+#include <thread>
+#include <unistd.h>
+
+TEST(FramePool, FramesArePageAligned)
+{
+    FramePool pool;
+    ASSERT_TRUE(pool.reset(3, 1000));
+
+    long pageSize = sysconf(_SC_PAGESIZE);
+    for (int i = 0; i < 3; i++)
+    {
+        FramePool::Frame *frame = pool.acquire();
+        ASSERT_NE(frame, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(frame->data()) % pageSize, 0u);
+        EXPECT_GE(frame->capacity(), 1000u);
+    }
+}
+
+TEST(FramePool, DropNewestKeepsQueuedFrames)
+{
+    FramePool pool(FramePool::DROP_NEWEST);
+    pool.reset(2, 16);
+
+    FramePool::Frame *first = pool.acquire();
+    first->size = 1;
+    pool.publish(first);
+    FramePool::Frame *second = pool.acquire();
+    second->size = 2;
+    pool.publish(second);
+
+    EXPECT_EQ(pool.acquire(), nullptr);
+    EXPECT_EQ(pool.dropped(), 1u);
+    EXPECT_EQ(pool.next(0), first);
+    EXPECT_EQ(pool.next(0), second);
+}
+
+TEST(FramePool, DropOldestReclaimsQueuedFrame)
+{
+    FramePool pool(FramePool::DROP_OLDEST);
+    pool.reset(2, 16);
+
+    FramePool::Frame *first = pool.acquire();
+    pool.publish(first);
+    FramePool::Frame *second = pool.acquire();
+    pool.publish(second);
+
+    // The consumer is behind, the oldest frame is overwritten
+    EXPECT_EQ(pool.acquire(), first);
+    EXPECT_EQ(pool.dropped(), 1u);
+    EXPECT_EQ(pool.depth(), 1u);
+    EXPECT_EQ(pool.next(0), second);
+}
+
+TEST(FramePool, AcquireWaitsForRecycledFrame)
+{
+    FramePool pool;
+    pool.reset(1, 16);
+    FramePool::Frame *frame = pool.acquire();
+    pool.publish(frame);
+
+    std::thread consumer([&pool]()
+    {
+        FramePool::Frame *queued = pool.next();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        pool.recycle(queued);
+    });
+    EXPECT_EQ(pool.acquire(5000), frame);
+    consumer.join();
+    EXPECT_EQ(pool.dropped(), 0u);
+}
+
+TEST(FramePool, CloseDrainsThenStops)
+{
+    FramePool pool;
+    pool.reset(2, 16);
+    FramePool::Frame *frame = pool.acquire();
+    pool.publish(frame);
+    pool.close();
+
+    EXPECT_EQ(pool.next(), frame);
+    EXPECT_EQ(pool.next(), nullptr);
+}
+
+TEST(FramePool, AbortWakesConsumerAndFreesQueuedFrames)
+{
+    FramePool pool;
+    pool.reset(2, 16);
+
+    std::thread consumer([&pool]()
+    {
+        EXPECT_EQ(pool.next(), nullptr);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    pool.abort();
+    consumer.join();
+
+    pool.publish(pool.acquire());
+    pool.abort();
+    EXPECT_EQ(pool.depth(), 0u);
+    EXPECT_NE(pool.acquire(), nullptr);
+    EXPECT_NE(pool.acquire(), nullptr);
+}
+
+TEST(FramePool, ResetKeepsLargerFrames)
+{
+    FramePool pool;
+    pool.reset(2, 1 << 20);
+    FramePool::Frame *frame = pool.acquire();
+    uint8_t *data = frame->data();
+    pool.recycle(frame);
+
+    pool.reset(2, 1000);
+    bool found = false;
+    for (int i = 0; i < 2; i++)
+        found |= pool.acquire()->data() == data;
+    EXPECT_TRUE(found);
+}
+
+TEST(FrameQueue, PassesSlotsInOrder)
+{
+    int slots[3];
+    FrameQueue<int *> queue(FrameQueue<int *>::DROP_OLDEST);
+    queue.reset({&slots[0], &slots[1], &slots[2]});
+
+    int *slot = nullptr;
+    std::vector<int *> sent;
+    for (int i = 0; i < 3; i++)
+    {
+        ASSERT_TRUE(queue.acquire(slot));
+        sent.push_back(slot);
+        queue.publish(slot);
+    }
+    EXPECT_EQ(queue.published(), 3u);
+    for (int i = 0; i < 3; i++)
+    {
+        ASSERT_TRUE(queue.next(slot, 0));
+        EXPECT_EQ(slot, sent[i]);
+    }
+    EXPECT_FALSE(queue.next(slot, 0));
+}
+
+TEST(FrameTiming, RateAndDeadTime)
+{
+    FrameTiming timing;
+    timing.add(10.0, 0.08);
+    timing.add(10.1, 0.08);
+    EXPECT_NEAR(timing.frameRate(), 10.0, 1e-6);
+    EXPECT_NEAR(timing.deadTime(), 0.02, 1e-6);
+    EXPECT_EQ(timing.frames(), 2u);
+}
@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+
+#include "httppoller.h"
+#include "http_fixture.h"
+
+#include <chrono>
+
+static const std::string REPORT = "/weewx.json";
+
+// Wait for the result of the running request
+template <typename T>
+static bool waitResult(HttpFeed<T> &feed, typename HttpFeed<T>::Result &result)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        if (feed.take(result))
+            return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return false;
+}
+
+// Stand-in parser: the document is a number
+static bool parseNumber(const std::string &body, int &value, std::string &error)
+{
+    try
+    {
+        value = std::stoi(body);
+        return true;
+    }
+    catch (const std::exception &)
+    {
+        error = "Not a number: " + body;
+        return false;
+    }
+}
+
+static void expectUnchangedAfterChange(HttpFixture::Mode mode)
+{
+    HttpFixture server(mode);
+    server.setDocument(REPORT, "1");
+
+    HttpFeed<int> feed(parseNumber);
+    feed.start();
+    HttpFeed<int>::Result result;
+
+    ASSERT_TRUE(feed.request(server.url(REPORT)));
+    ASSERT_TRUE(waitResult(feed, result));
+    EXPECT_TRUE(result.error.empty()) << result.error;
+    EXPECT_TRUE(result.modified);
+    ASSERT_TRUE(result.value);
+    EXPECT_EQ(*result.value, 1);
+
+    // Nothing new: no body, nothing parsed
+    ASSERT_TRUE(feed.request(server.url(REPORT)));
+    ASSERT_TRUE(waitResult(feed, result));
+    EXPECT_TRUE(result.error.empty()) << result.error;
+    EXPECT_FALSE(result.modified);
+    EXPECT_FALSE(result.value);
+
+    server.setDocument(REPORT, "2");
+    ASSERT_TRUE(feed.request(server.url(REPORT)));
+    ASSERT_TRUE(waitResult(feed, result));
+    EXPECT_TRUE(result.modified);
+    ASSERT_TRUE(result.value);
+    EXPECT_EQ(*result.value, 2);
+
+    HttpPoller::Stats stats = feed.stats();
+    EXPECT_EQ(stats.requests, 3u);
+    EXPECT_EQ(stats.notModified, 1u);
+    EXPECT_EQ(stats.failures, 0u);
+    EXPECT_GT(stats.averageMs, 0);
+    EXPECT_GE(stats.maxMs, stats.averageMs);
+
+    // All requests over one kept-alive connection
+    EXPECT_EQ(stats.connections, 1u);
+    EXPECT_EQ(server.accepted(), 1);
+    EXPECT_EQ(server.notModified(), mode == HttpFixture::KEEP_ALIVE ? 0 : 1);
+}
+
+TEST(HttpPoller, ETag)
+{
+    expectUnchangedAfterChange(HttpFixture::ETAG);
+}
+
+TEST(HttpPoller, LastModified)
+{
+    expectUnchangedAfterChange(HttpFixture::LAST_MODIFIED);
+}
+
+TEST(HttpPoller, NoValidators)
+{
+    expectUnchangedAfterChange(HttpFixture::KEEP_ALIVE);
+}
+
+TEST(HttpPoller, ValidatorsPerUrl)
+{
+    HttpFixture server(HttpFixture::ETAG);
+    server.setDocument("/a", "1");
+    server.setDocument("/b", "2");
+
+    HttpFeed<int> feed(parseNumber);
+    feed.start();
+    HttpFeed<int>::Result result;
+    for (const char *path : { "/a", "/b", "/a", "/b" })
+    {
+        ASSERT_TRUE(feed.request(server.url(path)));
+        ASSERT_TRUE(waitResult(feed, result));
+        EXPECT_TRUE(result.error.empty()) << result.error;
+    }
+    EXPECT_EQ(server.notModified(), 2);
+}
+
+TEST(HttpPoller, ParsedOnWorkerThread)
+{
+    HttpFixture server(HttpFixture::ETAG);
+    server.setDocument(REPORT, "42");
+
+    std::thread::id caller = std::this_thread::get_id();
+    std::atomic<bool> parsedOnCaller {false};
+    HttpFeed<int> feed([&](const std::string & body, int &value, std::string & error)
+    {
+        if (std::this_thread::get_id() == caller)
+            parsedOnCaller = true;
+        return parseNumber(body, value, error);
+    });
+    feed.start();
+
+    HttpFeed<int>::Result result;
+    ASSERT_TRUE(feed.request(server.url(REPORT)));
+    ASSERT_TRUE(waitResult(feed, result));
+    ASSERT_TRUE(result.value);
+    EXPECT_EQ(*result.value, 42);
+    EXPECT_FALSE(parsedOnCaller);
+}
+
+TEST(HttpPoller, ParseError)
+{
+    HttpFixture server(HttpFixture::ETAG);
+    server.setDocument(REPORT, "{ broken");
+
+    HttpFeed<int> feed(parseNumber);
+    feed.start();
+    HttpFeed<int>::Result result;
+    ASSERT_TRUE(feed.request(server.url(REPORT)));
+    ASSERT_TRUE(waitResult(feed, result));
+    EXPECT_EQ(result.error, "Not a number: { broken");
+    EXPECT_FALSE(result.value);
+}
+
+TEST(HttpPoller, NotFound)
+{
+    HttpFixture server(HttpFixture::ETAG);
+
+    HttpFeed<int> feed(parseNumber);
+    feed.start();
+    HttpFeed<int>::Result result;
+    ASSERT_TRUE(feed.request(server.url("/missing")));
+    ASSERT_TRUE(waitResult(feed, result));
+    EXPECT_EQ(result.status, 404);
+    EXPECT_EQ(result.error, "HTTP status 404");
+    EXPECT_EQ(feed.stats().failures, 1u);
+}
+
+TEST(HttpPoller, ConnectionRefused)
+{
+    std::string url;
+    {
+        HttpFixture server(HttpFixture::ETAG);
+        url = server.url(REPORT);
+    }
+
+    HttpFeed<int> feed(parseNumber, 1000);
+    feed.start();
+    HttpFeed<int>::Result result;
+    ASSERT_TRUE(feed.request(url));
+    ASSERT_TRUE(waitResult(feed, result));
+    EXPECT_EQ(result.status, 0);
+    EXPECT_FALSE(result.error.empty());
+}
+
+TEST(HttpPoller, OneRequestAtATime)
+{
+    HttpFixture server(HttpFixture::ETAG);
+    server.setDocument(REPORT, "1");
+    server.setDelay(200);
+
+    HttpFeed<int> feed(parseNumber);
+    EXPECT_FALSE(feed.request(server.url(REPORT)));
+
+    feed.start();
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(feed.request(server.url(REPORT)));
+    // The caller is never held up by the server
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+    EXPECT_TRUE(feed.busy());
+    EXPECT_FALSE(feed.request(server.url(REPORT)));
+
+    HttpFeed<int>::Result result;
+    EXPECT_FALSE(feed.take(result));
+    ASSERT_TRUE(waitResult(feed, result));
+    EXPECT_GE(result.latencyMs, 200);
+    EXPECT_FALSE(feed.busy());
+    EXPECT_TRUE(feed.request(server.url(REPORT)));
+}
+
+TEST(HttpPoller, StopWhileRequesting)
+{
+    HttpFixture server(HttpFixture::ETAG);
+    server.setDocument(REPORT, "1");
+    server.setDelay(5000);
+
+    HttpFeed<int> feed(parseNumber);
+    feed.start();
+    ASSERT_TRUE(feed.request(server.url(REPORT)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    auto start = std::chrono::steady_clock::now();
+    feed.stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+    EXPECT_FALSE(feed.busy());
+
+    // Restarting gives a working poller again
+    server.setDelay(0);
+    feed.start();
+    HttpFeed<int>::Result result;
+    ASSERT_TRUE(feed.request(server.url(REPORT)));
+    ASSERT_TRUE(waitResult(feed, result));
+    EXPECT_TRUE(result.error.empty()) << result.error;
+}
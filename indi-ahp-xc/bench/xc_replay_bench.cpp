@@ -0,0 +1,323 @@
+/*
+ AHP XC Packet Replay Benchmark
+
+ Replays synthetic correlator packets through the per-packet work of
+ AHP_XC::Callback, before and after the lag buffers and the geometry cache:
+
+   legacy  every lag buffer grows by one realloc'd row per packet, and the delay
+           and UV position of every baseline are recomputed for every packet
+   cached  lag rows go to buffers reserved for the integration, spread over the
+           baseline pool, and the geometry is recomputed once per simulated
+           second on the same pool
+
+ Both paths use the delay and projection functions of indicom, like
+ INDI::Correlator::getDelay() and getUVCoordinates() do in the driver. The serial
+ link is not simulated, packets are replayed as fast as they can be consumed.
+
+ Usage:
+   ./ahp_xc_replay_bench [--packets <n>] [--lags <n>] [--packet-time <s>] [--threads <n>]
+
+ Options:
+   --packets     <n>  Packets replayed per run (default: 2000)
+   --lags        <n>  Autocorrelator lag size, crosscorrelations get 2n-1 (default: 16)
+   --packet-time <s>  Simulated time between packets (default: 0.01)
+   --threads     <n>  Baseline pool threads, 0 for one per core (default: 0)
+
+ Runs for 8, 16 and 32 lines and reports packets per second for each path.
+
+ Copyright (C) 2026 agent (agent@local)
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "xc_buffers.h"
+
+#include <indicom.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+static void printUsage(const char *prog)
+{
+    printf("Usage: %s [--packets <n>] [--lags <n>] [--packet-time <s>] [--threads <n>]\n\n", prog);
+    printf("  --packets     <n>  Packets replayed per run (default: 2000)\n");
+    printf("  --lags        <n>  Autocorrelator lag size, crosscorrelations get 2n-1 (default: 16)\n");
+    printf("  --packet-time <s>  Simulated time between packets (default: 0.01)\n");
+    printf("  --threads     <n>  Baseline pool threads, 0 for one per core (default: 0)\n");
+}
+
+// Stand-ins for ahp_xc_correlation, ahp_xc_sample and ahp_xc_packet, with the members the driver uses
+struct Correlation
+{
+    unsigned long counts;
+    double magnitude;
+};
+
+struct Sample
+{
+    unsigned long lag_size;
+    Correlation *correlations;
+};
+
+struct Packet
+{
+    std::vector<unsigned long> counts;
+    std::vector<Sample> autocorrelations;
+    std::vector<Sample> crosscorrelations;
+    std::vector<Correlation> storage;
+};
+
+static const int PLOT_SIZE = 128;
+static const double WAVELENGTH = 0.211121449;
+
+struct Array
+{
+    unsigned int lines;
+    size_t lags;
+    std::vector<double> locations;                  // x, y, z per line
+    std::vector<std::vector<double>> baselines;     // x, y, z per pair
+    std::vector<Packet> packets;
+};
+
+static Array makeArray(unsigned int lines, size_t lags, size_t distinct)
+{
+    Array array;
+    array.lines = lines;
+    array.lags = lags;
+
+    std::mt19937 rng(lines);
+    std::uniform_real_distribution<double> position(-50.0, 50.0);
+    std::uniform_real_distribution<double> magnitude(0.0, 1000.0);
+    for (unsigned int x = 0; x < lines * 3; x++)
+        array.locations.push_back(position(rng));
+    for (unsigned int x = 0; x < lines; x++)
+        for (unsigned int y = x + 1; y < lines; y++)
+            array.baselines.push_back({ array.locations[y * 3] - array.locations[x * 3],
+                                        array.locations[y * 3 + 1] - array.locations[x * 3 + 1],
+                                        array.locations[y * 3 + 2] - array.locations[x * 3 + 2] });
+
+    size_t nbaselines = array.baselines.size();
+    size_t crosslags = lags * 2 - 1;
+    array.packets.resize(distinct);
+    for (auto &packet : array.packets)
+    {
+        packet.counts.assign(lines, 1000);
+        packet.storage.resize(lines * lags + nbaselines * crosslags);
+        for (auto &correlation : packet.storage)
+        {
+            correlation.counts = 1000;
+            correlation.magnitude = magnitude(rng);
+        }
+        Correlation *next = packet.storage.data();
+        for (unsigned int x = 0; x < lines; x++, next += lags)
+            packet.autocorrelations.push_back({ lags, next });
+        for (size_t x = 0; x < nbaselines; x++, next += crosslags)
+            packet.crosscorrelations.push_back({ crosslags, next });
+    }
+    return array;
+}
+
+// Pointing drifting with the sky, degrees
+static void pointing(double t, double &alt, double &az)
+{
+    alt = 45.0 + 20.0 * sin(t * 7.27e-5);
+    az = fmod(180.0 + t * 4.17e-3, 360.0);
+}
+
+// What updateGeometry() does for one pointing: array center, farthest line, every baseline
+static void computeGeometry(const Array &array, double alt, double az, std::vector<double> &delays,
+                            std::vector<int> &plotIndex, BlockPool *pool)
+{
+    double center[3] = { 0, 0, 0 };
+    for (unsigned int x = 0; x < array.lines; x++)
+        for (int i = 0; i < 3; i++)
+            center[i] += array.locations[x * 3 + i] / array.lines;
+    double delayMax = 0;
+    for (unsigned int x = 0; x < array.lines; x++)
+    {
+        double line[3];
+        for (int i = 0; i < 3; i++)
+            line[i] = array.locations[x * 3 + i] - center[i];
+        double d = baseline_delay(alt, az, line) / sqrt(line[0] * line[0] + line[1] * line[1] + line[2] * line[2]);
+        delayMax = std::max(delayMax, d);
+    }
+
+    auto job = [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            double baseline[3] = { array.baselines[i][0], array.baselines[i][1], array.baselines[i][2] };
+            delays[i] = fabs(baseline_delay(alt, az, baseline));
+            double uv[2];
+            baseline_2d_projection(alt, az, baseline, WAVELENGTH, uv);
+            int w = PLOT_SIZE, h = PLOT_SIZE;
+            int xx = static_cast<int>(w * uv[0] / 2.0);
+            int yy = static_cast<int>(h * uv[1] / 2.0);
+            plotIndex[i] = (xx >= -w / 2 && xx < w / 2 && yy >= -w / 2 && yy < h / 2) ? w * h / 2 + w / 2 + xx + yy * w : -1;
+        }
+    };
+    if (pool != nullptr)
+        pool->run(delays.size(), job, 16);
+    else
+        job(0, delays.size());
+}
+
+static void accumulatePlot(const Packet &packet, const std::vector<int> &plotIndex, std::vector<double> &plot)
+{
+    int len = static_cast<int>(plot.size());
+    for (size_t x = 0; x < plotIndex.size(); x++)
+    {
+        int z = plotIndex[x];
+        if (z < 0 || z >= len)
+            continue;
+        const Correlation &c = packet.crosscorrelations[x].correlations[packet.crosscorrelations[x].lag_size / 2];
+        double value = c.magnitude / c.counts;
+        plot[z] += value;
+        plot[len - 1 - z] += value;
+    }
+}
+
+// The driver before: one realloc'd row per buffer and the whole geometry for every packet
+static double runLegacy(const Array &array, size_t packets)
+{
+    size_t nbaselines = array.baselines.size();
+    size_t crosslags = array.lags * 2 - 1;
+    std::vector<double *> autos(array.lines, nullptr), cross(nbaselines, nullptr);
+    std::vector<double> delays(nbaselines);
+    std::vector<int> plotIndex(nbaselines);
+    std::vector<double> plot(PLOT_SIZE * PLOT_SIZE);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t p = 0; p < packets; p++)
+    {
+        const Packet &packet = array.packets[p % array.packets.size()];
+        double alt, az;
+        pointing(p * 0.01, alt, az);
+        computeGeometry(array, alt, az, delays, plotIndex, nullptr);
+        accumulatePlot(packet, plotIndex, plot);
+
+        for (unsigned int x = 0; x < array.lines; x++)
+        {
+            autos[x] = static_cast<double *>(realloc(autos[x], sizeof(double) * (p + 1) * array.lags));
+            for (size_t l = 0; l < array.lags; l++)
+                autos[x][p * array.lags + l] = packet.autocorrelations[x].correlations[l].magnitude;
+        }
+        for (size_t x = 0; x < nbaselines; x++)
+        {
+            cross[x] = static_cast<double *>(realloc(cross[x], sizeof(double) * (p + 1) * crosslags));
+            for (size_t l = 0; l < crosslags; l++)
+                cross[x][p * crosslags + l] = packet.crosscorrelations[x].correlations[l].magnitude;
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    for (auto buffer : autos)
+        free(buffer);
+    for (auto buffer : cross)
+        free(buffer);
+    return packets / elapsed.count();
+}
+
+// The driver now: reserved lag buffers filled on the pool, geometry once per simulated second
+static double runCached(const Array &array, size_t packets, double packetTime, BlockPool &pool, size_t &geometryUpdates)
+{
+    size_t nbaselines = array.baselines.size();
+    std::vector<LagBuffer> autos(array.lines), cross(nbaselines);
+    for (auto &lags : autos)
+        lags.setLagSize(array.lags);
+    for (auto &lags : cross)
+        lags.setLagSize(array.lags * 2 - 1);
+    std::vector<double> delays(nbaselines);
+    std::vector<int> plotIndex(nbaselines);
+    std::vector<double> plot(PLOT_SIZE * PLOT_SIZE);
+
+    geometryUpdates = 0;
+    double geometryTime = -1;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t p = 0; p < packets; p++)
+    {
+        const Packet &packet = array.packets[p % array.packets.size()];
+        double t = p * packetTime;
+        if (geometryTime < 0 || t - geometryTime >= 1.0)
+        {
+            double alt, az;
+            pointing(t, alt, az);
+            computeGeometry(array, alt, az, delays, plotIndex, &pool);
+            geometryTime = t;
+            geometryUpdates++;
+        }
+        if (p == 0)
+        {
+            for (auto &lags : autos)
+                lags.reserve(packets);
+            for (auto &lags : cross)
+                lags.reserve(packets);
+        }
+        accumulatePlot(packet, plotIndex, plot);
+        appendLags(packet, autos, cross, pool);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return packets / elapsed.count();
+}
+
+int main(int argc, char *argv[])
+{
+    size_t packets = 2000;
+    size_t lags = 16;
+    double packetTime = 0.01;
+    unsigned threads = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--packets") && i + 1 < argc)
+            packets = strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--lags") && i + 1 < argc)
+            lags = strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--packet-time") && i + 1 < argc)
+            packetTime = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+            threads = strtoul(argv[++i], nullptr, 10);
+        else
+        {
+            printUsage(argv[0]);
+            return strcmp(argv[i], "--help") ? 1 : 0;
+        }
+    }
+    if (packets == 0 || lags == 0 || packetTime <= 0)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    BlockPool pool(threads);
+    printf("%zu packets, %zu lags, %g s per packet, %u pool threads\n\n", packets, lags, packetTime, pool.threads());
+    printf("%6s %10s %14s %14s %9s %10s\n", "lines", "baselines", "legacy pkt/s", "cached pkt/s", "speedup", "geometry");
+
+    for (unsigned int lines : { 8u, 16u, 32u })
+    {
+        Array array = makeArray(lines, lags, 16);
+        double legacy = runLegacy(array, packets);
+        size_t geometryUpdates = 0;
+        double cached = runCached(array, packets, packetTime, pool, geometryUpdates);
+        printf("%6u %10zu %14.0f %14.0f %8.1fx %10zu\n", lines, array.baselines.size(), legacy, cached, cached / legacy,
+               geometryUpdates);
+    }
+    return 0;
+}
@@ -23,6 +23,7 @@
 #include <dirent.h>
 #include <unistd.h>
 #include <sys/file.h>
+#include <climits>
 #include <memory>
 #include <regex>
 #include <indicom.h>
@@ -192,6 +193,32 @@ void AHP_XC::sendFile(IBLOB* Blobs, IBLOBVectorProperty BlobP, unsigned int len)
 }
 
 void* AHP_XC::createFITS(int bpp, size_t *memsize, dsp_stream_p stream)
+{
+    uint32_t dims = 0;
+    int *sizes = nullptr;
+    uint8_t *buf = getBuffer(stream, &dims, &sizes);
+    void *fits = createFITS(bpp, memsize, buf, static_cast<int>(dims), sizes);
+    free(buf);
+    free(sizes);
+    return fits;
+}
+
+void* AHP_XC::createFITS(const LagBuffer &lags, size_t *memsize)
+{
+    // An integration without packets still gives a single empty row
+    std::vector<double> empty;
+    const double *buf = lags.data();
+    int sizes[2] = { static_cast<int>(lags.lagSize()), static_cast<int>(lags.rows()) };
+    if(lags.rows() == 0)
+    {
+        empty.assign(lags.lagSize(), 0.0);
+        buf = empty.data();
+        sizes[1] = 1;
+    }
+    return createFITS(-64, memsize, buf, 2, sizes);
+}
+
+void* AHP_XC::createFITS(int bpp, size_t *memsize, const void *buf, int naxis, const int *sizes)
 {
     int img_type  = USHORT_IMG;
     int byte_type = TUSHORT;
@@ -235,26 +262,28 @@ void* AHP_XC::createFITS(int bpp, size_t *memsize, dsp_stream_p stream)
             break;
 
         default:
-            DEBUGF(INDI::Logger::DBG_ERROR, "Unsupported bits per sample value %d", getBPS());
+            DEBUGF(INDI::Logger::DBG_ERROR, "Unsupported bits per sample value %d", bpp);
             return nullptr;
     }
 
     fitsfile *fptr = nullptr;
     void *memptr;
     int status    = 0;
-    uint32_t dims = 0;
-    int *sizes = nullptr;
-    uint8_t *buf = getBuffer(stream, &dims, &sizes);
-    int naxis    = static_cast<int>(dims);
-    long *naxes = static_cast<long*>(malloc(sizeof(long) * dims));
-    long nelements = 0;
+    std::vector<long> naxes(static_cast<size_t>(naxis));
+    long nelements = 1;
 
-    for (uint32_t i = 0, nelements = 1; i < dims; nelements *= static_cast<long>(sizes[i++]))
+    for (int i = 0; i < naxis; i++)
+    {
         naxes[i] = sizes[i];
+        nelements *= static_cast<long>(sizes[i]);
+    }
     char error_status[MAXINDINAME];
 
-    //  Now we have to send fits format data to the client
-    *memsize = 5760;
+    //  Now we have to send fits format data to the client.
+    //  Room for the header and the padded data is allocated at once, so the image is written
+    //  in place and the memory file becomes the BLOB without growing or being copied.
+    size_t datasize = static_cast<size_t>(nelements) * static_cast<size_t>(abs(bpp) / 8);
+    *memsize = 2880 * 4 + (datasize + 2879) / 2880 * 2880;
     memptr  = malloc(*memsize);
     if (!memptr)
     {
@@ -274,7 +303,7 @@ void* AHP_XC::createFITS(int bpp, size_t *memsize, dsp_stream_p stream)
         return nullptr;
     }
 
-    fits_create_img(fptr, img_type, naxis, naxes, &status);
+    fits_create_img(fptr, img_type, naxis, naxes.data(), &status);
 
     if (status)
     {
@@ -286,9 +315,13 @@ void* AHP_XC::createFITS(int bpp, size_t *memsize, dsp_stream_p stream)
         return nullptr;
     }
 
-    addFITSKeywords(fptr, buf, *memsize);
+    addFITSKeywords(fptr, static_cast<uint8_t*>(const_cast<void*>(buf)), static_cast<int>(*memsize));
 
-    fits_write_img(fptr, byte_type, 1, nelements, buf, &status);
+    fits_write_img(fptr, byte_type, 1, nelements, const_cast<void*>(buf), &status);
+
+    // The buffer stays at its allocated size, the file ends with the data unit
+    LONGLONG headstart = 0, datastart = 0, dataend = 0;
+    fits_get_hduaddrll(fptr, &headstart, &datastart, &dataend, &status);
 
     if (status)
     {
@@ -300,6 +333,7 @@ void* AHP_XC::createFITS(int bpp, size_t *memsize, dsp_stream_p stream)
         return nullptr;
     }
     fits_close_file(fptr, &status);
+    *memsize = static_cast<size_t>(dataend);
 
     return memptr;
 }
@@ -334,11 +368,163 @@ uint8_t* AHP_XC::getBuffer(dsp_stream_p in, uint32_t *dims, int **sizes)
     *dims = in->dims;
     *sizes = (int*)malloc(sizeof(int) * in->dims);
     for(int d = 0; d < in->dims; d++)
-        *sizes[d] = in->sizes[d];
+        (*sizes)[d] = in->sizes[d];
     return static_cast<uint8_t *>(buffer);
 }
 
 
+bool AHP_XC::geometryChanged()
+{
+    // Besides setup and pointing changes the sky rotation moves the baselines slowly
+    double now = getCurrentTime();
+    unsigned int generation = geometry_generation;
+    if(generation == geometry_seen && now - geometry_time < GEOMETRY_INTERVAL &&
+            geometry_pointing[0] == RA && geometry_pointing[1] == Dec &&
+            geometry_pointing[2] == Latitude && geometry_pointing[3] == Longitude)
+        return false;
+    geometry_seen = generation;
+    geometry_time = now;
+    geometry_pointing[0] = RA;
+    geometry_pointing[1] = Dec;
+    geometry_pointing[2] = Latitude;
+    geometry_pointing[3] = Longitude;
+    return true;
+}
+
+void AHP_XC::setLineDelay(unsigned int line, unsigned int delay_clocks)
+{
+    if(line_delay_clocks[line] == delay_clocks)
+        return;
+    line_delay_clocks[line] = delay_clocks;
+    ahp_xc_set_channel_auto(line, 0, 1, 1);
+    ahp_xc_set_channel_cross(line, delay_clocks, 1, 1);
+}
+
+void AHP_XC::updateGeometry()
+{
+    double lst = get_local_sidereal_time(Longitude);
+    double ha = get_local_hour_angle(lst, RA);
+    get_alt_az_coordinates(ha * 15, Dec, Latitude, &Altitude, &Azimuth);
+
+    unsigned int nlines = ahp_xc_get_nlines();
+    std::vector<char> enabled(nlines);
+    for(unsigned int x = 0; x < nlines; x++)
+        enabled[x] = lineEnableSP[x].sp[0].s == ISS_ON;
+
+    double center_tmp[3] = {0, 0, 0};
+    int first = -1;
+    int idx = 1;
+    for(unsigned int x = 0; x < nlines; x++)
+    {
+        if(enabled[x])
+        {
+            if(first > -1)
+            {
+                center_tmp[0] += lineLocationNP[x].np[0].value - lineLocationNP[first].np[0].value;
+                center_tmp[1] += lineLocationNP[x].np[1].value - lineLocationNP[first].np[1].value;
+                center_tmp[2] += lineLocationNP[x].np[2].value - lineLocationNP[first].np[2].value;
+                idx++;
+            }
+            else
+            {
+                first = static_cast<int>(x);
+            }
+        }
+    }
+    if(first < 0)
+    {
+        std::fill(baseline_plot_index.begin(), baseline_plot_index.end(), -1);
+        return;
+    }
+    center_tmp[0] /= idx;
+    center_tmp[1] /= idx;
+    center_tmp[2] /= idx;
+    center_tmp[0] += lineLocationNP[first].np[0].value;
+    center_tmp[1] += lineLocationNP[first].np[1].value;
+    center_tmp[2] += lineLocationNP[first].np[2].value;
+    unsigned int farest = 0;
+    double delay_max = 0;
+    for(unsigned int x = 0; x < nlines; x++)
+    {
+        if(enabled[x])
+        {
+            center[x].x = lineLocationNP[x].np[0].value - center_tmp[0];
+            center[x].y = lineLocationNP[x].np[1].value - center_tmp[1];
+            center[x].z = lineLocationNP[x].np[2].value - center_tmp[2];
+            double delay_tmp = baseline_delay(Altitude, Azimuth, center[x].values) / sqrt(pow(center[x].x, 2) + pow(center[x].y,
+                               2) + pow(center[x].z, 2));
+            farest = (delay_tmp > delay_max ? x : farest);
+            delay_max = (delay_tmp > delay_max ? delay_tmp : delay_max);
+        }
+    }
+
+    // Delay and plot position of every baseline, spread over the pool
+    std::vector<std::pair<unsigned int, unsigned int>> pairs;
+    pairs.reserve(ahp_xc_get_nbaselines());
+    for(unsigned int x = 0; x < nlines; x++)
+        for(unsigned int y = x + 1; y < nlines; y++)
+            pairs.emplace_back(x, y);
+    int w = nplots > 0 ? plot_str[0]->sizes[0] : 0;
+    int h = nplots > 0 ? plot_str[0]->sizes[1] : 0;
+    baseline_pool.run(pairs.size(), [&](size_t begin, size_t end)
+    {
+        for(size_t i = begin; i < end; i++)
+        {
+            baseline_plot_index[i] = -1;
+            if(!enabled[pairs[i].first] || !enabled[pairs[i].second])
+                continue;
+            baseline_delays[i] = fabs(baselines[i]->getDelay(Altitude, Azimuth));
+            if(w > 1 && h > 1)
+            {
+                INDI::Correlator::UVCoordinate uv = baselines[i]->getUVCoordinates(Altitude, Azimuth);
+                int xx = static_cast<int>(w * uv.u / 2.0);
+                int yy = static_cast<int>(h * uv.v / 2.0);
+                if(xx >= -w / 2 && xx < w / 2 && yy >= -w / 2 && yy < h / 2)
+                    baseline_plot_index[i] = w * h / 2 + w / 2 + xx + yy * w;
+            }
+        }
+    }, 16);
+
+    // The correlator is only told about delays that changed
+    delay[farest] = 0;
+    setLineDelay(farest, 0);
+    for(size_t i = 0; i < pairs.size(); i++)
+    {
+        unsigned int x = pairs[i].first;
+        unsigned int y = pairs[i].second;
+        if(!enabled[x] || !enabled[y] || (x != farest && y != farest))
+            continue;
+        double d = baseline_delays[i];
+        unsigned int delay_clocks = d * ahp_xc_get_frequency() / LIGHTSPEED;
+        delay_clocks = (delay_clocks > 0 ? (delay_clocks < ahp_xc_get_delaysize() ? delay_clocks : ahp_xc_get_delaysize() - 1) : 0);
+        unsigned int line = (y == farest ? x : y);
+        delay[line] = d;
+        setLineDelay(line, delay_clocks);
+    }
+}
+
+void AHP_XC::resetLags(size_t rows)
+{
+    size_t rowsize = 0;
+    for(auto &lags : autocorrelations_lags)
+        rowsize += lags.lagSize() * sizeof(double);
+    for(auto &lags : crosscorrelations_lags)
+        rowsize += lags.lagSize() * sizeof(double);
+    if(rowsize > 0)
+        rows = std::min(rows, LAGS_RESERVE_MAX / rowsize);
+
+    for(auto &lags : autocorrelations_lags)
+    {
+        lags.clear();
+        lags.reserve(rows);
+    }
+    for(auto &lags : crosscorrelations_lags)
+    {
+        lags.clear();
+        lags.reserve(rows);
+    }
+}
+
 void AHP_XC::Callback()
 {
     ahp_xc_packet* packet = ahp_xc_alloc_packet();
@@ -353,80 +539,8 @@ void AHP_XC::Callback()
             continue;
         }
         int idx = 0;
-        double lst = get_local_sidereal_time(Longitude);
-        double ha = get_local_hour_angle(lst, RA);
-        get_alt_az_coordinates(ha * 15, Dec, Latitude, &Altitude, &Azimuth);
-
-        double center_tmp[3] = {0, 0, 0};
-        int first = -1;
-        idx = 1;
-        for(unsigned int x = 0; x < ahp_xc_get_nlines(); x++)
-        {
-            if(lineEnableSP[x].sp[0].s == ISS_ON)
-            {
-                if(first > -1)
-                {
-                    center_tmp[0] += lineLocationNP[x].np[0].value - lineLocationNP[first].np[0].value;
-                    center_tmp[1] += lineLocationNP[x].np[1].value - lineLocationNP[first].np[1].value;
-                    center_tmp[2] += lineLocationNP[x].np[2].value - lineLocationNP[first].np[2].value;
-                    idx++;
-                }
-                else
-                {
-                    first = static_cast<int>(x);
-                }
-            }
-        }
-        center_tmp[0] /= idx;
-        center_tmp[1] /= idx;
-        center_tmp[2] /= idx;
-        center_tmp[0] += lineLocationNP[first].np[0].value;
-        center_tmp[1] += lineLocationNP[first].np[1].value;
-        center_tmp[2] += lineLocationNP[first].np[2].value;
-        unsigned int farest = 0;
-        double delay_max = 0;
-        for(unsigned int x = 0; x < ahp_xc_get_nlines(); x++)
-        {
-            if(lineEnableSP[x].sp[0].s == ISS_ON)
-            {
-                center[x].x = lineLocationNP[x].np[0].value - center_tmp[0];
-                center[x].y = lineLocationNP[x].np[1].value - center_tmp[1];
-                center[x].z = lineLocationNP[x].np[2].value - center_tmp[2];
-                double delay_tmp = baseline_delay(Altitude, Azimuth, center[x].values) / sqrt(pow(center[x].x, 2) + pow(center[x].y,
-                                   2) + pow(center[x].z, 2));
-                farest = (delay_tmp > delay_max ? x : farest);
-                delay_max = (delay_tmp > delay_max ? delay_tmp : delay_max);
-            }
-        }
-        delay[farest] = 0;
-        ahp_xc_set_channel_auto(static_cast<unsigned int>(farest), 0, 1, 1);
-        ahp_xc_set_channel_cross(static_cast<unsigned int>(farest), 0, 1, 1);
-        idx = 0;
-        for(unsigned int x = 0; x < ahp_xc_get_nlines(); x++)
-        {
-            for(unsigned int y = x + 1; y < ahp_xc_get_nlines(); y++)
-            {
-                if((lineEnableSP[x].sp[0].s == ISS_ON) && lineEnableSP[y].sp[0].s == ISS_ON)
-                {
-                    double d = fabs(baselines[idx]->getDelay(Altitude, Azimuth));
-                    unsigned int delay_clocks = d * ahp_xc_get_frequency() / LIGHTSPEED;
-                    delay_clocks = (delay_clocks > 0 ? (delay_clocks < ahp_xc_get_delaysize() ? delay_clocks : ahp_xc_get_delaysize() - 1) : 0);
-                    if(y == farest)
-                    {
-                        delay[x] = d;
-                        ahp_xc_set_channel_auto(x, 0, 1, 1);
-                        ahp_xc_set_channel_cross(x, delay_clocks, 1, 1);
-                    }
-                    if(x == farest)
-                    {
-                        delay[y] = d;
-                        ahp_xc_set_channel_auto(y, 0, 1, 1);
-                        ahp_xc_set_channel_cross(y, delay_clocks, 1, 1);
-                    }
-                }
-                idx++;
-            }
-        }
+        if(geometryChanged())
+            updateGeometry();
         if(InIntegration)
         {
             timeleft = CalcTimeLeft();
@@ -437,8 +551,7 @@ void AHP_XC::Callback()
                 timeleft = 0;
                 // We're done exposing
                 LOG_INFO("Integration complete, downloading plots...");
-                // Additional BLOBs
-                char **blobs = static_cast<char**>(malloc(sizeof(char*)*static_cast<unsigned int>(plotBP.nbp) + 1));
+                // The FITS memory files are the BLOBs, they are freed once sent
                 for(unsigned int x = 0; x < nplots; x++)
                 {
                     if(HasDSP())
@@ -446,143 +559,77 @@ void AHP_XC::Callback()
                         DSP->processBLOB(static_cast<unsigned char*>(static_cast<void*>(plot_str[x]->buf)),
                                          static_cast<unsigned int>(plot_str[x]->dims), plot_str[x]->sizes, -64); //TODO
                     }
-                    size_t memsize = static_cast<unsigned int>(plot_str[x]->len) * sizeof(double);
-                    void* fits = createFITS(-64, &memsize, plot_str[x]);
-                    if(fits != nullptr)
-                    {
-                        blobs[x] = static_cast<char*>(malloc(memsize));
-                        memcpy(blobs[x], fits, memsize);
-                        plotB[x].blob = blobs[x];
-                        plotB[x].bloblen = static_cast<int>(memsize);
-                        free(fits);
-                    }
+                    size_t memsize = 0;
+                    plotB[x].blob = createFITS(-64, &memsize, plot_str[x]);
+                    plotB[x].bloblen = plotB[x].blob != nullptr ? static_cast<int>(memsize) : 0;
                 }
                 LOG_INFO("Plots BLOBs generated, downloading...");
                 sendFile(plotB, plotBP, nplots);
                 for(unsigned int x = 0; x < nplots; x++)
                 {
-                    free(blobs[x]);
+                    free(plotB[x].blob);
+                    plotB[x].blob = nullptr;
                     memset(plot_str[x]->buf, 0, sizeof(dsp_t)*static_cast<size_t>(plot_str[x]->len));
                 }
                 LOG_INFO("Generating additional BLOBs...");
-                if(ahp_xc_get_nlines() > 0 && ahp_xc_get_autocorrelator_lagsize() > 1)
+                if(!autocorrelations_lags.empty())
                 {
-                    blobs = static_cast<char**>(realloc(blobs, sizeof(char*)*static_cast<unsigned int>(autocorrelationsBP.nbp) + 1));
-                    for(unsigned int x = 0; x < ahp_xc_get_nlines(); x++)
+                    for(unsigned int x = 0; x < autocorrelations_lags.size(); x++)
                     {
-                        size_t memsize = static_cast<unsigned int>(autocorrelations_str[x]->len) * sizeof(double);
-                        void* fits = createFITS(-64, &memsize, autocorrelations_str[x]);
-                        if(fits != nullptr)
-                        {
-                            blobs[x] = static_cast<char*>(malloc(memsize));
-                            memcpy(blobs[x], fits, memsize);
-                            autocorrelationsB[x].blob = blobs[x];
-                            autocorrelationsB[x].bloblen = static_cast<int>(memsize);
-                            free(fits);
-                        }
-                        autocorrelations_str[x]->sizes[1] = 1;
-                        autocorrelations_str[x]->len = autocorrelations_str[x]->sizes[0];
-                        dsp_stream_alloc_buffer(autocorrelations_str[x], autocorrelations_str[x]->len);
+                        size_t memsize = 0;
+                        autocorrelationsB[x].blob = createFITS(autocorrelations_lags[x], &memsize);
+                        autocorrelationsB[x].bloblen = autocorrelationsB[x].blob != nullptr ? static_cast<int>(memsize) : 0;
+                        autocorrelations_lags[x].clear();
                     }
                     LOG_INFO("Autocorrelations BLOBs generated, downloading...");
                     sendFile(autocorrelationsB, autocorrelationsBP, ahp_xc_get_nlines());
-                    for(unsigned int x = 0; x < ahp_xc_get_nlines(); x++)
+                    for(unsigned int x = 0; x < autocorrelations_lags.size(); x++)
                     {
-                        free(blobs[x]);
+                        free(autocorrelationsB[x].blob);
+                        autocorrelationsB[x].blob = nullptr;
                     }
                 }
-                if(ahp_xc_get_nbaselines() > 0 && ahp_xc_get_crosscorrelator_lagsize() > 1)
+                if(!crosscorrelations_lags.empty())
                 {
-                    blobs = static_cast<char**>(realloc(blobs, sizeof(char*)*static_cast<unsigned int>(crosscorrelationsBP.nbp) + 1));
-                    idx = 0;
-                    for(unsigned int x = 0; x < ahp_xc_get_nlines(); x++)
+                    for(unsigned int x = 0; x < crosscorrelations_lags.size(); x++)
                     {
-                        for(unsigned int y = x + 1; y < ahp_xc_get_nlines(); y++)
-                        {
-                            size_t memsize = static_cast<unsigned int>(crosscorrelations_str[x]->len) * sizeof(double);
-                            void* fits = createFITS(-64, &memsize, crosscorrelations_str[x]);
-                            if(fits != nullptr)
-                            {
-                                blobs[x] = static_cast<char*>(malloc(memsize));
-                                memcpy(blobs[x], fits, memsize);
-                                crosscorrelationsB[x].blob = blobs[x];
-                                crosscorrelationsB[x].bloblen = static_cast<int>(memsize);
-                                free(fits);
-                            }
-                            crosscorrelations_str[idx]->sizes[1] = 1;
-                            crosscorrelations_str[idx]->len = crosscorrelations_str[idx]->sizes[0];
-                            dsp_stream_alloc_buffer(crosscorrelations_str[idx], crosscorrelations_str[idx]->len);
-                            idx++;
-                        }
+                        size_t memsize = 0;
+                        crosscorrelationsB[x].blob = createFITS(crosscorrelations_lags[x], &memsize);
+                        crosscorrelationsB[x].bloblen = crosscorrelationsB[x].blob != nullptr ? static_cast<int>(memsize) : 0;
+                        crosscorrelations_lags[x].clear();
                     }
                     LOG_INFO("Crosscorrelations BLOBs generated, downloading...");
                     sendFile(crosscorrelationsB, crosscorrelationsBP, ahp_xc_get_nbaselines());
-                    for(unsigned int x = 0; x < ahp_xc_get_nbaselines(); x++)
+                    for(unsigned int x = 0; x < crosscorrelations_lags.size(); x++)
                     {
-                        free(blobs[x]);
+                        free(crosscorrelationsB[x].blob);
+                        crosscorrelationsB[x].blob = nullptr;
                     }
                 }
-                free(blobs);
                 LOG_INFO("Download complete.");
             }
             else
             {
+                // The first packet of a new integration empties and sizes the lag buffers
+                size_t rows = integration_rows.exchange(0);
+                if(rows > 0)
+                    resetLags(rows);
                 // Filling BLOBs
                 if(nplots > 0)
                 {
-                    idx = 0;
-                    for(unsigned int x = 0; x < ahp_xc_get_nlines(); x++)
-                    {
-                        for(unsigned int y = x + 1; y < ahp_xc_get_nlines(); y++)
-                        {
-                            if((lineEnableSP[x].sp[0].s == ISS_ON) && lineEnableSP[y].sp[0].s == ISS_ON)
-                            {
-                                int w = plot_str[0]->sizes[0];
-                                int h = plot_str[0]->sizes[1];
-                                INDI::Correlator::UVCoordinate uv = baselines[idx]->getUVCoordinates(Altitude, Azimuth);
-                                int xx = static_cast<int>(w * uv.u / 2.0);
-                                int yy = static_cast<int>(h * uv.v / 2.0);
-                                int z = w * h / 2 + w / 2 + xx + yy * w;
-                                if(xx >= -w / 2 && xx < w / 2 && yy >= -w / 2 && yy < h / 2)
-                                {
-                                    plot_str[0]->buf[z] += (double)packet->crosscorrelations[idx].correlations[packet->crosscorrelations[idx].lag_size /
-                                                           2].magnitude / (double)packet->crosscorrelations[idx].correlations[packet->crosscorrelations[idx].lag_size /
-                                                                   2].counts;
-                                    plot_str[0]->buf[w * h - 1 - z] += (double)
-                                                                       packet->crosscorrelations[idx].correlations[packet->crosscorrelations[idx].lag_size / 2].magnitude /
-                                                                       packet->crosscorrelations[idx].correlations[packet->crosscorrelations[idx].lag_size / 2].counts;
-                                }
-                            }
-                            idx++;
-                        }
-                    }
-                }
-                if(ahp_xc_get_nlines() > 0 && ahp_xc_get_autocorrelator_lagsize() > 1)
-                {
-                    for(unsigned int x = 0; x < ahp_xc_get_nlines(); x++)
-                    {
-                        int pos = autocorrelations_str[x]->len - autocorrelations_str[x]->sizes[0];
-                        autocorrelations_str[x]->sizes[1]++;
-                        autocorrelations_str[x]->len += autocorrelations_str[x]->sizes[0];
-                        autocorrelations_str[x]->buf = (dsp_t*)realloc(autocorrelations_str[x]->buf,
-                                                       sizeof(dsp_t) * static_cast<unsigned int>(autocorrelations_str[x]->len));
-                        for(unsigned int i = 0; i < packet->autocorrelations[x].lag_size; i++)
-                            autocorrelations_str[x]->buf[pos++] = packet->autocorrelations[x].correlations[i].magnitude;
-                    }
-                }
-                if(ahp_xc_get_nbaselines() > 0 && ahp_xc_get_crosscorrelator_lagsize() > 1)
-                {
+                    int len = plot_str[0]->len;
                     for(unsigned int x = 0; x < ahp_xc_get_nbaselines(); x++)
                     {
-                        int pos = crosscorrelations_str[x]->len - crosscorrelations_str[x]->sizes[0];
-                        crosscorrelations_str[x]->sizes[1]++;
-                        crosscorrelations_str[x]->len += crosscorrelations_str[x]->sizes[0];
-                        crosscorrelations_str[x]->buf = (dsp_t*)realloc(crosscorrelations_str[x]->buf,
-                                                        sizeof(dsp_t) * static_cast<unsigned int>(crosscorrelations_str[x]->len));
-                        for(unsigned int i = 0; i < packet->crosscorrelations[x].lag_size; i++)
-                            crosscorrelations_str[x]->buf[pos++] = packet->crosscorrelations[x].correlations[i].magnitude;
+                        int z = baseline_plot_index[x];
+                        if(z < 0 || z >= len)
+                            continue;
+                        double value = (double)packet->crosscorrelations[x].correlations[packet->crosscorrelations[x].lag_size / 2].magnitude /
+                                       (double)packet->crosscorrelations[x].correlations[packet->crosscorrelations[x].lag_size / 2].counts;
+                        plot_str[0]->buf[z] += value;
+                        plot_str[0]->buf[len - 1 - z] += value;
                     }
                 }
+                appendLags(*packet, autocorrelations_lags, crosscorrelations_lags, baseline_pool);
             }
         }
 
@@ -644,8 +691,6 @@ AHP_XC::AHP_XC()
 
     correlationsN = static_cast<INumber*>(malloc(sizeof(INumber)));
 
-    autocorrelations_str = static_cast<dsp_stream_p*>(malloc(sizeof(dsp_stream_p)));
-    crosscorrelations_str = static_cast<dsp_stream_p*>(malloc(sizeof(dsp_stream_p)));
     plot_str = static_cast<dsp_stream_p*>(malloc(sizeof(dsp_stream_p)));
 
     framebuffer = static_cast<double*>(malloc(sizeof(double)));
@@ -664,22 +709,9 @@ bool AHP_XC::Disconnect()
     }
     for(unsigned int x = 0; x < ahp_xc_get_nlines(); x++)
     {
-        if(ahp_xc_get_autocorrelator_lagsize() > 1)
-        {
-            dsp_stream_free_buffer(autocorrelations_str[x]);
-            dsp_stream_free(autocorrelations_str[x]);
-        }
         ActiveLine(x, false, false, false, false);
         usleep(10000);
     }
-    for(unsigned int x = 0; x < ahp_xc_get_nbaselines(); x++)
-    {
-        if(ahp_xc_get_crosscorrelator_lagsize() > 1)
-        {
-            dsp_stream_free_buffer(crosscorrelations_str[x]);
-            dsp_stream_free(crosscorrelations_str[x]);
-        }
-    }
 
     threadsRunning = false;
 
@@ -846,6 +878,7 @@ void AHP_XC::setupParams()
         plot_str[0]->sizes[1] = size;
         plot_str[0]->len = size * size;
         dsp_stream_alloc_buffer(plot_str[0], plot_str[0]->len);
+        geometry_generation++;
     }
 }
 
@@ -858,6 +891,9 @@ bool AHP_XC::StartIntegration(double duration)
         return false;
 
     IntegrationRequest = static_cast<double>(duration);
+    // The capture thread sizes the lag buffers for this many packets when the integration starts
+    double packettime = ahp_xc_get_packettime();
+    integration_rows = static_cast<size_t>(packettime > 0 ? duration / packettime : 0) + 1;
     gettimeofday(&ExpStart, nullptr);
     InIntegration = true;
     // We're done
@@ -886,6 +922,9 @@ bool AHP_XC::ISNewNumber(const char *dev, const char *name, double values[], cha
     for(unsigned int x = 0; x < ahp_xc_get_nbaselines(); x++)
         baselines[x]->ISNewNumber(dev, name, values, names, n);
 
+    // Baselines and wavelength may have changed
+    geometry_generation++;
+
     for(unsigned int i = 0; i < ahp_xc_get_nlines(); i++)
     {
         if(!strcmp(lineLocationNP[i].name, name))
@@ -967,6 +1006,7 @@ bool AHP_XC::ISNewSwitch(const char *dev, const char *name, ISState *states, cha
         if(!strcmp(name, lineEnableSP[x].name))
         {
             IUUpdateSwitch(&lineEnableSP[x], states, names, n);
+            geometry_generation++;
             if(lineEnableSP[x].sp[0].s == ISS_ON)
             {
                 ActiveLine(x, lineEnableSP[x].sp[0].s == ISS_ON
@@ -1204,12 +1244,16 @@ bool AHP_XC::Handshake()
     if(nplots > 0)
         plotB = static_cast<IBLOB*>(realloc(plotB, static_cast<unsigned long>(nplots) * sizeof(IBLOB) + 1));
 
+    autocorrelations_lags.clear();
     if(ahp_xc_get_autocorrelator_lagsize() > 1)
-        autocorrelations_str = static_cast<dsp_stream_p*>(realloc(autocorrelations_str,
-                               static_cast<unsigned long>(ahp_xc_get_nlines()) * sizeof(dsp_stream_p) + 1));
+        autocorrelations_lags.resize(ahp_xc_get_nlines());
+    for(auto &lags : autocorrelations_lags)
+        lags.setLagSize(ahp_xc_get_autocorrelator_lagsize());
+    crosscorrelations_lags.clear();
     if(ahp_xc_get_crosscorrelator_lagsize() > 1)
-        crosscorrelations_str = static_cast<dsp_stream_p*>(realloc(crosscorrelations_str,
-                                static_cast<unsigned long>(ahp_xc_get_nbaselines()) * sizeof(dsp_stream_p) + 1));
+        crosscorrelations_lags.resize(ahp_xc_get_nbaselines());
+    for(auto &lags : crosscorrelations_lags)
+        lags.setLagSize(ahp_xc_get_crosscorrelator_lagsize() * 2 - 1);
     if(nplots > 0)
         plot_str = static_cast<dsp_stream_p*>(realloc(plot_str, static_cast<unsigned long>(nplots) * sizeof(dsp_stream_p) + 1));
 
@@ -1225,15 +1269,12 @@ bool AHP_XC::Handshake()
 
     memset (totalcounts, 0, static_cast<unsigned long>(ahp_xc_get_nlines())*sizeof(double) +1);
     memset (totalcorrelations, 0, static_cast<unsigned long>(ahp_xc_get_nbaselines())*sizeof(ahp_xc_correlation) + 1);
+    baseline_delays.assign(ahp_xc_get_nbaselines(), 0);
+    baseline_plot_index.assign(ahp_xc_get_nbaselines(), -1);
+    line_delay_clocks.assign(ahp_xc_get_nlines(), UINT_MAX);
+    geometry_generation++;
     for(unsigned int x = 0; x < ahp_xc_get_nbaselines(); x++)
     {
-        if(ahp_xc_get_crosscorrelator_lagsize() > 1)
-        {
-            crosscorrelations_str[x] = dsp_stream_new();
-            dsp_stream_add_dim(crosscorrelations_str[x], static_cast<int>(ahp_xc_get_crosscorrelator_lagsize() * 2 - 1));
-            dsp_stream_add_dim(crosscorrelations_str[x], 1);
-            dsp_stream_alloc_buffer(crosscorrelations_str[x], crosscorrelations_str[x]->len);
-        }
         baselines[x] = new baseline();
         baselines[x]->initProperties();
     }
@@ -1260,14 +1301,6 @@ bool AHP_XC::Handshake()
 
     for (unsigned int x = 0; x < ahp_xc_get_nlines(); x++)
     {
-        if(ahp_xc_get_autocorrelator_lagsize() > 1)
-        {
-            autocorrelations_str[x] = dsp_stream_new();
-            dsp_stream_add_dim(autocorrelations_str[x], static_cast<int>(ahp_xc_get_autocorrelator_lagsize()));
-            dsp_stream_add_dim(autocorrelations_str[x], 1);
-            dsp_stream_alloc_buffer(autocorrelations_str[x], autocorrelations_str[x]->len);
-        }
-
         IUFillNumber(&lineLocationN[x * 3 + 0], "LOCATION_X", "X Location (m)", "%g", -EARTHRADIUSMEAN, EARTHRADIUSMEAN, 1.0E-9, 0);
         IUFillNumber(&lineLocationN[x * 3 + 1], "LOCATION_Y", "Y Location (m)", "%g", -EARTHRADIUSMEAN, EARTHRADIUSMEAN, 1.0E-9, 0);
         IUFillNumber(&lineLocationN[x * 3 + 2], "LOCATION_Z", "Z Location (m)", "%g", -EARTHRADIUSMEAN, EARTHRADIUSMEAN, 1.0E-9, 0);
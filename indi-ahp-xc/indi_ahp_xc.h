@@ -22,7 +22,9 @@
 
 #include "indispectrograph.h"
 #include "indicorrelator.h"
+#include "xc_buffers.h"
 #include <ahp/ahp_xc.h>
+#include <atomic>
 
 class baseline : public INDI::Correlator
 {
@@ -76,8 +78,6 @@ public:
         free(crosscorrelationsB);
         free(plotB);
 
-        free(autocorrelations_str);
-        free(crosscorrelations_str);
         free(plot_str);
 
         free(totalcounts);
@@ -166,10 +166,31 @@ private:
     IBLOB *crosscorrelationsB;
     IBLOBVectorProperty crosscorrelationsBP;
 
-    dsp_stream_p *autocorrelations_str;
-    dsp_stream_p *crosscorrelations_str;
+    // Lag rows of the running integration, one buffer per line and per baseline
+    std::vector<LagBuffer> autocorrelations_lags;
+    std::vector<LagBuffer> crosscorrelations_lags;
     dsp_stream_p *plot_str;
 
+    // Seconds after which the geometry follows the sky rotation
+    static constexpr double GEOMETRY_INTERVAL = 1.0;
+    // Bytes of lag rows reserved up front, longer integrations grow the buffers
+    static constexpr size_t LAGS_RESERVE_MAX = 256 * 1024 * 1024;
+
+    // Packets expected by the running integration, the capture thread reserves the lag rows once
+    std::atomic<size_t> integration_rows { 0 };
+
+    // Array geometry, recomputed on pointing or setup changes instead of on every packet
+    BlockPool baseline_pool;
+    std::atomic<unsigned int> geometry_generation { 0 };
+    unsigned int geometry_seen { 0 };
+    double geometry_time { 0 };
+    double geometry_pointing[4] { 0, 0, 0, 0 };
+    std::vector<double> baseline_delays;
+    // Plot pixel of each baseline, -1 when disabled or off the plot
+    std::vector<int> baseline_plot_index;
+    // Cross delay last sent to each line, the correlator is only told about changes
+    std::vector<unsigned int> line_delay_clocks;
+
     INumber settingsN[2];
     INumberVectorProperty settingsNP;
 
@@ -179,6 +200,11 @@ private:
     double timeleft;
     double wavelength;
     void Callback();
+    bool geometryChanged();
+    void updateGeometry();
+    void setLineDelay(unsigned int line, unsigned int delay_clocks);
+    // Empty the lag buffers and make room for rows packets, within LAGS_RESERVE_MAX
+    void resetLags(size_t rows);
     bool callHandshake();
     // Utility functions
     double CalcTimeLeft();
@@ -189,6 +215,8 @@ private:
     void EnableCapture(bool start);
     void sendFile(IBLOB* Blobs, IBLOBVectorProperty BlobP, unsigned int len);
     void* createFITS(int bpp, size_t *size, dsp_stream *buf);
+    void* createFITS(const LagBuffer &lags, size_t *size);
+    void* createFITS(int bpp, size_t *size, const void *buf, int naxis, const int *sizes);
     uint8_t* getBuffer(dsp_stream_p in, uint32_t *dims, int **sizes);
     int getFileIndex(const char * dir, const char * prefix, const char * ext);
     // Struct to keep timing
@@ -0,0 +1,46 @@
+/*
+    indi_ahp_xc - lag and baseline buffers of the AHP cross-correlator driver
+    Copyright (C) 2026  agent
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "xc_buffers.h"
+
+void LagBuffer::setLagSize(size_t lags)
+{
+    m_lags = lags;
+    m_rows = 0;
+    m_data.clear();
+}
+
+void LagBuffer::reserve(size_t rows)
+{
+    if (rows * m_lags > m_data.size())
+        m_data.resize(rows * m_lags);
+}
+
+double *LagBuffer::appendRow()
+{
+    size_t needed = (m_rows + 1) * m_lags;
+    if (needed > m_data.size())
+        m_data.resize(std::max(needed, m_data.size() * 2));
+    return m_data.data() + m_rows++ * m_lags;
+}
+
+void LagBuffer::clear()
+{
+    m_rows = 0;
+}
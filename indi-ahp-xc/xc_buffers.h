@@ -0,0 +1,105 @@
+/*
+    indi_ahp_xc - lag and baseline buffers of the AHP cross-correlator driver
+    Copyright (C) 2026  agent
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#pragma once
+
+#include "blockpool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Lag rows of one autocorrelation or crosscorrelation over an integration.
+ *
+ * Every packet appends one row of lagSize() values. The storage is reserved for
+ * the expected number of packets when the integration starts and otherwise grows
+ * by doubling, so the packet loop does not reallocate per row. clear() keeps the
+ * storage for the next integration.
+ */
+class LagBuffer
+{
+    public:
+        void setLagSize(size_t lags);
+        /** Make room for rows rows without growing. */
+        void reserve(size_t rows);
+        /** @return the next row, its content is undefined until written. */
+        double *appendRow();
+        void clear();
+
+        size_t lagSize() const
+        {
+            return m_lags;
+        }
+        size_t rows() const
+        {
+            return m_rows;
+        }
+        size_t capacity() const
+        {
+            return m_lags > 0 ? m_data.size() / m_lags : 0;
+        }
+        const double *data() const
+        {
+            return m_data.data();
+        }
+
+    private:
+        std::vector<double> m_data;
+        size_t m_lags {0};
+        size_t m_rows {0};
+};
+
+/**
+ * Append one packet to the lag buffers of the lines and baselines, spread over the pool.
+ *
+ * Packet is ahp_xc_packet, or a stand-in with the same members in the replay bench.
+ * autocorrelations holds one buffer per line and crosscorrelations one per baseline,
+ * either may be empty when the correlator has no lags of that kind.
+ */
+template <typename Packet>
+void appendLags(const Packet &packet, std::vector<LagBuffer> &autocorrelations, std::vector<LagBuffer> &crosscorrelations,
+                BlockPool &pool)
+{
+    size_t lines = autocorrelations.size();
+    size_t count = lines + crosscorrelations.size();
+    if (count == 0)
+        return;
+
+    // Blocks of a few thousand samples, so handing them out costs less than copying them
+    size_t lags = std::max(lines > 0 ? autocorrelations[0].lagSize() : 0,
+                           crosscorrelations.empty() ? 0 : crosscorrelations[0].lagSize());
+    size_t grain = std::max<size_t>(1, 4096 / std::max<size_t>(1, lags));
+
+    pool.run(count, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            bool line = i < lines;
+            const auto &sample = line ? packet.autocorrelations[i] : packet.crosscorrelations[i - lines];
+            LagBuffer &buffer = line ? autocorrelations[i] : crosscorrelations[i - lines];
+
+            double *row = buffer.appendRow();
+            size_t n = std::min<size_t>(sample.lag_size, buffer.lagSize());
+            for (size_t l = 0; l < n; l++)
+                row[l] = sample.correlations[l].magnitude;
+            std::fill(row + n, row + buffer.lagSize(), 0.0);
+        }
+    }, grain);
+}
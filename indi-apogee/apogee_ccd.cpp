@@ -680,7 +680,6 @@ bool ApogeeCCD::UpdateCCDBin(int binx, int biny)
 
 int ApogeeCCD::grabImage()
 {
-    std::vector<uint16_t> pImageData;
     uint16_t *image = reinterpret_cast<uint16_t*>(PrimaryCCD.getFrameBuffer());
 
     try
@@ -694,10 +693,10 @@ int ApogeeCCD::grabImage()
         }
         else
         {
-            ApgCam->GetImage(pImageData);
+            // Straight into the frame buffer
+            ApgCam->GetImage(image, PrimaryCCD.getFrameBufferSize() / sizeof(uint16_t));
             imageWidth  = ApgCam->GetRoiNumCols();
             imageHeight = ApgCam->GetRoiNumRows();
-            copy(pImageData.begin(), pImageData.end(), image);
         }
         guard.unlock();
     }
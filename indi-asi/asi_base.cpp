@@ -23,6 +23,7 @@
 #include "asi_base.h"
 #include "asi_helpers.h"
 #include "usb_utils.h"
+#include "pixelconvert.h"
 
 #include "config.h"
 
@@ -35,14 +36,17 @@
 #include <map>
 #include <unistd.h>
 #include <cstring>
+#include <thread>
 #include <errno.h>
 
 #define MAX_EXP_RETRIES         2
 #define VERBOSE_EXPOSURE        3
 #define TEMP_TIMER_MS           1000 /* Temperature polling time (ms) */
 #define TEMP_THRESHOLD          .25  /* Differential temperature threshold (C)*/
+#define STREAM_STATS_MS         1000 /* Stream statistics update period (ms) */
 
 #define CONTROL_TAB "Controls"
+#define STREAMING_TAB "Streaming"
 
 static bool warn_roi_height = true;
 static bool warn_roi_width = true;
@@ -58,6 +62,15 @@ void ASIBase::workerStreamVideo(const std::atomic_bool &isAboutToQuit)
     double ExposureRequest = 1.0 / Streamer->getTargetFPS();
     long uSecs = static_cast<long>(ExposureRequest * 950000.0);
 
+    uint32_t totalBytes = PrimaryCCD.getFrameBufferSize();
+    size_t bufferCount  = static_cast<size_t>(StreamBuffersNP[0].getValue());
+    if (mFramePool.reset(bufferCount, totalBytes) == false)
+    {
+        LOGF_ERROR("Failed to allocate %zu stream buffers of %u bytes.", bufferCount, totalBytes);
+        Streamer->setStream(false);
+        return;
+    }
+
     ret = ASISetControlValue(mCameraInfo.CameraID, ASI_EXPOSURE, uSecs, ASI_FALSE);
     if (ret != ASI_SUCCESS)
     {
@@ -70,15 +83,25 @@ void ASIBase::workerStreamVideo(const std::atomic_bool &isAboutToQuit)
         LOGF_ERROR("Failed to start video capture (%s).", Helpers::toString(ret));
     }
 
+    // Frames are published from a separate thread so a slow encoder or recorder never stalls USB capture.
+    std::thread publisher(&ASIBase::publishStreamFrames, this);
+
     while (!isAboutToQuit)
     {
-        uint8_t *targetFrame = PrimaryCCD.getFrameBuffer();
-        uint32_t totalBytes  = PrimaryCCD.getFrameBufferSize();
-        int waitMS           = static_cast<int>((ExposureRequest * 2000.0) + 500);
+        FramePool::Frame *targetFrame = mFramePool.acquire();
+        int waitMS                    = static_cast<int>((ExposureRequest * 2000.0) + 500);
 
-        ret = ASIGetVideoData(mCameraInfo.CameraID, targetFrame, totalBytes, waitMS);
+        if (targetFrame == nullptr)
+        {
+            usleep(100);
+            continue;
+        }
+
+        ret = ASIGetVideoData(mCameraInfo.CameraID, targetFrame->data(), totalBytes, waitMS);
         if (ret != ASI_SUCCESS)
         {
+            mFramePool.recycle(targetFrame);
+
             if (ret != ASI_ERROR_TIMEOUT)
             {
                 Streamer->setStream(false);
@@ -90,14 +113,48 @@ void ASIBase::workerStreamVideo(const std::atomic_bool &isAboutToQuit)
             continue;
         }
 
+        targetFrame->size = totalBytes;
+        mFramePool.publish(targetFrame);
+    }
+
+    ASIStopVideoCapture(mCameraInfo.CameraID);
+
+    mFramePool.abort();
+    publisher.join();
+
+    updateStreamStats();
+    mFramePool.clear();
+}
+
+void ASIBase::publishStreamFrames()
+{
+    INDI::ElapsedTimer statsTimer;
+
+    statsTimer.start();
+
+    while (FramePool::Frame *frame = mFramePool.next())
+    {
         if (mCurrentVideoFormat == ASI_IMG_RGB24)
-            for (uint32_t i = 0; i < totalBytes; i += 3)
-                std::swap(targetFrame[i], targetFrame[i + 2]);
+            PixelConvert::swapRB8(frame->data(), frame->size / 3, 3);
 
-        Streamer->newFrame(targetFrame, totalBytes);
+        Streamer->newFrame(frame->data(), frame->size);
+        mFramePool.recycle(frame);
+
+        if (statsTimer.elapsed() >= STREAM_STATS_MS)
+        {
+            updateStreamStats();
+            statsTimer.start();
+        }
     }
+}
 
-    ASIStopVideoCapture(mCameraInfo.CameraID);
+void ASIBase::updateStreamStats()
+{
+    StreamStatsNP[STREAM_FRAMES].setValue(mFramePool.published());
+    StreamStatsNP[STREAM_DROPPED].setValue(mFramePool.dropped());
+    StreamStatsNP[STREAM_QUEUE_DEPTH].setValue(mFramePool.depth());
+    StreamStatsNP.setState(mFramePool.dropped() > 0 ? IPS_BUSY : IPS_OK);
+    StreamStatsNP.apply();
 }
 
 void ASIBase::workerBlinkExposure(const std::atomic_bool &isAboutToQuit, int blinks, float duration)
@@ -422,6 +479,15 @@ bool ASIBase::initProperties()
     BlinkNP.fill(getDeviceName(), "BLINK", "Blink", CONTROL_TAB, IP_RW, 60, IPS_IDLE);
     BlinkNP.load();
 
+    StreamBuffersNP[0].fill("BUFFERS", "Buffers", "%2.0f", 2, 32, 1, 4);
+    StreamBuffersNP.fill(getDeviceName(), "STREAM_BUFFERS", "Frame Pool", STREAMING_TAB, IP_RW, 60, IPS_IDLE);
+    StreamBuffersNP.load();
+
+    StreamStatsNP[STREAM_FRAMES     ].fill("FRAMES",      "Captured",    "%.f", 0, 1e12, 0, 0);
+    StreamStatsNP[STREAM_DROPPED    ].fill("DROPPED",     "Dropped",     "%.f", 0, 1e12, 0, 0);
+    StreamStatsNP[STREAM_QUEUE_DEPTH].fill("QUEUE_DEPTH", "Queue depth", "%.f", 0, 32,   0, 0);
+    StreamStatsNP.fill(getDeviceName(), "STREAM_STATS", "Frame Stats", STREAMING_TAB, IP_RO, 60, IPS_IDLE);
+
     BayerTP[2].setText(getBayerString());
 
     ADCDepthNP[0].fill("BITS", "Bits", "%2.0f", 0, 32, 1, mCameraInfo.BitDepth);
@@ -551,6 +617,8 @@ bool ASIBase::updateProperties()
         }
 
         defineProperty(BlinkNP);
+        defineProperty(StreamBuffersNP);
+        defineProperty(StreamStatsNP);
         defineProperty(ADCDepthNP);
         defineProperty(SDKVersionSP);
         if (!mSerialNumber.empty())
@@ -584,6 +652,8 @@ bool ASIBase::updateProperties()
             deleteProperty(VideoFormatSP);
 
         deleteProperty(BlinkNP);
+        deleteProperty(StreamBuffersNP);
+        deleteProperty(StreamStatsNP);
         deleteProperty(SDKVersionSP);
         if (!mSerialNumber.empty())
         {
@@ -864,6 +934,15 @@ bool ASIBase::ISNewNumber(const char *dev, const char *name, double values[], ch
             saveConfig(BlinkNP);
             return true;
         }
+
+        if (StreamBuffersNP.isNameMatch(name))
+        {
+            // The pool is sized when streaming starts, so a running stream keeps its current buffers.
+            StreamBuffersNP.setState(StreamBuffersNP.update(values, names, n) ? IPS_OK : IPS_ALERT);
+            StreamBuffersNP.apply();
+            saveConfig(StreamBuffersNP);
+            return true;
+        }
     }
 
     return INDI::CCD::ISNewNumber(dev, name, values, names, n);
@@ -1274,14 +1353,11 @@ int ASIBase::grabImage(float duration)
     int nChannels = (type == ASI_IMG_RGB24) ? 3 : 1;
     size_t nTotalBytes = subW * subH * nChannels * (PrimaryCCD.getBPP() / 8);
 
+    // RGB24 is read into a scratch buffer kept across exposures, then split into planes.
     if (type == ASI_IMG_RGB24)
     {
-        buffer = static_cast<uint8_t *>(malloc(nTotalBytes));
-        if (buffer == nullptr)
-        {
-            LOGF_ERROR("%s: %d malloc failed (RGB 24).", getDeviceName());
-            return -1;
-        }
+        mRGBBuffer.resize(nTotalBytes);
+        buffer = mRGBBuffer.data();
     }
 
     ret = ASIGetDataAfterExp(mCameraInfo.CameraID, buffer, nTotalBytes);
@@ -1291,29 +1367,11 @@ int ASIBase::grabImage(float duration)
             "Failed to get data after exposure (%dx%d #%d channels) (%s).",
             subW, subH, nChannels, Helpers::toString(ret)
         );
-        if (type == ASI_IMG_RGB24)
-            free(buffer);
         return -1;
     }
 
     if (type == ASI_IMG_RGB24)
-    {
-        uint8_t *dstR = image;
-        uint8_t *dstG = image + subW * subH;
-        uint8_t *dstB = image + subW * subH * 2;
-
-        const uint8_t *src = buffer;
-        const uint8_t *end = buffer + subW * subH * 3;
-
-        while (src != end)
-        {
-            *dstB++ = *src++;
-            *dstG++ = *src++;
-            *dstR++ = *src++;
-        }
-
-        free(buffer);
-    }
+        PixelConvert::deinterleave8(buffer, image, subW * subH, 3, PixelConvert::ORDER_BGR);
     guard.unlock();
 
     PrimaryCCD.setNAxis(type == ASI_IMG_RGB24 ? 3 : 2);
@@ -1707,6 +1765,7 @@ bool ASIBase::saveConfigItems(FILE *fp)
         VideoFormatSP.save(fp);
 
     BlinkNP.save(fp);
+    StreamBuffersNP.save(fp);
 
     USBResetSP.save(fp);
 
@@ -30,6 +30,8 @@
 #include "indipropertytext.h"
 #include "indisinglethreadpool.h"
 
+#include "framepool.h"
+
 #include <vector>
 
 #include <indiccd.h>
@@ -93,6 +95,12 @@ class ASIBase : public INDI::CCD
         void workerBlinkExposure(const std::atomic_bool &isAboutToQuit, int blinks, float duration);
         void workerExposure(const std::atomic_bool &isAboutToQuit, float duration);
 
+        /** Video frame pool shared by the SDK read thread and the streamer */
+        FramePool mFramePool {FramePool::DROP_OLDEST};
+        /** Publish frames queued by workerStreamVideo until the pool is aborted */
+        void publishStreamFrames();
+        void updateStreamStats();
+
         /** Get image from CCD and send it to client */
         int grabImage(float duration);
 
@@ -158,6 +166,15 @@ class ASIBase : public INDI::CCD
             BLINK_DURATION
         };
 
+        INDI::PropertyNumber  StreamBuffersNP {1};
+        INDI::PropertyNumber  StreamStatsNP {3};
+        enum
+        {
+            STREAM_FRAMES,
+            STREAM_DROPPED,
+            STREAM_QUEUE_DEPTH
+        };
+
         INDI::PropertySwitch  FlipSP {2};
         enum
         {
@@ -171,5 +188,6 @@ class ASIBase : public INDI::CCD
         ASI_CAMERA_INFO mCameraInfo;
         uint8_t mExposureRetry {0};
         ASI_IMG_TYPE mCurrentVideoFormat;
+        std::vector<uint8_t> mRGBBuffer;
         std::vector<ASI_CONTROL_CAPS> mControlCaps;
 };
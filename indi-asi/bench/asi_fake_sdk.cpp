@@ -0,0 +1,306 @@
+/*
+    Synthetic ASI SDK for the Driver Benchmark
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "asi_fake_sdk.h"
+
+#include <cstring>
+#include <map>
+#include <mutex>
+
+namespace
+{
+
+struct Control
+{
+    const char *name;
+    ASI_CONTROL_TYPE type;
+    long min, max, def;
+    ASI_BOOL autoSupported;
+    ASI_BOOL writable;
+};
+
+const Control controls[] =
+{
+    {"Gain",          ASI_GAIN,              0, 600,        0,     ASI_TRUE,  ASI_TRUE},
+    {"Exposure",      ASI_EXPOSURE,          32, 2000000000, 10000, ASI_TRUE,  ASI_TRUE},
+    {"Offset",        ASI_OFFSET,            0, 80,         8,     ASI_FALSE, ASI_TRUE},
+    {"BandWidth",     ASI_BANDWIDTHOVERLOAD, 40, 100,       50,    ASI_TRUE,  ASI_TRUE},
+    {"Flip",          ASI_FLIP,              0, 3,          0,     ASI_FALSE, ASI_TRUE},
+    {"HighSpeedMode", ASI_HIGH_SPEED_MODE,   0, 1,          0,     ASI_FALSE, ASI_TRUE},
+    {"Temperature",   ASI_TEMPERATURE,       -500, 1000,    200,   ASI_FALSE, ASI_FALSE},
+};
+
+struct Camera
+{
+    ASI_CAMERA_INFO info {};
+
+    std::mutex mutex;
+    std::map<int, long> values;
+    int width {0}, height {0}, bin {1}, startX {0}, startY {0};
+    ASI_IMG_TYPE type {ASI_IMG_RAW16};
+
+    CameraBench::FakeSensor sensor;
+} camera;
+
+char sdkVersion[] = "1.0.0-fake";
+
+size_t frameBytes()
+{
+    size_t bytes = static_cast<size_t>(camera.width) * camera.height;
+    if (camera.type == ASI_IMG_RAW16)
+        bytes *= 2;
+    else if (camera.type == ASI_IMG_RGB24)
+        bytes *= 3;
+    return bytes;
+}
+
+}
+
+namespace FakeASI
+{
+
+void configure(const CameraBench::Options &options)
+{
+    camera.sensor.configure(options);
+
+    ASI_CAMERA_INFO &info = camera.info;
+    memset(&info, 0, sizeof(info));
+    snprintf(info.Name, sizeof(info.Name), "ZWO ASI Fake%s", options.color ? "MC" : "MM");
+    info.CameraID     = 0;
+    info.MaxWidth     = options.width;
+    info.MaxHeight    = options.height;
+    info.IsColorCam   = options.color ? ASI_TRUE : ASI_FALSE;
+    info.BayerPattern = ASI_BAYER_RG;
+    info.SupportedBins[0] = 1;
+    info.SupportedBins[1] = 2;
+    info.SupportedBins[2] = 4;
+    int f = 0;
+    info.SupportedVideoFormat[f++] = ASI_IMG_RAW8;
+    if (options.color)
+        info.SupportedVideoFormat[f++] = ASI_IMG_RGB24;
+    info.SupportedVideoFormat[f++] = ASI_IMG_RAW16;
+    info.SupportedVideoFormat[f++] = ASI_IMG_END;
+    info.PixelSize    = 2.9;
+    info.ST4Port      = ASI_TRUE;
+    info.IsUSB3Host   = ASI_TRUE;
+    info.IsUSB3Camera = ASI_TRUE;
+    info.ElecPerADU   = 1.0f;
+    info.BitDepth     = 12;
+
+    for (const auto &it : controls)
+        camera.values[it.type] = it.def;
+
+    camera.width  = options.width;
+    camera.height = options.height;
+    camera.type   = options.color ? ASI_IMG_RGB24 : (options.bitDepth == 8 ? ASI_IMG_RAW8 : ASI_IMG_RAW16);
+    camera.sensor.setFrameBytes(frameBytes());
+    camera.sensor.setExposureMs(camera.values[ASI_EXPOSURE] / 1000.0);
+}
+
+ASI_CAMERA_INFO cameraInfo()
+{
+    return camera.info;
+}
+
+double lastPullEnd()
+{
+    return camera.sensor.lastPullEnd();
+}
+
+}
+
+extern "C" {
+
+int ASIGetNumOfConnectedCameras()
+{
+    return 1;
+}
+
+ASI_ERROR_CODE ASIGetCameraProperty(ASI_CAMERA_INFO *pASICameraInfo, int iCameraIndex)
+{
+    if (iCameraIndex != 0)
+        return ASI_ERROR_INVALID_INDEX;
+    *pASICameraInfo = camera.info;
+    return ASI_SUCCESS;
+}
+
+ASI_ERROR_CODE ASIOpenCamera(int)
+{
+    return ASI_SUCCESS;
+}
+
+ASI_ERROR_CODE ASIInitCamera(int)
+{
+    return ASI_SUCCESS;
+}
+
+ASI_ERROR_CODE ASICloseCamera(int)
+{
+    return ASI_SUCCESS;
+}
+
+ASI_ERROR_CODE ASIGetNumOfControls(int, int *piNumberOfControls)
+{
+    *piNumberOfControls = sizeof(controls) / sizeof(controls[0]);
+    return ASI_SUCCESS;
+}
+
+ASI_ERROR_CODE ASIGetControlCaps(int, int iControlIndex, ASI_CONTROL_CAPS *pControlCaps)
+{
+    if (iControlIndex < 0 || iControlIndex >= static_cast<int>(sizeof(controls) / sizeof(controls[0])))
+        return ASI_ERROR_INVALID_CONTROL_TYPE;
+
+    const Control &it = controls[iControlIndex];
+    memset(pControlCaps, 0, sizeof(*pControlCaps));
+    snprintf(pControlCaps->Name, sizeof(pControlCaps->Name), "%s", it.name);
+    snprintf(pControlCaps->Description, sizeof(pControlCaps->Description), "%s", it.name);
+    pControlCaps->MinValue        = it.min;
+    pControlCaps->MaxValue        = it.max;
+    pControlCaps->DefaultValue    = it.def;
+    pControlCaps->IsAutoSupported = it.autoSupported;
+    pControlCaps->IsWritable      = it.writable;
+    pControlCaps->ControlType     = it.type;
+    return ASI_SUCCESS;
+}
+
+ASI_ERROR_CODE ASIGetControlValue(int, ASI_CONTROL_TYPE ControlType, long *plValue, ASI_BOOL *pbAuto)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    auto it = camera.values.find(ControlType);
+    if (it == camera.values.end())
+        return ASI_ERROR_INVALID_CONTROL_TYPE;
+    *plValue = it->second;
+    if (pbAuto)
+        *pbAuto = ASI_FALSE;
+    return ASI_SUCCESS;
+}
+
+ASI_ERROR_CODE ASISetControlValue(int, ASI_CONTROL_TYPE ControlType, long lValue, ASI_BOOL)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    auto it = camera.values.find(ControlType);
+    if (it == camera.values.end())
+        return ASI_ERROR_INVALID_CONTROL_TYPE;
+    it->second = lValue;
+    if (ControlType == ASI_EXPOSURE)
+        camera.sensor.setExposureMs(lValue / 1000.0);
+    return ASI_SUCCESS;
+}
+
+ASI_ERROR_CODE ASISetROIFormat(int, int iWidth, int iHeight, int iBin, ASI_IMG_TYPE Img_type)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    if (iWidth <= 0 || iHeight <= 0 || iWidth * iBin > camera.info.MaxWidth || iHeight * iBin > camera.info.MaxHeight)
+        return ASI_ERROR_INVALID_SIZE;
+    camera.width  = iWidth;
+    camera.height = iHeight;
+    camera.bin    = iBin;
+    camera.type   = Img_type;
+    camera.sensor.setFrameBytes(frameBytes());
+    return ASI_SUCCESS;
+}
+
+ASI_ERROR_CODE ASIGetROIFormat(int, int *piWidth, int *piHeight, int *piBin, ASI_IMG_TYPE *pImg_type)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    *piWidth   = camera.width;
+    *piHeight  = camera.height;
+    *piBin     = camera.bin;
+    *pImg_type = camera.type;
+    return ASI_SUCCESS;
+}
+
+ASI_ERROR_CODE ASISetStartPos(int, int iStartX, int iStartY)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    camera.startX = iStartX;
+    camera.startY = iStartY;
+    return ASI_SUCCESS;
+}
+
+ASI_ERROR_CODE ASIStartVideoCapture(int)
+{
+    camera.sensor.startVideo();
+    return ASI_SUCCESS;
+}
+
+ASI_ERROR_CODE ASIStopVideoCapture(int)
+{
+    camera.sensor.stopVideo();
+    return ASI_SUCCESS;
+}
+
+ASI_ERROR_CODE ASIGetVideoData(int, unsigned char *pBuffer, long lBuffSize, int iWaitms)
+{
+    if (!camera.sensor.capturing())
+        return ASI_ERROR_INVALID_SEQUENCE;
+    if (!camera.sensor.waitVideoFrame(iWaitms))
+        return ASI_ERROR_TIMEOUT;
+    if (camera.sensor.pull(pBuffer, lBuffSize, "video_pull") == 0)
+        return ASI_ERROR_BUFFER_TOO_SMALL;
+    return ASI_SUCCESS;
+}
+
+ASI_ERROR_CODE ASIPulseGuideOn(int, ASI_GUIDE_DIRECTION)
+{
+    return ASI_SUCCESS;
+}
+
+ASI_ERROR_CODE ASIPulseGuideOff(int, ASI_GUIDE_DIRECTION)
+{
+    return ASI_SUCCESS;
+}
+
+ASI_ERROR_CODE ASIStartExposure(int, ASI_BOOL)
+{
+    camera.sensor.startExposure();
+    return ASI_SUCCESS;
+}
+
+ASI_ERROR_CODE ASIStopExposure(int)
+{
+    camera.sensor.stopExposure();
+    return ASI_SUCCESS;
+}
+
+ASI_ERROR_CODE ASIGetExpStatus(int, ASI_EXPOSURE_STATUS *pExpStatus)
+{
+    if (camera.sensor.exposureDone())
+        *pExpStatus = ASI_EXP_SUCCESS;
+    else if (camera.sensor.exposing())
+        *pExpStatus = ASI_EXP_WORKING;
+    else
+        *pExpStatus = ASI_EXP_IDLE;
+    return ASI_SUCCESS;
+}
+
+ASI_ERROR_CODE ASIGetDataAfterExp(int, unsigned char *pBuffer, long lBuffSize)
+{
+    if (camera.sensor.pull(pBuffer, lBuffSize, "pull") == 0)
+        return ASI_ERROR_BUFFER_TOO_SMALL;
+    return ASI_SUCCESS;
+}
+
+char *ASIGetSDKVersion()
+{
+    return sdkVersion;
+}
+
+}
@@ -27,16 +27,28 @@
 #include <stream/streammanager.h>
 
 #include <algorithm>
+#include <errno.h>
 #include <math.h>
+#include <string.h>
+#include <time.h>
 #include <unistd.h>
+#include <chrono>
+#include <cstddef>
 #include <deque>
+#include <map>
 #include <memory>
+#include <mutex>
 
 #define MAX_CONNECTION_RETRIES  5
 #define MAX_EXP_RETRIES         3
 #define VERBOSE_EXPOSURE        3
 #define TEMP_TIMER_MS           1000 /* Temperature polling time (ms) */
 #define TEMP_THRESHOLD          .25  /* Differential temperature threshold (C)*/
+#define STREAM_FRAMES           4    /* Frames buffered between the fast mode callback and the streamer */
+#define STREAM_WAIT_MS          100  /* Longest wait for a streamed frame before checking for a stop request (ms) */
+#define ENCODE_FRAMES           2    /* Frames owned by the driver, one being encoded while the next is downloaded */
+#define ENCODE_WAIT_MS          1000 /* Longest wait of the encoding thread before checking for a stop request (ms) */
+#define FRAME_WAIT_MS           60000 /* Longest wait for the encoding thread to free a frame buffer (ms) */
 
 #define CONTROL_TAB "Controls"
 
@@ -98,6 +110,16 @@ static class Loader
         }
 } loader;
 
+// The fast mode callback only identifies the camera by its handle
+static std::mutex fastCallbackMutex;
+static std::map<ArtemisHandle, ATIKCCD *> fastCallbackCameras;
+
+// Monotonic time in seconds, for frame timing
+static double timeNow()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 ATIKCCD::ATIKCCD(std::string filterName, int id) : FilterInterface(this), m_iDevice(id)
 {
     setVersion(ATIK_VERSION_MAJOR, ATIK_VERSION_MINOR);
@@ -110,6 +132,11 @@ ATIKCCD::ATIKCCD(std::string filterName, int id) : FilterInterface(this), m_iDev
     setDeviceName(this->name);
 }
 
+ATIKCCD::~ATIKCCD()
+{
+    stopEncoder();
+}
+
 const char *ATIKCCD::getDefaultName()
 {
     return "Atik";
@@ -179,11 +206,31 @@ bool ATIKCCD::initProperties()
     IUFillSwitch(&FastModeS[FASTMODE_POWERSAVE], "CONTROL_POWERSAVE", "Powersave / Low noise", ISS_OFF);
     IUFillSwitch(&FastModeS[FASTMODE_NORMAL], "CONTROL_NORMAL", "Normal", ISS_OFF);
     IUFillSwitch(&FastModeS[FASTMODE_FAST], "CONTROL_FAST", "Fast / Stream", ISS_OFF);
-    // TODO: Implement fast mode 'fast' then increase SwitchVector size to 3
-    IDLog("Warning: Exposure speed 'fast' is not implemented in this version.");
+    // Fast speed is only for streaming, StartStreaming() selects it and restores the previous speed afterwards
     IUFillSwitchVector(&FastModeSP, FastModeS, 2, getDeviceName(), "CCD_FAST_MODE", "Fast Mode", CONTROLS_TAB, IP_RW,
                        ISR_1OFMANY, 60, IPS_IDLE);
 
+    // Sequence mode
+    IUFillSwitch(&OverlapS[OVERLAP_OFF], "OVERLAP_OFF", "Single", ISS_ON);
+    IUFillSwitch(&OverlapS[OVERLAP_ON], "OVERLAP_ON", "Overlapped", ISS_OFF);
+    IUFillSwitch(&OverlapS[OVERLAP_CONTINUOUS], "OVERLAP_CONTINUOUS", "Continuous", ISS_OFF);
+    IUFillSwitchVector(&OverlapSP, OverlapS, 3, getDeviceName(), "CCD_SEQUENCE_MODE", "Sequence Mode", CONTROLS_TAB, IP_RW,
+                       ISR_1OFMANY, 60, IPS_IDLE);
+
+    // Frame timing
+    IUFillNumber(&FrameTimingN[TIMING_FPS], "TIMING_FPS", "Frame rate (fps)", "%.2f", 0, 1000, 0, 0);
+    IUFillNumber(&FrameTimingN[TIMING_DEAD_TIME], "TIMING_DEAD_TIME", "Dead time (ms)", "%.1f", 0, 1e6, 0, 0);
+    IUFillNumber(&FrameTimingN[TIMING_DROPPED], "TIMING_DROPPED", "Dropped frames", "%.f", 0, 1e9, 0, 0);
+    IUFillNumberVector(&FrameTimingNP, FrameTimingN, 3, getDeviceName(), "CCD_FRAME_TIMING", "Frame Timing", CONTROLS_TAB,
+                       IP_RO, 60, IPS_IDLE);
+
+    // Frame latency
+    IUFillNumber(&FrameLatencyN[LATENCY_DOWNLOAD], "LATENCY_DOWNLOAD", "Download (ms)", "%.1f", 0, 1e6, 0, 0);
+    IUFillNumber(&FrameLatencyN[LATENCY_HANDOFF], "LATENCY_HANDOFF", "Hand-off (ms)", "%.1f", 0, 1e6, 0, 0);
+    IUFillNumber(&FrameLatencyN[LATENCY_ENCODE], "LATENCY_ENCODE", "Encode (ms)", "%.1f", 0, 1e6, 0, 0);
+    IUFillNumberVector(&FrameLatencyNP, FrameLatencyN, 3, getDeviceName(), "CCD_FRAME_LATENCY", "Frame Latency", CONTROLS_TAB,
+                       IP_RO, 60, IPS_IDLE);
+
 #if 0
     // Bit send format
     IUFillSwitch(&BitSendS[BITSEND_16BITS], "BITSEND_16BITS", "16BITS", ISS_OFF);
@@ -241,6 +288,14 @@ bool ATIKCCD::updateProperties()
             //loadConfig(true, "CCD_BIT_SEND");
         }
 
+        if (m_CanOverlap || m_CanContinuous)
+        {
+            defineProperty(&OverlapSP);
+            loadConfig(true, "CCD_SEQUENCE_MODE");
+        }
+        defineProperty(&FrameTimingNP);
+        defineProperty(&FrameLatencyNP);
+
         if (m_CameraFlags & ARTEMIS_PROPERTIES_CAMERAFLAGS_HAS_FILTERWHEEL)
             INDI::FilterInterface::updateProperties();
 
@@ -268,6 +323,11 @@ bool ATIKCCD::updateProperties()
             // deleteProperty(BitSendSP.name); // unused
         }
 
+        if (m_CanOverlap || m_CanContinuous)
+            deleteProperty(OverlapSP.name);
+        deleteProperty(FrameTimingNP.name);
+        deleteProperty(FrameLatencyNP.name);
+
         if (m_CameraFlags & ARTEMIS_PROPERTIES_CAMERAFLAGS_HAS_FILTERWHEEL)
             INDI::FilterInterface::updateProperties();
 
@@ -309,6 +369,12 @@ bool ATIKCCD::setupParams()
     SetCCDParams(pProp.nPixelsX, pProp.nPixelsY, 16, pProp.PixelMicronsX, pProp.PixelMicronsY);
     // Set frame buffer size
     PrimaryCCD.setFrameBufferSize(PrimaryCCD.getXRes() * PrimaryCCD.getYRes() * PrimaryCCD.getBPP() / 8, false);
+    m_SubX = PrimaryCCD.getSubX();
+    m_SubY = PrimaryCCD.getSubY();
+    m_SubW = PrimaryCCD.getSubW();
+    m_SubH = PrimaryCCD.getSubH();
+    m_BinX = PrimaryCCD.getBinX();
+    m_BinY = PrimaryCCD.getBinY();
 
     m_CameraFlags = pProp.cameraflags;
     LOGF_DEBUG("Camera flags: %d", m_CameraFlags);
@@ -390,6 +456,19 @@ bool ATIKCCD::setupParams()
         cap |= CCD_HAS_ST4_PORT;
     }
 
+    // Can we stream?
+    if (ArtemisHasFastMode(hCam))
+    {
+        LOG_DEBUG("Camera supports fast mode streaming.");
+        cap |= CCD_HAS_STREAMING;
+    }
+
+    // Can the next exposure integrate while the previous one is downloaded?
+    m_CanOverlap = (m_CameraFlags & ARTEMIS_PROPERTIES_CAMERAFLAGS_HAS_OVERLAP_MODE) != 0;
+    m_CanContinuous = ArtemisContinuousExposingModeSupported(hCam);
+    LOGF_DEBUG("Camera overlapped exposures: %s, continuous exposures: %s", m_CanOverlap ? "yes" : "no",
+               m_CanContinuous ? "yes" : "no");
+
     // Done with the capabilities!
     SetCCDCapability(cap);
 
@@ -469,7 +548,7 @@ bool ATIKCCD::setupParams()
             if (0 <= index && index < (int)(sizeof(FastModeS) / sizeof(FastModeS[0])))
             {
                 if (index == FASTMODE_FAST)
-                    LOG_WARN("Warning: fast mode exposure speed is not implemented, please choose another mode.");
+                    LOG_WARN("Warning: fast exposure speed is only used for streaming, please choose another mode.");
                 FastModeS[index].s = ISS_ON;
             }
             else LOG_WARN("Warning: camera is currently configured with an unknown Fast Mode state.");
@@ -530,6 +609,12 @@ bool ATIKCCD::setupParams()
         PrimaryCCD.setMinMaxStep("CCD_EXPOSURE", "CCD_EXPOSURE_VALUE", 0.001, 3600 * 24, 1, false);
     }
 
+    // Frames are allocated on first use, then kept for the whole session
+    m_EncodePool.reset(ENCODE_FRAMES, 0);
+    m_SendingFrame = nullptr;
+    m_EncodeQuit = false;
+    m_EncodeThread = std::thread(&ATIKCCD::encodeFrames, this);
+
     // Create imaging thread
     threadRequest = StateIdle;
     threadState = StateNone;
@@ -657,7 +742,11 @@ bool ATIKCCD::Disconnect()
     threadRequest = StateTerminate;
     pthread_cond_signal(&cv);
     pthread_mutex_unlock(&condMutex);
+    m_StreamPool.close();
     pthread_join(imagingThread, nullptr);
+    if (tState == StateStream)
+        stopFastExposure();
+    stopEncoder();
     tState = StateNone;
     if (isSimulation() == false)
     {
@@ -998,6 +1087,26 @@ bool ATIKCCD::ISNewSwitch(const char *dev, const char *name, ISState *states, ch
             IDSetSwitch(&v, nullptr);
             return true;
         }
+        else if (!strcmp(name, OverlapSP.name))
+        {
+            int prevIndex = IUFindOnSwitchIndex(&OverlapSP);
+            IUUpdateSwitch(&OverlapSP, states, names, n);
+            int targetIndex = IUFindOnSwitchIndex(&OverlapSP);
+            if (setSequenceMode(targetIndex))
+            {
+                OverlapSP.s = IPS_OK;
+                LOGF_INFO("Sequence mode set to %s.", OverlapS[targetIndex].label);
+            }
+            else
+            {
+                OverlapSP.s = IPS_ALERT;
+                IUResetSwitch(&OverlapSP);
+                OverlapS[prevIndex].s = ISS_ON;
+            }
+
+            IDSetSwitch(&OverlapSP, nullptr);
+            return true;
+        }
 #if 0
         else if (!strcmp(name, BitSendSP.name))
         {
@@ -1104,9 +1213,12 @@ bool ATIKCCD::StartExposure(float duration)
     PrimaryCCD.setExposureDuration(duration);
     ExposureRequest = duration;
 
+    // In overlapped and continuous modes the camera may already be integrating this exposure
+    int sequenceMode = IUFindOnSwitchIndex(&OverlapSP);
+
     // Camera needs to be in idle state to start exposure after previous abort
     int maxWaitCount = 1000; // 1000 * 0.1s = 100s
-    while (ArtemisCameraState(hCam) != CAMERA_IDLE && --maxWaitCount > 0)
+    while (sequenceMode == OVERLAP_OFF && ArtemisCameraState(hCam) != CAMERA_IDLE && --maxWaitCount > 0)
     {
         LOG_DEBUG("Waiting camera to be idle...");
         usleep(100000);
@@ -1135,7 +1247,20 @@ bool ATIKCCD::StartExposure(float duration)
     ArtemisSetDarkMode(hCam, PrimaryCCD.getFrameType() == INDI::CCDChip::DARK_FRAME ||
                        PrimaryCCD.getFrameType() == INDI::CCDChip::BIAS_FRAME);
 
-    int rc = ArtemisStartExposure(hCam, duration);
+    int rc = ARTEMIS_OK;
+    if (sequenceMode == OVERLAP_ON)
+    {
+        // The exposure time only needs to be set again when it or another setting changed
+        if (duration != m_OverlapDuration || !ArtemisOverlappedExposureValid(hCam))
+        {
+            rc = ArtemisSetOverlappedExposureTime(hCam, duration);
+            m_OverlapDuration = (rc == ARTEMIS_OK) ? duration : -1;
+        }
+        if (rc == ARTEMIS_OK)
+            rc = ArtemisStartOverlappedExposure(hCam);
+    }
+    else
+        rc = ArtemisStartExposure(hCam, duration);
 
     if (rc != ARTEMIS_OK)
     {
@@ -1144,6 +1269,7 @@ bool ATIKCCD::StartExposure(float duration)
     }
 
     gettimeofday(&ExpStart, nullptr);
+    m_ExposureStarted = timeNow();
     if (ExposureRequest > VERBOSE_EXPOSURE)
         LOGF_INFO("Taking a %g seconds frame...", ExposureRequest);
 
@@ -1173,9 +1299,196 @@ bool ATIKCCD::AbortExposure()
     pthread_mutex_unlock(&condMutex);
     ArtemisStopExposure(hCam);
     InExposure = false;
+    m_OverlapDuration = -1;
+    m_FrameTiming.reset();
+    return true;
+}
+
+/////////////////////////////////////////////////////////
+/// Start fast mode streaming, frames arrive in fastCallback()
+/////////////////////////////////////////////////////////
+bool ATIKCCD::StartStreaming()
+{
+    m_StreamExposure = 1.0 / Streamer->getTargetFPS();
+
+    // Horizon cameras only stream at fast exposure speed
+    if (m_isHorizon)
+    {
+        uint16_t value = FASTMODE_FAST;
+        if (ARTEMIS_OK != ArtemisCameraSpecificOptionSetData(hCam, ID_AtikHorizonExposureSpeed, reinterpret_cast<uint8_t*>(&value),
+                2))
+        {
+            LOG_ERROR("Failed setting fast exposure speed for streaming.");
+            return false;
+        }
+        m_StreamRestoreSpeed = IUFindOnSwitchIndex(&FastModeSP);
+    }
+
+    Streamer->setPixelFormat(HasBayer() ? INDI_BAYER_RGGB : INDI_MONO, 16);
+
+    size_t frameSize = PrimaryCCD.getSubW() / PrimaryCCD.getBinX() * PrimaryCCD.getSubH() / PrimaryCCD.getBinY() *
+                       PrimaryCCD.getBPP() / 8;
+    m_StreamPool.reset(STREAM_FRAMES, frameSize);
+    m_FrameTiming.reset();
+    m_SdkDroppedFrames = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(fastCallbackMutex);
+        fastCallbackCameras[hCam] = this;
+    }
+    ArtemisSetFastCallbackEx(hCam, &ATIKCCD::fastCallbackHelper);
+
+    int ms = std::max(1, static_cast<int>(m_StreamExposure * 1000.0));
+    if (!ArtemisStartFastExposure(hCam, ms))
+    {
+        LOG_ERROR("Failed to start fast exposures.");
+        stopFastExposure();
+        return false;
+    }
+
+    LOGF_INFO("Starting video streaming with exposure %d ms (%.f FPS)", ms, Streamer->getTargetFPS());
+
+    pthread_mutex_lock(&condMutex);
+    threadRequest = StateStream;
+    pthread_cond_signal(&cv);
+    pthread_mutex_unlock(&condMutex);
+
+    return true;
+}
+
+/////////////////////////////////////////////////////////
+/// Stop fast mode streaming
+/////////////////////////////////////////////////////////
+bool ATIKCCD::StopStreaming()
+{
+    pthread_mutex_lock(&condMutex);
+    threadRequest = StateAbort;
+    pthread_cond_signal(&cv);
+    m_StreamPool.close();
+    while (threadState == StateStream)
+    {
+        pthread_cond_wait(&cv, &condMutex);
+    }
+    pthread_mutex_unlock(&condMutex);
+
+    stopFastExposure();
+    return true;
+}
+
+/////////////////////////////////////////////////////////
+/// Stop fast exposures and restore the exposure speed
+/////////////////////////////////////////////////////////
+void ATIKCCD::stopFastExposure()
+{
+    ArtemisStopExposure(hCam);
+    ArtemisSetFastCallbackEx(hCam, nullptr);
+
+    // Waits for a callback still running
+    {
+        std::lock_guard<std::mutex> lock(fastCallbackMutex);
+        fastCallbackCameras.erase(hCam);
+    }
+
+    if (m_StreamRestoreSpeed >= 0)
+    {
+        uint16_t value = static_cast<uint16_t>(m_StreamRestoreSpeed);
+        if (ARTEMIS_OK != ArtemisCameraSpecificOptionSetData(hCam, ID_AtikHorizonExposureSpeed, reinterpret_cast<uint8_t*>(&value),
+                2))
+            LOG_WARN("Failed restoring exposure speed after streaming.");
+        m_StreamRestoreSpeed = -1;
+    }
+
+    publishFrameTiming(m_StreamPool.dropped() + m_SdkDroppedFrames);
+}
+
+/////////////////////////////////////////////////////////
+/// Fast mode callback, called on an SDK thread
+/////////////////////////////////////////////////////////
+void ATIKCCD::fastCallbackHelper(ArtemisHandle handle, int x, int y, int w, int h, int binx, int biny, void *imageBuffer,
+                                 unsigned char *info)
+{
+    INDI_UNUSED(x);
+    INDI_UNUSED(y);
+    INDI_UNUSED(binx);
+    INDI_UNUSED(biny);
+
+    std::lock_guard<std::mutex> lock(fastCallbackMutex);
+    auto camera = fastCallbackCameras.find(handle);
+    if (camera != fastCallbackCameras.end())
+        camera->second->fastCallback(w, h, imageBuffer, reinterpret_cast<const FastCallbackInfo *>(info));
+}
+
+/////////////////////////////////////////////////////////
+/// Copy a streamed frame to the pool, the SDK reuses its buffer after we return
+/////////////////////////////////////////////////////////
+void ATIKCCD::fastCallback(int w, int h, const void *imageBuffer, const FastCallbackInfo *info)
+{
+    // Older libraries pass a shorter structure, without the exposure start time
+    bool hasStartTime = info != nullptr && info->size + 1u >= offsetof(FastCallbackInfo, exposureNumber);
+    if (info != nullptr)
+        m_SdkDroppedFrames += info->droppedFrames;
+
+    if (imageBuffer == nullptr || w <= 0 || h <= 0)
+        return;
+
+    FramePool::Frame *frame = m_StreamPool.acquire();
+    if (frame == nullptr)
+        return;
+
+    frame->size = std::min(m_StreamPool.frameSize(), static_cast<size_t>(w) * h * PrimaryCCD.getBPP() / 8);
+    memcpy(frame->data(), imageBuffer, frame->size);
+    // Start of exposure, in seconds of the UTC day
+    if (hasStartTime)
+        frame->timestamp = info->exposureStartTimeHour * 3600.0 + info->exposureStartTimeMinute * 60.0 +
+                           info->exposureStartTimeSecond + info->exposureStartTimeMS / 1000.0;
+    else
+        frame->timestamp = timeNow();
+    m_StreamPool.publish(frame);
+}
+
+/////////////////////////////////////////////////////////
+/// Select single, overlapped or continuous exposures
+/////////////////////////////////////////////////////////
+bool ATIKCCD::setSequenceMode(int mode)
+{
+    if (mode == OVERLAP_ON && !m_CanOverlap)
+    {
+        LOG_ERROR("Camera does not support overlapped exposures.");
+        return false;
+    }
+    if (mode == OVERLAP_CONTINUOUS && !m_CanContinuous)
+    {
+        LOG_ERROR("Camera does not support continuous exposures.");
+        return false;
+    }
+
+    if (m_CanContinuous)
+    {
+        int rc = ArtemisSetContinuousExposingMode(hCam, mode == OVERLAP_CONTINUOUS);
+        if (rc != ARTEMIS_OK)
+        {
+            LOGF_ERROR("Failed to set continuous exposing mode (%d).", rc);
+            return false;
+        }
+    }
+
+    m_OverlapDuration = -1;
+    m_FrameTiming.reset();
     return true;
 }
 
+/////////////////////////////////////////////////////////
+/// Publish frame rate, dead time and dropped frames
+/////////////////////////////////////////////////////////
+void ATIKCCD::publishFrameTiming(uint64_t dropped)
+{
+    FrameTimingN[TIMING_FPS].value = m_FrameTiming.frameRate();
+    FrameTimingN[TIMING_DEAD_TIME].value = m_FrameTiming.deadTime() * 1000.0;
+    FrameTimingN[TIMING_DROPPED].value = static_cast<double>(dropped);
+    FrameTimingNP.s = IPS_OK;
+    IDSetNumber(&FrameTimingNP, nullptr);
+}
+
 /////////////////////////////////////////////////////////
 /// Updates CCD sub frame
 /////////////////////////////////////////////////////////
@@ -1184,16 +1497,21 @@ bool ATIKCCD::UpdateCCDFrame(int x, int y, int w, int h)
     int rc = ArtemisSubframe(hCam, x, y, w, h);
     if (rc != ARTEMIS_OK)
     {
-        LOGF_ERROR("Error settings subframe: (%d,%d,%d,%d) with binning (%d,%d).", x, y, w, h, PrimaryCCD.getBinX(),
-                   PrimaryCCD.getBinY());
+        LOGF_ERROR("Error settings subframe: (%d,%d,%d,%d) with binning (%d,%d).", x, y, w, h, m_BinX, m_BinY);
         return false;
     }
 
-    // Set UNBINNED coords
-    PrimaryCCD.setFrame(x, y, w, h);
+    std::lock_guard<std::mutex> guard(ccdBufferLock);
 
-    // Total bytes required for image buffer
-    PrimaryCCD.setFrameBufferSize(w / PrimaryCCD.getBinX() * h / PrimaryCCD.getBinY() * PrimaryCCD.getBPP() / 8, false);
+    // Set UNBINNED coords
+    m_SubX = x;
+    m_SubY = y;
+    m_SubW = w;
+    m_SubH = h;
+
+    // A frame being sent keeps the chip until UploadComplete(), which sets the new frame
+    if (m_SendingFrame == nullptr)
+        setChipFrame(x, y, w, h, m_BinX, m_BinY, w / m_BinX * h / m_BinY * PrimaryCCD.getBPP() / 8);
     return true;
 }
 
@@ -1207,9 +1525,23 @@ bool ATIKCCD::UpdateCCDBin(int binx, int biny)
     if (rc != ARTEMIS_OK)
         return false;
 
-    PrimaryCCD.setBin(binx, biny);
+    {
+        std::lock_guard<std::mutex> guard(ccdBufferLock);
+        m_BinX = binx;
+        m_BinY = biny;
+    }
+
+    return UpdateCCDFrame(m_SubX, m_SubY, m_SubW, m_SubH);
+}
 
-    return UpdateCCDFrame(PrimaryCCD.getSubX(), PrimaryCCD.getSubY(), PrimaryCCD.getSubW(), PrimaryCCD.getSubH());
+/////////////////////////////////////////////////////////
+/// Point the chip to a frame geometry, ccdBufferLock must be held
+/////////////////////////////////////////////////////////
+void ATIKCCD::setChipFrame(int x, int y, int w, int h, int binx, int biny, int size)
+{
+    PrimaryCCD.setBin(binx, biny);
+    PrimaryCCD.setFrame(x, y, w, h);
+    PrimaryCCD.setFrameBufferSize(size, false);
 }
 
 /////////////////////////////////////////////////////////
@@ -1217,32 +1549,161 @@ bool ATIKCCD::UpdateCCDBin(int binx, int biny)
 /////////////////////////////////////////////////////////
 bool ATIKCCD::grabImage()
 {
-    //uint8_t *image = PrimaryCCD.getFrameBuffer();
+    double ready = timeNow();
     int x, y, w, h, binx, biny;
 
     int rc = ArtemisGetImageData(hCam, &x, &y, &w, &h, &binx, &biny);
     if (rc != ARTEMIS_OK)
         return false;
 
+    const uint8_t *image = reinterpret_cast<const uint8_t*>(ArtemisImageBuffer(hCam));
+    if (image == nullptr)
+    {
+        LOG_ERROR("Camera returned no image buffer.");
+        return false;
+    }
+
+    // Waits while both frames are still being sent
+    FramePool::Frame *frame = m_EncodePool.acquire(FRAME_WAIT_MS);
+    if (frame == nullptr)
+    {
+        LOG_ERROR("No frame buffer available, the previous images are still being sent.");
+        return false;
+    }
+
+    // The frame is sent with the subframe and binning it was taken with, even if they change meanwhile
+    {
+        std::lock_guard<std::mutex> guard(ccdBufferLock);
+        frame->subX = m_SubX;
+        frame->subY = m_SubY;
+        frame->subW = m_SubW;
+        frame->subH = m_SubH;
+        frame->binX = m_BinX;
+        frame->binY = m_BinY;
+    }
+
+    // Same size as UpdateCCDFrame() gives the chip
+    int frameSize = frame->subW / frame->binX * frame->subH / frame->binY * PrimaryCCD.getBPP() / 8;
     int bufferSize = w * binx * h * biny * PrimaryCCD.getBPP() / 8;
-    if ( bufferSize < PrimaryCCD.getFrameBufferSize())
+    if ( bufferSize < frameSize)
     {
-        LOGF_WARN("Image size is unexpected. Expecting %d bytes but received %d bytes.", PrimaryCCD.getFrameBufferSize(),
-                  bufferSize);
-        PrimaryCCD.setFrameBufferSize(bufferSize, false);
+        LOGF_WARN("Image size is unexpected. Expecting %d bytes but received %d bytes.", frameSize, bufferSize);
+        frameSize = bufferSize;
     }
 
-    std::unique_lock<std::mutex> guard(ccdBufferLock);
-    PrimaryCCD.setFrameBuffer(reinterpret_cast<uint8_t*>(ArtemisImageBuffer(hCam)));
-    guard.unlock();
+    if (!frame->reserve(frameSize))
+    {
+        LOGF_ERROR("No frame buffer available for a %d bytes image.", frameSize);
+        m_EncodePool.recycle(frame);
+        return false;
+    }
+
+    // Copy once, the SDK may reuse its buffer for the next exposure as soon as we return
+    memcpy(frame->data(), image, frameSize);
+    frame->size = frameSize;
+    frame->timestamp = ready;
+    frame->download = std::max(0.0, ready - m_ExposureStarted - ExposureRequest);
+    frame->handoff = timeNow() - ready;
+    m_EncodePool.publish(frame);
 
     if (ExposureRequest > VERBOSE_EXPOSURE)
         LOG_INFO("Download complete.");
 
-    ExposureComplete(&PrimaryCCD);
+    m_FrameTiming.add(ready, ExposureRequest);
+    if (m_FrameTiming.frames() > 1)
+        publishFrameTiming(0);
     return true;
 }
 
+/////////////////////////////////////////////////////////
+/// Encoding thread, the chip points to one frame at a time until it is uploaded
+/////////////////////////////////////////////////////////
+void ATIKCCD::encodeFrames()
+{
+    while (true)
+    {
+        FramePool::Frame *frame = m_EncodePool.next(ENCODE_WAIT_MS);
+        if (frame == nullptr)
+        {
+            if (m_EncodeQuit)
+                break;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(ccdBufferLock);
+        setChipFrame(frame->subX, frame->subY, frame->subW, frame->subH, frame->binX, frame->binY, frame->size);
+        PrimaryCCD.setFrameBuffer(frame->data());
+        m_SendingFrame = frame;
+        m_SendStarted = timeNow();
+        guard.unlock();
+
+        // Encoding and upload go on in the background, UploadComplete() hands the frame back
+        ExposureComplete(&PrimaryCCD);
+
+        guard.lock();
+        if (!m_SentCV.wait_for(guard, std::chrono::milliseconds(FRAME_WAIT_MS), [this]() { return m_SendingFrame == nullptr; }))
+        {
+            // The upload failed without completing, take the frame back for the next exposures
+            LOG_WARN("Image upload did not complete, reusing its frame buffer.");
+            PrimaryCCD.setFrameBuffer(nullptr);
+            m_SendingFrame = nullptr;
+            m_EncodePool.recycle(frame);
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////
+/// The frame is sent, give it back and restore the client's frame and binning
+/////////////////////////////////////////////////////////
+void ATIKCCD::UploadComplete(INDI::CCDChip *targetChip)
+{
+    INDI_UNUSED(targetChip);
+
+    std::unique_lock<std::mutex> guard(ccdBufferLock);
+    FramePool::Frame *frame = m_SendingFrame;
+    if (frame == nullptr)
+        return;
+
+    // The chip must not keep or free memory of the pool
+    PrimaryCCD.setFrameBuffer(nullptr);
+    setChipFrame(m_SubX, m_SubY, m_SubW, m_SubH, m_BinX, m_BinY, m_SubW / m_BinX * m_SubH / m_BinY * PrimaryCCD.getBPP() / 8);
+    double encode = timeNow() - m_SendStarted;
+    m_SendingFrame = nullptr;
+    guard.unlock();
+
+    publishFrameLatency(*frame, encode);
+    m_EncodePool.recycle(frame);
+    m_SentCV.notify_all();
+}
+
+/////////////////////////////////////////////////////////
+/// Send the frames already downloaded, then stop the encoding thread
+/////////////////////////////////////////////////////////
+void ATIKCCD::stopEncoder()
+{
+    if (!m_EncodeThread.joinable())
+        return;
+
+    m_EncodeQuit = true;
+    m_EncodePool.close();
+    m_EncodeThread.join();
+}
+
+/////////////////////////////////////////////////////////
+/// Publish where the time went between end of exposure and upload
+/////////////////////////////////////////////////////////
+void ATIKCCD::publishFrameLatency(const FramePool::Frame &frame, double encode)
+{
+    FrameLatencyN[LATENCY_DOWNLOAD].value = frame.download * 1000.0;
+    FrameLatencyN[LATENCY_HANDOFF].value = frame.handoff * 1000.0;
+    FrameLatencyN[LATENCY_ENCODE].value = encode * 1000.0;
+    FrameLatencyNP.s = IPS_OK;
+    IDSetNumber(&FrameLatencyNP, nullptr);
+
+    LOGF_DEBUG("Frame latency: download %.1f ms, hand-off %.1f ms, encode %.1f ms", FrameLatencyN[LATENCY_DOWNLOAD].value,
+               FrameLatencyN[LATENCY_HANDOFF].value, FrameLatencyN[LATENCY_ENCODE].value);
+}
+
 /////////////////////////////////////////////////////////
 /// Cooler & Filter Wheel monitoring
 /////////////////////////////////////////////////////////
@@ -1494,6 +1955,10 @@ void *ATIKCCD::imagingThreadEntry()
         {
             checkExposureProgress();
         }
+        else if (threadRequest == StateStream)
+        {
+            streamFrames();
+        }
         else if (threadRequest == StateRestartExposure)
         {
             threadRequest = StateIdle;
@@ -1606,7 +2071,57 @@ void ATIKCCD::checkExposureProgress()
             PrimaryCCD.setExposureLeft(timeLeft);
         }
 
-        usleep(uSecs);
+        pthread_mutex_lock(&condMutex);
+        waitRequest(uSecs);
+    }
+}
+
+/////////////////////////////////////////////////////////
+/// Sleep on the imaging thread, waking up early on a new request.
+/// condMutex must be locked.
+/////////////////////////////////////////////////////////
+void ATIKCCD::waitRequest(int uSecs)
+{
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    long nsecs = deadline.tv_nsec + (uSecs % 1000000) * 1000L;
+    deadline.tv_sec += uSecs / 1000000 + nsecs / 1000000000L;
+    deadline.tv_nsec = nsecs % 1000000000L;
+
+    ImageState request = threadRequest;
+    while (threadRequest == request)
+    {
+        if (pthread_cond_timedwait(&cv, &condMutex, &deadline) == ETIMEDOUT)
+            break;
+    }
+}
+
+/////////////////////////////////////////////////////////
+/// Hand frames from the fast mode callback to the streamer
+/////////////////////////////////////////////////////////
+void ATIKCCD::streamFrames()
+{
+    double lastUpdate = timeNow();
+
+    while (threadRequest == StateStream)
+    {
+        pthread_mutex_unlock(&condMutex);
+
+        FramePool::Frame *frame = m_StreamPool.next(STREAM_WAIT_MS);
+        if (frame != nullptr)
+        {
+            Streamer->newFrame(frame->data(), frame->size);
+            m_FrameTiming.add(frame->timestamp, m_StreamExposure);
+            m_StreamPool.recycle(frame);
+        }
+
+        double now = timeNow();
+        if (now - lastUpdate >= 1.0)
+        {
+            publishFrameTiming(m_StreamPool.dropped() + m_SdkDroppedFrames);
+            lastUpdate = now;
+        }
+
         pthread_mutex_lock(&condMutex);
     }
 }
@@ -1660,6 +2175,9 @@ bool ATIKCCD::saveConfigItems(FILE *fp)
         // IUSaveConfigSwitch(fp, &BitSendSP); // unused
     }
 
+    if (m_CanOverlap || m_CanContinuous)
+        IUSaveConfigSwitch(fp, &OverlapSP);
+
     if (m_CameraFlags & ARTEMIS_PROPERTIES_CAMERAFLAGS_HAS_FILTERWHEEL)
         FilterNameTP.save(fp);
     // JM 2020-01-15: Seems like setting filter slot results in spinning
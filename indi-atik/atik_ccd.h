@@ -21,16 +21,22 @@
 
 #pragma once
 
+#include "framepool.h"
+
 #include <AtikCameras.h>
 
 #include <indifilterinterface.h>
 #include <indiccd.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+
 class ATIKCCD : public INDI::CCD, public INDI::FilterInterface
 {
     public:
         explicit ATIKCCD(std::string cameraName, int id);
-        ~ATIKCCD() override = default;
+        ~ATIKCCD() override;
 
         virtual const char *getDefaultName() override;
 
@@ -44,6 +50,9 @@ class ATIKCCD : public INDI::CCD, public INDI::FilterInterface
         virtual bool StartExposure(float duration) override;
         virtual bool AbortExposure() override;
 
+        virtual bool StartStreaming() override;
+        virtual bool StopStreaming() override;
+
         static void debugCallbackHelper(void *context, const char *message);
 
     protected:
@@ -54,6 +63,7 @@ class ATIKCCD : public INDI::CCD, public INDI::FilterInterface
         virtual void TimerHit() override;
         virtual bool UpdateCCDFrame(int x, int y, int w, int h) override;
         virtual bool UpdateCCDBin(int binx, int biny) override;
+        virtual void UploadComplete(INDI::CCDChip *targetChip) override;
 
         // Guide Port
         virtual IPState GuideNorth(uint32_t ms) override;
@@ -122,6 +132,22 @@ class ATIKCCD : public INDI::CCD, public INDI::FilterInterface
         // Exposure Progress
         void checkExposureProgress();
         void exposureSetRequest(ImageState request);
+        void waitRequest(int uSecs);
+
+        // Streaming
+        static void fastCallbackHelper(ArtemisHandle handle, int x, int y, int w, int h, int binx, int biny, void *imageBuffer,
+                                       unsigned char *info);
+        void fastCallback(int w, int h, const void *imageBuffer, const FastCallbackInfo *info);
+        void streamFrames();
+        void stopFastExposure();
+
+        /**
+         * @brief setSequenceMode select single, overlapped or continuous exposures
+         * @param mode one of the OVERLAP_* values
+         * @return True if the camera supports and accepted the mode.
+         */
+        bool setSequenceMode(int mode);
+        void publishFrameTiming(uint64_t dropped);
 
         // Guiding
         static void TimerHelperNS(void *context);
@@ -134,6 +160,12 @@ class ATIKCCD : public INDI::CCD, public INDI::FilterInterface
         // Retrieve image from SDK
         bool grabImage();
 
+        // Encoding thread, sends downloaded frames while the next exposure runs
+        void encodeFrames();
+        void stopEncoder();
+        void publishFrameLatency(const FramePool::Frame &frame, double encode);
+        void setChipFrame(int x, int y, int w, int h, int binx, int biny, int size);
+
         /**
          * @brief setupParams get initial camera parameters
          */
@@ -220,6 +252,36 @@ class ATIKCCD : public INDI::CCD, public INDI::FilterInterface
             FASTMODE_FAST,
         };
 
+        // Sequence mode
+        ISwitch OverlapS[3];
+        ISwitchVectorProperty OverlapSP;
+        enum
+        {
+            OVERLAP_OFF = 0,
+            OVERLAP_ON,
+            OVERLAP_CONTINUOUS,
+        };
+
+        // Frame rate and dead time of the last stream or sequence
+        INumber FrameTimingN[3];
+        INumberVectorProperty FrameTimingNP;
+        enum
+        {
+            TIMING_FPS,
+            TIMING_DEAD_TIME,
+            TIMING_DROPPED,
+        };
+
+        // Latency of the last frame, in milliseconds
+        INumber FrameLatencyN[3];
+        INumberVectorProperty FrameLatencyNP;
+        enum
+        {
+            LATENCY_DOWNLOAD,
+            LATENCY_HANDOFF,
+            LATENCY_ENCODE,
+        };
+
 #if 0 // unused
         // Bit send
         ISwitch BitSendS[2];
@@ -242,6 +304,7 @@ class ATIKCCD : public INDI::CCD, public INDI::FilterInterface
 
 
         struct timeval ExpStart;
+        double m_ExposureStarted {0};
         double ExposureRequest { 0 };
         double TemperatureRequest { 1e6 };
         int genTimerID {-1};
@@ -254,6 +317,29 @@ class ATIKCCD : public INDI::CCD, public INDI::FilterInterface
         pthread_mutex_t condMutex = PTHREAD_MUTEX_INITIALIZER;
         pthread_mutex_t accessMutex = PTHREAD_MUTEX_INITIALIZER;
 
+        // Streaming
+        FramePool m_StreamPool;
+        FrameTiming m_FrameTiming;
+        double m_StreamExposure {0};
+        int m_StreamRestoreSpeed {-1};
+        std::atomic<uint64_t> m_SdkDroppedFrames {0};
+
+        // Downloaded frames waiting for encoding
+        FramePool m_EncodePool;
+        std::thread m_EncodeThread;
+        std::atomic<bool> m_EncodeQuit { false };
+        // Frame the chip points to until UploadComplete(), guarded by ccdBufferLock
+        FramePool::Frame *m_SendingFrame { nullptr };
+        double m_SendStarted {0};
+        std::condition_variable m_SentCV;
+        // Unbinned subframe and binning of the next exposure, guarded by ccdBufferLock
+        int m_SubX {0}, m_SubY {0}, m_SubW {0}, m_SubH {0}, m_BinX {1}, m_BinY {1};
+
+        // Overlapped exposures
+        bool m_CanOverlap { false };
+        bool m_CanContinuous { false };
+        float m_OverlapDuration {-1};
+
         // Pulse Guiding
         int WEtimerID;
         int NStimerID;
@@ -1,4 +1,5 @@
 #include "OriginBackendSimple.hpp"
+#include "OriginImageDecoder.hpp"
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QNetworkRequest>
@@ -269,204 +270,57 @@ OriginBackendSimple::~OriginBackendSimple()
     delete m_webSocket;
 }
 
-// In OriginBackendSimple.cpp
-
 void OriginBackendSimple::requestImage(const QString& filePath)
 {
-    qDebug() << "=== IMAGE DOWNLOAD START ===" << QDateTime::currentDateTime().toString();
     qDebug() << "Image notification received:" << filePath;
-    
-    // Store the path for later download
-    m_pendingImagePath = filePath;
-    
-    // Download the image using simple HTTP GET without QEventLoop
-    QString fullPath = QString("http://%1/SmartScope-1.0/dev2/%2")
-                       .arg(m_connectedHost, filePath);
-    
-    qDebug() << "Will download from:" << fullPath;
-    
-    // Record start time
-    auto startTime = std::chrono::steady_clock::now();
-    
-    // Use synchronous download
-    QByteArray imageData = downloadImageSync(fullPath);
-    
-    // Record end time
-    auto endTime = std::chrono::steady_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
-    
-    qDebug() << "=== IMAGE DOWNLOAD COMPLETE ===" << QDateTime::currentDateTime().toString();
-    qDebug() << "Download took:" << duration << "ms (" << (duration/1000.0) << "seconds)";
-    
-    if (!imageData.isEmpty())
-    {
-        qDebug() << "Downloaded" << imageData.size() << "bytes";
-        
-        // Call image callback with the data
-        if (m_imageCallback)
-        {
-            m_imageCallback(filePath, imageData, 0, 0, 0);
-        }
-    }
-    else
+
+    if (!m_imagePipeline)
     {
-        qDebug() << "Failed to download image";
+        qDebug() << "Image pipeline not running, ignoring image";
+        return;
     }
-    
-    qDebug() << "=== IMAGE PROCESSING COMPLETE ===" << QDateTime::currentDateTime().toString();
+
+    // Queue the download, the pipeline threads fetch and decode it while the WebSocket keeps being polled
+    QString path = QString("/SmartScope-1.0/dev2/%1").arg(filePath);
+    m_imagePipeline->request(path.toStdString());
 }
 
-QByteArray OriginBackendSimple::downloadImageSync(const QString& url)
+void OriginBackendSimple::pollImages()
 {
-    QByteArray result;
-    
-    // Parse URL
-    QUrl qurl(url);
-    QString host = qurl.host();
-    int port = qurl.port(80);
-    QString path = qurl.path();
-    
-    qDebug() << "Downloading from host:" << host << "port:" << port << "path:" << path;
-    
-    // Create socket
-    int sock = socket(AF_INET, SOCK_STREAM, 0);
-    if (sock < 0)
-    {
-        qDebug() << "Failed to create socket";
-        return result;
-    }
-    
-    // Set socket timeouts
-    struct timeval timeout;
-    timeout.tv_sec = 60;
-    timeout.tv_usec = 0;
-    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
-    setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
-    
-    // Set socket to non-blocking for the download loop
-    int flags = fcntl(sock, F_GETFL, 0);
-    fcntl(sock, F_SETFL, flags | O_NONBLOCK);
-    
-    // Resolve host
-    struct hostent *server = gethostbyname(host.toUtf8().constData());
-    if (server == nullptr)
-    {
-        qDebug() << "Failed to resolve host";
-        close(sock);
-        return result;
-    }
-    
-    // Connect (switch back to blocking for connect)
-    fcntl(sock, F_SETFL, flags);
-    struct sockaddr_in serv_addr;
-    memset(&serv_addr, 0, sizeof(serv_addr));
-    serv_addr.sin_family = AF_INET;
-    memcpy(&serv_addr.sin_addr.s_addr, server->h_addr, server->h_length);
-    serv_addr.sin_port = htons(port);
-    
-    if (connect(sock, (struct sockaddr *)&serv_addr, sizeof(serv_addr)) < 0)
-    {
-        qDebug() << "Failed to connect to server";
-        close(sock);
-        return result;
-    }
-    
-    // Send HTTP GET request
-    QString request = QString("GET %1 HTTP/1.1\r\n"
-                             "Host: %2\r\n"
-                             "Connection: close\r\n"
-                             "\r\n").arg(path, host);
-    
-    send(sock, request.toUtf8().constData(), request.length(), 0);
-    
-    // Switch to non-blocking for reading
-    fcntl(sock, F_SETFL, flags | O_NONBLOCK);
-    
-    // Read response with periodic WebSocket keepalive
-    char buffer[65536];
-    QByteArray response;
-    int totalBytes = 0;
-    auto lastKeepalive = std::chrono::steady_clock::now();
-    auto lastLog = lastKeepalive;
-    
-    qDebug() << "Reading response with WebSocket keepalive...";
-    
-    while (true)
+    if (!m_imagePipeline)
+        return;
+
+    std::vector<std::shared_ptr<OriginImage>> images;
+    m_imagePipeline->takeReady(images);
+
+    for (auto &image : images)
     {
-        int bytesRead = recv(sock, buffer, sizeof(buffer), 0);
-        
-        if (bytesRead > 0)
-        {
-            response.append(buffer, bytesRead);
-            totalBytes += bytesRead;
-        }
-        else if (bytesRead == 0)
-        {
-            // Connection closed - done
-            break;
-        }
-        else if (errno != EAGAIN && errno != EWOULDBLOCK)
-        {
-            // Real error
-            qDebug() << "Socket error:" << strerror(errno);
-            break;
-        }
-        
-        // Check if we should send a keepalive
-        auto now = std::chrono::steady_clock::now();
-        auto keepaliveElapsed = std::chrono::duration_cast<std::chrono::seconds>(now - lastKeepalive).count();
-        
-        if (keepaliveElapsed >= 5)  // Every 5 seconds
-        {
-            qDebug() << "Sending WebSocket keepalive (downloaded" << totalBytes << "bytes)";
-            
-            // Send a lightweight status request to keep WebSocket alive
-            sendCommand("GetStatus", "Mount");
-            
-            // Process any incoming WebSocket messages
-            while (m_webSocket->hasData())
-            {
-                std::string message = m_webSocket->receiveText();
-                if (!message.empty())
-                {
-                    processMessage(message);
-                }
-            }
-            
-            lastKeepalive = now;
-        }
-        
-        // Log progress
-        auto logElapsed = std::chrono::duration_cast<std::chrono::seconds>(now - lastLog).count();
-        if (logElapsed >= 5)
+        // Report the file name the notification carried
+        QString filePath = QString::fromStdString(image->path).section("/SmartScope-1.0/dev2/", 1);
+
+        if (!image->error.empty())
         {
-            qDebug() << "Downloaded" << totalBytes << "bytes so far...";
-            lastLog = now;
+            qDebug() << "Failed to get image" << filePath << ":" << image->error.c_str();
+            continue;
         }
-        
-        // Small sleep to avoid spinning
-        usleep(10000);  // 10ms
-    }
-    
-    close(sock);
-    
-    qDebug() << "Received" << response.size() << "bytes total";
-    
-    // Parse HTTP response
-    int headerEnd = response.indexOf("\r\n\r\n");
-    if (headerEnd > 0)
-    {
-        result = response.mid(headerEnd + 4);
-        qDebug() << "Image data size:" << result.size() << "bytes";
+
+        const auto &download = image->download;
+        qDebug() << "Image" << filePath << ":" << download.bytes << "bytes in" << download.totalMs << "ms ("
+                 << (download.totalMs > 0 ? download.bytes / download.totalMs / 1000.0 : 0) << "MB/s, first byte after"
+                 << download.firstByteMs << "ms," << (download.reused ? "reused" : "new") << "connection), decoded"
+                 << image->width << "x" << image->height << "in" << image->decodeMs << "ms";
+
+        if (m_imageCallback)
+            m_imageCallback(filePath, image, 0, 0, 0);
     }
-    
-    return result;
 }
 
 void OriginBackendSimple::poll()
 {
     if (!m_webSocket)
         return;
+
+    pollImages();
     
     static auto lastPollTime = std::chrono::steady_clock::now();
     auto now = std::chrono::steady_clock::now();
@@ -561,6 +415,9 @@ bool OriginBackendSimple::connectToTelescope(const QString& host, int port)
     
     m_connected = true;
     qDebug() << "WebSocket connected";
+
+    m_imagePipeline.reset(new OriginImagePipeline(host.toStdString(), port, decodeOriginImage));
+    m_imagePipeline->start();
     
     // Send initial status request
     sendCommand("GetStatus", "Mount");
@@ -601,6 +458,7 @@ void OriginBackendSimple::disconnectFromTelescope()
     {
         m_webSocket->disconnect();
     }
+    m_imagePipeline.reset();
     m_connected = false;
     m_logicallyConnected = false;
 }
@@ -643,7 +501,8 @@ void OriginBackendSimple::processMessage(const std::string& message)
     if (source == "ImageServer" && command == "NewImageReady" && type == "Notification")
     {
         QString filePath = obj["FileLocation"].toString();
-        if (!filePath.isEmpty() && filePath.endsWith(".tiff", Qt::CaseInsensitive))
+        bool isPreview = filePath.endsWith(".jpg", Qt::CaseInsensitive) || filePath.endsWith(".jpeg", Qt::CaseInsensitive);
+        if (!filePath.isEmpty() && (filePath.endsWith(".tiff", Qt::CaseInsensitive) || (isPreview && m_previewWanted)))
         {
             requestImage(filePath);
         }
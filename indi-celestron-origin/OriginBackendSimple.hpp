@@ -6,11 +6,13 @@
 #include <functional>
 #include "SimpleWebSocket.h"
 #include "TelescopeData.hpp"
+#include "OriginImagePipeline.hpp"
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -68,7 +70,7 @@ public:
     };
 
     // Callback types
-    using ImageCallback = std::function<void(const QString&, const QByteArray&, double, double, double)>;
+    using ImageCallback = std::function<void(const QString&, std::shared_ptr<OriginImage>, double, double, double)>;
     using StatusCallback = std::function<void()>;
 
     explicit OriginBackendSimple();
@@ -97,6 +99,8 @@ public:
     // Camera operations
     bool takeSnapshot(double exposure, int iso);
     bool abortExposure();
+    // Also download the JPEG previews, not only full captures
+    void setPreviewWanted(bool wanted) { m_previewWanted = wanted; }
     
     // Status
     TelescopeStatus status() const { return m_status; }
@@ -108,6 +112,8 @@ public:
     
     // Polling - call this from INDI TimerHit()
     void poll();
+    // Hand downloaded and decoded images to the image callback, also called by poll()
+    void pollImages();
 
 private:
     SimpleWebSocket *m_webSocket;
@@ -131,8 +137,9 @@ private:
     // Callbacks
     ImageCallback m_imageCallback;
     StatusCallback m_statusCallback;
-    QByteArray downloadImageSync(const QString& url);
-    QString m_pendingImagePath;    
+    // Downloads and decodes images off the INDI thread, over one keep-alive connection
+    std::unique_ptr<OriginImagePipeline> m_imagePipeline;
+    bool m_previewWanted {false};
     // Message handling
     void processMessage(const std::string& message);
     void sendCommand(const QString& command, const QString& destination,
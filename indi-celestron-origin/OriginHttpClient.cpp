@@ -0,0 +1,407 @@
+#include "OriginHttpClient.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace
+{
+// Socket reads are polled in slices this long so abort() is noticed quickly
+constexpr int POLL_SLICE_MS = 100;
+constexpr size_t READ_CHUNK = 64 * 1024;
+
+double msSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::string trim(const std::string& s)
+{
+    size_t start = s.find_first_not_of(" \t\r\n");
+    size_t end = s.find_last_not_of(" \t\r\n");
+    return start == std::string::npos ? std::string() : s.substr(start, end - start + 1);
+}
+}
+
+OriginHttpClient::OriginHttpClient(const std::string& host, int port, int timeoutMs)
+    : m_host(host)
+    , m_port(port)
+    , m_timeoutMs(timeoutMs)
+{
+}
+
+OriginHttpClient::~OriginHttpClient()
+{
+    disconnect();
+}
+
+void OriginHttpClient::disconnect()
+{
+    if (m_socket >= 0)
+    {
+        close(m_socket);
+        m_socket = -1;
+    }
+    m_pending.clear();
+    m_pendingOffset = 0;
+}
+
+void OriginHttpClient::abort()
+{
+    m_aborted = true;
+}
+
+bool OriginHttpClient::get(const std::string& path, std::vector<uint8_t>& body, Stats *stats)
+{
+    Stats local;
+    if (!stats)
+        stats = &local;
+
+    Result result = request(path, body, stats);
+
+    // The server closed the idle keep-alive connection, retry once on a fresh one
+    if (result == STALE)
+    {
+        disconnect();
+        result = request(path, body, stats);
+    }
+
+    if (result != OK)
+    {
+        disconnect();
+        return false;
+    }
+    return true;
+}
+
+OriginHttpClient::Result OriginHttpClient::request(const std::string& path, std::vector<uint8_t>& body, Stats *stats)
+{
+    *stats = Stats();
+    stats->reused = m_socket >= 0;
+
+    if (m_aborted)
+    {
+        m_lastError = "Aborted";
+        return FAILED;
+    }
+
+    if (m_socket < 0 && !openConnection())
+        return FAILED;
+
+    std::string request = "GET " + path + " HTTP/1.1\r\n"
+                          "Host: " + m_host + "\r\n"
+                          "Connection: keep-alive\r\n"
+                          "\r\n";
+
+    auto start = std::chrono::steady_clock::now();
+    if (!sendAll(request))
+        return stats->reused ? STALE : FAILED;
+
+    // Status line, e.g. "HTTP/1.1 200 OK"
+    std::string line;
+    if (!readLine(line))
+        return stats->reused && !m_aborted ? STALE : FAILED;
+
+    int status = 0;
+    int minor = 1;
+    if (sscanf(line.c_str(), "HTTP/1.%d %d", &minor, &status) != 2)
+    {
+        m_lastError = "Malformed status line: " + trim(line);
+        return FAILED;
+    }
+
+    long long contentLength = -1;
+    bool chunked = false;
+    bool keepAlive = minor >= 1;
+
+    while (true)
+    {
+        if (!readLine(line))
+            return FAILED;
+        line = trim(line);
+        if (line.empty())
+            break;
+
+        size_t colon = line.find(':');
+        if (colon == std::string::npos)
+            continue;
+        std::string name = trim(line.substr(0, colon));
+        std::string value = trim(line.substr(colon + 1));
+
+        if (strcasecmp(name.c_str(), "Content-Length") == 0)
+            contentLength = atoll(value.c_str());
+        else if (strcasecmp(name.c_str(), "Transfer-Encoding") == 0)
+            chunked = strcasestr(value.c_str(), "chunked") != nullptr;
+        else if (strcasecmp(name.c_str(), "Connection") == 0)
+        {
+            if (strcasestr(value.c_str(), "close"))
+                keepAlive = false;
+            else if (strcasestr(value.c_str(), "keep-alive"))
+                keepAlive = true;
+        }
+    }
+    stats->firstByteMs = msSince(start);
+
+    bool ok;
+    if (status / 100 == 1 || status == 204 || status == 304)
+    {
+        body.clear();
+        ok = true;
+    }
+    else if (chunked)
+        ok = readChunked(body);
+    else if (contentLength >= 0)
+    {
+        // Size the buffer once and receive the body straight into it
+        body.resize(static_cast<size_t>(contentLength));
+        ok = readExact(body.data(), body.size());
+    }
+    else
+    {
+        ok = readUntilClose(body);
+        keepAlive = false;
+    }
+
+    if (!ok)
+        return FAILED;
+
+    stats->bytes = body.size();
+    stats->totalMs = msSince(start);
+
+    if (!keepAlive)
+        disconnect();
+
+    if (status / 100 != 2)
+    {
+        m_lastError = "HTTP status " + std::to_string(status);
+        return FAILED;
+    }
+    return OK;
+}
+
+bool OriginHttpClient::openConnection()
+{
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+
+    struct addrinfo *result = nullptr;
+    std::string port = std::to_string(m_port);
+    if (getaddrinfo(m_host.c_str(), port.c_str(), &hints, &result) != 0 || result == nullptr)
+    {
+        m_lastError = "Failed to resolve host " + m_host;
+        return false;
+    }
+
+    int sock = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+    if (sock < 0)
+    {
+        m_lastError = std::string("Failed to create socket: ") + strerror(errno);
+        freeaddrinfo(result);
+        return false;
+    }
+
+    int flags = fcntl(sock, F_GETFL, 0);
+    fcntl(sock, F_SETFL, flags | O_NONBLOCK);
+
+    int rc = ::connect(sock, result->ai_addr, result->ai_addrlen);
+    freeaddrinfo(result);
+
+    if (rc < 0 && errno != EINPROGRESS)
+    {
+        m_lastError = std::string("Failed to connect: ") + strerror(errno);
+        close(sock);
+        return false;
+    }
+
+    if (rc < 0)
+    {
+        struct pollfd pfd = { sock, POLLOUT, 0 };
+        int error = 0;
+        socklen_t len = sizeof(error);
+        if (poll(&pfd, 1, m_timeoutMs) <= 0 || getsockopt(sock, SOL_SOCKET, SO_ERROR, &error, &len) < 0 || error != 0)
+        {
+            m_lastError = std::string("Failed to connect: ") + (error ? strerror(error) : "timeout");
+            close(sock);
+            return false;
+        }
+    }
+
+    int one = 1;
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    m_socket = sock;
+    m_connections++;
+    m_pending.clear();
+    m_pendingOffset = 0;
+    return true;
+}
+
+bool OriginHttpClient::sendAll(const std::string& data)
+{
+    size_t sent = 0;
+    while (sent < data.size())
+    {
+        ssize_t n = send(m_socket, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n > 0)
+        {
+            sent += n;
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+        {
+            struct pollfd pfd = { m_socket, POLLOUT, 0 };
+            if (poll(&pfd, 1, m_timeoutMs) > 0)
+                continue;
+        }
+        m_lastError = std::string("Failed to send request: ") + (n < 0 ? strerror(errno) : "timeout");
+        return false;
+    }
+    return true;
+}
+
+ssize_t OriginHttpClient::receiveSocket(uint8_t *data, size_t len)
+{
+    int waited = 0;
+    while (!m_aborted)
+    {
+        ssize_t n = recv(m_socket, data, len, 0);
+        if (n > 0)
+            return n;
+        if (n == 0)
+        {
+            m_lastError = "Connection closed by server";
+            return 0;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        {
+            m_lastError = std::string("Socket error: ") + strerror(errno);
+            return -1;
+        }
+
+        if (waited >= m_timeoutMs)
+        {
+            m_lastError = "Timeout waiting for data";
+            return -1;
+        }
+        struct pollfd pfd = { m_socket, POLLIN, 0 };
+        poll(&pfd, 1, POLL_SLICE_MS);
+        waited += POLL_SLICE_MS;
+    }
+
+    m_lastError = "Aborted";
+    return -1;
+}
+
+ssize_t OriginHttpClient::receive(uint8_t *data, size_t len)
+{
+    // Bytes left over from reading the headers come first
+    if (m_pendingOffset < m_pending.size())
+    {
+        size_t n = std::min(len, m_pending.size() - m_pendingOffset);
+        memcpy(data, m_pending.data() + m_pendingOffset, n);
+        m_pendingOffset += n;
+        return n;
+    }
+    return receiveSocket(data, len);
+}
+
+bool OriginHttpClient::readLine(std::string& line)
+{
+    line.clear();
+    while (true)
+    {
+        auto begin = m_pending.begin() + m_pendingOffset;
+        auto newline = std::find(begin, m_pending.end(), '\n');
+        if (newline != m_pending.end())
+        {
+            line.append(begin, newline + 1);
+            m_pendingOffset = newline + 1 - m_pending.begin();
+            return true;
+        }
+        line.append(begin, m_pending.end());
+        if (line.size() > 16 * 1024)
+        {
+            m_lastError = "Header line too long";
+            return false;
+        }
+
+        m_pending.resize(READ_CHUNK);
+        m_pendingOffset = 0;
+        ssize_t n = receiveSocket(m_pending.data(), m_pending.size());
+        m_pending.resize(n > 0 ? n : 0);
+        if (n <= 0)
+            return false;
+    }
+}
+
+bool OriginHttpClient::readExact(uint8_t *data, size_t len)
+{
+    size_t got = 0;
+    while (got < len)
+    {
+        ssize_t n = receive(data + got, len - got);
+        if (n <= 0)
+            return false;
+        got += n;
+    }
+    return true;
+}
+
+bool OriginHttpClient::readChunked(std::vector<uint8_t>& body)
+{
+    body.clear();
+    std::string line;
+    while (true)
+    {
+        if (!readLine(line))
+            return false;
+        size_t size = strtoul(line.c_str(), nullptr, 16);
+        if (size == 0)
+            break;
+
+        size_t offset = body.size();
+        body.resize(offset + size);
+        if (!readExact(body.data() + offset, size) || !readLine(line))
+            return false;
+    }
+
+    // Trailers up to the empty line
+    do
+    {
+        if (!readLine(line))
+            return false;
+    }
+    while (!trim(line).empty());
+    return true;
+}
+
+bool OriginHttpClient::readUntilClose(std::vector<uint8_t>& body)
+{
+    body.clear();
+    while (true)
+    {
+        size_t offset = body.size();
+        body.resize(offset + READ_CHUNK);
+        ssize_t n = receive(body.data() + offset, READ_CHUNK);
+        body.resize(offset + (n > 0 ? n : 0));
+        if (n <= 0)
+            return n == 0;
+    }
+}
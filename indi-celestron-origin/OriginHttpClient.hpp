@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+/**
+ * Minimal HTTP/1.1 GET client for the Origin image server.
+ *
+ * The connection is kept alive between requests and reopened transparently when the
+ * server closed it. Bodies with a Content-Length are received straight into the caller's
+ * buffer, which is resized once up front, so a buffer reused across images is not
+ * reallocated. Chunked and close-delimited bodies are supported as a fallback.
+ *
+ * All calls block, the client is meant to be driven by a single worker thread.
+ * abort() may be called from any thread to unblock it.
+ */
+class OriginHttpClient
+{
+public:
+    struct Stats
+    {
+        bool reused = false;        // request went over an already open connection
+        size_t bytes = 0;           // body size
+        double firstByteMs = 0;     // request sent to response headers received
+        double totalMs = 0;         // request sent to body complete
+    };
+
+    OriginHttpClient(const std::string& host, int port, int timeoutMs = 60000);
+    ~OriginHttpClient();
+
+    // GET path into body. Returns false on network errors or a non-2xx status, see lastError().
+    bool get(const std::string& path, std::vector<uint8_t>& body, Stats *stats = nullptr);
+
+    void disconnect();
+    void abort();
+
+    bool isConnected() const { return m_socket >= 0; }
+    int connections() const { return m_connections; }
+    const std::string& lastError() const { return m_lastError; }
+
+private:
+    enum Result { OK, FAILED, STALE };
+
+    Result request(const std::string& path, std::vector<uint8_t>& body, Stats *stats);
+    bool openConnection();
+    bool sendAll(const std::string& data);
+    // Receive at most len bytes: the byte count, 0 at end of stream, -1 on timeout or error
+    ssize_t receiveSocket(uint8_t *data, size_t len);
+    // As receiveSocket(), taking buffered bytes first
+    ssize_t receive(uint8_t *data, size_t len);
+    bool readLine(std::string& line);
+    bool readExact(uint8_t *data, size_t len);
+    bool readChunked(std::vector<uint8_t>& body);
+    bool readUntilClose(std::vector<uint8_t>& body);
+
+    std::string m_host;
+    int m_port;
+    int m_timeoutMs;
+    int m_socket {-1};
+    int m_connections {0};
+    std::atomic<bool> m_aborted {false};
+    std::string m_lastError;
+
+    // Received bytes not consumed yet, i.e. what followed the headers in the same read
+    std::vector<uint8_t> m_pending;
+    size_t m_pendingOffset {0};
+};
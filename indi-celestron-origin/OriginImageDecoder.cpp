@@ -0,0 +1,184 @@
+#include "OriginImageDecoder.hpp"
+
+#include "pixelconvert.h"
+
+#include <QImage>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <tiffio.h>
+
+namespace
+{
+// libtiff client over the downloaded body, so the image is never written to disk
+struct MemoryStream
+{
+    const uint8_t *data;
+    toff_t size;
+    toff_t offset;
+};
+
+tsize_t memoryRead(thandle_t handle, tdata_t buffer, tsize_t size)
+{
+    auto stream = static_cast<MemoryStream *>(handle);
+    toff_t left = stream->offset < stream->size ? stream->size - stream->offset : 0;
+    tsize_t n = static_cast<tsize_t>(std::min<toff_t>(left, static_cast<toff_t>(size)));
+    memcpy(buffer, stream->data + stream->offset, n);
+    stream->offset += n;
+    return n;
+}
+
+tsize_t memoryWrite(thandle_t, tdata_t, tsize_t)
+{
+    return 0;
+}
+
+toff_t memorySeek(thandle_t handle, toff_t offset, int whence)
+{
+    auto stream = static_cast<MemoryStream *>(handle);
+    switch (whence)
+    {
+        case SEEK_SET:
+            stream->offset = offset;
+            break;
+        case SEEK_CUR:
+            stream->offset += offset;
+            break;
+        case SEEK_END:
+            stream->offset = stream->size + offset;
+            break;
+    }
+    return stream->offset;
+}
+
+int memoryClose(thandle_t)
+{
+    return 0;
+}
+
+toff_t memorySize(thandle_t handle)
+{
+    return static_cast<MemoryStream *>(handle)->size;
+}
+
+int memoryMap(thandle_t handle, tdata_t *base, toff_t *size)
+{
+    auto stream = static_cast<MemoryStream *>(handle);
+    *base = const_cast<uint8_t *>(stream->data);
+    *size = stream->size;
+    return 1;
+}
+
+void memoryUnmap(thandle_t, tdata_t, toff_t)
+{
+}
+
+// Interleaved pixels before the split into planes, kept per decode thread
+thread_local std::vector<uint8_t> interleaved;
+}
+
+void decodeOriginTIFF(const std::vector<uint8_t>& body, OriginImage& image)
+{
+    MemoryStream stream { body.data(), body.size(), 0 };
+    TIFF *tif = TIFFClientOpen("origin", "r", &stream, memoryRead, memoryWrite, memorySeek, memoryClose,
+                               memorySize, memoryMap, memoryUnmap);
+    if (!tif)
+    {
+        image.error = "Failed to open TIFF";
+        return;
+    }
+
+    uint32_t width = 0, height = 0;
+    uint16_t samplesperpixel = 0, bitspersample = 0, config = PLANARCONFIG_CONTIG;
+
+    TIFFGetField(tif, TIFFTAG_IMAGEWIDTH, &width);
+    TIFFGetField(tif, TIFFTAG_IMAGELENGTH, &height);
+    TIFFGetField(tif, TIFFTAG_SAMPLESPERPIXEL, &samplesperpixel);
+    TIFFGetField(tif, TIFFTAG_BITSPERSAMPLE, &bitspersample);
+    TIFFGetField(tif, TIFFTAG_PLANARCONFIG, &config);
+
+    if (samplesperpixel != 3 || bitspersample != 16 || config != PLANARCONFIG_CONTIG || TIFFIsTiled(tif))
+    {
+        image.error = "Unexpected TIFF format: " + std::to_string(samplesperpixel) + " samples of " +
+                      std::to_string(bitspersample) + " bits";
+        TIFFClose(tif);
+        return;
+    }
+
+    size_t pixels = static_cast<size_t>(width) * height;
+    size_t frameSize = pixels * 3 * sizeof(uint16_t);
+    interleaved.resize(frameSize);
+
+    // Whole strips at a time, then one pass to split the channels
+    size_t offset = 0;
+    for (tstrip_t strip = 0; strip < TIFFNumberOfStrips(tif) && offset < frameSize; strip++)
+    {
+        tsize_t n = TIFFReadEncodedStrip(tif, strip, interleaved.data() + offset, frameSize - offset);
+        if (n < 0)
+        {
+            image.error = "Error reading TIFF strip " + std::to_string(strip);
+            TIFFClose(tif);
+            return;
+        }
+        offset += n;
+    }
+    TIFFClose(tif);
+
+    if (offset < frameSize)
+    {
+        image.error = "Truncated TIFF";
+        return;
+    }
+
+    image.width = width;
+    image.height = height;
+    image.planes = 3;
+    image.bpp = 16;
+    image.data.resize(frameSize);
+    PixelConvert::deinterleave16(reinterpret_cast<const uint16_t *>(interleaved.data()),
+                                 reinterpret_cast<uint16_t *>(image.data.data()), pixels, 3, PixelConvert::ORDER_RGB);
+}
+
+void decodeOriginJPEG(const std::vector<uint8_t>& body, OriginImage& image)
+{
+    QImage decoded;
+    if (!decoded.loadFromData(body.data(), static_cast<int>(body.size()), "JPG"))
+    {
+        image.error = "Failed to decode JPEG";
+        return;
+    }
+    if (decoded.format() != QImage::Format_RGB888)
+        decoded = decoded.convertToFormat(QImage::Format_RGB888);
+
+    uint32_t width = decoded.width();
+    uint32_t height = decoded.height();
+    size_t pixels = static_cast<size_t>(width) * height;
+    size_t rowSize = static_cast<size_t>(width) * 3;
+
+    // QImage pads rows to 4 bytes, pack them first if needed
+    const uint8_t *src = decoded.constBits();
+    if (static_cast<size_t>(decoded.bytesPerLine()) != rowSize)
+    {
+        interleaved.resize(pixels * 3);
+        for (uint32_t row = 0; row < height; row++)
+            memcpy(interleaved.data() + row * rowSize, decoded.constScanLine(row), rowSize);
+        src = interleaved.data();
+    }
+
+    image.width = width;
+    image.height = height;
+    image.planes = 3;
+    image.bpp = 8;
+    image.data.resize(pixels * 3);
+    PixelConvert::deinterleave8(src, image.data.data(), pixels, 3, PixelConvert::ORDER_RGB);
+}
+
+void decodeOriginImage(const std::vector<uint8_t>& body, OriginImage& image)
+{
+    if (body.size() >= 4 && ((body[0] == 'I' && body[1] == 'I') || (body[0] == 'M' && body[1] == 'M')))
+        decodeOriginTIFF(body, image);
+    else if (body.size() >= 2 && body[0] == 0xFF && body[1] == 0xD8)
+        decodeOriginJPEG(body, image);
+    else
+        image.error = "Unknown image format";
+}
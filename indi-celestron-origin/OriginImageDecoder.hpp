@@ -0,0 +1,18 @@
+#pragma once
+
+#include "OriginImagePipeline.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// Decoders for the images served by the Origin, straight from the downloaded body into
+// the planar RGB layout of the CCD frame buffer. They run on the pipeline decode thread.
+
+// 16-bit RGB TIFF of a full capture
+void decodeOriginTIFF(const std::vector<uint8_t>& body, OriginImage& image);
+
+// 8-bit RGB JPEG of a preview
+void decodeOriginJPEG(const std::vector<uint8_t>& body, OriginImage& image);
+
+// Picks the decoder from the file signature
+void decodeOriginImage(const std::vector<uint8_t>& body, OriginImage& image);
@@ -0,0 +1,137 @@
+#include "OriginImagePipeline.hpp"
+
+#include <chrono>
+
+namespace
+{
+// Decoded images nobody collected are dropped beyond this, oldest first
+constexpr size_t MAX_READY = 4;
+// Body buffers kept for reuse, one being filled and one being decoded
+constexpr size_t MAX_FREE_BODIES = 2;
+}
+
+OriginImagePipeline::OriginImagePipeline(const std::string& host, int port, Decoder decoder)
+    : m_client(host, port)
+    , m_decoder(std::move(decoder))
+{
+}
+
+OriginImagePipeline::~OriginImagePipeline()
+{
+    stop();
+}
+
+void OriginImagePipeline::start()
+{
+    if (m_running)
+        return;
+
+    m_running = true;
+    m_downloadThread = std::thread(&OriginImagePipeline::downloadLoop, this);
+    m_decodeThread = std::thread(&OriginImagePipeline::decodeLoop, this);
+}
+
+void OriginImagePipeline::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_running = false;
+    }
+    m_client.abort();
+    m_requestReady.notify_all();
+    m_bodyReady.notify_all();
+
+    if (m_downloadThread.joinable())
+        m_downloadThread.join();
+    if (m_decodeThread.joinable())
+        m_decodeThread.join();
+}
+
+void OriginImagePipeline::request(const std::string& path)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_requests.push_back(path);
+    }
+    m_requestReady.notify_one();
+}
+
+void OriginImagePipeline::takeReady(std::vector<std::shared_ptr<OriginImage>>& images)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    images.assign(m_ready.begin(), m_ready.end());
+    m_ready.clear();
+}
+
+void OriginImagePipeline::downloadLoop()
+{
+    while (true)
+    {
+        std::string path;
+        std::vector<uint8_t> body;
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_requestReady.wait(lock, [this]() { return !m_running || !m_requests.empty(); });
+            if (!m_running)
+                return;
+
+            path = m_requests.front();
+            m_requests.pop_front();
+            if (!m_freeBodies.empty())
+            {
+                body = std::move(m_freeBodies.back());
+                m_freeBodies.pop_back();
+            }
+        }
+
+        auto image = std::make_shared<OriginImage>();
+        image->path = path;
+
+        bool ok = m_client.get(path, body, &image->download);
+        m_connections = m_client.connections();
+
+        if (!ok)
+            image->error = m_client.lastError();
+
+        // Failures go through the decode queue too, so images are reported in request order
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_downloaded.push_back({image, std::move(body)});
+        m_bodyReady.notify_one();
+    }
+}
+
+void OriginImagePipeline::decodeLoop()
+{
+    while (true)
+    {
+        Downloaded downloaded;
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_bodyReady.wait(lock, [this]() { return !m_running || !m_downloaded.empty(); });
+            if (!m_running)
+                return;
+
+            downloaded = std::move(m_downloaded.front());
+            m_downloaded.pop_front();
+        }
+
+        if (downloaded.image->error.empty())
+        {
+            auto start = std::chrono::steady_clock::now();
+            m_decoder(downloaded.body, *downloaded.image);
+            downloaded.image->decodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        pushReady(downloaded.image);
+        if (m_freeBodies.size() < MAX_FREE_BODIES)
+            m_freeBodies.push_back(std::move(downloaded.body));
+    }
+}
+
+void OriginImagePipeline::pushReady(const std::shared_ptr<OriginImage>& image)
+{
+    if (m_ready.size() >= MAX_READY)
+        m_ready.pop_front();
+    m_ready.push_back(image);
+}
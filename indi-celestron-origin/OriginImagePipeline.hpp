@@ -0,0 +1,94 @@
+#pragma once
+
+#include "OriginHttpClient.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * A downloaded and decoded Origin image.
+ *
+ * data holds the planes one after the other (R, G, B), in the layout the CCD frame
+ * buffer expects, so uploading it is a single copy.
+ */
+struct OriginImage
+{
+    std::string path;
+    std::string error;          // empty on success
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t planes = 0;
+    uint8_t bpp = 0;
+    std::vector<uint8_t> data;
+
+    OriginHttpClient::Stats download;
+    double decodeMs = 0;
+};
+
+/**
+ * Downloads images over a persistent HTTP connection on one thread and decodes them on
+ * another, so neither blocks the WebSocket/INDI loop and the next download can start
+ * while the previous image is being decoded.
+ *
+ * Finished images, failed ones included, are collected with takeReady() from the
+ * driver thread.
+ */
+class OriginImagePipeline
+{
+public:
+    // Decode body into image, setting image.error on failure. Called on the decode thread.
+    using Decoder = std::function<void(const std::vector<uint8_t>& body, OriginImage& image)>;
+
+    OriginImagePipeline(const std::string& host, int port, Decoder decoder);
+    ~OriginImagePipeline();
+
+    void start();
+    void stop();
+
+    // Queue an image for download, path is the absolute URL path on the image server
+    void request(const std::string& path);
+
+    // Move the finished images to images, oldest first
+    void takeReady(std::vector<std::shared_ptr<OriginImage>>& images);
+
+    // Connections opened so far, 1 while keep-alive holds
+    int connections() const { return m_connections; }
+
+private:
+    struct Downloaded
+    {
+        std::shared_ptr<OriginImage> image;
+        std::vector<uint8_t> body;
+    };
+
+    void downloadLoop();
+    void decodeLoop();
+    // Call with m_lock held
+    void pushReady(const std::shared_ptr<OriginImage>& image);
+
+    OriginHttpClient m_client;
+    Decoder m_decoder;
+
+    std::atomic<bool> m_running {false};
+    std::atomic<int> m_connections {0};
+    std::thread m_downloadThread;
+    std::thread m_decodeThread;
+
+    // Guards the queues below
+    std::mutex m_lock;
+    std::condition_variable m_requestReady;
+    std::condition_variable m_bodyReady;
+    std::deque<std::string> m_requests;
+    std::deque<Downloaded> m_downloaded;
+    std::deque<std::shared_ptr<OriginImage>> m_ready;
+    // Decoded bodies are handed back so the next download reuses their allocation
+    std::vector<std::vector<uint8_t>> m_freeBodies;
+};
@@ -7,11 +7,7 @@
 #include <sys/time.h>
 #include <unistd.h>
 #include <stdio.h>
-#include <tiffio.h>
 #include <cstring>
-#include <QDir>
-#include <QFile>
-#include <QStandardPaths>
 #include <libnova/precession.h>
 #include <libnova/julian_day.h>
 
@@ -419,9 +415,9 @@ bool OriginCamera::Connect()
     initProperties();
     ISGetProperties(nullptr);
     
-    backend->setImageCallback([this](const QString& path, const QByteArray& data, 
+    backend->setImageCallback([this](const QString& path, std::shared_ptr<OriginImage> image,
 				       double ra, double dec, double /*exposure*/) {
-      this->onImageReady(path, data, ra, dec);
+      this->onImageReady(path, image, ra, dec);
     });
     // START THE CAMERA'S TIMER!
     SetTimer(getCurrentPollingPeriod());
@@ -435,11 +431,11 @@ bool OriginCamera::Disconnect()
 }
 
 
-void OriginCamera::onImageReady(const QString& filePath, const QByteArray& imageData,
+void OriginCamera::onImageReady(const QString& filePath, std::shared_ptr<OriginImage> image,
                                  double ra, double dec)
 {
     qDebug() << "Image ready callback received:" << filePath 
-             << "Size:" << imageData.size() << "bytes";
+             << "Size:" << image->width << "x" << image->height;
     
     // Check if this is a preview or full capture based on filename
     bool isPreview = filePath.contains("jpg", Qt::CaseInsensitive);
@@ -469,7 +465,7 @@ void OriginCamera::onImageReady(const QString& filePath, const QByteArray& image
     
     // This is the image we want!
     m_pendingImagePath = filePath;
-    m_pendingImageData = imageData;
+    m_pendingImage = image;
     m_pendingImageRA = ra;
     m_pendingImageDec = dec;
     m_imageReady = true;
@@ -484,7 +480,7 @@ bool OriginCamera::StartExposure(float duration)
     // Clear previous state
     m_imageReady = false;
     m_pendingImagePath.clear();
-    m_pendingImageData.clear();
+    m_pendingImage.reset();
     m_waitingForImage = true;
     m_useNextImage = true;
     
@@ -492,6 +488,9 @@ bool OriginCamera::StartExposure(float duration)
     int iso = GainNP[0].getValue();
     
     qDebug() << "Using ISO:" << iso << "Mode:" << (m_isPreviewMode ? "Preview" : "Full");
+
+    // Previews are only downloaded while one is wanted
+    backend->setPreviewWanted(m_isPreviewMode);
     
     bool success;
     
@@ -534,7 +533,8 @@ bool OriginCamera::AbortExposure()
     m_imageReady = false;
     m_waitingForImage = false;
     m_useNextImage = false;
-    m_pendingImageData.clear();
+    m_pendingImage.reset();
+    backend->setPreviewWanted(false);
     
     return true;
 }
@@ -554,6 +554,9 @@ void OriginCamera::TimerHit()
 {  
     if (!isConnected())
         return;
+
+    // Collect images the backend finished decoding since the last poll
+    backend->pollImages();
     
     if (InExposure)
     {
@@ -564,7 +567,7 @@ void OriginCamera::TimerHit()
         if (m_isPreviewMode)
         {
             // Preview mode: complete as soon as we have an image
-            canComplete = m_imageReady && !m_pendingImageData.isEmpty();
+            canComplete = m_imageReady && m_pendingImage;
         }
         else
         {
@@ -581,7 +584,7 @@ void OriginCamera::TimerHit()
             {
                 // Exposure time complete, check for image
                 PrimaryCCD.setExposureLeft(0);
-                canComplete = m_imageReady && !m_pendingImageData.isEmpty();
+                canComplete = m_imageReady && m_pendingImage;
                 
                 if (!canComplete && false)
                 {
@@ -594,14 +597,16 @@ void OriginCamera::TimerHit()
         {
             qDebug() << "Exposure complete and image data ready, processing...";
             
-            if (processAndUploadImage(m_pendingImageData))
+            backend->setPreviewWanted(false);
+
+            if (processAndUploadImage(*m_pendingImage))
             {
                 qDebug() << "Image processed and sent to client";
                 InExposure = false;
                 m_imageReady = false;
                 m_waitingForImage = false;
                 m_useNextImage = false;
-                m_pendingImageData.clear();
+                m_pendingImage.reset();
             }
             else
             {
@@ -611,7 +616,7 @@ void OriginCamera::TimerHit()
                 m_imageReady = false;
                 m_waitingForImage = false;
                 m_useNextImage = false;
-                m_pendingImageData.clear();
+                m_pendingImage.reset();
             }
         }
     }
@@ -658,128 +663,19 @@ bool OriginCamera::initProperties()
     return true;
 }
 
-bool OriginCamera::processAndUploadImage(const QByteArray& imageData)
+bool OriginCamera::processAndUploadImage(const OriginImage& image)
 {
-    qDebug() << "Processing 16-bit RGB TIFF with libtiff:" << imageData.size() << "bytes";
-    
-    // Use QStandardPaths to get a persistent temp directory
-    QString tempDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
-    
-    // Create the directory if it doesn't exist
-    QDir dir(tempDir);
-    if (!dir.exists())
-    {
-        if (!dir.mkpath("."))
-        {
-            qDebug() << "Failed to create cache directory:" << tempDir;
-            return false;
-        }
-    }
-    
-    // Create temp file in persistent location
-    QString tempPath = QString("%1/origin_temp_%2.tiff")
-                           .arg(tempDir)
-                           .arg(QDateTime::currentMSecsSinceEpoch());
-    
-    QFile tempFile(tempPath);
-    if (!tempFile.open(QIODevice::WriteOnly))
-    {
-        qDebug() << "Failed to create temp file";
-        return false;
-    }
-    tempFile.write(imageData);
-    tempFile.close();
-    
-    // Open TIFF with libtiff
-    TIFF* tif = TIFFOpen(tempPath.toUtf8().constData(), "r");
-    if (!tif)
-    {
-        qDebug() << "Failed to open TIFF with libtiff";
-        QFile::remove(tempPath);
-        return false;
-    }
-    
-    // Read TIFF properties
-    uint32_t width, height;
-    uint16_t samplesperpixel, bitspersample, photometric, config;
-    
-    TIFFGetField(tif, TIFFTAG_IMAGEWIDTH, &width);
-    TIFFGetField(tif, TIFFTAG_IMAGELENGTH, &height);
-    TIFFGetField(tif, TIFFTAG_SAMPLESPERPIXEL, &samplesperpixel);
-    TIFFGetField(tif, TIFFTAG_BITSPERSAMPLE, &bitspersample);
-    TIFFGetField(tif, TIFFTAG_PHOTOMETRIC, &photometric);
-    TIFFGetField(tif, TIFFTAG_PLANARCONFIG, &config);
-    
-    qDebug() << "TIFF properties: width=" << width << "height=" << height
-             << "samples=" << samplesperpixel << "bits=" << bitspersample
-             << "photometric=" << photometric << "planar=" << config;
-    
-    if (samplesperpixel != 3 || bitspersample != 16)
-    {
-        qDebug() << "Unexpected TIFF format";
-        TIFFClose(tif);
-        QFile::remove(tempPath);
-        return false;
-    }
-    
-    // Set up for 3-axis FITS (RGB cube)
-    PrimaryCCD.setFrame(0, 0, width, height);
+    qDebug() << "Uploading" << image.width << "x" << image.height << image.bpp << "bit RGB image";
+
+    // The pipeline already decoded the image into planar RGB on its own thread
+    PrimaryCCD.setFrame(0, 0, image.width, image.height);
     PrimaryCCD.setExposureDuration(m_exposureDuration);
+    PrimaryCCD.setBPP(image.bpp);
     PrimaryCCD.setNAxis(3);
-    
-    // Allocate buffer
-    int planeSize = width * height;
-    PrimaryCCD.setFrameBufferSize(planeSize * 3 * sizeof(uint16_t));
-    uint16_t *image = (uint16_t *)PrimaryCCD.getFrameBuffer();
-    
-    // Allocate scanline buffer
-    uint16_t *scanline = (uint16_t *)_TIFFmalloc(TIFFScanlineSize(tif));
-    
-    if (!scanline)
-    {
-        qDebug() << "Failed to allocate scanline buffer";
-        TIFFClose(tif);
-        QFile::remove(tempPath);
-        return false;
-    }
-    
-    // Read TIFF data line by line and convert to planar RGB
-    qDebug() << "Reading TIFF data...";
-    
-    for (uint32_t row = 0; row < height; row++)
-    {
-        if (TIFFReadScanline(tif, scanline, row) < 0)
-        {
-            qDebug() << "Error reading scanline" << row;
-            break;
-        }
-        
-        // Convert interleaved RGB to planar RGB
-        // scanline format: R0 G0 B0 R1 G1 B1 R2 G2 B2 ...
-        // output format: R0 R1 R2 ... G0 G1 G2 ... B0 B1 B2 ...
-        for (uint32_t col = 0; col < width; col++)
-        {
-            int idx = row * width + col;
-            int scanIdx = col * 3;
-            
-            image[idx] = scanline[scanIdx];                    // R plane
-            image[planeSize + idx] = scanline[scanIdx + 1];    // G plane
-            image[planeSize * 2 + idx] = scanline[scanIdx + 2]; // B plane
-        }
-    }
-    
-    // Cleanup
-    _TIFFfree(scanline);
-    TIFFClose(tif);
-    //    QFile::remove(tempPath);
-    qDebug() << "TIFF file left in: " << tempPath;
-    
-    // Sample center pixel to verify
-    int centerIdx = (height / 2) * width + (width / 2);
-    qDebug() << "Center pixel values: R=" << image[centerIdx] 
-             << "G=" << image[planeSize + centerIdx]
-             << "B=" << image[planeSize*2 + centerIdx];
-    
+
+    PrimaryCCD.setFrameBufferSize(image.data.size());
+    memcpy(PrimaryCCD.getFrameBuffer(), image.data.data(), image.data.size());
+
     qDebug() << "3-axis RGB FITS ready, sending to Ekos";
     
     // Send to Ekos
@@ -80,7 +80,7 @@ private:
     // Image callback support
     bool m_imageReady {false};
     QString m_pendingImagePath;
-    QByteArray m_pendingImageData;
+    std::shared_ptr<OriginImage> m_pendingImage;
     double m_pendingImageRA {0};
     double m_pendingImageDec {0};
     
@@ -98,8 +98,8 @@ private:
     bool m_isPreviewMode {false};
     
     // Methods
-    void onImageReady(const QString& filePath, const QByteArray& imageData,
+    void onImageReady(const QString& filePath, std::shared_ptr<OriginImage> image,
                      double ra, double dec);
-    bool processAndUploadImage(const QByteArray& imageData);
+    bool processAndUploadImage(const OriginImage& image);
     double currentTime();
 };
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include "OriginHttpClient.hpp"
+#include "OriginImagePipeline.hpp"
+#include "http_fixture.h"
+
+#include <chrono>
+#include <random>
+
+static std::vector<uint8_t> randomImage(size_t size, unsigned seed)
+{
+    std::mt19937 generator(seed);
+    std::vector<uint8_t> data(size);
+    for (auto &byte : data)
+        byte = generator() & 0xff;
+    return data;
+}
+
+static const std::string IMAGE_PATH = "/SmartScope-1.0/dev2/Images/Temp/0.tiff";
+
+TEST(OriginHttpClient, KeepAlive)
+{
+    HttpFixture server;
+    for (int i = 0; i < 3; i++)
+        server.setDocument("/image" + std::to_string(i), randomImage(4 * 1024 * 1024 + i, i));
+
+    OriginHttpClient client("127.0.0.1", server.port());
+    std::vector<uint8_t> body;
+    for (int i = 0; i < 3; i++)
+    {
+        OriginHttpClient::Stats stats;
+        ASSERT_TRUE(client.get("/image" + std::to_string(i), body, &stats)) << client.lastError();
+        EXPECT_EQ(body, randomImage(4 * 1024 * 1024 + i, i));
+        EXPECT_EQ(stats.bytes, body.size());
+        EXPECT_EQ(stats.reused, i > 0);
+    }
+
+    // All three images over the same connection
+    EXPECT_EQ(server.accepted(), 1);
+    EXPECT_EQ(client.connections(), 1);
+}
+
+TEST(OriginHttpClient, ConnectionClose)
+{
+    HttpFixture server(HttpFixture::CLOSE);
+    server.setDocument(IMAGE_PATH, randomImage(100000, 1));
+
+    OriginHttpClient client("127.0.0.1", server.port());
+    std::vector<uint8_t> body;
+    for (int i = 0; i < 2; i++)
+    {
+        ASSERT_TRUE(client.get(IMAGE_PATH, body)) << client.lastError();
+        EXPECT_EQ(body, randomImage(100000, 1));
+        EXPECT_FALSE(client.isConnected());
+    }
+    EXPECT_EQ(server.accepted(), 2);
+}
+
+TEST(OriginHttpClient, ServerDropsIdleConnection)
+{
+    HttpFixture server(HttpFixture::DROP_IDLE);
+    server.setDocument(IMAGE_PATH, randomImage(100000, 2));
+
+    OriginHttpClient client("127.0.0.1", server.port());
+    std::vector<uint8_t> body;
+    for (int i = 0; i < 3; i++)
+    {
+        // Give the server time to close, the next request then finds a dead connection and retries
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ASSERT_TRUE(client.get(IMAGE_PATH, body)) << client.lastError();
+        EXPECT_EQ(body, randomImage(100000, 2));
+    }
+    EXPECT_EQ(server.requests(), 3);
+}
+
+TEST(OriginHttpClient, Chunked)
+{
+    HttpFixture server(HttpFixture::CHUNKED);
+    server.setDocument(IMAGE_PATH, randomImage(1000001, 3));
+
+    OriginHttpClient client("127.0.0.1", server.port());
+    std::vector<uint8_t> body;
+    for (int i = 0; i < 2; i++)
+    {
+        ASSERT_TRUE(client.get(IMAGE_PATH, body)) << client.lastError();
+        EXPECT_EQ(body, randomImage(1000001, 3));
+    }
+    EXPECT_EQ(server.accepted(), 1);
+}
+
+TEST(OriginHttpClient, NotFound)
+{
+    HttpFixture server;
+    server.setDocument(IMAGE_PATH, randomImage(1000, 4));
+
+    OriginHttpClient client("127.0.0.1", server.port());
+    std::vector<uint8_t> body;
+    EXPECT_FALSE(client.get("/missing.tiff", body));
+    EXPECT_EQ(client.lastError(), "HTTP status 404");
+
+    // The connection is still usable after an error status
+    ASSERT_TRUE(client.get(IMAGE_PATH, body)) << client.lastError();
+    EXPECT_EQ(body.size(), 1000u);
+}
+
+TEST(OriginHttpClient, ConnectionRefused)
+{
+    int port;
+    {
+        HttpFixture server;
+        port = server.port();
+    }
+
+    OriginHttpClient client("127.0.0.1", port, 1000);
+    std::vector<uint8_t> body;
+    EXPECT_FALSE(client.get(IMAGE_PATH, body));
+    EXPECT_FALSE(client.lastError().empty());
+}
+
+TEST(OriginImagePipeline, DownloadAndDecode)
+{
+    HttpFixture server;
+    const int count = 5;
+    for (int i = 0; i < count; i++)
+        server.setDocument("/image" + std::to_string(i), randomImage(2 * 1024 * 1024, i));
+    server.setDocument("/bad", "x");
+
+    std::thread::id caller = std::this_thread::get_id();
+    std::atomic<bool> decodedOnCaller {false};
+
+    // Stand-in decoder: the first byte becomes the image width
+    OriginImagePipeline pipeline("127.0.0.1", server.port(), [&](const std::vector<uint8_t>& body, OriginImage & image)
+    {
+        if (std::this_thread::get_id() == caller)
+            decodedOnCaller = true;
+        if (body.size() < 2)
+        {
+            image.error = "Too short";
+            return;
+        }
+        image.width = body[0];
+        image.data = body;
+    });
+    pipeline.start();
+
+    for (int i = 0; i < count; i++)
+        pipeline.request("/image" + std::to_string(i));
+    pipeline.request("/bad");
+    pipeline.request("/missing");
+
+    std::vector<std::shared_ptr<OriginImage>> ready, images;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (ready.size() < count + 2u && std::chrono::steady_clock::now() < deadline)
+    {
+        pipeline.takeReady(images);
+        ready.insert(ready.end(), images.begin(), images.end());
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    pipeline.stop();
+
+    ASSERT_EQ(ready.size(), count + 2u);
+    for (int i = 0; i < count; i++)
+    {
+        EXPECT_EQ(ready[i]->path, "/image" + std::to_string(i));
+        EXPECT_TRUE(ready[i]->error.empty());
+        EXPECT_EQ(ready[i]->data, randomImage(2 * 1024 * 1024, i));
+        EXPECT_EQ(ready[i]->width, ready[i]->data[0]);
+        EXPECT_EQ(ready[i]->download.bytes, 2 * 1024 * 1024u);
+    }
+    EXPECT_EQ(ready[count]->error, "Too short");
+    EXPECT_EQ(ready[count + 1]->error, "HTTP status 404");
+    EXPECT_FALSE(decodedOnCaller);
+    EXPECT_EQ(pipeline.connections(), 1);
+}
+
+TEST(OriginImagePipeline, StopWhileDownloading)
+{
+    HttpFixture server;
+    server.setDocument(IMAGE_PATH, randomImage(64 * 1024 * 1024, 5));
+
+    OriginImagePipeline pipeline("127.0.0.1", server.port(), [](const std::vector<uint8_t>&, OriginImage &) {});
+    pipeline.start();
+    pipeline.request(IMAGE_PATH);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    auto start = std::chrono::steady_clock::now();
+    pipeline.stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+}
@@ -0,0 +1,287 @@
+/*
+    Celestron AUX Bus Reader
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "auxbus.h"
+
+#include <indilogger.h>
+
+#include <algorithm>
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+
+constexpr std::chrono::milliseconds AUXBus::REQUEST_EXPIRY;
+constexpr size_t AUXBus::MAX_UNSOLICITED;
+
+AUXBus::~AUXBus()
+{
+    stop();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/////////////////////////////////////////////////////////////////////////////////////
+void AUXBus::start(int fd)
+{
+    stop();
+
+    m_FD = fd;
+    m_Stream.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_Lock);
+        m_Requests.clear();
+        m_Unsolicited.clear();
+        m_Latency.clear();
+    }
+    m_Running = true;
+    m_Reader = std::thread(&AUXBus::readLoop, this);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/////////////////////////////////////////////////////////////////////////////////////
+void AUXBus::stop()
+{
+    m_Running = false;
+    if (m_Reader.joinable())
+        m_Reader.join();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/////////////////////////////////////////////////////////////////////////////////////
+void AUXBus::expect(const AUXCommand &command)
+{
+    Request request;
+    // The reply comes back from the destination with the same command
+    request.source      = command.destination();
+    request.destination = command.source();
+    request.command     = command.command();
+    request.sent        = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(m_Lock);
+    m_Requests.push_back(request);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/////////////////////////////////////////////////////////////////////////////////////
+bool AUXBus::waitReply(const AUXCommand &command, int timeoutMs, AUXCommand &reply)
+{
+    std::unique_lock<std::mutex> lock(m_Lock);
+
+    auto request = std::find_if(m_Requests.begin(), m_Requests.end(), [&command](const Request & r)
+    {
+        return !r.waited && r.source == command.destination() && r.destination == command.source() &&
+               r.command == command.command();
+    });
+    if (request == m_Requests.end())
+        return false;
+
+    request->waited = true;
+    m_Replied.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this, request]()
+    {
+        return request->done || !m_Running;
+    });
+
+    bool done = request->done;
+    if (done)
+        reply = request->reply;
+    else
+        m_Latency[request->source].timeouts++;
+    m_Requests.erase(request);
+    return done;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/////////////////////////////////////////////////////////////////////////////////////
+void AUXBus::takeUnsolicited(std::vector<AUXCommand> &packets)
+{
+    std::lock_guard<std::mutex> lock(m_Lock);
+    packets.assign(m_Unsolicited.begin(), m_Unsolicited.end());
+    m_Unsolicited.clear();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/////////////////////////////////////////////////////////////////////////////////////
+AUXBus::Latency AUXBus::latency(AUXTargets target)
+{
+    std::lock_guard<std::mutex> lock(m_Lock);
+    auto entry = m_Latency.find(target);
+    return entry == m_Latency.end() ? Latency() : entry->second;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/////////////////////////////////////////////////////////////////////////////////////
+void AUXBus::resetLatency()
+{
+    std::lock_guard<std::mutex> lock(m_Lock);
+    m_Latency.clear();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Reader thread
+/////////////////////////////////////////////////////////////////////////////////////
+void AUXBus::readLoop()
+{
+    uint8_t buf[512];
+
+    while (m_Running)
+    {
+        pollfd pfd {m_FD, POLLIN, 0};
+        int rc = poll(&pfd, 1, 100);
+        if (rc < 0 && errno != EINTR)
+        {
+            DEBUGFDEVICE(AUXCommand::DEVICE_NAME, INDI::Logger::DBG_WARNING, "AUX reader poll failed: %s", strerror(errno));
+            break;
+        }
+
+        if (rc > 0)
+        {
+            ssize_t n = read(m_FD, buf, sizeof(buf));
+            if (n > 0)
+            {
+                m_Stream.insert(m_Stream.end(), buf, buf + n);
+                frame();
+            }
+            else if (n == 0 || (errno != EAGAIN && errno != EINTR))
+            {
+                DEBUGFDEVICE(AUXCommand::DEVICE_NAME, INDI::Logger::DBG_WARNING, "AUX reader stopped: %s",
+                             n == 0 ? "connection closed" : strerror(errno));
+                break;
+            }
+        }
+
+        expire();
+    }
+
+    // Release anybody still waiting
+    std::lock_guard<std::mutex> lock(m_Lock);
+    m_Running = false;
+    m_Replied.notify_all();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Extract the complete packets from the stream.
+/// A packet is 0x3b <len> <source> <destination> <command> <len - 3 bytes of data> <checksum>
+/////////////////////////////////////////////////////////////////////////////////////
+void AUXBus::frame()
+{
+    size_t start = 0;
+    while (true)
+    {
+        auto preamble = std::find(m_Stream.begin() + start, m_Stream.end(), 0x3b);
+        if (preamble - m_Stream.begin() > static_cast<long>(start))
+            DEBUGFDEVICE(AUXCommand::DEVICE_NAME, AUXCommand::DEBUG_LEVEL, "AUX reader skipped %d bytes",
+                         static_cast<int>(preamble - m_Stream.begin() - start));
+        start = preamble - m_Stream.begin();
+        if (m_Stream.size() - start < 2)
+            break;
+
+        uint8_t len = m_Stream[start + 1];
+        if (len < 3)
+        {
+            start++;
+            continue;
+        }
+        if (m_Stream.size() - start < len + 3u)
+            break;
+
+        int sum = 0;
+        for (size_t i = start + 1; i < start + len + 2; i++)
+            sum += m_Stream[i];
+        if (static_cast<uint8_t>(-sum) != m_Stream[start + len + 2])
+        {
+            // Not a packet boundary after all, resynchronize on the next preamble
+            DEBUGDEVICE(AUXCommand::DEVICE_NAME, AUXCommand::DEBUG_LEVEL, "AUX reader checksum error, resynchronizing");
+            start++;
+            continue;
+        }
+
+        dispatch(AUXBuffer(m_Stream.begin() + start, m_Stream.begin() + start + len + 3));
+        start += len + 3;
+    }
+
+    m_Stream.erase(m_Stream.begin(), m_Stream.begin() + start);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/////////////////////////////////////////////////////////////////////////////////////
+void AUXBus::dispatch(const AUXBuffer &packet)
+{
+    AUXCommand command(packet);
+    auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(m_Lock);
+    for (auto &request : m_Requests)
+    {
+        if (request.done || request.source != command.source() || request.destination != command.destination() ||
+                request.command != command.command())
+            continue;
+
+        request.done  = true;
+        request.reply = command;
+
+        double ms = std::chrono::duration<double, std::milli>(now - request.sent).count();
+        Latency &latency = m_Latency[request.source];
+        latency.replies++;
+        latency.last = ms;
+        latency.mean += (ms - latency.mean) / latency.replies;
+        latency.max = std::max(latency.max, ms);
+
+        m_Replied.notify_all();
+        return;
+    }
+
+    if (m_Unsolicited.size() >= MAX_UNSOLICITED)
+        m_Unsolicited.pop_front();
+    m_Unsolicited.push_back(command);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Drop requests nobody waits for, e.g. commands sent without reading the reply.
+/////////////////////////////////////////////////////////////////////////////////////
+void AUXBus::expire()
+{
+    auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(m_Lock);
+    for (auto request = m_Requests.begin(); request != m_Requests.end();)
+    {
+        if (request->waited || now - request->sent < REQUEST_EXPIRY)
+        {
+            ++request;
+            continue;
+        }
+
+        if (request->done)
+        {
+            if (m_Unsolicited.size() >= MAX_UNSOLICITED)
+                m_Unsolicited.pop_front();
+            m_Unsolicited.push_back(request->reply);
+        }
+        request = m_Requests.erase(request);
+    }
+}
@@ -0,0 +1,119 @@
+/*
+    Celestron AUX Bus Reader
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include "auxproto.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief The AUXBus class reads the AUX stream of a direct connection (network, AUX or mount USB port)
+ * on its own thread.
+ *
+ * Packets are framed from a buffered stream and handed to the request waiting for them, matched on the
+ * (source, destination, command) of the expected reply, oldest request first. Several requests to
+ * different targets may be outstanding at once. Any other packet, e.g. queries of other bus devices,
+ * is queued as unsolicited traffic for the driver thread, so driver state is only touched by that thread.
+ */
+class AUXBus
+{
+    public:
+        // Reply latency per target, in ms
+        struct Latency
+        {
+            uint32_t replies {0};
+            uint32_t timeouts {0};
+            double last {0};
+            double mean {0};
+            double max {0};
+        };
+
+        AUXBus() = default;
+        ~AUXBus();
+
+        void start(int fd);
+        void stop();
+        bool isRunning() const
+        {
+            return m_Running;
+        }
+
+        /**
+         * @brief expect Register the reply to a command. Must be called before the command is written.
+         */
+        void expect(const AUXCommand &command);
+
+        /**
+         * @brief waitReply Wait for the reply to a command registered with expect().
+         * @return True if the reply arrived within timeoutMs, false otherwise.
+         */
+        bool waitReply(const AUXCommand &command, int timeoutMs, AUXCommand &reply);
+
+        /**
+         * @brief takeUnsolicited Move the packets nobody waited for to packets, oldest first.
+         */
+        void takeUnsolicited(std::vector<AUXCommand> &packets);
+
+        Latency latency(AUXTargets target);
+        void resetLatency();
+
+    private:
+        struct Request
+        {
+            uint8_t source {0};
+            uint8_t destination {0};
+            uint8_t command {0};
+            std::chrono::steady_clock::time_point sent;
+            bool waited {false};
+            bool done {false};
+            AUXCommand reply;
+        };
+
+        void readLoop();
+        void frame();
+        void dispatch(const AUXBuffer &packet);
+        void expire();
+
+        int m_FD {-1};
+        std::atomic<bool> m_Running {false};
+        std::thread m_Reader;
+
+        // Guards requests, unsolicited packets and latencies
+        std::mutex m_Lock;
+        std::condition_variable m_Replied;
+        std::list<Request> m_Requests;
+        std::deque<AUXCommand> m_Unsolicited;
+        std::map<uint8_t, Latency> m_Latency;
+
+        // Bytes read but not framed yet, reader thread only
+        AUXBuffer m_Stream;
+
+        // Requests not waited for are dropped after this, a reply that did arrive goes to the unsolicited queue
+        static constexpr std::chrono::milliseconds REQUEST_EXPIRY {3000};
+        static constexpr size_t MAX_UNSOLICITED {256};
+};
@@ -163,8 +163,8 @@ class AUXCommand
         uint8_t len {0};
         bool valid {false};
 
-        AUXCommands m_Command;
-        AUXTargets m_Source, m_Destination;
+        AUXCommands m_Command {MC_GET_POSITION};
+        AUXTargets m_Source {ANY}, m_Destination {ANY};
         AUXBuffer m_Data;
 
 
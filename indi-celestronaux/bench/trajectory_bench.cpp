@@ -0,0 +1,220 @@
+/*
+ Alt-Az Tracking Trajectory Benchmark
+
+ Compares the tracking prediction of CelestronAUX::TimerHit before and after the
+ trajectory engine: three coordinate transforms per tick with a +/-5 s central
+ difference, against rate and acceleration evaluated from TrackingTrajectory.
+ Both run over the same simulated session for a set of targets, one of them
+ transiting a degree from the zenith.
+
+ The transform is INDI::EquatorialToHorizontal, i.e. the driver without an
+ alignment model. With a model each transform also runs the math plugin, so the
+ saving per tick is larger on a real mount.
+
+ Usage:
+   ./caux_trajectory_bench [--hours <h>] [--tick <s>] [--latitude <deg>]
+
+ Options:
+   --hours    <h>    Simulated tracking time per target (default: 2)
+   --tick     <s>    Tracking update period (default: 1)
+   --latitude <deg>  Observer latitude (default: 50)
+
+ Tracking error is the distance between where the commanded position and rate
+ put the axis at the next tick and where the target actually is, in arcsec.
+
+ Copyright (C) 2026 agent (agent@local)
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "trajectory.h"
+
+#include <libastro.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static void printUsage(const char *prog)
+{
+    printf("Usage: %s [--hours <h>] [--tick <s>] [--latitude <deg>]\n\n", prog);
+    printf("  --hours    <h>    Simulated tracking time per target (default: 2)\n");
+    printf("  --tick     <s>    Tracking update period (default: 1)\n");
+    printf("  --latitude <deg>  Observer latitude (default: 50)\n");
+}
+
+// Commanded position and mean rate for one tick, both axes, degrees and degrees/s
+struct Command
+{
+    double position[2];
+    double rate[2];
+};
+
+struct Errors
+{
+    double sum2[2] {0, 0};
+    double max[2] {0, 0};
+    size_t n {0};
+
+    void add(const double error[2])
+    {
+        for (int axis = 0; axis < 2; axis++)
+        {
+            sum2[axis] += error[axis] * error[axis];
+            max[axis] = std::max(max[axis], std::abs(error[axis]));
+        }
+        n++;
+    }
+    double rms(int axis) const
+    {
+        return n > 0 ? std::sqrt(sum2[axis] / n) : 0;
+    }
+};
+
+static INDI::IGeographicCoordinates location { 8.0, 50.0, 100 };
+
+static void mountAxisCoordinates(double ra, double de, double jd, double &azimuth, double &altitude)
+{
+    INDI::IEquatorialCoordinates equatorial { ra, de };
+    INDI::IHorizontalCoordinates horizontal { 0, 0 };
+    INDI::EquatorialToHorizontal(&equatorial, &location, jd, &horizontal);
+    azimuth  = horizontal.azimuth;
+    altitude = horizontal.altitude;
+}
+
+// The former TimerHit prediction: position now and the rate from positions 5 s before and after.
+static void centralDifference(double ra, double de, double jd, Command &command)
+{
+    const double timeStep = 5.0;
+    const double JDoffset = timeStep / 86400;
+    double past[2], future[2];
+
+    mountAxisCoordinates(ra, de, jd, command.position[0], command.position[1]);
+    mountAxisCoordinates(ra, de, jd + JDoffset, future[0], future[1]);
+    mountAxisCoordinates(ra, de, jd - JDoffset, past[0], past[1]);
+
+    command.rate[0] = std::remainder(future[0] - past[0], 360.0) / timeStep / 2;
+    command.rate[1] = (future[1] - past[1]) / timeStep / 2;
+}
+
+int main(int argc, char *argv[])
+{
+    double hours = 2, tick = 1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--hours") && i + 1 < argc)
+            hours = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--tick") && i + 1 < argc)
+            tick = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--latitude") && i + 1 < argc)
+            location.latitude = atof(argv[++i]);
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (hours <= 0 || tick <= 0 || std::abs(location.latitude) >= 90)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // 2026-03-20 20:00 UT
+    const double JD0 = 2461120.333333;
+    size_t ticks = static_cast<size_t>(hours * 3600 / tick);
+
+    struct Target
+    {
+        const char *name;
+        double ra, de;
+    };
+    // RA on the meridian an hour into the session (local sidereal time), so the targets cross it
+    double meridian = std::fmod(280.46061837 + 360.98564736629 * (JD0 + 1.0 / 24 - 2451545.0) + location.longitude, 360.0) / 15;
+    std::vector<Target> targets =
+    {
+        { "east, low", std::fmod(meridian + 4, 24.0), 10 },
+        { "meridian", meridian, 20 },
+        { "near pole", meridian, location.latitude > 0 ? 80.0 : -80.0 },
+        { "near zenith", meridian, location.latitude > 0 ? location.latitude - 1 : location.latitude + 1 },
+    };
+
+    printf("Alt-Az tracking prediction, %.1f h per target, %.1f s ticks, latitude %.1f\n\n", hours, tick,
+           location.latitude);
+    printf("%-12s %-20s %12s %10s %10s %10s %10s %8s\n", "target", "method", "us/tick", "AZ rms\"", "AZ max\"",
+           "ALT rms\"", "ALT max\"", "fits");
+
+    for (const Target &target : targets)
+    {
+        std::vector<Command> before(ticks), after(ticks);
+
+        // Former approach
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ticks; i++)
+            centralDifference(target.ra, target.de, JD0 + i * tick / 86400, before[i]);
+        double beforeTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        // Trajectory, refitted as TimerHit does when the tick leaves the current piece
+        TrackingTrajectory trajectory;
+        trajectory.setTarget(target.ra, target.de);
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ticks; i++)
+        {
+            double jd = JD0 + i * tick / 86400;
+            if (!trajectory.covers(jd + tick / 86400))
+                trajectory.fit(jd, [&](double offset, double & azimuth, double & altitude)
+            {
+                mountAxisCoordinates(target.ra, target.de, jd + offset / 86400, azimuth, altitude);
+            });
+
+            double position[2], rate[2], acceleration[2];
+            trajectory.evaluate(jd, position, rate, acceleration);
+            for (int axis = 0; axis < 2; axis++)
+            {
+                after[i].position[axis] = position[axis];
+                after[i].rate[axis]     = rate[axis] + acceleration[axis] * tick / 2;
+            }
+        }
+        double afterTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        // Tracking error at the next tick
+        Errors beforeErrors, afterErrors;
+        for (size_t i = 0; i + 1 < ticks; i++)
+        {
+            double next[2];
+            mountAxisCoordinates(target.ra, target.de, JD0 + (i + 1) * tick / 86400, next[0], next[1]);
+            for (const auto &pair : { std::make_pair(&before[i], &beforeErrors), std::make_pair(&after[i], &afterErrors) })
+            {
+                double error[2];
+                error[0] = std::remainder(pair.first->position[0] + pair.first->rate[0] * tick - next[0], 360.0) * 3600;
+                error[1] = (pair.first->position[1] + pair.first->rate[1] * tick - next[1]) * 3600;
+                pair.second->add(error);
+            }
+        }
+
+        printf("%-12s %-20s %12.3f %10.4f %10.4f %10.4f %10.4f %8s\n", target.name, "central difference",
+               beforeTime / ticks, beforeErrors.rms(0), beforeErrors.max[0], beforeErrors.rms(1), beforeErrors.max[1], "-");
+        printf("%-12s %-20s %12.3f %10.4f %10.4f %10.4f %10.4f %8u\n", "", "trajectory",
+               afterTime / ticks, afterErrors.rms(0), afterErrors.max[0], afterErrors.rms(1), afterErrors.max[1],
+               trajectory.fits());
+    }
+
+    return 0;
+}
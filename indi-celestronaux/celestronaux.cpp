@@ -44,6 +44,15 @@ using namespace INDI::AlignmentSubsystem;
 static constexpr double MIN_TRACK_RATE_FACTOR =
     0.1; // Factor to ensure track rate doesn't go below a certain threshold of predicted rate
 
+// Keeps the commanded rate on the side of the predicted rate and at least MIN_TRACK_RATE_FACTOR of it
+static double limitTrackRate(double predicted, double rate)
+{
+    double minRate = predicted * MIN_TRACK_RATE_FACTOR;
+    if (rate * predicted < 0 || std::abs(rate) < std::abs(minRate))
+        return minRate;
+    return rate;
+}
+
 static std::unique_ptr<CelestronAUX> telescope_caux(new CelestronAUX());
 
 double anglediff(double a, double b)
@@ -91,6 +100,12 @@ CelestronAUX::CelestronAUX()
         GuideWENP.apply();
     });
 
+    m_RateTimer.setInterval(RATE_UPDATE_MS);
+    m_RateTimer.callOnTimeout([this]()
+    {
+        updateTrackRates();
+    });
+
     m_GuideDETimer.setSingleShot(true);
     m_GuideDETimer.callOnTimeout([this]()
     {
@@ -152,6 +167,11 @@ bool CelestronAUX::Handshake()
         else
             std::this_thread::sleep_for(std::chrono::milliseconds(500));
 
+        // Direct connections are read by the background reader. The hand controller passthrough and the
+        // half duplex PC port, which echoes what we write, are read synchronously after each command.
+        if (getActiveConnection() != serialConnection || (!m_IsRTSCTS && !m_isHandController))
+            m_AUXBus.start(PortFD);
+
         // read firmware version, if read ok, detected scope
         LOG_DEBUG("Communicating with mount motor controllers...");
         if (getVersion(AZM) && getVersion(ALT))
@@ -162,6 +182,7 @@ bool CelestronAUX::Handshake()
         {
             LOG_ERROR("Got no response from target ALT or AZM.");
             LOG_ERROR("Cannot continue without connection to motor controllers.");
+            m_AUXBus.stop();
             return false;
         }
 
@@ -227,7 +248,9 @@ bool CelestronAUX::Handshake()
 /////////////////////////////////////////////////////////////////////////////////////
 bool CelestronAUX::Disconnect()
 {
+    m_RateTimer.stop();
     Abort();
+    m_AUXBus.stop();
     return INDI::Telescope::Disconnect();
 }
 
@@ -419,6 +442,16 @@ bool CelestronAUX::initProperties()
     AngleNP[AXIS_ALT].fill("AXIS_ALT", "Axis 2", "%.2f", -90, 90, 0, 0);
     AngleNP.fill(getDeviceName(), "TELESCOPE_ENCODER_ANGLES", "Angles", MOUNTINFO_TAB, IP_RO, 60, IPS_IDLE);
 
+    // AUX reply latency
+    AUXLatencyNP[LATENCY_AZM_MEAN].fill("AZM_MEAN", "AZM mean (ms)", "%.1f", 0, 10000, 0, 0);
+    AUXLatencyNP[LATENCY_AZM_MAX].fill("AZM_MAX", "AZM max (ms)", "%.1f", 0, 10000, 0, 0);
+    AUXLatencyNP[LATENCY_ALT_MEAN].fill("ALT_MEAN", "ALT mean (ms)", "%.1f", 0, 10000, 0, 0);
+    AUXLatencyNP[LATENCY_ALT_MAX].fill("ALT_MAX", "ALT max (ms)", "%.1f", 0, 10000, 0, 0);
+    AUXLatencyNP[LATENCY_FOCUS_MEAN].fill("FOCUS_MEAN", "Focuser mean (ms)", "%.1f", 0, 10000, 0, 0);
+    AUXLatencyNP[LATENCY_FOCUS_MAX].fill("FOCUS_MAX", "Focuser max (ms)", "%.1f", 0, 10000, 0, 0);
+    AUXLatencyNP[LATENCY_TIMEOUTS].fill("TIMEOUTS", "Timeouts", "%.f", 0, 1e9, 0, 0);
+    AUXLatencyNP.fill(getDeviceName(), "AUX_LATENCY", "AUX Latency", MOUNTINFO_TAB, IP_RO, 60, IPS_IDLE);
+
     // PID Control
     Axis1PIDNP[Propotional].fill("Propotional", "Propotional", "%.2f", 0, 500, 10, 0);
     Axis1PIDNP[Derivative].fill("Derivative", "Derivative", "%.2f", 0, 500, 10, 0);
@@ -592,6 +625,8 @@ bool CelestronAUX::updateProperties()
         // Encoders
         defineProperty(EncoderNP);
         defineProperty(AngleNP);
+        if (m_AUXBus.isRunning())
+            defineProperty(AUXLatencyNP);
         if (m_MountType == ALT_AZ)
         {
             defineProperty(Axis1PIDNP);
@@ -755,6 +790,7 @@ bool CelestronAUX::updateProperties()
 
         deleteProperty(EncoderNP);
         deleteProperty(AngleNP);
+        deleteProperty(AUXLatencyNP);
 
         if (m_MountType == ALT_AZ)
         {
@@ -826,6 +862,8 @@ bool CelestronAUX::ISNewBLOB(const char *dev, const char *name, int sizes[], int
     {
         // Process alignment properties
         ProcessAlignmentBLOBProperties(this, name, sizes, blobsizes, blobs, formats, names, n);
+        if (strstr(name, "ALIGNMENT_"))
+            m_TrackingTrajectory.invalidate();
     }
     // Pass it up the chain
     return INDI::Telescope::ISNewBLOB(dev, name, sizes, blobsizes, blobs, formats, names, n);
@@ -947,6 +985,8 @@ bool CelestronAUX::ISNewNumber(const char *dev, const char *name, double values[
 
         // Process Alignment Properties
         ProcessAlignmentNumberProperties(this, name, values, names, n);
+        if (strstr(name, "ALIGNMENT_"))
+            m_TrackingTrajectory.invalidate();
 
     }
 
@@ -1167,6 +1207,8 @@ bool CelestronAUX::ISNewSwitch(const char *dev, const char *name, ISState *state
 
         // Process alignment properties
         ProcessAlignmentSwitchProperties(this, name, states, names, n);
+        if (strstr(name, "ALIGNMENT_"))
+            m_TrackingTrajectory.invalidate();
 
         // Process Focus Properties
         if (strstr(name, "FOCUS_"))
@@ -1185,7 +1227,11 @@ bool CelestronAUX::ISNewSwitch(const char *dev, const char *name, ISState *state
 bool CelestronAUX::ISNewText(const char *dev, const char *name, char *texts[], char *names[], int n)
 {
     if (!strcmp(dev, getDeviceName()))
+    {
         ProcessAlignmentTextProperties(this, name, texts, names, n);
+        if (strstr(name, "ALIGNMENT_"))
+            m_TrackingTrajectory.invalidate();
+    }
 
     return INDI::Telescope::ISNewText(dev, name, texts, names, n);
 }
@@ -1482,6 +1528,7 @@ void CelestronAUX::resetTracking()
 
     m_TrackingElapsedTimer.restart();
     m_GuideOffset[AXIS_AZ] = m_GuideOffset[AXIS_ALT] = 0;
+    m_TrackingTrajectory.invalidate();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -1500,26 +1547,20 @@ bool CelestronAUX::ReadScopeStatus()
     if (!isConnected())
         return false;
 
-    if (!getStatus(AXIS_AZ))
-        return false;
-    if (!getStatus(AXIS_ALT))
-        return false;
-
     double axis1 = EncoderNP[AXIS_AZ].getValue();
     double axis2 = EncoderNP[AXIS_ALT].getValue();
 
-    if (!getEncoder(AXIS_AZ))
+    // Slew status of moving axes and both encoders, as one batch of outstanding requests
+    std::vector<AUXCommand> commands;
+    for (INDI_HO_AXIS axis : {AXIS_AZ, AXIS_ALT})
     {
-        if (EncoderNP.getState() != IPS_ALERT)
-        {
-            EncoderNP.setState(IPS_ALERT);
-            AngleNP.setState(IPS_ALERT);
-            EncoderNP.apply();
-            AngleNP.apply();
-        }
-        return false;
+        if (m_AxisStatus[axis] == SLEWING && ScopeStatus != SLEWING_MANUAL)
+            commands.push_back(AUXCommand(MC_SLEW_DONE, APP, axis == AXIS_AZ ? AZM : ALT));
     }
-    if (!getEncoder(AXIS_ALT))
+    commands.push_back(AUXCommand(MC_GET_POSITION, APP, AZM));
+    commands.push_back(AUXCommand(MC_GET_POSITION, APP, ALT));
+
+    if (!exchangeAUXCommands(commands))
     {
         if (EncoderNP.getState() != IPS_ALERT)
         {
@@ -1531,6 +1572,8 @@ bool CelestronAUX::ReadScopeStatus()
         return false;
     }
 
+    updateAUXLatency();
+
     // Mount Alt-Az Coords
     if (m_MountType == ALT_AZ)
     {
@@ -2043,55 +2086,63 @@ void CelestronAUX::TimerHit()
             // For Equatorial mount, we simply use user-selected tracking mode and let it passively track.
             else if (m_MountType == ALT_AZ)
             {
-                TelescopeDirectionVector TDV;
-                TelescopeDirectionVector futureTDV;
-                TelescopeDirectionVector pastTDV;
                 INDI::IHorizontalCoordinates targetMountAxisCoordinates { 0, 0 };
-                INDI::IHorizontalCoordinates pastMountAxisCoordinates { 0, 0 };
-                INDI::IHorizontalCoordinates futureMountAxisCoordinates { 0, 0 };
-                double timeStep { 5.0 }; // time step for tracking rate estimation in seconds
-                double JDoffset { timeStep / (60 * 60 * 24) } ; // The same in days
-
-                // Start by transforming tracking target celestial coordinates to telescope coordinates.
-                if (TransformCelestialToTelescope(m_SkyTrackingTarget.rightascension, m_SkyTrackingTarget.declination,
-                                                  0, TDV))
-                {
-                    // If mount is Alt-Az then that's all we need to do
-                    AltitudeAzimuthFromTelescopeDirectionVector(TDV, targetMountAxisCoordinates);
-                    TransformCelestialToTelescope(m_SkyTrackingTarget.rightascension, m_SkyTrackingTarget.declination,
-                                                  JDoffset, futureTDV);
-                    AltitudeAzimuthFromTelescopeDirectionVector(futureTDV, futureMountAxisCoordinates);
-                    TransformCelestialToTelescope(m_SkyTrackingTarget.rightascension, m_SkyTrackingTarget.declination,
-                                                  -JDoffset, pastTDV);
-                    AltitudeAzimuthFromTelescopeDirectionVector(pastTDV, pastMountAxisCoordinates);
+                double JDnow { ln_get_julian_from_sys() };
+                double tick { getPollingPeriod() / 1000.0 }; // tracking update period in seconds
 
-                }
-                // If transformation failed.
-                else
+                // Mount axis trajectory of the target, the alignment model is only evaluated to fit a new
+                // piece when this tick leaves the current one or the target, model or location changed.
+                m_TrackingTrajectory.setTarget(m_SkyTrackingTarget.rightascension, m_SkyTrackingTarget.declination);
+                if (!m_TrackingTrajectory.covers(JDnow + tick / (60 * 60 * 24)))
                 {
-                    double JDnow {ln_get_julian_from_sys()};
-                    INDI::IEquatorialCoordinates EquatorialCoordinates { 0, 0 };
-                    EquatorialCoordinates.rightascension  = m_SkyTrackingTarget.rightascension;
-                    EquatorialCoordinates.declination = m_SkyTrackingTarget.declination;
-                    INDI::EquatorialToHorizontal(&EquatorialCoordinates, &m_Location, JDnow, &targetMountAxisCoordinates);
-                    INDI::EquatorialToHorizontal(&EquatorialCoordinates, &m_Location, JDnow + JDoffset, &futureMountAxisCoordinates);
-                    INDI::EquatorialToHorizontal(&EquatorialCoordinates, &m_Location, JDnow - JDoffset, &pastMountAxisCoordinates);
+                    m_TrackingTrajectory.fit(JDnow, [this, JDnow](double offset, double & azimuth, double & altitude)
+                    {
+                        TelescopeDirectionVector TDV;
+                        INDI::IHorizontalCoordinates mountAxisCoordinates { 0, 0 };
+                        double JDoffset { offset / (60 * 60 * 24) };
+
+                        // Transform tracking target celestial coordinates to telescope coordinates.
+                        if (TransformCelestialToTelescope(m_SkyTrackingTarget.rightascension, m_SkyTrackingTarget.declination,
+                                                          JDoffset, TDV))
+                            AltitudeAzimuthFromTelescopeDirectionVector(TDV, mountAxisCoordinates);
+                        // If transformation failed.
+                        else
+                        {
+                            INDI::IEquatorialCoordinates EquatorialCoordinates { 0, 0 };
+                            EquatorialCoordinates.rightascension  = m_SkyTrackingTarget.rightascension;
+                            EquatorialCoordinates.declination = m_SkyTrackingTarget.declination;
+                            INDI::EquatorialToHorizontal(&EquatorialCoordinates, &m_Location, JDnow + JDoffset,
+                                                         &mountAxisCoordinates);
+                        }
+                        azimuth  = mountAxisCoordinates.azimuth;
+                        altitude = mountAxisCoordinates.altitude;
+                    });
+                    LOGF_DEBUG("Tracking trajectory fitted over %.1f s, error %.3f arcsec (%u fits)", m_TrackingTrajectory.span(),
+                               m_TrackingTrajectory.fitError() * 3600, m_TrackingTrajectory.fits());
                 }
 
+                double position[2], rate[2], acceleration[2];
+                m_TrackingTrajectory.evaluate(JDnow, position, rate, acceleration);
+                targetMountAxisCoordinates.azimuth = range360(position[AXIS_AZ]);
+                targetMountAxisCoordinates.altitude = position[AXIS_ALT];
+
+                // Between polls, updateTrackRates() moves the rate along the trajectory every RATE_UPDATE_MS.
+                // Slow polling only needs the PID correction from here, the trajectory drives the rate.
+                if (!m_RateTimer.isActive() && getPollingPeriod() >= 2 * RATE_UPDATE_MS)
+                    m_RateTimer.start();
+                double rateTick = m_RateTimer.isActive() ? RATE_UPDATE_MS / 1000.0 : tick;
 
                 // Calculate expected tracking rates
+                // Mean rate until the next rate update, in deg/s
                 double predRate[2] = {0, 0};
-                // Central difference, error quadratic in timestep
-                // Rates in deg/s
-                predRate[AXIS_AZ] = range180(AzimuthToDegrees(futureMountAxisCoordinates.azimuth - pastMountAxisCoordinates.azimuth)) /
-                                    timeStep / 2;
-                predRate[AXIS_ALT] = (futureMountAxisCoordinates.altitude - pastMountAxisCoordinates.altitude) / timeStep / 2;
+                predRate[AXIS_AZ] = rate[AXIS_AZ] + acceleration[AXIS_AZ] * rateTick / 2;
+                predRate[AXIS_ALT] = rate[AXIS_ALT] + acceleration[AXIS_ALT] * rateTick / 2;
 
-                LOGF_DEBUG("Predicted positions (AZ):  %9.4f  %9.4f (now, future, degs)",
+                LOGF_DEBUG("Predicted positions (AZ):  %9.4f  %9.4f (now, next tick, degs)",
                            AzimuthToDegrees(targetMountAxisCoordinates.azimuth),
-                           AzimuthToDegrees(futureMountAxisCoordinates.azimuth)) ;
-                LOGF_DEBUG("Predicted positions (AL):  %9.4f  %9.4f (now, future, degs)", targetMountAxisCoordinates.altitude,
-                           futureMountAxisCoordinates.altitude);
+                           AzimuthToDegrees(range360(position[AXIS_AZ] + predRate[AXIS_AZ] * tick)));
+                LOGF_DEBUG("Predicted positions (AL):  %9.4f  %9.4f (now, next tick, degs)", targetMountAxisCoordinates.altitude,
+                           position[AXIS_ALT] + predRate[AXIS_ALT] * tick);
                 LOGF_DEBUG("Predicted Rates (AZ, ALT): %9.4f  %9.4f (arcsec/s)", 3600 * predRate[AXIS_AZ], 3600 * predRate[AXIS_ALT]);
 
                 // Rates in units 1024 * arcsec/s
@@ -2156,12 +2207,10 @@ void CelestronAUX::TimerHit()
                     m_LastOffset[AXIS_AZ] = offsetSteps[AXIS_AZ];
                     targetSteps[AXIS_AZ] = DegreesToEncoders(AzimuthToDegrees(targetMountAxisCoordinates.azimuth));
                     // Track rate: predicted + PID controlled correction based on tracking error: offsetSteps
-                    trackRates[AXIS_AZ] = predRate[AXIS_AZ] + m_Controllers[AXIS_AZ]->calculate(0, -offsetSteps[AXIS_AZ]);
+                    m_TrackCorrection[AXIS_AZ] = m_Controllers[AXIS_AZ]->calculate(0, -offsetSteps[AXIS_AZ]);
 
                     // Apply minTrackRate logic from Skywatcher
-                    double minAzTrackRate = predRate[AXIS_AZ] * MIN_TRACK_RATE_FACTOR;
-                    if (trackRates[AXIS_AZ] * predRate[AXIS_AZ] < 0 || std::abs(trackRates[AXIS_AZ]) < std::abs(minAzTrackRate))
-                        trackRates[AXIS_AZ] = minAzTrackRate;
+                    trackRates[AXIS_AZ] = limitTrackRate(predRate[AXIS_AZ], predRate[AXIS_AZ] + m_TrackCorrection[AXIS_AZ]);
 
                     LOGF_DEBUG("Predicted AZ Rate: %8.2f", predRate[AXIS_AZ]);
                     LOGF_DEBUG("Tracking AZ Now: %8.f Target: %8d Offset: %8d Rate: %8.2f", EncoderNP[AXIS_AZ].getValue(), targetSteps[AXIS_AZ],
@@ -2205,12 +2254,10 @@ void CelestronAUX::TimerHit()
                     m_LastOffset[AXIS_ALT] = offsetSteps[AXIS_ALT];
                     targetSteps[AXIS_ALT]  = DegreesToEncoders(targetMountAxisCoordinates.altitude);
                     // Track rate: predicted + PID controlled correction based on tracking error: offsetSteps
-                    trackRates[AXIS_ALT] = predRate[AXIS_ALT] + m_Controllers[AXIS_ALT]->calculate(0, -offsetSteps[AXIS_ALT]);
+                    m_TrackCorrection[AXIS_ALT] = m_Controllers[AXIS_ALT]->calculate(0, -offsetSteps[AXIS_ALT]);
 
                     // Apply minTrackRate logic from Skywatcher
-                    double minAlTrackRate = predRate[AXIS_ALT] * MIN_TRACK_RATE_FACTOR;
-                    if (trackRates[AXIS_ALT] * predRate[AXIS_ALT] < 0 || std::abs(trackRates[AXIS_ALT]) < std::abs(minAlTrackRate))
-                        trackRates[AXIS_ALT] = minAlTrackRate;
+                    trackRates[AXIS_ALT] = limitTrackRate(predRate[AXIS_ALT], predRate[AXIS_ALT] + m_TrackCorrection[AXIS_ALT]);
 
                     LOGF_DEBUG("Predicted AL Rate: %8.2f", predRate[AXIS_ALT]);
                     LOGF_DEBUG("Tracking AL Now: %8.f Target: %8d Offset: %8d Rate: %8.2f", EncoderNP[AXIS_ALT].getValue(),
@@ -2294,6 +2341,7 @@ bool CelestronAUX::updateLocation(double latitude, double longitude, double elev
 {
     // Update INDI Alignment Subsystem Location
     UpdateLocation(latitude, longitude, elevation);
+    m_TrackingTrajectory.invalidate();
 
     // Do we really need this in update Location??
     // take care of latitude for north or south emisphere
@@ -2918,6 +2966,35 @@ bool CelestronAUX::Abort()
     return true;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////
+/// The encoders and the PID controllers are only updated every poll. In between, the
+/// predicted rate follows the fitted trajectory and the last PID correction is kept.
+/////////////////////////////////////////////////////////////////////////////////////
+void CelestronAUX::updateTrackRates()
+{
+    if (!isConnected() || TrackState != SCOPE_TRACKING || m_MountType != ALT_AZ || m_ManualMotionActive)
+    {
+        m_RateTimer.stop();
+        return;
+    }
+
+    // A new piece is only fitted by TimerHit, never extrapolate past the current one here
+    double JDnow { ln_get_julian_from_sys() };
+    if (!m_TrackingTrajectory.covers(JDnow))
+        return;
+
+    double tick { RATE_UPDATE_MS / 1000.0 };
+    double position[2], rate[2], acceleration[2];
+    m_TrackingTrajectory.evaluate(JDnow, position, rate, acceleration);
+
+    for (INDI_HO_AXIS axis : {AXIS_AZ, AXIS_ALT})
+    {
+        // Mean rate until the next update, in units 1024 * arcsec/s
+        double predRate = 3600 * (rate[axis] + acceleration[axis] * tick / 2) * 1024;
+        trackByRate(axis, static_cast<int32_t>(limitTrackRate(predRate, predRate + m_TrackCorrection[axis])));
+    }
+}
+
 /////////////////////////////////////////////////////////////////////////////////////
 /// Rate is Celestron specific and roughly equals 80 ticks per 1 motor step
 /// rate = 80 would cause the motor to spin at a rate of 1 step/s
@@ -3531,12 +3608,78 @@ bool CelestronAUX::tcpReadResponse()
 /////////////////////////////////////////////////////////////////////////////////////
 bool CelestronAUX::readAUXResponse(AUXCommand c)
 {
-    if (getActiveConnection() == serialConnection)
+    if (m_AUXBus.isRunning())
+    {
+        AUXCommand reply;
+        bool replied = m_AUXBus.waitReply(c, READ_TIMEOUT * 1000, reply);
+        processUnsolicited();
+        if (replied)
+            processResponse(reply);
+        else
+            DEBUGF(DBG_SERIAL, "No reply from 0x%02x to command 0x%02x", c.destination(), c.command());
+        return replied;
+    }
+    else if (getActiveConnection() == serialConnection)
         return serialReadResponse(c);
     else
         return tcpReadResponse();
 }
 
+/////////////////////////////////////////////////////////////////////////////////////
+/// Bus traffic that is not a reply we waited for, e.g. GPS queries of the hand controller
+/////////////////////////////////////////////////////////////////////////////////////
+void CelestronAUX::processUnsolicited()
+{
+    std::vector<AUXCommand> packets;
+    m_AUXBus.takeUnsolicited(packets);
+    for (auto &packet : packets)
+        processResponse(packet);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/////////////////////////////////////////////////////////////////////////////////////
+bool CelestronAUX::exchangeAUXCommands(std::vector<AUXCommand> &commands)
+{
+    bool replied = true;
+
+    if (m_AUXBus.isRunning())
+    {
+        for (auto &command : commands)
+            sendAUXCommand(command);
+        for (auto &command : commands)
+            replied = readAUXResponse(command) && replied;
+    }
+    else
+    {
+        for (auto &command : commands)
+            replied = sendAUXCommand(command) && readAUXResponse(command) && replied;
+    }
+
+    return replied;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/////////////////////////////////////////////////////////////////////////////////////
+void CelestronAUX::updateAUXLatency()
+{
+    if (!m_AUXBus.isRunning() || m_AUXLatencyTimer.elapsed() < 2000)
+        return;
+    m_AUXLatencyTimer.start();
+
+    AUXBus::Latency azm = m_AUXBus.latency(AZM), alt = m_AUXBus.latency(ALT), focus = m_AUXBus.latency(FOCUS);
+    AUXLatencyNP[LATENCY_AZM_MEAN].setValue(azm.mean);
+    AUXLatencyNP[LATENCY_AZM_MAX].setValue(azm.max);
+    AUXLatencyNP[LATENCY_ALT_MEAN].setValue(alt.mean);
+    AUXLatencyNP[LATENCY_ALT_MAX].setValue(alt.max);
+    AUXLatencyNP[LATENCY_FOCUS_MEAN].setValue(focus.mean);
+    AUXLatencyNP[LATENCY_FOCUS_MAX].setValue(focus.max);
+    AUXLatencyNP[LATENCY_TIMEOUTS].setValue(azm.timeouts + alt.timeouts + focus.timeouts);
+    AUXLatencyNP.setState((azm.timeouts + alt.timeouts + focus.timeouts) > 0 ? IPS_BUSY : IPS_OK);
+    AUXLatencyNP.apply();
+}
+
 /////////////////////////////////////////////////////////////////////////////////////
 ///
 /////////////////////////////////////////////////////////////////////////////////////
@@ -3549,7 +3692,9 @@ int CelestronAUX::sendBuffer(AUXBuffer buf)
         if (aux_tty_write((char * )buf.data(), buf.size(), CTS_TIMEOUT, &n) != TTY_OK)
             return 0;
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        // Give the synchronous reader time for the reply, the background reader does not need it
+        if (!m_AUXBus.isRunning())
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
         if (n == -1)
             LOG_ERROR("CAUX::sendBuffer");
         if ((unsigned)n != buf.size())
@@ -3597,7 +3742,15 @@ bool CelestronAUX::sendAUXCommand(AUXCommand &command)
         buf[7] = response_data_size = command.responseDataSize();
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    if (m_AUXBus.isRunning())
+    {
+        // Keep the replies of other outstanding requests, the reader matches ours.
+        // Only our own requests get a reply, not the answers of the GPS emulation.
+        if (command.source() == APP)
+            m_AUXBus.expect(command);
+    }
+    else
+        tcflush(PortFD, TCIOFLUSH);
     return (sendBuffer(buf) == static_cast<int>(buf.size()));
 }
 
@@ -40,7 +40,9 @@
 #include <termios.h>
 
 #include "auxproto.h"
+#include "auxbus.h"
 #include "adaptive_tuner.h"
+#include "trajectory.h"
 
 class CelestronAUX :
     public INDI::Telescope,
@@ -206,6 +208,8 @@ class CelestronAUX :
          * @return True if successful, false otherwise.
          */
         bool trackByRate(INDI_HO_AXIS axis, int32_t rate);
+        // Feed forward rate updates along the fitted trajectory between two polls
+        void updateTrackRates();
 
         /**
          * @brief trackByRate Track using specific mode (sidereal, solar, or lunar)
@@ -305,13 +309,25 @@ class CelestronAUX :
         INDI::IHorizontalCoordinates m_MountCurrentAltAz {0, 0};
 
         INDI::ElapsedTimer m_TrackingElapsedTimer;
+        TrackingTrajectory m_TrackingTrajectory;
         INDI::Timer m_GuideRATimer, m_GuideDETimer;
+        INDI::Timer m_RateTimer;
+        // Rate correction of the PID controllers at the last poll, 1024 * arcsec/s
+        double m_TrackCorrection[2] = {0, 0};
 
 
         /////////////////////////////////////////////////////////////////////////////////////
         /// Auxiliary Command Communication
         /////////////////////////////////////////////////////////////////////////////////////
         bool sendAUXCommand(AUXCommand &command);
+        /**
+         * @brief exchangeAUXCommands Send all commands, then read their replies. On a direct connection
+         * the requests are all outstanding at once.
+         * @return True if every command got a reply, false otherwise.
+         */
+        bool exchangeAUXCommands(std::vector<AUXCommand> &commands);
+        void processUnsolicited();
+        void updateAUXLatency();
         void closeConnection();
         void emulateGPS(AUXCommand &m);
         bool serialReadResponse(AUXCommand c);
@@ -322,6 +338,10 @@ class CelestronAUX :
         void formatModelString(char *s, int n, uint16_t model);
         void formatVersionString(char *s, int n, uint8_t *verBuf);
 
+        // Background reader of direct (non-passthrough) connections
+        AUXBus m_AUXBus;
+        INDI::ElapsedTimer m_AUXLatencyTimer;
+
         // GPS Emulation
         bool m_GPSEmulation {false};
 
@@ -421,6 +441,10 @@ class CelestronAUX :
         // Angles
         INDI::PropertyNumber AngleNP {2};
 
+        // Reply latency per target
+        INDI::PropertyNumber AUXLatencyNP {7};
+        enum { LATENCY_AZM_MEAN, LATENCY_AZM_MAX, LATENCY_ALT_MEAN, LATENCY_ALT_MAX, LATENCY_FOCUS_MEAN, LATENCY_FOCUS_MAX, LATENCY_TIMEOUTS };
+
         int32_t m_LastTrackRate[2] = {-1, -1};
         double m_TrackStartSteps[2] = {0, 0};
         int32_t m_LastOffset[2] = {0, 0};
@@ -484,6 +508,8 @@ class CelestronAUX :
 
         // Measured rate that would result in 1 step/sec
         static constexpr uint32_t GAIN_STEPS {80};
+        // Period of the rate updates between polls while tracking Alt-Az, in ms
+        static constexpr uint32_t RATE_UPDATE_MS {250};
 
         // MC_SET_POS_GUIDERATE & MC_SET_NEG_GUIDERATE use 24bit number rate in
         static constexpr uint8_t RATE_PER_ARCSEC {4};
@@ -163,6 +163,24 @@ def test_approach_sequence(indiserver_process):
     asyncio.run(run())
 
 
+def test_aux_latency(indiserver_process):
+    """Replies to the status polls are matched by the AUX reader and timed per target."""
+
+    async def run():
+        async with driver_client_context() as client:
+            prop = await client.wait_for_condition(
+                DEVICE_NAME,
+                "AUX_LATENCY",
+                lambda p: float(p["values"].get("AZM_MEAN", 0)) > 0
+                and float(p["values"].get("ALT_MEAN", 0)) > 0,
+                timeout=15,
+            )
+            assert float(prop["values"]["AZM_MAX"]) >= float(prop["values"]["AZM_MEAN"])
+            assert float(prop["values"]["TIMEOUTS"]) == 0
+
+    asyncio.run(run())
+
+
 def test_reconnection(indiserver_process):
     """Verify driver recovers after simulator restart."""
     # Omitted for simplicity
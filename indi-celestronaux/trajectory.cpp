@@ -0,0 +1,128 @@
+/*
+    Celestron Aux Alt-Az Trajectory
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "trajectory.h"
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr double SECONDS_PER_DAY = 86400.0;
+
+TrackingTrajectory::TrackingTrajectory(double maxSpan, double minSpan, double tolerance) :
+    m_MaxSpan(maxSpan), m_MinSpan(minSpan), m_Tolerance(tolerance)
+{
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/////////////////////////////////////////////////////////////////////////////////////
+void TrackingTrajectory::setTarget(double ra, double de)
+{
+    if (ra != m_RA || de != m_DE)
+    {
+        m_RA    = ra;
+        m_DE    = de;
+        m_Valid = false;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/////////////////////////////////////////////////////////////////////////////////////
+bool TrackingTrajectory::covers(double jd) const
+{
+    return m_Valid && jd >= m_Start && (jd - m_Start) * SECONDS_PER_DAY <= 3 * m_Step;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// Cubic through four equally spaced nodes s = 0..3, from the Newton forward differences.
+/////////////////////////////////////////////////////////////////////////////////////
+static void interpolate(const double y[4], double c[4])
+{
+    double d1 = y[1] - y[0];
+    double d2 = y[2] - 2 * y[1] + y[0];
+    double d3 = y[3] - 3 * y[2] + 3 * y[1] - y[0];
+
+    c[0] = y[0];
+    c[1] = d1 - d2 / 2 + d3 / 3;
+    c[2] = d2 / 2 - d3 / 2;
+    c[3] = d3 / 6;
+}
+
+static double polynomial(const double c[4], double s)
+{
+    return ((c[3] * s + c[2]) * s + c[1]) * s + c[0];
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/////////////////////////////////////////////////////////////////////////////////////
+void TrackingTrajectory::fit(double jd, const Sampler &sampler)
+{
+    double span = m_MaxSpan;
+
+    while (true)
+    {
+        double azimuth[4], altitude[4];
+        for (int i = 0; i < 4; i++)
+        {
+            sampler(span * i / 3, azimuth[i], altitude[i]);
+            // Unwrap relative to the first node
+            if (i > 0)
+                azimuth[i] = azimuth[0] + std::remainder(azimuth[i] - azimuth[0], 360.0);
+        }
+
+        interpolate(azimuth, m_Coefficients[0]);
+        interpolate(altitude, m_Coefficients[1]);
+        m_Start = jd;
+        m_Step  = span / 3;
+
+        // Check the fit between the nodes, where the interpolation error is largest
+        double checkAzimuth, checkAltitude;
+        sampler(span / 2, checkAzimuth, checkAltitude);
+        double fittedAzimuth = polynomial(m_Coefficients[0], 1.5);
+        checkAzimuth = fittedAzimuth + std::remainder(checkAzimuth - fittedAzimuth, 360.0);
+        m_FitError = std::max(std::abs(checkAzimuth - fittedAzimuth),
+                              std::abs(checkAltitude - polynomial(m_Coefficients[1], 1.5)));
+
+        if (m_FitError <= m_Tolerance || span / 2 < m_MinSpan)
+            break;
+        span /= 2;
+    }
+
+    m_Valid = true;
+    m_Fits++;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+///
+/////////////////////////////////////////////////////////////////////////////////////
+void TrackingTrajectory::evaluate(double jd, double position[2], double rate[2], double acceleration[2]) const
+{
+    double s = (jd - m_Start) * SECONDS_PER_DAY / m_Step;
+
+    for (int axis = 0; axis < 2; axis++)
+    {
+        const double *c = m_Coefficients[axis];
+        position[axis]     = polynomial(c, s);
+        rate[axis]         = ((3 * c[3] * s + 2 * c[2]) * s + c[1]) / m_Step;
+        acceleration[axis] = (6 * c[3] * s + 2 * c[2]) / (m_Step * m_Step);
+    }
+}
@@ -0,0 +1,106 @@
+/*
+    Celestron Aux Alt-Az Trajectory
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+/**
+ * @brief The TrackingTrajectory class predicts the mount axis position of a tracking target.
+ *
+ * The azimuth and altitude the mount has to follow are fitted with a cubic over a short time span,
+ * from four evaluations of the alignment model at equally spaced times plus one at the middle of the
+ * span to check the fit. If the check is off by more than the tolerance, e.g. near the zenith, the
+ * span is halved. Position, rate and acceleration of each tracking tick then come from the cubic and
+ * a new piece is only fitted when the tick leaves the span, or when the target, model or location
+ * changed and the trajectory was invalidated.
+ *
+ * Angles are in degrees, rates in degrees/s and accelerations in degrees/s². The azimuth is unwrapped
+ * over a piece, so it may be outside [0, 360).
+ */
+class TrackingTrajectory
+{
+    public:
+        /**
+         * @brief Sampler Mount axis position of the target offset seconds from now.
+         */
+        typedef std::function<void(double offset, double &azimuth, double &altitude)> Sampler;
+
+        TrackingTrajectory(double maxSpan = 60, double minSpan = 5, double tolerance = 0.1 / 3600);
+
+        /**
+         * @brief setTarget Select the target to track, invalidates the trajectory if it changed.
+         */
+        void setTarget(double ra, double de);
+
+        /**
+         * @brief invalidate Force a new fit on the next tick, e.g. after the model or location changed.
+         */
+        void invalidate()
+        {
+            m_Valid = false;
+        }
+
+        /**
+         * @brief covers True if jd is within the span of the current piece.
+         */
+        bool covers(double jd) const;
+
+        /**
+         * @brief fit Fit a new piece starting at jd, which must be the time "now" of the sampler.
+         */
+        void fit(double jd, const Sampler &sampler);
+
+        /**
+         * @brief evaluate Position, rate and acceleration of both axes at jd, index 0 is azimuth and 1 altitude.
+         * @note Outside of the span, the last piece is extrapolated.
+         */
+        void evaluate(double jd, double position[2], double rate[2], double acceleration[2]) const;
+
+        uint32_t fits() const
+        {
+            return m_Fits;
+        }
+        double span() const
+        {
+            return 3 * m_Step;
+        }
+        // Mid span check error of the last fit, in degrees
+        double fitError() const
+        {
+            return m_FitError;
+        }
+
+    private:
+        double m_MaxSpan, m_MinSpan, m_Tolerance;
+
+        bool m_Valid {false};
+        double m_RA {-1}, m_DE {-1};
+
+        // Piece start, JD, and node spacing in seconds
+        double m_Start {0};
+        double m_Step {0};
+        // Cubic per axis in s = (t - start) / step
+        double m_Coefficients[2][4] {};
+
+        uint32_t m_Fits {0};
+        double m_FitError {0};
+};
@@ -70,7 +70,7 @@ std::unique_ptr<WeatherRadio> station_ptr(new WeatherRadio());
 ***************************************************************************************/
 static size_t WriteCallback(void *contents, size_t size, size_t nmemb, void *userp)
 {
-    strcpy(static_cast<char *>(userp), static_cast<char *>(contents));
+    static_cast<std::string *>(userp)->append(static_cast<char *>(contents), size * nmemb);
     return size * nmemb;
 }
 
@@ -167,6 +167,11 @@ bool WeatherRadio::initProperties()
     IUFillNumberVector(&windDirectionCalibrationNP, windDirectionCalibrationN, 1, getDeviceName(), "WIND_DIRECTION_CALIBRATION",
                        "Wind direction", CALIBRATION_TAB, IP_RW, 0, IPS_OK);
 
+    IUFillNumber(&httpLatencyN[0], "LATENCY_LAST", "Last (ms)", "%.1f", 0, 60000, 0, 0);
+    IUFillNumber(&httpLatencyN[1], "LATENCY_AVERAGE", "Average (ms)", "%.1f", 0, 60000, 0, 0);
+    IUFillNumberVector(&httpLatencyNP, httpLatencyN, 2, getDeviceName(), "HTTP_LATENCY", "HTTP latency", CONNECTION_TAB, IP_RO, 0,
+                       IPS_IDLE);
+
     addDebugControl();
     setWeatherConnection(CONNECTION_SERIAL);
 
@@ -216,7 +221,7 @@ bool WeatherRadio::updateProperties()
     if (isConnected())
     {
         // read the weather parameters for the first time so that #updateProperties() knows all sensors
-        updateWeather();
+        executeCommand(CMD_WEATHER);
 
         if (sensorRegistry.temperature.size() > 0)
         {
@@ -325,6 +330,8 @@ bool WeatherRadio::updateProperties()
         result = INDI::Weather::updateProperties();
 
         defineProperty(&resetArduinoSP);
+        if (getActiveConnection()->type() == Connection::Interface::CONNECTION_TCP)
+            defineProperty(&httpLatencyNP);
     }
     else
     {
@@ -333,6 +340,7 @@ bool WeatherRadio::updateProperties()
             deleteProperty(rawDevices[i].name);
 
         deleteProperty(resetArduinoSP.name);
+        deleteProperty(httpLatencyNP.name);
         deleteProperty(wetnessSensorSP.name);
         deleteProperty(wetnessCalibrationNP.name);
         deleteProperty(rainVolumeSensorSP.name);
@@ -753,7 +761,7 @@ bool WeatherRadio::ISNewNumber(const char *dev, const char *name, double values[
         {
             // update the weather if location (and especially the elevation) changes
             if (INDI::Weather::ISNewNumber(dev, name, values, names, n))
-                return (updateWeather() == IPS_OK);
+                return (updateWeather() != IPS_ALERT);
             else
                 return false;
         }
@@ -1006,6 +1014,41 @@ bool WeatherRadio::Handshake()
 ***************************************************************************************/
 IPState WeatherRadio::updateWeather()
 {
+    // over HTTP the weather document is fetched and parsed in the background
+    if (getActiveConnection()->type() == Connection::Interface::CONNECTION_TCP)
+    {
+        HttpFeed<WeatherDocument>::Result response;
+        if (!weatherFeed.take(response))
+        {
+            // nothing back yet, start a request unless one is still running
+            weatherFeed.request(commandURL(CMD_WEATHER));
+            return IPS_BUSY;
+        }
+        // fetch the next document in time for the next update
+        weatherFeed.request(commandURL(CMD_WEATHER));
+
+        HttpPoller::Stats stats = weatherFeed.stats();
+        httpLatencyN[0].value = stats.lastMs;
+        httpLatencyN[1].value = stats.averageMs;
+        httpLatencyNP.s = response.error.empty() ? IPS_OK : IPS_ALERT;
+        IDSetNumber(&httpLatencyNP, nullptr);
+
+        if (!response.error.empty())
+        {
+            LOGF_ERROR("HTTP request to %s failed: %s", hostname, response.error.c_str());
+            return IPS_ALERT;
+        }
+
+        // an unchanged document leaves all sensor values as they are
+        if (response.value)
+            for (JsonValue value : response.value->values)
+                handleResponseValue(CMD_WEATHER, value);
+        else
+            LOG_DEBUG("Weather data unchanged.");
+
+        return IPS_OK;
+    }
+
     bool result = executeCommand(CMD_WEATHER);
 
     // result recieved
@@ -1366,21 +1409,20 @@ bool WeatherRadio::executeCommand(wr_command cmd)
     {
         CURL *curl;
         CURLcode res;
-        char requestURL[MAXRBUF];
-
-        snprintf(requestURL, MAXRBUF, "http://%s:%s/%s", hostname, port, cmdstring.c_str());
+        std::string requestURL = commandURL(cmd);
+        std::string body;
 
         curl = curl_easy_init();
         if (curl)
         {
-            curl_easy_setopt(curl, CURLOPT_URL, requestURL);
+            curl_easy_setopt(curl, CURLOPT_URL, requestURL.c_str());
             curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, response);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &body);
             res = curl_easy_perform(curl);
             curl_easy_cleanup(curl);
             if (res == CURLcode::CURLE_OK)
             {
-                std::stringstream rs (response);
+                std::stringstream rs (body);
                 std::string line;
 
                 // handle each line separately
@@ -1432,6 +1474,54 @@ void WeatherRadio::handleResponse(wr_command cmd, const char *response, int leng
         return;
     }
 
+    handleResponseValue(cmd, value);
+}
+
+/**************************************************************************************
+** Build the HTTP request URL for a command
+***************************************************************************************/
+std::string WeatherRadio::commandURL(wr_command cmd)
+{
+    return std::string("http://") + hostname + ":" + port + "/" + commands[cmd];
+}
+
+/**************************************************************************************
+** Parse a weather document received over HTTP, runs on the poller thread
+***************************************************************************************/
+bool WeatherRadio::parseWeatherDocument(const std::string &body, WeatherDocument &document, std::string &error)
+{
+    std::stringstream rs (body);
+    std::string line;
+
+    // each line is a separate JSON document
+    while (std::getline(rs, line, '\n'))
+    {
+        // ignore empty lines and non JSON
+        if (line.empty() || (line[0] != '[' && line[0] != '{'))
+            continue;
+
+        // the parser works in place, so the source has to live as long as the document
+        document.sources.emplace_back(new char[line.length() + 1]);
+        char *source = document.sources.back().get();
+        memcpy(source, line.c_str(), line.length() + 1);
+
+        char *endptr;
+        JsonValue value;
+        int status = jsonParse(source, &endptr, &value, document.allocator);
+        if (status != JSON_OK)
+        {
+            char message[MAXRBUF];
+            snprintf(message, MAXRBUF, "Parsing error %s at %zd", jsonStrError(status), endptr - source);
+            error = message;
+            return false;
+        }
+        document.values.push_back(value);
+    }
+    return true;
+}
+
+void WeatherRadio::handleResponseValue(wr_command cmd, JsonValue value)
+{
     // starting from version 1.14, the responses are typed, before that it was
     // necessary to know which command has triggered the response.
     if (major_version > 1 || (major_version == 1 && minor_version > 13))
@@ -1563,11 +1653,13 @@ bool WeatherRadio::transmitSerial(std::string buffer)
 ***************************************************************************************/
 bool WeatherRadio::Connect()
 {
+    weatherFeed.start();
     return INDI::Weather::Connect();
 }
 
 bool WeatherRadio::Disconnect()
 {
+    weatherFeed.stop();
     return INDI::Weather::Disconnect();
 }
 
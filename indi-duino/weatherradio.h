@@ -27,6 +27,7 @@
 #include <memory>
 
 #include "gason/gason.h"
+#include "httppoller.h"
 
 #include "indiweather.h"
 #include "weathercalculator.h"
@@ -158,6 +159,25 @@ protected:
     ISwitch resetArduinoS[1] = {};
     ISwitchVectorProperty resetArduinoSP;
 
+    // latency of the weather requests over HTTP
+    INumber httpLatencyN[2] = {};
+    INumberVectorProperty httpLatencyNP;
+
+    /**
+     * @brief Weather document received over HTTP, one JSON value per response line
+     */
+    struct WeatherDocument
+    {
+        // gason parses in place, the values point into the sources and the allocator
+        std::vector<std::unique_ptr<char[]>> sources;
+        JsonAllocator allocator;
+        std::vector<JsonValue> values;
+    };
+    static bool parseWeatherDocument(const std::string &body, WeatherDocument &document, std::string &error);
+
+    // fetches and parses the weather document without blocking the INDI thread
+    HttpFeed<WeatherDocument> weatherFeed{parseWeatherDocument};
+
     // calibration parameters to calculate the corrected sky temperature
     INumberVectorProperty skyTemperatureCalibrationNP;
     INumber skyTemperatureCalibrationN[7];
@@ -295,8 +315,12 @@ protected:
 
     // send a command to the serial device or by HTTP
     bool executeCommand(wr_command cmd);
+    // HTTP request URL for a command
+    std::string commandURL(wr_command cmd);
     // handle one single response line
     void handleResponse(wr_command cmd, const char *response, int length);
+    // handle one parsed response document
+    void handleResponseValue(wr_command cmd, JsonValue value);
     // handle a message from the weather station
     void handleMessage(JsonValue value);
 
@@ -0,0 +1,124 @@
+/* Copyright 2026 agent (agent AT local) */
+/* This file is part of the Skywatcher Protocol INDI driver.
+
+    The Skywatcher Protocol INDI driver is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Skywatcher Protocol INDI driver is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Skywatcher Protocol INDI driver.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "pointindex.h"
+
+#include <algorithm>
+
+void PointIndex::clear()
+{
+    nodes.clear();
+    built = true;
+}
+
+void PointIndex::add(HtmID id, double x, double y, double z)
+{
+    Node node;
+    node.p[0] = x;
+    node.p[1] = y;
+    node.p[2] = z;
+    node.id   = id;
+    node.axis = 0;
+    nodes.push_back(node);
+    built = false;
+}
+
+void PointIndex::build(size_t lo, size_t hi)
+{
+    if (hi - lo < 2)
+        return;
+
+    double min[3] = { 2, 2, 2 }, max[3] = { -2, -2, -2 };
+    for (size_t i = lo; i < hi; i++)
+        for (int k = 0; k < 3; k++)
+        {
+            min[k] = std::min(min[k], nodes[i].p[k]);
+            max[k] = std::max(max[k], nodes[i].p[k]);
+        }
+    int axis = 0;
+    for (int k = 1; k < 3; k++)
+        if (max[k] - min[k] > max[axis] - min[axis])
+            axis = k;
+
+    size_t mid = lo + (hi - lo) / 2;
+    std::nth_element(nodes.begin() + lo, nodes.begin() + mid, nodes.begin() + hi,
+                     [axis](const Node & a, const Node & b)
+    {
+        return a.p[axis] < b.p[axis];
+    });
+    nodes[mid].axis = axis;
+    build(lo, mid);
+    build(mid + 1, hi);
+}
+
+void PointIndex::search(size_t lo, size_t hi, const double q[3], size_t n, std::vector<Neighbour> &heap) const
+{
+    if (lo >= hi)
+        return;
+
+    size_t mid = lo + (hi - lo) / 2;
+    const Node &node = nodes[mid];
+    double dx = q[0] - node.p[0], dy = q[1] - node.p[1], dz = q[2] - node.p[2];
+    Neighbour candidate(dx * dx + dy * dy + dz * dz, node.id);
+    if (heap.size() < n)
+    {
+        heap.push_back(candidate);
+        std::push_heap(heap.begin(), heap.end());
+    }
+    else if (candidate < heap.front())
+    {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = candidate;
+        std::push_heap(heap.begin(), heap.end());
+    }
+
+    if (hi - lo == 1)
+        return;
+
+    // Visit the side of the splitting plane holding the query first, the other
+    // side only if the plane is closer than the current n-th neighbour.
+    double delta = q[node.axis] - node.p[node.axis];
+    if (delta < 0)
+        search(lo, mid, q, n, heap);
+    else
+        search(mid + 1, hi, q, n, heap);
+    if (heap.size() < n || delta * delta <= heap.front().first)
+    {
+        if (delta < 0)
+            search(mid + 1, hi, q, n, heap);
+        else
+            search(lo, mid, q, n, heap);
+    }
+}
+
+void PointIndex::nearest(double x, double y, double z, size_t n, std::vector<Neighbour> &result)
+{
+    result.clear();
+    if (n == 0 || nodes.empty())
+        return;
+
+    if (!built)
+    {
+        build(0, nodes.size());
+        built = true;
+    }
+
+    double q[3] = { x, y, z };
+    result.reserve(std::min(n, nodes.size()));
+    search(0, nodes.size(), q, n, result);
+    std::sort_heap(result.begin(), result.end());
+}
@@ -0,0 +1,63 @@
+/* Copyright 2026 agent (agent AT local) */
+/* This file is part of the Skywatcher Protocol INDI driver.
+
+    The Skywatcher Protocol INDI driver is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Skywatcher Protocol INDI driver is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with the Skywatcher Protocol INDI driver.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "htm.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Nearest neighbour index over alignment points given as unit vectors.
+//
+// Points are kept in an implicit kd-tree: the vector is reordered so that the
+// median of every range along its widest axis sits in the middle of the range.
+// The tree is rebuilt lazily on the first query after points were added, so
+// loading a data file costs a single O(n log n) build.
+class PointIndex
+{
+    public:
+        typedef std::pair<double, HtmID> Neighbour;
+
+        void clear();
+        void add(HtmID id, double x, double y, double z);
+        size_t size() const
+        {
+            return nodes.size();
+        }
+
+        /**
+         * @brief nearest Find the n points closest to (x, y, z).
+         * @param result filled with (squared chord length, point id), closest first.
+         */
+        void nearest(double x, double y, double z, size_t n, std::vector<Neighbour> &result);
+
+    private:
+        struct Node
+        {
+            double p[3];
+            HtmID id;
+            int axis;
+        };
+
+        void build(size_t lo, size_t hi);
+        void search(size_t lo, size_t hi, const double q[3], size_t n, std::vector<Neighbour> &heap) const;
+
+        std::vector<Node> nodes;
+        bool built {true};
+};
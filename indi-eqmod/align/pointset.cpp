@@ -24,6 +24,7 @@
 #include <libnova/sidereal_time.h>
 #include <libnova/transform.h>
 
+#include <algorithm>
 #include <math.h>
 #include <string.h>
 #include <wordexp.h>
@@ -160,6 +161,26 @@ PointSet::ComputeDistances(double alt, double az, PointFilter filter, bool ingot
     return distances;
 }
 
+std::vector<PointSet::Distance> PointSet::NearestPoints(double alt, double az, size_t n, bool ingoto)
+{
+    std::vector<PointIndex::Neighbour> nearest;
+    std::vector<Distance> distances;
+    double horangle = range360(-180.0 - az) * M_PI / 180.0;
+    double altangle = alt * M_PI / 180.0;
+    PointIndex &index = ingoto ? CelestialIndex : TelescopeIndex;
+
+    index.nearest(cos(altangle) * cos(horangle), cos(altangle) * sin(horangle), sin(altangle), n, nearest);
+    for (size_t i = 0; i < nearest.size(); i++)
+    {
+        Distance elt;
+        elt.htmID = nearest[i].second;
+        // chord length to great circle distance
+        elt.value = 2 * asin(std::min(1.0, sqrt(nearest[i].first) / 2));
+        distances.push_back(elt);
+    }
+    return distances;
+}
+
 void PointSet::AddPoint(AlignData aligndata, INDI::IGeographicCoordinates *pos)
 {
     Point point;
@@ -197,6 +218,9 @@ void PointSet::AddPoint(AlignData aligndata, INDI::IGeographicCoordinates *pos)
     cc_ID2name(point.htmname, point.htmID);
     point.index = getNbPoints();
     PointSetMap->insert(std::pair<HtmID, Point>(point.htmID, point));
+    CelestialIndex.add(point.htmID, point.cx, point.cy, point.cz);
+    TelescopeIndex.add(point.htmID, point.tx, point.ty, point.tz);
+    currentIndex = -1;
     Triangulation->AddPoint(point.htmID);
     LOGF_INFO("Align Pointset: added point %d alt = %g az = %g\n", point.index,
               point.celestialALT, point.celestialAZ);
@@ -235,6 +259,9 @@ void PointSet::Init()
 void PointSet::Reset()
 {
     current.clear();
+    currentIndex = -1;
+    CelestialIndex.clear();
+    TelescopeIndex.clear();
     if (PointSetMap)
     {
         PointSetMap->clear();
@@ -315,6 +342,8 @@ char *PointSet::LoadDataFile(const char *filename)
     lnalignpos->longitude = lon;
     lnalignpos->latitude = lat;
     PointSetMap->clear();
+    CelestialIndex.clear();
+    TelescopeIndex.clear();
     alignxml     = nextXMLEle(sitexml, 1);
     aligndata.jd = -1.0;
     while (alignxml)
@@ -527,8 +556,7 @@ std::vector<HtmID> PointSet::findFace(double currentRA, double currentDEC, doubl
     INDI_UNUSED(pointaz);
     Point point;
     double horangle = 0, altangle = 0;
-    std::vector<Face *> faces;
-    std::vector<Face *>::iterator it;
+    int index;
 
     point.aligndata.jd        = jd;
     point.aligndata.targetRA  = currentRA;
@@ -544,22 +572,108 @@ std::vector<HtmID> PointSet::findFace(double currentRA, double currentDEC, doubl
 
     if (Triangulation->isValid() && isPointInside(&point, current, ingoto))
         return current;
-    faces = Triangulation->getFaces();
-    it    = faces.begin();
-    while (it < faces.end())
+    index = locateFace(&point, ingoto);
+    if (index >= 0)
     {
-        if (isPointInside(&point, (*it)->v, ingoto))
-        {
-            currentFace = *it;
-            current     = (*it)->v;
-            LOGF_INFO("Align: current face is {%d, %d, %d}", PointSetMap->at(current[0]).index,
-                      PointSetMap->at(current[1]).index, PointSetMap->at(current[2]).index);
-            return current;
-        }
-        it++;
+        currentIndex = index;
+        currentFace  = Triangulation->getFaces()[index];
+        current      = currentFace->v;
+        LOGF_INFO("Align: current face is {%d, %d, %d}", PointSetMap->at(current[0]).index,
+                  PointSetMap->at(current[1]).index, PointSetMap->at(current[2]).index);
+        return current;
     }
     if (current.size() > 0)
         LOG_INFO("Align: current face is empty");
     current.clear();
     return current;
 }
+
+int PointSet::scanFace(Point *p, bool ingoto)
+{
+    const std::vector<Face *> &faces = Triangulation->getFaces();
+    for (size_t i = 0; i < faces.size(); i++)
+        if (isPointInside(p, faces[i]->v, ingoto))
+            return i;
+    return -1;
+}
+
+/* Orientation of a face, in the coordinates used by scalarTripleProduct for its vertices */
+static double faceOrientation(PointSet::Point *a, PointSet::Point *b, PointSet::Point *c, bool ingoto)
+{
+    if (ingoto)
+        return a->cx * (b->cy * c->cz - b->cz * c->cy) + a->cy * (b->cz * c->cx - b->cx * c->cz) +
+               a->cz * (b->cx * c->cy - b->cy * c->cx);
+    else
+        return a->tx * (b->ty * c->tz - b->tz * c->ty) + a->ty * (b->tz * c->tx - b->tx * c->tz) +
+               a->tz * (b->tx * c->ty - b->ty * c->tx);
+}
+
+/* Visibility walk: cross any edge having p on the side opposite to the face until p is inside the face */
+int PointSet::walkFaces(Point *p, int start, bool ingoto)
+{
+    const std::vector<Face *> &faces = Triangulation->getFaces();
+    int f = start;
+
+    for (size_t step = 0; step <= faces.size(); step++)
+    {
+        Face *face   = faces[f];
+        Point *v[3]  = { &PointSetMap->at(face->v[0]), &PointSetMap->at(face->v[1]), &PointSetMap->at(face->v[2]) };
+        double orient = faceOrientation(v[0], v[1], v[2], ingoto);
+        int next     = f;
+        if (orient == 0.0)
+            return FaceUnknown;
+        // start from a different edge at each step so the walk can not loop on a non Delaunay triangulation
+        for (int k = 0; k < 3; k++)
+        {
+            int e = (k + step) % 3;
+            if (scalarTripleProduct(p, v[e], v[(e + 1) % 3], ingoto) * orient < 0)
+            {
+                next = face->n[e];
+                break;
+            }
+        }
+        if (next == f)
+            return f;
+        if (next < 0)
+            return FaceOutside;
+        f = next;
+    }
+    return FaceUnknown;
+}
+
+int PointSet::locateFace(Point *p, bool ingoto)
+{
+    const std::vector<Face *> &faces = Triangulation->getFaces();
+    int start = currentIndex, index;
+
+    if (faces.empty())
+        return -1;
+    if (start < 0 || start >= (int)faces.size())
+    {
+        // no last face, start from a face around the nearest vertex
+        std::vector<PointIndex::Neighbour> nearest;
+        PointIndex &vertices = ingoto ? CelestialIndex : TelescopeIndex;
+        vertices.nearest(p->cx, p->cy, p->cz, 1, nearest);
+        start = nearest.empty() ? -1 : Triangulation->getVertexFace(nearest[0].second);
+        if (start < 0)
+            start = 0;
+    }
+
+    index = walkFaces(p, start, ingoto);
+    if (index == FaceOutside)
+    {
+        // isPointInside also accepts faces containing the antipode
+        Point antipode = *p;
+        antipode.cx    = -p->cx;
+        antipode.cy    = -p->cy;
+        antipode.cz    = -p->cz;
+        index          = walkFaces(&antipode, start, ingoto);
+        // boundary edges of the celestial hull lie on planes of the hull, so p is out of every face.
+        // The same faces may be folded in telescope coordinates, check them all.
+        if (index == FaceOutside && ingoto)
+            return -1;
+    }
+    if (index >= 0 && isPointInside(p, faces[index]->v, ingoto))
+        return index;
+    return scanFace(p, ingoto);
+}
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "htm.h"
+#include "pointindex.h"
 
 #include <map>
 #include <set>
@@ -77,6 +78,8 @@ class PointSet
         void setTriangulationBlobData(IBLOB *blob);
         std::set<Distance, bool (*)(Distance, Distance)> *ComputeDistances(double alt, double az, PointFilter filter,
                 bool ingoto);
+        // the n points closest to alt/az, closest first, same distances as ComputeDistances
+        std::vector<Distance> NearestPoints(double alt, double az, size_t n, bool ingoto);
         std::vector<HtmID> findFace(double currentRA, double currentDEC, double jd, double pointalt, double pointaz,
                                     INDI::IGeographicCoordinates *position, bool ingoto);
         double lat, lon, alt;
@@ -85,15 +88,25 @@ class PointSet
         void RaDecFromAltAz(double alt, double az, double jd, double *ra, double *dec, INDI::IGeographicCoordinates *pos);
         double scalarTripleProduct(Point *p, Point *e1, Point *e2, bool ingoto);
         bool isPointInside(Point *p, std::vector<HtmID> f, bool ingoto);
+        // index of the face containing p (see isPointInside) or -1:
+        // locateFace walks the triangulation from the last face, scanFace tests every face
+        int locateFace(Point *p, bool ingoto);
+        int scanFace(Point *p, bool ingoto);
 
     protected:
     private:
+        enum { FaceOutside = -1, FaceUnknown = -2 };
+        int walkFaces(Point *p, int start, bool ingoto);
+
         XMLEle *PointSetXmlRoot;
         std::map<HtmID, Point> *PointSetMap;
         bool PointSetInitialized;
         TriangulateCHull *Triangulation;
         Face *currentFace;
         std::vector<HtmID> current;
+        int currentIndex { -1 };
+        // celestial and telescope unit vectors of the points, for nearest point queries
+        PointIndex CelestialIndex, TelescopeIndex;
         // to get access to lat/long data
         INDI::Telescope *telescope;
         // from align data file
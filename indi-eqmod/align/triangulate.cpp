@@ -27,6 +27,7 @@ void Triangulate::Reset()
     isvalid = false;
     vvertices.clear();
     vfaces.clear();
+    vertexface.clear();
 }
 
 void Triangulate::AddPoint(HtmID id)
@@ -62,7 +63,7 @@ XMLEle *Triangulate::toXML()
     return (root);
 }
 
-std::vector<Face *> Triangulate::getFaces()
+const std::vector<Face *> &Triangulate::getFaces()
 {
     isvalid = true;
     return vfaces;
@@ -72,3 +73,36 @@ bool Triangulate::isValid()
 {
     return isvalid;
 }
+
+int Triangulate::getVertexFace(HtmID id)
+{
+    std::map<HtmID, int>::iterator it = vertexface.find(id);
+    return (it == vertexface.end()) ? -1 : it->second;
+}
+
+void Triangulate::linkFaces()
+{
+    // edges are keyed with their lower vertex first, the first face seen waits for the second one
+    std::map<std::pair<HtmID, HtmID>, std::pair<int, int>> edges;
+
+    vertexface.clear();
+    for (int i = 0; i < (int)vfaces.size(); i++)
+    {
+        Face *f = vfaces[i];
+        for (int e = 0; e < 3; e++)
+        {
+            HtmID a = f->v[e], b = f->v[(e + 1) % 3];
+            std::pair<HtmID, HtmID> key = (a < b) ? std::make_pair(a, b) : std::make_pair(b, a);
+            std::map<std::pair<HtmID, HtmID>, std::pair<int, int>>::iterator it = edges.find(key);
+            f->n[e] = -1;
+            if (it == edges.end())
+                edges.insert(std::make_pair(key, std::make_pair(i, e)));
+            else
+            {
+                f->n[e] = it->second.first;
+                vfaces[it->second.first]->n[it->second.second] = i;
+            }
+            vertexface.insert(std::make_pair(f->v[e], i));
+        }
+    }
+}
@@ -29,6 +29,8 @@ class Face
         v[2] = v2;
     }
     std::vector<HtmID> v;
+    // index of the face sharing edge (v[i], v[i + 1]), -1 on the boundary
+    int n[3] { -1, -1, -1 };
 };
 
 class Triangulate
@@ -41,12 +43,17 @@ class Triangulate
     virtual void Reset();
     virtual void AddPoint(HtmID id);
     virtual XMLEle *toXML();
-    virtual std::vector<Face *> getFaces();
+    virtual const std::vector<Face *> &getFaces();
     virtual bool isValid();
+    // index of a face having id as vertex, -1 if none
+    int getVertexFace(HtmID id);
 
   protected:
+    void linkFaces();
+
     std::map<HtmID, PointSet::Point> *pmap;
     std::vector<HtmID> vvertices;
     std::vector<Face *> vfaces;
+    std::map<HtmID, int> vertexface;
     bool isvalid {false};
 };
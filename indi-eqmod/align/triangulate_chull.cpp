@@ -95,6 +95,7 @@ void TriangulateCHull::AddPoint(HtmID id)
         //fprintf(stderr, "Triangulate addpoint: added face (%d total)\n", vfaces.size());
         f = f->next;
     } while (f != faces);
+    linkFaces();
 }
 
 //XMLEle *TriangulateCHull::toXML()
@@ -346,6 +346,9 @@ void EQMod::ISGetProperties(const char *dev)
         defineProperty(TrackDefaultSP);
         defineProperty(ST4GuideRateNSSP);
         defineProperty(ST4GuideRateWESP);
+        defineProperty(PipeliningSP);
+        defineProperty(PollIntervalsNP);
+        defineProperty(LinkLatencyNP);
 
 #if defined WITH_ALIGN && defined WITH_ALIGN_GEEHALEL
         defineProperty(&AlignMethodSP);
@@ -428,6 +431,9 @@ bool EQMod::loadProperties()
     UseBacklashSP       = getSwitch("USEBACKLASH");
     AuxEncoderSP        = getSwitch("AUXENCODER");
     AuxEncoderNP        = getNumber("AUXENCODERVALUES");
+    PipeliningSP        = getSwitch("PIPELINING");
+    PollIntervalsNP     = getNumber("POLL_INTERVALS");
+    LinkLatencyNP       = getNumber("LINK_LATENCY");
     ST4GuideRateNSSP    = getSwitch("ST4_GUIDE_RATE_NS");
     ST4GuideRateWESP    = getSwitch("ST4_GUIDE_RATE_WE");
     PPECTrainingSP      = getSwitch("PPEC_TRAINING");
@@ -528,6 +534,9 @@ bool EQMod::updateProperties()
         defineProperty(TrackDefaultSP);
         defineProperty(ST4GuideRateNSSP);
         defineProperty(ST4GuideRateWESP);
+        defineProperty(PipeliningSP);
+        defineProperty(PollIntervalsNP);
+        defineProperty(LinkLatencyNP);
 
 #if defined WITH_ALIGN && defined WITH_ALIGN_GEEHALEL
         defineProperty(&AlignMethodSP);
@@ -579,6 +588,10 @@ bool EQMod::updateProperties()
             mount->SetBacklashRA((uint32_t)(BacklashNP.findWidgetByName("BACKLASHRA")->getValue()));
             mount->SetBacklashDE((uint32_t)(BacklashNP.findWidgetByName("BACKLASHDE")->getValue()));
 
+            mount->SetPipelining(PipeliningSP.findWidgetByName("PIPELINING_ON")->getState() == ISS_ON);
+            mount->SetPollIntervals(PollIntervalsNP.findWidgetByName("STATUS_INTERVAL")->getValue(),
+                                    PollIntervalsNP.findWidgetByName("AUX_INTERVAL")->getValue());
+
             if (mount->HasSnapPort1())
             {
                 defineProperty(SNAPPORT1SP);
@@ -639,6 +652,9 @@ bool EQMod::updateProperties()
         deleteProperty(UseBacklashSP);
         deleteProperty(ST4GuideRateNSSP);
         deleteProperty(ST4GuideRateWESP);
+        deleteProperty(PipeliningSP);
+        deleteProperty(PollIntervalsNP);
+        deleteProperty(LinkLatencyNP);
         deleteProperty(LEDBrightnessNP);
 
         if (mount->HasAuxEncoders())
@@ -828,8 +844,9 @@ bool EQMod::ReadScopeStatus()
     try
     {
         TelescopePierSide pierSide;
-        currentRAEncoder = mount->GetRAEncoder();
-        currentDEEncoder = mount->GetDEEncoder();
+        mount->PollStatus();
+        currentRAEncoder = mount->GetlastreadRAEncoder();
+        currentDEEncoder = mount->GetlastreadDEEncoder();
         DEBUGF(DBG_SCOPE_STATUS, "Current encoders RA=%ld DE=%ld", static_cast<long>(currentRAEncoder),
                static_cast<long>(currentDEEncoder));
         EncodersToRADec(currentRAEncoder, currentDEEncoder, lst, &currentRA, &currentDEC, &currentHA, &pierSide);
@@ -931,11 +948,22 @@ bool EQMod::ReadScopeStatus()
         CurrentSteppersNP.update(steppervalues, (char **)steppernames, 2);
         CurrentSteppersNP.apply();
 
-        mount->GetRAMotorStatus(RAStatusLP);
-        mount->GetDEMotorStatus(DEStatusLP);
+        mount->GetRAMotorStatus(RAStatusLP, false);
+        mount->GetDEMotorStatus(DEStatusLP, false);
         RAStatusLP.apply();
         DEStatusLP.apply();
 
+        {
+            const Skywatcher::SkywatcherLinkStats &stats = mount->GetLinkStats();
+            LinkLatencyNP.findWidgetByName("LATENCY_LAST")->setValue(stats.last);
+            LinkLatencyNP.findWidgetByName("LATENCY_MEAN")->setValue(stats.mean);
+            LinkLatencyNP.findWidgetByName("LATENCY_MAX")->setValue(stats.max);
+            LinkLatencyNP.findWidgetByName("POLL_TIME")->setValue(stats.polltime);
+            LinkLatencyNP.findWidgetByName("POLL_COMMANDS")->setValue(stats.pollcommands);
+            LinkLatencyNP.setState(IPS_OK);
+            LinkLatencyNP.apply();
+        }
+
         periods[0] = mount->GetRAPeriod();
         periods[1] = mount->GetDEPeriod();
         PeriodsNP.update(periods, (char **)periodsnames, 2);
@@ -967,8 +995,8 @@ bool EQMod::ReadScopeStatus()
         {
             double auxencodervalues[2];
             const char *auxencodernames[] = { "AUXENCRASteps", "AUXENCDESteps" };
-            auxencodervalues[0]           = mount->GetRAAuxEncoder();
-            auxencodervalues[1]           = mount->GetDEAuxEncoder();
+            auxencodervalues[0]           = mount->GetlastreadRAAuxEncoder();
+            auxencodervalues[1]           = mount->GetlastreadDEAuxEncoder();
             AuxEncoderNP.update(auxencodervalues, (char **)auxencodernames, 2);
             AuxEncoderNP.apply();
         }
@@ -2534,6 +2562,17 @@ bool EQMod::ISNewNumber(const char *dev, const char *name, double values[], char
             return true;
         }
 
+        if (PollIntervalsNP.isNameMatch(name))
+        {
+            PollIntervalsNP.update(values, names, n);
+            PollIntervalsNP.setState(IPS_OK);
+            PollIntervalsNP.apply();
+            mount->SetPollIntervals(PollIntervalsNP.findWidgetByName("STATUS_INTERVAL")->getValue(),
+                                    PollIntervalsNP.findWidgetByName("AUX_INTERVAL")->getValue());
+            saveConfig(PollIntervalsNP);
+            return true;
+        }
+
         if (strcmp(name, "BACKLASH") == 0)
         {
             BacklashNP.update(values, names, n);
@@ -2657,6 +2696,18 @@ bool EQMod::ISNewSwitch(const char *dev, const char *name, ISState *states, char
             return true;
         }
 
+        if (PipeliningSP.isNameMatch(name))
+        {
+            PipeliningSP.update(states, names, n);
+            mount->SetPipelining(PipeliningSP.findWidgetByName("PIPELINING_ON")->getState() == ISS_ON);
+            LOGF_INFO("Command pipelining %s.", PipeliningSP.findWidgetByName("PIPELINING_ON")->getState() == ISS_ON ?
+                      "enabled" : "disabled");
+            PipeliningSP.setState(IPS_OK);
+            PipeliningSP.apply();
+            saveConfig(PipeliningSP);
+            return true;
+        }
+
         if (strcmp(name, "USEBACKLASH") == 0)
         {
             UseBacklashSP.update(states, names, n);
@@ -3535,6 +3586,10 @@ bool EQMod::saveConfigItems(FILE *fp)
         BacklashNP.save(fp);
     if (UseBacklashSP)
         UseBacklashSP.save(fp);
+    if (PipeliningSP)
+        PipeliningSP.save(fp);
+    if (PollIntervalsNP)
+        PollIntervalsNP.save(fp);
     if (GuideRateNP)
         GuideRateNP.save(fp);
     if (PulseLimitsNP)
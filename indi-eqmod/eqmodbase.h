@@ -120,6 +120,9 @@ protected:
 #endif
     INDI::PropertySwitch   AuxEncoderSP        {INDI::Property()};
     INDI::PropertyNumber   AuxEncoderNP        {INDI::Property()};
+    INDI::PropertySwitch   PipeliningSP        {INDI::Property()};
+    INDI::PropertyNumber   PollIntervalsNP     {INDI::Property()};
+    INDI::PropertyNumber   LinkLatencyNP       {INDI::Property()};
 
     INDI::PropertySwitch   ST4GuideRateNSSP    {INDI::Property()};
     INDI::PropertySwitch   ST4GuideRateWESP    {INDI::Property()};
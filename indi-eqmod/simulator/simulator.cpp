@@ -19,6 +19,7 @@ void EQModSimulator::Connect()
 {
     auto sw  = SimModeSP.findOnSwitch();
     sksim    = new SkywatcherSimulator();
+    replies.clear();
 
     if (sw->isNameMatch("SIM_EQ6"))
     {
@@ -93,17 +94,36 @@ void EQModSimulator::receive_cmd(const char *cmd, int *received)
 {
     // *received=0;
     if (sksim)
+    {
+        char reply[32];
+        int len = 0;
         sksim->process_command(cmd, received);
+        sksim->get_reply(reply, &len);
+        replies.push_back(std::string(reply, len));
+    }
 }
 
 void EQModSimulator::send_reply(char *buf, int *sent)
 {
+    if (!replies.empty())
+    {
+        const std::string &reply = replies.front();
+        memcpy(buf, reply.c_str(), reply.size() + 1);
+        *sent = reply.size();
+        replies.pop_front();
+        return;
+    }
     if (sksim)
         sksim->get_reply(buf, sent);
     //strncpy(buf,"=\r", 2);
     //*sent=2;
 }
 
+void EQModSimulator::flush()
+{
+    replies.clear();
+}
+
 bool EQModSimulator::initProperties()
 {
     telescope->buildSkeleton("indi_eqmod_simulator_sk.xml");
@@ -22,6 +22,9 @@
 
 #include <inditelescope.h>
 
+#include <deque>
+#include <string>
+
 class EQModSimulator
 {
   protected:
@@ -38,11 +41,15 @@ class EQModSimulator
 
     bool defined=false;
 
+    // replies not read yet, in command order, so that commands may be pipelined
+    std::deque<std::string> replies;
+
   public:
     EQModSimulator(INDI::Telescope *);
     void Connect();
     void receive_cmd(const char *cmd, int *received);
     void send_reply(char *buf, int *sent);
+    void flush();
     bool initProperties();
     bool updateProperties(bool enable);
     bool ISNewNumber(const char *dev, const char *name, double values[], char *names[], int n);
@@ -78,6 +78,9 @@ bool Skywatcher::Handshake()
 
     uint32_t tmpMCVersion = 0;
 
+    linkstats        = SkywatcherLinkStats();
+    pipelinefailures = 0;
+
     dispatch_command(InquireMotorBoardVersion, Axis1, nullptr);
     //read_eqmod();
     tmpMCVersion = Revu24str2long(response + 1);
@@ -116,19 +119,7 @@ uint32_t Skywatcher::GetRAEncoder()
 {
     // Axis Position
     dispatch_command(GetAxisPosition, Axis1, nullptr);
-
-    uint32_t steps = Revu24str2long(response + 1);
-    if (steps & 0x80000000)
-        DEBUGF(telescope->DBG_SCOPE_STATUS, "%s() = Ignoring invalid response %s", __FUNCTION__, response);
-    else
-        RAStep = steps;
-
-    gettimeofday(&lastreadmotorposition[Axis1], nullptr);
-    if (RAStep != lastRAStep)
-    {
-        DEBUGF(telescope->DBG_SCOPE_STATUS, "%s() = %ld", __FUNCTION__, static_cast<long>(RAStep));
-        lastRAStep = RAStep;
-    }
+    ParseAxisPosition(Axis1, response);
     return RAStep;
 }
 
@@ -136,19 +127,39 @@ uint32_t Skywatcher::GetDEEncoder()
 {
     // Axis Position
     dispatch_command(GetAxisPosition, Axis2, nullptr);
+    ParseAxisPosition(Axis2, response);
+    return DEStep;
+}
+
+uint32_t Skywatcher::GetlastreadRAEncoder()
+{
+    return RAStep;
+}
 
-    uint32_t steps = Revu24str2long(response + 1);
+uint32_t Skywatcher::GetlastreadDEEncoder()
+{
+    return DEStep;
+}
+
+void Skywatcher::ParseAxisPosition(SkywatcherAxis axis, const char *reply)
+{
+    uint32_t *step     = (axis == Axis1) ? &RAStep : &DEStep;
+    uint32_t *laststep = (axis == Axis1) ? &lastRAStep : &lastDEStep;
+
+    uint32_t steps = Revu24str2long(reply + 1);
     if (steps & 0x80000000)
-        DEBUGF(telescope->DBG_SCOPE_STATUS, "%s() = Ignoring invalid response %s", __FUNCTION__, response);
+        DEBUGF(telescope->DBG_SCOPE_STATUS, "%s() : Axis = %c -- Ignoring invalid response %s", __FUNCTION__,
+               AxisCmd[axis], reply);
     else
-        DEStep = steps;
-    gettimeofday(&lastreadmotorposition[Axis2], nullptr);
-    if (DEStep != lastDEStep)
+        *step = steps;
+
+    gettimeofday(&lastreadmotorposition[axis], nullptr);
+    if (*step != *laststep)
     {
-        DEBUGF(telescope->DBG_SCOPE_STATUS, "%s() = %ld", __FUNCTION__, static_cast<long>(DEStep));
-        lastDEStep = DEStep;
+        DEBUGF(telescope->DBG_SCOPE_STATUS, "%s() : Axis = %c -- steps = %ld", __FUNCTION__, AxisCmd[axis],
+               static_cast<long>(*step));
+        *laststep = *step;
     }
-    return DEStep;
 }
 
 uint32_t Skywatcher::GetRAEncoderZero()
@@ -245,9 +256,10 @@ void Skywatcher::GetRAMotorStatus(ILightVectorProperty *motorLP)
     }
 }
 
-void Skywatcher::GetRAMotorStatus(INDI::PropertyLight motorLP)
+void Skywatcher::GetRAMotorStatus(INDI::PropertyLight motorLP, bool refresh)
 {
-    ReadMotorStatus(Axis1);
+    if (refresh)
+        ReadMotorStatus(Axis1);
     if (!RAInitialized)
     {
         motorLP.findWidgetByName("RAInitialized")->setState(IPS_ALERT);
@@ -288,9 +300,10 @@ void Skywatcher::GetDEMotorStatus(ILightVectorProperty *motorLP)
     }
 }
 
-void Skywatcher::GetDEMotorStatus(INDI::PropertyLight motorLP)
+void Skywatcher::GetDEMotorStatus(INDI::PropertyLight motorLP, bool refresh)
 {
-    ReadMotorStatus(Axis2);
+    if (refresh)
+        ReadMotorStatus(Axis2);
     if (!DEInitialized)
     {
         motorLP.findWidgetByName("DEInitialized")->setState(IPS_ALERT);
@@ -805,36 +818,41 @@ void Skywatcher::ReadMotorStatus(SkywatcherAxis axis)
 {
     dispatch_command(GetAxisStatus, axis, nullptr);
     //read_eqmod();
+    ParseMotorStatus(axis, response);
+}
+
+void Skywatcher::ParseMotorStatus(SkywatcherAxis axis, const char *reply)
+{
     switch (axis)
     {
         case Axis1:
-            RAInitialized = (response[3] & 0x01);
-            RARunning     = (response[2] & 0x01);
-            if (response[1] & 0x01)
+            RAInitialized = (reply[3] & 0x01);
+            RARunning     = (reply[2] & 0x01);
+            if (reply[1] & 0x01)
                 RAStatus.slewmode = SLEW;
             else
                 RAStatus.slewmode = GOTO;
-            if (response[1] & 0x02)
+            if (reply[1] & 0x02)
                 RAStatus.direction = BACKWARD;
             else
                 RAStatus.direction = FORWARD;
-            if (response[1] & 0x04)
+            if (reply[1] & 0x04)
                 RAStatus.speedmode = HIGHSPEED;
             else
                 RAStatus.speedmode = LOWSPEED;
             break;
         case Axis2:
-            DEInitialized = (response[3] & 0x01);
-            DERunning     = (response[2] & 0x01);
-            if (response[1] & 0x01)
+            DEInitialized = (reply[3] & 0x01);
+            DERunning     = (reply[2] & 0x01);
+            if (reply[1] & 0x01)
                 DEStatus.slewmode = SLEW;
             else
                 DEStatus.slewmode = GOTO;
-            if (response[1] & 0x02)
+            if (reply[1] & 0x02)
                 DEStatus.direction = BACKWARD;
             else
                 DEStatus.direction = FORWARD;
-            if (response[1] & 0x04)
+            if (reply[1] & 0x04)
                 DEStatus.speedmode = HIGHSPEED;
             else
                 DEStatus.speedmode = LOWSPEED;
@@ -843,6 +861,7 @@ void Skywatcher::ReadMotorStatus(SkywatcherAxis axis)
             break;
     }
     gettimeofday(&lastreadmotorstatus[axis], nullptr);
+    motionchanged[axis] = false;
 }
 
 void Skywatcher::SlewRA(double rate)
@@ -1368,6 +1387,16 @@ uint32_t Skywatcher::ReadEncoder(SkywatcherAxis axis)
     return Revu24str2long(response + 1);
 }
 
+uint32_t Skywatcher::GetlastreadRAAuxEncoder()
+{
+    return AuxStep[Axis1];
+}
+
+uint32_t Skywatcher::GetlastreadDEAuxEncoder()
+{
+    return AuxStep[Axis2];
+}
+
 uint32_t Skywatcher::GetRAAuxEncoder()
 {
     return ReadEncoder(Axis1);
@@ -1788,8 +1817,13 @@ double Skywatcher::get_max_rate()
 
 bool Skywatcher::dispatch_command(SkywatcherCommand cmd, SkywatcherAxis axis, char *command_arg)
 {
+    // Motor status has to be read again on the next poll
+    if (cmd == StartMotion || cmd == NotInstantAxisStop || cmd == InstantAxisStop || cmd == SetMotionMode)
+        motionchanged[axis] = true;
+
     for (uint8_t i = 0; i < EQMOD_MAX_RETRY; i++)
     {
+        struct timeval start, now;
         // Clear string
         command[0] = '\0';
 
@@ -1800,6 +1834,7 @@ bool Skywatcher::dispatch_command(SkywatcherCommand cmd, SkywatcherAxis axis, ch
                      SkywatcherTrailingChar);
 
         int nbytes_written = 0;
+        gettimeofday(&start, nullptr);
         if (!isSimulation())
         {
             int err_code = 0;
@@ -1837,6 +1872,8 @@ bool Skywatcher::dispatch_command(SkywatcherCommand cmd, SkywatcherAxis axis, ch
         {
             if (read_eqmod())
             {
+                gettimeofday(&now, nullptr);
+                update_link_stats((now.tv_sec - start.tv_sec) * 1000.0 + (now.tv_usec - start.tv_usec) / 1000.0);
                 if (i > 0)
                 {
                     LOGF_WARN("%s() : serial port read failed for %dms (%d retries), verify mount link.", __FUNCTION__,
@@ -1860,6 +1897,166 @@ bool Skywatcher::dispatch_command(SkywatcherCommand cmd, SkywatcherAxis axis, ch
     return true;
 }
 
+void Skywatcher::dispatch_commands(SkywatcherTransaction *transactions, int count)
+{
+    int done = 0;
+
+    if (pipelining && count > 1 && count <= SKYWATCHER_MAX_PIPELINE)
+    {
+        char commands[SKYWATCHER_MAX_PIPELINE][SKYWATCHER_MAX_CMD];
+        struct timeval start, now;
+        int written = 0;
+
+        for (int i = 0; i < count; i++)
+            snprintf(commands[i], SKYWATCHER_MAX_CMD, "%c%c%c%c", SkywatcherLeadingChar, transactions[i].cmd,
+                     AxisCmd[transactions[i].axis], SkywatcherTrailingChar);
+
+        if (!isSimulation())
+            tcflush(PortFD, TCIOFLUSH);
+        gettimeofday(&start, nullptr);
+        // One write per command, each one goes in its own datagram on UDP links
+        for (; written < count; written++)
+        {
+            int nbytes_written = 0;
+            if (!isSimulation())
+            {
+                if (tty_write_string(PortFD, commands[written], &nbytes_written) != TTY_OK)
+                    break;
+            }
+            else
+                telescope->simulator->receive_cmd(commands[written], &nbytes_written);
+        }
+        DEBUGF(telescope->DBG_COMM, "dispatch_commands: %d of %d commands written", written, count);
+
+        try
+        {
+            for (; done < written; done++)
+            {
+                // for the error messages of read_eqmod
+                snprintf(command, SKYWATCHER_MAX_CMD, "%.3s", commands[done]);
+                debugnextread = true;
+                read_eqmod();
+                if (done == 0)
+                {
+                    gettimeofday(&now, nullptr);
+                    update_link_stats((now.tv_sec - start.tv_sec) * 1000.0 + (now.tv_usec - start.tv_usec) / 1000.0);
+                }
+                memcpy(transactions[done].response, response, SKYWATCHER_MAX_CMD);
+            }
+            pipelinefailures = 0;
+        }
+        catch (EQModError &e)
+        {
+            // Replies after a lost or garbled one can not be matched, finish one command at a time.
+            // Some links may not keep up with back-to-back commands: stop pipelining if it keeps failing.
+            if (isSimulation())
+                telescope->simulator->flush();
+            if (++pipelinefailures >= SKYWATCHER_MAX_TRIES)
+            {
+                LOGF_WARN("Pipelined commands failed %d times (%s), sending commands one at a time.", pipelinefailures,
+                          e.message);
+                pipelining = false;
+            }
+            else
+                DEBUGF(telescope->DBG_COMM, "dispatch_commands: %s, retrying one command at a time", e.message);
+        }
+    }
+
+    for (; done < count; done++)
+    {
+        dispatch_command(transactions[done].cmd, transactions[done].axis, nullptr);
+        memcpy(transactions[done].response, response, SKYWATCHER_MAX_CMD);
+    }
+}
+
+void Skywatcher::update_link_stats(double roundtrip)
+{
+    linkstats.exchanges++;
+    linkstats.last = roundtrip;
+    linkstats.mean += (roundtrip - linkstats.mean) / linkstats.exchanges;
+    if (roundtrip > linkstats.max)
+        linkstats.max = roundtrip;
+}
+
+const Skywatcher::SkywatcherLinkStats &Skywatcher::GetLinkStats()
+{
+    return linkstats;
+}
+
+void Skywatcher::SetPipelining(bool enable)
+{
+    pipelining       = enable;
+    pipelinefailures = 0;
+}
+
+void Skywatcher::SetPollIntervals(double status, double aux)
+{
+    statusinterval = status;
+    auxinterval    = aux;
+}
+
+void Skywatcher::PollStatus()
+{
+    SkywatcherTransaction transactions[SKYWATCHER_MAX_PIPELINE];
+    struct timeval start, now;
+    bool readstatus[NUMBER_OF_SKYWATCHERAXIS];
+    bool readaux;
+    int count = 0;
+
+    gettimeofday(&start, nullptr);
+    for (int axis = Axis1; axis < NUMBER_OF_SKYWATCHERAXIS; axis++)
+    {
+        bool running = (axis == Axis1) ? RARunning : DERunning;
+        double age   = (start.tv_sec - lastreadmotorstatus[axis].tv_sec) +
+                       (start.tv_usec - lastreadmotorstatus[axis].tv_usec) / 1e6;
+        readstatus[axis] = running || motionchanged[axis] || age >= statusinterval;
+    }
+    readaux = HasAuxEncoders() && ((start.tv_sec - lastreadauxencoder.tv_sec) +
+                                   (start.tv_usec - lastreadauxencoder.tv_usec) / 1e6) >= auxinterval;
+
+    for (int axis = Axis1; axis < NUMBER_OF_SKYWATCHERAXIS; axis++)
+    {
+        transactions[count].cmd    = GetAxisPosition;
+        transactions[count++].axis = static_cast<SkywatcherAxis>(axis);
+        if (readstatus[axis])
+        {
+            transactions[count].cmd    = GetAxisStatus;
+            transactions[count++].axis = static_cast<SkywatcherAxis>(axis);
+        }
+        if (readaux)
+        {
+            transactions[count].cmd    = InquireAuxEncoder;
+            transactions[count++].axis = static_cast<SkywatcherAxis>(axis);
+        }
+    }
+
+    dispatch_commands(transactions, count);
+
+    for (int i = 0; i < count; i++)
+    {
+        switch (transactions[i].cmd)
+        {
+            case GetAxisPosition:
+                ParseAxisPosition(transactions[i].axis, transactions[i].response);
+                break;
+            case GetAxisStatus:
+                ParseMotorStatus(transactions[i].axis, transactions[i].response);
+                break;
+            case InquireAuxEncoder:
+                AuxStep[transactions[i].axis] = Revu24str2long(transactions[i].response + 1);
+                break;
+            default:
+                break;
+        }
+    }
+    if (readaux)
+        lastreadauxencoder = start;
+
+    gettimeofday(&now, nullptr);
+    linkstats.polltime     = (now.tv_sec - start.tv_sec) * 1000.0 + (now.tv_usec - start.tv_usec) / 1000.0;
+    linkstats.pollcommands = count;
+}
+
 bool Skywatcher::read_eqmod()
 {
     int err_code = 0, nbytes_read = 0;
@@ -1912,7 +2109,7 @@ bool Skywatcher::read_eqmod()
     return true;
 }
 
-uint32_t Skywatcher::Revu24str2long(char *s)
+uint32_t Skywatcher::Revu24str2long(const char *s)
 {
     uint32_t res = 0;
     res               = HEX(s[4]);
@@ -1929,7 +2126,7 @@ uint32_t Skywatcher::Revu24str2long(char *s)
     return res;
 }
 
-uint32_t Skywatcher::Highstr2long(char *s)
+uint32_t Skywatcher::Highstr2long(const char *s)
 {
     uint32_t res = 0;
     res               = HEX(s[0]);
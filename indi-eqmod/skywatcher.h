@@ -42,6 +42,9 @@ class EQMod; // TODO
 #define SKYWATCHER_LOWSPEED_RATE 128
 #define SKYWATCHER_MAXREFRESH    0.5
 
+// Commands written back-to-back in a pipelined transaction
+#define SKYWATCHER_MAX_PIPELINE 8
+
 #define SKYWATCHER_BACKLASH_SPEED_RA 64
 #define SKYWATCHER_BACKLASH_SPEED_DE 64
 
@@ -78,11 +81,33 @@ class Skywatcher
 
         INDI_DEPRECATED("Use GetRAMotorStatus(INDI::PropertyLight).")
         void GetRAMotorStatus(ILightVectorProperty *motorLP);
-        void GetRAMotorStatus(INDI::PropertyLight motorLP);
+        // refresh false shows the status read by the last poll
+        void GetRAMotorStatus(INDI::PropertyLight motorLP, bool refresh = true);
         
         INDI_DEPRECATED("Use GetDEMotorStatus(INDI::PropertyLight).")
         void GetDEMotorStatus(ILightVectorProperty *motorLP);
-        void GetDEMotorStatus(INDI::PropertyLight motorLP);
+        void GetDEMotorStatus(INDI::PropertyLight motorLP, bool refresh = true);
+
+        // Poll scheduler: reads both encoders on every call, motor status while
+        // motors run or after a motion command, otherwise every status interval,
+        // and aux encoders every aux interval, all as one pipelined transaction.
+        void PollStatus();
+        void SetPollIntervals(double status, double aux);
+        void SetPipelining(bool enable);
+        uint32_t GetlastreadRAEncoder();
+        uint32_t GetlastreadDEEncoder();
+        uint32_t GetlastreadRAAuxEncoder();
+        uint32_t GetlastreadDEAuxEncoder();
+
+        // Link latency, in ms: round trip to the first reply of each exchange, and duration of the last poll
+        typedef struct SkywatcherLinkStats
+        {
+            uint32_t exchanges = 0;
+            double last = 0, mean = 0, max = 0;
+            double polltime = 0;
+            int pollcommands = 0;
+        } SkywatcherLinkStats;
+        const SkywatcherLinkStats &GetLinkStats();
 
         INDI_DEPRECATED("Use InquireBoardVersion(INDI::PropertyText).")
         void InquireBoardVersion(ITextVectorProperty *boardTP);
@@ -269,6 +294,8 @@ class Skywatcher
         void InquireEncoderInfo(SkywatcherAxis axis, double *steppersvalues);
         void CheckMotorStatus(SkywatcherAxis axis);
         void ReadMotorStatus(SkywatcherAxis axis);
+        void ParseMotorStatus(SkywatcherAxis axis, const char *reply);
+        void ParseAxisPosition(SkywatcherAxis axis, const char *reply);
         void SetMotion(SkywatcherAxis axis, SkywatcherAxisStatus newstatus);
         void SetSpeed(SkywatcherAxis axis, uint32_t period);
         void SetTarget(SkywatcherAxis axis, uint32_t increment);
@@ -289,11 +316,21 @@ class Skywatcher
         void SetAxisPosition(SkywatcherAxis axis, uint32_t step);
         void TurnSnapPort(SkywatcherAxis axis, bool on);
 
+        typedef struct SkywatcherTransaction
+        {
+            SkywatcherCommand cmd;
+            SkywatcherAxis axis;
+            char response[SKYWATCHER_MAX_CMD];
+        } SkywatcherTransaction;
+
         bool read_eqmod();
         bool dispatch_command(SkywatcherCommand cmd, SkywatcherAxis axis, char *arg);
+        // Write all commands (no argument) back-to-back, then match the replies in order
+        void dispatch_commands(SkywatcherTransaction *transactions, int count);
+        void update_link_stats(double roundtrip);
 
-        uint32_t Revu24str2long(char *);
-        uint32_t Highstr2long(char *);
+        uint32_t Revu24str2long(const char *);
+        uint32_t Highstr2long(const char *);
         void long2Revu24str(uint32_t, char *);
 
         double get_min_rate();
@@ -356,6 +393,16 @@ class Skywatcher
 
         bool snapportstatus[NUMBER_OF_SKYWATCHERAXIS];
 
+        // Poll scheduler
+        bool pipelining {true};
+        int pipelinefailures {0};
+        double statusinterval {1.0}; // s
+        double auxinterval {1.0};    // s
+        bool motionchanged[NUMBER_OF_SKYWATCHERAXIS] {true, true};
+        struct timeval lastreadauxencoder {0, 0};
+        uint32_t AuxStep[NUMBER_OF_SKYWATCHERAXIS] {0, 0};
+        SkywatcherLinkStats linkstats;
+
         const long EQMOD_TIMEOUT = 200000; // us
         const uint8_t EQMOD_MAX_RETRY = 10;
 };
@@ -4,6 +4,9 @@
 #include "config.h"
 #include "eqmodbase.h"
 
+#include <chrono>
+#include <random>
+
 
 using ::testing::_;
 using ::testing::StrEq;
@@ -453,6 +456,108 @@ TEST(EqmodTest, scope_limits_altaz)
 }
 #endif
 
+#ifdef WITH_ALIGN_GEEHALEL
+#include "align/pointset.h"
+
+#include <indicom.h>
+
+static PointSet::Point AlignQueryPoint(double alt, double az)
+{
+    PointSet::Point point;
+    double horangle = range360(-180.0 - az) * M_PI / 180.0;
+    double altangle = alt * M_PI / 180.0;
+    point.celestialALT = alt;
+    point.celestialAZ  = az;
+    point.cx           = cos(altangle) * cos(horangle);
+    point.cy           = cos(altangle) * sin(horangle);
+    point.cz           = sin(altangle);
+    return point;
+}
+
+// Compares the indexed nearest point and face lookups with the full scans they replace,
+// and reports the time per query of both at 10, 100 and 1000 alignment points.
+TEST(EqmodTest, align_point_lookup)
+{
+    TestEQMod eqmod;
+    INDI::IGeographicCoordinates position { 15.0, 50.0, 0 };
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    for (int count : { 10, 100, 1000 })
+    {
+        PointSet pointset(&eqmod);
+        pointset.Init();
+        for (int i = 0; i < count; i++)
+        {
+            AlignData aligndata;
+            aligndata.jd           = 2460000.5;
+            aligndata.lst          = 0;
+            aligndata.targetRA     = uniform(rng) * 24.0;
+            aligndata.targetDEC    = asin(2 * uniform(rng) - 1) * 180.0 / M_PI;
+            aligndata.telescopeRA  = aligndata.targetRA + (uniform(rng) - 0.5) * 0.02;
+            aligndata.telescopeDEC = std::max(-90.0, std::min(90.0, aligndata.targetDEC + (uniform(rng) - 0.5) * 0.3));
+            pointset.AddPoint(aligndata, &position);
+        }
+
+        // a tracked target drifting in azimuth, jumping elsewhere from time to time
+        std::vector<PointSet::Point> queries;
+        double alt = 0, az = 0;
+        for (int i = 0; i < 5000; i++)
+        {
+            if (i % 500 == 0)
+            {
+                alt = asin(2 * uniform(rng) - 1) * 180.0 / M_PI;
+                az  = uniform(rng) * 360.0;
+            }
+            az  = range360(az + 0.05);
+            alt = std::min(89.9, alt + 0.01);
+            queries.push_back(AlignQueryPoint(alt, az));
+        }
+
+        for (bool ingoto : { false, true })
+        {
+            std::chrono::duration<double, std::micro> scan(0), indexed(0);
+            for (auto &point : queries)
+            {
+                auto start = std::chrono::steady_clock::now();
+                auto distances = pointset.ComputeDistances(point.celestialALT, point.celestialAZ, PointSet::None, ingoto);
+                auto middle = std::chrono::steady_clock::now();
+                auto nearest = pointset.NearestPoints(point.celestialALT, point.celestialAZ, 3, ingoto);
+                indexed += std::chrono::steady_clock::now() - middle;
+                scan += middle - start;
+
+                ASSERT_EQ(nearest.size(), 3u);
+                auto it = distances->begin();
+                for (auto &d : nearest)
+                {
+                    EXPECT_EQ(d.htmID, it->htmID);
+                    EXPECT_NEAR(d.value, it->value, 1e-9);
+                    it++;
+                }
+                delete distances;
+            }
+            printf("%4d points, %s: nearest scan %8.2f us, index %6.2f us\n", count, ingoto ? "goto" : "sync",
+                   scan.count() / queries.size(), indexed.count() / queries.size());
+
+            scan = indexed = std::chrono::duration<double, std::micro>(0);
+            for (auto &point : queries)
+            {
+                auto start = std::chrono::steady_clock::now();
+                int expected = pointset.scanFace(&point, ingoto);
+                auto middle = std::chrono::steady_clock::now();
+                int face = pointset.locateFace(&point, ingoto);
+                indexed += std::chrono::steady_clock::now() - middle;
+                scan += middle - start;
+
+                EXPECT_EQ(face < 0, expected < 0);
+            }
+            printf("%4d points, %s: face scan %8.2f us, walk %6.2f us\n", count, ingoto ? "goto" : "sync",
+                   scan.count() / queries.size(), indexed.count() / queries.size());
+        }
+    }
+}
+#endif
+
 int main(int argc, char **argv)
 {
     INDI::Logger::getInstance().configure("", INDI::Logger::file_off,
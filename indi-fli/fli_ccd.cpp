@@ -21,6 +21,8 @@
 
 */
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 #include <time.h>
 #include <math.h>
@@ -39,6 +41,8 @@
 #define MAX_X_BIN      16   /* Max Horizontal binning */
 #define MAX_Y_BIN      16   /* Max Vertical binning */
 #define TEMP_THRESHOLD .25  /* Differential temperature threshold (C)*/
+#define DOWNLOAD_CHUNK (1024 * 1024) /* Bytes requested per FLIGrabFrame() call */
+#define DOWNLOAD_UPDATE_MS 250       /* Download progress update interval */
 
 static std::unique_ptr<FLICCD> fliCCD(new FLICCD());
 
@@ -51,6 +55,7 @@ FLICCD::FLICCD()
 
 FLICCD::~FLICCD()
 {
+    m_DownloadWorker.quit();
     delete [] CameraModeS;
 }
 
@@ -94,6 +99,17 @@ bool FLICCD::initProperties()
     IUFillSwitchVector(&BackgroundFlushSP, BackgroundFlushS, 2, getDeviceName(), "CCD_BACKGROUND_FLUSH", "BKG. Flush",
                        OPTIONS_TAB, IP_RW, ISR_1OFMANY, 0, IPS_IDLE);
 
+    // Image download: whole row batches straight into the frame buffer, or the legacy row by row transfer
+    IUFillSwitch(&DownloadModeS[DOWNLOAD_FRAME], "FRAME", "Batched", ISS_ON);
+    IUFillSwitch(&DownloadModeS[DOWNLOAD_ROWS], "ROWS", "Row by row", ISS_OFF);
+    IUFillSwitchVector(&DownloadModeSP, DownloadModeS, 2, getDeviceName(), "CCD_DOWNLOAD_MODE", "Download",
+                       OPTIONS_TAB, IP_RW, ISR_1OFMANY, 0, IPS_IDLE);
+
+    IUFillNumber(&DownloadN[DOWNLOAD_PROGRESS], "PROGRESS", "Progress (%)", "%.f", 0., 100., 1., 0.);
+    IUFillNumber(&DownloadN[DOWNLOAD_RATE], "RATE", "Rate (MB/s)", "%.2f", 0., 1000., 0., 0.);
+    IUFillNumberVector(&DownloadNP, DownloadN, 2, getDeviceName(), "CCD_DOWNLOAD", "Download", MAIN_CONTROL_TAB,
+                       IP_RO, 60, IPS_IDLE);
+
     SetCCDCapability(CCD_CAN_ABORT | CCD_CAN_BIN | CCD_CAN_SUBFRAME | CCD_HAS_COOLER | CCD_HAS_SHUTTER);
 
     PrimaryCCD.setMinMaxStep("CCD_EXPOSURE", "CCD_EXPOSURE_VALUE", 0.04, 3600, 1, false);
@@ -120,6 +136,8 @@ bool FLICCD::updateProperties()
         defineProperty(&CoolerNP);
         defineProperty(&FlushNP);
         defineProperty(&BackgroundFlushSP);
+        defineProperty(&DownloadModeSP);
+        defineProperty(&DownloadNP);
 
         setupParams();
 
@@ -134,6 +152,8 @@ bool FLICCD::updateProperties()
         deleteProperty(CoolerNP.name);
         deleteProperty(FlushNP.name);
         deleteProperty(BackgroundFlushSP.name);
+        deleteProperty(DownloadModeSP.name);
+        deleteProperty(DownloadNP.name);
 
         if (CameraModeS != nullptr)
             deleteProperty(CameraModeSP.name);
@@ -208,6 +228,15 @@ bool FLICCD::ISNewSwitch(const char *dev, const char *name, ISState *states, cha
             return true;
         }
 
+        // Download Mode
+        if (!strcmp(name, DownloadModeSP.name))
+        {
+            IUUpdateSwitch(&DownloadModeSP, states, names, n);
+            DownloadModeSP.s = IPS_OK;
+            IDSetSwitch(&DownloadModeSP, nullptr);
+            return true;
+        }
+
         // Camera Modes
         if (!strcmp(name, CameraModeSP.name) && CameraModeS != nullptr)
         {
@@ -244,6 +273,7 @@ bool FLICCD::Connect()
     LOG_DEBUG("Attempting to find FLI CCD...");
 
     sim = isSimulation();
+    m_CanGrabFrame = true;
 
     if (sim)
     {
@@ -274,6 +304,8 @@ bool FLICCD::Disconnect()
 {
     int err;
 
+    m_DownloadWorker.quit();
+
     if (sim)
         return true;
 
@@ -509,6 +541,14 @@ bool FLICCD::StartExposure(float duration)
 {
     int err = 0;
 
+    // An aborted frame is still being read, the camera cannot take commands yet
+    if (InDownload)
+    {
+        LOG_ERROR("Previous download still in progress, try again shortly.");
+        return false;
+    }
+    m_DownloadCancelled = false;
+
     if (PrimaryCCD.getFrameType() == INDI::CCDChip::BIAS_FRAME)
     {
         // TODO check if this work with the SDK
@@ -543,6 +583,17 @@ bool FLICCD::AbortExposure()
 {
     int err = 0;
 
+    {
+        // The worker stops between two transfers and cancels the exposure itself, nothing waits for it here
+        std::lock_guard<std::mutex> lock(m_DownloadLock);
+        if (InDownload)
+        {
+            m_DownloadCancelled = true;
+            InExposure = false;
+            return true;
+        }
+    }
+
     if (!sim && (err = FLICancelExposure(fli_dev)))
     {
         LOGF_ERROR("FLICancelExposure() failed. %s.", strerror(-err));
@@ -644,47 +695,154 @@ bool FLICCD::UpdateCCDBin(int binx, int biny)
 }
 
 // Downloads the image from the CCD.
-bool FLICCD::grabImage()
+void FLICCD::grabImage(const std::atomic_bool &isAboutToQuit)
 {
     std::unique_lock<std::mutex> guard(ccdBufferLock);
-    int err        = 0;
+    long err       = 0;
     uint8_t *image = PrimaryCCD.getFrameBuffer();
     int row_size   = PrimaryCCD.getSubW() / PrimaryCCD.getBinX() * PrimaryCCD.getBPP() / 8;
-    int width      = PrimaryCCD.getSubW() / PrimaryCCD.getBinX();
     int height     = PrimaryCCD.getSubH() / PrimaryCCD.getBinY();
+    int rows       = 0;
+
+    m_DownloadTimer.start();
+    setDownloadProgress(0, height, 0, true);
 
     if (sim)
     {
         for (int i = 0; i < height; i++)
             for (int j = 0; j < row_size; j++)
                 image[i * row_size + j] = rand() % 255;
+        rows = height;
     }
     else
     {
-        bool success = true;
-        for (int i = 0; i < height; i++)
+        if (IUFindOnSwitchIndex(&DownloadModeSP) == DOWNLOAD_FRAME && m_CanGrabFrame)
         {
-            if ((err = FLIGrabRow(fli_dev, image + (i * row_size), width)))
+            err = grabFrame(isAboutToQuit, image, row_size, height, rows);
+            if (err == -EINVAL && rows == 0)
             {
-                /* print this error once but read to the end to flush the array */
-                if (success)
-                {
-                    LOGF_ERROR("FLIGrabRow() failed at row %d. %s.", i, strerror(-err));
-                    success = false;
-                }
+                LOG_INFO("FLIGrabFrame() is not supported by this libfli, downloading row by row.");
+                m_CanGrabFrame = false;
+                err = 0;
             }
         }
 
-        if (!success)
-            return false;
+        // Row transfers read on from wherever the batches stopped
+        if (err == 0 && rows < height && !downloadCancelled(isAboutToQuit))
+            err = grabRows(isAboutToQuit, image, row_size, height, rows);
+    }
+
+    // An abort is either seen here or comes after the download ended, never in between
+    std::unique_lock<std::mutex> downloadGuard(m_DownloadLock);
+    bool cancelled = downloadCancelled(isAboutToQuit);
+    if (!cancelled)
+        InDownload = false;
+    downloadGuard.unlock();
+
+    if (cancelled)
+    {
+        LOGF_INFO("Download aborted after %d of %d rows.", rows, height);
+        // Cancelling the exposure discards the rows the camera has not sent yet
+        if (!sim && rows < height && (err = FLICancelExposure(fli_dev)))
+            LOGF_ERROR("FLICancelExposure() failed. %s.", strerror(-err));
+        DownloadNP.s = IPS_IDLE;
+        IDSetNumber(&DownloadNP, nullptr);
+        InDownload = false;
+        return;
+    }
+
+    if (err)
+    {
+        DownloadNP.s = IPS_ALERT;
+        IDSetNumber(&DownloadNP, nullptr);
+        PrimaryCCD.setExposureFailed();
+        return;
     }
+
     guard.unlock();
 
-    LOG_INFO("Download complete.");
+    setDownloadProgress(rows, height, static_cast<size_t>(rows) * row_size, true);
+    DownloadNP.s = IPS_OK;
+    IDSetNumber(&DownloadNP, nullptr);
+    LOGF_INFO("Download complete (%.2f MB/s).", DownloadN[DOWNLOAD_RATE].value);
 
     ExposureComplete(&PrimaryCCD);
+}
 
-    return true;
+long FLICCD::grabFrame(const std::atomic_bool &isAboutToQuit, uint8_t *image, int row_size, int height, int &rows)
+{
+    // Whole rows only, libfli never splits a row across calls.
+    size_t chunk = std::max<size_t>(DOWNLOAD_CHUNK / row_size, 1) * row_size;
+    size_t total = static_cast<size_t>(height) * row_size;
+    size_t done  = static_cast<size_t>(rows) * row_size;
+
+    while (done < total && !downloadCancelled(isAboutToQuit))
+    {
+        size_t grabbed = 0;
+        long err = FLIGrabFrame(fli_dev, image + done, std::min(chunk, total - done), &grabbed);
+        if (err)
+        {
+            if (err != -EINVAL || done > 0)
+                LOGF_ERROR("FLIGrabFrame() failed at row %d. %s.", rows, strerror(-err));
+            return err;
+        }
+
+        if (grabbed == 0)
+        {
+            LOGF_ERROR("FLIGrabFrame() returned no data at row %d.", rows);
+            return -EIO;
+        }
+
+        done += grabbed;
+        rows = done / row_size;
+        setDownloadProgress(rows, height, done, false);
+    }
+
+    return 0;
+}
+
+long FLICCD::grabRows(const std::atomic_bool &isAboutToQuit, uint8_t *image, int row_size, int height, int &rows)
+{
+    long err   = 0;
+    long first = 0;
+    int width  = PrimaryCCD.getSubW() / PrimaryCCD.getBinX();
+
+    // Read to the end even after an error to flush the array
+    for (; rows < height && !downloadCancelled(isAboutToQuit); rows++)
+    {
+        if ((err = FLIGrabRow(fli_dev, image + (rows * row_size), width)))
+        {
+            /* print this error once */
+            if (first == 0)
+            {
+                LOGF_ERROR("FLIGrabRow() failed at row %d. %s.", rows, strerror(-err));
+                first = err;
+            }
+        }
+
+        setDownloadProgress(rows + 1, height, static_cast<size_t>(rows + 1) * row_size, false);
+    }
+
+    return first;
+}
+
+bool FLICCD::downloadCancelled(const std::atomic_bool &isAboutToQuit) const
+{
+    return isAboutToQuit || m_DownloadCancelled;
+}
+
+void FLICCD::setDownloadProgress(int rows, int height, size_t bytes, bool force)
+{
+    if (!force && m_DownloadUpdate.elapsed() < DOWNLOAD_UPDATE_MS)
+        return;
+
+    m_DownloadUpdate.start();
+
+    double seconds = m_DownloadTimer.elapsed() / 1000.0;
+    DownloadN[DOWNLOAD_PROGRESS].value = height > 0 ? 100.0 * rows / height : 0;
+    DownloadN[DOWNLOAD_RATE].value     = seconds > 0 ? bytes / seconds / 1e6 : 0;
+    DownloadNP.s = IPS_BUSY;
+    IDSetNumber(&DownloadNP, nullptr);
 }
 
 void FLICCD::TimerHit()
@@ -705,7 +863,8 @@ void FLICCD::TimerHit()
         {
             PrimaryCCD.setExposureLeft(0);
             InExposure = false;
-            grabImage();
+            InDownload = true;
+            m_DownloadWorker.start(std::bind(&FLICCD::grabImage, this, std::placeholders::_1));
         }
         else
         {
@@ -735,7 +894,8 @@ void FLICCD::TimerHit()
                 PrimaryCCD.setExposureLeft(0);
                 InExposure = false;
                 /* grab and save image */
-                grabImage();
+                InDownload = true;
+                m_DownloadWorker.start(std::bind(&FLICCD::grabImage, this, std::placeholders::_1));
             }
             else
             {
@@ -745,6 +905,13 @@ void FLICCD::TimerHit()
         }
     }
 
+    // The camera is busy sending the image, leave the cooler alone until it is done
+    if (InDownload)
+    {
+        SetTimer(getCurrentPollingPeriod());
+        return;
+    }
+
     switch (TemperatureNP.getState())
     {
         case IPS_IDLE:
@@ -917,6 +1084,7 @@ bool FLICCD::saveConfigItems(FILE *fp)
 
     IUSaveConfigNumber(fp, &FlushNP);
     IUSaveConfigSwitch(fp, &BackgroundFlushSP);
+    IUSaveConfigSwitch(fp, &DownloadModeSP);
 
     if (CameraModeS)
         IUSaveConfigSwitch(fp, &CameraModeSP);
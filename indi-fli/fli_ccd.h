@@ -25,7 +25,11 @@
 
 #include <libfli.h>
 #include <indiccd.h>
+#include <indisinglethreadpool.h>
+#include <indielapsedtimer.h>
+#include <atomic>
 #include <iostream>
+#include <mutex>
 
 using namespace std;
 
@@ -67,8 +71,15 @@ class FLICCD : public INDI::CCD
         // Calculate Time until exposure is complete
         float calcTimeLeft();
 
-        // Fetch image row by row from the CCD
-        bool grabImage();
+        // Fetch the image from the CCD, runs on the download worker
+        void grabImage(const std::atomic_bool &isAboutToQuit);
+        // Batched download through FLIGrabFrame, returns the error and rows read.
+        long grabFrame(const std::atomic_bool &isAboutToQuit, uint8_t *image, int row_size, int height, int &rows);
+        // Download through FLIGrabRow, starting at the given row.
+        long grabRows(const std::atomic_bool &isAboutToQuit, uint8_t *image, int row_size, int height, int &rows);
+        // The worker is quitting or the exposure was aborted
+        bool downloadCancelled(const std::atomic_bool &isAboutToQuit) const;
+        void setDownloadProgress(int rows, int height, size_t bytes, bool force);
 
         // Get initial CCD values upon connection
         bool setupParams();
@@ -107,6 +118,22 @@ class FLICCD : public INDI::CCD
         ISwitch *CameraModeS = nullptr;
         ISwitchVectorProperty CameraModeSP;
 
+        ISwitch DownloadModeS[2];
+        ISwitchVectorProperty DownloadModeSP;
+        enum
+        {
+            DOWNLOAD_FRAME,
+            DOWNLOAD_ROWS
+        };
+
+        INumber DownloadN[2];
+        INumberVectorProperty DownloadNP;
+        enum
+        {
+            DOWNLOAD_PROGRESS,
+            DOWNLOAD_RATE
+        };
+
         int timerID = 0;
 
         // Exposure timing
@@ -116,6 +143,18 @@ class FLICCD : public INDI::CCD
         flidev_t fli_dev;
         cam_t FLICam;
 
+        // Image download, off the main thread so a large frame does not stall the driver
+        INDI::SingleThreadPool m_DownloadWorker;
+        std::atomic_bool InDownload {false};
+        // Set by AbortExposure during a download, the worker then cancels the exposure and drops the frame
+        std::atomic_bool m_DownloadCancelled {false};
+        // Orders the end of a download against an abort
+        std::mutex m_DownloadLock;
+        INDI::ElapsedTimer m_DownloadTimer;
+        INDI::ElapsedTimer m_DownloadUpdate;
+        // Cleared when libfli does not implement FLIGrabFrame
+        bool m_CanGrabFrame {true};
+
         // Simulation mode
         bool sim = false;
 };
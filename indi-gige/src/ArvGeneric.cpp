@@ -18,8 +18,12 @@
  */
 #include "ArvGeneric.h"
 
+#include <string.h>
+
 using namespace arv;
 
+#define STREAM_POP_TIMEOUT_US (100000) /* Lets the stream thread notice stream_stop() */
+
 const char *ArvGeneric::_str_val(const char *s)
 {
     return (s ? s : "None");
@@ -62,7 +66,7 @@ min_max_property<int> ArvGeneric::get_height()
 }
 min_max_property<int> ArvGeneric::get_bpp()
 {
-    return min_max_property<int>(16, 16, 16);
+    return min_max_property<int>(this->cam.bpp);
 }
 min_max_property<double> ArvGeneric::get_pixel_pitch()
 {
@@ -87,6 +91,7 @@ bool ArvGeneric::_get_bounds(void (*fn_arv_bounds)(::ArvCamera *, T *min, T *max
     T min, max;
     fn_arv_bounds(this->camera, &min, &max, &(this->error));
     prop->update(min, max);
+    return true;
 }
 
 bool ArvGeneric::is_exposing()
@@ -101,6 +106,10 @@ bool ArvGeneric::_stream_active()
 {
     return this->stream_active;
 }
+bool ArvGeneric::is_streaming()
+{
+    return this->streaming;
+}
 
 ArvGeneric::ArvGeneric(void *camera_device) : ArvCamera(camera_device)
 {
@@ -136,7 +145,8 @@ bool ArvGeneric::connect()
         this->cam.vendor_name = arv_camera_get_vendor_name(this->camera, &(this->error));
         this->cam.device_id   = arv_camera_get_device_id(this->camera, &(this->error));
     }
-    return true;
+    /* Only read the bounds, the camera settings are left alone */
+    return this->_get_initial_config();
 }
 
 bool ArvGeneric::_configure(void)
@@ -147,10 +157,15 @@ bool ArvGeneric::_configure(void)
 
 void ArvGeneric::_init()
 {
-    this->camera        = nullptr;
-    this->buffer        = nullptr;
-    this->stream        = nullptr;
-    this->stream_active = false;
+    this->camera         = nullptr;
+    this->error          = nullptr;
+    this->buffer         = nullptr;
+    this->stream         = nullptr;
+    this->stream_active  = false;
+    this->buffer_queued  = false;
+    this->stream_payload = 0;
+    this->streaming      = false;
+    memset(&this->stream_statistics, 0, sizeof(this->stream_statistics));
 
     /* Don't clear device_id, its needed to re-attach with connect() */
 }
@@ -159,10 +174,14 @@ bool ArvGeneric::disconnect()
 {
     if (this->is_connected())
     {
+        this->stream_stop();
         this->_test_exposure_and_abort();
+        this->_stream_destroy();
         g_clear_object(&this->camera);
+        g_clear_error(&this->error);
     }
     this->_init();
+    return true;
 }
 
 bool ArvGeneric::_set_initial_config()
@@ -195,6 +214,10 @@ bool ArvGeneric::_get_initial_config()
     this->cam.model_name  = arv_camera_get_model_name(camera, &error);
     this->cam.device_id   = arv_camera_get_device_id(camera, &error);
 
+    /* The pixel format is the camera's own, 8-bit formats are reported as such */
+    ::ArvPixelFormat const format = arv_camera_get_pixel_format(camera, &error);
+    this->cam.bpp.set_single((format != 0 && ARV_PIXEL_FORMAT_BIT_PER_PIXEL(format) <= 8) ? 8 : 16);
+
     /* No GVCP call for this..., specialize if necessary */
     this->cam.pixel_pitch.set_single(1.0);
 
@@ -264,32 +287,28 @@ void ArvGeneric::set_exposure_time(double const val)
     this->_set_cam_exposure_property(arv_camera_set_exposure_time, &this->cam.exposure, val);
 }
 
-::ArvBuffer *ArvGeneric::_buffer_create(void)
-{
-    ::ArvBuffer *buffer;
-
-    /* Ensure no buffers in stream */
-    while (1)
-    {
-        buffer = arv_stream_try_pop_buffer(this->stream);
-        if (buffer)
-            g_clear_object(&buffer);
-        else
-            break;
-    }
-
-    gint const payload = arv_camera_get_payload(this->camera, &(this->error));
-    buffer             = arv_buffer_new(payload, nullptr);
-    arv_stream_push_buffer(this->stream, buffer);
-    return buffer;
-}
-
 ::ArvStream *ArvGeneric::_stream_create(void)
 {
     ::ArvStream *stream = arv_camera_create_stream(this->camera, nullptr, nullptr, &(this->error));
     return stream;
 }
 
+void ArvGeneric::_stream_destroy(void)
+{
+    /* Queued buffers belong to the stream, a popped exposure buffer is ours */
+    if (this->buffer && !this->buffer_queued)
+        g_clear_object(&this->buffer);
+    this->buffer        = nullptr;
+    this->buffer_queued = false;
+
+    if (this->stream)
+    {
+        this->stream_statistics = this->get_stream_statistics();
+        g_clear_object(&this->stream);
+    }
+    this->stream_payload = 0;
+}
+
 void ArvGeneric::_stream_start()
 {
     this->stream_active = true;
@@ -301,9 +320,8 @@ void ArvGeneric::_stream_start()
 
 void ArvGeneric::_stream_stop()
 {
-    /* stop the acquisition stream */
+    /* stop the acquisition, the stream and its buffer are kept for the next exposure */
     arv_camera_stop_acquisition(this->camera, &(this->error));
-    g_object_unref(this->stream);
 
     this->stream_active = false;
 }
@@ -317,8 +335,26 @@ void ArvGeneric::_trigger_exposure()
 void ArvGeneric::exposure_start(void)
 {
     this->_test_exposure_and_abort();
-    this->stream = this->_stream_create();
-    this->buffer = this->_buffer_create();
+
+    /* Reuse the stream and its buffer as long as the frame size is unchanged */
+    gint const payload = arv_camera_get_payload(this->camera, &(this->error));
+    if (this->stream && payload != this->stream_payload)
+        this->_stream_destroy();
+
+    if (!this->stream)
+    {
+        this->stream = this->_stream_create();
+        if (!this->stream)
+            return;
+        this->buffer         = arv_buffer_new(payload, nullptr);
+        this->stream_payload = payload;
+    }
+
+    if (!this->buffer_queued)
+    {
+        arv_stream_push_buffer(this->stream, this->buffer);
+        this->buffer_queued = true;
+    }
 
     this->_stream_start();
     this->_trigger_exposure();
@@ -330,25 +366,18 @@ void ArvGeneric::exposure_abort(void)
     {
         arv_camera_abort_acquisition(this->camera, &(this->error));
         this->_stream_stop();
+        /* The buffer may still be filling, start over with a new stream */
+        this->_stream_destroy();
     }
 }
 
 void ArvGeneric::_get_image(void (*fn_image_callback)(void *const, uint8_t const *const, size_t), void *const usr_ptr)
 {
-    ArvBuffer *const popped_buf = arv_stream_timeout_pop_buffer(this->stream, 100000);
-    if ((popped_buf != nullptr) && (popped_buf == this->buffer) &&
-        arv_buffer_get_status(this->buffer) == ARV_BUFFER_STATUS_SUCCESS)
+    if (fn_image_callback != nullptr)
     {
-        if (fn_image_callback != nullptr)
-        {
-            size_t size;
-            uint8_t const *const data = (uint8_t const *const)arv_buffer_get_data(this->buffer, &size);
-            fn_image_callback(usr_ptr, data, size);
-        }
-    }
-    else
-    {
-        //TODO: failure...
+        size_t size;
+        uint8_t const *const data = (uint8_t const *const)arv_buffer_get_data(this->buffer, &size);
+        fn_image_callback(usr_ptr, data, size);
     }
 }
 
@@ -358,15 +387,19 @@ ARV_EXPOSURE_STATUS ArvGeneric::exposure_poll(void (*fn_image_callback)(void *co
     if (!this->_stream_active())
         return ARV_EXPOSURE_UNKNOWN;
 
-    ::ArvBufferStatus const status = arv_buffer_get_status(this->buffer);
-    switch (status)
+    /* The buffer is reused, so its status is only meaningful once the stream hands it back */
+    ::ArvBuffer *const popped_buf = arv_stream_try_pop_buffer(this->stream);
+    if (popped_buf == nullptr)
     {
-        case ARV_BUFFER_STATUS_CLEARED:
-            return ARV_EXPOSURE_BUSY;
-        case ARV_BUFFER_STATUS_FILLING:
+        if (arv_buffer_get_status(this->buffer) == ARV_BUFFER_STATUS_FILLING)
             return ARV_EXPOSURE_FILLING;
-        case ARV_BUFFER_STATUS_UNKNOWN:
-            return ARV_EXPOSURE_UNKNOWN;
+        return ARV_EXPOSURE_BUSY;
+    }
+    this->buffer_queued = false;
+
+    ::ArvBufferStatus const status = arv_buffer_get_status(popped_buf);
+    switch (status)
+    {
         case ARV_BUFFER_STATUS_SUCCESS:
             this->_get_image(fn_image_callback, usr_ptr);
             this->_stream_stop();
@@ -376,9 +409,122 @@ ARV_EXPOSURE_STATUS ArvGeneric::exposure_poll(void (*fn_image_callback)(void *co
         case ARV_BUFFER_STATUS_WRONG_PACKET_ID:
         case ARV_BUFFER_STATUS_SIZE_MISMATCH:
         case ARV_BUFFER_STATUS_ABORTED:
+        default:
             this->_stream_stop();
             return ARV_EXPOSURE_FAILED;
-        default:
-            return ARV_EXPOSURE_UNKNOWN;
     }
 }
+
+void ArvGeneric::set_frame_rate(double const val)
+{
+    GError *rate_error = nullptr;
+    this->cam.frame_rate.set(val);
+    arv_camera_set_frame_rate(this->camera, this->cam.frame_rate.val(), &rate_error);
+    g_clear_error(&rate_error);
+}
+
+bool ArvGeneric::stream_start(int const n_buffers, void (*fn_frame_callback)(void *const, uint8_t const *const, size_t),
+                              void *const usr_ptr)
+{
+    this->stream_stop();
+    this->_test_exposure_and_abort();
+
+    /* Single frame exposures use a stream with one buffer, continuous acquisition needs its own pool */
+    this->_stream_destroy();
+
+    GError *stream_error = nullptr;
+    arv_camera_clear_triggers(this->camera, &stream_error);
+    g_clear_error(&stream_error);
+    arv_camera_set_acquisition_mode(this->camera, ARV_ACQUISITION_MODE_CONTINUOUS, &stream_error);
+    if (stream_error)
+    {
+        g_clear_error(&stream_error);
+        return false;
+    }
+
+    this->stream = this->_stream_create();
+    if (!this->stream)
+        return false;
+
+    /* Pre-queue the whole pool so the receive thread never waits for a buffer */
+    gint const payload = arv_camera_get_payload(this->camera, &stream_error);
+    g_clear_error(&stream_error);
+    for (int i = 0; i < n_buffers; i++)
+        arv_stream_push_buffer(this->stream, arv_buffer_new(payload, nullptr));
+    this->stream_payload = payload;
+
+    arv_camera_start_acquisition(this->camera, &stream_error);
+    if (stream_error)
+    {
+        g_clear_error(&stream_error);
+        this->_stream_destroy();
+        return false;
+    }
+
+    this->streaming     = true;
+    this->stream_thread = std::thread(&ArvGeneric::_stream_loop, this, fn_frame_callback, usr_ptr);
+    return true;
+}
+
+void ArvGeneric::stream_stop(void)
+{
+    if (!this->streaming)
+        return;
+
+    this->streaming = false;
+    if (this->stream_thread.joinable())
+        this->stream_thread.join();
+
+    GError *stream_error = nullptr;
+    arv_camera_stop_acquisition(this->camera, &stream_error);
+    g_clear_error(&stream_error);
+    this->_stream_destroy();
+
+    /* Back to software triggered single frames */
+    arv_camera_set_trigger(this->camera, "Software", &stream_error);
+    g_clear_error(&stream_error);
+}
+
+void ArvGeneric::_stream_loop(void (*fn_frame_callback)(void *const, uint8_t const *const, size_t),
+                              void *const usr_ptr)
+{
+    while (this->streaming)
+    {
+        ::ArvBuffer *const popped_buf = arv_stream_timeout_pop_buffer(this->stream, STREAM_POP_TIMEOUT_US);
+        if (popped_buf == nullptr)
+            continue;
+
+        /* Incomplete frames are counted by the stream statistics and skipped */
+        if (arv_buffer_get_status(popped_buf) == ARV_BUFFER_STATUS_SUCCESS && fn_frame_callback != nullptr)
+        {
+            size_t size;
+            uint8_t const *const data = (uint8_t const *const)arv_buffer_get_data(popped_buf, &size);
+            fn_frame_callback(usr_ptr, data, size);
+        }
+
+        arv_stream_push_buffer(this->stream, popped_buf);
+    }
+}
+
+ARV_STREAM_STATISTICS ArvGeneric::get_stream_statistics(void)
+{
+    if (!this->stream)
+        return this->stream_statistics;
+
+    ARV_STREAM_STATISTICS stats;
+    memset(&stats, 0, sizeof(stats));
+    guint64 completed, failures, underruns;
+    arv_stream_get_statistics(this->stream, &completed, &failures, &underruns);
+    stats.completed_buffers = completed;
+    stats.failures          = failures;
+    stats.underruns         = underruns;
+
+    if (ARV_IS_GV_STREAM(this->stream))
+    {
+        guint64 resent, missing;
+        arv_gv_stream_get_statistics(ARV_GV_STREAM(this->stream), &resent, &missing);
+        stats.missing_packets = missing;
+        stats.resent_packets  = resent;
+    }
+    return stats;
+}
@@ -25,6 +25,9 @@
 #include <arv.h>
 //}
 
+#include <atomic>
+#include <thread>
+
 #include "ArvInterface.h"
 
 using namespace arv;
@@ -66,9 +69,16 @@ class ArvGeneric : public arv::ArvCamera
     ARV_EXPOSURE_STATUS exposure_poll(void (*fn_image_callback)(void *const, uint8_t const *const, size_t),
                                       void *const usr_ptr);
 
+    bool stream_start(int const n_buffers, void (*fn_frame_callback)(void *const, uint8_t const *const, size_t),
+                      void *const usr_ptr);
+    void stream_stop(void);
+    bool is_streaming();
+    void set_frame_rate(double const val);
+    ARV_STREAM_STATISTICS get_stream_statistics(void);
+
   protected:
     void _init(void);
-    bool _configure(void);
+    virtual bool _configure(void);
     void _test_exposure_and_abort(void);
     template <typename T>
     bool _get_bounds(void (*fn_arv_bounds)(::ArvCamera *, T *min, T *max, GError**), min_max_property<T> *prop);
@@ -89,13 +99,21 @@ class ArvGeneric : public arv::ArvCamera
 
     /* streaming, capturing functions */
     ::ArvStream *_stream_create(void);
-    ::ArvBuffer *_buffer_create(void);
+    void _stream_destroy(void);
     bool _stream_active();
     void _stream_start();
     void _stream_stop();
     void _trigger_exposure();
+    void _stream_loop(void (*fn_frame_callback)(void *const, uint8_t const *const, size_t), void *const usr_ptr);
 
     bool stream_active;
+    bool buffer_queued;
+    gint stream_payload;
+
+    /* continuous acquisition state */
+    std::thread stream_thread;
+    std::atomic<bool> streaming;
+    ARV_STREAM_STATISTICS stream_statistics;
 
     /* Camera properties */
     struct
@@ -106,6 +124,7 @@ class ArvGeneric : public arv::ArvCamera
         min_max_property<gint> y_offset;
         min_max_property<gint> width;
         min_max_property<gint> height;
+        min_max_property<gint> bpp;
 
         min_max_property<double> pixel_pitch;
 
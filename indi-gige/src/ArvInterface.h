@@ -33,6 +33,14 @@ typedef enum {
 
 } ARV_EXPOSURE_STATUS;
 
+typedef struct {
+    uint64_t completed_buffers; //!< Frames received complete
+    uint64_t failures;          //!< Frames received incomplete or with errors
+    uint64_t underruns;         //!< Frames lost because no buffer was queued
+    uint64_t missing_packets;   //!< Packets never received, GigE Vision only
+    uint64_t resent_packets;    //!< Packets recovered through resend requests, GigE Vision only
+} ARV_STREAM_STATISTICS;
+
 template <class T>
 class min_max_property
 {
@@ -109,6 +117,14 @@ class ArvCamera
     virtual void exposure_abort(void)                      = 0;
     virtual ARV_EXPOSURE_STATUS exposure_poll(void (*fn_image_callback)(void *const, uint8_t const *const, size_t),
                                               void *const) = 0;
+
+    /* Continuous acquisition, frames are passed to the callback on a dedicated thread */
+    virtual bool stream_start(int const n_buffers, void (*fn_frame_callback)(void *const, uint8_t const *const, size_t),
+                              void *const usr_ptr)            = 0;
+    virtual void stream_stop(void)                            = 0;
+    virtual bool is_streaming()                               = 0;
+    virtual void set_frame_rate(double const val)             = 0;
+    virtual ARV_STREAM_STATISTICS get_stream_statistics(void) = 0;
 };
 
 class ArvFactory
@@ -115,6 +115,15 @@ void BlackFly::exposure_start(void)
     ArvGeneric::exposure_start();
 }
 
+bool BlackFly::stream_start(int const n_buffers, void (*fn_frame_callback)(void *const, uint8_t const *const, size_t),
+                            void *const usr_ptr)
+{
+    printf("%s\n", __PRETTY_FUNCTION__);
+    /* Same endianness reset as for exposures */
+    this->_fixup();
+    return ArvGeneric::stream_start(n_buffers, fn_frame_callback, usr_ptr);
+}
+
 bool BlackFly::_configure(void)
 {
     printf("%s\n", __PRETTY_FUNCTION__);
@@ -25,6 +25,7 @@
 
 #include "indidevapi.h"
 #include "eventloop.h"
+#include <stream/streammanager.h>
 
 #include "indi_gige.h"
 
@@ -43,7 +44,11 @@
 #define TIMER_US_TO_MS (1000)
 #define TIMER_US_TO_S  (1000000)
 #define TIMER_TICK_MS  (100)
-#define CAPS           (CCD_CAN_ABORT | CCD_CAN_BIN | CCD_CAN_SUBFRAME)
+#define CAPS           (CCD_CAN_ABORT | CCD_CAN_BIN | CCD_CAN_SUBFRAME | CCD_HAS_STREAMING)
+
+#define STREAM_BUFFERS_DEFAULT  (8)
+#define STREAM_STATISTICS_TICKS (10) /* Refresh stream statistics once per second while streaming */
+#define STREAMING_TAB           "Streaming"
 
 static class Loader
 {
@@ -64,7 +69,9 @@ const char *GigECCD::getDefaultName()
 
 GigECCD::GigECCD(arv::ArvCamera *camera)
 {
-    this->camera = camera;
+    this->camera                  = camera;
+    this->stream_statistics_ticks = 0;
+    this->stream_frame_size       = 0;
     snprintf(this->name, sizeof(this->name), "GigE CCD%s", this->camera->model_name());
     setDeviceName(this->name);
 }
@@ -77,6 +84,19 @@ bool GigECCD::initProperties()
 {
     INDI::CCD::initProperties();
     this->SetCCDCapability((CAPS));
+
+    IUFillNumber(&this->indiprop_stream_buffers[0], "COUNT", "Buffers", "%.f", 2, 64, 1, STREAM_BUFFERS_DEFAULT);
+    IUFillNumberVector(&this->indiprop_stream_buffers_prop, this->indiprop_stream_buffers, 1, getDeviceName(),
+                       "STREAM_BUFFERS", "Stream Buffers", STREAMING_TAB, IP_RW, 60, IPS_IDLE);
+
+    IUFillNumber(&this->indiprop_stream_stats[0], "COMPLETED", "Completed frames", "%.f", 0, 1e12, 0, 0);
+    IUFillNumber(&this->indiprop_stream_stats[1], "FAILURES", "Failed frames", "%.f", 0, 1e12, 0, 0);
+    IUFillNumber(&this->indiprop_stream_stats[2], "UNDERRUNS", "Underruns", "%.f", 0, 1e12, 0, 0);
+    IUFillNumber(&this->indiprop_stream_stats[3], "MISSING_PACKETS", "Missing packets", "%.f", 0, 1e12, 0, 0);
+    IUFillNumber(&this->indiprop_stream_stats[4], "RESENT_PACKETS", "Resent packets", "%.f", 0, 1e12, 0, 0);
+    IUFillNumberVector(&this->indiprop_stream_stats_prop, this->indiprop_stream_stats, 5, getDeviceName(),
+                       "STREAM_STATISTICS", "Stream Statistics", STREAMING_TAB, IP_RO, 60, IPS_IDLE);
+
     this->addConfigurationControl();
     this->addDebugControl();
     return true;
@@ -103,11 +123,13 @@ bool GigECCD::_update_geometry(void)
         LOGF_ERROR("Unexpected INDI image buffer size, has %i bytes, camera has %i", indi_bufsize,
                frame_byte_size);
         PrimaryCCD.setFrameBufferSize(0);
+        return false;
     }
     else
     {
         LOGF_INFO("Reserving INDI image buffer size %i bytes", indi_bufsize);
         PrimaryCCD.setFrameBufferSize(frame_byte_size);
+        return true;
     }
 }
 
@@ -127,12 +149,16 @@ void GigECCD::_update_indi_properties(void)
 
     defineProperty(&indiprop_info_prop);
     defineProperty(&this->indiprop_gain_prop);
+    defineProperty(&this->indiprop_stream_buffers_prop);
+    defineProperty(&this->indiprop_stream_stats_prop);
 }
 
 void GigECCD::_delete_indi_properties(void)
 {
     this->deleteProperty(this->indiprop_gain_prop.name);
     this->deleteProperty(this->indiprop_info_prop.name);
+    this->deleteProperty(this->indiprop_stream_buffers_prop.name);
+    this->deleteProperty(this->indiprop_stream_stats_prop.name);
 }
 
 //Initial call
@@ -168,6 +194,7 @@ bool GigECCD::Connect()
 bool GigECCD::Disconnect()
 {
     LOGF_INFO("%s", __PRETTY_FUNCTION__);
+    camera->stream_stop();
 #if 0
     //TODO: re-iterate and acquire proper camera from AvrFactory (based on ID?)
     return camera->disconnect();
@@ -178,6 +205,12 @@ bool GigECCD::Disconnect()
 bool GigECCD::StartExposure(float duration)
 {
     LOGF_INFO("%s exposure_time=%.4f", __PRETTY_FUNCTION__, duration);
+    if (camera->is_streaming())
+    {
+        LOG_ERROR("Cannot start an exposure while streaming.");
+        return false;
+    }
+
     /* Driver will clamp to lowest possible exposure */
     if (PrimaryCCD.getFrameType() == INDI::CCDChip::BIAS_FRAME)
         duration = 0;
@@ -198,6 +231,65 @@ bool GigECCD::AbortExposure()
     return true;
 }
 
+bool GigECCD::StartStreaming()
+{
+    /* The exposure is left as the user set it, a longer one lowers the rate the camera reaches */
+    double const fps = Streamer->getTargetFPS();
+    camera->set_frame_rate(fps);
+
+    int const bpp    = camera->get_bpp().val();
+    int const width  = camera->get_width().val();
+    int const height = camera->get_height().val();
+    Streamer->setPixelFormat(INDI_MONO, bpp);
+    Streamer->setSize(width, height);
+    this->stream_frame_size = (size_t)width * height * bpp / 8;
+
+    int const n_buffers = (int)this->indiprop_stream_buffers[0].value;
+    if (!camera->stream_start(n_buffers, this->_receive_frame_hook, this))
+    {
+        LOG_ERROR("Failed to start continuous acquisition.");
+        return false;
+    }
+
+    LOGF_INFO("Streaming at %.1f fps with %d buffers", fps, n_buffers);
+    this->stream_statistics_ticks = 0;
+    return true;
+}
+
+bool GigECCD::StopStreaming()
+{
+    camera->stream_stop();
+    this->_update_stream_statistics();
+    return true;
+}
+
+void GigECCD::_update_frame(uint8_t const *const data, size_t size)
+{
+    /* Frame changes restart the stream, so the size set in StartStreaming holds */
+    if (size < this->stream_frame_size)
+        return;
+
+    Streamer->newFrame(data, this->stream_frame_size);
+}
+
+void GigECCD::_receive_frame_hook(void *const class_ptr, uint8_t const *const data, size_t size)
+{
+    GigECCD *const cls = static_cast<GigECCD *const>(class_ptr);
+    cls->_update_frame(data, size);
+}
+
+void GigECCD::_update_stream_statistics(void)
+{
+    arv::ARV_STREAM_STATISTICS const stats = camera->get_stream_statistics();
+    this->indiprop_stream_stats[0].value   = stats.completed_buffers;
+    this->indiprop_stream_stats[1].value   = stats.failures;
+    this->indiprop_stream_stats[2].value   = stats.underruns;
+    this->indiprop_stream_stats[3].value   = stats.missing_packets;
+    this->indiprop_stream_stats[4].value   = stats.resent_packets;
+    this->indiprop_stream_stats_prop.s     = (stats.failures || stats.missing_packets) ? IPS_ALERT : IPS_OK;
+    IDSetNumber(&this->indiprop_stream_stats_prop, nullptr);
+}
+
 void GigECCD::_update_image(uint8_t const *const data, size_t size)
 {
     LOGF_INFO("Receiving %i bytes image", size);
@@ -263,7 +355,16 @@ void GigECCD::_handle_timeout(struct timeval *const tv, uint32_t timeout_us)
 void GigECCD::TimerHit()
 {
     this->timer_id = this->SetTimer(TIMER_TICK_MS);
-    if (!this->camera->is_connected() || !this->camera->is_exposing())
+    if (!this->camera->is_connected())
+        return;
+
+    if (this->camera->is_streaming() && ++this->stream_statistics_ticks >= STREAM_STATISTICS_TICKS)
+    {
+        this->stream_statistics_ticks = 0;
+        this->_update_stream_statistics();
+    }
+
+    if (!this->camera->is_exposing())
         return;
 
     arv::ARV_EXPOSURE_STATUS const status = camera->exposure_poll(this->_receive_image_hook, this);
@@ -271,9 +372,11 @@ void GigECCD::TimerHit()
     {
         case arv::ARV_EXPOSURE_FINISHED:
             /* Nothing to do, ArvCamera automatically unsets is_exposing */
+            this->_update_stream_statistics();
             break;
         case arv::ARV_EXPOSURE_UNKNOWN:
         case arv::ARV_EXPOSURE_FAILED:
+            this->_update_stream_statistics();
             this->_handle_failed();
             break;
         case arv::ARV_EXPOSURE_FILLING:
@@ -302,6 +405,15 @@ bool GigECCD::ISNewNumber(const char *dev, const char *name, double values[], ch
             IDSetNumber(&this->indiprop_gain_prop, nullptr);
             return true;
         }
+
+        if (!strcmp(name, this->indiprop_stream_buffers_prop.name))
+        {
+            /* Takes effect the next time streaming starts */
+            IUUpdateNumber(&this->indiprop_stream_buffers_prop, values, names, n);
+            this->indiprop_stream_buffers_prop.s = IPS_OK;
+            IDSetNumber(&this->indiprop_stream_buffers_prop, nullptr);
+            return true;
+        }
     }
 
     return INDI::CCD::ISNewNumber(dev, name, values, names, n);
@@ -311,8 +423,17 @@ bool GigECCD::UpdateCCDFrame(int x, int y, int w, int h)
 {
     LOGF_INFO("%s x=%i y=%i w=%i h=%i", __PRETTY_FUNCTION__, x, y, w, h);
 
+    /* The stream buffers are sized for the frame, so restart streaming around the change */
+    bool const was_streaming = this->camera->is_streaming();
+    if (was_streaming)
+        this->camera->stream_stop();
+
     this->camera->set_geometry(x, y, w, h);
-    return this->_update_geometry();
+    bool const ret = this->_update_geometry();
+
+    if (was_streaming)
+        this->StartStreaming();
+    return ret;
 }
 
 bool GigECCD::UpdateCCDBin(int binx, int biny)
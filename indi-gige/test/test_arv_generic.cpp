@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "ArvGeneric.h"
+
+/* Device id of the camera on Aravis' "Fake" interface */
+#define FAKE_DEVICE_ID "Fake_1"
+
+namespace
+{
+
+class FakeGeneric : public ArvGeneric
+{
+  public:
+    explicit FakeGeneric(::ArvCamera *camera) : ArvGeneric(camera) {}
+    ::ArvCamera *arv_camera() { return this->camera; }
+};
+
+struct Received
+{
+    std::atomic<int> frames { 0 };
+    std::atomic<size_t> size { 0 };
+};
+
+void on_data(void *const usr, uint8_t const *const data, size_t size)
+{
+    Received *const received = static_cast<Received *>(usr);
+    if (data != nullptr)
+        received->size = size;
+    received->frames++;
+}
+
+class ArvGenericFake : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        arv_enable_interface("Fake");
+        arv_update_device_list();
+
+        ::ArvCamera *const arv = arv_camera_new(FAKE_DEVICE_ID, nullptr);
+        ASSERT_NE(arv, nullptr);
+        camera = new FakeGeneric(arv);
+    }
+
+    void TearDown() override
+    {
+        delete camera;
+    }
+
+    /* Polls like GigECCD::TimerHit until the exposure is no longer in progress */
+    arv::ARV_EXPOSURE_STATUS expose(double exposure_us, Received *received)
+    {
+        camera->set_exposure_time(exposure_us);
+        camera->exposure_start();
+
+        auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        arv::ARV_EXPOSURE_STATUS status = arv::ARV_EXPOSURE_BUSY;
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            status = camera->exposure_poll(on_data, received);
+            if (status != arv::ARV_EXPOSURE_BUSY && status != arv::ARV_EXPOSURE_FILLING)
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return status;
+    }
+
+    FakeGeneric *camera { nullptr };
+};
+
+}
+
+TEST_F(ArvGenericFake, ConnectLeavesPixelFormat)
+{
+    ::ArvPixelFormat const format = arv_camera_get_pixel_format(camera->arv_camera(), nullptr);
+
+    ASSERT_TRUE(camera->connect());
+    EXPECT_EQ(arv_camera_get_pixel_format(camera->arv_camera(), nullptr), format);
+
+    int const bpp = (ARV_PIXEL_FORMAT_BIT_PER_PIXEL(format) <= 8) ? 8 : 16;
+    EXPECT_EQ(camera->get_bpp().val(), bpp);
+    EXPECT_GT(camera->get_width().max(), 0);
+    EXPECT_GT(camera->get_height().max(), 0);
+}
+
+TEST_F(ArvGenericFake, SingleExposuresReuseTheStream)
+{
+    ASSERT_TRUE(camera->connect());
+    camera->update_geometry();
+
+    for (int i = 0; i < 3; i++)
+    {
+        Received received;
+        ASSERT_EQ(expose(10000, &received), arv::ARV_EXPOSURE_FINISHED) << "exposure " << i;
+        EXPECT_EQ(received.frames, 1);
+        EXPECT_EQ(received.size, (size_t)camera->get_frame_byte_size());
+        EXPECT_FALSE(camera->is_exposing());
+    }
+}
+
+TEST_F(ArvGenericFake, StreamDeliversFramesAndKeepsExposure)
+{
+    ASSERT_TRUE(camera->connect());
+    camera->update_geometry();
+    camera->set_exposure_time(20000);
+    camera->set_frame_rate(20);
+
+    Received received;
+    ASSERT_TRUE(camera->stream_start(4, on_data, &received));
+    EXPECT_TRUE(camera->is_streaming());
+
+    auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (received.frames < 5 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    camera->stream_stop();
+    EXPECT_FALSE(camera->is_streaming());
+    EXPECT_GE(received.frames, 5);
+    EXPECT_EQ(received.size, (size_t)camera->get_frame_byte_size());
+    EXPECT_NEAR(arv_camera_get_exposure_time(camera->arv_camera(), nullptr), 20000, 1);
+
+    /* Statistics outlive the stream */
+    arv::ARV_STREAM_STATISTICS const stats = camera->get_stream_statistics();
+    EXPECT_GE(stats.completed_buffers, 5u);
+
+    /* Single frames work again once streaming stopped */
+    Received single;
+    EXPECT_EQ(expose(10000, &single), arv::ARV_EXPOSURE_FINISHED);
+    EXPECT_EQ(single.frames, 1);
+}
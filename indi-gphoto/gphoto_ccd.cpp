@@ -25,8 +25,10 @@
 #include "config.h"
 #include "gphoto_driver.h"
 #include "gphoto_readimage.h"
+#include "jpegdecode.h"
 
 #include <algorithm>
+#include <chrono>
 #include <stream/streammanager.h>
 
 #include <sharedblob.h>
@@ -244,6 +246,7 @@ GPhotoCCD::GPhotoCCD(const char * model, const char * port) : FI(this)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 GPhotoCCD::~GPhotoCCD()
 {
+    stopDecode();
     free(on_off[0]);
     free(on_off[1]);
     expTID = 0;
@@ -316,11 +319,23 @@ bool GPhotoCCD::initProperties()
     DownloadTimeoutNP.fill(getDeviceName(), "CCD_DOWNLOAD_TIMEOUT", "Download Timeout", OPTIONS_TAB, IP_RW, 60, IPS_IDLE);
     DownloadTimeoutNP.load();
 
+    // Live View Width, the preview is scaled down by 2, 4 or 8 while it stays at least this wide
+    LiveViewWidthNP[0].fill("WIDTH", "Min width (0 full)", "%.f", 0, 8192, 64, 0);
+    LiveViewWidthNP.fill(getDeviceName(), "CCD_LIVE_VIEW_WIDTH", "Live View", OPTIONS_TAB, IP_RW, 60, IPS_IDLE);
+    LiveViewWidthNP.load();
+    m_LiveViewWidth = LiveViewWidthNP[0].getValue();
+
     // Nikon should have force bulb off by default.
     ForceBULBSP[INDI_ENABLED].fill("On", "On", isNikon ? ISS_OFF : ISS_ON);
     ForceBULBSP[INDI_DISABLED].fill("Off", "Off", isNikon ? ISS_ON : ISS_OFF);
     ForceBULBSP.fill(getDeviceName(), "CCD_FORCE_BLOB", "Force BULB", OPTIONS_TAB, IP_RW, ISR_1OFMANY, 0, IPS_IDLE);
 
+    // Memory Capture
+    MemoryCaptureSP[INDI_ENABLED].fill("On", "On", ISS_ON);
+    MemoryCaptureSP[INDI_DISABLED].fill("Off", "Off", ISS_OFF);
+    MemoryCaptureSP.fill(getDeviceName(), "CCD_MEMORY_CAPTURE", "Memory Capture", OPTIONS_TAB, IP_RW, ISR_1OFMANY, 0,
+                         IPS_IDLE);
+
     // Upload File
     UploadFileTP[0].fill("PATH", "Path", nullptr);
     UploadFileTP.fill(getDeviceName(), "CCD_UPLOAD_FILE", "Upload File", OPTIONS_TAB, IP_RW, 0, IPS_IDLE);
@@ -444,7 +459,9 @@ bool GPhotoCCD::updateProperties()
         }
 
         defineProperty(ForceBULBSP);
+        defineProperty(MemoryCaptureSP);
         defineProperty(DownloadTimeoutNP);
+        defineProperty(LiveViewWidthNP);
     }
     else
     {
@@ -470,7 +487,9 @@ bool GPhotoCCD::updateProperties()
         deleteProperty(SDCardImageSP);
 
         deleteProperty(ForceBULBSP);
+        deleteProperty(MemoryCaptureSP);
         deleteProperty(DownloadTimeoutNP);
+        deleteProperty(LiveViewWidthNP);
 
         HideExtendedOptions();
     }
@@ -612,6 +631,27 @@ bool GPhotoCCD::ISNewSwitch(const char * dev, const char * name, ISState * state
             return true;
         }
 
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        // Memory Capture
+        // Keep FITS/XISF captures in memory and decode them in the background instead of going
+        // through a temporary file.
+        ///////////////////////////////////////////////////////////////////////////////////////////////
+        if (MemoryCaptureSP.isNameMatch(name))
+        {
+            if (!MemoryCaptureSP.update(states, names, n))
+                return false;
+
+            MemoryCaptureSP.setState(IPS_OK);
+            if (MemoryCaptureSP[INDI_ENABLED].getState() == ISS_ON)
+                LOG_INFO("Memory capture is enabled. Images are decoded in memory while the next exposure may start.");
+            else
+                LOG_INFO("Memory capture is disabled. Images are saved to a temporary file before decoding.");
+
+            MemoryCaptureSP.apply();
+            saveConfig(MemoryCaptureSP);
+            return true;
+        }
+
         if (ExposurePresetSP.isNameMatch(name))
         {
             if (!ExposurePresetSP.update(states, names, n))
@@ -811,6 +851,17 @@ bool GPhotoCCD::ISNewNumber(const char * dev, const char * name, double values[]
             return true;
         }
 
+        // Live View Width
+        if (LiveViewWidthNP.isNameMatch(name))
+        {
+            LiveViewWidthNP.update(values, names, n);
+            LiveViewWidthNP.setState(IPS_OK);
+            LiveViewWidthNP.apply();
+            saveConfig(LiveViewWidthNP);
+            m_LiveViewWidth = LiveViewWidthNP[0].getValue();
+            return true;
+        }
+
         if (CamOptions.find(name) != CamOptions.end())
         {
             cam_opt * opt = CamOptions[name];
@@ -1009,6 +1060,7 @@ bool GPhotoCCD::Disconnect()
 {
     if (isSimulation())
         return true;
+    stopDecode();
     gphoto_close(gphotodrv);
     gphotodrv        = nullptr;
     frameInitialized = false;
@@ -1167,29 +1219,7 @@ void GPhotoCCD::TimerHit()
                 }
             }
 
-            if (isTemperatureSupported)
-            {
-                double cameraTemperature = static_cast<double>(gphoto_get_last_sensor_temperature(gphotodrv));
-                if (fabs(cameraTemperature - TemperatureNP[0].getValue()) > 0.01)
-                {
-                    // Check if we are getting bogus temperature values and set property to alert
-                    // unless it is already set
-                    if (cameraTemperature < MINUMUM_CAMERA_TEMPERATURE)
-                    {
-                        if (TemperatureNP.getState() != IPS_ALERT)
-                        {
-                            TemperatureNP.setState(IPS_ALERT);
-                            TemperatureNP.apply();
-                        }
-                    }
-                    else
-                    {
-                        TemperatureNP.setState(IPS_OK);
-                        TemperatureNP[0].setValue(cameraTemperature);
-                        TemperatureNP.apply();
-                    }
-                }
-            }
+            updateTemperature();
         }
 
         if (InExposure && timerID == -1)
@@ -1197,6 +1227,36 @@ void GPhotoCCD::TimerHit()
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void GPhotoCCD::updateTemperature()
+{
+    if (!isTemperatureSupported)
+        return;
+
+    double cameraTemperature = static_cast<double>(gphoto_get_last_sensor_temperature(gphotodrv));
+    if (fabs(cameraTemperature - TemperatureNP[0].getValue()) > 0.01)
+    {
+        // Check if we are getting bogus temperature values and set property to alert
+        // unless it is already set
+        if (cameraTemperature < MINUMUM_CAMERA_TEMPERATURE)
+        {
+            if (TemperatureNP.getState() != IPS_ALERT)
+            {
+                TemperatureNP.setState(IPS_ALERT);
+                TemperatureNP.apply();
+            }
+        }
+        else
+        {
+            TemperatureNP.setState(IPS_OK);
+            TemperatureNP[0].setValue(cameraTemperature);
+            TemperatureNP.apply();
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1244,6 +1304,11 @@ bool GPhotoCCD::grabImage()
         ExposureComplete(&PrimaryCCD);
         gphoto_read_exposure_fd(gphotodrv, -1);
     }
+    else if ((EncodeFormatSP[FORMAT_FITS].getState() == ISS_ON || EncodeFormatSP[FORMAT_XISF].getState() == ISS_ON) &&
+             !isSimulation() && MemoryCaptureSP[INDI_ENABLED].getState() == ISS_ON)
+    {
+        return grabImageToMemory();
+    }
     else if (EncodeFormatSP[FORMAT_FITS].getState() == ISS_ON || EncodeFormatSP[FORMAT_XISF].getState() == ISS_ON)
     {
         char filename[MAXRBUF] = "/tmp/indi_XXXXXX";
@@ -1268,6 +1333,7 @@ bool GPhotoCCD::grabImage()
         else
         {
             int fd = mkstemp(filename);
+            gphoto_defer_temperature(gphotodrv, false);
             int ret = gphoto_read_exposure_fd(gphotodrv, fd);
             if (ret != GP_OK || fd == -1)
             {
@@ -1349,116 +1415,8 @@ bool GPhotoCCD::grabImage()
             SetCCDCapability(GetCCDCapability() | CCD_HAS_BAYER);
         }
 
-        if (EncodeFormatSP[FORMAT_FITS].getState() == ISS_ON)
-            PrimaryCCD.setImageExtension("fits");
-        else
-            PrimaryCCD.setImageExtension("xisf");
-
-        uint16_t subW = PrimaryCCD.getSubW();
-        uint16_t subH = PrimaryCCD.getSubH();
-
-        // If subframing is requested
-        // If either axis is less than the image resolution
-        // then we subframe, given the OTHER axis is within range as well.
-        if ( (subW > 0 && subH > 0) && ((subW < w && subH <= h) || (subH < h && subW <= w)))
-        {
-
-            uint16_t subX = PrimaryCCD.getSubX();
-            uint16_t subY = PrimaryCCD.getSubY();
-
-            // Align all boundaries to be even
-            // This should fix issues with subframed bayered images.
-            //            subX -= subX % 2;
-            //            subY -= subY % 2;
-            //            subW -= subW % 2;
-            //            subH -= subH % 2;
-
-            int subFrameSize     = subW * subH * bpp / 8 * ((naxis == 3) ? 3 : 1);
-            int oneFrameSize     = subW * subH * bpp / 8;
-
-            int lineW  = subW * bpp / 8;
-
-            LOGF_DEBUG("Subframing... subFrameSize: %d - oneFrameSize: %d - subX: %d - subY: %d - subW: %d - subH: %d",
-                       subFrameSize, oneFrameSize,
-                       subX, subY, subW, subH);
-
-            if (naxis == 2)
-            {
-                // JM 2020-08-29: Using memmove since regions are overlaping
-                // as proposed by Camiel Severijns on INDI forums.
-                for (int i = subY; i < subY + subH; i++)
-                    memmove(memptr + (i - subY) * lineW, memptr + (i * w + subX) * bpp / 8, lineW);
-            }
-            else
-            {
-                uint8_t * subR = memptr;
-                uint8_t * subG = memptr + oneFrameSize;
-                uint8_t * subB = memptr + oneFrameSize * 2;
-
-                uint8_t * startR = memptr;
-                uint8_t * startG = memptr + (w * h * bpp / 8);
-                uint8_t * startB = memptr + (w * h * bpp / 8 * 2);
-
-                for (int i = subY; i < subY + subH; i++)
-                {
-                    memcpy(subR + (i - subY) * lineW, startR + (i * w + subX) * bpp / 8, lineW);
-                    memcpy(subG + (i - subY) * lineW, startG + (i * w + subX) * bpp / 8, lineW);
-                    memcpy(subB + (i - subY) * lineW, startB + (i * w + subX) * bpp / 8, lineW);
-                }
-            }
-
-            PrimaryCCD.setFrameBuffer(memptr);
-            PrimaryCCD.setFrameBufferSize(memsize, false);
-            PrimaryCCD.setResolution(w, h);
-            PrimaryCCD.setFrame(subX, subY, subW, subH);
-            PrimaryCCD.setNAxis(naxis);
-            PrimaryCCD.setBPP(bpp);
-
-            // binning if needed
-            if(binning)
-            {
-
-                // binBayerFrame implemented since 1.9.4
-#if INDI_VERSION_MAJOR >= 1 && INDI_VERSION_MINOR >= 9 && INDI_VERSION_RELEASE >=4
-                PrimaryCCD.binBayerFrame();
-#else
-                PrimaryCCD.binFrame();
-#endif
-            }
-
-            ExposureComplete(&PrimaryCCD);
-
-            // Restore old pointer and release memory
-            //PrimaryCCD.setFrameBuffer(memptr);
-            //PrimaryCCD.setFrameBufferSize(memsize, false);
-            //delete [] (subframeBuf);
-        }
-        else
-        {
-            if (PrimaryCCD.getSubW() != 0 && (w > PrimaryCCD.getSubW() || h > PrimaryCCD.getSubH()))
-                LOGF_WARN("Camera image size (%dx%d) is less than requested size (%d,%d). Purge configuration and update frame size to match camera size.",
-                          w, h, PrimaryCCD.getSubW(), PrimaryCCD.getSubH());
-
-            PrimaryCCD.setFrameBuffer(memptr);
-            PrimaryCCD.setFrameBufferSize(memsize, false);
-            PrimaryCCD.setResolution(w, h);
-            PrimaryCCD.setFrame(0, 0, w, h);
-            PrimaryCCD.setNAxis(naxis);
-            PrimaryCCD.setBPP(bpp);
-
-            // binning if needed
-            if(binning)
-            {
-                // binBayerFrame implemented since 1.9.4
-#if INDI_VERSION_MAJOR >= 1 && INDI_VERSION_MINOR >= 9 && INDI_VERSION_RELEASE >=4
-                PrimaryCCD.binBayerFrame();
-#else
-                PrimaryCCD.binFrame();
-#endif
-            }
-
-            ExposureComplete(&PrimaryCCD);
-        }
+        setImage(memptr, memsize, naxis, w, h, bpp);
+        ExposureComplete(&PrimaryCCD);
     }
 
     // Read Native image AS IS
@@ -1511,6 +1469,7 @@ bool GPhotoCCD::grabImage()
         }
         else
         {
+            gphoto_defer_temperature(gphotodrv, false);
             int rc = gphoto_read_exposure(gphotodrv);
             if (rc != 0)
             {
@@ -1560,6 +1519,371 @@ bool GPhotoCCD::grabImage()
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Hand a decoded image to the primary chip, applying the subframe and binning
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void GPhotoCCD::setImage(uint8_t * memptr, size_t memsize, int naxis, int w, int h, int bpp)
+{
+    if (EncodeFormatSP[FORMAT_FITS].getState() == ISS_ON)
+        PrimaryCCD.setImageExtension("fits");
+    else
+        PrimaryCCD.setImageExtension("xisf");
+
+    uint16_t subW = PrimaryCCD.getSubW();
+    uint16_t subH = PrimaryCCD.getSubH();
+
+    // If subframing is requested
+    // If either axis is less than the image resolution
+    // then we subframe, given the OTHER axis is within range as well.
+    if ( (subW > 0 && subH > 0) && ((subW < w && subH <= h) || (subH < h && subW <= w)))
+    {
+
+        uint16_t subX = PrimaryCCD.getSubX();
+        uint16_t subY = PrimaryCCD.getSubY();
+
+        // Align all boundaries to be even
+        // This should fix issues with subframed bayered images.
+        //            subX -= subX % 2;
+        //            subY -= subY % 2;
+        //            subW -= subW % 2;
+        //            subH -= subH % 2;
+
+        int subFrameSize     = subW * subH * bpp / 8 * ((naxis == 3) ? 3 : 1);
+        int oneFrameSize     = subW * subH * bpp / 8;
+
+        int lineW  = subW * bpp / 8;
+
+        LOGF_DEBUG("Subframing... subFrameSize: %d - oneFrameSize: %d - subX: %d - subY: %d - subW: %d - subH: %d",
+                   subFrameSize, oneFrameSize,
+                   subX, subY, subW, subH);
+
+        if (naxis == 2)
+        {
+            // JM 2020-08-29: Using memmove since regions are overlaping
+            // as proposed by Camiel Severijns on INDI forums.
+            for (int i = subY; i < subY + subH; i++)
+                memmove(memptr + (i - subY) * lineW, memptr + (i * w + subX) * bpp / 8, lineW);
+        }
+        else
+        {
+            uint8_t * subR = memptr;
+            uint8_t * subG = memptr + oneFrameSize;
+            uint8_t * subB = memptr + oneFrameSize * 2;
+
+            uint8_t * startR = memptr;
+            uint8_t * startG = memptr + (w * h * bpp / 8);
+            uint8_t * startB = memptr + (w * h * bpp / 8 * 2);
+
+            for (int i = subY; i < subY + subH; i++)
+            {
+                memcpy(subR + (i - subY) * lineW, startR + (i * w + subX) * bpp / 8, lineW);
+                memcpy(subG + (i - subY) * lineW, startG + (i * w + subX) * bpp / 8, lineW);
+                memcpy(subB + (i - subY) * lineW, startB + (i * w + subX) * bpp / 8, lineW);
+            }
+        }
+
+        PrimaryCCD.setFrameBuffer(memptr);
+        PrimaryCCD.setFrameBufferSize(memsize, false);
+        PrimaryCCD.setResolution(w, h);
+        PrimaryCCD.setFrame(subX, subY, subW, subH);
+        PrimaryCCD.setNAxis(naxis);
+        PrimaryCCD.setBPP(bpp);
+
+        // binning if needed
+        if(binning)
+        {
+
+            // binBayerFrame implemented since 1.9.4
+#if INDI_VERSION_MAJOR >= 1 && INDI_VERSION_MINOR >= 9 && INDI_VERSION_RELEASE >=4
+            PrimaryCCD.binBayerFrame();
+#else
+            PrimaryCCD.binFrame();
+#endif
+        }
+
+        // Restore old pointer and release memory
+        //PrimaryCCD.setFrameBuffer(memptr);
+        //PrimaryCCD.setFrameBufferSize(memsize, false);
+        //delete [] (subframeBuf);
+    }
+    else
+    {
+        if (PrimaryCCD.getSubW() != 0 && (w > PrimaryCCD.getSubW() || h > PrimaryCCD.getSubH()))
+            LOGF_WARN("Camera image size (%dx%d) is less than requested size (%d,%d). Purge configuration and update frame size to match camera size.",
+                      w, h, PrimaryCCD.getSubW(), PrimaryCCD.getSubH());
+
+        PrimaryCCD.setFrameBuffer(memptr);
+        PrimaryCCD.setFrameBufferSize(memsize, false);
+        PrimaryCCD.setResolution(w, h);
+        PrimaryCCD.setFrame(0, 0, w, h);
+        PrimaryCCD.setNAxis(naxis);
+        PrimaryCCD.setBPP(bpp);
+
+        // binning if needed
+        if(binning)
+        {
+            // binBayerFrame implemented since 1.9.4
+#if INDI_VERSION_MAJOR >= 1 && INDI_VERSION_MINOR >= 9 && INDI_VERSION_RELEASE >=4
+            PrimaryCCD.binBayerFrame();
+#else
+            PrimaryCCD.binFrame();
+#endif
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Download the image into memory and queue it for decoding, the frame completes in finishDecode()
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool GPhotoCCD::grabImageToMemory()
+{
+    auto downloadStart = std::chrono::steady_clock::now();
+    gphoto_defer_temperature(gphotodrv, true);
+    int ret = gphoto_read_exposure(gphotodrv);
+    if (ret != GP_OK)
+    {
+        LOGF_ERROR("Exposure failed to save image... %s", gp_result_as_string(ret));
+        // As suggested on INDI forums, this result could be misleading.
+        if (ret == GP_ERROR_DIRECTORY_NOT_FOUND)
+            LOG_INFO("Make sure BULB switch is ON in the camera. Try setting AF switch to OFF.");
+        return false;
+    }
+
+    const char *extension = gphoto_get_file_extension(gphotodrv);
+    if (!strcmp(extension, "unknown"))
+    {
+        LOG_ERROR("Exposure failed.");
+        return false;
+    }
+
+    // We're done exposing
+    if (ExposureRequest > 3)
+        LOG_INFO("Exposure done, decoding image...");
+
+    std::chrono::duration<double> download = std::chrono::steady_clock::now() - downloadStart;
+    LOGF_DEBUG("Downloaded %s image in %.3f seconds.", extension, download.count());
+
+    // Never wait for an earlier frame on the main thread, the decode thread works through them in order
+    DecodeJob job;
+    job.file = gphoto_take_file(gphotodrv);
+    job.extension = extension;
+    job.duration = ExposureRequest;
+    job.start = ExpStart;
+    // The spare buffer, or none and the decoder allocates one
+    job.buffer = m_DecodeBuffer;
+    m_DecodeBuffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_DecodeMutex);
+        m_DecodeQueue.push_back(job);
+    }
+
+    if (!m_DecodeThread.joinable())
+        m_DecodeThread = std::thread(&GPhotoCCD::decodeLoop, this);
+    m_DecodePending++;
+    m_DecodeCV.notify_all();
+
+    if (m_DecodeTID == -1)
+        m_DecodeTID = IEAddTimer(DECODE_POLL_MS, GPhotoCCD::DecodeUpdate, this);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void GPhotoCCD::DecodeUpdate(void * vp)
+{
+    static_cast<GPhotoCCD *>(vp)->DecodeUpdate();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Complete the frames as soon as they are decoded
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void GPhotoCCD::DecodeUpdate()
+{
+    m_DecodeTID = -1;
+    if (!finishDecode())
+        m_DecodeTID = IEAddTimer(DECODE_POLL_MS, GPhotoCCD::DecodeUpdate, this);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void GPhotoCCD::decodeLoop()
+{
+    std::unique_lock<std::mutex> lock(m_DecodeMutex);
+    for (;;)
+    {
+        m_DecodeCV.wait(lock, [this]()
+        {
+            return m_DecodeQuit || !m_DecodeQueue.empty();
+        });
+        if (m_DecodeQuit)
+            return;
+
+        DecodeJob job = m_DecodeQueue.front();
+        m_DecodeQueue.pop_front();
+        lock.unlock();
+
+        auto start = std::chrono::steady_clock::now();
+        const char *data = nullptr;
+        unsigned long size = 0;
+        job.rc = gp_file_get_data_and_size(job.file, &data, &size);
+        if (job.rc == GP_OK)
+        {
+            if (strcasecmp(job.extension.c_str(), "jpg") == 0 || strcasecmp(job.extension.c_str(), "jpeg") == 0)
+                job.rc = read_jpeg_buffer(reinterpret_cast<const uint8_t *>(data), size, &job.buffer, &job.size, &job.naxis,
+                                          &job.w, &job.h);
+            else
+                job.rc = m_RawDecoder.decode(data, size, &job.buffer, &job.size, &job.naxis, &job.w, &job.h, &job.bpp,
+                                             job.bayer, &job.temperature);
+        }
+        gp_file_free(job.file);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        job.seconds = elapsed.count();
+
+        job.file = nullptr;
+        lock.lock();
+        m_DecodedJobs.push_back(job);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Complete the decoded frames on the main thread, false while frames are still decoding
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool GPhotoCCD::finishDecode()
+{
+    for (;;)
+    {
+        DecodeJob job;
+        {
+            std::lock_guard<std::mutex> lock(m_DecodeMutex);
+            if (m_DecodedJobs.empty())
+                return m_DecodePending == 0;
+            // The frame buffer and the frame timing belong to libindi until the previous frame is uploaded
+            if (m_Uploading)
+            {
+                if (std::chrono::steady_clock::now() - m_UploadStarted < std::chrono::milliseconds(UPLOAD_WAIT_MS))
+                    return false;
+                LOG_WARN("Previous image upload did not complete.");
+            }
+            job = m_DecodedJobs.front();
+            m_DecodedJobs.pop_front();
+        }
+        m_DecodePending--;
+        completeDecode(job);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Upload a decoded frame
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void GPhotoCCD::completeDecode(DecodeJob &job)
+{
+    if (job.rc != 0)
+    {
+        if (m_DecodeBuffer == nullptr)
+            m_DecodeBuffer = job.buffer;
+        else if (job.buffer)
+            IDSharedBlobFree(job.buffer);
+        LOGF_ERROR("Exposure failed to parse %s image.", job.extension.c_str());
+        // Do not fail the exposure that started in the meantime
+        if (!InExposure)
+            PrimaryCCD.setExposureFailed();
+        return;
+    }
+
+    LOGF_DEBUG("Decoded %s image in %.3f seconds: memsize (%d) naxis (%d) w (%d) h (%d) bpp (%d) bayer pattern (%s)",
+               job.extension.c_str(), job.seconds, job.size, job.naxis, job.w, job.h, job.bpp, job.bayer);
+
+    if (job.bayer[0])
+    {
+        BayerTP[2].setText(job.bayer);
+        BayerTP.apply();
+        SetCCDCapability(GetCCDCapability() | CCD_HAS_BAYER);
+    }
+    else
+        SetCCDCapability(GetCCDCapability() & ~CCD_HAS_BAYER);
+
+    if (job.temperature > -273.0f)
+    {
+        gphoto_set_last_sensor_temperature(gphotodrv, job.temperature);
+        updateTemperature();
+    }
+
+    // Swap the decoded buffer in, the previous frame buffer takes the next decode
+    {
+        std::lock_guard<std::mutex> guard(ccdBufferLock);
+        uint8_t *previous = PrimaryCCD.getFrameBuffer();
+        if (m_DecodeBuffer == nullptr)
+            m_DecodeBuffer = previous;
+        else if (previous)
+            IDSharedBlobFree(previous);
+        setImage(job.buffer, job.size, job.naxis, job.w, job.h, job.bpp);
+    }
+
+    // libindi encodes on its own thread, after another exposure may have started, so it gets this frame's own timing
+    m_UploadDuration = job.duration;
+    m_UploadStart = job.start;
+    m_UploadStarted = std::chrono::steady_clock::now();
+    m_Uploading = true;
+    ExposureComplete(&PrimaryCCD);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// The next decoded frame may take the frame buffer
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void GPhotoCCD::UploadComplete(INDI::CCDChip * targetChip)
+{
+    INDI_UNUSED(targetChip);
+    m_Uploading = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void GPhotoCCD::stopDecode()
+{
+    if (m_DecodeTID != -1)
+    {
+        IERmTimer(m_DecodeTID);
+        m_DecodeTID = -1;
+    }
+
+    if (m_DecodeThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_DecodeMutex);
+            m_DecodeQuit = true;
+        }
+        m_DecodeCV.notify_all();
+        m_DecodeThread.join();
+        m_DecodeQuit = false;
+    }
+
+    // Frames that were never decoded or never completed
+    for (auto &job : m_DecodeQueue)
+    {
+        gp_file_free(job.file);
+        if (job.buffer)
+            IDSharedBlobFree(job.buffer);
+    }
+    for (auto &job : m_DecodedJobs)
+    {
+        if (job.buffer)
+            IDSharedBlobFree(job.buffer);
+    }
+    m_DecodeQueue.clear();
+    m_DecodedJobs.clear();
+    m_DecodePending = 0;
+    m_Uploading = false;
+
+    if (m_DecodeBuffer)
+    {
+        IDSharedBlobFree(m_DecodeBuffer);
+        m_DecodeBuffer = nullptr;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1961,6 +2285,7 @@ void GPhotoCCD::streamLiveView()
     }
 
     char errMsg[MAXRBUF] = {0};
+    JpegDecoder decoder;
     while (true)
     {
         std::unique_lock<std::mutex> guard(liveStreamMutex);
@@ -1987,8 +2312,6 @@ void GPhotoCCD::streamLiveView()
             }
         }
 
-        uint8_t * inBuffer = reinterpret_cast<uint8_t *>(const_cast<char *>(previewData));
-
         //        if (streamSubframeS[1].s == ISS_ON)
         //        {
         //            if (liveVideoWidth <= 0)
@@ -2003,17 +2326,44 @@ void GPhotoCCD::streamLiveView()
         //            continue;
         //        }
 
-        uint8_t * ccdBuffer      = PrimaryCCD.getFrameBuffer();
-        size_t size             = 0;
-        int w = 0, h = 0, naxis = 0;
+        const uint8_t * jpeg = reinterpret_cast<const uint8_t *>(previewData);
+        JpegDecoder::Info info;
+        if (!decoder.readHeader(jpeg, previewSize, 1, info))
+        {
+            LOGF_ERROR("Error getting live video frame: %s", decoder.lastError().c_str());
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
 
-        // Read jpeg from memory
+        // Scale down in the DCT while the frame stays as wide as CCD_LIVE_VIEW_WIDTH asks. The stream frame
+        // size is set from the decoded size below and only crops it afterwards, so it cannot drive the scale.
+        int scale = JpegDecoder::scaleFor(info.width, m_LiveViewWidth);
+        if (scale != 1)
+            decoder.readHeader(jpeg, previewSize, scale, info);
+        size_t size = info.size();
+        int w = info.width, h = info.height, naxis = info.channels;
+
+        // Decode straight into the CCD buffer
         std::unique_lock<std::mutex> ccdguard(ccdBufferLock);
-        rc = read_jpeg_mem(inBuffer, previewSize, &ccdBuffer, &size, &naxis, &w, &h);
+        uint8_t * ccdBuffer = PrimaryCCD.getFrameBuffer();
+        if (PrimaryCCD.getFrameBufferSize() != static_cast<int>(size))
+        {
+            ccdBuffer = static_cast<uint8_t *>(IDSharedBlobRealloc(ccdBuffer, size));
+            if (ccdBuffer == nullptr)
+                ccdBuffer = static_cast<uint8_t *>(IDSharedBlobAlloc(size));
+            if (ccdBuffer == nullptr)
+            {
+                LOG_ERROR("Failed to allocate memory for live video frame.");
+                break;
+            }
+            PrimaryCCD.setFrameBuffer(ccdBuffer);
+            PrimaryCCD.setFrameBufferSize(size, false);
+        }
 
-        if (rc != 0)
+        if (!decoder.decode(jpeg, previewSize, scale, JpegDecoder::INTERLEAVED, ccdBuffer))
         {
-            LOG_ERROR("Error getting live video frame.");
+            ccdguard.unlock();
+            LOGF_ERROR("Error getting live video frame: %s", decoder.lastError().c_str());
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
             continue;
         }
@@ -2025,8 +2375,6 @@ void GPhotoCCD::streamLiveView()
             Streamer->setSize(liveVideoWidth, liveVideoHeight);
         }
 
-        PrimaryCCD.setFrameBuffer(ccdBuffer);
-
         // We are done with writing to CCD buffer
         ccdguard.unlock();
 
@@ -2045,9 +2393,6 @@ void GPhotoCCD::streamLiveView()
             PrimaryCCD.setFrame(0, 0, w, h);
         }
 
-        if (PrimaryCCD.getFrameBufferSize() != static_cast<int>(size))
-            PrimaryCCD.setFrameBufferSize(size, false);
-
         Streamer->newFrame(ccdBuffer, size);
     }
 
@@ -2075,6 +2420,9 @@ bool GPhotoCCD::saveConfigItems(FILE * fp)
     // Download Timeout
     DownloadTimeoutNP.save(fp);
 
+    // Live View Width
+    LiveViewWidthNP.save(fp);
+
     // Capture Target
     if (CaptureTargetSP.getState() == IPS_OK)
     {
@@ -2094,6 +2442,9 @@ bool GPhotoCCD::saveConfigItems(FILE * fp)
     // Force BULB Mode
     ForceBULBSP.save(fp);
 
+    // Memory Capture
+    MemoryCaptureSP.save(fp);
+
     return true;
 }
 
@@ -2104,6 +2455,24 @@ void GPhotoCCD::addFITSKeywords(INDI::CCDChip * targetChip, std::vector<INDI::FI
 {
     INDI::CCD::addFITSKeywords(targetChip, fitsKeywords);
 
+    // The chip may already hold the exposure started while this frame was decoding
+    if (m_Uploading)
+    {
+        struct tm tp;
+        char dateObs[MAXINDIFORMAT], startTime[MAXINDIFORMAT];
+        gmtime_r(&m_UploadStart.tv_sec, &tp);
+        strftime(startTime, sizeof(startTime), "%Y-%m-%dT%H:%M:%S", &tp);
+        snprintf(dateObs, sizeof(dateObs), "%s.%03d", startTime, static_cast<int>(m_UploadStart.tv_usec / 1000));
+
+        for (auto &record : fitsKeywords)
+        {
+            if (record.key() == "EXPTIME")
+                record = INDI::FITSRecord("EXPTIME", m_UploadDuration, 6, "Total Exposure Time (s)");
+            else if (record.key() == "DATE-OBS")
+                record = INDI::FITSRecord("DATE-OBS", dateObs, "UTC start date of observation");
+        }
+    }
+
     if (ISOSP.count() > 0)
     {
         auto onISO = ISOSP.findOnSwitch();
@@ -23,13 +23,20 @@
 #pragma once
 
 #include "gphoto_driver.h"
+#include "gphoto_readimage.h"
 
 #include <indiccd.h>
 #include <indifocuserinterface.h>
 
 #include <map>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <future>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #define MAXEXPERR 10 /* max err in exp time we allow, secs */
 #define OPENDT    5  /* open retry delay, secs */
@@ -92,6 +99,9 @@ class GPhotoCCD : public INDI::CCD, public INDI::FocuserInterface
         static void UpdateExtendedOptions(void * vp);
         void UpdateExtendedOptions(bool force = false);
 
+        static void DecodeUpdate(void * vp);
+        void DecodeUpdate();
+
         static void UpdateFocusMotionHelper(void *context);
         void UpdateFocusMotionCallback();
 
@@ -99,6 +109,7 @@ class GPhotoCCD : public INDI::CCD, public INDI::FocuserInterface
         // Misc.
         bool saveConfigItems(FILE * fp) override;
         void addFITSKeywords(INDI::CCDChip * targetChip, std::vector<INDI::FITSRecord> &fitsKeywords) override;
+        void UploadComplete(INDI::CCDChip * targetChip) override;
         void TimerHit() override;
 
         // Capture format
@@ -143,6 +154,31 @@ class GPhotoCCD : public INDI::CCD, public INDI::FocuserInterface
 
         double CalcTimeLeft();
         bool grabImage();
+        void setImage(uint8_t * memptr, size_t memsize, int naxis, int w, int h, int bpp);
+        void updateTemperature();
+
+        // Memory capture: the camera file is kept in memory and decoded on m_DecodeThread,
+        // so the driver is free to start the next exposure in the meantime.
+        struct DecodeJob
+        {
+            CameraFile * file {nullptr};
+            std::string extension;
+            double duration {0};
+            struct timeval start {};
+            // Filled in by the decode thread
+            int rc {0};
+            uint8_t * buffer {nullptr};
+            size_t size {0};
+            int naxis {2}, w {0}, h {0}, bpp {8};
+            char bayer[8] {};
+            float temperature {-273};
+            double seconds {0};
+        };
+        bool grabImageToMemory();
+        bool finishDecode();
+        void completeDecode(DecodeJob &job);
+        void decodeLoop();
+        void stopDecode();
 
         char name[MAXINDIDEVICE];
         char model[MAXINDINAME];
@@ -203,8 +239,15 @@ class GPhotoCCD : public INDI::CCD, public INDI::FocuserInterface
         INDI::PropertySwitch ExposurePresetSP {0};
         // Force BULB mode (vs predefined exposure indexes) when capturing
         INDI::PropertySwitch ForceBULBSP {2};
+        // Decode captures from memory instead of a temporary file
+        INDI::PropertySwitch MemoryCaptureSP {2};
         // Wait this many seconds before giving up on exposure download
         INDI::PropertyNumber DownloadTimeoutNP {1};
+        // Smallest live view width, the preview JPEG is scaled down in the DCT as far as this allows.
+        // Not taken from the stream frame: that selects a crop in the coordinates of the decoded frame,
+        // so it cannot also pick the scale those coordinates depend on.
+        INDI::PropertyNumber LiveViewWidthNP {1};
+        std::atomic<int> m_LiveViewWidth {0};
         // Upload file, used for testing purposes under simulation under native mode
         INDI::PropertyText UploadFileTP {1};
         INDI::PropertyBlob imageBP {INDI::Property()};
@@ -214,9 +257,33 @@ class GPhotoCCD : public INDI::CCD, public INDI::FocuserInterface
         // Threading
         std::thread m_LiveViewThread;
 
+        // Memory capture decoding, jobs wait in m_DecodeQueue and come back in m_DecodedJobs in capture order
+        std::thread m_DecodeThread;
+        std::mutex m_DecodeMutex;
+        std::condition_variable m_DecodeCV;
+        std::deque<DecodeJob> m_DecodeQueue;
+        std::deque<DecodeJob> m_DecodedJobs;
+        bool m_DecodeQuit {false};
+        // Jobs handed over on the main thread whose frame is not complete yet
+        size_t m_DecodePending {0};
+        int m_DecodeTID {-1};
+        RawDecoder m_RawDecoder;
+        // Spare frame buffer the next capture is decoded into
+        uint8_t * m_DecodeBuffer {nullptr};
+        // A decoded frame is being encoded and uploaded by libindi, until UploadComplete()
+        std::atomic<bool> m_Uploading {false};
+        std::chrono::steady_clock::time_point m_UploadStarted;
+        // Exposure of the frame being uploaded, the chip may already hold a newer one
+        double m_UploadDuration {0};
+        struct timeval m_UploadStart {};
+
         std::map <uint8_t, uint8_t> m_CaptureFormatMap;
 
         static constexpr double MINUMUM_CAMERA_TEMPERATURE = -60.0;
+        // Poll for a finished decode this often, milliseconds
+        static constexpr uint32_t DECODE_POLL_MS = 50;
+        // Longest wait for an upload before the next decoded frame is completed anyway, milliseconds
+        static constexpr uint32_t UPLOAD_WAIT_MS = 60000;
 
         // Ratio from far 3 to far 2
         static constexpr double FOCUS_HIGH_MED_RATIO = 7.33;
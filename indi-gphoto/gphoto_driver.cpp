@@ -164,6 +164,8 @@ struct _gphoto_driver
 
     bool supports_temperature;
     float last_sensor_temp;
+    // The caller decodes the image and reports the temperature found in it
+    bool defer_temperature;
     bool bulb_mode {false};
 
     DSUSBDriver *dsusb;
@@ -872,7 +874,8 @@ static int download_image(gphoto_driver *gphoto, CameraFilePath *fn, int fd)
     // Extract temperature(s) from gphoto image via libraw
     const char *imgData;
     unsigned long imgSize;
-    result = gp_file_get_data_and_size(gphoto->camerafile, &imgData, &imgSize);
+    result = gphoto->defer_temperature ? GP_ERROR_NOT_SUPPORTED :
+             gp_file_get_data_and_size(gphoto->camerafile, &imgData, &imgSize);
     if (result == GP_OK)
     {
         LibRaw lib_raw;
@@ -902,7 +905,8 @@ static int download_image(gphoto_driver *gphoto, CameraFilePath *fn, int fd)
     // Extract temperature(s) from gphoto image via libraw
     const char *imgData;
     unsigned long imgSize;
-    result = gp_file_get_data_and_size(gphoto->camerafile, &imgData, &imgSize);
+    result = gphoto->defer_temperature ? GP_ERROR_NOT_SUPPORTED :
+             gp_file_get_data_and_size(gphoto->camerafile, &imgData, &imgSize);
     if (result == GP_OK)
     {
         LibRaw lib_raw;
@@ -1042,6 +1046,16 @@ float gphoto_get_last_sensor_temperature(gphoto_driver *gphoto)
     return gphoto->last_sensor_temp;
 }
 
+void gphoto_set_last_sensor_temperature(gphoto_driver *gphoto, float temperature)
+{
+    gphoto->last_sensor_temp = temperature;
+}
+
+void gphoto_defer_temperature(gphoto_driver *gphoto, bool enabled)
+{
+    gphoto->defer_temperature = enabled;
+}
+
 int gphoto_mirrorlock(gphoto_driver *gphoto, int msec)
 {
     if (gphoto->bulb_widget && !strcmp(gphoto->bulb_widget->name, "eosremoterelease"))
@@ -2108,6 +2122,13 @@ void gphoto_get_buffer(gphoto_driver *gphoto, const char **buffer, unsigned long
     gp_file_get_data_and_size(gphoto->camerafile, buffer, size);
 }
 
+CameraFile *gphoto_take_file(gphoto_driver *gphoto)
+{
+    CameraFile *file = gphoto->camerafile;
+    gphoto->camerafile = nullptr;
+    return file;
+}
+
 void gphoto_free_buffer(gphoto_driver *gphoto)
 {
     if (gphoto->camerafile)
@@ -99,6 +99,8 @@ gphoto_driver *gphoto_open(Camera *camera, GPContext *context, const char *model
 int gphoto_close(gphoto_driver *gphoto);
 void gphoto_get_buffer(gphoto_driver *gphoto, const char **buffer, unsigned long *size);
 void gphoto_free_buffer(gphoto_driver *gphoto);
+// Take over the image downloaded by gphoto_read_exposure(), the caller frees it with gp_file_free()
+CameraFile *gphoto_take_file(gphoto_driver *gphoto);
 const char *gphoto_get_file_extension(gphoto_driver *gphoto);
 void gphoto_show_options(gphoto_driver *gphoto);
 gphoto_widget_list *gphoto_find_all_widgets(gphoto_driver *gphoto);
@@ -123,6 +125,9 @@ const char *gphoto_get_model(gphoto_driver *gphoto);
 int gphoto_handle_sdcard_image(gphoto_driver *gphoto, CameraImageHandling handling);
 bool gphoto_supports_temperature(gphoto_driver *gphoto);
 float gphoto_get_last_sensor_temperature(gphoto_driver *gphoto);
+void gphoto_set_last_sensor_temperature(gphoto_driver *gphoto, float temperature);
+// Skip the temperature lookup in the downloaded image when the caller decodes it anyway
+void gphoto_defer_temperature(gphoto_driver *gphoto, bool enabled);
 void gphoto_force_bulb(gphoto_driver *gphoto, bool enabled);
 void gphoto_set_view_finder(gphoto_driver *gphoto, bool enabled);
 void gphoto_set_download_timeout(gphoto_driver *gphoto, int timeout);
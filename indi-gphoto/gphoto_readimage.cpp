@@ -1,10 +1,10 @@
 
 #include "gphoto_readimage.h"
+#include "config.h"
 
 #include <indilogger.h>
 #include <sharedblob.h>
 
-#include <jpeglib.h>
 #include <fitsio.h>
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
@@ -42,6 +42,7 @@ enum
 void gphoto_read_set_debug(const char *name)
 {
     snprintf(device, sizeof(device), "%s", name);
+    jpeg_set_debug(name);
 }
 
 void *tstrealloc(void *ptr, size_t size)
@@ -137,33 +138,25 @@ int dcraw_parse_header_info(const char *filename, struct dcraw_header *header)
     return 0;
 }
 
-int read_libraw(const char *filename, uint8_t **memptr, size_t *memsize, int *n_axis, int *w, int *h, int *bitsperpixel,
-                char *bayer_pattern)
+// Copy the visible area of the raw image opened in RawProcessor, name is only used in messages
+static int unpack_libraw(LibRaw &RawProcessor, const char *name, uint8_t **memptr, size_t *memsize, int *n_axis, int *w,
+                         int *h, int *bitsperpixel, char *bayer_pattern)
 {
     int ret = 0;
-    // Creation of image processing object
-    LibRaw RawProcessor;
-
-    // Let us open the file
-    if ((ret = RawProcessor.open_file(filename)) != LIBRAW_SUCCESS)
-    {
-        DEBUGFDEVICE(device, INDI::Logger::DBG_ERROR, "Cannot open %s: %s", filename, libraw_strerror(ret));
-        RawProcessor.recycle();
-        return -1;
-    }
 
     // Let us unpack the image
     if ((ret = RawProcessor.unpack()) != LIBRAW_SUCCESS)
     {
-        DEBUGFDEVICE(device, INDI::Logger::DBG_ERROR, "Cannot unpack %s: %s", filename, libraw_strerror(ret));
+        DEBUGFDEVICE(device, INDI::Logger::DBG_ERROR, "Cannot unpack %s: %s", name, libraw_strerror(ret));
         RawProcessor.recycle();
         return -1;
     }
 
-    // Covert to image
-    if ((ret = RawProcessor.raw2image()) != LIBRAW_SUCCESS)
+    // The Bayer data is copied straight from raw_image, raw2image() would only build a second,
+    // four times larger copy of it that is never used
+    if (RawProcessor.imgdata.rawdata.raw_image == nullptr)
     {
-        DEBUGFDEVICE(device, INDI::Logger::DBG_ERROR, "Cannot convert %s : %s", filename, libraw_strerror(ret));
+        DEBUGFDEVICE(device, INDI::Logger::DBG_ERROR, "Cannot convert %s : not a Bayer raw image", name);
         RawProcessor.recycle();
         return -1;
     }
@@ -194,6 +187,7 @@ int read_libraw(const char *filename, uint8_t **memptr, size_t *memsize, int *n_
     if (*memptr == nullptr)
     {
         DEBUGFDEVICE(device, INDI::Logger::DBG_ERROR, "%s: Failed to allocate %d bytes of memory!", __PRETTY_FUNCTION__, *memsize);
+        RawProcessor.recycle();
         return -1;
     }
 
@@ -215,175 +209,60 @@ int read_libraw(const char *filename, uint8_t **memptr, size_t *memsize, int *n_
     return 0;
 }
 
-int read_jpeg(const char *filename, uint8_t **memptr, size_t *memsize, int *naxis, int *w, int *h)
+int read_libraw(const char *filename, uint8_t **memptr, size_t *memsize, int *n_axis, int *w, int *h, int *bitsperpixel,
+                char *bayer_pattern)
 {
-    unsigned char *r_data = nullptr, *g_data = nullptr, *b_data = nullptr;
-
-    /* these are standard libjpeg structures for reading(decompression) */
-    struct jpeg_decompress_struct cinfo;
-    struct jpeg_error_mgr jerr;
-    /* libjpeg data structure for storing one row, that is, scanline of an image */
-    JSAMPROW row_pointer[1] = { nullptr };
-
-    FILE *infile = fopen(filename, "rb");
+    int ret = 0;
+    // Creation of image processing object
+    LibRaw RawProcessor;
 
-    if (!infile)
-    {
-        DEBUGFDEVICE(device, INDI::Logger::DBG_DEBUG, "Error opening jpeg file %s!", filename);
-        return -1;
-    }
-    /* here we set up the standard libjpeg error handler */
-    cinfo.err = jpeg_std_error(&jerr);
-    /* setup decompression process and source, then read JPEG header */
-    jpeg_create_decompress(&cinfo);
-    /* this makes the library read from infile */
-    jpeg_stdio_src(&cinfo, infile);
-    /* reading the image header which contains image information */
-    jpeg_read_header(&cinfo, (boolean)TRUE);
-
-    /* Start decompression jpeg here */
-    jpeg_start_decompress(&cinfo);
-
-    *memsize = cinfo.output_width * cinfo.output_height * cinfo.num_components;
-    *memptr  = static_cast<uint8_t *>(IDSharedBlobRealloc(*memptr, *memsize));
-    if (*memptr == nullptr)
-        *memptr = static_cast<uint8_t *>(IDSharedBlobAlloc(*memsize));
-    if (*memptr == nullptr)
+    // Let us open the file
+    if ((ret = RawProcessor.open_file(filename)) != LIBRAW_SUCCESS)
     {
-        DEBUGFDEVICE(device, INDI::Logger::DBG_ERROR, "%s: Failed to allocate %d bytes of memory!", __PRETTY_FUNCTION__, *memsize);
+        DEBUGFDEVICE(device, INDI::Logger::DBG_ERROR, "Cannot open %s: %s", filename, libraw_strerror(ret));
+        RawProcessor.recycle();
         return -1;
     }
-    // if you do some ugly pointer math, remember to restore the original pointer or some random crashes will happen. This is why I do not like pointers!!
-    uint8_t *oldmem = *memptr;
-    *naxis = cinfo.num_components;
-    *w     = cinfo.output_width;
-    *h     = cinfo.output_height;
-
-    /* now actually read the jpeg into the raw buffer */
-    row_pointer[0] = (unsigned char *)malloc(cinfo.output_width * cinfo.num_components);
-    if (cinfo.num_components)
-    {
-        r_data = (unsigned char *)*memptr;
-        g_data = r_data + cinfo.output_width * cinfo.output_height;
-        b_data = r_data + 2 * cinfo.output_width * cinfo.output_height;
-    }
-    /* read one scan line at a time */
-    for (unsigned int row = 0; row < cinfo.image_height; row++)
-    {
-        unsigned char *ppm8 = row_pointer[0];
-        jpeg_read_scanlines(&cinfo, row_pointer, 1);
 
-        if (cinfo.num_components == 3)
-        {
-            for (unsigned int i = 0; i < cinfo.output_width; i++)
-            {
-                *r_data++ = *ppm8++;
-                *g_data++ = *ppm8++;
-                *b_data++ = *ppm8++;
-            }
-        }
-        else
-        {
-            memcpy(*memptr, ppm8, cinfo.output_width);
-            *memptr += cinfo.output_width;
-        }
-    }
-
-    /* wrap up decompression, destroy objects, free pointers and close open files */
-    jpeg_finish_decompress(&cinfo);
-    jpeg_destroy_decompress(&cinfo);
-
-    if (row_pointer[0])
-        free(row_pointer[0]);
-    if (infile)
-        fclose(infile);
-
-    *memptr = oldmem;
-
-    return 0;
+    return unpack_libraw(RawProcessor, filename, memptr, memsize, n_axis, w, h, bitsperpixel, bayer_pattern);
 }
 
-int read_jpeg_mem(unsigned char *inBuffer, unsigned long inSize, uint8_t **memptr, size_t *memsize, int *naxis, int *w,
-                  int *h)
+RawDecoder::RawDecoder() : m_Processor(new LibRaw())
 {
-    /* these are standard libjpeg structures for reading(decompression) */
-    struct jpeg_decompress_struct cinfo;
-    struct jpeg_error_mgr jerr;
-    /* libjpeg data structure for storing one row, that is, scanline of an image */
-    JSAMPROW row_pointer[1] = { nullptr };
-
-    /* here we set up the standard libjpeg error handler */
-    cinfo.err = jpeg_std_error(&jerr);
-    /* setup decompression process and source, then read JPEG header */
-    jpeg_create_decompress(&cinfo);
-    /* this makes the library read from infile */
-    jpeg_mem_src(&cinfo, inBuffer, inSize);
-
-    /* reading the image header which contains image information */
-    jpeg_read_header(&cinfo, (boolean)TRUE);
-
-    /* Start decompression jpeg here */
-    jpeg_start_decompress(&cinfo);
-
-    *memsize = cinfo.output_width * cinfo.output_height * cinfo.num_components;
-    *memptr  = static_cast<uint8_t *>(IDSharedBlobRealloc(*memptr, *memsize));
-    if (*memptr == nullptr)
-        *memptr = static_cast<uint8_t *>(IDSharedBlobAlloc(*memsize));
-    if (*memptr == nullptr)
-    {
-        DEBUGFDEVICE(device, INDI::Logger::DBG_ERROR, "%s: Failed to allocate %d bytes of memory!", __PRETTY_FUNCTION__, *memsize);
-        return -1;
-    }
-
-    uint8_t *destmem = *memptr;
+}
 
-    *naxis = cinfo.num_components;
-    *w     = cinfo.output_width;
-    *h     = cinfo.output_height;
+RawDecoder::~RawDecoder() = default;
 
-    /* now actually read the jpeg into the raw buffer */
-    row_pointer[0] = (unsigned char *)malloc(cinfo.output_width * cinfo.num_components);
+int RawDecoder::decode(const void *data, size_t size, uint8_t **memptr, size_t *memsize, int *n_axis, int *w, int *h,
+                       int *bitsperpixel, char *bayer_pattern, float *temperature)
+{
+    int ret = 0;
+    *temperature = -273.0;
 
-    /* read one scan line at a time */
-    for (unsigned int row = 0; row < cinfo.image_height; row++)
+    if ((ret = m_Processor->open_buffer(const_cast<void *>(data), size)) != LIBRAW_SUCCESS)
     {
-        unsigned char *ppm8 = row_pointer[0];
-        jpeg_read_scanlines(&cinfo, row_pointer, 1);
-        memcpy(destmem, ppm8, cinfo.output_width * cinfo.num_components);
-        destmem += cinfo.output_width * cinfo.num_components;
+        DEBUGFDEVICE(device, INDI::Logger::DBG_ERROR, "Cannot open raw image: %s", libraw_strerror(ret));
+        m_Processor->recycle();
+        return -1;
     }
 
-    /* wrap up decompression, destroy objects, free pointers and close open files */
-    jpeg_finish_decompress(&cinfo);
-    jpeg_destroy_decompress(&cinfo);
-
-    if (row_pointer[0])
-        free(row_pointer[0]);
-
-    return 0;
-}
-
-int read_jpeg_size(unsigned char *inBuffer, unsigned long inSize, int *w, int *h)
-{
-    /* these are standard libjpeg structures for reading(decompression) */
-    struct jpeg_decompress_struct cinfo;
-    struct jpeg_error_mgr jerr;
-
-    /* here we set up the standard libjpeg error handler */
-    cinfo.err = jpeg_std_error(&jerr);
-    /* setup decompression process and source, then read JPEG header */
-    jpeg_create_decompress(&cinfo);
-    /* this makes the library read from infile */
-    jpeg_mem_src(&cinfo, inBuffer, inSize);
-
-    /* reading the image header which contains image information */
-    jpeg_read_header(&cinfo, (boolean)TRUE);
-
-    *w     = cinfo.image_width;
-    *h     = cinfo.image_height;
-
-    /* wrap up decompression, destroy objects, free pointers and close open files */
-    jpeg_destroy_decompress(&cinfo);
+    // The temperature comes with the metadata of this open, no second pass over the file
+#if defined(LIBRAW_CAMERA_TEMPERATURE) && defined(LIBRAW_SENSOR_TEMPERATURE)
+    if (m_Processor->imgdata.other.SensorTemperature > -273.15f)
+        *temperature = m_Processor->imgdata.other.SensorTemperature;
+    else if (m_Processor->imgdata.other.CameraTemperature > -273.15f)
+        *temperature = m_Processor->imgdata.other.CameraTemperature;
+#elif defined(LIBRAW_CAMERA_TEMPERATURE2) && defined(LIBRAW_SENSOR_TEMPERATURE2)
+    if (m_Processor->imgdata.makernotes.common.SensorTemperature > -273.15f)
+        *temperature = m_Processor->imgdata.makernotes.common.SensorTemperature;
+    else if (m_Processor->imgdata.makernotes.common.CameraTemperature > -273.15f)
+        *temperature = m_Processor->imgdata.makernotes.common.CameraTemperature;
+#endif
+
+    if (unpack_libraw(*m_Processor, "raw image", memptr, memsize, n_axis, w, h, bitsperpixel, bayer_pattern))
+        return -1;
 
+    // Release the unpacked data, the instance is kept for the next frame
+    m_Processor->recycle();
     return 0;
 }
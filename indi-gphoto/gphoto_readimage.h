@@ -3,11 +3,32 @@
 
 #include <stdint.h>
 #include <stdlib.h>
+#include <memory>
+
+// read_jpeg() and friends are shared with the other DSLR drivers
+#include "jpegdecode.h"
+
+class LibRaw;
 
 int read_libraw(const char *filename, uint8_t **memptr, size_t *memsize, int *n_axis, int *w, int *h, int *bitsperpixel,
                 char *bayer_pattern);
-int read_jpeg(const char *filename, uint8_t **memptr, size_t *memsize, int *n_axis, int *w, int *h);
-int read_jpeg_mem(unsigned char *inBuffer, unsigned long inSize, uint8_t **memptr, size_t *memsize, int *naxis, int *w,
-                  int *h);
-int read_jpeg_size(unsigned char *inBuffer, unsigned long inSize, int *w, int *h);
 void gphoto_read_set_debug(const char *name);
+
+/**
+ * Decodes raw files held in memory, such as a camera file downloaded by gphoto, with the
+ * same output as read_libraw(). One LibRaw instance serves every frame, and the sensor
+ * temperature is read from the same open instead of a separate pass over the file.
+ */
+class RawDecoder
+{
+    public:
+        RawDecoder();
+        ~RawDecoder();
+
+        /** @param temperature set to the sensor or camera temperature in the file, -273 if there is none */
+        int decode(const void *data, size_t size, uint8_t **memptr, size_t *memsize, int *n_axis, int *w, int *h,
+                   int *bitsperpixel, char *bayer_pattern, float *temperature);
+
+    private:
+        std::unique_ptr<LibRaw> m_Processor;
+};
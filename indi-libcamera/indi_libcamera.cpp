@@ -36,16 +36,112 @@
 #include <vector>
 #include <map>
 #include <unistd.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <signal.h>
 
+#include <libcamera/formats.h>
 #include <libraw.h>
 #include <jpeglib.h>
 
+#include "pixelconvert.h"
+
 
 #define CONTROL_TAB "Controls"
 
+/**
+ * Anonymous in-memory file. The rpicam-apps encoders only write to a path, so
+ * they are handed /proc/self/fd/N and the image never touches the SD card.
+ */
+class MemoryFile
+{
+    public:
+        ~MemoryFile()
+        {
+            if (m_fd >= 0)
+                close(m_fd);
+        }
+
+        bool create(const char *name)
+        {
+            m_fd = memfd_create(name, MFD_CLOEXEC);
+            if (m_fd < 0)
+                return false;
+            m_path = "/proc/self/fd/" + std::to_string(m_fd);
+            return true;
+        }
+
+        const std::string &path() const
+        {
+            return m_path;
+        }
+
+        size_t size() const
+        {
+            struct stat sb;
+            return fstat(m_fd, &sb) == 0 ? sb.st_size : 0;
+        }
+
+        bool read(uint8_t *buffer, size_t size) const
+        {
+            size_t done = 0;
+            while (done < size)
+            {
+                ssize_t n = pread(m_fd, buffer + done, size - done, done);
+                if (n <= 0)
+                    return false;
+                done += n;
+            }
+            return true;
+        }
+
+    private:
+        int m_fd {-1};
+        std::string m_path;
+};
+
+/** Raw sensor formats unpacked without going through DNG */
+static const struct
+{
+    libcamera::PixelFormat format;
+    const char *bayer;
+    unsigned int bits;
+    bool packed;
+} RawFormats[] =
+{
+    { libcamera::formats::SRGGB8, "RGGB", 8, false },
+    { libcamera::formats::SGRBG8, "GRBG", 8, false },
+    { libcamera::formats::SGBRG8, "GBRG", 8, false },
+    { libcamera::formats::SBGGR8, "BGGR", 8, false },
+    { libcamera::formats::SRGGB10, "RGGB", 10, false },
+    { libcamera::formats::SGRBG10, "GRBG", 10, false },
+    { libcamera::formats::SGBRG10, "GBRG", 10, false },
+    { libcamera::formats::SBGGR10, "BGGR", 10, false },
+    { libcamera::formats::SRGGB12, "RGGB", 12, false },
+    { libcamera::formats::SGRBG12, "GRBG", 12, false },
+    { libcamera::formats::SGBRG12, "GBRG", 12, false },
+    { libcamera::formats::SBGGR12, "BGGR", 12, false },
+    { libcamera::formats::SRGGB16, "RGGB", 16, false },
+    { libcamera::formats::SGRBG16, "GRBG", 16, false },
+    { libcamera::formats::SGBRG16, "GBRG", 16, false },
+    { libcamera::formats::SBGGR16, "BGGR", 16, false },
+    { libcamera::formats::SRGGB10_CSI2P, "RGGB", 10, true },
+    { libcamera::formats::SGRBG10_CSI2P, "GRBG", 10, true },
+    { libcamera::formats::SGBRG10_CSI2P, "GBRG", 10, true },
+    { libcamera::formats::SBGGR10_CSI2P, "BGGR", 10, true },
+    { libcamera::formats::SRGGB12_CSI2P, "RGGB", 12, true },
+    { libcamera::formats::SGRBG12_CSI2P, "GRBG", 12, true },
+    { libcamera::formats::SGBRG12_CSI2P, "GBRG", 12, true },
+    { libcamera::formats::SBGGR12_CSI2P, "BGGR", 12, true },
+    { libcamera::formats::R8, "", 8, false },
+    { libcamera::formats::R10, "", 10, false },
+    { libcamera::formats::R12, "", 12, false },
+    { libcamera::formats::R16, "", 16, false },
+    { libcamera::formats::R10_CSI2P, "", 10, true },
+    { libcamera::formats::R12_CSI2P, "", 12, true },
+};
+
 static class Loader
 {
         std::map<int, std::shared_ptr<INDILibCamera >> cameras;
@@ -130,6 +226,8 @@ int INDILibCamera::getColorspaceFlags(std::string const &codec)
 void INDILibCamera::workerStreamVideo(const std::atomic_bool &isAboutToQuit, double framerate)
 {
     LOGF_INFO("Starting video stream at %.2f fps", framerate);
+    // Video needs the camera, drop any still session kept armed.
+    releaseStillSession();
     RPiCamEncoder app;
     auto options = app.GetOptions();
     configureVideoOptions(options, framerate);
@@ -228,41 +326,66 @@ void INDILibCamera::metadataReady(libcamera::ControlList &metadata)
 void INDILibCamera::workerExposure(const std::atomic_bool &isAboutToQuit, float duration)
 {
     LOGF_INFO("Starting exposure for %.3f seconds", duration);
-    RPiCamINDIApp app;
+    INDI::ElapsedTimer setupTimer;
+    bool keepArmed = KeepArmedSP[INDI_ENABLED].getState() == ISS_ON;
+    StillSessionKey key = currentStillSessionKey();
+
+    // The session must outlive the completed request and buffer mappings below,
+    // so it is owned locally and only handed back to m_StillApp when kept armed.
+    std::unique_ptr<RPiCamINDIApp> session = std::move(m_StillApp);
+
+    // An armed session is reused as long as nothing that needs ConfigureStill changed.
+    if (session && (!keepArmed || !(key == m_StillKey)))
+    {
+        LOG_DEBUG("Still configuration changed, reconfiguring camera.");
+        closeStillApp(*session);
+        session.reset();
+    }
+
+    bool reused = session != nullptr;
+    if (!reused)
+    {
+        session.reset(new RPiCamINDIApp());
+        configureStillOptions(session->GetOptions(), duration);
+    }
+    else
+        updateStillControls(session->GetOptions(), duration);
+
+    RPiCamINDIApp &app = *session;
     auto options = app.GetOptions();
-    configureStillOptions(options, duration);
     unsigned int still_flags = RPiCamApp::FLAG_STILL_RAW;
 
     try
     {
-        app.OpenCamera();
-        app.ConfigureStill(still_flags);
+        if (!reused)
+        {
+            app.OpenCamera();
+            app.ConfigureStill(still_flags);
+            m_StillKey = key;
+        }
         app.StartCamera();
     }
     catch (std::exception &e)
     {
         LOGF_ERROR("Error opening camera: %s", e.what());
         PrimaryCCD.setExposureFailed();
-        app.StopCamera();
-        app.Teardown();
-        app.CloseCamera();
+        closeStillApp(app);
+        return;
     }
 
+    double setupMs = setupTimer.elapsed();
+
     RPiCamApp::Msg msg = app.Wait();
     if (msg.type != RPiCamApp::MsgType::RequestComplete)
     {
         PrimaryCCD.setExposureFailed();
-        app.StopCamera();
-        app.Teardown();
-        app.CloseCamera();
+        closeStillApp(app);
         LOGF_ERROR("Exposure failed: %d", msg.type);
         return;
     }
     else if (isAboutToQuit)
     {
-        app.StopCamera();
-        app.Teardown();
-        app.CloseCamera();
+        closeStillApp(app);
         return;
     }
 
@@ -275,47 +398,58 @@ void INDILibCamera::workerExposure(const std::atomic_bool &isAboutToQuit, float
 
     try
     {
-        char filename[MAXINDIFORMAT] {0};
-
-        if (raw)
-        {
-            strncpy(filename, "/tmp/output.dng", MAXINDIFORMAT);
-            dng_save(mem, info, payload->metadata, filename, app.CameraId(), options);
-        }
-        else
-        {
-            strncpy(filename, "/tmp/output.jpg", MAXINDIFORMAT);
-            jpeg_save(mem, info, payload->metadata, filename, app.CameraId(), options);
-        }
-
         char bayer_pattern[8] = {};
         uint8_t * memptr = PrimaryCCD.getFrameBuffer();
         size_t memsize = 0;
         int naxis = 2, w = 0, h = 0, bpp = 8;
+        bool fits = EncodeFormatSP[FORMAT_FITS].getState() == ISS_ON;
+
+        // Raw frames for FITS are unpacked straight from the request buffer. DNG and JPEG
+        // are only encoded when the client asked for them, or for raw formats we cannot
+        // unpack ourselves, and then into an anonymous memory file rather than /tmp.
+        bool unpacked = fits && raw && unpackRAW(mem[0], info, &memptr, &memsize, &w, &h, &bpp, bayer_pattern);
 
-        if (EncodeFormatSP[FORMAT_FITS].getState() == ISS_ON)
+        MemoryFile encoded;
+        if (!unpacked)
+        {
+            if (!encoded.create(raw ? "output.dng" : "output.jpg"))
+            {
+                LOGF_ERROR("Error creating memory file: %s", strerror(errno));
+                PrimaryCCD.setExposureFailed();
+                closeStillApp(app);
+                return;
+            }
+
+            if (raw)
+                dng_save(mem, info, payload->metadata, encoded.path(), app.CameraId(), options);
+            else
+                jpeg_save(mem, info, payload->metadata, encoded.path(), app.CameraId(), options);
+        }
+
+        if (fits)
         {
             if (CaptureFormatSP.findOnSwitchIndex() == CAPTURE_DNG)
             {
-                if (!processRAW(filename, &memptr, &memsize, &naxis, &w, &h, &bpp, bayer_pattern))
+                if (!unpacked && !processRAW(encoded.path().c_str(), &memptr, &memsize, &naxis, &w, &h, &bpp, bayer_pattern))
                 {
                     LOG_ERROR("Exposure failed to parse raw image.");
                     PrimaryCCD.setExposureFailed();
-                    app.StopCamera();
-                    app.Teardown();
-                    app.CloseCamera();
-                    unlink(filename);
+                    closeStillApp(app);
                     return;
                 }
 
-                SetCCDCapability(GetCCDCapability() | CCD_HAS_BAYER);
-                BayerTP[2].setText(bayer_pattern);
-                BayerTP.apply();
+                m_pixel_format = bayerToPixelFormat(bayer_pattern);
+                if (m_pixel_format == INDI_MONO)
+                    SetCCDCapability(GetCCDCapability() & ~CCD_HAS_BAYER);
+                else
+                {
+                    SetCCDCapability(GetCCDCapability() | CCD_HAS_BAYER);
+                    BayerTP[2].setText(bayer_pattern);
+                    BayerTP.apply();
+                }
                 m_csi_format_packed = options->Get().mode.packed;
                 m_bit_depth = options->Get().mode.bit_depth;
-                m_pixel_format = bayerToPixelFormat(bayer_pattern);
                 LOGF_INFO("Acquired image, mode: %s%d%s", bayer_pattern, m_bit_depth, m_csi_format_packed ? "P" : "U");
-
                 auto bl = payload->metadata.get(controls::SensorBlackLevels);
                 if (bl)
                 {
@@ -351,14 +485,11 @@ void INDILibCamera::workerExposure(const std::atomic_bool &isAboutToQuit, float
             }
             else
             {
-                if (!processJPEG(filename, &memptr, &memsize, &naxis, &w, &h))
+                if (!processJPEG(encoded.path().c_str(), &memptr, &memsize, &naxis, &w, &h))
                 {
                     LOG_ERROR("Exposure failed to parse jpeg.");
                     PrimaryCCD.setExposureFailed();
-                    app.StopCamera();
-                    app.Teardown();
-                    app.CloseCamera();
-                    unlink(filename);
+                    closeStillApp(app);
                     return;
                 }
 
@@ -446,24 +577,8 @@ void INDILibCamera::workerExposure(const std::atomic_bool &isAboutToQuit, float
         }
         else
         {
-            int fd = open(filename, O_RDONLY);
-            struct stat sb;
-
-            // Get file size
-            if (fstat(fd, &sb) == -1)
-            {
-                LOGF_ERROR("Error opening file %s: %s", filename, strerror(errno));
-                PrimaryCCD.setExposureFailed();
-                app.StopCamera();
-                app.Teardown();
-                app.CloseCamera();
-                close(fd);
-                return;
-            }
-
-            // Copy file to memory using mmap
-            memsize = sb.st_size;
-            // Guard CCD Buffer content until we finish copying mmap buffer to it
+            memsize = encoded.size();
+            // Guard CCD Buffer content until we finish copying the encoded image to it
             std::unique_lock<std::mutex> guard(ccdBufferLock);
             // If CCD Buffer size is different, allocate memory to file size
             if (PrimaryCCD.getFrameBufferSize() != static_cast<int>(memsize))
@@ -471,46 +586,17 @@ void INDILibCamera::workerExposure(const std::atomic_bool &isAboutToQuit, float
                 PrimaryCCD.setFrameBufferSize(memsize);
                 memptr = PrimaryCCD.getFrameBuffer();
             }
-            // mmap crashes randomly for some reason
-            if(0)
-            {
-
-                void *mmap_mem = mmap(nullptr, memsize, PROT_READ, MAP_PRIVATE, fd, 0);
-                if (mmap_mem == nullptr)
-                {
-                    LOGF_ERROR("Error reading file %s: %s", filename, strerror(errno));
-                    PrimaryCCD.setExposureFailed();
-                    app.StopCamera();
-                    app.Teardown();
-                    app.CloseCamera();
-                    close(fd);
-                    return;
-                }
-
-                // Copy mmap buffer to ccd buffer
-                memcpy(memptr, mmap_mem, memsize);
 
-                // Release mmap memory
-                munmap(mmap_mem, memsize);
-            }
-            else
+            if (!encoded.read(memptr, memsize))
             {
-                ssize_t bytesRead = read(fd, memptr, memsize);
-                if (bytesRead == -1 || static_cast<size_t>(bytesRead) < memsize)
-                {
-                    LOGF_ERROR("Error reading file %s: %s or incomplete read (%zd/%zu bytes)", filename, strerror(errno), bytesRead, memsize);
-                    PrimaryCCD.setExposureFailed();
-                    app.StopCamera();
-                    app.Teardown();
-                    app.CloseCamera();
-                    close(fd);
-                    return;
-                }
+                LOGF_ERROR("Error reading encoded image: %s", strerror(errno));
+                PrimaryCCD.setExposureFailed();
+                closeStillApp(app);
+                return;
             }
-            // Close file
-            close(fd);
-            // Set extension (eg. cr2..etc)
-            PrimaryCCD.setImageExtension(strchr(filename, '.') + 1);
+
+            // Set extension (eg. dng..etc)
+            PrimaryCCD.setImageExtension(raw ? "dng" : "jpg");
             // We are ready to unlock
             guard.unlock();
         }
@@ -523,11 +609,72 @@ void INDILibCamera::workerExposure(const std::atomic_bool &isAboutToQuit, float
         PrimaryCCD.setExposureFailed();
     }
 
+    // Keep the pipeline configured for the next exposure, only the sensor is stopped.
+    INDI::ElapsedTimer teardownTimer;
+    if (keepArmed && KeepArmedSP[INDI_ENABLED].getState() == ISS_ON)
+    {
+        app.StopCamera();
+        m_StillApp = std::move(session);
+    }
+    else
+        closeStillApp(app);
+
+    updateSetupOverhead(setupMs + teardownTimer.elapsed(), reused);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/////////////////////////////////////////////////////////////////////////////
+INDILibCamera::StillSessionKey INDILibCamera::currentStillSessionKey()
+{
+    StillSessionKey key;
+    key.width   = PrimaryCCD.getSubW();
+    key.height  = PrimaryCCD.getSubH();
+    key.binning = PrimaryCCD.getBinX();
+    key.format  = CaptureFormatSP.findOnSwitchIndex();
+    key.gain    = GainNP[0].getValue();
+    key.denoise = AdjustDenoiseModeSP.findOnSwitchIndex();
+    return key;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/////////////////////////////////////////////////////////////////////////////
+void INDILibCamera::closeStillApp(RPiCamINDIApp &app)
+{
     app.StopCamera();
     app.Teardown();
     app.CloseCamera();
 }
 
+/////////////////////////////////////////////////////////////////////////////
+/// Must only be called from the worker thread, or when it is stopped.
+/////////////////////////////////////////////////////////////////////////////
+void INDILibCamera::releaseStillSession()
+{
+    if (!m_StillApp)
+        return;
+
+    closeStillApp(*m_StillApp);
+    m_StillApp.reset();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+///
+/////////////////////////////////////////////////////////////////////////////
+void INDILibCamera::updateSetupOverhead(double ms, bool reused)
+{
+    m_SetupOverheadTotal += ms;
+    m_SetupOverheadCount++;
+
+    LOGF_DEBUG("Exposure setup overhead: %.1f ms (%s session)", ms, reused ? "armed" : "new");
+
+    SetupOverheadNP[SETUP_LAST].setValue(ms);
+    SetupOverheadNP[SETUP_AVERAGE].setValue(m_SetupOverheadTotal / m_SetupOverheadCount);
+    SetupOverheadNP.setState(IPS_OK);
+    SetupOverheadNP.apply();
+}
+
 /*
 Adjustments:
 Brightness : [-1.000000..1.000000]
@@ -773,6 +920,15 @@ bool INDILibCamera::initProperties()
     GainNP[0].fill("GAIN", "Gain", "%.2f", props.gain.min, props.gain.max, 1.00, props.gain.def);
     GainNP.fill(getDeviceName(), "CCD_GAIN", "Gain", IMAGE_CONTROLS_TAB, IP_RW, 60, IPS_IDLE);
 
+    KeepArmedSP[INDI_ENABLED].fill("INDI_ENABLED", "Enabled", ISS_OFF);
+    KeepArmedSP[INDI_DISABLED].fill("INDI_DISABLED", "Disabled", ISS_ON);
+    KeepArmedSP.fill(getDeviceName(), "KEEP_ARMED", "Keep Armed", OPTIONS_TAB, IP_RW, ISR_1OFMANY, 60, IPS_IDLE);
+    KeepArmedSP.load();
+
+    SetupOverheadNP[SETUP_LAST].fill("LAST", "Last (ms)", "%.1f", 0, 1e6, 0, 0);
+    SetupOverheadNP[SETUP_AVERAGE].fill("AVERAGE", "Average (ms)", "%.1f", 0, 1e6, 0, 0);
+    SetupOverheadNP.fill(getDeviceName(), "SETUP_OVERHEAD", "Setup Overhead", OPTIONS_TAB, IP_RO, 60, IPS_IDLE);
+
     uint32_t cap = 0;
     cap |= CCD_HAS_BAYER;
     cap |= CCD_HAS_STREAMING;
@@ -814,6 +970,8 @@ bool INDILibCamera::updateProperties()
         defineProperty(AdjustAwbModeSP);
         defineProperty(AdjustMeteringModeSP);
         defineProperty(AdjustDenoiseModeSP);
+        defineProperty(KeepArmedSP);
+        defineProperty(SetupOverheadNP);
     }
     else
     {
@@ -824,6 +982,8 @@ bool INDILibCamera::updateProperties()
         deleteProperty(AdjustAwbModeSP);
         deleteProperty(AdjustMeteringModeSP);
         deleteProperty(AdjustDenoiseModeSP);
+        deleteProperty(KeepArmedSP);
+        deleteProperty(SetupOverheadNP);
     }
 
     return true;
@@ -834,9 +994,6 @@ bool INDILibCamera::updateProperties()
 /////////////////////////////////////////////////////////////////////////////
 void INDILibCamera::configureStillOptions(StillOptions *options, double duration)
 {
-    TimeVal<std::chrono::microseconds> tv;
-    tv.set(std::to_string(duration) + "s");
-
     int argc = 1;
     char *argv[] = { (char*)"indi_libcamera_ccd", nullptr };
     if (isDebug())
@@ -854,6 +1011,20 @@ void INDILibCamera::configureStillOptions(StillOptions *options, double duration
     options->Set().thumb_width = 0; // thumb_quality is now thumb_width, thumb_height, thumb_quality
     options->Set().thumb_height = 0;
     options->Set().thumb_quality = 0;
+
+    updateStillControls(options, duration);
+
+    options->Set().width = PrimaryCCD.getSubW();
+    options->Set().height = PrimaryCCD.getSubH();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// Per exposure settings, applied as controls when the camera is started.
+/////////////////////////////////////////////////////////////////////////////
+void INDILibCamera::updateStillControls(StillOptions *options, double duration)
+{
+    TimeVal<std::chrono::microseconds> tv;
+    tv.set(std::to_string(duration) + "s");
     options->Set().shutter = tv;
 
     options->Set().brightness = AdjustmentNP[AdjustBrightness].getValue();
@@ -871,9 +1042,6 @@ void INDILibCamera::configureStillOptions(StillOptions *options, double duration
     options->Set().awb_index = AdjustAwbModeSP.findOnSwitchIndex();
     options->Set().metering_index = AdjustMeteringModeSP.findOnSwitchIndex();
     options->Set().denoise = AdjustDenoiseModeSP.findOnSwitch()->getName();
-
-    options->Set().width = PrimaryCCD.getSubW();
-    options->Set().height = PrimaryCCD.getSubH();
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -952,6 +1120,7 @@ bool INDILibCamera::Disconnect()
 {
     LOGF_INFO("Disconnecting from %s", getDeviceName());
     m_Worker.quit();
+    releaseStillSession();
     return true;
 }
 
@@ -1062,6 +1231,19 @@ bool INDILibCamera::ISNewSwitch(const char *dev, const char *name, ISState * sta
             }, true);
             return true;
         }
+
+        // Keep camera armed between exposures. A session left armed is released by the next
+        // exposure, streaming or disconnect, never under an exposure in progress.
+        if (KeepArmedSP.isNameMatch(name))
+        {
+            updateProperty(KeepArmedSP, states, names, n, [this]()
+            {
+                m_SetupOverheadTotal = 0;
+                m_SetupOverheadCount = 0;
+                return true;
+            }, true);
+            return true;
+        }
     }
 
     return INDI::CCD::ISNewSwitch(dev, name, states, names, n);
@@ -1205,6 +1387,7 @@ bool INDILibCamera::saveConfigItems(FILE * fp)
     AdjustAwbModeSP.save(fp);
     AdjustMeteringModeSP.save(fp);
     AdjustDenoiseModeSP.save(fp);
+    KeepArmedSP.save(fp);
 
     return true;
 }
@@ -1228,6 +1411,67 @@ bool INDILibCamera::SetCaptureFormat(uint8_t index)
     return true;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+/// Unpack a raw Bayer or mono stream buffer into 8 or 16 bit samples. Returns
+/// false for formats that need the DNG path (e.g. PiSP compressed raw).
+/////////////////////////////////////////////////////////////////////////////
+bool INDILibCamera::unpackRAW(const libcamera::Span<uint8_t> &mem, const StreamInfo &info, uint8_t **memptr,
+                              size_t *memsize, int *w, int *h, int *bitsperpixel, char *bayer_pattern)
+{
+    auto format = std::find_if(std::begin(RawFormats), std::end(RawFormats), [&info](const auto & it)
+    {
+        return it.format == info.pixel_format;
+    });
+
+    if (format == std::end(RawFormats))
+    {
+        LOGF_DEBUG("Raw format %s is not unpacked directly, using DNG.", info.pixel_format.toString().c_str());
+        return false;
+    }
+
+    *w            = info.width;
+    *h            = info.height;
+    *bitsperpixel = format->bits == 8 ? 8 : 16;
+    strncpy(bayer_pattern, format->bayer, 8);
+
+    size_t rowBytes = *w * *bitsperpixel / 8;
+    size_t srcRowBytes = rowBytes;
+    if (format->packed)
+        srcRowBytes = format->bits == 10 ? (*w + 3) / 4 * 5 : (*w + 1) / 2 * 3;
+
+    if (mem.size() < static_cast<size_t>(info.stride) * (*h - 1) + srcRowBytes)
+    {
+        LOGF_ERROR("Raw buffer too small: %zu bytes for %dx%d stride %d.", mem.size(), *w, *h, info.stride);
+        return false;
+    }
+
+    *memsize = rowBytes * *h;
+    *memptr  = static_cast<uint8_t *>(IDSharedBlobRealloc(*memptr, *memsize));
+    if (*memptr == nullptr)
+        *memptr = static_cast<uint8_t *>(IDSharedBlobAlloc(*memsize));
+    if (*memptr == nullptr)
+    {
+        LOGF_ERROR("%s: Failed to allocate %d bytes of memory!", __PRETTY_FUNCTION__, *memsize);
+        return false;
+    }
+
+    for (int y = 0; y < *h; y++)
+    {
+        const uint8_t *src = mem.data() + static_cast<size_t>(y) * info.stride;
+        uint8_t *dst = *memptr + y * rowBytes;
+        if (!format->packed)
+            memcpy(dst, src, rowBytes);
+        else if (format->bits == 10)
+            PixelConvert::unpackRaw10(src, reinterpret_cast<uint16_t *>(dst), *w);
+        else
+            PixelConvert::unpackRaw12(src, reinterpret_cast<uint16_t *>(dst), *w);
+    }
+
+    LOGF_DEBUG("Unpacked %s %dx%d stride %d (%s).", info.pixel_format.toString().c_str(), *w, *h, info.stride,
+               PixelConvert::simdLevel());
+    return true;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 ///
 /////////////////////////////////////////////////////////////////////////////
@@ -119,6 +119,7 @@ class INDILibCamera : public INDI::CCD
         void initSwitch(INDI::PropertySwitch &switchSP, int n, const char **names);
 
         void configureStillOptions(StillOptions *options, double duration);
+        void updateStillControls(StillOptions *options, double duration);
         void configureVideoOptions(VideoOptions *options, double framerate);
 
 
@@ -132,6 +133,9 @@ class INDILibCamera : public INDI::CCD
             CAPTURE_JPG
         };
 
+        bool unpackRAW(const libcamera::Span<uint8_t> &mem, const StreamInfo &info, uint8_t **memptr, size_t *memsize,
+                       int *w, int *h, int *bitsperpixel, char *bayer_pattern);
+
         bool processRAW(const char *filename, uint8_t **memptr, size_t *memsize, int *n_axis, int *w, int *h, int *bitsperpixel,
                         char *bayer_pattern);
 
@@ -158,6 +162,15 @@ class INDILibCamera : public INDI::CCD
         INDI::PropertyNumber AdjustmentNP {AdjustAwbBlue + 1};
         INDI::PropertyNumber GainNP {1};
 
+        // Keep the still pipeline configured between exposures
+        INDI::PropertySwitch KeepArmedSP {2};
+        INDI::PropertyNumber SetupOverheadNP {2};
+        enum
+        {
+            SETUP_LAST,
+            SETUP_AVERAGE
+        };
+
         // std::unique_ptr<RPiCamApp> m_CameraApp;
         // std::unique_ptr<RPiCamEncoder> m_CameraEncoder;
 
@@ -170,4 +183,30 @@ class INDILibCamera : public INDI::CCD
         libcamera::ControlList m_ControlList;
 
         RpiCamProperties getAvailableCamProperties();
+
+        /** Settings that need a new ConfigureStill when they change */
+        struct StillSessionKey
+        {
+            uint32_t width {0}, height {0}, binning {0};
+            int format {-1};
+            double gain {0};
+            int denoise {-1};
+
+            bool operator==(const StillSessionKey &other) const
+            {
+                return width == other.width && height == other.height && binning == other.binning &&
+                       format == other.format && gain == other.gain && denoise == other.denoise;
+            }
+        };
+
+        StillSessionKey currentStillSessionKey();
+        void closeStillApp(RPiCamINDIApp &app);
+        void releaseStillSession();
+        void updateSetupOverhead(double ms, bool reused);
+
+        // Still capture session, only touched from the worker thread
+        std::unique_ptr<RPiCamINDIApp> m_StillApp;
+        StillSessionKey m_StillKey;
+        double m_SetupOverheadTotal {0};
+        uint32_t m_SetupOverheadCount {0};
 };
@@ -19,11 +19,14 @@
 
 #include "indi_limesdr_receiver.h"
 #include <stdio.h>
+#include <string.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <indilogger.h>
 #include <memory>
 #include <deque>
+#include <cmath>
+#include <algorithm>
 
 #define min(a, b)               \
     ({                          \
@@ -37,19 +40,35 @@
 #define MIN_FRAME_SIZE (512)
 #define MAX_FRAME_SIZE (SUBFRAME_SIZE * 16)
 #define SPECTRUM_SIZE  (256)
+// LMS FIFO in samples, the receive thread keeps it drained so it does not grow with the integration
+#define FIFO_SIZE      (SUBFRAME_SIZE * 64)
+#define RECV_TIMEOUT   (1000)
 
 static class Loader
 {
 public:
     std::deque<std::unique_ptr<LIMESDR>> receivers;
-    lms_info_str_t *lime_dev_list;
+    std::unique_ptr<lms_info_str_t[]> lime_dev_list;
 public:
     Loader()
     {
-        int iNumofConnectedReceivers = LMS_GetDeviceList(lime_dev_list);
+        int iNumofConnectedReceivers = LMS_GetDeviceList(nullptr);
+        if (iNumofConnectedReceivers > 0)
+        {
+            lime_dev_list.reset(new lms_info_str_t[iNumofConnectedReceivers]);
+            iNumofConnectedReceivers = LMS_GetDeviceList(lime_dev_list.get());
+        }
 
         if (iNumofConnectedReceivers <= 0)
         {
+            // A recording can stand in for the hardware, e.g. to test the driver.
+            const char *replay = getenv("LIMESDR_REPLAY_FILE");
+            if (replay != nullptr && replay[0] != '\0')
+            {
+                receivers.push_back(std::unique_ptr<LIMESDR>(new LIMESDR(0, replay, false)));
+                return;
+            }
+
             //Try sending IDMessage as well?
             IDLog("No LIMESDR receivers detected. Power on?");
             IDMessage(nullptr, "No LIMESDR receivers detected. Power on?");
@@ -58,26 +77,44 @@ public:
 
         for (int i = 0; i < iNumofConnectedReceivers; i++)
         {
-            receivers.push_back(std::unique_ptr<LIMESDR>(new LIMESDR(i)));
+            receivers.push_back(std::unique_ptr<LIMESDR>(new LIMESDR(i, getenv("LIMESDR_REPLAY_FILE"))));
         }
     }
 } loader;
 
-LIMESDR::LIMESDR(uint32_t index)
+LIMESDR::LIMESDR(uint32_t index, const char *replayFile, bool hasHardware)
 {
     InIntegration = false;
     receiverIndex = index;
+    replayOnly = !hasHardware;
+    IUFillText(&ReplayFileT[0], "REPLAY_FILE", "cf32 File", replayFile ? replayFile : "");
 
     char name[MAXINDIDEVICE];
     snprintf(name, MAXINDIDEVICE, "%s %d", getDefaultName(), index);
     setDeviceName(name);
 }
 
+LIMESDR::~LIMESDR()
+{
+    stopReceiver();
+}
+
 /**************************************************************************************
 ** Client is asking us to establish connection to the device
 ***************************************************************************************/
 bool LIMESDR::Connect()
 {
+    if (isSimulation())
+    {
+        LOGF_INFO("LIME-SDR Receiver simulated, replaying %s.", ReplayFileT[0].text);
+        return true;
+    }
+    if (replayOnly)
+    {
+        LOG_ERROR("No LIME-SDR hardware, enable simulation to replay a recording.");
+        return false;
+    }
+
     int r = LMS_Open(&lime_dev, loader.lime_dev_list[receiverIndex], NULL);
     if (r < 0)
     {
@@ -99,8 +136,11 @@ bool LIMESDR::Connect()
 ***************************************************************************************/
 bool LIMESDR::Disconnect()
 {
+    stopReceiver();
     InIntegration = false;
-    LMS_Close(lime_dev);
+    if (lime_dev != nullptr)
+        LMS_Close(lime_dev);
+    lime_dev = nullptr;
     setBufferSize(1);
     LOG_INFO("LIME-SDR Receiver disconnected successfully!");
     return true;
@@ -133,6 +173,32 @@ bool LIMESDR::initProperties()
     setMinMaxStep("RECEIVER_SETTINGS", "RECEIVER_BANDWIDTH", 400.0e+6, 3.8e+9, 1, false);
     setMinMaxStep("RECEIVER_SETTINGS", "RECEIVER_BITSPERSAMPLE", -32, -32, 0, false);
     setIntegrationFileExtension("fits");
+
+    IUFillNumber(&SpectrumSettingsN[SPECTRUM_BINS], "SPECTRUM_BINS", "Bins", "%.f",
+                 SpectrumAccumulator::MIN_BINS, SpectrumAccumulator::MAX_BINS, 0, SPECTRUM_SIZE);
+    IUFillNumber(&SpectrumSettingsN[SPECTRUM_PUBLISH], "SPECTRUM_PUBLISH", "Publish (s)", "%.1f", 0.5, 3600, 0.5, 1);
+    IUFillNumberVector(&SpectrumSettingsNP, SpectrumSettingsN, 2, getDeviceName(), "LIME_SPECTRUM_SETTINGS", "Spectrum",
+                       OPTIONS_TAB, IP_RW, 60, IPS_IDLE);
+
+    IUFillSwitch(&OutputS[OUTPUT_RAW], "OUTPUT_RAW", "Raw samples", ISS_ON);
+    IUFillSwitch(&OutputS[OUTPUT_SPECTRUM], "OUTPUT_SPECTRUM", "Spectrum", ISS_OFF);
+    IUFillSwitchVector(&OutputSP, OutputS, 2, getDeviceName(), "LIME_OUTPUT", "Output", OPTIONS_TAB, IP_RW, ISR_1OFMANY,
+                       60, IPS_IDLE);
+
+    IUFillNumber(&IntegrationStatsN[STATS_SAMPLES], "STATS_SAMPLES", "Samples", "%.f", 0, 1e15, 0, 0);
+    IUFillNumber(&IntegrationStatsN[STATS_POWER], "STATS_POWER", "Total power (dB)", "%.2f", -400, 400, 0, 0);
+    IUFillNumber(&IntegrationStatsN[STATS_PEAK], "STATS_PEAK", "Peak (Hz)", "%.f", 0, 1e10, 0, 0);
+    IUFillNumber(&IntegrationStatsN[STATS_DROPPED], "STATS_DROPPED", "Dropped", "%.f", 0, 1e15, 0, 0);
+    IUFillNumberVector(&IntegrationStatsNP, IntegrationStatsN, 4, getDeviceName(), "LIME_INTEGRATION_STATS", "Progress",
+                       MAIN_CONTROL_TAB, IP_RO, 60, IPS_IDLE);
+
+    IUFillBLOB(&PartialB[0], "SPECTRUM", "Spectrum", ".f32");
+    IUFillBLOB(&PartialB[1], "CONTINUUM", "Continuum", ".f32");
+    IUFillBLOBVector(&PartialBP, PartialB, 2, getDeviceName(), "LIME_PARTIAL", "Partial", MAIN_CONTROL_TAB, IP_RO, 60,
+                     IPS_IDLE);
+
+    IUFillTextVector(&ReplayFileTP, ReplayFileT, 1, getDeviceName(), "LIME_REPLAY", "Replay", OPTIONS_TAB, IP_RW, 60,
+                     IPS_IDLE);
     /*
     // PrimaryReceiver Device Continuum Blob
     IUFillBLOB(&TFitsB[0], "TRMT", "Transmit1", "");
@@ -144,6 +210,8 @@ bool LIMESDR::initProperties()
 */
     // Add Debug, Simulator, and Configuration controls
     addAuxControls();
+    if (replayOnly)
+        setSimulation(true);
 
     setDefaultPollingPeriod(500);
 
@@ -164,6 +232,14 @@ bool LIMESDR::updateProperties()
         // Inital values
         setupParams(1000000, 1420000000, 10000, 10);
         //defineProperty(&TFitsBP);
+        defineProperty(&SpectrumSettingsNP);
+        loadConfig(true, SpectrumSettingsNP.name);
+        defineProperty(&OutputSP);
+        loadConfig(true, OutputSP.name);
+        defineProperty(&IntegrationStatsNP);
+        defineProperty(&PartialBP);
+        defineProperty(&ReplayFileTP);
+        loadConfig(true, ReplayFileTP.name);
 
         // Start the timer
         SetTimer(getCurrentPollingPeriod());
@@ -171,6 +247,11 @@ bool LIMESDR::updateProperties()
     else
     {
         //deleteProperty(TFitsBP.name);
+        deleteProperty(SpectrumSettingsNP.name);
+        deleteProperty(OutputSP.name);
+        deleteProperty(IntegrationStatsNP.name);
+        deleteProperty(PartialBP.name);
+        deleteProperty(ReplayFileTP.name);
     }
 
     return true;
@@ -185,22 +266,53 @@ bool LIMESDR::StartIntegration(double duration)
 
     // Since we have only have one Receiver with one chip, we set the exposure duration of the primary Receiver
     setIntegrationTime(duration);
-    b_read  = 0;
-    to_read = getSampleRate() * getIntegrationTime();
-
-    setBufferSize(to_read * sizeof(float));
+    to_read = static_cast<uint64_t>(getSampleRate() * getIntegrationTime());
 
     if (to_read > 0)
     {
-        lime_stream.channel             = 0;
-        lime_stream.isTx                = false;
-        lime_stream.fifoSize            = to_read;
-        lime_stream.dataFmt             = lms_stream_t::LMS_FMT_F32;
-        lime_stream.throughputVsLatency = 0.5;
-        LMS_SetupStream(lime_dev, &lime_stream);
-        LMS_StartStream(&lime_stream);
+        stopReceiver();
+
+        if (isSimulation())
+            source.reset(new FileIQSource(ReplayFileT[0].text));
+        else
+            source.reset(new LimeIQSource(lime_dev, FIFO_SIZE));
+
+        if (!source->start(getSampleRate()))
+        {
+            LOG_ERROR(isSimulation() ? "Failed to open the replay file." : "Failed to start the receive stream.");
+            source.reset();
+            return false;
+        }
+
+        // The spectrum needs memory for the bins only, raw output keeps every I/Q pair.
+        size_t bins;
+        {
+            std::lock_guard<std::mutex> lock(accumulatorMutex);
+            accumulator.setBins(static_cast<size_t>(SpectrumSettingsN[SPECTRUM_BINS].value));
+            bins = accumulator.bins();
+        }
+        spectrumOut.resize(bins);
+        continuumOut.resize(SpectrumAccumulator::CONTINUUM_POINTS);
+        if (OutputS[OUTPUT_SPECTRUM].s == ISS_ON)
+        {
+            setBufferSize(bins * sizeof(float));
+            rawOut = nullptr;
+        }
+        else
+        {
+            setBufferSize(to_read * 2 * sizeof(float));
+            rawOut = reinterpret_cast<float *>(getBuffer());
+        }
+
+        receiveAbort = false;
+        receiveDone  = false;
+        receiveError = false;
+        receiveThread = std::thread(&LIMESDR::receiveLoop, this);
+
         gettimeofday(&CapStart, nullptr);
+        LastPublish = CapStart;
         InIntegration = true;
+        IntegrationStatsNP.s = IPS_BUSY;
         LOG_INFO("Integration started...");
         return true;
     }
@@ -209,12 +321,87 @@ bool LIMESDR::StartIntegration(double duration)
     return false;
 }
 
+/**************************************************************************************
+** Receive thread, reduces fixed blocks of samples until the integration is complete
+***************************************************************************************/
+void LIMESDR::receiveLoop()
+{
+    std::vector<float> block(SUBFRAME_SIZE * 2);
+    uint64_t received = 0;
+
+    while (!receiveAbort && received < to_read)
+    {
+        size_t count = static_cast<size_t>(min(static_cast<uint64_t>(SUBFRAME_SIZE), to_read - received));
+        int n = source->read(block.data(), count, RECV_TIMEOUT);
+        if (n < 0)
+        {
+            receiveError = true;
+            break;
+        }
+        if (n == 0)
+            continue;
+
+        if (rawOut != nullptr)
+            memcpy(rawOut + 2 * received, block.data(), n * 2 * sizeof(float));
+
+        std::lock_guard<std::mutex> lock(accumulatorMutex);
+        accumulator.add(block.data(), n);
+        received += n;
+    }
+
+    receiveDone = true;
+}
+
+void LIMESDR::stopReceiver()
+{
+    receiveAbort = true;
+    if (receiveThread.joinable())
+        receiveThread.join();
+    source.reset();
+}
+
+/**************************************************************************************
+** Send the spectrum and continuum accumulated so far
+***************************************************************************************/
+void LIMESDR::publishPartial()
+{
+    size_t bins = spectrumOut.size();
+    size_t points;
+    uint64_t samples;
+    double power;
+    {
+        std::lock_guard<std::mutex> lock(accumulatorMutex);
+        accumulator.spectrum(spectrumOut.data());
+        points  = accumulator.continuum(continuumOut.data());
+        samples = accumulator.samples();
+        power   = accumulator.totalPower();
+    }
+
+    size_t peak = std::max_element(spectrumOut.begin(), spectrumOut.end()) - spectrumOut.begin();
+    IntegrationStatsN[STATS_SAMPLES].value = samples;
+    IntegrationStatsN[STATS_POWER].value   = power > 0 ? 10.0 * log10(power) : -400;
+    IntegrationStatsN[STATS_PEAK].value    = getFrequency() + (static_cast<double>(peak) - bins / 2.0) * getSampleRate() / bins;
+    IntegrationStatsN[STATS_DROPPED].value = source ? source->dropped() : 0;
+    IDSetNumber(&IntegrationStatsNP, nullptr);
+
+    PartialB[0].blob    = spectrumOut.data();
+    PartialB[0].bloblen = PartialB[0].size = static_cast<int>(bins * sizeof(float));
+    PartialB[1].blob    = continuumOut.data();
+    PartialB[1].bloblen = PartialB[1].size = static_cast<int>(points * sizeof(float));
+    PartialBP.s = IPS_OK;
+    IDSetBLOB(&PartialBP, nullptr);
+
+    gettimeofday(&LastPublish, nullptr);
+}
+
 /**************************************************************************************
 ** Client is updating capture settings
 ***************************************************************************************/
 void LIMESDR::setupParams(float sr, float freq, float bw, float gain)
 {
     setBPS(-32);
+    if (lime_dev == nullptr)
+        return;
     int r = 0;
     r |= LMS_SetAntenna(lime_dev, LMS_CH_RX, 0, 0);
     r |= LMS_SetNormalizedGain(lime_dev, LMS_CH_RX, 0, gain);
@@ -245,9 +432,51 @@ bool LIMESDR::ISNewNumber(const char *dev, const char *name, double values[], ch
         }
         IDSetNumber(&ReceiverSettingsNP, nullptr);
     }
+    if (dev && !strcmp(dev, getDeviceName()) && !strcmp(name, SpectrumSettingsNP.name))
+    {
+        // Applies from the next integration
+        IUUpdateNumber(&SpectrumSettingsNP, values, names, n);
+        SpectrumSettingsNP.s = IPS_OK;
+        IDSetNumber(&SpectrumSettingsNP, nullptr);
+        return true;
+    }
     return processNumber(dev, name, values, names, n) & !r;
 }
 
+bool LIMESDR::ISNewText(const char *dev, const char *name, char *texts[], char *names[], int n)
+{
+    if (dev && !strcmp(dev, getDeviceName()) && !strcmp(name, ReplayFileTP.name))
+    {
+        IUUpdateText(&ReplayFileTP, texts, names, n);
+        ReplayFileTP.s = IPS_OK;
+        IDSetText(&ReplayFileTP, nullptr);
+        return true;
+    }
+    return INDI::Receiver::ISNewText(dev, name, texts, names, n);
+}
+
+bool LIMESDR::ISNewSwitch(const char *dev, const char *name, ISState *states, char *names[], int n)
+{
+    if (dev && !strcmp(dev, getDeviceName()) && !strcmp(name, OutputSP.name))
+    {
+        // Applies from the next integration
+        IUUpdateSwitch(&OutputSP, states, names, n);
+        OutputSP.s = IPS_OK;
+        IDSetSwitch(&OutputSP, nullptr);
+        return true;
+    }
+    return INDI::Receiver::ISNewSwitch(dev, name, states, names, n);
+}
+
+bool LIMESDR::saveConfigItems(FILE *fp)
+{
+    INDI::Receiver::saveConfigItems(fp);
+    IUSaveConfigNumber(fp, &SpectrumSettingsNP);
+    IUSaveConfigSwitch(fp, &OutputSP);
+    IUSaveConfigText(fp, &ReplayFileTP);
+    return true;
+}
+
 /**************************************************************************************
 ** Client is asking us to abort a capture
 ***************************************************************************************/
@@ -255,14 +484,10 @@ bool LIMESDR::AbortIntegration()
 {
     if (InIntegration)
     {
-        lms_stream_status_t status;
-        LMS_GetStreamStatus(&lime_stream, &status);
-        if (status.fifoFilledCount <= 0)
-        {
-            InIntegration = false;
-            LMS_StopStream(&lime_stream);
-            LMS_DestroyStream(lime_dev, &lime_stream);
-        }
+        stopReceiver();
+        InIntegration = false;
+        IntegrationStatsNP.s = IPS_IDLE;
+        IDSetNumber(&IntegrationStatsNP, nullptr);
     }
     return true;
 }
@@ -298,22 +523,32 @@ void LIMESDR::TimerHit()
     if (InIntegration)
     {
         timeleft = CalcTimeLeft();
-        if (timeleft < 0.1)
+        if (receiveDone)
         {
             /* We're done capturing */
-            LOG_INFO("Integration done, expecting data...");
-            lms_stream_status_t status;
-            LMS_GetStreamStatus(&lime_stream, &status);
-            if (status.active)
+            receiveThread.join();
+            if (receiveError)
             {
-                if (status.fifoFilledCount >= status.fifoSize)
-                {
-                    n_read = status.fifoFilledCount;
-                    grabData();
-                }
+                LOG_ERROR("Receive stream failed, integration aborted.");
+                source.reset();
+                InIntegration = false;
+                IntegrationStatsNP.s = IPS_ALERT;
+                IDSetNumber(&IntegrationStatsNP, nullptr);
             }
+            else
+                grabData();
             timeleft = 0.0;
         }
+        else
+        {
+            struct timeval now;
+            gettimeofday(&now, nullptr);
+            double sincePublish = (now.tv_sec - LastPublish.tv_sec) + (now.tv_usec - LastPublish.tv_usec) / 1e6;
+            if (sincePublish >= SpectrumSettingsN[SPECTRUM_PUBLISH].value)
+                publishPartial();
+            if (timeleft < 0)
+                timeleft = 0;
+        }
 
         // This is an over simplified timing method, check ReceiverSimulator and limesdrReceiver for better timing checks
         setIntegrationLeft(timeleft);
@@ -330,12 +565,14 @@ void LIMESDR::grabData()
 {
     if (InIntegration)
     {
-        continuum = getBuffer();
-        LOG_INFO("Downloading...");
-        LMS_RecvStream(&lime_stream, continuum, n_read, NULL, 1000);
-        LMS_StopStream(&lime_stream);
-        LMS_DestroyStream(lime_dev, &lime_stream);
+        publishPartial();
+        source.reset();
+        // Raw samples are already in the buffer
+        if (rawOut == nullptr)
+            memcpy(getBuffer(), spectrumOut.data(), spectrumOut.size() * sizeof(float));
         InIntegration = false;
+        IntegrationStatsNP.s = IPS_OK;
+        IDSetNumber(&IntegrationStatsNP, nullptr);
 
         LOG_INFO("Download complete.");
         IntegrationComplete();
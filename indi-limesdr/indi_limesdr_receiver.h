@@ -21,6 +21,15 @@
 
 #include <lime/LimeSuite.h>
 #include "indireceiver.h"
+#include "limesdr_iqsource.h"
+#include "limesdr_spectrum.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 enum Settings
 {
@@ -32,9 +41,12 @@ enum Settings
 class LIMESDR : public INDI::Receiver
 {
   public:
-    LIMESDR(uint32_t index);
+    LIMESDR(uint32_t index, const char *replayFile = nullptr, bool hasHardware = true);
+    ~LIMESDR() override;
 
     bool ISNewNumber(const char *dev, const char *name, double values[], char *names[], int n) override;
+    bool ISNewText(const char *dev, const char *name, char *texts[], char *names[], int n) override;
+    bool ISNewSwitch(const char *dev, const char *name, ISState *states, char *names[], int n) override;
 
   protected:
 	// General device functions
@@ -43,6 +55,7 @@ class LIMESDR : public INDI::Receiver
 	const char *getDefaultName() override;
 	bool initProperties() override;
 	bool updateProperties() override;
+    bool saveConfigItems(FILE *fp) override;
 
     // Receiver specific functions
     bool StartIntegration(double duration) override;
@@ -57,20 +70,69 @@ class LIMESDR : public INDI::Receiver
 	// Utility functions
 	float CalcTimeLeft();
     void setupParams(float sr, float freq, float bw, float gain);
-    lms_stream_t lime_stream;
+    void stopReceiver();
+    // Receive thread: reads fixed blocks from the source into the accumulator
+    void receiveLoop();
+    // Send the spectrum and continuum accumulated so far
+    void publishPartial();
+    std::unique_ptr<IQSource> source;
+    std::thread receiveThread;
+    std::atomic<bool> receiveAbort { false };
+    std::atomic<bool> receiveDone { false };
+    std::atomic<bool> receiveError { false };
+    // Guards accumulator, read by the main thread for partial results
+    std::mutex accumulatorMutex;
+    SpectrumAccumulator accumulator;
+    std::vector<float> spectrumOut;
+    std::vector<float> continuumOut;
+    // Integration buffer the receive thread copies raw samples to, null for spectrum output
+    float *rawOut { nullptr };
 	// Are we exposing?
     bool InIntegration;
 	// Struct to keep timing
 	struct timeval CapStart;
-    int to_read;
-    int b_read;
-    int n_read;
+    struct timeval LastPublish;
+    uint64_t to_read;
     float IntegrationRequest;
-	uint8_t* continuum;
-    uint8_t *spectrum;
 
     uint32_t receiverIndex = { 0 };
+    // No device attached, only the replay source is available
+    bool replayOnly = { false };
+
+    // Spectrum settings
+    INumber SpectrumSettingsN[2];
+    INumberVectorProperty SpectrumSettingsNP;
+    enum
+    {
+        SPECTRUM_BINS,
+        SPECTRUM_PUBLISH
+    };
+
+    // What the integration result holds
+    ISwitch OutputS[2];
+    ISwitchVectorProperty OutputSP;
+    enum
+    {
+        OUTPUT_RAW,
+        OUTPUT_SPECTRUM
+    };
+
+    // Progress of the running integration
+    INumber IntegrationStatsN[4];
+    INumberVectorProperty IntegrationStatsNP;
+    enum
+    {
+        STATS_SAMPLES,
+        STATS_POWER,
+        STATS_PEAK,
+        STATS_DROPPED
+    };
+
+    // Partial spectrum and continuum, raw float32
+    IBLOB PartialB[2];
+    IBLOBVectorProperty PartialBP;
 
-    IBLOB TFitsB[5];
-    IBLOBVectorProperty TFitsBP;
+    // Recorded cf32 file used instead of the hardware in simulation
+    IText ReplayFileT[1] {};
+    ITextVectorProperty ReplayFileTP;
 };
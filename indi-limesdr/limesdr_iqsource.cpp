@@ -0,0 +1,142 @@
+/*
+    indi_LMS_receiver - I/Q sample sources
+    Copyright (C) 2026  agent
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "limesdr_iqsource.h"
+
+#include <algorithm>
+#include <thread>
+
+LimeIQSource::LimeIQSource(lms_device_t *device, uint32_t fifoSize) : m_Device(device), m_FifoSize(fifoSize)
+{
+}
+
+LimeIQSource::~LimeIQSource()
+{
+    stop();
+}
+
+bool LimeIQSource::start(double)
+{
+    m_Stream.channel             = 0;
+    m_Stream.isTx                = false;
+    m_Stream.fifoSize            = m_FifoSize;
+    m_Stream.dataFmt             = lms_stream_t::LMS_FMT_F32;
+    m_Stream.throughputVsLatency = 0.5;
+    if (LMS_SetupStream(m_Device, &m_Stream) != 0)
+        return false;
+
+    if (LMS_StartStream(&m_Stream) != 0)
+    {
+        LMS_DestroyStream(m_Device, &m_Stream);
+        return false;
+    }
+
+    m_Running = true;
+    return true;
+}
+
+int LimeIQSource::read(float *iq, size_t count, unsigned timeoutMs)
+{
+    return LMS_RecvStream(&m_Stream, iq, count, nullptr, timeoutMs);
+}
+
+void LimeIQSource::stop()
+{
+    if (!m_Running)
+        return;
+
+    LMS_StopStream(&m_Stream);
+    LMS_DestroyStream(m_Device, &m_Stream);
+    m_Running = false;
+}
+
+uint32_t LimeIQSource::dropped()
+{
+    lms_stream_status_t status;
+    if (!m_Running || LMS_GetStreamStatus(&m_Stream, &status) != 0)
+        return 0;
+    return status.droppedPackets + status.overrun;
+}
+
+FileIQSource::FileIQSource(const std::string &path, bool realtime) : m_Path(path), m_Realtime(realtime)
+{
+}
+
+FileIQSource::~FileIQSource()
+{
+    stop();
+}
+
+bool FileIQSource::start(double sampleRate)
+{
+    stop();
+    m_File = fopen(m_Path.c_str(), "rb");
+    if (m_File == nullptr)
+        return false;
+
+    m_SampleRate = sampleRate;
+    m_Samples    = 0;
+    m_Start      = std::chrono::steady_clock::now();
+    return true;
+}
+
+int FileIQSource::read(float *iq, size_t count, unsigned timeoutMs)
+{
+    if (m_File == nullptr)
+        return -1;
+
+    if (m_Realtime && m_SampleRate > 0)
+    {
+        // Hand out samples no faster than the hardware would deliver them.
+        auto due = m_Start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                       std::chrono::duration<double>((m_Samples + count) / m_SampleRate));
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        std::this_thread::sleep_until(std::min(due, deadline));
+        if (due > deadline)
+            return 0;
+    }
+
+    size_t got = 0;
+    bool rewound = false;
+    while (got < count)
+    {
+        size_t n = fread(iq + 2 * got, 2 * sizeof(float), count - got, m_File);
+        got += n;
+        if (got < count)
+        {
+            // Loop the recording, but give up on a file without a single sample.
+            if (ferror(m_File) || (rewound && n == 0))
+                return got > 0 ? static_cast<int>(got) : -1;
+            rewind(m_File);
+            rewound = (n == 0);
+        }
+    }
+
+    m_Samples += got;
+    return static_cast<int>(got);
+}
+
+void FileIQSource::stop()
+{
+    if (m_File != nullptr)
+    {
+        fclose(m_File);
+        m_File = nullptr;
+    }
+}
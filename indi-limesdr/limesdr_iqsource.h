@@ -0,0 +1,87 @@
+/*
+    indi_LMS_receiver - I/Q sample sources
+    Copyright (C) 2026  agent
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#pragma once
+
+#include <lime/LimeSuite.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// Source of complex samples for the receive thread, as interleaved float I/Q pairs.
+class IQSource
+{
+    public:
+        virtual ~IQSource() = default;
+
+        virtual bool start(double sampleRate) = 0;
+        /** Read up to count samples, returns the number read or -1 on error. */
+        virtual int read(float *iq, size_t count, unsigned timeoutMs) = 0;
+        virtual void stop() = 0;
+
+        /** Samples lost by the source since start, e.g. FIFO overruns. */
+        virtual uint32_t dropped()
+        {
+            return 0;
+        }
+};
+
+// LMS RX stream with a fixed FIFO, independent of the integration length.
+class LimeIQSource : public IQSource
+{
+    public:
+        LimeIQSource(lms_device_t *device, uint32_t fifoSize);
+        ~LimeIQSource() override;
+
+        bool start(double sampleRate) override;
+        int read(float *iq, size_t count, unsigned timeoutMs) override;
+        void stop() override;
+        uint32_t dropped() override;
+
+    private:
+        lms_device_t *m_Device {nullptr};
+        lms_stream_t m_Stream {};
+        uint32_t m_FifoSize {0};
+        bool m_Running {false};
+};
+
+// Replays a recorded complex float32 (cf32) file, looping at the end, so the
+// driver can run without hardware. In real time mode reads are paced to the
+// sample rate like the hardware stream.
+class FileIQSource : public IQSource
+{
+    public:
+        FileIQSource(const std::string &path, bool realtime = true);
+        ~FileIQSource() override;
+
+        bool start(double sampleRate) override;
+        int read(float *iq, size_t count, unsigned timeoutMs) override;
+        void stop() override;
+
+    private:
+        std::string m_Path;
+        bool m_Realtime {true};
+        FILE *m_File {nullptr};
+        double m_SampleRate {0};
+        uint64_t m_Samples {0};
+        std::chrono::steady_clock::time_point m_Start;
+};
@@ -0,0 +1,184 @@
+/*
+    indi_LMS_receiver - spectrum and continuum integration
+    Copyright (C) 2026  agent
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "limesdr_spectrum.h"
+
+#include <algorithm>
+#include <cmath>
+
+void SpectrumAccumulator::setBins(size_t bins)
+{
+    bins = std::max(MIN_BINS, std::min(MAX_BINS, bins));
+    size_t n = MIN_BINS;
+    while (n * 2 <= bins)
+        n *= 2;
+
+    if (n != mBins)
+    {
+        mBins = n;
+
+        int log2n = 0;
+        while ((size_t(1) << log2n) < n)
+            log2n++;
+
+        mWindow.resize(n);
+        mReverse.resize(n);
+        mTwiddle.resize(n / 2);
+        double energy = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+            mWindow[i] = static_cast<float>(0.5 - 0.5 * cos(2.0 * M_PI * i / n));
+            energy += static_cast<double>(mWindow[i]) * mWindow[i];
+
+            uint32_t r = 0;
+            for (int b = 0; b < log2n; b++)
+                r |= ((i >> b) & 1) << (log2n - 1 - b);
+            mReverse[i] = r;
+        }
+        for (size_t i = 0; i < n / 2; i++)
+            mTwiddle[i] = std::polar(1.0f, static_cast<float>(-2.0 * M_PI * i / n));
+
+        // With this scale the expected bin power of white noise is variance / bins.
+        mScale = 1.0 / (energy * n);
+        mWork.resize(n);
+        mPower.resize(n);
+    }
+
+    reset();
+}
+
+void SpectrumAccumulator::reset()
+{
+    std::fill(mPower.begin(), mPower.end(), 0.0);
+    mFill   = 0;
+    mFrames = 0;
+
+    mContinuum.assign(CONTINUUM_POINTS, 0.0f);
+    mPoints       = 0;
+    mPointSamples = std::max<size_t>(mBins, 1);
+    mPointSum     = 0;
+    mPointFill    = 0;
+
+    mPowerSum = 0;
+    mSamples  = 0;
+}
+
+void SpectrumAccumulator::add(const float *iq, size_t count)
+{
+    if (mBins == 0)
+        return;
+
+    size_t i = 0;
+    while (i < count)
+    {
+        // Largest run that neither overflows the FFT frame nor the continuum point.
+        size_t run = std::min(count - i, mBins - mFill);
+        run = std::min<uint64_t>(run, mPointSamples - mPointFill);
+
+        const float *src = iq + 2 * i;
+        const float *window = mWindow.data() + mFill;
+        std::complex<float> *dst = mWork.data() + mFill;
+        double power = 0;
+        for (size_t k = 0; k < run; k++)
+        {
+            float re = src[2 * k], im = src[2 * k + 1];
+            power += re * re + im * im;
+            dst[k] = std::complex<float>(re * window[k], im * window[k]);
+        }
+
+        mPowerSum += power;
+        mPointSum += power;
+        mPointFill += run;
+        mFill += run;
+        i += run;
+
+        if (mFill == mBins)
+        {
+            transform();
+            mFill = 0;
+        }
+
+        if (mPointFill == mPointSamples)
+        {
+            mContinuum[mPoints++] = static_cast<float>(mPointSum / mPointSamples);
+            if (mPoints == CONTINUUM_POINTS)
+            {
+                for (size_t p = 0; p < CONTINUUM_POINTS / 2; p++)
+                    mContinuum[p] = 0.5f * (mContinuum[2 * p] + mContinuum[2 * p + 1]);
+                mPoints = CONTINUUM_POINTS / 2;
+                mPointSamples *= 2;
+            }
+
+            mPointSum  = 0;
+            mPointFill = 0;
+        }
+    }
+
+    mSamples += count;
+}
+
+void SpectrumAccumulator::transform()
+{
+    const size_t n = mBins;
+    std::complex<float> *x = mWork.data();
+
+    for (size_t i = 0; i < n; i++)
+    {
+        size_t r = mReverse[i];
+        if (r > i)
+            std::swap(x[i], x[r]);
+    }
+
+    for (size_t half = 1, stride = n / 2; half < n; half *= 2, stride /= 2)
+    {
+        for (size_t start = 0; start < n; start += 2 * half)
+        {
+            for (size_t k = 0; k < half; k++)
+            {
+                std::complex<float> t = mTwiddle[k * stride] * x[start + half + k];
+                x[start + half + k] = x[start + k] - t;
+                x[start + k] += t;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < n; i++)
+        mPower[i] += std::norm(x[i]);
+    mFrames++;
+}
+
+void SpectrumAccumulator::spectrum(float *out) const
+{
+    const size_t n = mBins;
+    double scale = mFrames > 0 ? mScale / mFrames : 0;
+    // Negative frequencies first so the LO frequency sits in the middle bin.
+    for (size_t i = 0; i < n; i++)
+        out[i] = static_cast<float>(mPower[(i + n / 2) % n] * scale);
+}
+
+size_t SpectrumAccumulator::continuum(float *out) const
+{
+    std::copy(mContinuum.begin(), mContinuum.begin() + mPoints, out);
+    return mPoints;
+}
+
+double SpectrumAccumulator::totalPower() const
+{
+    return mSamples > 0 ? mPowerSum / mSamples : 0;
+}
@@ -0,0 +1,103 @@
+/*
+    indi_LMS_receiver - spectrum and continuum integration
+    Copyright (C) 2026  agent
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Power spectrum and total power continuum of a complex sample stream.
+//
+// Samples are fed in blocks of any size. Every bins samples are windowed
+// (Hann) and transformed, and |X|^2 is added to a running sum, so the
+// spectrum is the Welch average of the whole integration. The continuum
+// keeps at most CONTINUUM_POINTS mean power values: when it fills up,
+// neighbouring points are merged and each point covers twice as many
+// samples. Memory therefore depends on the bin count only, never on the
+// integration length.
+class SpectrumAccumulator
+{
+    public:
+        static constexpr size_t MIN_BINS = 64;
+        static constexpr size_t MAX_BINS = 65536;
+        static constexpr size_t CONTINUUM_POINTS = 1024;
+
+        /** Bins are rounded down to a power of two within [MIN_BINS, MAX_BINS]. Resets the sums. */
+        void setBins(size_t bins);
+        size_t bins() const
+        {
+            return mBins;
+        }
+
+        /** Clear the sums, keep the bin count. */
+        void reset();
+
+        /** Add count interleaved I/Q float pairs. */
+        void add(const float *iq, size_t count);
+
+        /**
+         * @brief spectrum Mean power per bin, DC in the middle (bins values).
+         * Powers are scaled so that the bins add up to the mean sample power.
+         */
+        void spectrum(float *out) const;
+
+        /** Mean power of the completed continuum points, returns the number written. */
+        size_t continuum(float *out) const;
+
+        /** Mean |x|^2 over every sample added since the last reset. */
+        double totalPower() const;
+
+        uint64_t samples() const
+        {
+            return mSamples;
+        }
+        uint64_t frames() const
+        {
+            return mFrames;
+        }
+        /** Samples averaged in each continuum point. */
+        uint64_t samplesPerPoint() const
+        {
+            return mPointSamples;
+        }
+
+    private:
+        void transform();
+
+        size_t mBins {0};
+        std::vector<float> mWindow;
+        std::vector<std::complex<float>> mTwiddle;
+        std::vector<uint32_t> mReverse;
+        std::vector<std::complex<float>> mWork;
+        size_t mFill {0};
+        std::vector<double> mPower;
+        double mScale {0};
+        uint64_t mFrames {0};
+
+        std::vector<float> mContinuum;
+        size_t mPoints {0};
+        uint64_t mPointSamples {0};
+        double mPointSum {0};
+        uint64_t mPointFill {0};
+
+        double mPowerSum {0};
+        uint64_t mSamples {0};
+};
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "limesdr_iqsource.h"
+#include "limesdr_spectrum.h"
+
+namespace
+{
+
+// Writes count interleaved I/Q pairs produced by fn(i) to a cf32 file.
+template <typename Fn>
+std::string writeCF32(const char *name, size_t count, Fn fn)
+{
+    std::string path = ::testing::TempDir() + name;
+    FILE *f = fopen(path.c_str(), "wb");
+    for (size_t i = 0; i < count; i++)
+    {
+        float iq[2];
+        fn(i, iq);
+        fwrite(iq, sizeof(float), 2, f);
+    }
+    fclose(f);
+    return path;
+}
+
+std::string writeRamp(size_t count)
+{
+    return writeCF32("limesdr_ramp.cf32", count, [](size_t i, float *iq)
+    {
+        iq[0] = static_cast<float>(i);
+        iq[1] = -static_cast<float>(i);
+    });
+}
+
+}
+
+TEST(FileIQSource, ReadsSamplesInOrderAndLoops)
+{
+    std::string path = writeRamp(10);
+    FileIQSource source(path, false);
+    ASSERT_TRUE(source.start(1e6));
+
+    std::vector<float> iq(2 * 25);
+    ASSERT_EQ(source.read(iq.data(), 25, 100), 25);
+    for (size_t i = 0; i < 25; i++)
+    {
+        EXPECT_EQ(iq[2 * i], static_cast<float>(i % 10)) << "sample " << i;
+        EXPECT_EQ(iq[2 * i + 1], -static_cast<float>(i % 10)) << "sample " << i;
+    }
+
+    // The next read continues where the last one stopped
+    ASSERT_EQ(source.read(iq.data(), 3, 100), 3);
+    EXPECT_EQ(iq[0], 5.0f);
+    EXPECT_EQ(iq[4], 7.0f);
+
+    source.stop();
+    EXPECT_EQ(source.read(iq.data(), 1, 100), -1);
+    remove(path.c_str());
+}
+
+TEST(FileIQSource, MissingOrEmptyFileFails)
+{
+    FileIQSource missing(::testing::TempDir() + "limesdr_missing.cf32", false);
+    EXPECT_FALSE(missing.start(1e6));
+
+    std::string path = writeCF32("limesdr_empty.cf32", 0, [](size_t, float *) {});
+    FileIQSource empty(path, false);
+    ASSERT_TRUE(empty.start(1e6));
+
+    float iq[2];
+    EXPECT_EQ(empty.read(iq, 1, 100), -1);
+    remove(path.c_str());
+}
+
+TEST(FileIQSource, RealtimeIsPacedToTheSampleRate)
+{
+    std::string path = writeRamp(1000);
+    FileIQSource source(path, true);
+    ASSERT_TRUE(source.start(1000));
+
+    std::vector<float> iq(2 * 100);
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(source.read(iq.data(), 100, 1000), 100);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_GE(elapsed, 0.09);
+
+    // 100 more samples are due in 100 ms, a 10 ms timeout returns nothing
+    EXPECT_EQ(source.read(iq.data(), 100, 10), 0);
+    EXPECT_EQ(source.read(iq.data(), 100, 1000), 100);
+    EXPECT_EQ(iq[0], 100.0f);
+    remove(path.c_str());
+}
+
+TEST(FileIQSource, ReplayedToneFillsTheSpectrumBin)
+{
+    const size_t bins = 256;
+    const size_t tone = bins / 4;
+    std::string path  = writeCF32("limesdr_tone.cf32", bins * 8, [&](size_t i, float *iq)
+    {
+        double phase = 2.0 * M_PI * tone * i / bins;
+        iq[0] = static_cast<float>(cos(phase));
+        iq[1] = static_cast<float>(sin(phase));
+    });
+
+    FileIQSource source(path, false);
+    ASSERT_TRUE(source.start(1e6));
+
+    SpectrumAccumulator accumulator;
+    accumulator.setBins(bins);
+
+    // Blocks that do not line up with the FFT size, the recording loops twice
+    std::vector<float> iq(2 * 1000);
+    uint64_t total = 0;
+    while (total < bins * 16)
+    {
+        int n = source.read(iq.data(), 1000, 100);
+        ASSERT_GT(n, 0);
+        accumulator.add(iq.data(), n);
+        total += n;
+    }
+    EXPECT_EQ(accumulator.samples(), total);
+    EXPECT_NEAR(accumulator.totalPower(), 1.0, 1e-3);
+
+    std::vector<float> spectrum(bins);
+    accumulator.spectrum(spectrum.data());
+    size_t peak = std::max_element(spectrum.begin(), spectrum.end()) - spectrum.begin();
+    EXPECT_EQ(peak, bins / 2 + tone);
+    EXPECT_NEAR(std::accumulate(spectrum.begin(), spectrum.end(), 0.0), 1.0, 1e-3);
+    remove(path.c_str());
+}
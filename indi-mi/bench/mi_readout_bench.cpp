@@ -0,0 +1,339 @@
+/*
+ Moravian Readout Benchmark
+
+ Measures how long the INDI timer thread is blocked by an MI camera exposure,
+ before and after the readout thread. Before, MICCD::TimerHit polled
+ gxccd_image_ready every polling period and read the image and flipped it in
+ place in the same call. After, ReadoutThread sleeps until the exposure should be
+ over, polls from its own thread and flips the rows while copying them to the
+ frame buffer, so TimerHit only reports the time left.
+
+ The camera is simulated: the image is ready when the exposure time is up, and
+ gxccd_read_image is a sleep for the transfer at the given rate plus a copy.
+
+ Usage:
+   ./mi_readout_bench [--width <px>] [--height <px>] [--exposure <s>] [--frames <n>]
+                      [--poll <ms>] [--rate <MB/s>]
+
+ Options:
+   --width    <px>    Image width (default: 6252)
+   --height   <px>    Image height (default: 4176)
+   --exposure <s>     Exposure time (default: 1)
+   --frames   <n>     Exposures in the sequence (default: 4)
+   --poll     <ms>    INDI polling period (default: 1000)
+   --rate     <MB/s>  Simulated download rate (default: 100)
+
+ Blocked is the time spent in one TimerHit call. Ready to frame is the time from
+ the end of the exposure to the frame in the buffer, which includes waiting for
+ the next poll before.
+
+ Copyright (C) 2026 agent (agent@local)
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "mi_readout.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static void printUsage(const char *prog)
+{
+    printf("Usage: %s [--width <px>] [--height <px>] [--exposure <s>] [--frames <n>]\n"
+           "          [--poll <ms>] [--rate <MB/s>]\n\n", prog);
+    printf("  --width    <px>    Image width (default: 6252)\n");
+    printf("  --height   <px>    Image height (default: 4176)\n");
+    printf("  --exposure <s>     Exposure time (default: 1)\n");
+    printf("  --frames   <n>     Exposures in the sequence (default: 4)\n");
+    printf("  --poll     <ms>    INDI polling period (default: 1000)\n");
+    printf("  --rate     <MB/s>  Simulated download rate (default: 100)\n");
+}
+
+static double msSince(Clock::time_point start, Clock::time_point end = Clock::now())
+{
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// The former in-place flip of MICCD::grabImage
+static void mirror_image(void *buf, size_t w, size_t d)
+{
+    size_t w2     = w * 2;
+    size_t half_d = d / 2;
+
+    for (size_t line = 1; line <= half_d; line++)
+    {
+        uint16_t *sa = (uint16_t *)((char *)buf + (line - 1) * w2);
+        uint16_t *da = (uint16_t *)((char *)buf + (d - line) * w2);
+        for (size_t index = 1; index <= w; index++)
+        {
+            uint16_t tmp = *sa;
+            *sa          = *da;
+            *da          = tmp;
+            ++sa;
+            ++da;
+        }
+    }
+}
+
+// Stands in for libgxccd, the image is ready once the exposure time is up
+class Camera
+{
+    public:
+        Camera(size_t size, double rate) : m_image(size), m_rate(rate)
+        {
+            uint16_t *pixels = reinterpret_cast<uint16_t *>(m_image.data());
+            for (size_t i = 0; i < size / 2; i++)
+                pixels[i] = static_cast<uint16_t>(rand());
+        }
+
+        void start(double exposure)
+        {
+            m_start = Clock::now().time_since_epoch().count();
+            m_end   = (Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(exposure)))
+                      .time_since_epoch().count();
+        }
+        bool ready() const
+        {
+            return Clock::now().time_since_epoch().count() >= m_end;
+        }
+        Clock::time_point started() const
+        {
+            return Clock::time_point(Clock::duration(m_start.load()));
+        }
+        Clock::time_point end() const
+        {
+            return Clock::time_point(Clock::duration(m_end.load()));
+        }
+        void read(uint8_t *buf)
+        {
+            std::this_thread::sleep_for(std::chrono::duration<double>(m_image.size() / m_rate));
+            memcpy(buf, m_image.data(), m_image.size());
+        }
+
+        const std::vector<uint8_t> &image() const
+        {
+            return m_image;
+        }
+
+    private:
+        std::vector<uint8_t> m_image;
+        double m_rate;
+        std::atomic<Clock::rep> m_start {0};
+        std::atomic<Clock::rep> m_end {0};
+};
+
+struct Stats
+{
+    double blockedMax {0};
+    double blockedSum {0};
+    size_t ticks {0};
+    double latencySum {0};
+    size_t frames {0};
+    double total {0};
+
+    void tick(double blocked)
+    {
+        blockedMax = std::max(blockedMax, blocked);
+        blockedSum += blocked;
+        ticks++;
+    }
+    void print(const char *name) const
+    {
+        printf("  %-16s %10.1f %10.2f %14.1f %10.2f\n", name, blockedMax, ticks ? blockedSum / ticks : 0,
+               frames ? latencySum / frames : 0, total);
+    }
+};
+
+struct Params
+{
+    size_t width {6252};
+    size_t height {4176};
+    double exposure {1};
+    int frames {4};
+    int poll {1000};
+    double rate {100};
+};
+
+// Like INDI: the next TimerHit is scheduled by SetTimer at the end of the current one
+template <typename Hit, typename Done>
+static void runTimer(const Params &params, Stats &stats, Hit hit, Done done)
+{
+    Clock::time_point next = Clock::now() + std::chrono::milliseconds(params.poll);
+    while (!done())
+    {
+        std::this_thread::sleep_until(next);
+        Clock::time_point start = Clock::now();
+        hit();
+        stats.tick(msSince(start));
+        next = Clock::now() + std::chrono::milliseconds(params.poll);
+    }
+}
+
+static Stats runTimerHit(const Params &params, Camera &camera, std::vector<uint8_t> &frame)
+{
+    Stats stats;
+    std::mutex bufferLock;
+    Clock::time_point begin = Clock::now(), last = begin;
+    int done = 0;
+
+    camera.start(params.exposure);
+    runTimer(params, stats, [&]()
+    {
+        if (!camera.ready())
+            return;
+
+        std::unique_lock<std::mutex> guard(bufferLock);
+        camera.read(frame.data());
+        mirror_image(frame.data(), params.width, params.height);
+        guard.unlock();
+
+        stats.latencySum += msSince(camera.end());
+        stats.frames++;
+        last = Clock::now();
+        if (++done < params.frames)
+            camera.start(params.exposure);
+    }, [&]()
+    {
+        return done >= params.frames;
+    });
+
+    stats.total = msSince(begin, last) / 1000;
+    return stats;
+}
+
+static Stats runReadoutThread(const Params &params, Camera &camera, std::vector<uint8_t> &frame)
+{
+    Stats stats;
+    std::mutex bufferLock;
+    std::vector<uint8_t> readout(frame.size());
+    std::atomic<int> done {0};
+    double timeLeft = 0;
+    Clock::time_point begin = Clock::now(), last = begin;
+
+    ReadoutThread thread([&]()
+    {
+        return camera.ready();
+    }, [&]()
+    {
+        camera.read(readout.data());
+        {
+            std::unique_lock<std::mutex> guard(bufferLock);
+            mirror_copy(frame.data(), readout.data(), params.width, params.height);
+        }
+
+        stats.latencySum += msSince(camera.end());
+        stats.frames++;
+        last = Clock::now();
+        if (done + 1 < params.frames)
+        {
+            camera.start(params.exposure);
+            thread.arm(params.exposure);
+        }
+        done++;
+    });
+
+    camera.start(params.exposure);
+    thread.arm(params.exposure);
+    runTimer(params, stats, [&]()
+    {
+        timeLeft = params.exposure - msSince(camera.started()) / 1000;
+    }, [&]()
+    {
+        return done >= params.frames;
+    });
+
+    stats.total = msSince(begin, last) / 1000;
+    return stats;
+}
+
+int main(int argc, char *argv[])
+{
+    Params params;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--width") && i + 1 < argc)
+            params.width = strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--height") && i + 1 < argc)
+            params.height = strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--exposure") && i + 1 < argc)
+            params.exposure = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--frames") && i + 1 < argc)
+            params.frames = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--poll") && i + 1 < argc)
+            params.poll = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--rate") && i + 1 < argc)
+            params.rate = atof(argv[++i]);
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (params.width == 0 || params.height == 0 || params.exposure < 0 || params.frames <= 0 || params.poll <= 0
+            || params.rate <= 0)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    size_t size = params.width * params.height * 2;
+    Camera camera(size, params.rate * 1e6);
+    std::vector<uint8_t> frame(size), flipped(size);
+
+    printf("%zu x %zu (%.1f MB), %d x %.2f s exposures, %d ms polling, %.0f MB/s download\n\n", params.width,
+           params.height, size / 1e6, params.frames, params.exposure, params.poll, params.rate);
+
+    // Flip alone, and check both give the same image
+    const int repeats = 5;
+    memcpy(frame.data(), camera.image().data(), size);
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < repeats; i++)
+        mirror_image(frame.data(), params.width, params.height);
+    double swapMs = msSince(start) / repeats;
+
+    start = Clock::now();
+    for (int i = 0; i < repeats; i++)
+        mirror_copy(flipped.data(), camera.image().data(), params.width, params.height);
+    double copyMs = msSince(start) / repeats;
+
+    if (memcmp(frame.data(), flipped.data(), size))
+    {
+        printf("mirror_copy differs from mirror_image\n");
+        return 1;
+    }
+
+    printf("Flip              ms/frame\n");
+    printf("  mirror_image    %8.1f  (rows swapped in place after the read)\n", swapMs);
+    printf("  mirror_copy     %8.1f  (rows copied in reverse order from the read buffer)\n\n", copyMs);
+
+    Stats before = runTimerHit(params, camera, frame);
+    Stats after  = runReadoutThread(params, camera, frame);
+
+    printf("Timer thread     blocked ms: max       mean  ready to frame ms    total s\n");
+    before.print("TimerHit");
+    after.print("ReadoutThread");
+    return 0;
+}
@@ -22,6 +22,7 @@
 */
 
 #include "mi_ccd.h"
+#include "mi_readout.h"
 
 #include "config.h"
 
@@ -156,6 +157,7 @@ MICCD::MICCD(int camId, bool eth) : FilterInterface(this)
 
 MICCD::~MICCD()
 {
+    readoutThread.reset();
     gxccd_release(cameraHandle);
 }
 
@@ -346,6 +348,7 @@ bool MICCD::Connect()
 
         numFilters = 5;
 
+        startReadoutThread();
         return true;
     }
 
@@ -406,14 +409,22 @@ bool MICCD::Connect()
         }
         IDSetSwitch(&ReadModeSP, nullptr);
     }
+
+    startReadoutThread();
     return true;
 }
 
 bool MICCD::Disconnect()
 {
+    // A download in progress is dropped, the readout thread releases the camera once it is done
+    camera_t *handle = cameraHandle.exchange(nullptr);
+    readoutThread->cancel([this, handle]()
+    {
+        std::unique_lock<std::mutex> cameraGuard(cameraLock);
+        gxccd_release(handle);
+    });
+
     LOGF_INFO("Disconnected from %s.", name);
-    gxccd_release(cameraHandle);
-    cameraHandle = nullptr;
     return true;
 }
 
@@ -485,15 +496,26 @@ int MICCD::SetTemperature(double temperature)
 
     TemperatureRequest = temperature;
 
-    if (!isSimulation() && gxccd_set_temperature(cameraHandle, temperature) < 0)
+    IPState state = cameraCommand([this, temperature]()
     {
-        char errorStr[MAX_ERROR_LEN];
-        gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
-        LOGF_ERROR("Setting temperature failed: %s.", errorStr);
-        return -1;
-    }
+        if (!isSimulation() && gxccd_set_temperature(cameraHandle, temperature) < 0)
+        {
+            char errorStr[MAX_ERROR_LEN];
+            gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
+            LOGF_ERROR("Setting temperature failed: %s.", errorStr);
+            return false;
+        }
+        return true;
+    }, [this](IPState state)
+    {
+        if (state == IPS_ALERT)
+        {
+            TemperatureNP.setState(IPS_ALERT);
+            TemperatureNP.apply();
+        }
+    });
 
-    return 0;
+    return state == IPS_ALERT ? -1 : 0;
 }
 
 bool MICCD::StartExposure(float duration)
@@ -501,43 +523,58 @@ bool MICCD::StartExposure(float duration)
     imageFrameType = PrimaryCCD.getFrameType();
     useShutter = (imageFrameType == INDI::CCDChip::LIGHT_FRAME || imageFrameType == INDI::CCDChip::FLAT_FRAME);
 
-    if (!isSimulation())
+    // During a read the exposure starts once the image is in
+    cameraCommand([this, duration]()
     {
-        int mode = IUFindOnSwitchIndex(&ReadModeSP);
-        gxccd_set_read_mode(cameraHandle, mode);
-
-        // send binned coords
-        int x = PrimaryCCD.getSubX() / PrimaryCCD.getBinX();
-        int y = PrimaryCCD.getSubY() / PrimaryCCD.getBinY();
-        int w = PrimaryCCD.getSubW() / PrimaryCCD.getBinX();
-        int d = PrimaryCCD.getSubH() / PrimaryCCD.getBinY();
-        // invert frame, libgxccd has 0 on the bottom
-        int fd = PrimaryCCD.getYRes() / PrimaryCCD.getBinY();
-        int fy = fd - y - d;
-        gxccd_start_exposure(cameraHandle, duration, useShutter, x, fy, w, d);
-    }
+        if (!isSimulation())
+        {
+            int mode = IUFindOnSwitchIndex(&ReadModeSP);
+            gxccd_set_read_mode(cameraHandle, mode);
+
+            // send binned coords
+            int x = PrimaryCCD.getSubX() / PrimaryCCD.getBinX();
+            int y = PrimaryCCD.getSubY() / PrimaryCCD.getBinY();
+            int w = PrimaryCCD.getSubW() / PrimaryCCD.getBinX();
+            int d = PrimaryCCD.getSubH() / PrimaryCCD.getBinY();
+            // invert frame, libgxccd has 0 on the bottom
+            int fd = PrimaryCCD.getYRes() / PrimaryCCD.getBinY();
+            int fy = fd - y - d;
+            gxccd_start_exposure(cameraHandle, duration, useShutter, x, fy, w, d);
+        }
 
-    ExposureRequest = duration;
-    PrimaryCCD.setExposureDuration(duration);
+        ExposureRequest = duration;
+        PrimaryCCD.setExposureDuration(duration);
 
-    gettimeofday(&ExpStart, nullptr);
-    InExposure  = true;
-    downloading = false;
-    LOGF_DEBUG("Taking a %.3f seconds frame...", ExposureRequest);
+        gettimeofday(&ExpStart, nullptr);
+        InExposure  = true;
+        downloading = false;
+        readoutThread->arm(duration);
+        LOGF_DEBUG("Taking a %.3f seconds frame...", ExposureRequest);
+        return true;
+    });
     return true;
 }
 
 bool MICCD::AbortExposure()
 {
-    if (InExposure && !isSimulation())
+    // A download in progress is dropped by the readout thread, the exposure is over then
+    bool reading = readoutThread->cancel();
+
+    if (InExposure && !reading && !isSimulation())
     {
-        if (gxccd_abort_exposure(cameraHandle, false) < 0)
+        IPState state = cameraCommand([this]()
         {
-            char errorStr[MAX_ERROR_LEN];
-            gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
-            LOGF_ERROR("Aborting exposure failed: %s.", errorStr);
+            if (gxccd_abort_exposure(cameraHandle, false) < 0)
+            {
+                char errorStr[MAX_ERROR_LEN];
+                gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
+                LOGF_ERROR("Aborting exposure failed: %s.", errorStr);
+                return false;
+            }
+            return true;
+        });
+        if (state == IPS_ALERT)
             return false;
-        }
     }
 
     InExposure  = false;
@@ -571,7 +608,8 @@ bool MICCD::UpdateCCDFrame(int x, int y, int w, int h)
     int imageWidth  = x_2 - x_1;
     int imageHeight = y_2 - y_1;
 
-    // Set UNBINNED coords
+    // Set UNBINNED coords, grabImage() may be copying into the frame buffer
+    std::unique_lock<std::mutex> guard(ccdBufferLock);
     PrimaryCCD.setFrame(x, y, w, h);
     PrimaryCCD.setFrameBufferSize(imageWidth * imageHeight * PrimaryCCD.getBPP() / 8);
     return true;
@@ -585,14 +623,23 @@ bool MICCD::UpdateCCDBin(int hor, int ver)
                    hor, ver, maxBinX, maxBinY);
         return false;
     }
-    if (gxccd_set_binning(cameraHandle, hor, ver) < 0)
+    IPState state = cameraCommand([this, hor, ver]()
     {
-        char errorStr[MAX_ERROR_LEN];
-        gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
-        LOGF_ERROR("Setting binning failed: %s.", errorStr);
+        if (gxccd_set_binning(cameraHandle, hor, ver) < 0)
+        {
+            char errorStr[MAX_ERROR_LEN];
+            gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
+            LOGF_ERROR("Setting binning failed: %s.", errorStr);
+            return false;
+        }
+        return true;
+    });
+    if (state == IPS_ALERT)
         return false;
-    }
+
+    std::unique_lock<std::mutex> guard(ccdBufferLock);
     PrimaryCCD.setBin(hor, ver);
+    guard.unlock();
     return UpdateCCDFrame(PrimaryCCD.getSubX(), PrimaryCCD.getSubY(), PrimaryCCD.getSubW(), PrimaryCCD.getSubH());
 }
 
@@ -606,38 +653,73 @@ float MICCD::calcTimeLeft()
     return ExposureRequest - timesince / 1000.0;
 }
 
-static void mirror_image(void *buf, size_t w, size_t d)
+void MICCD::startReadoutThread()
+{
+    // Kept across reconnects, only joined in the destructor
+    if (readoutThread)
+        return;
+
+    readoutThread.reset(new ReadoutThread([this]()
+    {
+        return isImageReady();
+    }, [this]()
+    {
+        PrimaryCCD.setExposureLeft(0);
+        InExposure  = false;
+        downloading = true;
+
+        // Don't spam the session log unless it is a long exposure > 5 seconds
+        if (ExposureRequest > 5)
+            LOG_INFO("Exposure done, downloading image...");
+
+        // grab and save image
+        grabImage();
+    }));
+}
+
+/* Called on the readout thread once the exposure should be over. */
+bool MICCD::isImageReady()
 {
-    size_t w2     = w * 2;
-    size_t half_d = d / 2;
+    if (isSimulation())
+        return true;
 
-    for (size_t line = 1; line <= half_d; line++)
+    std::unique_lock<std::mutex> cameraGuard(cameraLock);
+    camera_t *handle = cameraHandle;
+    if (!handle)
+        return false;
+
+    bool ready = false;
+    if (gxccd_image_ready(handle, &ready) < 0)
     {
-        uint16_t *sa = (uint16_t *)((char *)buf + (line - 1) * w2);
-        uint16_t *da = (uint16_t *)((char *)buf + (d - line) * w2);
-        for (size_t index = 1; index <= w; index++)
+        // Polled every few ms now, report the first failure only
+        if (!imageReadyFailed)
         {
-            uint16_t tmp = *sa;
-            *sa          = *da;
-            *da          = tmp;
-            ++sa;
-            ++da;
+            char errorStr[MAX_ERROR_LEN];
+            gxccd_get_last_error(handle, errorStr, sizeof(errorStr));
+            LOGF_ERROR("Getting image ready failed: %s.", errorStr);
         }
+        imageReadyFailed = true;
+        return false;
     }
+    imageReadyFailed = false;
+    return ready;
 }
 
-/* Downloads the image from the CCD. */
+/* Downloads the image from the CCD, on the readout thread. */
 int MICCD::grabImage()
 {
-    std::unique_lock<std::mutex> guard(ccdBufferLock);
-    int ret              = 0;
-    unsigned char *image = (unsigned char *)PrimaryCCD.getFrameBuffer();
-    int width  = PrimaryCCD.getSubW() / PrimaryCCD.getBinX();
-    int height = PrimaryCCD.getSubH() / PrimaryCCD.getBinY();
+    int ret     = 0;
+    int width   = PrimaryCCD.getSubW() / PrimaryCCD.getBinX();
+    int height  = PrimaryCCD.getSubH() / PrimaryCCD.getBinY();
+    size_t size = PrimaryCCD.getFrameBufferSize();
+
+    // The camera is read into a buffer of our own, the frame buffer is only locked for the flip
+    if (readoutBuffer.size() < size)
+        readoutBuffer.resize(size);
 
     if (isSimulation())
     {
-        uint16_t *buffer = (uint16_t *)image;
+        uint16_t *buffer = reinterpret_cast<uint16_t *>(readoutBuffer.data());
 
         for (int i = 0; i < height; i++)
             for (int j = 0; j < width; j++)
@@ -645,61 +727,103 @@ int MICCD::grabImage()
     }
     else
     {
-        ret = gxccd_read_image(cameraHandle, image, PrimaryCCD.getFrameBufferSize());
-        if (ret < 0)
+        // Disconnect() leaves the camera to this thread until the download is over
+        std::unique_lock<std::mutex> cameraGuard(cameraLock);
+        camera_t *handle = cameraHandle;
+        if (!handle)
+            return -1;
+
+        // Not locked across the read, the event loop defers its commands meanwhile
+        readingImage = true;
+        cameraGuard.unlock();
+        ret = gxccd_read_image(handle, readoutBuffer.data(), size);
+        cameraGuard.lock();
+        readingImage = false;
+
+        if (ret < 0 && !readoutThread->discarded())
         {
             char errorStr[MAX_ERROR_LEN];
-            gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
+            gxccd_get_last_error(handle, errorStr, sizeof(errorStr));
             LOGF_ERROR("Error getting image: %s.", errorStr);
         }
-        else
+        cameraIdle.notify_all();
+    }
+
+    // Aborted or disconnected during the download, the state is already reset
+    if (readoutThread->discarded())
+    {
+        LOG_DEBUG("Exposure aborted, image dropped.");
+        runDeferredCommands();
+        return ret;
+    }
+
+    if (!ret)
+    {
+        // libgxccd has 0 on the bottom, flip while copying
+        std::unique_lock<std::mutex> guard(ccdBufferLock);
+        if (PrimaryCCD.getFrameBufferSize() < static_cast<int>(size))
         {
-            mirror_image(image, width, height);
+            LOG_WARN("Frame changed during the download, image dropped.");
+            ret = -1;
         }
+        else
+            mirror_copy(PrimaryCCD.getFrameBuffer(), readoutBuffer.data(), width, height);
     }
 
-    guard.unlock();
-
     if (ExposureRequest > 5 && !ret)
         LOG_INFO("Download complete.");
 
     downloading = false;
     ExposureComplete(&PrimaryCCD);
 
+    // Commands that came during the read go after this frame, a next exposure included
+    runDeferredCommands();
     return ret;
 }
 
+/* Runs a camera command now, or queues it behind the image being read. */
+IPState MICCD::cameraCommand(const std::function<bool()> &command, const std::function<void(IPState)> &done)
+{
+    std::unique_lock<std::mutex> cameraGuard(cameraLock);
+    if (readingImage || !deferredCommands.empty())
+    {
+        deferredCommands.push_back({command, done});
+        return IPS_BUSY;
+    }
+
+    return command() ? IPS_OK : IPS_ALERT;
+}
+
+/* Called on the readout thread once the image is handed over. Commands are dropped after a disconnect. */
+void MICCD::runDeferredCommands()
+{
+    std::unique_lock<std::mutex> cameraGuard(cameraLock);
+    std::deque<DeferredCommand> commands;
+    commands.swap(deferredCommands);
+
+    for (auto &deferred : commands)
+    {
+        if (!cameraHandle)
+            break;
+
+        bool ok = deferred.command();
+        if (deferred.done)
+            deferred.done(ok ? IPS_OK : IPS_ALERT);
+    }
+}
+
 void MICCD::TimerHit()
 {
     if (!isConnected())
         return; // No need to reset timer if we are not connected anymore
 
+    // Completion and download are up to the readout thread, only report progress here
     if (InExposure)
     {
         float timeleft = calcTimeLeft();
-        bool ready     = false;
-
-        if (!downloading && (gxccd_image_ready(cameraHandle, &ready) < 0))
-        {
-            char errorStr[MAX_ERROR_LEN];
-            gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
-            LOGF_ERROR("Getting image ready failed: %s.", errorStr);
-        }
-        if (ready)
-        {
-            PrimaryCCD.setExposureLeft(0);
-            InExposure  = false;
-            downloading = true;
 
-            // Don't spam the session log unless it is a long exposure > 5 seconds
-            if (ExposureRequest > 5)
-                LOG_INFO("Exposure done, downloading image...");
-
-            // grab and save image
-            grabImage();
-        }
         // camera may need some time for image download -> update client only for positive values
-        else if (timeleft >= 0)
+        if (timeleft >= 0)
         {
             LOGF_DEBUG("Exposure in progress: Time left %.2fs", timeleft);
             PrimaryCCD.setExposureLeft(timeleft);
@@ -716,66 +840,70 @@ int MICCD::QueryFilter()
 
 bool MICCD::SelectFilter(int position)
 {
-    if (!isSimulation() && gxccd_set_filter(cameraHandle, position - 1) < 0)
+    // During a read the wheel turns once the image is in, the filter slot stays busy until then
+    IPState state = cameraCommand([this, position]()
     {
-        char errorStr[MAX_ERROR_LEN];
-        gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
-        LOGF_ERROR("Setting filter failed: %s.", errorStr);
-        return false;
-    }
+        if (!isSimulation() && gxccd_set_filter(cameraHandle, position - 1) < 0)
+        {
+            char errorStr[MAX_ERROR_LEN];
+            gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
+            LOGF_ERROR("Setting filter failed: %s.", errorStr);
+            return false;
+        }
 
-    CurrentFilter = position;
-    SelectFilterDone(position);
-    LOGF_DEBUG("Filter changed to %d", position);
-    return true;
+        CurrentFilter = position;
+        SelectFilterDone(position);
+        LOGF_DEBUG("Filter changed to %d", position);
+        return true;
+    }, [this](IPState state)
+    {
+        if (state == IPS_ALERT)
+        {
+            FilterSlotNP.setState(IPS_ALERT);
+            FilterSlotNP.apply();
+        }
+    });
+
+    return state != IPS_ALERT;
 }
 
 IPState MICCD::GuideNorth(uint32_t ms)
 {
-    if (gxccd_move_telescope(cameraHandle, 0, static_cast<int16_t>(ms)) < 0)
-    {
-        char errorStr[MAX_ERROR_LEN];
-        gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
-        LOGF_ERROR("GuideNorth() failed: %s.", errorStr);
-        return IPS_ALERT;
-    }
-    return IPS_OK;
+    return guidePulse(0, static_cast<int16_t>(ms), AXIS_DE, "GuideNorth");
 }
 
 IPState MICCD::GuideSouth(uint32_t ms)
 {
-    if (gxccd_move_telescope(cameraHandle, 0, (-1 * static_cast<int16_t>(ms))) < 0)
-    {
-        char errorStr[MAX_ERROR_LEN];
-        gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
-        LOGF_ERROR("GuideSouth() failed: %s.", errorStr);
-        return IPS_ALERT;
-    }
-    return IPS_OK;
+    return guidePulse(0, (-1 * static_cast<int16_t>(ms)), AXIS_DE, "GuideSouth");
 }
 
 IPState MICCD::GuideEast(uint32_t ms)
 {
-    if (gxccd_move_telescope(cameraHandle, (-1 * static_cast<int16_t>(ms)), 0) < 0)
-    {
-        char errorStr[MAX_ERROR_LEN];
-        gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
-        LOGF_ERROR("GuideEast() failed: %s.", errorStr);
-        return IPS_ALERT;
-    }
-    return IPS_OK;
+    return guidePulse((-1 * static_cast<int16_t>(ms)), 0, AXIS_RA, "GuideEast");
 }
 
 IPState MICCD::GuideWest(uint32_t ms)
 {
-    if (gxccd_move_telescope(cameraHandle, static_cast<int16_t>(ms), 0) < 0)
+    return guidePulse(static_cast<int16_t>(ms), 0, AXIS_RA, "GuideWest");
+}
+
+/* The camera times the pulse itself. A pulse deferred by a read completes once it is sent. */
+IPState MICCD::guidePulse(int16_t raMs, int16_t decMs, INDI_EQ_AXIS axis, const char *direction)
+{
+    return cameraCommand([this, raMs, decMs, direction]()
     {
-        char errorStr[MAX_ERROR_LEN];
-        gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
-        LOGF_ERROR("GuideWest() failed: %s.", errorStr);
-        return IPS_ALERT;
-    }
-    return IPS_OK;
+        if (gxccd_move_telescope(cameraHandle, raMs, decMs) < 0)
+        {
+            char errorStr[MAX_ERROR_LEN];
+            gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
+            LOGF_ERROR("%s() failed: %s.", direction, errorStr);
+            return false;
+        }
+        return true;
+    }, [this, axis](IPState)
+    {
+        GuideComplete(axis);
+    });
 }
 
 bool MICCD::ISNewSwitch(const char *dev, const char *name, ISState *states, char *names[], int n)
@@ -800,13 +928,21 @@ bool MICCD::ISNewSwitch(const char *dev, const char *name, ISState *states, char
                 bool on = !IUFindOnSwitchIndex(&CoolerSP);
                 double temp = on ? TemperatureRequest : TEMP_COOLER_OFF;
 
-                if (gxccd_set_temperature(cameraHandle, temp) < 0)
+                CoolerSP.s = cameraCommand([this, temp]()
                 {
-                    char errorStr[MAX_ERROR_LEN];
-                    gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
-                    LOGF_ERROR("Setting temperature failed: %s.", errorStr);
-                    CoolerSP.s = IPS_ALERT;
-                }
+                    if (gxccd_set_temperature(cameraHandle, temp) < 0)
+                    {
+                        char errorStr[MAX_ERROR_LEN];
+                        gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
+                        LOGF_ERROR("Setting temperature failed: %s.", errorStr);
+                        return false;
+                    }
+                    return true;
+                }, [this](IPState state)
+                {
+                    CoolerSP.s = state;
+                    IDSetSwitch(&CoolerSP, nullptr);
+                });
             }
 
             IDSetSwitch(&CoolerSP, nullptr);
@@ -841,17 +977,21 @@ bool MICCD::ISNewNumber(const char *dev, const char *name, double values[], char
         {
             IUUpdateNumber(&FanNP, values, names, n);
 
-            if (!isSimulation() && gxccd_set_fan(cameraHandle, FanN[0].value) < 0)
+            FanNP.s = cameraCommand([this]()
             {
-                char errorStr[MAX_ERROR_LEN];
-                gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
-                LOGF_ERROR("Setting fan failed: %s.", errorStr);
-                FanNP.s = IPS_ALERT;
-            }
-            else
+                if (!isSimulation() && gxccd_set_fan(cameraHandle, FanN[0].value) < 0)
+                {
+                    char errorStr[MAX_ERROR_LEN];
+                    gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
+                    LOGF_ERROR("Setting fan failed: %s.", errorStr);
+                    return false;
+                }
+                return true;
+            }, [this](IPState state)
             {
-                FanNP.s = IPS_OK;
-            }
+                FanNP.s = state;
+                IDSetNumber(&FanNP, nullptr);
+            });
 
             IDSetNumber(&FanNP, nullptr);
             return true;
@@ -861,17 +1001,21 @@ bool MICCD::ISNewNumber(const char *dev, const char *name, double values[], char
         {
             IUUpdateNumber(&WindowHeatingNP, values, names, n);
 
-            if (!isSimulation() && gxccd_set_window_heating(cameraHandle, WindowHeatingN[0].value) < 0)
+            WindowHeatingNP.s = cameraCommand([this]()
             {
-                char errorStr[MAX_ERROR_LEN];
-                gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
-                LOGF_ERROR("Setting heating failed: %s.", errorStr);
-                WindowHeatingNP.s = IPS_ALERT;
-            }
-            else
+                if (!isSimulation() && gxccd_set_window_heating(cameraHandle, WindowHeatingN[0].value) < 0)
+                {
+                    char errorStr[MAX_ERROR_LEN];
+                    gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
+                    LOGF_ERROR("Setting heating failed: %s.", errorStr);
+                    return false;
+                }
+                return true;
+            }, [this](IPState state)
             {
-                WindowHeatingNP.s = IPS_OK;
-            }
+                WindowHeatingNP.s = state;
+                IDSetNumber(&WindowHeatingNP, nullptr);
+            });
 
             IDSetNumber(&WindowHeatingNP, nullptr);
             return true;
@@ -884,17 +1028,21 @@ bool MICCD::ISNewNumber(const char *dev, const char *name, double values[], char
             // set NIR pre-flash if available.
             if (canDoPreflash)
             {
-                if (!isSimulation() && gxccd_set_preflash(cameraHandle, PreflashN[0].value, PreflashN[1].value) < 0)
+                PreflashNP.s = cameraCommand([this]()
                 {
-                    char errorStr[MAX_ERROR_LEN];
-                    gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
-                    LOGF_ERROR("Setting NIR preflash failed: %s.", errorStr);
-                    PreflashNP.s = IPS_ALERT;
-                }
-                else
+                    if (!isSimulation() && gxccd_set_preflash(cameraHandle, PreflashN[0].value, PreflashN[1].value) < 0)
+                    {
+                        char errorStr[MAX_ERROR_LEN];
+                        gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
+                        LOGF_ERROR("Setting NIR preflash failed: %s.", errorStr);
+                        return false;
+                    }
+                    return true;
+                }, [this](IPState state)
                 {
-                    PreflashNP.s = IPS_OK;
-                }
+                    PreflashNP.s = state;
+                    IDSetNumber(&PreflashNP, nullptr);
+                });
             }
 
             IDSetNumber(&PreflashNP, nullptr);
@@ -905,17 +1053,21 @@ bool MICCD::ISNewNumber(const char *dev, const char *name, double values[], char
         {
             IUUpdateNumber(&GainNP, values, names, n);
 
-            if (!isSimulation() && gxccd_set_gain(cameraHandle, static_cast<uint16_t>(GainN[0].value)) < 0)
+            GainNP.s = cameraCommand([this]()
             {
-                char errorStr[MAX_ERROR_LEN];
-                gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
-                LOGF_ERROR("Setting gain failed: %s.", errorStr);
-                GainNP.s = IPS_ALERT;
-            }
-            else
+                if (!isSimulation() && gxccd_set_gain(cameraHandle, static_cast<uint16_t>(GainN[0].value)) < 0)
+                {
+                    char errorStr[MAX_ERROR_LEN];
+                    gxccd_get_last_error(cameraHandle, errorStr, sizeof(errorStr));
+                    LOGF_ERROR("Setting gain failed: %s.", errorStr);
+                    return false;
+                }
+                return true;
+            }, [this](IPState state)
             {
-                GainNP.s = IPS_OK;
-            }
+                GainNP.s = state;
+                IDSetNumber(&GainNP, nullptr);
+            });
 
             IDSetNumber(&GainNP, nullptr);
             return true;
@@ -949,6 +1101,14 @@ void MICCD::updateTemperature()
     }
     else
     {
+        // The camera is busy reading an image, try again next time
+        std::unique_lock<std::mutex> cameraGuard(cameraLock);
+        if (readingImage)
+        {
+            temperatureID = IEAddTimer(getCurrentPollingPeriod(), MICCD::updateTemperatureHelper, this);
+            return;
+        }
+
         if (gxccd_get_value(cameraHandle, GV_CHIP_TEMPERATURE, &ccdtemp) < 0)
         {
             char errorStr[MAX_ERROR_LEN];
@@ -1025,6 +1185,13 @@ void MICCD::addFITSKeywords(INDI::CCDChip *targetChip, std::vector<INDI::FITSRec
     if (hasGain)
         fitsKeywords.push_back({"GAIN", GainN[0].value, 3, "Gain"});
 
+    // Not on the event loop, the next image may be read meanwhile
+    std::unique_lock<std::mutex> cameraGuard(cameraLock);
+    cameraIdle.wait(cameraGuard, [this]()
+    {
+        return !readingImage;
+    });
+
     if (!gxccd_get_integer_parameter(cameraHandle, GIP_MAX_PIXEL_VALUE, &ivalue))
         fitsKeywords.push_back({"DATAMAX", ivalue, nullptr});
 
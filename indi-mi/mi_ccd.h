@@ -26,6 +26,16 @@
 #include <indiccd.h>
 #include <indifilterinterface.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class ReadoutThread;
+
 class MICCD : public INDI::CCD, public INDI::FilterInterface
 {
     public:
@@ -93,7 +103,8 @@ class MICCD : public INDI::CCD, public INDI::FilterInterface
         char name[MAXINDIDEVICE];
 
         int cameraId;
-        camera_t *cameraHandle;
+        // Cleared by Disconnect() while the readout thread may still poll the camera
+        std::atomic<camera_t *> cameraHandle {nullptr};
         bool isEth;
 
         bool hasGain;
@@ -112,6 +123,7 @@ class MICCD : public INDI::CCD, public INDI::FilterInterface
         int timerID;
 
         bool downloading;
+        bool imageReadyFailed {false};
 
         bool canDoPreflash;
 
@@ -123,8 +135,29 @@ class MICCD : public INDI::CCD, public INDI::FilterInterface
 
         bool setupParams();
 
+        // Serializes libgxccd calls of the readout thread and the INDI event loop
+        std::mutex cameraLock;
+        // Set by the readout thread while it reads an image without holding cameraLock
+        bool readingImage {false};
+        std::condition_variable cameraIdle;
+        // Camera commands that came during a read, run on the readout thread after that frame
+        struct DeferredCommand
+        {
+            std::function<bool()> command;
+            std::function<void(IPState)> done;
+        };
+        std::deque<DeferredCommand> deferredCommands;
+        std::unique_ptr<ReadoutThread> readoutThread;
+        // Image as read from the camera, bottom row first
+        std::vector<uint8_t> readoutBuffer;
+
         float calcTimeLeft();
+        void startReadoutThread();
+        bool isImageReady();
         int grabImage();
+        IPState cameraCommand(const std::function<bool()> &command, const std::function<void(IPState)> &done = nullptr);
+        void runDeferredCommands();
+        IPState guidePulse(int16_t raMs, int16_t decMs, INDI_EQ_AXIS axis, const char *direction);
 
         void updateTemperature();
         static void updateTemperatureHelper(void *);
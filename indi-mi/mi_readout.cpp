@@ -0,0 +1,149 @@
+/*
+ Moravian Instruments Readout Thread
+
+ Copyright (C) 2026 agent (agent@local)
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "mi_readout.h"
+
+#include <cstring>
+
+ReadoutThread::ReadoutThread(ReadyFunction ready, ReadoutFunction readout, int pollMs)
+    : m_ready(std::move(ready)), m_readout(std::move(readout)), m_poll(pollMs)
+{
+    m_thread = std::thread(&ReadoutThread::run, this);
+}
+
+ReadoutThread::~ReadoutThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_wake.notify_all();
+    m_thread.join();
+}
+
+void ReadoutThread::arm(double duration)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_end = std::chrono::steady_clock::now() +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(duration));
+        m_armed = true;
+        m_generation++;
+    }
+    m_wake.notify_all();
+}
+
+bool ReadoutThread::cancel(std::function<void()> done)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_armed = false;
+        m_wake.notify_all();
+        if (m_busy)
+        {
+            m_discard = true;
+            if (done)
+                m_done = std::move(done);
+            return true;
+        }
+    }
+
+    if (done)
+        done();
+    return false;
+}
+
+bool ReadoutThread::discarded()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_discard;
+}
+
+void ReadoutThread::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_wake.wait(lock, [this]
+        {
+            return m_quit || m_armed;
+        });
+        if (m_quit)
+            return;
+
+        // Anything but the exposure we started with, cancelled or re-armed
+        uint64_t generation = m_generation;
+        auto stale = [&]
+        {
+            return m_quit || !m_armed || m_generation != generation;
+        };
+
+        // The camera is not asked before the exposure should be over
+        if (m_wake.wait_until(lock, m_end, stale))
+            continue;
+
+        while (true)
+        {
+            lock.unlock();
+            bool ready = m_ready();
+            lock.lock();
+            if (stale())
+                break;
+
+            if (ready)
+            {
+                m_armed = false;
+                m_busy = true;
+                lock.unlock();
+                m_readout();
+                lock.lock();
+                m_busy = false;
+                m_discard = false;
+
+                std::function<void()> done;
+                std::swap(done, m_done);
+                if (done)
+                {
+                    lock.unlock();
+                    done();
+                    lock.lock();
+                }
+                break;
+            }
+
+            if (m_wake.wait_for(lock, m_poll, stale))
+                break;
+        }
+    }
+}
+
+void mirror_copy(void *dst, const void *src, size_t w, size_t d)
+{
+    size_t w2 = w * 2;
+    const char *sa = static_cast<const char *>(src);
+    char *da = static_cast<char *>(dst) + d * w2;
+
+    for (size_t line = 0; line < d; line++)
+    {
+        da -= w2;
+        memcpy(da, sa, w2);
+        sa += w2;
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ Moravian Instruments Readout Thread
+
+ Copyright (C) 2026 agent (agent@local)
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * Waits for the end of an exposure and reads the image out, off the INDI timer thread.
+ *
+ * arm() sets a timer to the expected end of the exposure. Only then the thread starts
+ * asking ready() every poll interval, as libgxccd recommends, and calls readout() on
+ * its own thread once the image is ready. readout() may arm() the next exposure.
+ */
+class ReadoutThread
+{
+    public:
+        using ReadyFunction = std::function<bool()>;
+        using ReadoutFunction = std::function<void()>;
+
+        ReadoutThread(ReadyFunction ready, ReadoutFunction readout, int pollMs = 20);
+        ~ReadoutThread();
+
+        /** Watch an exposure of duration seconds starting now. */
+        void arm(double duration);
+        /**
+         * Stop watching, without waiting for a readout in progress.
+         * @param done runs once the thread is done with the camera: right away if it is
+         * idle, else on the thread when the readout returns.
+         * @return true if a readout was in progress, discarded() tells it to drop its image.
+         */
+        bool cancel(std::function<void()> done = nullptr);
+        /** For readout(): the exposure was cancelled meanwhile, the image must not be sent. */
+        bool discarded();
+
+    private:
+        void run();
+
+        ReadyFunction m_ready;
+        ReadoutFunction m_readout;
+        std::chrono::milliseconds m_poll;
+
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::chrono::steady_clock::time_point m_end;
+        uint64_t m_generation {0};
+        bool m_armed {false};
+        bool m_busy {false};
+        bool m_discard {false};
+        bool m_quit {false};
+        std::function<void()> m_done;
+
+        std::thread m_thread;
+};
+
+/**
+ * Copy a w x d 16-bit image upside down, one row at a time.
+ *
+ * libgxccd returns the bottom row first. Copying the rows in reverse order flips the
+ * image in the same pass that moves it to the frame buffer, with memcpy doing the
+ * vector work.
+ */
+void mirror_copy(void *dst, const void *src, size_t w, size_t d);
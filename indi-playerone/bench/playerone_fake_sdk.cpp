@@ -0,0 +1,415 @@
+/*
+    Synthetic PlayerOne SDK for the Driver Benchmark
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "playerone_fake_sdk.h"
+
+#include <cstring>
+#include <map>
+#include <mutex>
+
+namespace
+{
+
+struct Config
+{
+    const char *name;
+    POAConfig id;
+    POAValueType type;
+    double min, max, def;
+    POABool autoSupported;
+    POABool writable;
+};
+
+const Config configs[] =
+{
+    {"Exposure",     POA_EXPOSURE,            VAL_INT,   10, 2000000000, 10000, POA_TRUE,  POA_TRUE},
+    {"Gain",         POA_GAIN,                VAL_INT,   0, 500,         0,     POA_TRUE,  POA_TRUE},
+    {"Offset",       POA_OFFSET,              VAL_INT,   0, 255,         10,    POA_FALSE, POA_TRUE},
+    {"Temperature",  POA_TEMPERATURE,         VAL_FLOAT, -50, 80,        20,    POA_FALSE, POA_FALSE},
+    {"USBBandLimit", POA_USB_BANDWIDTH_LIMIT, VAL_INT,   35, 100,        100,   POA_FALSE, POA_TRUE},
+    {"FrameLimit",   POA_FRAME_LIMIT,         VAL_INT,   0, 2000,        0,     POA_FALSE, POA_TRUE},
+    {"HQI",          POA_HQI,                 VAL_BOOL,  0, 1,           0,     POA_FALSE, POA_TRUE},
+    {"PixelBinSum",  POA_PIXEL_BIN_SUM,       VAL_BOOL,  0, 1,           0,     POA_FALSE, POA_TRUE},
+    {"Exp",          POA_EXP,                 VAL_FLOAT, 0.00001, 7200,  0.01,  POA_TRUE,  POA_TRUE},
+};
+
+const char *sensorModes[] = {"Normal", "LowNoise"};
+
+struct Camera
+{
+    POACameraProperties info {};
+
+    std::mutex mutex;
+    std::map<int, POAConfigValue> values;
+    int width {0}, height {0}, bin {1}, startX {0}, startY {0}, sensorMode {0};
+    POAImgFormat format {POA_RAW16};
+    bool continuous {false};
+    // A frame that was ready when the exposure was stopped, still to be read
+    bool pending {false};
+
+    CameraBench::FakeSensor sensor;
+} camera;
+
+POAConfigValue toValue(const Config &config, double value)
+{
+    POAConfigValue result;
+    switch (config.type)
+    {
+        case VAL_INT:
+            result.intValue = static_cast<long>(value);
+            break;
+        case VAL_FLOAT:
+            result.floatValue = value;
+            break;
+        case VAL_BOOL:
+            result.boolValue = value != 0 ? POA_TRUE : POA_FALSE;
+            break;
+    }
+    return result;
+}
+
+size_t frameBytes()
+{
+    size_t bytes = static_cast<size_t>(camera.width) * camera.height;
+    if (camera.format == POA_RAW16)
+        bytes *= 2;
+    else if (camera.format == POA_RGB24)
+        bytes *= 3;
+    return bytes;
+}
+
+bool frameReady()
+{
+    return camera.pending || camera.sensor.exposureDone() || camera.sensor.videoFrameReady();
+}
+
+}
+
+namespace FakePOA
+{
+
+void configure(const CameraBench::Options &options)
+{
+    camera.sensor.configure(options);
+
+    POACameraProperties &info = camera.info;
+    memset(&info, 0, sizeof(info));
+    snprintf(info.cameraModelName, sizeof(info.cameraModelName), "PlayerOne Fake%s", options.color ? "C" : "M");
+    snprintf(info.SN, sizeof(info.SN), "BENCH0001");
+    snprintf(info.sensorModelName, sizeof(info.sensorModelName), "FAKE");
+    info.cameraID      = 0;
+    info.maxWidth      = options.width;
+    info.maxHeight     = options.height;
+    info.bitDepth      = 12;
+    info.isColorCamera = options.color ? POA_TRUE : POA_FALSE;
+    info.isHasST4Port  = POA_TRUE;
+    info.isUSB3Speed   = POA_TRUE;
+    info.bayerPattern  = options.color ? POA_BAYER_RG : POA_BAYER_MONO;
+    info.pixelSize     = 2.9;
+    info.bins[0] = 1;
+    info.bins[1] = 2;
+    info.bins[2] = 4;
+    int f = 0;
+    info.imgFormats[f++] = POA_RAW8;
+    if (options.color)
+        info.imgFormats[f++] = POA_RGB24;
+    info.imgFormats[f++] = POA_RAW16;
+    info.imgFormats[f++] = POA_END;
+
+    for (const auto &it : configs)
+        camera.values[it.id] = toValue(it, it.def);
+
+    camera.width  = options.width;
+    camera.height = options.height;
+    camera.format = options.color ? POA_RGB24 : (options.bitDepth == 8 ? POA_RAW8 : POA_RAW16);
+    camera.sensor.setFrameBytes(frameBytes());
+    camera.sensor.setExposureMs(camera.values[POA_EXPOSURE].intValue / 1000.0);
+}
+
+POACameraProperties cameraInfo()
+{
+    return camera.info;
+}
+
+double lastPullEnd()
+{
+    return camera.sensor.lastPullEnd();
+}
+
+uint64_t videoFrames()
+{
+    return camera.sensor.videoFrames();
+}
+
+}
+
+extern "C" {
+
+int POAGetCameraCount()
+{
+    return 1;
+}
+
+POAErrors POAGetCameraProperties(int nIndex, POACameraProperties *pProp)
+{
+    if (nIndex != 0)
+        return POA_ERROR_INVALID_INDEX;
+    *pProp = camera.info;
+    return POA_OK;
+}
+
+POAErrors POAOpenCamera(int)
+{
+    return POA_OK;
+}
+
+POAErrors POAInitCamera(int)
+{
+    return POA_OK;
+}
+
+POAErrors POACloseCamera(int)
+{
+    return POA_OK;
+}
+
+POAErrors POAGetConfigsCount(int, int *pConfCount)
+{
+    *pConfCount = sizeof(configs) / sizeof(configs[0]);
+    return POA_OK;
+}
+
+POAErrors POAGetConfigAttributes(int, int nConfIndex, POAConfigAttributes *pConfAttr)
+{
+    if (nConfIndex < 0 || nConfIndex >= static_cast<int>(sizeof(configs) / sizeof(configs[0])))
+        return POA_ERROR_INVALID_INDEX;
+
+    const Config &it = configs[nConfIndex];
+    memset(pConfAttr, 0, sizeof(*pConfAttr));
+    snprintf(pConfAttr->szConfName, sizeof(pConfAttr->szConfName), "%s", it.name);
+    snprintf(pConfAttr->szDescription, sizeof(pConfAttr->szDescription), "%s", it.name);
+    pConfAttr->isSupportAuto = it.autoSupported;
+    pConfAttr->isWritable    = it.writable;
+    pConfAttr->isReadable    = POA_TRUE;
+    pConfAttr->configID      = it.id;
+    pConfAttr->valueType     = it.type;
+    pConfAttr->minValue      = toValue(it, it.min);
+    pConfAttr->maxValue      = toValue(it, it.max);
+    pConfAttr->defaultValue  = toValue(it, it.def);
+    return POA_OK;
+}
+
+POAErrors POASetConfig(int, POAConfig confID, POAConfigValue confValue, POABool)
+{
+    // Guide and flip configs are commands, not values
+    if ((confID >= POA_GUIDE_NORTH && confID <= POA_GUIDE_WEST) || (confID >= POA_FLIP_NONE && confID <= POA_FLIP_BOTH))
+        return POA_OK;
+
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    auto it = camera.values.find(confID);
+    if (it == camera.values.end())
+        return POA_ERROR_INVALID_CONFIG;
+    it->second = confValue;
+
+    // POA_EXPOSURE and POA_EXP are two views of the same setting
+    if (confID == POA_EXPOSURE)
+    {
+        camera.values[POA_EXP].floatValue = confValue.intValue / 1000000.0;
+        camera.sensor.setExposureMs(confValue.intValue / 1000.0);
+    }
+    else if (confID == POA_EXP)
+    {
+        camera.values[POA_EXPOSURE].intValue = static_cast<long>(confValue.floatValue * 1000000.0);
+        camera.sensor.setExposureMs(confValue.floatValue * 1000.0);
+    }
+    return POA_OK;
+}
+
+POAErrors POAGetConfig(int, POAConfig confID, POAConfigValue *pConfValue, POABool *pIsAuto)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    auto it = camera.values.find(confID);
+    if (it == camera.values.end())
+        return POA_ERROR_INVALID_CONFIG;
+    *pConfValue = it->second;
+    if (pIsAuto)
+        *pIsAuto = POA_FALSE;
+    return POA_OK;
+}
+
+POAErrors POASetImageStartPos(int, int startX, int startY)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    camera.startX = startX;
+    camera.startY = startY;
+    return POA_OK;
+}
+
+POAErrors POAGetImageSize(int, int *pWidth, int *pHeight)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    *pWidth  = camera.width;
+    *pHeight = camera.height;
+    return POA_OK;
+}
+
+POAErrors POASetImageSize(int, int width, int height)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    if (width <= 0 || height <= 0 || width * camera.bin > camera.info.maxWidth || height * camera.bin > camera.info.maxHeight)
+        return POA_ERROR_OUT_OF_LIMIT;
+    camera.width  = width;
+    camera.height = height;
+    camera.sensor.setFrameBytes(frameBytes());
+    return POA_OK;
+}
+
+POAErrors POAGetImageBin(int, int *pBin)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    *pBin = camera.bin;
+    return POA_OK;
+}
+
+POAErrors POASetImageBin(int, int bin)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    if (bin != 1 && bin != 2 && bin != 4)
+        return POA_ERROR_INVALID_ARGU;
+    // Like the SDK, binning scales the current image size
+    camera.width  = camera.width * camera.bin / bin;
+    camera.height = camera.height * camera.bin / bin;
+    camera.bin    = bin;
+    camera.sensor.setFrameBytes(frameBytes());
+    return POA_OK;
+}
+
+POAErrors POAGetImageFormat(int, POAImgFormat *pImgFormat)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    *pImgFormat = camera.format;
+    return POA_OK;
+}
+
+POAErrors POASetImageFormat(int, POAImgFormat imgFormat)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    camera.format = imgFormat;
+    camera.sensor.setFrameBytes(frameBytes());
+    return POA_OK;
+}
+
+POAErrors POAStartExposure(int, POABool bSingleFrame)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    camera.pending = false;
+    camera.continuous = bSingleFrame == POA_FALSE;
+    if (camera.continuous)
+        camera.sensor.startVideo();
+    else
+        camera.sensor.startExposure();
+    return POA_OK;
+}
+
+POAErrors POAStopExposure(int)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    camera.pending = frameReady();
+    camera.continuous = false;
+    camera.sensor.stopVideo();
+    camera.sensor.stopExposure();
+    return POA_OK;
+}
+
+POAErrors POAGetCameraState(int, POACameraState *pCameraState)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    bool exposing = camera.sensor.capturing() || (camera.sensor.exposing() && !camera.sensor.exposureDone());
+    *pCameraState = exposing ? STATE_EXPOSING : STATE_OPENED;
+    return POA_OK;
+}
+
+POAErrors POAImageReady(int, POABool *pIsReady)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    *pIsReady = frameReady() ? POA_TRUE : POA_FALSE;
+    return POA_OK;
+}
+
+POAErrors POAGetImageData(int, unsigned char *pBuf, long lBufSize, int nTimeoutms)
+{
+    bool pending, continuous;
+    {
+        std::lock_guard<std::mutex> lock(camera.mutex);
+        pending = camera.pending;
+        continuous = camera.continuous;
+        camera.pending = false;
+    }
+
+    if (pending || (!continuous && camera.sensor.waitExposure(nTimeoutms)))
+    {
+        if (camera.sensor.pull(pBuf, lBufSize, "pull") == 0)
+            return POA_ERROR_SIZE_LESS;
+        return POA_OK;
+    }
+
+    if (!continuous || !camera.sensor.waitVideoFrame(nTimeoutms))
+        return POA_ERROR_TIMEOUT;
+    if (camera.sensor.pull(pBuf, lBufSize, "video_pull") == 0)
+        return POA_ERROR_SIZE_LESS;
+    return POA_OK;
+}
+
+POAErrors POAGetSensorModeCount(int, int *pModeCount)
+{
+    *pModeCount = sizeof(sensorModes) / sizeof(sensorModes[0]);
+    return POA_OK;
+}
+
+POAErrors POAGetSensorModeInfo(int, int modeIndex, POASensorModeInfo *pSenModeInfo)
+{
+    if (modeIndex < 0 || modeIndex >= static_cast<int>(sizeof(sensorModes) / sizeof(sensorModes[0])))
+        return POA_ERROR_INVALID_INDEX;
+    memset(pSenModeInfo, 0, sizeof(*pSenModeInfo));
+    snprintf(pSenModeInfo->name, sizeof(pSenModeInfo->name), "%s", sensorModes[modeIndex]);
+    snprintf(pSenModeInfo->desc, sizeof(pSenModeInfo->desc), "%s", sensorModes[modeIndex]);
+    return POA_OK;
+}
+
+POAErrors POASetSensorMode(int, int modeIndex)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    camera.sensorMode = modeIndex;
+    return POA_OK;
+}
+
+POAErrors POAGetSensorMode(int, int *pModeIndex)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    *pModeIndex = camera.sensorMode;
+    return POA_OK;
+}
+
+const char *POAGetSDKVersion()
+{
+    return "1.0.0-fake";
+}
+
+}
@@ -0,0 +1,45 @@
+/*
+    Synthetic PlayerOne SDK for the Driver Benchmark
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <PlayerOneCamera.h>
+
+#include "camerabench.h"
+
+// Synthetic stand-in for libPlayerOneCamera used by the offline driver benchmark.
+// It implements the subset of the SDK used by POABase on top of
+// CameraBench::FakeSensor, with single frame and continuous exposure.
+namespace FakePOA
+{
+
+/** Describe the simulated camera. Must be called before the driver is created. */
+void configure(const CameraBench::Options &options);
+
+/** Camera properties matching the configured sensor. */
+POACameraProperties cameraInfo();
+
+/** Time at which the last POAGetImageData returned, in CameraBench::nowMs() units. */
+double lastPullEnd();
+
+/** Frames read out while exposing continuously, since the last POAStartExposure. */
+uint64_t videoFrames();
+
+}
@@ -0,0 +1,96 @@
+/*
+ QHY Driver Benchmark
+
+ Runs the indi_qhy_ccd driver code against a synthetic camera, without any
+ hardware, and reports per-frame latency broken down by pipeline stage.
+
+ Usage:
+   ./qhy_driver_bench [--width <px>] [--height <px>] [--bin <n>] [--color] [--bits <8|16>]
+                      [--frames <N>] [--exposure <s>] [--stream <s>] [--usb <MB/s>] [--json <path>]
+
+ Stages:
+   pull         GetQHYCCDSingleFrame, including the simulated USB transfer
+   convert      end of pull to ExposureComplete
+   encode_send  INDI::CCD::ExposureComplete, i.e. FITS encoding and BLOB send
+   video_pull   GetQHYCCDLiveFrame while streaming
+
+ Stream frames are the frames read from the SDK; the driver's frame queue is not
+ visible from outside, so drops are not reported.
+ The report is written as JSON, see common/camerabench.h.
+
+ Copyright (C) 2026 agent (agent@local)
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "qhy_ccd.h"
+#include "qhy_fake_sdk.h"
+#include "camerabench_driver.h"
+
+class BenchQHY : public QHYCCD
+{
+    public:
+        BenchQHY() : QHYCCD("Fake", FakeQHY::cameraID) {}
+
+        CameraBench::Completion completion;
+
+    protected:
+        virtual bool ExposureComplete(INDI::CCDChip *targetChip) override
+        {
+            CameraBench::recorder().add("convert", CameraBench::nowMs() - FakeQHY::lastPullEnd());
+
+            bool rc;
+            {
+                CameraBench::StageTimer timer("encode_send");
+                rc = QHYCCD::ExposureComplete(targetChip);
+            }
+            completion.signal();
+            return rc;
+        }
+};
+
+int main(int argc, char *argv[])
+{
+    CameraBench::Options options;
+    if (!CameraBench::parseOptions(argc, argv, options))
+        return 1;
+
+    FILE *report = CameraBench::reportStream(options);
+    if (report == nullptr)
+        return 1;
+
+    FakeQHY::configure(options);
+    BenchQHY camera;
+
+    if (!CameraBench::connect(camera, options))
+        return 1;
+
+    CameraBench::Report result;
+    result.driver = "indi_qhy_ccd";
+    result.camera = camera.getDeviceName();
+
+    CameraBench::recorder().clear();
+    if (!CameraBench::runExposures(camera, options, camera.completion, result.latency))
+        return 1;
+
+    CameraBench::runStream(camera, options, result.stream, [] { return FakeQHY::videoFrames(); });
+
+    result.stages = CameraBench::recorder().snapshot();
+    camera.Disconnect();
+
+    CameraBench::writeReport(report, options, result);
+    fclose(report);
+    return 0;
+}
@@ -0,0 +1,430 @@
+/*
+ Synthetic QHY SDK for the Driver Benchmark
+
+ Copyright (C) 2026 agent (agent@local)
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "qhy_fake_sdk.h"
+
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <set>
+
+namespace
+{
+
+struct Param
+{
+    CONTROL_ID id;
+    double min, max, step, def;
+};
+
+const Param params[] =
+{
+    {CONTROL_EXPOSURE,    1, 3600000000.0, 1, 10000},
+    {CONTROL_GAIN,        0, 100, 1, 0},
+    {CONTROL_OFFSET,      0, 255, 1, 10},
+    {CONTROL_SPEED,       0, 2, 1, 2},
+    {CONTROL_USBTRAFFIC,  0, 255, 1, 30},
+    {CONTROL_TRANSFERBIT, 8, 16, 8, 16},
+    {CONTROL_ST4PORT,     0, 1, 1, 1},
+};
+
+const std::set<int> available =
+{
+    CONTROL_EXPOSURE, CONTROL_GAIN, CONTROL_OFFSET, CONTROL_SPEED, CONTROL_USBTRAFFIC, CONTROL_TRANSFERBIT,
+    CONTROL_ST4PORT, CAM_BIN1X1MODE, CAM_BIN2X2MODE, CAM_BIN4X4MODE, CAM_8BITS, CAM_16BITS,
+    CAM_SINGLEFRAMEMODE, CAM_LIVEVIDEOMODE
+};
+
+struct Camera
+{
+    CameraBench::Options options;
+
+    std::mutex mutex;
+    std::map<int, double> values;
+    uint32_t width {0}, height {0}, bin {1}, startX {0}, startY {0}, bits {16};
+
+    CameraBench::FakeSensor sensor;
+} camera;
+
+// Any non-null pointer will do, the driver never looks inside
+char handle[] = "fake";
+
+size_t frameBytes()
+{
+    return static_cast<size_t>(camera.width) * camera.height * camera.bits / 8;
+}
+
+void frameInfo(uint32_t *w, uint32_t *h, uint32_t *bpp, uint32_t *channels)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    *w        = camera.width;
+    *h        = camera.height;
+    *bpp      = camera.bits;
+    *channels = 1;
+}
+
+}
+
+namespace FakeQHY
+{
+
+const char *cameraID = "QHYFAKE-BENCH0001";
+
+void configure(const CameraBench::Options &options)
+{
+    camera.options = options;
+    camera.sensor.configure(options);
+
+    for (const auto &it : params)
+        camera.values[it.id] = it.def;
+
+    camera.width  = options.width;
+    camera.height = options.height;
+    camera.bits   = options.bitDepth == 8 ? 8 : 16;
+    camera.values[CONTROL_TRANSFERBIT] = camera.bits;
+    camera.sensor.setFrameBytes(frameBytes());
+    camera.sensor.setExposureMs(camera.values[CONTROL_EXPOSURE] / 1000.0);
+}
+
+double lastPullEnd()
+{
+    return camera.sensor.lastPullEnd();
+}
+
+uint64_t videoFrames()
+{
+    return camera.sensor.videoFrames();
+}
+
+}
+
+EXPORTC void STDCALL SetQHYCCDLogLevel(uint8_t)
+{
+}
+
+EXPORTC void STDCALL SetQHYCCDLogFunction(std::function<void(const std::string &message)>)
+{
+}
+
+EXPORTC void STDCALL SetQHYCCDBufferNumber(uint32_t)
+{
+}
+
+EXPORTC void STDCALL EnableQHYCCDMessage(bool)
+{
+}
+
+EXPORTC void STDCALL EnableQHYCCDLogFile(bool)
+{
+}
+
+EXPORTC uint32_t STDCALL InitQHYCCDResource(void)
+{
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL ReleaseQHYCCDResource(void)
+{
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL ScanQHYCCD(void)
+{
+    return 0;
+}
+
+EXPORTC uint32_t STDCALL GetQHYCCDId(uint32_t, char *)
+{
+    return QHYCCD_ERROR;
+}
+
+EXPORTC uint32_t STDCALL GetQHYCCDModel(char *, char *)
+{
+    return QHYCCD_ERROR;
+}
+
+EXPORTC qhyccd_handle *STDCALL OpenQHYCCD(char *id)
+{
+    return strcmp(id, FakeQHY::cameraID) == 0 ? handle : nullptr;
+}
+
+EXPORTC uint32_t STDCALL CloseQHYCCD(qhyccd_handle *)
+{
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL InitQHYCCD(qhyccd_handle *)
+{
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL SetQHYCCDStreamMode(qhyccd_handle *, uint8_t)
+{
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL GetQHYCCDSDKVersion(uint32_t *year, uint32_t *month, uint32_t *day, uint32_t *subday)
+{
+    *year   = 26;
+    *month  = 2;
+    *day    = 1;
+    *subday = 0;
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL IsQHYCCDControlAvailable(qhyccd_handle *, CONTROL_ID controlId)
+{
+    if (controlId == CAM_COLOR)
+        return camera.options.color ? BAYER_RG : QHYCCD_ERROR;
+    return available.count(controlId) ? QHYCCD_SUCCESS : QHYCCD_ERROR;
+}
+
+EXPORTC uint32_t STDCALL GetQHYCCDParamMinMaxStep(qhyccd_handle *, CONTROL_ID controlId, double *min, double *max,
+        double *step)
+{
+    for (const auto &it : params)
+    {
+        if (it.id == controlId)
+        {
+            *min  = it.min;
+            *max  = it.max;
+            *step = it.step;
+            return QHYCCD_SUCCESS;
+        }
+    }
+    return QHYCCD_ERROR;
+}
+
+EXPORTC double STDCALL GetQHYCCDParam(qhyccd_handle *, CONTROL_ID controlId)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    auto it = camera.values.find(controlId);
+    return it == camera.values.end() ? static_cast<double>(QHYCCD_ERROR) : it->second;
+}
+
+EXPORTC uint32_t STDCALL SetQHYCCDParam(qhyccd_handle *, CONTROL_ID controlId, double value)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    auto it = camera.values.find(controlId);
+    if (it == camera.values.end())
+        return QHYCCD_ERROR;
+    it->second = value;
+    if (controlId == CONTROL_EXPOSURE)
+        camera.sensor.setExposureMs(value / 1000.0);
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL GetQHYCCDNumberOfReadModes(qhyccd_handle *, uint32_t *numModes)
+{
+    *numModes = 1;
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL GetQHYCCDReadModeName(qhyccd_handle *, uint32_t modeNumber, char *name)
+{
+    if (modeNumber != 0)
+        return QHYCCD_ERROR;
+    strcpy(name, "STANDARD MODE");
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL GetQHYCCDReadModeResolution(qhyccd_handle *, uint32_t modeNumber, uint32_t *width,
+        uint32_t *height)
+{
+    if (modeNumber != 0)
+        return QHYCCD_ERROR;
+    *width  = camera.options.width;
+    *height = camera.options.height;
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL GetQHYCCDReadMode(qhyccd_handle *, uint32_t *modeNumber)
+{
+    *modeNumber = 0;
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL SetQHYCCDReadMode(qhyccd_handle *, uint32_t modeNumber)
+{
+    return modeNumber == 0 ? QHYCCD_SUCCESS : QHYCCD_ERROR;
+}
+
+EXPORTC uint32_t STDCALL IsQHYCCDCFWPlugged(qhyccd_handle *)
+{
+    return QHYCCD_ERROR;
+}
+
+EXPORTC uint32_t STDCALL GetQHYCCDCFWStatus(qhyccd_handle *, char *)
+{
+    return QHYCCD_ERROR;
+}
+
+EXPORTC uint32_t STDCALL GetQHYCCDHumidity(qhyccd_handle *, double *)
+{
+    return QHYCCD_ERROR;
+}
+
+EXPORTC uint32_t STDCALL GetQHYCCDChipInfo(qhyccd_handle *, double *chipw, double *chiph, uint32_t *imagew,
+        uint32_t *imageh, double *pixelw, double *pixelh, uint32_t *bpp)
+{
+    *imagew = camera.options.width;
+    *imageh = camera.options.height;
+    *pixelw = *pixelh = 2.9;
+    *chipw  = *imagew * *pixelw / 1000.0;
+    *chiph  = *imageh * *pixelh / 1000.0;
+    *bpp    = camera.options.bitDepth == 8 ? 8 : 16;
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL GetQHYCCDEffectiveArea(qhyccd_handle *, uint32_t *startX, uint32_t *startY, uint32_t *sizeX,
+        uint32_t *sizeY)
+{
+    *startX = 0;
+    *startY = 0;
+    *sizeX  = camera.options.width;
+    *sizeY  = camera.options.height;
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL GetQHYCCDOverScanArea(qhyccd_handle *, uint32_t *startX, uint32_t *startY, uint32_t *sizeX,
+        uint32_t *sizeY)
+{
+    *startX = *startY = *sizeX = *sizeY = 0;
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL SetQHYCCDBinMode(qhyccd_handle *, uint32_t wbin, uint32_t hbin)
+{
+    if (wbin != hbin || (wbin != 1 && wbin != 2 && wbin != 4))
+        return QHYCCD_ERROR;
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    camera.bin = wbin;
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL SetQHYCCDResolution(qhyccd_handle *, uint32_t x, uint32_t y, uint32_t xsize, uint32_t ysize)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    if (xsize == 0 || ysize == 0 || (x + xsize) * camera.bin > static_cast<uint32_t>(camera.options.width)
+            || (y + ysize) * camera.bin > static_cast<uint32_t>(camera.options.height))
+        return QHYCCD_ERROR;
+    camera.startX = x;
+    camera.startY = y;
+    camera.width  = xsize;
+    camera.height = ysize;
+    camera.sensor.setFrameBytes(frameBytes());
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL SetQHYCCDBitsMode(qhyccd_handle *, uint32_t bits)
+{
+    if (bits != 8 && bits != 16)
+        return QHYCCD_ERROR;
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    camera.bits = bits;
+    camera.values[CONTROL_TRANSFERBIT] = bits;
+    camera.sensor.setFrameBytes(frameBytes());
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL ControlQHYCCDShutter(qhyccd_handle *, uint8_t)
+{
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL ControlQHYCCDGuide(qhyccd_handle *, uint32_t, uint16_t)
+{
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL ExpQHYCCDSingleFrame(qhyccd_handle *)
+{
+    camera.sensor.startExposure();
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL CancelQHYCCDExposingAndReadout(qhyccd_handle *)
+{
+    camera.sensor.stopExposure();
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL GetQHYCCDSingleFrame(qhyccd_handle *, uint32_t *w, uint32_t *h, uint32_t *bpp,
+        uint32_t *channels, uint8_t *imgdata)
+{
+    // Blocks until the exposure is over, with the SDK's default 60 s readout timeout
+    if (!camera.sensor.waitExposure(camera.sensor.exposureMs() + 60000))
+        return QHYCCD_ERROR;
+    frameInfo(w, h, bpp, channels);
+    if (camera.sensor.pull(imgdata, camera.sensor.frameBytes(), "pull") == 0)
+        return QHYCCD_ERROR;
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL BeginQHYCCDLive(qhyccd_handle *)
+{
+    camera.sensor.startVideo();
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL StopQHYCCDLive(qhyccd_handle *)
+{
+    camera.sensor.stopVideo();
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL GetQHYCCDLiveFrame(qhyccd_handle *, uint32_t *w, uint32_t *h, uint32_t *bpp,
+        uint32_t *channels, uint8_t *imgdata)
+{
+    // Never blocks, the driver polls
+    if (!camera.sensor.waitVideoFrame(0))
+        return QHYCCD_ERROR;
+    frameInfo(w, h, bpp, channels);
+    if (camera.sensor.pull(imgdata, camera.sensor.frameBytes(), "video_pull") == 0)
+        return QHYCCD_ERROR;
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL SetQHYCCDGPSVCOXFreq(qhyccd_handle *, uint16_t)
+{
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC uint32_t STDCALL SetQHYCCDGPSLedCalMode(qhyccd_handle *, uint8_t)
+{
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC void STDCALL SetQHYCCDGPSPOSA(qhyccd_handle *, uint8_t, uint32_t, uint8_t)
+{
+}
+
+EXPORTC void STDCALL SetQHYCCDGPSPOSB(qhyccd_handle *, uint8_t, uint32_t, uint8_t)
+{
+}
+
+EXPORTC uint32_t STDCALL SetQHYCCDGPSMasterSlave(qhyccd_handle *, uint8_t)
+{
+    return QHYCCD_SUCCESS;
+}
+
+EXPORTC void STDCALL SetQHYCCDGPSSlaveModeParameter(qhyccd_handle *, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t)
+{
+}
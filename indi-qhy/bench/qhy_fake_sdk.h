@@ -0,0 +1,46 @@
+/*
+ Synthetic QHY SDK for the Driver Benchmark
+
+ Copyright (C) 2026 agent (agent@local)
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <qhyccd.h>
+
+#include "camerabench.h"
+
+// Synthetic stand-in for libqhyccd used by the offline driver benchmark.
+// It implements the subset of the SDK used by QHYCCD on top of
+// CameraBench::FakeSensor, with single frame and live modes. ScanQHYCCD
+// reports no cameras so the driver's hot-plug handler stays idle.
+namespace FakeQHY
+{
+
+/** Camera ID accepted by OpenQHYCCD. */
+extern const char *cameraID;
+
+/** Describe the simulated camera. Must be called before the driver is created. */
+void configure(const CameraBench::Options &options);
+
+/** Time at which the last GetQHYCCDSingleFrame returned, in CameraBench::nowMs() units. */
+double lastPullEnd();
+
+/** Live frames read out since the last BeginQHYCCDLive. */
+uint64_t videoFrames();
+
+}
@@ -25,6 +25,7 @@
 #include "config.h"
 #include <stream/streammanager.h>
 #include <hotplugmanager.h>
+#include <indielapsedtimer.h>
 
 #include <libnova/julian_day.h>
 #include <algorithm>
@@ -32,6 +33,7 @@
 #include <math.h>
 #include <memory>
 #include <deque>
+#include <thread>
 
 #define UPDATE_THRESHOLD       0.05   /* Differential temperature threshold (C)*/
 
@@ -2506,45 +2508,78 @@ void *QHYCCD::imagingThreadEntry()
     return nullptr;
 }
 
+/*
+ * Capture stage of streaming. Frames are read straight into the slots of
+ * m_FrameQueue; GPS decoding and the streamer hand-off run on the
+ * post-processing thread so this loop never waits on INDI property updates.
+ * Called with condMutex held, which is released for the whole session.
+ */
 void QHYCCD::streamVideo()
 {
-    uint32_t ret = 0, w, h, bpp, channels;
-    //uint32_t t_start = time(NULL), frames = 0;
+    pthread_mutex_unlock(&condMutex);
+
+    m_FrameQueue.allocate(STREAM_QUEUE_SLOTS, PrimaryCCD.getFrameBufferSize());
+    std::thread postProcessThread(&QHYCCD::postProcessFrames, this);
+
+    uint32_t w, h, bpp, channels;
     while (m_ThreadRequest == StateStream)
     {
-        pthread_mutex_unlock(&condMutex);
-        uint32_t retries = 0;
-        std::unique_lock<std::mutex> guard(ccdBufferLock);
-        uint8_t *buffer = PrimaryCCD.getFrameBuffer();
-        while (retries++ < 10)
+        QHYFrameQueue::Frame &frame = m_FrameQueue.writeSlot();
+        if (GetQHYCCDLiveFrame(m_CameraHandle, &w, &h, &bpp, &channels, frame.data.data()) != QHYCCD_SUCCESS)
         {
-
-            ret = GetQHYCCDLiveFrame(m_CameraHandle, &w, &h, &bpp, &channels, buffer);
-            if (ret == QHYCCD_ERROR)
-                usleep(1000);
-            else
-                break;
+            // No frame ready yet, the SDK has no blocking call to wait on.
+            usleep(STREAM_POLL_US);
+            continue;
         }
-        guard.unlock();
-        if (ret == QHYCCD_SUCCESS)
+
+        frame.width    = w;
+        frame.height   = h;
+        frame.bpp      = bpp;
+        frame.channels = channels;
+        frame.size     = w * h * bpp / 8 * channels;
+        m_FrameQueue.push();
+    }
+
+    m_FrameQueue.abort();
+    postProcessThread.join();
+
+    LOGF_DEBUG("Streaming stopped: %llu frames captured, %llu dropped by post-processing.",
+               static_cast<unsigned long long>(m_FrameQueue.pushed()),
+               static_cast<unsigned long long>(m_FrameQueue.dropped()));
+    m_FrameQueue.release();
+
+    pthread_mutex_lock(&condMutex);
+}
+
+/*
+ * Post-processing stage of streaming: timestamps frames from the GPS header
+ * when enabled and passes them on to the streamer.
+ */
+void QHYCCD::postProcessFrames()
+{
+    INDI::ElapsedTimer gpsUpdate;
+    bool gpsPublished = false;
+
+    while (QHYFrameQueue::Frame *frame = m_FrameQueue.readSlot())
+    {
+        uint64_t timestamp = 0;
+        if (HasGPS && GPSControlS[INDI_ENABLED].s == ISS_ON)
         {
-            uint64_t timestamp = 0;
-            if (HasGPS && GPSControlS[INDI_ENABLED].s == ISS_ON)
+            parseGPSHeader(frame->data.data());
+            timestamp = (uint64_t)GPSHeader.start_sec * 1e6;
+            timestamp += GPSHeader.start_us + QHY_SER_US_EPOCH;
+
+            // Every frame gets its timestamp, but the properties only need to follow at a readable rate.
+            if (!gpsPublished || gpsUpdate.elapsed() >= STREAM_GPS_UPDATE_MS)
             {
-                decodeGPSHeader();
-                timestamp = (uint64_t)GPSHeader.start_sec * 1e6;
-                timestamp += GPSHeader.start_us + QHY_SER_US_EPOCH;
+                publishGPSHeader();
+                gpsUpdate.start();
+                gpsPublished = true;
             }
-
-            Streamer->newFrame(buffer, w * h * bpp / 8 * channels, timestamp);
-
-            //DEBUG
-            //if(!frames)
-            //    LOGF_DEBUG("Receiving frames ...");
-            //if(!(++frames % 30))
-            //    LOGF_DEBUG("Frames received: %d (%.1f fps)", frames, 1.0 * frames / (time(NULL) - t_start));
         }
-        pthread_mutex_lock(&condMutex);
+
+        Streamer->newFrame(frame->data.data(), frame->size, timestamp);
+        m_FrameQueue.pop();
     }
 }
 
@@ -2759,27 +2794,25 @@ void QHYCCD::setLEDStartPosNP(const INumberVectorProperty &value)
 
 void QHYCCD::decodeGPSHeader()
 {
-    char ts[64] = {0}, iso8601[64] = {0}, data[64] = {0};
+    parseGPSHeader(PrimaryCCD.getFrameBuffer());
+    publishGPSHeader();
+}
 
+void QHYCCD::parseGPSHeader(const uint8_t *frame)
+{
     uint8_t gpsarray[64] = {0};
-    memcpy(gpsarray, PrimaryCCD.getFrameBuffer(), 64);
+    memcpy(gpsarray, frame, 64);
 
     // Sequence Number
     GPSHeader.seqNumber = gpsarray[0] << 24 | gpsarray[1] << 16 | gpsarray[2] << 8 | gpsarray[3];
-    snprintf(data, 64, "%u", GPSHeader.seqNumber);
-    IUSaveText(&GPSDataHeaderT[GPS_DATA_SEQ_NUMBER], data);
 
     GPSHeader.tempNumber = gpsarray[4];
 
     // Width
     GPSHeader.width = gpsarray[5] << 8 | gpsarray[6];
-    snprintf(data, 64, "%u", GPSHeader.width);
-    IUSaveText(&GPSDataHeaderT[GPS_DATA_WIDTH], data);
 
     // Height
     GPSHeader.height = gpsarray[7] << 8 | gpsarray[8];
-    snprintf(data, 64, "%u", GPSHeader.height);
-    IUSaveText(&GPSDataHeaderT[GPS_DATA_HEIGHT], data);
 
     // Latitude
     uint32_t latitude = gpsarray[9] << 24 | gpsarray[10] << 16 | gpsarray[11] << 8 | gpsarray[12];
@@ -2787,8 +2820,6 @@ void QHYCCD::decodeGPSHeader()
     GPSHeader.latitude = (latitude % 1000000000) / 10000000;
     GPSHeader.latitude += (latitude % 10000000) / 6000000.0;
     GPSHeader.latitude *= latitude > 1000000000 ? -1.0 : 1.0;
-    snprintf(data, 64, "%f", GPSHeader.latitude);
-    IUSaveText(&GPSDataHeaderT[GPS_DATA_LATITUDE], data);
 
     // Longitude
     uint32_t longitude = gpsarray[13] << 24 | gpsarray[14] << 16 | gpsarray[15] << 8 | gpsarray[16];
@@ -2796,81 +2827,95 @@ void QHYCCD::decodeGPSHeader()
     GPSHeader.longitude = (longitude % 1000000000) / 1000000;
     GPSHeader.longitude += (longitude % 1000000) / 600000.0;
     GPSHeader.longitude *= longitude > 1000000000 ? -1.0 : 1.0;
-    snprintf(data, 64, "%f", GPSHeader.longitude);
-    IUSaveText(&GPSDataHeaderT[GPS_DATA_LONGITUDE], data);
 
     // Start Flag
     GPSHeader.start_flag = gpsarray[17];
-    snprintf(data, 64, "%u", GPSHeader.start_flag);
-    IUSaveText(&GPSDataStartT[GPS_DATA_START_FLAG], data);
 
     // Start Seconds
     GPSHeader.start_sec = gpsarray[18] << 24 | gpsarray[19] << 16 | gpsarray[20] << 8 | gpsarray[21];
-    snprintf(data, 64, "%u", GPSHeader.start_sec);
-    IUSaveText(&GPSDataStartT[GPS_DATA_START_SEC], data);
 
     // Start microseconds
     // It's a 10Mhz crystal so we divide by 10 to get microseconds
     GPSHeader.start_us = (gpsarray[22] << 16 | gpsarray[23] << 8 | gpsarray[24]) / 10.0;
-    snprintf(data, 64, "%.1f", GPSHeader.start_us);
-    IUSaveText(&GPSDataStartT[GPS_DATA_START_USEC], data);
 
     // Start JD
     GPSHeader.start_jd = JStoJD(GPSHeader.start_sec, GPSHeader.start_us);
-    // Get ISO8601
-    JDtoISO8601(GPSHeader.start_jd, iso8601);
-    // Add millisecond
-    snprintf(ts, sizeof(ts), "%s.%03d", iso8601, static_cast<int>(GPSHeader.start_us / 1000.0));
-    IUSaveText(&GPSDataStartT[GPS_DATA_START_TS], ts);
 
     // End Flag
     GPSHeader.end_flag = gpsarray[25];
-    snprintf(data, 64, "%u", GPSHeader.end_flag);
-    IUSaveText(&GPSDataEndT[GPS_DATA_END_FLAG], data);
 
     // End Seconds
     GPSHeader.end_sec = gpsarray[26] << 24 | gpsarray[27] << 16 | gpsarray[28] << 8 | gpsarray[29];
-    snprintf(data, 64, "%u", GPSHeader.end_sec);
-    IUSaveText(&GPSDataEndT[GPS_DATA_END_SEC], data);
 
     // End Microseconds
     GPSHeader.end_us = (gpsarray[30] << 16 | gpsarray[31] << 8 | gpsarray[32]) / 10.0;
-    snprintf(data, 64, "%.1f", GPSHeader.end_us);
-    IUSaveText(&GPSDataEndT[GPS_DATA_END_USEC], data);
 
     // End JD
     GPSHeader.end_jd = JStoJD(GPSHeader.end_sec, GPSHeader.end_us);
-    // Get ISO8601
-    JDtoISO8601(GPSHeader.end_jd, iso8601);
-    // Add millisecond
-    snprintf(ts, sizeof(ts), "%s.%03d", iso8601, static_cast<int>(GPSHeader.end_us / 1000.0));
-    IUSaveText(&GPSDataEndT[GPS_DATA_END_TS], ts);
 
     // Now Flag
     GPSHeader.now_flag = gpsarray[33];
-    snprintf(data, 64, "%u", GPSHeader.now_flag);
-    IUSaveText(&GPSDataNowT[GPS_DATA_NOW_FLAG], data);
 
     // Now Seconds
     GPSHeader.now_sec = gpsarray[34] << 24 | gpsarray[35] << 16 | gpsarray[36] << 8 | gpsarray[37];
-    snprintf(data, 64, "%u", GPSHeader.now_sec);
-    IUSaveText(&GPSDataNowT[GPS_DATA_NOW_SEC], data);
 
     // Now microseconds
     GPSHeader.now_us = (gpsarray[38] << 16 | gpsarray[39] << 8 | gpsarray[40]) / 10.0;
-    snprintf(data, 64, "%.1f", GPSHeader.now_us);
-    IUSaveText(&GPSDataNowT[GPS_DATA_NOW_USEC], data);
 
     // Now JD
     GPSHeader.now_jd = JStoJD(GPSHeader.now_sec, GPSHeader.now_us);
+
+    // PPS
+    GPSHeader.max_clock = gpsarray[41] << 16 | gpsarray[42] << 8 | gpsarray[43];
+}
+
+void QHYCCD::publishGPSHeader()
+{
+    char ts[64] = {0}, iso8601[64] = {0}, data[64] = {0};
+
+    snprintf(data, 64, "%u", GPSHeader.seqNumber);
+    IUSaveText(&GPSDataHeaderT[GPS_DATA_SEQ_NUMBER], data);
+    snprintf(data, 64, "%u", GPSHeader.width);
+    IUSaveText(&GPSDataHeaderT[GPS_DATA_WIDTH], data);
+    snprintf(data, 64, "%u", GPSHeader.height);
+    IUSaveText(&GPSDataHeaderT[GPS_DATA_HEIGHT], data);
+    snprintf(data, 64, "%f", GPSHeader.latitude);
+    IUSaveText(&GPSDataHeaderT[GPS_DATA_LATITUDE], data);
+    snprintf(data, 64, "%f", GPSHeader.longitude);
+    IUSaveText(&GPSDataHeaderT[GPS_DATA_LONGITUDE], data);
+
+    snprintf(data, 64, "%u", GPSHeader.start_flag);
+    IUSaveText(&GPSDataStartT[GPS_DATA_START_FLAG], data);
+    snprintf(data, 64, "%u", GPSHeader.start_sec);
+    IUSaveText(&GPSDataStartT[GPS_DATA_START_SEC], data);
+    snprintf(data, 64, "%.1f", GPSHeader.start_us);
+    IUSaveText(&GPSDataStartT[GPS_DATA_START_USEC], data);
     // Get ISO8601
-    JDtoISO8601(GPSHeader.now_jd, iso8601);
+    JDtoISO8601(GPSHeader.start_jd, iso8601);
     // Add millisecond
+    snprintf(ts, sizeof(ts), "%s.%03d", iso8601, static_cast<int>(GPSHeader.start_us / 1000.0));
+    IUSaveText(&GPSDataStartT[GPS_DATA_START_TS], ts);
+
+    snprintf(data, 64, "%u", GPSHeader.end_flag);
+    IUSaveText(&GPSDataEndT[GPS_DATA_END_FLAG], data);
+    snprintf(data, 64, "%u", GPSHeader.end_sec);
+    IUSaveText(&GPSDataEndT[GPS_DATA_END_SEC], data);
+    snprintf(data, 64, "%.1f", GPSHeader.end_us);
+    IUSaveText(&GPSDataEndT[GPS_DATA_END_USEC], data);
+    JDtoISO8601(GPSHeader.end_jd, iso8601);
+    snprintf(ts, sizeof(ts), "%s.%03d", iso8601, static_cast<int>(GPSHeader.end_us / 1000.0));
+    IUSaveText(&GPSDataEndT[GPS_DATA_END_TS], ts);
+
+    snprintf(data, 64, "%u", GPSHeader.now_flag);
+    IUSaveText(&GPSDataNowT[GPS_DATA_NOW_FLAG], data);
+    snprintf(data, 64, "%u", GPSHeader.now_sec);
+    IUSaveText(&GPSDataNowT[GPS_DATA_NOW_SEC], data);
+    snprintf(data, 64, "%.1f", GPSHeader.now_us);
+    IUSaveText(&GPSDataNowT[GPS_DATA_NOW_USEC], data);
+    JDtoISO8601(GPSHeader.now_jd, iso8601);
     snprintf(ts, sizeof(ts), "%s.%03d", iso8601, static_cast<int>(GPSHeader.now_us / 1000.0));
     IUSaveText(&GPSDataNowT[GPS_DATA_NOW_TS], ts);
 
-    // PPS
-    GPSHeader.max_clock = gpsarray[41] << 16 | gpsarray[42] << 8 | gpsarray[43];
     snprintf(data, 64, "%u", GPSHeader.max_clock);
     IUSaveText(&GPSDataHeaderT[GPS_DATA_MAX_CLOCK], data);
 
@@ -21,10 +21,13 @@
 
 #pragma once
 
+#include "qhy_frame_queue.h"
+
 #include <qhyccd.h>
 #include <indiccd.h>
 #include <indifilterinterface.h>
 #include <unistd.h>
+#include <atomic>
 #include <functional>
 #include <pthread.h>
 
@@ -396,6 +399,7 @@ class QHYCCD : public INDI::CCD, public INDI::FilterInterface
         static void *imagingHelper(void *context);
         void *imagingThreadEntry();
         void streamVideo();
+        void postProcessFrames();
         void getExposure();
         void exposureSetRequest(ImageState request);
         int grabImage();
@@ -421,8 +425,12 @@ class QHYCCD : public INDI::CCD, public INDI::FilterInterface
         bool isQHY5PIIC();
         // Call when max filter count is known
         bool updateFilterProperties();
-        // Decode GPS Header
+        // Decode GPS Header of the current frame buffer and publish it
         void decodeGPSHeader();
+        // Parse the GPS header at the start of a frame into GPSHeader
+        void parseGPSHeader(const uint8_t *frame);
+        // Update the GPS properties from GPSHeader
+        void publishGPSHeader();
         /**
          * @brief JStoJD Convert Julian Second to Julian Date
          * @param JS Julian Second
@@ -490,8 +498,11 @@ class QHYCCD : public INDI::CCD, public INDI::FilterInterface
         /////////////////////////////////////////////////////////////////////////////
         /// Threading
         /////////////////////////////////////////////////////////////////////////////
-        ImageState m_ThreadRequest;
+        // Atomic so the streaming loop can poll it without taking condMutex
+        std::atomic<ImageState> m_ThreadRequest {StateNone};
         ImageState m_ThreadState;
+        // Frames handed from the capture loop to postProcessFrames() while streaming
+        QHYFrameQueue m_FrameQueue;
         pthread_t m_ImagingThread;
         pthread_cond_t cv         = PTHREAD_COND_INITIALIZER;
         pthread_mutex_t condMutex = PTHREAD_MUTEX_INITIALIZER;
@@ -505,4 +516,10 @@ class QHYCCD : public INDI::CCD, public INDI::FilterInterface
         static constexpr const char * GPS_CONTROL_TAB = "GPS Control";
         static constexpr const char * GPS_DATA_TAB = "GPS Data";
         static constexpr uint64_t QHY_SER_US_EPOCH = 62948880000000000; // offset to SER epoch January 1, 1 AD
+        // Frame slots between capture and post-processing while streaming
+        static constexpr size_t STREAM_QUEUE_SLOTS = 4;
+        // Poll interval while GetQHYCCDLiveFrame has no frame ready
+        static constexpr uint32_t STREAM_POLL_US = 250;
+        // Minimum interval between GPS property updates while streaming
+        static constexpr double STREAM_GPS_UPDATE_MS = 1000;
 };
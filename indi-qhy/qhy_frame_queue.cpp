@@ -0,0 +1,111 @@
+/*
+ QHY Frame Queue
+
+ Copyright (C) 2026 agent (agent@local)
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "qhy_frame_queue.h"
+
+void QHYFrameQueue::allocate(size_t slots, size_t bufferSize)
+{
+    mSlots.resize(slots < 2 ? 2 : slots);
+    for (auto &slot : mSlots)
+        slot.data.resize(bufferSize);
+    mScratch.data.resize(bufferSize);
+
+    mHead     = 0;
+    mTail     = 0;
+    mSleeping = false;
+    mWritingScratch = false;
+    mAborted  = false;
+    mPushed   = 0;
+    mDropped  = 0;
+}
+
+void QHYFrameQueue::release()
+{
+    mSlots.clear();
+    mSlots.shrink_to_fit();
+    mScratch.data.clear();
+    mScratch.data.shrink_to_fit();
+}
+
+bool QHYFrameQueue::full() const
+{
+    return (mTail.load(std::memory_order_relaxed) + 1) % mSlots.size() == mHead.load(std::memory_order_acquire);
+}
+
+QHYFrameQueue::Frame &QHYFrameQueue::writeSlot()
+{
+    mWritingScratch = full();
+    return mWritingScratch ? mScratch : mSlots[mTail.load(std::memory_order_relaxed)];
+}
+
+bool QHYFrameQueue::push()
+{
+    if (mWritingScratch)
+    {
+        ++mDropped;
+        return false;
+    }
+
+    size_t tail = mTail.load(std::memory_order_relaxed);
+    mTail.store((tail + 1) % mSlots.size());
+    ++mPushed;
+
+    if (mSleeping.load())
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCondition.notify_one();
+    }
+    return true;
+}
+
+QHYFrameQueue::Frame *QHYFrameQueue::readSlot()
+{
+    size_t head = mHead.load(std::memory_order_relaxed);
+    auto ready = [&]
+    {
+        return mAborted.load() || mTail.load() != head;
+    };
+
+    if (!ready())
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mSleeping = true;
+        mCondition.wait(lock, ready);
+        mSleeping = false;
+    }
+
+    if (mAborted)
+        return nullptr;
+
+    return &mSlots[head];
+}
+
+void QHYFrameQueue::pop()
+{
+    size_t head = mHead.load(std::memory_order_relaxed);
+    mHead.store((head + 1) % mSlots.size(), std::memory_order_release);
+}
+
+void QHYFrameQueue::abort()
+{
+    mAborted = true;
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCondition.notify_all();
+}
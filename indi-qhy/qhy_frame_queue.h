@@ -0,0 +1,90 @@
+/*
+ QHY Frame Queue
+
+ Copyright (C) 2026 agent (agent@local)
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief The QHYFrameQueue class is a bounded single producer, single consumer
+ * queue of preallocated frame buffers between the USB capture loop and the
+ * post-processing thread.
+ *
+ * Slot hand-over is lock-free. The producer never waits: when the consumer is
+ * behind, the frame is read into a scratch slot and dropped on push. The mutex
+ * is only taken to park and wake an idle consumer.
+ */
+class QHYFrameQueue
+{
+    public:
+        struct Frame
+        {
+            std::vector<uint8_t> data;
+            size_t size {0};
+            uint32_t width {0}, height {0}, bpp {0}, channels {0};
+        };
+
+        /** Allocate slots buffers of bufferSize bytes. Usable depth is slots - 1. */
+        void allocate(size_t slots, size_t bufferSize);
+        void release();
+
+        /** Producer: slot to capture the next frame into, always valid. */
+        Frame &writeSlot();
+        /** Producer: publish the frame in writeSlot(). @return false if it had to be dropped. */
+        bool push();
+
+        /** Consumer: wait for the next frame. @return nullptr once aborted. */
+        Frame *readSlot();
+        /** Consumer: return the frame from readSlot() to the producer. */
+        void pop();
+
+        /** Wake the consumer and make readSlot() return nullptr. */
+        void abort();
+
+        uint64_t pushed() const
+        {
+            return mPushed;
+        }
+        uint64_t dropped() const
+        {
+            return mDropped;
+        }
+
+    private:
+        bool full() const;
+
+        std::vector<Frame> mSlots;
+        Frame mScratch;
+        bool mWritingScratch {false};
+
+        alignas(64) std::atomic<size_t> mHead {0};  // next slot to read, owned by the consumer
+        alignas(64) std::atomic<size_t> mTail {0};  // next slot to write, owned by the producer
+        alignas(64) std::atomic<bool> mSleeping {false};
+        std::atomic<bool> mAborted {false};
+        std::atomic<uint64_t> mPushed {0};
+        std::atomic<uint64_t> mDropped {0};
+
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+};
@@ -0,0 +1,101 @@
+/*
+ SVBONY Driver Benchmark
+
+ Runs the indi_svbony_ccd driver code against a synthetic camera, without any
+ hardware, and reports per-frame latency broken down by pipeline stage.
+
+ Usage:
+   ./svbony_driver_bench [--width <px>] [--height <px>] [--bin <n>] [--color] [--bits <8|16>]
+                         [--frames <N>] [--exposure <s>] [--stream <s>] [--usb <MB/s>] [--json <path>]
+
+ Stages:
+   pull         SVBGetVideoData of a soft triggered frame, including the simulated USB transfer
+   convert      end of pull to ExposureComplete (BGR deinterleave, format setup)
+   encode_send  INDI::CCD::ExposureComplete, i.e. FITS encoding and BLOB send
+   video_pull   SVBGetVideoData while streaming
+
+ Stream frames are the frames read from the SDK; the driver does not count drops.
+ The report is written as JSON, see common/camerabench.h.
+
+ Copyright (C) 2026 agent (agent@local)
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "svbony_base.h"
+#include "svbony_fake_sdk.h"
+#include "camerabench_driver.h"
+
+class BenchSVBONY : public SVBONYBase
+{
+    public:
+        explicit BenchSVBONY(const SVB_CAMERA_INFO &camInfo)
+        {
+            mCameraInfo = camInfo;
+            mSerialNumber = camInfo.CameraSN;
+            mCameraName = camInfo.FriendlyName;
+            setDeviceName(mCameraName.c_str());
+        }
+
+        CameraBench::Completion completion;
+
+    protected:
+        virtual bool ExposureComplete(INDI::CCDChip *targetChip) override
+        {
+            CameraBench::recorder().add("convert", CameraBench::nowMs() - FakeSVB::lastPullEnd());
+
+            bool rc;
+            {
+                CameraBench::StageTimer timer("encode_send");
+                rc = SVBONYBase::ExposureComplete(targetChip);
+            }
+            completion.signal();
+            return rc;
+        }
+};
+
+int main(int argc, char *argv[])
+{
+    CameraBench::Options options;
+    if (!CameraBench::parseOptions(argc, argv, options))
+        return 1;
+
+    FILE *report = CameraBench::reportStream(options);
+    if (report == nullptr)
+        return 1;
+
+    FakeSVB::configure(options);
+    BenchSVBONY camera(FakeSVB::cameraInfo());
+
+    if (!CameraBench::connect(camera, options))
+        return 1;
+
+    CameraBench::Report result;
+    result.driver = "indi_svbony_ccd";
+    result.camera = camera.getDeviceName();
+
+    CameraBench::recorder().clear();
+    if (!CameraBench::runExposures(camera, options, camera.completion, result.latency))
+        return 1;
+
+    CameraBench::runStream(camera, options, result.stream, [] { return FakeSVB::videoFrames(); });
+
+    result.stages = CameraBench::recorder().snapshot();
+    camera.Disconnect();
+
+    CameraBench::writeReport(report, options, result);
+    fclose(report);
+    return 0;
+}
@@ -0,0 +1,360 @@
+/*
+    Synthetic SVBony SDK for the Driver Benchmark
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "svbony_fake_sdk.h"
+
+#include <cstring>
+#include <map>
+#include <mutex>
+
+namespace
+{
+
+struct Control
+{
+    const char *name;
+    SVB_CONTROL_TYPE type;
+    long min, max, def;
+    SVB_BOOL autoSupported;
+    SVB_BOOL writable;
+};
+
+const Control controls[] =
+{
+    {"Gain",                SVB_GAIN,                        0, 720,       0,     SVB_TRUE,  SVB_TRUE},
+    {"Exposure",            SVB_EXPOSURE,                    29, 2000000000, 10000, SVB_TRUE,  SVB_TRUE},
+    {"Gamma",               SVB_GAMMA,                       0, 1000,      100,   SVB_FALSE, SVB_TRUE},
+    {"Flip",                SVB_FLIP,                        0, 3,         0,     SVB_FALSE, SVB_TRUE},
+    {"Frame speed",         SVB_FRAME_SPEED_MODE,            0, 2,         2,     SVB_FALSE, SVB_TRUE},
+    {"Black level",         SVB_BLACK_LEVEL,                 0, 255,       10,    SVB_FALSE, SVB_TRUE},
+    {"Bad pixel correction", SVB_BAD_PIXEL_CORRECTION_ENABLE, 0, 1,         0,     SVB_FALSE, SVB_TRUE},
+};
+
+struct Camera
+{
+    SVB_CAMERA_INFO info {};
+    SVB_CAMERA_PROPERTY property {};
+
+    std::mutex mutex;
+    std::map<int, long> values;
+    int width {0}, height {0}, bin {1}, startX {0}, startY {0};
+    SVB_IMG_TYPE type {SVB_IMG_RAW16};
+    SVB_CAMERA_MODE mode {SVB_MODE_NORMAL};
+    bool capturing {false};
+
+    CameraBench::FakeSensor sensor;
+} camera;
+
+size_t frameBytes()
+{
+    size_t bytes = static_cast<size_t>(camera.width) * camera.height;
+    switch (camera.type)
+    {
+        case SVB_IMG_RAW8:
+        case SVB_IMG_Y8:
+            return bytes;
+        case SVB_IMG_RGB24:
+            return bytes * 3;
+        case SVB_IMG_RGB32:
+            return bytes * 4;
+        default:
+            return bytes * 2;
+    }
+}
+
+}
+
+namespace FakeSVB
+{
+
+void configure(const CameraBench::Options &options)
+{
+    camera.sensor.configure(options);
+
+    SVB_CAMERA_INFO &info = camera.info;
+    memset(&info, 0, sizeof(info));
+    snprintf(info.FriendlyName, sizeof(info.FriendlyName), "SVBONY Fake%s", options.color ? "C" : "M");
+    snprintf(info.CameraSN, sizeof(info.CameraSN), "BENCH0001");
+    snprintf(info.PortType, sizeof(info.PortType), "USB3.0");
+    info.CameraID = 0;
+
+    SVB_CAMERA_PROPERTY &property = camera.property;
+    memset(&property, 0, sizeof(property));
+    property.MaxWidth     = options.width;
+    property.MaxHeight    = options.height;
+    property.IsColorCam   = options.color ? SVB_TRUE : SVB_FALSE;
+    property.BayerPattern = SVB_BAYER_RG;
+    property.SupportedBins[0] = 1;
+    property.SupportedBins[1] = 2;
+    property.SupportedBins[2] = 4;
+    int f = 0;
+    property.SupportedVideoFormat[f++] = SVB_IMG_RAW8;
+    if (options.color)
+        property.SupportedVideoFormat[f++] = SVB_IMG_RGB24;
+    property.SupportedVideoFormat[f++] = SVB_IMG_RAW16;
+    property.SupportedVideoFormat[f++] = SVB_IMG_END;
+    property.MaxBitDepth  = 12;
+    property.IsTriggerCam = SVB_TRUE;
+
+    for (const auto &it : controls)
+        camera.values[it.type] = it.def;
+
+    camera.width  = options.width;
+    camera.height = options.height;
+    camera.type   = options.color ? SVB_IMG_RGB24 : (options.bitDepth == 8 ? SVB_IMG_RAW8 : SVB_IMG_RAW16);
+    camera.sensor.setFrameBytes(frameBytes());
+    camera.sensor.setExposureMs(camera.values[SVB_EXPOSURE] / 1000.0);
+}
+
+SVB_CAMERA_INFO cameraInfo()
+{
+    return camera.info;
+}
+
+double lastPullEnd()
+{
+    return camera.sensor.lastPullEnd();
+}
+
+uint64_t videoFrames()
+{
+    return camera.sensor.videoFrames();
+}
+
+}
+
+extern "C" {
+
+int SVBGetNumOfConnectedCameras()
+{
+    return 1;
+}
+
+SVB_ERROR_CODE SVBGetCameraInfo(SVB_CAMERA_INFO *pSVBCameraInfo, int iCameraIndex)
+{
+    if (iCameraIndex != 0)
+        return SVB_ERROR_INVALID_INDEX;
+    *pSVBCameraInfo = camera.info;
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBGetCameraProperty(int, SVB_CAMERA_PROPERTY *pCameraProperty)
+{
+    *pCameraProperty = camera.property;
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBGetCameraPropertyEx(int, SVB_CAMERA_PROPERTY_EX *pCameraPorpertyEx)
+{
+    memset(pCameraPorpertyEx, 0, sizeof(*pCameraPorpertyEx));
+    pCameraPorpertyEx->bSupportPulseGuide = SVB_TRUE;
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBOpenCamera(int)
+{
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBCloseCamera(int)
+{
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBRestoreDefaultParam(int)
+{
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBSetAutoSaveParam(int, SVB_BOOL)
+{
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBGetNumOfControls(int, int *piNumberOfControls)
+{
+    *piNumberOfControls = sizeof(controls) / sizeof(controls[0]);
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBGetControlCaps(int, int iControlIndex, SVB_CONTROL_CAPS *pControlCaps)
+{
+    if (iControlIndex < 0 || iControlIndex >= static_cast<int>(sizeof(controls) / sizeof(controls[0])))
+        return SVB_ERROR_INVALID_CONTROL_TYPE;
+
+    const Control &it = controls[iControlIndex];
+    memset(pControlCaps, 0, sizeof(*pControlCaps));
+    snprintf(pControlCaps->Name, sizeof(pControlCaps->Name), "%s", it.name);
+    snprintf(pControlCaps->Description, sizeof(pControlCaps->Description), "%s", it.name);
+    pControlCaps->MinValue        = it.min;
+    pControlCaps->MaxValue        = it.max;
+    pControlCaps->DefaultValue    = it.def;
+    pControlCaps->IsAutoSupported = it.autoSupported;
+    pControlCaps->IsWritable      = it.writable;
+    pControlCaps->ControlType     = it.type;
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBGetControlValue(int, SVB_CONTROL_TYPE ControlType, long *plValue, SVB_BOOL *pbAuto)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    auto it = camera.values.find(ControlType);
+    if (it == camera.values.end())
+        return SVB_ERROR_INVALID_CONTROL_TYPE;
+    *plValue = it->second;
+    if (pbAuto)
+        *pbAuto = SVB_FALSE;
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBSetControlValue(int, SVB_CONTROL_TYPE ControlType, long lValue, SVB_BOOL)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    auto it = camera.values.find(ControlType);
+    if (it == camera.values.end())
+        return SVB_ERROR_INVALID_CONTROL_TYPE;
+    it->second = lValue;
+    if (ControlType == SVB_EXPOSURE)
+        camera.sensor.setExposureMs(lValue / 1000.0);
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBGetOutputImageType(int, SVB_IMG_TYPE *pImageType)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    *pImageType = camera.type;
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBSetOutputImageType(int, SVB_IMG_TYPE ImageType)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    camera.type = ImageType;
+    camera.sensor.setFrameBytes(frameBytes());
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBSetROIFormat(int, int iStartX, int iStartY, int iWidth, int iHeight, int iBin)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    if (iWidth <= 0 || iHeight <= 0 || iWidth * iBin > camera.property.MaxWidth
+            || iHeight * iBin > camera.property.MaxHeight)
+        return SVB_ERROR_INVALID_SIZE;
+    camera.startX = iStartX;
+    camera.startY = iStartY;
+    camera.width  = iWidth;
+    camera.height = iHeight;
+    camera.bin    = iBin;
+    camera.sensor.setFrameBytes(frameBytes());
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBGetROIFormat(int, int *piStartX, int *piStartY, int *piWidth, int *piHeight, int *piBin)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    *piStartX = camera.startX;
+    *piStartY = camera.startY;
+    *piWidth  = camera.width;
+    *piHeight = camera.height;
+    *piBin    = camera.bin;
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBSetCameraMode(int, SVB_CAMERA_MODE mode)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    if (camera.capturing)
+        return SVB_ERROR_VIDEO_MODE_ACTIVE;
+    camera.mode = mode;
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBStartVideoCapture(int)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    camera.capturing = true;
+    // In soft trigger mode every frame waits for SVBSendSoftTrigger
+    if (camera.mode == SVB_MODE_NORMAL)
+        camera.sensor.startVideo();
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBStopVideoCapture(int)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    camera.capturing = false;
+    camera.sensor.stopVideo();
+    camera.sensor.stopExposure();
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBSendSoftTrigger(int)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    if (!camera.capturing || camera.mode != SVB_MODE_TRIG_SOFT)
+        return SVB_ERROR_INVALID_MODE;
+    camera.sensor.startExposure();
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBGetVideoData(int, unsigned char *pBuffer, long lBuffSize, int iWaitms)
+{
+    SVB_CAMERA_MODE mode;
+    {
+        std::lock_guard<std::mutex> lock(camera.mutex);
+        if (!camera.capturing)
+            return SVB_ERROR_INVALID_SEQUENCE;
+        mode = camera.mode;
+    }
+
+    // Like the SDK, a read without a triggered frame blocks for the full wait
+    if (mode == SVB_MODE_NORMAL)
+    {
+        if (!camera.sensor.waitVideoFrame(iWaitms))
+            return SVB_ERROR_TIMEOUT;
+        if (camera.sensor.pull(pBuffer, lBuffSize, "video_pull") == 0)
+            return SVB_ERROR_BUFFER_TOO_SMALL;
+        return SVB_SUCCESS;
+    }
+
+    if (!camera.sensor.waitExposure(iWaitms))
+        return SVB_ERROR_TIMEOUT;
+    if (camera.sensor.pull(pBuffer, lBuffSize, "pull") == 0)
+        return SVB_ERROR_BUFFER_TOO_SMALL;
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBPulseGuide(int, SVB_GUIDE_DIRECTION, int)
+{
+    return SVB_SUCCESS;
+}
+
+SVB_ERROR_CODE SVBGetSensorPixelSize(int, float *fPixelSize)
+{
+    *fPixelSize = 2.9f;
+    return SVB_SUCCESS;
+}
+
+const char *SVBGetSDKVersion()
+{
+    return "1.0.0-fake";
+}
+
+}
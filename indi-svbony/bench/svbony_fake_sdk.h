@@ -0,0 +1,45 @@
+/*
+    Synthetic SVBony SDK for the Driver Benchmark
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <SVBCameraSDK.h>
+
+#include "camerabench.h"
+
+// Synthetic stand-in for libSVBCameraSDK used by the offline driver benchmark.
+// It implements the subset of the SDK used by SVBONYBase on top of
+// CameraBench::FakeSensor, with soft trigger and normal (video) modes.
+namespace FakeSVB
+{
+
+/** Describe the simulated camera. Must be called before the driver is created. */
+void configure(const CameraBench::Options &options);
+
+/** Camera info matching the configured sensor. */
+SVB_CAMERA_INFO cameraInfo();
+
+/** Time at which the last exposure was read out, in CameraBench::nowMs() units. */
+double lastPullEnd();
+
+/** Video frames read out since the last SVBStartVideoCapture in normal mode. */
+uint64_t videoFrames();
+
+}
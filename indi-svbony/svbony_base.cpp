@@ -23,6 +23,7 @@
 
 #include "svbony_base.h"
 #include "svbony_helpers.h"
+#include "pixelconvert.h"
 
 #include "config.h"
 
@@ -141,8 +142,7 @@ void SVBONYBase::workerStreamVideo(const std::atomic_bool &isAboutToQuit)
             if (Helpers::isRGB(mCurrentVideoFormat))
             {
                 int nChannels = Helpers::getNChannels(mCurrentVideoFormat);
-                for (uint32_t i = 0; i < totalBytes; i += nChannels)
-                    std::swap(targetFrame[i], targetFrame[i + 2]); // swap R and B channel.
+                PixelConvert::swapRB8(targetFrame, totalBytes / nChannels, nChannels);
             }
 
             Streamer->newFrame(targetFrame, totalBytes);
@@ -240,13 +240,8 @@ void SVBONYBase::workerExposure(const std::atomic_bool &isAboutToQuit, float dur
 
     if (Helpers::isRGB(type))
     {
-        buffer = static_cast<uint8_t *>(malloc(nTotalBytes));
-        if (buffer == nullptr)
-        {
-            LOGF_ERROR("%s: %d malloc failed (RGB 24/32).", getDeviceName(), nTotalBytes);
-            guard.unlock();
-            return;
-        }
+        mRGBBuffer.resize(nTotalBytes);
+        buffer = mRGBBuffer.data();
     }
 
     /*
@@ -259,8 +254,6 @@ void SVBONYBase::workerExposure(const std::atomic_bool &isAboutToQuit, float dur
         {
             ret = SVBGetVideoData(mCameraInfo.CameraID, buffer, nTotalBytes,  1000);
             LOGF_DEBUG("Discard unretrieved exposure data: SVBGetVideoData(%s)", Helpers::toString(ret));
-            if (Helpers::isRGB(type))
-                free(buffer);
             guard.unlock();
             PrimaryCCD.setExposureLeft(0);
             return;
@@ -294,41 +287,9 @@ void SVBONYBase::workerExposure(const std::atomic_bool &isAboutToQuit, float dur
             switch (ret)
             {
                 case SVB_SUCCESS:
+                    // BGR(A) to separate R, G, B (and alpha) planes
                     if (Helpers::isRGB(type))
-                    {
-                        uint8_t *dstR = image;
-                        uint8_t *dstG = image + subW * subH;
-                        uint8_t *dstB = image + subW * subH * 2;
-
-                        const uint8_t *src = buffer;
-
-                        /*
-                            To optimize execution speed, RGB32 and RGB24 are discriminated outside of while loop.
-                        */
-                        if (type == SVB_IMG_RGB32)
-                        {
-                            const uint8_t *end = buffer + subW * subH * 4;
-                            uint8_t *dstA = image + subW * subH * 3; // Alpha channel destination address
-                            while (src != end)
-                            {
-                                *dstB++ = *src++;
-                                *dstG++ = *src++;
-                                *dstR++ = *src++;
-                                *dstA++ = *src++;
-                            }
-                        }
-                        else
-                        {
-                            const uint8_t *end = buffer + subW * subH * 3;
-                            while (src != end)
-                            {
-                                *dstB++ = *src++;
-                                *dstG++ = *src++;
-                                *dstR++ = *src++;
-                            }
-                        }
-                        free(buffer);
-                    }
+                        PixelConvert::deinterleave8(buffer, image, subW * subH, nChannels, PixelConvert::ORDER_BGR);
                     guard.unlock();
                     sendImage(type, duration);
 
@@ -350,8 +311,6 @@ void SVBONYBase::workerExposure(const std::atomic_bool &isAboutToQuit, float dur
                     }
                 //fall through
                 default: // Cannot continue to retrive image data when ret is any error except timeout.
-                    if (Helpers::isRGB(type))
-                        free(buffer);
                     guard.unlock();
                     PrimaryCCD.setExposureLeft(0);
                     PrimaryCCD.setExposureFailed();
@@ -173,5 +173,7 @@ class SVBONYBase : public INDI::CCD
         SVB_CAMERA_PROPERTY_EX mCameraPropertyExtended;
         uint8_t mExposureRetry {0};
         SVB_IMG_TYPE mCurrentVideoFormat;
+        /** Read buffer for RGB24/RGB32 frames, kept across exposures */
+        std::vector<uint8_t> mRGBBuffer;
         std::vector<SVB_CONTROL_CAPS> mControlCaps;
 };
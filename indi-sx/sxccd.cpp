@@ -33,8 +33,10 @@
 
 #include "sxconfig.h"
 
+#include <algorithm>
 #include <cmath>
 #include <deque>
+#include <functional>
 #include <memory>
 #include <unistd.h>
 
@@ -103,6 +105,7 @@ SXCCD::SXCCD(DEVICE device, const char *name)
     ExposureTimerID       = 0;
     DidFlush              = false;
     DidLatch              = false;
+    ReadoutAborted        = false;
     GuideExposureTimerID  = 0;
     InGuideExposure       = false;
     DidGuideLatch         = false;
@@ -115,6 +118,7 @@ SXCCD::SXCCD(DEVICE device, const char *name)
 
 SXCCD::~SXCCD()
 {
+    ReadoutWorker.quit();
     if (handle)
         sxClose(&handle);
 }
@@ -295,6 +299,7 @@ bool SXCCD::Connect()
 
 bool SXCCD::Disconnect()
 {
+    ReadoutWorker.quit();
     if (handle != nullptr)
     {
         sxClose(&handle);
@@ -389,6 +394,9 @@ int SXCCD::SetTemperature(double temperature)
 {
     int result         = 0;
     TemperatureRequest = temperature;
+    // The cooler reply would be read from the pipe carrying the pixels, TimerHit applies it after the readout.
+    if (DidLatch)
+        return 0;
     unsigned char status;
     unsigned short sx_temperature;
     sxSetCooler(handle, (unsigned char)(CoolerS[0].s == ISS_ON), (unsigned short)(TemperatureRequest * 10 + 2730),
@@ -411,6 +419,13 @@ int SXCCD::SetTemperature(double temperature)
 
 bool SXCCD::StartExposure(float n)
 {
+    // An aborted frame is still coming down the pipe, the camera cannot take commands yet.
+    if (DidLatch)
+    {
+        LOG_ERROR("Previous readout still in progress, try again shortly.");
+        return false;
+    }
+    ReadoutAborted = false;
     InExposure = true;
     PrimaryCCD.setExposureDuration(n);
     if (sxIsInterlaced(model) && PrimaryCCD.getBinY() == 1)
@@ -445,12 +460,21 @@ bool SXCCD::AbortExposure()
     {
         if (ExposureTimerID)
             IERmTimer(ExposureTimerID);
-        if (HasShutter)
-            sxSetShutter(handle, 1);
         ExposureTimerID = 0;
+        InExposure      = false;
         PrimaryCCD.setExposureLeft(ExposureTimeLeft = 0);
-        DidLatch = false;
         DidFlush = false;
+        {
+            // The worker finishes the transfer on its own and drops the frame, nothing waits for it here.
+            std::lock_guard<std::mutex> lock(ReadoutLock);
+            if (DidLatch)
+            {
+                ReadoutAborted = true;
+                return true;
+            }
+        }
+        if (HasShutter)
+            sxSetShutter(handle, 1);
         return true;
     }
     return false;
@@ -468,120 +492,173 @@ void SXCCD::ExposureTimerHit()
         }
         else
         {
-            int rc;
-            ExposureTimerID   = 0;
-            bool isInterlaced = sxIsInterlaced(model);
-            int subX          = PrimaryCCD.getSubX();
-            int subY          = PrimaryCCD.getSubY();
-            int subW          = PrimaryCCD.getSubW();
-            int subH          = PrimaryCCD.getSubH();
-            int binX          = PrimaryCCD.getBinX();
-            int binY          = PrimaryCCD.getBinY();
-            int subWW         = subW * 2;
-            bool isICX453     = sxIsICX453(model);
-            uint8_t *buf      = PrimaryCCD.getFrameBuffer();
-            int size;
-            if (isInterlaced && binY > 1)
-                size = subW * subH / 2 / binX / (binY / 2);
-            else
-                size = subW * subH / binX / binY;
+            ExposureTimerID = 0;
             if (HasShutter)
                 sxSetShutter(handle, 1);
+            // Latch and download on the worker so guiding and property updates keep running.
             DidLatch = true;
-            if (isInterlaced)
+            ReadoutWorker.start(std::bind(&SXCCD::ReadoutWorkerHit, this, std::placeholders::_1));
+        }
+    }
+}
+
+// Interleaves the two interlaced fields into the frame as rows of the second field arrive.
+struct FieldMerge
+{
+    uint8_t *frame;
+    const char *evenField;
+    const char *oddField;
+    int rowBytes;
+    int rows;
+    int merged;
+};
+
+static void mergeFields(void *context, unsigned long received)
+{
+    FieldMerge *merge = static_cast<FieldMerge *>(context);
+    int ready = std::min<unsigned long>(merge->rows, received / merge->rowBytes);
+    for (; merge->merged < ready; merge->merged++)
+    {
+        int j = merge->merged;
+        memcpy(merge->frame + 2 * j * merge->rowBytes, merge->oddField + j * merge->rowBytes, merge->rowBytes);
+        memcpy(merge->frame + (2 * j + 1) * merge->rowBytes, merge->evenField + j * merge->rowBytes, merge->rowBytes);
+    }
+}
+
+// Reorders ICX453 double width rows into the Bayer frame as they arrive.
+struct ICX453Reorder
+{
+    uint16_t *frame;
+    const uint16_t *raw;
+    int subW;
+    int subH;
+    int offset_1;
+    int offset_2;
+    int rows;
+};
+
+static void reorderICX453(void *context, unsigned long received)
+{
+    ICX453Reorder *reorder = static_cast<ICX453Reorder *>(context);
+    int subW = reorder->subW;
+    for (int i = reorder->rows; i < reorder->subH; i += 2)
+    {
+        // Output rows i and i + 1 come from one raw row of 2 * subW pixels.
+        if ((static_cast<unsigned long>(i) + 2) * subW * 2 > received)
+            break;
+
+        int isubW  = i * subW;
+        int i1subW = (i + 1) * subW;
+        for (int j = 0; j < subW; j += 2)
+        {
+            int j2 = j * 2;
+            reorder->frame[isubW + j]      = reorder->raw[isubW + j2];
+            reorder->frame[isubW + j + 1]  = reorder->raw[isubW + j2 + reorder->offset_1];
+            reorder->frame[i1subW + j]     = reorder->raw[isubW + j2 + 1];
+            reorder->frame[i1subW + j + 1] = reorder->raw[isubW + j2 + reorder->offset_2];
+        }
+        reorder->rows = i + 2;
+    }
+}
+
+void SXCCD::ReadoutWorkerHit(const std::atomic_bool &isAboutToQuit)
+{
+    int rc;
+    bool isInterlaced = sxIsInterlaced(model);
+    int subX          = PrimaryCCD.getSubX();
+    int subY          = PrimaryCCD.getSubY();
+    int subW          = PrimaryCCD.getSubW();
+    int subH          = PrimaryCCD.getSubH();
+    int binX          = PrimaryCCD.getBinX();
+    int binY          = PrimaryCCD.getBinY();
+    bool isICX453     = sxIsICX453(model);
+    uint8_t *buf      = PrimaryCCD.getFrameBuffer();
+    int size;
+    if (isInterlaced && binY > 1)
+        size = subW * subH / 2 / binX / (binY / 2);
+    else
+        size = subW * subH / binX / binY;
+    if (isInterlaced)
+    {
+        if (binY > 1)
+        {
+            rc = sxLatchPixels(handle, CCD_EXP_FLAGS_FIELD_BOTH, 0, subX, subY / binY, subW, subH / 2, binX,
+                               binY / 2);
+            if (rc)
+                rc = sxReadPixelsAsync(handle, buf, size * 2);
+        }
+        else
+        {
+            rc = sxLatchPixels(handle, CCD_EXP_FLAGS_FIELD_EVEN | CCD_EXP_FLAGS_SPARE2, 0, subX, subY / 2, subW,
+                               subH / 2, binX, 1);
+            struct timeval tv;
+            gettimeofday(&tv, nullptr);
+            long startTime = tv.tv_sec * 1000000 + tv.tv_usec;
+            if (rc)
+                rc = sxReadPixelsAsync(handle, evenBuf, size);
+            gettimeofday(&tv, nullptr);
+            wipeDelay = tv.tv_sec * 1000000 + tv.tv_usec - startTime;
+            if (rc)
+                rc = sxLatchPixels(handle, CCD_EXP_FLAGS_FIELD_ODD | CCD_EXP_FLAGS_SPARE2, 0, subX, subY / 2,
+                                   subW, subH / 2, binX, 1);
+            if (rc)
             {
-                if (binY > 1)
-                {
-                    rc = sxLatchPixels(handle, CCD_EXP_FLAGS_FIELD_BOTH, 0, subX, subY / binY, subW, subH / 2, binX,
-                                       binY / 2);
-                    if (rc)
-                        rc = sxReadPixels(handle, buf, size * 2);
-                }
-                else
-                {
-                    rc = sxLatchPixels(handle, CCD_EXP_FLAGS_FIELD_EVEN | CCD_EXP_FLAGS_SPARE2, 0, subX, subY / 2, subW,
-                                       subH / 2, binX, 1);
-                    struct timeval tv;
-                    gettimeofday(&tv, nullptr);
-                    long startTime = tv.tv_sec * 1000000 + tv.tv_usec;
-                    if (rc)
-                        rc = sxReadPixels(handle, evenBuf, size);
-                    gettimeofday(&tv, nullptr);
-                    wipeDelay = tv.tv_sec * 1000000 + tv.tv_usec - startTime;
-                    if (rc)
-                        rc = sxLatchPixels(handle, CCD_EXP_FLAGS_FIELD_ODD | CCD_EXP_FLAGS_SPARE2, 0, subX, subY / 2,
-                                           subW, subH / 2, binX, 1);
-                    if (rc)
-                        rc = sxReadPixels(handle, oddBuf, size);
-                    if (rc)
-                    {
-                        for (int i = 0, j = 0; i < subH; i += 2, j++)
-                        {
-                            memcpy(buf + i * subWW, oddBuf + (j * subWW), subWW);
-                            memcpy(buf + ((i + 1) * subWW), evenBuf + (j * subWW), subWW);
-                        }
-                        //            deinterlace((unsigned short *)buf, subW, subH);
-                    }
-                }
+                // Rows are merged while the rest of the odd field is still in flight.
+                FieldMerge merge = { buf, evenBuf, oddBuf, subW / binX * 2, subH / 2, 0 };
+                rc = sxReadPixelsAsync(handle, oddBuf, size, mergeFields, &merge);
+                //            deinterlace((unsigned short *)buf, subW, subH);
             }
-            else if (isICX453)
+        }
+    }
+    else if (isICX453)
+    {
+        rc = sxLatchPixels(handle, CCD_EXP_FLAGS_FIELD_BOTH, 0, subX * 2, subY / 2, subW * 2, subH / 2, binX, binY);
+        if (rc)
+        {
+            if (binX == 1 && binY == 1)
             {
-                rc = sxLatchPixels(handle, CCD_EXP_FLAGS_FIELD_BOTH, 0, subX * 2, subY / 2, subW * 2, subH / 2, binX, binY);
-                if (rc)
+                int offset_1 = 2, offset_2 = 3;
+                if (strstr(getDeviceName(), "SXVF-M25C"))
                 {
-                    if (binX == 1 && binY == 1)
-                    {
-                        rc = sxReadPixels(handle, evenBuf, size * 2);
-                        if (rc)
-                        {
-                            uint16_t *buf16 = reinterpret_cast<uint16_t *>(buf);
-                            uint16_t *evenBuf16 = reinterpret_cast<uint16_t *>(evenBuf);
-
-                            int offset_1 = 2, offset_2 = 3;
-                            if (strstr(getDeviceName(), "SXVF-M25C"))
-                            {
-                                // Patch by Greg Bosch on 2020-01-02 to fix bayer pattern
-                                // on SXVF-M25C.
-                                offset_1 = 3;
-                                offset_2 = 2;
-                            }
-
-                            for (int i = 0; i < subH; i += 2)
-                            {
-                                for (int j = 0; j < subW; j += 2)
-                                {
-                                    int isubW = i * subW;
-                                    int i1subW = (i + 1) * subW;
-                                    int j2 = j * 2;
-
-                                    buf16[isubW + j]  = evenBuf16[isubW + j2];
-                                    buf16[isubW + j + 1]  = evenBuf16[isubW + j2 + offset_1];
-                                    buf16[i1subW + j]  = evenBuf16[isubW + j2 + 1];
-                                    buf16[i1subW + j + 1]  = evenBuf16[isubW + j2 + offset_2];
-
-                                }
-                            }
-                        }
-                    }
-                    else
-                    {
-                        rc = sxReadPixels(handle, buf, size * 2);
-                    }
+                    // Patch by Greg Bosch on 2020-01-02 to fix bayer pattern
+                    // on SXVF-M25C.
+                    offset_1 = 3;
+                    offset_2 = 2;
                 }
+
+                ICX453Reorder reorder = { reinterpret_cast<uint16_t *>(buf), reinterpret_cast<uint16_t *>(evenBuf),
+                                          subW, subH, offset_1, offset_2, 0
+                                        };
+                rc = sxReadPixelsAsync(handle, evenBuf, size * 2, reorderICX453, &reorder);
             }
             else
             {
-                rc = sxLatchPixels(handle, CCD_EXP_FLAGS_FIELD_BOTH, 0, subX, subY, subW, subH, binX, binY);
-                if (rc)
-                    rc = sxReadPixels(handle, buf, size * 2);
+                rc = sxReadPixelsAsync(handle, buf, size * 2);
             }
-            DidLatch   = false;
-            InExposure = false;
-            PrimaryCCD.setExposureLeft(ExposureTimeLeft = 0);
-            if (rc)
-                ExposureComplete(&PrimaryCCD);
         }
     }
+    else
+    {
+        rc = sxLatchPixels(handle, CCD_EXP_FLAGS_FIELD_BOTH, 0, subX, subY, subW, subH, binX, binY);
+        if (rc)
+            rc = sxReadPixelsAsync(handle, buf, size * 2);
+    }
+    // A started download is not cancelled, the camera would still send the rest of the frame
+    // and the next command would read pixels as its reply. An abort just discards the frame.
+    bool aborted;
+    {
+        std::lock_guard<std::mutex> lock(ReadoutLock);
+        aborted  = ReadoutAborted || isAboutToQuit;
+        DidLatch = false;
+    }
+    if (aborted)
+        return;
+    InExposure = false;
+    PrimaryCCD.setExposureLeft(ExposureTimeLeft = 0);
+    if (rc)
+        ExposureComplete(&PrimaryCCD);
+    else
+        LOG_ERROR("Failed to download the image.");
 }
 
 bool SXCCD::StartGuideExposure(float n)
@@ -615,6 +692,12 @@ void SXCCD::GuideExposureTimerHit()
 {
     if (InGuideExposure)
     {
+        // Wait for the primary readout, both would be read from the same pipe.
+        if (DidLatch)
+        {
+            GuideExposureTimerID = IEAddTimer(100, GuideExposureTimerCallback, this);
+            return;
+        }
         int rc;
         GuideExposureTimerID = 0;
         int subX             = GuideCCD.getSubX();
@@ -34,6 +34,10 @@
 #include "sxccdusb.h"
 
 #include <indiccd.h>
+#include <indisinglethreadpool.h>
+
+#include <atomic>
+#include <mutex>
 
 void ExposureTimerCallback(void *p);
 void GuideExposureTimerCallback(void *p);
@@ -64,10 +68,16 @@ class SXCCD : public INDI::CCD
         int WEGuiderTimerID;
         int NSGuiderTimerID;
         bool DidFlush;
-        bool DidLatch;
+        // Set while the primary CCD is read out on the worker, the USB IN pipe is busy
+        std::atomic_bool DidLatch;
+        // Set by AbortExposure while the worker reads out, the worker then drops the frame
+        bool ReadoutAborted;
+        // Guards DidLatch and ReadoutAborted when the readout ends
+        std::mutex ReadoutLock;
         bool DidGuideLatch;
         bool InGuideExposure;
         char GuideStatus;
+        INDI::SingleThreadPool ReadoutWorker;
 
     protected:
         const char *getDefaultName();
@@ -85,6 +95,7 @@ class SXCCD : public INDI::CCD
         bool AbortGuideExposure();
         void TimerHit();
         void ExposureTimerHit();
+        void ReadoutWorkerHit(const std::atomic_bool &isAboutToQuit);
         void GuideExposureTimerHit();
         void WEGuiderTimerHit();
         void NSGuiderTimerHit();
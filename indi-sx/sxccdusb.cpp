@@ -39,7 +39,10 @@
 
 #include <indidevapi.h>
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include <stdarg.h>
 #include <stdlib.h>
@@ -125,6 +128,14 @@
 //#warning "Intel mode, 16MB CHUNK_SIZE"
 #endif
 
+// Bulk transfers queued at once by sxReadPixelsAsync, each a multiple of the 512 byte packet size
+#define ASYNC_TRANSFERS     4
+#ifdef __arm__
+#define ASYNC_TRANSFER_SIZE (256 * 1024)
+#else
+#define ASYNC_TRANSFER_SIZE (1024 * 1024)
+#endif
+
 #if 1
 #define TRACE(c) (c)
 #define DEBUG(c) (c)
@@ -755,6 +766,132 @@ int sxReadPixels(HANDLE sxHandle, void *pixels, unsigned long count)
     return rc >= 0;
 }
 
+struct AsyncRead
+{
+    std::mutex lock;
+    unsigned char *pixels;
+    unsigned long count;
+    unsigned long submitted;
+    std::vector<bool> done;
+    unsigned long received;
+    int active;
+    int status;
+};
+
+static void asyncReadCallback(struct libusb_transfer *transfer)
+{
+    // May run on any thread handling libusb events, e.g. a control request on the main thread.
+    AsyncRead *read = static_cast<AsyncRead *>(transfer->user_data);
+    std::lock_guard<std::mutex> guard(read->lock);
+
+    if (transfer->status != LIBUSB_TRANSFER_COMPLETED || transfer->actual_length != transfer->length)
+    {
+        if (read->status == LIBUSB_TRANSFER_COMPLETED)
+            read->status = transfer->status == LIBUSB_TRANSFER_COMPLETED ? LIBUSB_TRANSFER_ERROR : transfer->status;
+        read->active--;
+        return;
+    }
+
+    unsigned long offset = transfer->buffer - read->pixels;
+    read->done[offset / ASYNC_TRANSFER_SIZE] = true;
+    while (read->received < read->count && read->done[read->received / ASYNC_TRANSFER_SIZE])
+        read->received = std::min(read->count, read->received + ASYNC_TRANSFER_SIZE);
+
+    if (read->status == LIBUSB_TRANSFER_COMPLETED && read->submitted < read->count)
+    {
+        // Reuse the transfer for the next chunk so the queue never runs dry.
+        transfer->buffer = read->pixels + read->submitted;
+        transfer->length = std::min<unsigned long>(ASYNC_TRANSFER_SIZE, read->count - read->submitted);
+        int rc = libusb_submit_transfer(transfer);
+        if (rc == 0)
+        {
+            read->submitted += transfer->length;
+            return;
+        }
+        DEBUG(log(true, "sxReadPixelsAsync: libusb_submit_transfer -> %s\n", libusb_error_name(rc)));
+        read->status = LIBUSB_TRANSFER_ERROR;
+    }
+    read->active--;
+}
+
+int sxReadPixelsAsync(HANDLE sxHandle, void *pixels, unsigned long count, sxReadProgress progress, void *context)
+{
+    AsyncRead read;
+    read.pixels    = static_cast<unsigned char *>(pixels);
+    read.count     = count;
+    read.submitted = 0;
+    read.done.assign((count + ASYNC_TRANSFER_SIZE - 1) / ASYNC_TRANSFER_SIZE, false);
+    read.received  = 0;
+    read.active    = 0;
+    read.status    = LIBUSB_TRANSFER_COMPLETED;
+
+    libusb_transfer *transfers[ASYNC_TRANSFERS] = { nullptr };
+    {
+        std::lock_guard<std::mutex> guard(read.lock);
+        for (int i = 0; i < ASYNC_TRANSFERS && read.submitted < count; i++)
+        {
+            transfers[i] = libusb_alloc_transfer(0);
+            if (transfers[i] == nullptr)
+                break;
+            int size = std::min<unsigned long>(ASYNC_TRANSFER_SIZE, count - read.submitted);
+            libusb_fill_bulk_transfer(transfers[i], sxHandle, BULK_IN, read.pixels + read.submitted, size,
+                                      asyncReadCallback, &read, BULK_DATA_TIMEOUT);
+            int rc = libusb_submit_transfer(transfers[i]);
+            DEBUG(log(true, "sxReadPixelsAsync: libusb_submit_transfer -> %s\n", rc < 0 ? libusb_error_name(rc) : "OK"));
+            if (rc < 0)
+            {
+                read.status = LIBUSB_TRANSFER_ERROR;
+                break;
+            }
+            read.submitted += size;
+            read.active++;
+        }
+    }
+
+    unsigned long reported = 0;
+    bool cancelled = false;
+    for (;;)
+    {
+        unsigned long received;
+        bool failed;
+        {
+            std::lock_guard<std::mutex> guard(read.lock);
+            if (read.active == 0)
+                break;
+            received = read.received;
+            failed = read.status != LIBUSB_TRANSFER_COMPLETED;
+        }
+
+        if (!cancelled && failed)
+        {
+            // Cancelled transfers still complete through the callback, wait for all of them.
+            for (int i = 0; i < ASYNC_TRANSFERS; i++)
+                if (transfers[i])
+                    libusb_cancel_transfer(transfers[i]);
+            cancelled = true;
+        }
+
+        if (progress && received > reported)
+        {
+            progress(context, received);
+            reported = received;
+        }
+
+        struct timeval tv = { 0, 100000 };
+        libusb_handle_events_timeout_completed(ctx, &tv, nullptr);
+    }
+
+    for (int i = 0; i < ASYNC_TRANSFERS; i++)
+        if (transfers[i])
+            libusb_free_transfer(transfers[i]);
+
+    bool ok = read.status == LIBUSB_TRANSFER_COMPLETED && read.received == count;
+    DEBUG(log(true, "sxReadPixelsAsync: %lu of %lu bytes -> %s\n", read.received, count, ok ? "OK" : "FAILED"));
+    if (ok && progress && read.received > reported)
+        progress(context, read.received);
+    return ok;
+}
+
 int sxSetSTAR2000(HANDLE sxHandle, char star2k)
 {
     unsigned char setup_data[8];
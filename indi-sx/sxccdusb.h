@@ -155,6 +155,13 @@ int sxExposePixelsGated(HANDLE sxHandle, unsigned short flags, unsigned short ca
                         unsigned short yoffset, unsigned short width, unsigned short height, unsigned short xbin,
                         unsigned short ybin, unsigned long msec);
 int sxReadPixels(HANDLE sxHandle, void *pixels, unsigned long count);
+/*
+ * Same as sxReadPixels, but keeps several bulk transfers in flight. progress, if set, is called on the
+ * calling thread with the number of bytes received contiguously from the start of pixels.
+ */
+typedef void (*sxReadProgress)(void *context, unsigned long received);
+int sxReadPixelsAsync(HANDLE sxHandle, void *pixels, unsigned long count, sxReadProgress progress = nullptr,
+                      void *context = nullptr);
 int sxSetShutter(HANDLE sxHandle, unsigned short state);
 int sxSetTimer(HANDLE sxHandle, unsigned long msec);
 unsigned long sxGetTimer(HANDLE sxHandle);
@@ -0,0 +1,97 @@
+/*
+ Toupcam Driver Benchmark
+
+ Runs the indi_toupcam_ccd driver code against a synthetic camera, without any
+ hardware, and reports per-frame latency broken down by pipeline stage.
+
+ Usage:
+   ./toupcam_driver_bench [--width <px>] [--height <px>] [--bin <n>] [--color] [--bits <8|16>]
+                          [--frames <N>] [--exposure <s>] [--stream <s>] [--usb <MB/s>] [--json <path>]
+
+ Stages:
+   pull         Toupcam_PullImageWithRowPitchV2 of a triggered frame, including the simulated USB transfer
+   convert      end of pull to ExposureComplete (RGB deinterleave for color cameras)
+   encode_send  INDI::CCD::ExposureComplete, i.e. FITS encoding and BLOB send
+   video_pull   Toupcam_PullImageWithRowPitchV2 while streaming
+
+ Frames are delivered from the fake SDK's event thread, as with the real SDK
+ in pull mode. Stream frames are the frames pulled from the SDK; the driver
+ does not count drops.
+ The report is written as JSON, see common/camerabench.h.
+
+ Copyright (C) 2026 agent (agent@local)
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "indi_toupbase.h"
+#include "toupcam_fake_sdk.h"
+#include "camerabench_driver.h"
+
+class BenchToupcam : public ToupBase
+{
+    public:
+        BenchToupcam() : ToupBase(FakeToup::device(), "Fake") {}
+
+        CameraBench::Completion completion;
+
+    protected:
+        virtual bool ExposureComplete(INDI::CCDChip *targetChip) override
+        {
+            CameraBench::recorder().add("convert", CameraBench::nowMs() - FakeToup::lastPullEnd());
+
+            bool rc;
+            {
+                CameraBench::StageTimer timer("encode_send");
+                rc = ToupBase::ExposureComplete(targetChip);
+            }
+            completion.signal();
+            return rc;
+        }
+};
+
+int main(int argc, char *argv[])
+{
+    CameraBench::Options options;
+    if (!CameraBench::parseOptions(argc, argv, options))
+        return 1;
+
+    FILE *report = CameraBench::reportStream(options);
+    if (report == nullptr)
+        return 1;
+
+    FakeToup::configure(options);
+    BenchToupcam camera;
+
+    if (!CameraBench::connect(camera, options))
+        return 1;
+
+    CameraBench::Report result;
+    result.driver = "indi_toupcam_ccd";
+    result.camera = camera.getDeviceName();
+
+    CameraBench::recorder().clear();
+    if (!CameraBench::runExposures(camera, options, camera.completion, result.latency))
+        return 1;
+
+    CameraBench::runStream(camera, options, result.stream, [] { return FakeToup::videoFrames(); });
+
+    result.stages = CameraBench::recorder().snapshot();
+    camera.Disconnect();
+
+    CameraBench::writeReport(report, options, result);
+    fclose(report);
+    return 0;
+}
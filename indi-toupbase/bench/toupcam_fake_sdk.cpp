@@ -0,0 +1,572 @@
+/*
+    Synthetic Toupcam SDK for the Driver Benchmark
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "toupcam_fake_sdk.h"
+
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+
+constexpr HRESULT FAKE_S_OK       = 0;
+constexpr HRESULT FAKE_E_NOTIMPL  = static_cast<HRESULT>(0x80004001);
+constexpr HRESULT FAKE_E_INVALID  = static_cast<HRESULT>(0x80070057);
+constexpr HRESULT FAKE_E_UNEXPECT = static_cast<HRESULT>(0x8000ffff);
+constexpr HRESULT FAKE_E_PENDING  = static_cast<HRESULT>(0x8000000a);
+
+constexpr unsigned fourcc(char a, char b, char c, char d)
+{
+    return static_cast<unsigned>(static_cast<uint8_t>(a)) | (static_cast<unsigned>(static_cast<uint8_t>(b)) << 8)
+           | (static_cast<unsigned>(static_cast<uint8_t>(c)) << 16) | (static_cast<unsigned>(static_cast<uint8_t>(d)) << 24);
+}
+
+struct Camera
+{
+    CameraBench::Options options;
+    ToupcamModelV2 model {};
+    ToupcamDeviceV2 device {};
+
+    std::mutex mutex;
+    std::map<unsigned, int> values;
+    unsigned roiWidth {0}, roiHeight {0}, bin {1};
+    unsigned short gain {TOUPCAM_EXPOGAIN_MIN}, speed {0};
+    // A frame was announced and not pulled or flushed yet
+    bool pending {false};
+
+    PTOUPCAM_EVENT_CALLBACK callback {nullptr};
+    void *context {nullptr};
+    std::atomic<bool> running {false};
+    std::thread events;
+
+    CameraBench::FakeSensor sensor;
+} camera;
+
+Toupcam_t handle;
+
+bool triggered()
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    return camera.values[TOUPCAM_OPTION_TRIGGER] != 0;
+}
+
+// Plays the SDK's own thread: announce every finished exposure or video frame
+void runEvents()
+{
+    while (camera.running)
+    {
+        bool ready;
+        if (triggered())
+        {
+            ready = camera.sensor.waitExposure(20);
+            // The frame is now in the SDK's buffer, the sensor is free for the next trigger
+            if (ready)
+                camera.sensor.stopExposure();
+        }
+        else
+            ready = camera.sensor.waitVideoFrame(20);
+
+        if (!ready || !camera.running)
+            continue;
+
+        {
+            std::lock_guard<std::mutex> lock(camera.mutex);
+            camera.pending = true;
+        }
+        camera.callback(TOUPCAM_EVENT_IMAGE, camera.context);
+    }
+}
+
+void stopEvents()
+{
+    camera.running = false;
+    if (camera.events.joinable() && camera.events.get_id() != std::this_thread::get_id())
+        camera.events.join();
+
+    camera.sensor.stopVideo();
+    camera.sensor.stopExposure();
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    camera.pending = false;
+}
+
+}
+
+namespace FakeToup
+{
+
+void configure(const CameraBench::Options &options)
+{
+    camera.options = options;
+    camera.sensor.configure(options);
+
+    camera.model.name        = "Fake Toupcam";
+    camera.model.flag        = TOUPCAM_FLAG_TRIGGER_SOFTWARE | TOUPCAM_FLAG_BINSKIP_SUPPORTED | TOUPCAM_FLAG_ST4
+                               | (options.bitDepth > 8 ? TOUPCAM_FLAG_RAW16 : TOUPCAM_FLAG_RAW8)
+                               | (options.color ? 0 : TOUPCAM_FLAG_MONO);
+    camera.model.maxspeed    = 2;
+    camera.model.preview     = 1;
+    camera.model.still       = 0;
+    camera.model.maxfanspeed = 0;
+    camera.model.xpixsz      = 2.9f;
+    camera.model.ypixsz      = 2.9f;
+    camera.model.res[0].width  = options.width;
+    camera.model.res[0].height = options.height;
+
+    strncpy(camera.device.displayname, camera.model.name, sizeof(camera.device.displayname) - 1);
+    strncpy(camera.device.id, "tp-fake-bench-0001", sizeof(camera.device.id) - 1);
+    camera.device.model = &camera.model;
+
+    camera.values =
+    {
+        {TOUPCAM_OPTION_TRIGGER, 0}, {TOUPCAM_OPTION_BITDEPTH, 0}, {TOUPCAM_OPTION_RAW, 0}, {TOUPCAM_OPTION_BINNING, 1},
+        {TOUPCAM_OPTION_NOFRAME_TIMEOUT, 0}, {TOUPCAM_OPTION_ZERO_PADDING, 0}, {TOUPCAM_OPTION_FRAMERATE, 0},
+        {TOUPCAM_OPTION_BLACKLEVEL, 0}, {TOUPCAM_OPTION_CG, 0}
+    };
+    camera.roiWidth  = options.width;
+    camera.roiHeight = options.height;
+    camera.sensor.setExposureMs(10);
+}
+
+const ToupcamDeviceV2 *device()
+{
+    return &camera.device;
+}
+
+double lastPullEnd()
+{
+    return camera.sensor.lastPullEnd();
+}
+
+uint64_t videoFrames()
+{
+    return camera.sensor.videoFrames();
+}
+
+}
+
+TOUPCAM_API(const char *) Toupcam_Version()
+{
+    return "1.0.0-fake";
+}
+
+TOUPCAM_API(unsigned) Toupcam_EnumV2(ToupcamDeviceV2 arr[TOUPCAM_MAX])
+{
+    (void)arr;
+    return 0;
+}
+
+TOUPCAM_API(HToupcam) Toupcam_Open(const char *camId)
+{
+    // Color cameras are opened with a leading '@' for RGB white balance
+    if (camId != nullptr && camId[0] == '@')
+        camId++;
+    return (camId != nullptr && strcmp(camId, camera.device.id) == 0) ? &handle : nullptr;
+}
+
+TOUPCAM_API(void) Toupcam_Close(HToupcam)
+{
+    stopEvents();
+}
+
+TOUPCAM_API(HRESULT) Toupcam_StartPullModeWithCallback(HToupcam, PTOUPCAM_EVENT_CALLBACK funEvent, void *ctxEvent)
+{
+    stopEvents();
+
+    camera.callback = funEvent;
+    camera.context  = ctxEvent;
+    if (!triggered())
+        camera.sensor.startVideo();
+    camera.running = true;
+    camera.events  = std::thread(runEvents);
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_Stop(HToupcam)
+{
+    stopEvents();
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_Trigger(HToupcam, unsigned short nNumber)
+{
+    if (nNumber == 0)
+    {
+        camera.sensor.stopExposure();
+        return FAKE_S_OK;
+    }
+    if (!camera.running || !triggered())
+        return FAKE_E_UNEXPECT;
+    camera.sensor.startExposure();
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_PullImageWithRowPitchV2(HToupcam, void *pImageData, int bits, int, ToupcamFrameInfoV2 *pInfo)
+{
+    unsigned width, height;
+    {
+        std::lock_guard<std::mutex> lock(camera.mutex);
+        if (!camera.pending)
+            return FAKE_E_PENDING;
+        camera.pending = false;
+        width  = camera.roiWidth / camera.bin;
+        height = camera.roiHeight / camera.bin;
+    }
+
+    // 24 and 48 bits are RGB, anything above 8 bits is padded to 16
+    size_t bytesPerPixel = bits == 24 ? 3 : bits == 48 ? 6 : bits > 8 ? 2 : 1;
+    size_t bytes = static_cast<size_t>(width) * height * bytesPerPixel;
+    if (bytes != camera.sensor.frameBytes())
+        camera.sensor.setFrameBytes(bytes);
+
+    if (camera.sensor.pull(pImageData, bytes, camera.sensor.capturing() ? "video_pull" : "pull") == 0)
+        return FAKE_E_INVALID;
+
+    if (pInfo)
+    {
+        pInfo->width     = width;
+        pInfo->height    = height;
+        pInfo->flag      = 0;
+        pInfo->seq       = static_cast<unsigned>(camera.sensor.videoFrames());
+        pInfo->timestamp = static_cast<unsigned long long>(CameraBench::nowMs() * 1000);
+    }
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_Option(HToupcam, unsigned iOption, int *piValue)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    auto it = camera.values.find(iOption);
+    if (it == camera.values.end())
+        return FAKE_E_NOTIMPL;
+    *piValue = it->second;
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_put_Option(HToupcam, unsigned iOption, int iValue)
+{
+    if (iOption == TOUPCAM_OPTION_FLUSH)
+    {
+        std::lock_guard<std::mutex> lock(camera.mutex);
+        camera.pending = false;
+        return FAKE_S_OK;
+    }
+
+    std::unique_lock<std::mutex> lock(camera.mutex);
+    auto it = camera.values.find(iOption);
+    if (it == camera.values.end())
+        return FAKE_E_NOTIMPL;
+
+    if (iOption == TOUPCAM_OPTION_BINNING)
+    {
+        unsigned bin = iValue & 0x7F;
+        if (bin != 1 && bin != 2 && bin != 4)
+            return FAKE_E_INVALID;
+        camera.bin = bin;
+    }
+
+    bool wasTriggered = camera.values[TOUPCAM_OPTION_TRIGGER] != 0;
+    it->second = iValue;
+    lock.unlock();
+
+    // Switching trigger mode while running starts or stops the video stream
+    if (iOption == TOUPCAM_OPTION_TRIGGER && camera.running && wasTriggered != (iValue != 0))
+    {
+        if (iValue == 0)
+            camera.sensor.startVideo();
+        else
+            camera.sensor.stopVideo();
+    }
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_put_ExpoTime(HToupcam, unsigned Time)
+{
+    camera.sensor.setExposureMs(Time / 1000.0);
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_ExpTimeRange(HToupcam, unsigned *nMin, unsigned *nMax, unsigned *nDef)
+{
+    *nMin = 10;
+    *nMax = 3600000000u;
+    *nDef = 10000;
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_put_Roi(HToupcam, unsigned xOffset, unsigned yOffset, unsigned xWidth, unsigned yHeight)
+{
+    // All zero restores the full frame
+    if (xWidth == 0 && yHeight == 0)
+    {
+        xWidth  = camera.options.width;
+        yHeight = camera.options.height;
+    }
+    if (xOffset + xWidth > static_cast<unsigned>(camera.options.width)
+            || yOffset + yHeight > static_cast<unsigned>(camera.options.height))
+        return FAKE_E_INVALID;
+
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    camera.roiWidth  = xWidth;
+    camera.roiHeight = yHeight;
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_eSize(HToupcam, unsigned *pnResolutionIndex)
+{
+    *pnResolutionIndex = 0;
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_put_eSize(HToupcam, unsigned nResolutionIndex)
+{
+    return nResolutionIndex == 0 ? FAKE_S_OK : FAKE_E_INVALID;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_RawFormat(HToupcam, unsigned *pFourCC, unsigned *pBitsPerPixel)
+{
+    if (pFourCC)
+        *pFourCC = camera.options.color ? fourcc('R', 'G', 'G', 'B') : fourcc('G', 'R', 'E', 'Y');
+    if (pBitsPerPixel)
+    {
+        std::lock_guard<std::mutex> lock(camera.mutex);
+        *pBitsPerPixel = camera.values[TOUPCAM_OPTION_BITDEPTH] ? camera.options.bitDepth : 8;
+    }
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_MaxBitDepth(HToupcam)
+{
+    return camera.options.bitDepth;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_ExpoAGain(HToupcam, unsigned short *Gain)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    *Gain = camera.gain;
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_put_ExpoAGain(HToupcam, unsigned short Gain)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    camera.gain = Gain;
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_ExpoAGainRange(HToupcam, unsigned short *nMin, unsigned short *nMax,
+        unsigned short *nDef)
+{
+    if (nMin)
+        *nMin = TOUPCAM_EXPOGAIN_MIN;
+    *nMax = 5000;
+    *nDef = TOUPCAM_EXPOGAIN_MIN;
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_Speed(HToupcam, unsigned short *pSpeed)
+{
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    *pSpeed = camera.speed;
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_put_Speed(HToupcam, unsigned short nSpeed)
+{
+    if (nSpeed > camera.model.maxspeed)
+        return FAKE_E_INVALID;
+    std::lock_guard<std::mutex> lock(camera.mutex);
+    camera.speed = nSpeed;
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_Contrast(HToupcam, int *Contrast)
+{
+    *Contrast = 0;
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_put_Contrast(HToupcam, int)
+{
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_Hue(HToupcam, int *Hue)
+{
+    *Hue = 0;
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_put_Hue(HToupcam, int)
+{
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_Saturation(HToupcam, int *Saturation)
+{
+    *Saturation = 128;
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_put_Saturation(HToupcam, int)
+{
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_Brightness(HToupcam, int *Brightness)
+{
+    *Brightness = 0;
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_put_Brightness(HToupcam, int)
+{
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_Gamma(HToupcam, int *Gamma)
+{
+    *Gamma = 100;
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_put_Gamma(HToupcam, int)
+{
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_WhiteBalanceGain(HToupcam, int aGain[3])
+{
+    aGain[0] = aGain[1] = aGain[2] = 0;
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_put_WhiteBalanceGain(HToupcam, int [3])
+{
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_BlackBalance(HToupcam, unsigned short aSub[3])
+{
+    aSub[0] = aSub[1] = aSub[2] = 0;
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_put_BlackBalance(HToupcam, unsigned short [3])
+{
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_LevelRange(HToupcam, unsigned short aLow[4], unsigned short aHigh[4])
+{
+    for (int i = 0; i < 4; i++)
+    {
+        aLow[i]  = 0;
+        aHigh[i] = 255;
+    }
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_put_LevelRange(HToupcam, unsigned short [4], unsigned short [4])
+{
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_AwbInit(HToupcam, PITOUPCAM_WHITEBALANCE_CALLBACK, void *)
+{
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_AbbOnce(HToupcam, PITOUPCAM_BLACKBALANCE_CALLBACK, void *)
+{
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_put_AutoExpoEnable(HToupcam, int)
+{
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_put_HZ(HToupcam, int)
+{
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_put_Mode(HToupcam, int)
+{
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_put_RealTime(HToupcam, int)
+{
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_Temperature(HToupcam, short *)
+{
+    return FAKE_E_NOTIMPL;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_put_Temperature(HToupcam, short)
+{
+    return FAKE_E_NOTIMPL;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_ST4PlusGuide(HToupcam, unsigned, unsigned)
+{
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_SerialNumber(HToupcam, char sn[32])
+{
+    strncpy(sn, "TPFAKEBENCH0001", 32);
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_ProductionDate(HToupcam, char pdate[10])
+{
+    strncpy(pdate, "20260101", 10);
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_FwVersion(HToupcam, char fwver[16])
+{
+    strncpy(fwver, "1.0.0", 16);
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_HwVersion(HToupcam, char hwver[16])
+{
+    strncpy(hwver, "1.0", 16);
+    return FAKE_S_OK;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_FpgaVersion(HToupcam, char [16])
+{
+    return FAKE_E_NOTIMPL;
+}
+
+TOUPCAM_API(HRESULT) Toupcam_get_Revision(HToupcam, unsigned short *pRevision)
+{
+    *pRevision = 1;
+    return FAKE_S_OK;
+}
@@ -0,0 +1,48 @@
+/*
+    Synthetic Toupcam SDK for the Driver Benchmark
+
+    Copyright (C) 2026 agent (agent@local)
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <toupcam.h>
+
+#include "camerabench.h"
+
+// Synthetic stand-in for libtoupcam used by the offline driver benchmark.
+// It implements the subset of the SDK used by ToupBase on top of
+// CameraBench::FakeSensor. Like the real SDK in pull mode, frames are
+// announced with TOUPCAM_EVENT_IMAGE from an SDK thread and pulled by the
+// driver from within the callback. Toupcam_EnumV2 reports no cameras so the
+// driver's hot-plug handler stays idle.
+namespace FakeToup
+{
+
+/** Describe the simulated camera. Must be called before the driver is created. */
+void configure(const CameraBench::Options &options);
+
+/** The simulated camera as Toupcam_EnumV2 would report it. */
+const ToupcamDeviceV2 *device();
+
+/** Time at which the last Toupcam_PullImageWithRowPitchV2 returned, in CameraBench::nowMs() units. */
+double lastPullEnd();
+
+/** Video frames pulled since the camera last switched to video trigger mode. */
+uint64_t videoFrames();
+
+}
@@ -29,6 +29,7 @@
 
 #include <hotplugmanager.h>
 #include "toupbase_ccd_hotplug_handler.h"
+#include "pixelconvert.h"
 
 #define BITDEPTH_FLAG       (CP(FLAG_RAW10) | CP(FLAG_RAW12) | CP(FLAG_RAW14) | CP(FLAG_RAW16))
 #define CONTROL_TAB         "Control"
@@ -2228,22 +2229,11 @@ void ToupBase::eventCallBack(unsigned event)
                 {
                     if (m_MonoCamera == false && (0 == m_CurrentVideoFormat))
                     {
-                        uint8_t *image  = PrimaryCCD.getFrameBuffer();
                         uint32_t width  = PrimaryCCD.getSubW() / PrimaryCCD.getBinX() * (PrimaryCCD.getBPP() / 8);
                         uint32_t height = PrimaryCCD.getSubH() / PrimaryCCD.getBinY() * (PrimaryCCD.getBPP() / 8);
 
-                        uint8_t *subR = image;
-                        uint8_t *subG = image + width * height;
-                        uint8_t *subB = image + width * height * 2;
-                        int size      = width * height * 3 - 3;
-
                         // RGB to three sepearate R-frame, G-frame, and B-frame for color FITS
-                        for (int i = 0; i <= size; i += 3)
-                        {
-                            *subR++ = buffer[i];
-                            *subG++ = buffer[i + 1];
-                            *subB++ = buffer[i + 2];
-                        }
+                        PixelConvert::deinterleave8(buffer, PrimaryCCD.getFrameBuffer(), width * height, 3, PixelConvert::ORDER_RGB);
                     }
 
                     LOGF_DEBUG("Image received. Width: %d, Height: %d, flag: %d, timestamp: %ld", info.width, info.height, info.flag,
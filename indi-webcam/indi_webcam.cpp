@@ -29,6 +29,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include <eventloop.h>
 
 #include "indi_webcam.h"
+#include "pixelconvert.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -203,7 +204,6 @@ indi_webcam::indi_webcam()
     frameRate = 30;
     videoSize = "640x480";
     webcamStacking = false;
-    averaging = false;
     outputFormat = "8 bit RGB";
 
     protocol = "HTTP";
@@ -337,6 +337,10 @@ bool indi_webcam::ConnectToSource(std::string device, std::string source, int fr
         return false;
     }
 
+    //Let FFMpeg pick the number of decoding threads, this matters for H.264 and MJPEG at high resolutions.
+    pCodecCtx->thread_count = 0;
+    pCodecCtx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
     //Attempt to open the codec.  If that fails, abort the connection.
     if(avcodec_open2(pCodecCtx, pCodec, &optionsDict) < 0)
     {
@@ -362,6 +366,7 @@ bool indi_webcam::reconnectSource()
     {
         if(ConnectToSource(videoDevice, videoSource, frameRate, videoSize, inputPixelFormat, url))
             return true;
+        attempt++;
     }
     //All 10 attempts resulted in failure.
     return false;
@@ -545,15 +550,31 @@ bool indi_webcam::initProperties()
     CaptureFormat rgb = {"INDI_RGB", "RGB", 8, true};
     addCaptureFormat(rgb);
 
-    RapidStacking = new ISwitch[3];
+    RapidStacking = new ISwitch[5];
     IUFillSwitch(&RapidStacking[0], "Integration", "Integration", ISS_OFF);
     IUFillSwitch(&RapidStacking[1], "Average", "Average", ISS_OFF);
-    IUFillSwitch(&RapidStacking[2], "Off", "Off", ISS_ON);
+    IUFillSwitch(&RapidStacking[2], "Median", "Median", ISS_OFF);
+    IUFillSwitch(&RapidStacking[3], "Sigma Clip", "Sigma Clip", ISS_OFF);
+    IUFillSwitch(&RapidStacking[4], "Off", "Off", ISS_ON);
 
-    IUFillSwitchVector(&RapidStackingSelection, RapidStacking, 3, getDeviceName(), "RAPID_STACKING_OPTION", "Rapid Stacking",
+    IUFillSwitchVector(&RapidStackingSelection, RapidStacking, 5, getDeviceName(), "RAPID_STACKING_OPTION", "Rapid Stacking",
                        MAIN_CONTROL_TAB, IP_RW, ISR_1OFMANY, 60, IPS_IDLE);
     defineProperty(&RapidStackingSelection);
 
+    //Median and Sigma Clip reduce this many frames at a time
+    IUFillNumber(&StackSettingsT[0], "WINDOW", "Window (frames)", "%.0f", WebcamStacker::MIN_WINDOW,
+                 WebcamStacker::MAX_WINDOW, 1, 5);
+    IUFillNumber(&StackSettingsT[1], "SIGMA", "Sigma", "%.1f", 1, 5, 0.1, 2.5);
+    IUFillNumberVector(&StackSettingsTP, StackSettingsT, NARRAY(StackSettingsT), getDeviceName(), "STACK_SETTINGS",
+                       "Stack Settings", MAIN_CONTROL_TAB, IP_RW, 0, IPS_IDLE);
+    defineProperty(&StackSettingsTP);
+
+    IUFillNumber(&StackStatsT[0], "FPS", "Stack FPS", "%.1f", 0, 1000, 0, 0);
+    IUFillNumber(&StackStatsT[1], "FRAMES", "Frames", "%.0f", 0, 1e9, 0, 0);
+    IUFillNumberVector(&StackStatsTP, StackStatsT, NARRAY(StackStatsT), getDeviceName(), "STACK_STATS",
+                       "Stack Rate", MAIN_CONTROL_TAB, IP_RO, 0, IPS_IDLE);
+    defineProperty(&StackStatsTP);
+
     OutputFormats = new ISwitch[3];
     IUFillSwitch(&OutputFormats[0], "16 bit Grayscale", "16 bit Grayscale", ISS_OFF);
     IUFillSwitch(&OutputFormats[1], "16 bit RGB", "16 bit RGB", ISS_OFF);
@@ -692,6 +713,7 @@ bool indi_webcam::initProperties()
     SetCCDCapability(cap);
 
     loadConfig(true, RapidStackingSelection.name);
+    loadConfig(true, StackSettingsTP.name);
     loadConfig(true, OutputFormatSelection.name);
     loadConfig(true, PixelSizeTP.name);
     loadConfig(true, InputOptionsTP.name);
@@ -933,6 +955,16 @@ bool indi_webcam::ISNewNumber (const char *dev, const char *name, double values[
         return true;
     }
 
+    if (!strcmp(name, StackSettingsTP.name) )
+    {
+        IUUpdateNumber(&StackSettingsTP, values, names, n);
+        stacker.setWindow(IUFindNumber( &StackSettingsTP, "WINDOW" )->value);
+        stacker.setSigma(IUFindNumber( &StackSettingsTP, "SIGMA" )->value);
+        StackSettingsTP.s = IPS_OK;
+        IDSetNumber (&StackSettingsTP, nullptr);
+        return true;
+    }
+
     return INDI::CCD::ISNewNumber(dev, name, values, names, n);
 }
 
@@ -1064,21 +1096,17 @@ bool indi_webcam::ISNewSwitch (const char *dev, const char *name, ISState *state
         ISwitch *sp = IUFindOnSwitch(&RapidStackingSelection);
         if (sp)
         {
+            webcamStacking = true;
             if(!strcmp(sp->name, "Integration"))
-            {
-                webcamStacking = true;
-                averaging = false;
-            }
-            if(!strcmp(sp->name, "Average"))
-            {
-                webcamStacking = true;
-                averaging = true;
-            }
-            if(!strcmp(sp->name, "Off"))
-            {
+                stacker.setMode(WebcamStacker::MODE_INTEGRATE);
+            else if(!strcmp(sp->name, "Average"))
+                stacker.setMode(WebcamStacker::MODE_AVERAGE);
+            else if(!strcmp(sp->name, "Median"))
+                stacker.setMode(WebcamStacker::MODE_MEDIAN);
+            else if(!strcmp(sp->name, "Sigma Clip"))
+                stacker.setMode(WebcamStacker::MODE_SIGMA_CLIP);
+            else
                 webcamStacking = false;
-                averaging = false;
-            }
             RapidStackingSelection.s = IPS_OK;
             IDSetSwitch(&RapidStackingSelection, nullptr);
             return true;
@@ -1258,14 +1286,6 @@ bool indi_webcam::StartExposure(float duration)
         return false;
     }
 
-    //This resets the stack buffer
-    if(webcamStacking)
-    {
-        if(stackBuffer)
-            free(stackBuffer);
-        stackBuffer = nullptr;
-    }
-
     //This sets up the output format for the exposure
     if(outputFormat == "16 bit RGB")
     {
@@ -1298,6 +1318,11 @@ bool indi_webcam::StartExposure(float duration)
         return false;
     }
 
+    //This resets the stack for the new exposure
+    stackStarted = false;
+    if(webcamStacking && !startStack())
+        return false;
+
     //This will ensure that we get the current frame, not some old frame still in the buffer
     if(!flush_frame_buffer())
         DEBUG(INDI::Logger::DBG_SESSION, "FFMPEG Issue in flushing buffer");
@@ -1324,11 +1349,6 @@ bool indi_webcam::StartExposure(float duration)
 
 bool indi_webcam::AbortExposure()
 {
-    if(stackBuffer)
-    {
-        free(stackBuffer);
-        stackBuffer = nullptr;
-    }
     InExposure = false;
     return true;
 }
@@ -1376,7 +1396,7 @@ void indi_webcam::TimerHit()
         // or the time left is less than the polling period, so get it now.
         if (timeleft < (1 / frameRate) || timeleft < getCurrentPollingPeriod() / 1000.0)
         {
-            if(webcamStacking)
+            if(webcamStacking && stackStarted)
                 copyFinalStackToPrimaryFrameBuffer();
             PrimaryCCD.setExposureLeft(0);
             InExposure = false;
@@ -1415,98 +1435,42 @@ bool indi_webcam::grabImage()
     return true;
 }
 
-//This adds each image to the running stack
-bool indi_webcam::addToStack()
+//This sets up the stack for the frame size and bit depth of the new exposure.
+//Colour frames are stacked as planar FITS data, so each plane adds height rows.
+bool indi_webcam::startStack()
 {
-    if(!stackBuffer)
+    int planes = (PrimaryCCD.getNAxis() == 3) ? 3 : 1;
+    if(!stacker.begin(pCodecCtx->width, pCodecCtx->height * planes, PrimaryCCD.getBPP()))
     {
-        stackBuffer = (float *)malloc(numBytes * sizeof(float_t));
-        numberOfFramesInStack = 0;
-    }
-
-    int w = pCodecCtx->width  * ((PrimaryCCD.getNAxis() == 3) ? 3 : 1);
-    int h = pCodecCtx->height;
-
-    for (int i = 0; i < w * h; i++)
-    {
-        int x = i % w;
-        int y = i / w;
-        if(x >= 0 && y >= 0 && x < w && y < h)
-        {
-            if(numberOfFramesInStack == 0)
-                stackBuffer[i] = getImageDataFloatValue(x, y);
-            else
-                stackBuffer[i] += getImageDataFloatValue(x, y);
-        }
+        LOGF_ERROR("Cannot stack %dx%d frames at %d bits.", pCodecCtx->width, pCodecCtx->height, PrimaryCCD.getBPP());
+        return false;
     }
-    numberOfFramesInStack++;
+    stackStarted = true;
     return true;
 }
 
-//This gets the pixel value at an x, y position in the image
-float indi_webcam::getImageDataFloatValue(int x, int y)
-{
-    int w = pCodecCtx->width  * ((PrimaryCCD.getNAxis() == 3) ? 3 : 1);
-    uint8_t *primaryBuffer = PrimaryCCD.getFrameBuffer();
-    if(PrimaryCCD.getBPP() == 8)
-        return (float) primaryBuffer[y * w + x];
-    else if(PrimaryCCD.getBPP() == 16)
-    {
-        uint16_t *newBuffer = reinterpret_cast<uint16_t *>(primaryBuffer);
-        return (float) newBuffer[y * w + x];
-    }
-    else
-        return 0;
-}
-//This sets the pixel value at an x, y position in the image
-void indi_webcam::setImageDataValueFromFloat(int x, int y, float value, bool roundAnswer)
+//This adds each image to the running stack
+//If stacking was switched on during the exposure, the stack starts here, with the geometry of this frame.
+bool indi_webcam::addToStack()
 {
-    uint8_t *primaryBuffer = PrimaryCCD.getFrameBuffer();
-    int w = pCodecCtx->width * ((PrimaryCCD.getNAxis() == 3) ? 3 : 1);
-    if(!stackBuffer)
-        return;
-    if(PrimaryCCD.getBPP() == 8)
-    {
-        int max = std::numeric_limits<uint8_t>::max();
-        if (value > max)
-            value = max;
-        if(roundAnswer)
-            primaryBuffer[y * w + x] = round(value);
-        else
-            primaryBuffer[y * w + x] = value;
-    }
-    else if(PrimaryCCD.getBPP() == 16)
-    {
-        int max = std::numeric_limits<uint16_t>::max();
-        if (value > max)
-            value = max;
-        uint16_t *newBuffer = reinterpret_cast<uint16_t *>(primaryBuffer);
-        if(roundAnswer)
-            newBuffer[y * w + x] = round(value);
-        else
-            newBuffer[y * w + x] = value;
-    }
+    if(!stackStarted && !startStack())
+        return false;
+    return stacker.add(PrimaryCCD.getFrameBuffer());
 }
 
 //This will take the final image stack and copy it back to the primary buffer for final download.
 void indi_webcam::copyFinalStackToPrimaryFrameBuffer()
 {
-    int w = pCodecCtx->width  * ((PrimaryCCD.getNAxis() == 3) ? 3 : 1);
-    int h = pCodecCtx->height;
-    for (int i = 0; i < w * h; i++)
-    {
-        int x = i % w;
-        int y = i / w;
-        if(x >= 0 && y >= 0 && x < w && y < h)
-        {
-            if(averaging)
-                setImageDataValueFromFloat(x, y, round(stackBuffer[i] / numberOfFramesInStack), true);
-            else //Integrating
-                setImageDataValueFromFloat(x, y, round(stackBuffer[i]), true);
-        }
-    }
+    stacker.finish(PrimaryCCD.getFrameBuffer());
 
-    LOGF_INFO("Final Image is a stack of %u exposures.", numberOfFramesInStack);
+    StackStatsT[0].value = stacker.fps();
+    StackStatsT[1].value = stacker.frames();
+    StackStatsTP.s = IPS_OK;
+    IDSetNumber(&StackStatsTP, nullptr);
+
+    if(stacker.saturated())
+        LOGF_WARN("Stack is full after %u exposures, later frames were not added.", stacker.frames());
+    LOGF_INFO("Final Image is a stack of %u exposures at %.1f fps.", stacker.frames(), stacker.fps());
 }
 
 //This will crop the image to a subframe if desired.
@@ -1603,15 +1567,18 @@ void indi_webcam::debugTriggered(bool enabled)
 void indi_webcam::start_capturing()
 {
     if (is_capturing) return;
+    //The previous capture thread may have stopped by itself after a source error.
+    if (capture_thread.joinable())
+        capture_thread.join();
     is_capturing = true;
     capture_thread = std::thread(RunCaptureThread, this);
 }
 
 void indi_webcam::stop_capturing()
 {
-    if (!is_capturing) return;
     is_capturing = false;
-    if (std::this_thread::get_id() != capture_thread.get_id())
+    //The capture thread may also have stopped by itself, it still needs joining then.
+    if (capture_thread.joinable() && std::this_thread::get_id() != capture_thread.get_id())
         capture_thread.join();
 }
 
@@ -1636,109 +1603,171 @@ void indi_webcam::RunCaptureThread(indi_webcam *webcam)
     webcam->run_capture();
 }
 
-//This is the loop that runs during streaming
-//Note that it ONLY supports RGB24 aka INDI_RGB format.
+//This is the capture stage that runs during streaming, it demuxes and decodes frames.
+//Colour conversion and publishing run on their own threads so each stage can work on a different frame.
 void indi_webcam::run_capture()
 {
 
-    //This sets up the output format for the exposures
+    //This sets up the output format for the stream, 16 bit formats keep their full depth.
     if(outputFormat == "16 bit RGB")
     {
-        LOG_INFO("Note, RGB 16 bit not supported in video stream using 8 Bit RGB instead.");
-        out_pix_fmt = AV_PIX_FMT_RGB24;
-        PrimaryCCD.setBPP(8);
+        out_pix_fmt = AV_PIX_FMT_RGB48LE;
+        PrimaryCCD.setBPP(16);
         PrimaryCCD.setNAxis(3);
-        Streamer->setPixelFormat(INDI_RGB);
+        Streamer->setPixelFormat(INDI_RGB, 16);
     }
     else if(outputFormat == "8 bit RGB")
     {
         out_pix_fmt = AV_PIX_FMT_RGB24;
         PrimaryCCD.setBPP(8);
         PrimaryCCD.setNAxis(3);
-        Streamer->setPixelFormat(INDI_RGB);
+        Streamer->setPixelFormat(INDI_RGB, 8);
     }
     else if(outputFormat == "16 bit Grayscale")
     {
-        LOG_INFO("Note, 16 bit Grayscale not supported in video stream using 8 Bit Grayscale instead.");
-        out_pix_fmt = AV_PIX_FMT_GRAY8;
-        PrimaryCCD.setBPP(8);
+        out_pix_fmt = AV_PIX_FMT_GRAY16LE;
+        PrimaryCCD.setBPP(16);
         PrimaryCCD.setNAxis(2);
-        Streamer->setPixelFormat(INDI_MONO);
+        Streamer->setPixelFormat(INDI_MONO, 16);
     }
     else
         return;
 
-    if(!setupStreaming())
-        return;
+    //This sizes the stream for the source's current geometry.
+    auto setupStream = [this]()
+    {
+        if(!setupStreaming())
+            return false;
+        int w = pCodecCtx->width;
+        int h = pCodecCtx->height;
+        Streamer->setSize(w, h);
+        PrimaryCCD.setFrame(0, 0, w, h);
+        return true;
+    };
 
-    int w = pCodecCtx->width;
-    int h = pCodecCtx->height;
-    Streamer->setSize(w, h);
-    PrimaryCCD.setFrame(0, 0, w, h);
+    if(!setupStream())
+        return;
 
     //This will clear the frame button before streaming is started so that the frames are all current.
     if(!flush_frame_buffer())
         DEBUG(INDI::Logger::DBG_SESSION, "FFMPEG Issue in flushing buffer");
 
-    /*
-    int ret = avformat_flush(pFormatCtx);
-    if(ret != 0 )
+    //Each stage hands its frames to the next one through a small pool.
+    std::vector<AVFrame *> frames;
+    for (int i = 0; i < STREAM_POOL_SIZE; i++)
+        frames.push_back(av_frame_alloc());
+
+    std::thread conversion_thread;
+    std::thread publisher_thread;
+    auto startStages = [&]()
     {
-        char errbuff[200];
-        av_make_error_string(errbuff, 200, ret);
-        DEBUGF(INDI::Logger::DBG_SESSION, "FFMPEG Issue in flushing buffer: %d, %s.", ret, errbuff);
-    }
-    */
+        decodedFrames.reset(frames);
+        if(!convertedFrames.reset(STREAM_POOL_SIZE, numBytes))
+            DEBUG(INDI::Logger::DBG_WARNING, "Not all stream buffers could be allocated.");
+        conversion_thread = std::thread(&indi_webcam::run_conversion, this);
+        publisher_thread = std::thread(&indi_webcam::run_publisher, this);
+    };
+    auto stopStages = [&]()
+    {
+        decodedFrames.abort();
+        conversion_thread.join();
+        convertedFrames.abort();
+        publisher_thread.join();
+    };
+
+    startStages();
 
     while (is_capturing && is_streaming)
     {
+        AVFrame *frame = nullptr;
+        bool acquired = decodedFrames.acquire(frame);
+        bool reconnected = false;
+        if(acquired && decodeNextFrame(frame, reconnected))
+        {
+            if(!reconnected)
+            {
+                decodedFrames.publish(frame);
+                continue;
+            }
 
-        if(getStreamFrame())
-            Streamer->newFrame(pFrameOUT->data[0], numBytes);
+            //A reconnected source may come back with another pixel format or size,
+            //so the stages are stopped and the stream is set up again before the next frame.
+            av_frame_unref(frame);
+            stopStages();
+            if(!setupStream())
+            {
+                is_capturing = false;
+                is_streaming = false;
+                break;
+            }
+            startStages();
+        }
         else
         {
+            if(acquired)
+                decodedFrames.recycle(frame);
             is_capturing = false;
             is_streaming = false;
         }
     }
 
+    if(conversion_thread.joinable())
+        stopStages();
+
+    DEBUGF(INDI::Logger::DBG_DEBUG, "Stream dropped %llu decoded and %llu converted frames.",
+           static_cast<unsigned long long>(decodedFrames.dropped()), static_cast<unsigned long long>(convertedFrames.dropped()));
+
+    for (auto &frame : frames)
+        av_frame_free(&frame);
+    convertedFrames.clear();
     freeMemory();
 
     DEBUG(INDI::Logger::DBG_SESSION, "Capture thread releasing device.");
 }
 
+//This is the conversion stage of streaming, it converts decoded frames to the output format.
+void indi_webcam::run_conversion()
+{
+    AVFrame *frame = nullptr;
+    while (decodedFrames.next(frame))
+    {
+        FramePool::Frame *out = convertedFrames.acquire();
+        bool converted = out && convertFrame(frame, out->data());
+        av_frame_unref(frame);
+        decodedFrames.recycle(frame);
+
+        if(converted)
+            convertedFrames.publish(out);
+        else
+        {
+            if(out)
+                convertedFrames.recycle(out);
+            is_capturing = false;
+        }
+    }
+}
+
+//This is the last stage of streaming, it hands converted frames to the streamer.
+void indi_webcam::run_publisher()
+{
+    while (FramePool::Frame *out = convertedFrames.next())
+    {
+        Streamer->newFrame(out->data(), numBytes);
+        convertedFrames.recycle(out);
+    }
+}
+
 //This converts an image from INDI_RGB to FITS_RGB so the FITSViewer can read it.
 bool indi_webcam::convertINDI_RGBtoFITS_RGB(uint8_t *originalImage, uint8_t *convertedImage)
 {
     if(PrimaryCCD.getBPP() == 8)
     {
-        int size =  numBytes / 3;
-        uint8_t *r, *g, *b;
-        r = (convertedImage);
-        g = (convertedImage + size);
-        b = (convertedImage + size * 2);
-        for(int i = 0; i < numBytes; i += 3)
-        {
-            *r++ = *originalImage++;
-            *g++ = *originalImage++;
-            *b++ = *originalImage++;
-        }
+        PixelConvert::deinterleave8(originalImage, convertedImage, numBytes / 3, 3, PixelConvert::ORDER_RGB);
     }
     else if(PrimaryCCD.getBPP() == 16)
     {
-        uint16_t *bigOriginalImage = reinterpret_cast<uint16_t *>(originalImage);
-        uint16_t *bigConvertedImage = reinterpret_cast<uint16_t *>(convertedImage);
-        int size =  numBytes / 2 / 3;
-        uint16_t *r, *g, *b;
-        r = (bigConvertedImage);
-        g = (bigConvertedImage + size);
-        b = (bigConvertedImage + size * 2);
-        for(int i = 0; i < numBytes / 2; i += 3)
-        {
-            *r++ = *bigOriginalImage++;
-            *g++ = *bigOriginalImage++;
-            *b++ = *bigOriginalImage++;
-        }
+        PixelConvert::deinterleave16(reinterpret_cast<uint16_t *>(originalImage), reinterpret_cast<uint16_t *>(convertedImage),
+                                     numBytes / 2 / 3, 3, PixelConvert::ORDER_RGB);
     }
     return true;
 }
@@ -1748,48 +1777,49 @@ bool indi_webcam::convertINDI_RGBtoFITS_RGB(uint8_t *originalImage, uint8_t *con
 bool indi_webcam::setupStreaming()
 {
     // Determine required buffer size and allocate buffer for pframeRGB
-    numBytes = av_image_get_buffer_size(out_pix_fmt, pCodecCtx->width, pCodecCtx->height, 1);
+    outWidth = pCodecCtx->width;
+    outHeight = pCodecCtx->height;
+    numBytes = av_image_get_buffer_size(out_pix_fmt, outWidth, outHeight, 1);
 
-    // Allocate video frame
-    if(pFrame)
-        av_frame_free(&pFrame);
-    pFrame = av_frame_alloc();
+    // Allocate video frame, it is kept when the stream is set up again after a reconnect
+    if(pFrame == nullptr)
+        pFrame = av_frame_alloc();
     if(pFrame == nullptr)
         return false;
 
     // Allocate an AVFrame structure
-    if(pFrameOUT)
-        av_frame_free(&pFrameOUT);
-    pFrameOUT = av_frame_alloc();
+    if(pFrameOUT == nullptr)
+        pFrameOUT = av_frame_alloc();
     if(pFrameOUT == nullptr)
         return false;
 
     // Assign appropriate parts of buffer to image planes in pFrameRGB
-    if(!buffer)
-        buffer = (uint8_t *)malloc(numBytes * sizeof(uint8_t));
+    if(buffer)
+        av_free(buffer);
+    buffer = (uint8_t *)av_malloc(numBytes * sizeof(uint8_t));
     if(buffer == nullptr)
         return false;
 
-    av_image_fill_arrays (pFrameOUT->data, pFrameOUT->linesize, buffer, out_pix_fmt,
-                          pCodecCtx->width, pCodecCtx->height, 1);
-
-    // initialize SWS context for software scaling
-    sws_ctx = sws_getContext( pCodecCtx->width, pCodecCtx->height,
-                              pCodecCtx->pix_fmt, pCodecCtx->width, pCodecCtx->height,
-                              out_pix_fmt, SWS_BILINEAR, nullptr, nullptr, nullptr
-                            );
-    if(sws_ctx == nullptr)
-        return false;
+    av_image_fill_arrays (pFrameOUT->data, pFrameOUT->linesize, buffer, out_pix_fmt, outWidth, outHeight, 1);
 
-    updateVideoAdjustments();
+    // The SWS context for software scaling is created by convertFrame for the pixel format of the decoded frames
+    if(sws_ctx)
+        sws_freeContext(sws_ctx);
+    sws_ctx = nullptr;
 
     PrimaryCCD.setFrameBufferSize(numBytes);
-    PrimaryCCD.setResolution(pCodecCtx->width, pCodecCtx->height);
+    PrimaryCCD.setResolution(outWidth, outHeight);
 
     return true;
 }
 
+//The video adjustments are applied by the thread doing the colour conversion before its next frame.
 void indi_webcam::updateVideoAdjustments()
+{
+    videoAdjustmentsChanged = true;
+}
+
+void indi_webcam::applyVideoAdjustments()
 {
     if(sws_ctx == nullptr)
         return;
@@ -1801,15 +1831,27 @@ void indi_webcam::updateVideoAdjustments()
                              (int)(brightness * 65536), (int)(contrast * 65536), (int)(saturation * 65536));
 }
 
-//This gets one image from the camera.
-//It is used for both the streaming and exposing algorithms
-bool indi_webcam::getStreamFrame()
+//This decodes the next frame of the video stream.
+//It reads as many packets as the decoder needs, trying again and reconnecting the source if reading fails.
+//reconnected is set if the source had to be reconnected on the way.
+bool indi_webcam::decodeNextFrame(AVFrame *frame, bool &reconnected)
 {
-    AVPacket packet;
-    //If at first you don't succees to get a frame, try again.
-    int ret = -1;
-    while(ret < 0)
+    reconnected = false;
+    while(true)
     {
+        int ret = avcodec_receive_frame(pCodecCtx, frame);
+        if(ret == 0)
+            return true;
+        if(ret != AVERROR(EAGAIN))
+        {
+            char errbuff[200];
+            av_make_error_string(errbuff, 200, ret);
+            DEBUGF(INDI::Logger::DBG_SESSION, "Error during decoding: %s", errbuff);
+            return false;
+        }
+
+        //The decoder needs more data, if at first you don't succeed to get a packet, try again.
+        AVPacket packet;
         int tries = 0;
         while(tries < 10) //Try a maximum of 10 times before trying to reconnect the source
         {
@@ -1830,59 +1872,101 @@ bool indi_webcam::getStreamFrame()
         }
         if(ret < 0) // If it still is not working after 10 tries, we should try reconnecting the source.
         {
-            if(reconnectSource())
-            {
-                DEBUG(INDI::Logger::DBG_SESSION, "Device successfully reconnected.");
-                freeMemory();
-                //Try to set up streaming again, if there is an error, return
-                if(!setupStreaming())
-                {
-                    DEBUG(INDI::Logger::DBG_SESSION, "Error on Stream Setup.");
-                    return false;
-                }
-            }
-            else
+            if(!reconnectSource())
             {
                 DEBUG(INDI::Logger::DBG_SESSION, "Device did not reconnect after 10 tries.");
-                av_packet_unref(&packet);
                 return false;
             }
+            DEBUG(INDI::Logger::DBG_SESSION, "Device successfully reconnected.");
+            reconnected = true;
+            continue;
         }
-    }
-    if(packet.stream_index == videoStream)
-    {
-        int ret;
-        ret = avcodec_send_packet(pCodecCtx, &packet);
-        char errbuff[200];
-        av_make_error_string(errbuff, 200, ret);
-        if (ret < 0)
-        {
-            DEBUGF(INDI::Logger::DBG_SESSION, "Error sending a packet for decoding:%s", errbuff);
-            av_packet_unref(&packet);
-            return false;
-        }
-        while (ret >= 0)
+
+        if(packet.stream_index == videoStream)
         {
-            ret = avcodec_receive_frame(pCodecCtx, pFrame);
-            if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF)
-                continue;
-            else if (ret < 0)
+            ret = avcodec_send_packet(pCodecCtx, &packet);
+            if (ret < 0)
             {
-                DEBUG(INDI::Logger::DBG_SESSION, "Error during decoding");
+                char errbuff[200];
+                av_make_error_string(errbuff, 200, ret);
+                DEBUGF(INDI::Logger::DBG_SESSION, "Error sending a packet for decoding:%s", errbuff);
                 av_packet_unref(&packet);
                 return false;
             }
-            // We have a frame at that point
-            // Convert the image from its native format to our output format
-            sws_scale(sws_ctx, (uint8_t const * const *)pFrame->data,
-                      pFrame->linesize, 0, pCodecCtx->height,
-                      pFrameOUT->data, pFrameOUT->linesize);
-            av_packet_unref(&packet);
-            return true;
         }
+        av_packet_unref(&packet);
+    }
+}
 
+//This converts a decoded frame to our output format, out must hold numBytes.
+bool indi_webcam::convertFrame(AVFrame *frame, uint8_t *out)
+{
+    if(frame->width != outWidth || frame->height != outHeight)
+    {
+        LOGF_ERROR("Source changed its size from %dx%d to %dx%d, please restart the capture.", outWidth, outHeight,
+                   frame->width, frame->height);
+        return false;
     }
-    return false;
+
+    bool adjusted = brightness != 0.0 || contrast != 1.0 || saturation != 1.0;
+
+    //Sources that already deliver the output format, such as 16 bit grayscale cameras, are copied as they are.
+    if(frame->format == out_pix_fmt && !adjusted)
+    {
+        av_image_copy_to_buffer(out, numBytes, frame->data, frame->linesize, out_pix_fmt, outWidth, outHeight, 1);
+        return true;
+    }
+
+    //Accurate rounding keeps the low bits of high bit depth sources when converting to a 16 bit format.
+    int flags = SWS_BILINEAR;
+    if(PrimaryCCD.getBPP() == 16)
+        flags |= SWS_ACCURATE_RND | SWS_FULL_CHR_H_INT;
+
+    //This only creates a new context if the decoded pixel format changed, for instance after reconnecting.
+    SwsContext *ctx = sws_getCachedContext(sws_ctx, outWidth, outHeight, static_cast<AVPixelFormat>(frame->format),
+                                           outWidth, outHeight, out_pix_fmt, flags, nullptr, nullptr, nullptr);
+    if(ctx == nullptr)
+    {
+        LOG_ERROR("Cannot convert the decoded frames to the output format.");
+        return false;
+    }
+    if(ctx != sws_ctx || videoAdjustmentsChanged.exchange(false))
+    {
+        sws_ctx = ctx;
+        applyVideoAdjustments();
+    }
+
+    uint8_t *data[4];
+    int linesize[4];
+    av_image_fill_arrays(data, linesize, out, out_pix_fmt, outWidth, outHeight, 1);
+    sws_scale(sws_ctx, (uint8_t const * const *)frame->data, frame->linesize, 0, outHeight, data, linesize);
+    return true;
+}
+
+//This gets one image from the camera.
+//It is used by the exposing algorithm, streaming decodes and converts on separate threads.
+bool indi_webcam::getStreamFrame()
+{
+    bool reconnected = false;
+    if(!decodeNextFrame(pFrame, reconnected))
+        return false;
+
+    //A reconnected source may come back with another pixel format or size.
+    //A stack already started keeps its size, convertFrame() reports a source that changed it.
+    if(reconnected && !(webcamStacking && stackStarted))
+    {
+        if(!setupStreaming())
+        {
+            av_frame_unref(pFrame);
+            return false;
+        }
+        PrimaryCCD.setFrame(0, 0, outWidth, outHeight);
+    }
+
+    // Convert the image from its native format to our output format
+    bool converted = convertFrame(pFrame, pFrameOUT->data[0]);
+    av_frame_unref(pFrame);
+    return converted;
 }
 
 //This will clear out the frame buffer of any unread frames.
@@ -1911,6 +1995,8 @@ bool indi_webcam::flush_frame_buffer()
         packetReceiveTime = now.tv_usec - then.tv_usec;
         av_packet_unref(&packet);
     }
+    //Frames still queued in the decoder threads are stale as well.
+    avcodec_flush_buffers(pCodecCtx);
     DEBUGF(INDI::Logger::DBG_SESSION, "Buffer Cleared of %u stale frames.", num);
     return true;  //Buffer Cleared
 }
@@ -1945,6 +2031,7 @@ bool indi_webcam::saveConfigItems(FILE *fp)
     INDI::CCD::saveConfigItems(fp);
     IUSaveConfigSwitch(fp, &CaptureDeviceSelection);
     IUSaveConfigSwitch(fp, &RapidStackingSelection);
+    IUSaveConfigNumber(fp, &StackSettingsTP);
     IUSaveConfigSwitch(fp, &OutputFormatSelection);
     IUSaveConfigSwitch(fp, &OnlineProtocolSelection);
     IUSaveConfigNumber(fp, &PixelSizeTP);
@@ -28,6 +28,9 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
 #include <indiccd.h>
 #include <stream/streammanager.h>
 
+#include "framepool.h"
+#include "webcam_stacker.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -42,6 +45,7 @@ extern "C" {
 }
 #endif
 //#include <ctime>
+#include <atomic>
 #include <thread>
 
 //These are required to check for AVFoundation Devices
@@ -115,17 +119,14 @@ private:
 
     //webcam stacking.
     bool webcamStacking = false;
+    //The stack was set up for the frames of the current exposure
+    bool stackStarted = false;
     bool gotAnImageAlready = false;
     bool loadingSettings = false;
-    bool averaging = false;
-    float *stackBuffer = nullptr;
-    int numberOfFramesInStack = 0;
+    WebcamStacker stacker;
+    bool startStack();
     bool addToStack();
     void copyFinalStackToPrimaryFrameBuffer();
-    void setImageDataValueFromFloat(int x, int y, float value, bool roundAnswer);
-    void setRGBImageDataValueFromFloat(int x, int y, int channel, float value, bool roundAnswer);
-    float getImageDataFloatValue(int x, int y);
-    float getRGBImageDataFloatValue(int x, int y, int channel);
 
     //These are our device capture settings
     bool use16Bit = true;
@@ -185,6 +186,10 @@ private:
     INumberVectorProperty PixelSizeTP;
     INumber VideoAdjustmentsT[3] {};
     INumberVectorProperty VideoAdjustmentsTP;
+    INumber StackSettingsT[2] {};
+    INumberVectorProperty StackSettingsTP;
+    INumber StackStatsT[2] {};
+    INumberVectorProperty StackStatsTP;
 
 
     //Webcam setup, release, and frame capture
@@ -192,13 +197,22 @@ private:
     bool setupStreaming();
     void freeMemory();
     bool getStreamFrame();
+    bool decodeNextFrame(AVFrame *frame, bool &reconnected);
+    bool convertFrame(AVFrame *frame, uint8_t *out);
 
     //Related to streaming
+    //Streaming runs in three stages: the capture thread demuxes and decodes,
+    //the conversion thread runs sws_scale and the publisher thread hands frames to the streamer.
+    static const int STREAM_POOL_SIZE = 3;
     std::thread capture_thread;
     static void RunCaptureThread(indi_webcam *webcam);
     void run_capture();
-    bool is_capturing = false;
-    bool is_streaming = false;
+    void run_conversion();
+    void run_publisher();
+    FrameQueue<AVFrame *> decodedFrames {FrameQueue<AVFrame *>::DROP_OLDEST};
+    FramePool convertedFrames {FramePool::DROP_OLDEST};
+    std::atomic<bool> is_capturing { false };
+    std::atomic<bool> is_streaming { false };
     void start_capturing();
     void stop_capturing();
 
@@ -206,6 +220,8 @@ private:
     struct SwsContext *sws_ctx;
     uint8_t *buffer;
     int numBytes = 0;
+    int outWidth = 0;
+    int outHeight = 0;
     AVPixelFormat out_pix_fmt;
     AVFormatContext *pFormatCtx;
     int              videoStream;
@@ -223,7 +239,9 @@ private:
     double brightness = 0.0;
     double contrast = 1.0;
     double saturation = 1.0;
+    std::atomic<bool> videoAdjustmentsChanged { false };
     void updateVideoAdjustments();
+    void applyVideoAdjustments();
 
 };
 #endif // indi_webcam_H
@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+
+#include "webcam_stacker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+// Random planar frames of width x rows samples
+template <typename T>
+static std::vector<std::vector<T>> randomFrames(size_t width, size_t rows, int count, unsigned seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<uint32_t> value(0, std::numeric_limits<T>::max());
+    std::vector<std::vector<T>> frames(count, std::vector<T>(width * rows));
+    for (auto &frame : frames)
+        for (auto &sample : frame)
+            sample = static_cast<T>(value(generator));
+    return frames;
+}
+
+static double median(std::vector<double> v)
+{
+    std::sort(v.begin(), v.end());
+    size_t n = v.size();
+    return (n & 1) ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+static double sigmaClip(const std::vector<double> &v, double sigma)
+{
+    double mean = 0, var = 0;
+    for (double x : v)
+        mean += x;
+    mean /= v.size();
+    for (double x : v)
+        var += (x - mean) * (x - mean);
+    var /= v.size();
+
+    double kept = 0;
+    int keptCount = 0;
+    for (double x : v)
+        if ((x - mean) * (x - mean) <= sigma * sigma * var)
+        {
+            kept += x;
+            keptCount++;
+        }
+    return keptCount > 0 ? kept / keptCount : mean;
+}
+
+// Straightforward per-sample model of every mode, the rolling window slides by one frame
+template <typename T>
+static std::vector<double> reference(const std::vector<std::vector<T>> &frames, WebcamStacker::Mode mode, int window,
+                                     double sigma)
+{
+    size_t samples = frames[0].size();
+    int count = static_cast<int>(frames.size());
+    std::vector<double> out(samples);
+
+    for (size_t i = 0; i < samples; i++)
+    {
+        if (mode == WebcamStacker::MODE_INTEGRATE || mode == WebcamStacker::MODE_AVERAGE)
+        {
+            double sum = 0;
+            for (const auto &frame : frames)
+                sum += frame[i];
+            out[i] = mode == WebcamStacker::MODE_AVERAGE ? sum / count :
+                     std::min<double>(sum, std::numeric_limits<T>::max());
+            continue;
+        }
+
+        // Window positions [p, p + window), or one short window if there are fewer frames
+        int positions = std::max(1, count - window + 1);
+        int length = std::min(window, count);
+        double total = 0;
+        for (int p = 0; p < positions; p++)
+        {
+            std::vector<double> v;
+            for (int k = p; k < p + length; k++)
+                v.push_back(frames[k][i]);
+            total += mode == WebcamStacker::MODE_MEDIAN ? median(v) : sigmaClip(v, sigma);
+        }
+        out[i] = std::min<double>(total / positions, std::numeric_limits<T>::max());
+    }
+    return out;
+}
+
+template <typename T>
+static void checkStack(size_t width, size_t rows, int count, WebcamStacker::Mode mode, int window)
+{
+    const double sigma = 2.0;
+    auto frames = randomFrames<T>(width, rows, count, static_cast<unsigned>(width * 31 + rows * 7 + count));
+
+    WebcamStacker stacker;
+    stacker.setMode(mode);
+    stacker.setWindow(window);
+    stacker.setSigma(sigma);
+    ASSERT_TRUE(stacker.begin(width, rows, sizeof(T) * 8));
+    for (const auto &frame : frames)
+        ASSERT_TRUE(stacker.add(reinterpret_cast<const uint8_t *>(frame.data())));
+    EXPECT_EQ(stacker.frames(), static_cast<uint32_t>(count));
+
+    std::vector<T> out(width * rows);
+    stacker.finish(reinterpret_cast<uint8_t *>(out.data()));
+
+    auto expected = reference(frames, mode, window, sigma);
+    // Float accumulation and rounding to the output type
+    const double tolerance = sizeof(T) == 1 ? 1.0 : 2.0;
+    for (size_t i = 0; i < out.size(); i++)
+        ASSERT_NEAR(out[i], expected[i], tolerance) << "sample " << i << " mode " << mode << " window " << window;
+}
+
+TEST(WebcamStacker, Integrate)
+{
+    checkStack<uint8_t>(641, 483, 7, WebcamStacker::MODE_INTEGRATE, 5);
+    checkStack<uint16_t>(97, 61, 4, WebcamStacker::MODE_INTEGRATE, 5);
+}
+
+TEST(WebcamStacker, Average)
+{
+    checkStack<uint8_t>(641, 483, 7, WebcamStacker::MODE_AVERAGE, 5);
+    checkStack<uint16_t>(97, 61, 9, WebcamStacker::MODE_AVERAGE, 5);
+}
+
+TEST(WebcamStacker, RollingMedian)
+{
+    checkStack<uint8_t>(641, 3 * 121, 11, WebcamStacker::MODE_MEDIAN, 5);
+    checkStack<uint8_t>(33, 17, 9, WebcamStacker::MODE_MEDIAN, 4);
+    checkStack<uint16_t>(97, 61, 16, WebcamStacker::MODE_MEDIAN, 15);
+}
+
+TEST(WebcamStacker, RollingSigmaClip)
+{
+    checkStack<uint8_t>(641, 3 * 121, 11, WebcamStacker::MODE_SIGMA_CLIP, 5);
+    checkStack<uint16_t>(97, 61, 8, WebcamStacker::MODE_SIGMA_CLIP, 3);
+}
+
+TEST(WebcamStacker, ShorterThanWindow)
+{
+    checkStack<uint8_t>(65, 33, 2, WebcamStacker::MODE_MEDIAN, 5);
+    checkStack<uint16_t>(65, 33, 4, WebcamStacker::MODE_SIGMA_CLIP, 7);
+}
+
+TEST(WebcamStacker, WindowSlidesByOneFrame)
+{
+    // A single bright frame never wins the median of any window of 3
+    WebcamStacker stacker;
+    stacker.setMode(WebcamStacker::MODE_MEDIAN);
+    stacker.setWindow(3);
+    ASSERT_TRUE(stacker.begin(8, 8, 8));
+
+    std::vector<uint8_t> dark(64, 10), bright(64, 250), out(64);
+    for (int i = 0; i < 9; i++)
+        stacker.add(i == 4 ? bright.data() : dark.data());
+    stacker.finish(out.data());
+    for (uint8_t sample : out)
+        EXPECT_EQ(sample, 10);
+
+    // Two bright frames in a row win the two windows that hold both. Windows 0-2, 1-3, 2-4
+    // and 3-5 have medians 10, 250, 250 and 10. Separate windows 0-2 and 3-5 would give 10.
+    ASSERT_TRUE(stacker.begin(8, 8, 8));
+    for (int i = 0; i < 6; i++)
+        stacker.add(i == 2 || i == 3 ? bright.data() : dark.data());
+    stacker.finish(out.data());
+    for (uint8_t sample : out)
+        EXPECT_EQ(sample, 130);
+}
+
+TEST(WebcamStacker, GeometryChange)
+{
+    // A new geometry on begin() must not use the previous buffers
+    checkStack<uint16_t>(320, 240, 6, WebcamStacker::MODE_MEDIAN, 5);
+
+    WebcamStacker stacker;
+    stacker.setMode(WebcamStacker::MODE_AVERAGE);
+    ASSERT_TRUE(stacker.begin(16, 16, 16));
+    std::vector<uint16_t> small(16 * 16, 1000);
+    stacker.add(reinterpret_cast<const uint8_t *>(small.data()));
+
+    ASSERT_TRUE(stacker.begin(64, 48, 8));
+    std::vector<uint8_t> large(64 * 48, 200), out(64 * 48);
+    stacker.add(large.data());
+    stacker.add(large.data());
+    stacker.finish(out.data());
+    EXPECT_EQ(stacker.frames(), 2u);
+    for (uint8_t sample : out)
+        EXPECT_EQ(sample, 200);
+
+    EXPECT_FALSE(stacker.begin(0, 48, 8));
+    EXPECT_FALSE(stacker.begin(64, 48, 12));
+}
+
+TEST(WebcamStacker, ModeAppliesFromNextStack)
+{
+    WebcamStacker stacker;
+    stacker.setMode(WebcamStacker::MODE_INTEGRATE);
+    ASSERT_TRUE(stacker.begin(8, 8, 8));
+    std::vector<uint8_t> frame(64, 40), out(64);
+    stacker.add(frame.data());
+
+    // Switched mid-exposure, the running stack keeps integrating
+    stacker.setMode(WebcamStacker::MODE_MEDIAN);
+    stacker.add(frame.data());
+    stacker.finish(out.data());
+    for (uint8_t sample : out)
+        EXPECT_EQ(sample, 80);
+}
@@ -0,0 +1,353 @@
+/*
+INDI Webcam Stacker
+
+Copyright (C) 2026 agent (agent AT local)
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "webcam_stacker.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+// Samples per row block handed to a worker, small enough to stay in L2.
+constexpr size_t BLOCK_SAMPLES = 32768;
+// Pixels reduced together by the window kernels.
+constexpr size_t LANES = 64;
+}
+
+WebcamStacker::WebcamStacker() = default;
+
+WebcamStacker::~WebcamStacker() = default;
+
+void WebcamStacker::setWindow(int frames)
+{
+    mWindow = std::max(MIN_WINDOW, std::min(MAX_WINDOW, frames));
+}
+
+bool WebcamStacker::begin(size_t width, size_t rows, int bpp)
+{
+    if (width == 0 || rows == 0 || (bpp != 8 && bpp != 16))
+        return false;
+
+    // Mode and window may be changed by the client mid-exposure, they apply from the next stack.
+    mActiveMode   = mMode;
+    mActiveWindow = mWindow;
+    mWidth = width;
+    mRows  = rows;
+    mBPP   = bpp;
+
+    size_t samples = width * rows;
+    size_t bytesPerSample = bpp / 8;
+    if (mActiveMode == MODE_INTEGRATE || mActiveMode == MODE_AVERAGE)
+    {
+        mSum.resize(samples);
+        mMaxFrames = std::numeric_limits<uint32_t>::max() / (bpp == 8 ? 0xFFu : 0xFFFFu);
+    }
+    else
+    {
+        mMean.resize(samples);
+        mWindowFrames.resize(samples * bytesPerSample * mActiveWindow);
+        mMaxFrames = std::numeric_limits<uint32_t>::max();
+    }
+
+    mBlockRows = std::max<size_t>(1, BLOCK_SAMPLES / width);
+
+    mWindowFill = 0;
+    mWindowNext = 0;
+    mMeanWeight = 0;
+    mFrames     = 0;
+    mSaturated  = false;
+    mStart      = std::chrono::steady_clock::now();
+    return true;
+}
+
+bool WebcamStacker::add(const uint8_t *frame)
+{
+    if (mWidth == 0)
+        return false;
+
+    if (mFrames >= mMaxFrames)
+    {
+        mSaturated = true;
+        return false;
+    }
+
+    bool sum = (mActiveMode == MODE_INTEGRATE || mActiveMode == MODE_AVERAGE);
+    if (mBPP == 8)
+    {
+        if (sum)
+            accumulate(frame);
+        else
+            store(frame);
+    }
+    else
+    {
+        const uint16_t *frame16 = reinterpret_cast<const uint16_t *>(frame);
+        if (sum)
+            accumulate(frame16);
+        else
+            store(frame16);
+    }
+
+    mFrames++;
+    return true;
+}
+
+void WebcamStacker::finish(uint8_t *out)
+{
+    if (mFrames == 0)
+        return;
+
+    bool sum = (mActiveMode == MODE_INTEGRATE || mActiveMode == MODE_AVERAGE);
+    if (mBPP == 8)
+    {
+        if (sum)
+            finishSum(out);
+        else
+            finishMean(out);
+    }
+    else
+    {
+        uint16_t *out16 = reinterpret_cast<uint16_t *>(out);
+        if (sum)
+            finishSum(out16);
+        else
+            finishMean(out16);
+    }
+}
+
+void WebcamStacker::release()
+{
+    mPool.stop();
+    std::vector<uint32_t>().swap(mSum);
+    std::vector<float>().swap(mMean);
+    std::vector<uint8_t>().swap(mWindowFrames);
+    mWidth = mRows = 0;
+    mFrames = 0;
+}
+
+double WebcamStacker::fps() const
+{
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - mStart).count();
+    return seconds > 0 ? mFrames / seconds : 0;
+}
+
+template <typename T>
+void WebcamStacker::accumulate(const T *frame)
+{
+    bool first = (mFrames == 0);
+    parallelRows([&](size_t begin, size_t end)
+    {
+        const T *__restrict src = frame + begin * mWidth;
+        uint32_t *__restrict dst = mSum.data() + begin * mWidth;
+        size_t count = (end - begin) * mWidth;
+
+        if (first)
+        {
+            for (size_t i = 0; i < count; i++)
+                dst[i] = src[i];
+        }
+        else
+        {
+            for (size_t i = 0; i < count; i++)
+                dst[i] += src[i];
+        }
+    });
+}
+
+template <typename T>
+void WebcamStacker::store(const T *frame)
+{
+    // The new frame replaces the oldest one in the ring
+    size_t samples = mWidth * mRows;
+    T *slot = reinterpret_cast<T *>(mWindowFrames.data()) + mWindowNext * samples;
+    memcpy(slot, frame, samples * sizeof(T));
+
+    mWindowNext = (mWindowNext + 1) % mActiveWindow;
+    if (mWindowFill < mActiveWindow)
+        mWindowFill++;
+
+    // Every frame from the one that fills the window on moves the window by one
+    if (mWindowFill == mActiveWindow)
+        reduceWindow<T>();
+}
+
+template <typename T>
+void WebcamStacker::reduceWindow()
+{
+    const int n = mWindowFill;
+    if (n == 0)
+        return;
+
+    const size_t samples = mWidth * mRows;
+    const T *frames = reinterpret_cast<const T *>(mWindowFrames.data());
+    const bool first = (mMeanWeight == 0);
+    const bool median = (mActiveMode == MODE_MEDIAN);
+    const float sigma2 = mSigma * mSigma;
+    const float count = static_cast<float>(n);
+
+    parallelRows([&](size_t begin, size_t end)
+    {
+        T v[MAX_WINDOW][LANES];
+        float result[LANES];
+
+        for (size_t offset = begin * mWidth; offset < end * mWidth; offset += LANES)
+        {
+            size_t len = std::min(LANES, end * mWidth - offset);
+
+            for (int k = 0; k < n; k++)
+                memcpy(v[k], frames + k * samples + offset, len * sizeof(T));
+
+            if (median)
+            {
+                // Partial selection sort across the frames, every lane at once.
+                // After pass i, v[i] holds the i-th smallest sample.
+                const int mid = n / 2;
+                for (int i = 0; i <= mid && i < n - 1; i++)
+                {
+                    for (int j = i + 1; j < n; j++)
+                    {
+                        T *__restrict a = v[i];
+                        T *__restrict b = v[j];
+                        for (size_t l = 0; l < len; l++)
+                        {
+                            T lo = std::min(a[l], b[l]);
+                            T hi = std::max(a[l], b[l]);
+                            a[l] = lo;
+                            b[l] = hi;
+                        }
+                    }
+                }
+
+                if (n & 1)
+                {
+                    for (size_t l = 0; l < len; l++)
+                        result[l] = v[mid][l];
+                }
+                else
+                {
+                    for (size_t l = 0; l < len; l++)
+                        result[l] = (static_cast<float>(v[mid - 1][l]) + v[mid][l]) * 0.5f;
+                }
+            }
+            else
+            {
+                float mean[LANES], var[LANES], kept[LANES], keptCount[LANES];
+                for (size_t l = 0; l < len; l++)
+                    mean[l] = var[l] = kept[l] = keptCount[l] = 0;
+
+                for (int k = 0; k < n; k++)
+                    for (size_t l = 0; l < len; l++)
+                        mean[l] += v[k][l];
+                for (size_t l = 0; l < len; l++)
+                    mean[l] /= count;
+
+                for (int k = 0; k < n; k++)
+                    for (size_t l = 0; l < len; l++)
+                    {
+                        float d = v[k][l] - mean[l];
+                        var[l] += d * d;
+                    }
+                for (size_t l = 0; l < len; l++)
+                    var[l] = var[l] / count * sigma2;
+
+                // Keep samples with (x - mean)^2 <= sigma^2 * variance, no sqrt needed.
+                for (int k = 0; k < n; k++)
+                    for (size_t l = 0; l < len; l++)
+                    {
+                        float x = v[k][l];
+                        float d = x - mean[l];
+                        bool keep = d * d <= var[l];
+                        kept[l] += keep ? x : 0.0f;
+                        keptCount[l] += keep ? 1.0f : 0.0f;
+                    }
+
+                for (size_t l = 0; l < len; l++)
+                    result[l] = keptCount[l] > 0 ? kept[l] / keptCount[l] : mean[l];
+            }
+
+            float *__restrict acc = mMean.data() + offset;
+            if (first)
+            {
+                for (size_t l = 0; l < len; l++)
+                    acc[l] = result[l];
+            }
+            else
+            {
+                for (size_t l = 0; l < len; l++)
+                    acc[l] += result[l];
+            }
+        }
+    });
+
+    mMeanWeight++;
+}
+
+template <typename T>
+void WebcamStacker::finishSum(T *out)
+{
+    const uint32_t maxValue = std::numeric_limits<T>::max();
+    const float scale = 1.0f / mFrames;
+    const bool average = (mActiveMode == MODE_AVERAGE);
+
+    parallelRows([&](size_t begin, size_t end)
+    {
+        const uint32_t *__restrict src = mSum.data() + begin * mWidth;
+        T *__restrict dst = out + begin * mWidth;
+        size_t count = (end - begin) * mWidth;
+
+        if (average)
+        {
+            for (size_t i = 0; i < count; i++)
+                dst[i] = static_cast<T>(static_cast<float>(src[i]) * scale + 0.5f);
+        }
+        else
+        {
+            for (size_t i = 0; i < count; i++)
+                dst[i] = static_cast<T>(std::min(src[i], maxValue));
+        }
+    });
+}
+
+template <typename T>
+void WebcamStacker::finishMean(T *out)
+{
+    // A stack shorter than the window never filled it, reduce what is there.
+    if (mMeanWeight == 0)
+        reduceWindow<T>();
+
+    const float maxValue = std::numeric_limits<T>::max();
+    const float scale = 1.0f / mMeanWeight;
+
+    parallelRows([&](size_t begin, size_t end)
+    {
+        const float *__restrict src = mMean.data() + begin * mWidth;
+        T *__restrict dst = out + begin * mWidth;
+        size_t count = (end - begin) * mWidth;
+
+        for (size_t i = 0; i < count; i++)
+            dst[i] = static_cast<T>(std::min(src[i] * scale + 0.5f, maxValue));
+    });
+}
+
+void WebcamStacker::parallelRows(const RowJob &job)
+{
+    mPool.run(mRows, job, mBlockRows);
+}
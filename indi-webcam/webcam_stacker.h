@@ -0,0 +1,144 @@
+/*
+INDI Webcam Stacker
+
+Copyright (C) 2026 agent (agent AT local)
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include "blockpool.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Rapid stacking of webcam frames into a single exposure.
+//
+// Frames are planar 8 or 16-bit buffers as they sit in the CCD frame buffer.
+// Integration and Average add every frame into a uint32 sum. Median and
+// Sigma Clip keep a rolling window of the last N frames in a ring. Once the
+// window is full, every new frame slides it by one, the window is reduced per
+// pixel and the result is added into a float mean of all window positions.
+// All passes work on contiguous rows, written so the compiler can vectorize
+// them, and are split in row blocks across a small worker pool.
+class WebcamStacker
+{
+    public:
+        enum Mode
+        {
+            MODE_INTEGRATE,
+            MODE_AVERAGE,
+            MODE_MEDIAN,
+            MODE_SIGMA_CLIP
+        };
+
+        static constexpr int MIN_WINDOW = 3;
+        static constexpr int MAX_WINDOW = 15;
+
+        WebcamStacker();
+        ~WebcamStacker();
+
+        WebcamStacker(const WebcamStacker &) = delete;
+        WebcamStacker &operator=(const WebcamStacker &) = delete;
+
+        void setMode(Mode mode)
+        {
+            mMode = mode;
+        }
+        Mode mode() const
+        {
+            return mMode;
+        }
+
+        /** Length of the rolling window reduced by Median and Sigma Clip. */
+        void setWindow(int frames);
+        /** Samples further than sigma standard deviations from the window mean are rejected. */
+        void setSigma(double sigma)
+        {
+            mSigma = static_cast<float>(sigma);
+        }
+
+        /**
+         * @brief begin Start a new stack. Buffers are kept from the previous stack when the geometry is unchanged.
+         * @param width samples per row.
+         * @param rows number of rows, i.e. height times colour planes.
+         * @param bpp 8 or 16.
+         */
+        bool begin(size_t width, size_t rows, int bpp);
+
+        /** Add a frame of width * rows samples. False if the uint32 sum cannot take another frame. */
+        bool add(const uint8_t *frame);
+
+        /** Write the stacked frame, same layout as the input frames. */
+        void finish(uint8_t *out);
+
+        /** Free all buffers, e.g. on disconnect. */
+        void release();
+
+        uint32_t frames() const
+        {
+            return mFrames;
+        }
+        /** True if frames were refused because the sum would overflow. */
+        bool saturated() const
+        {
+            return mSaturated;
+        }
+        /** Frames added per second since begin(). */
+        double fps() const;
+
+    private:
+        using RowJob = BlockPool::Job;
+
+        template <typename T> void accumulate(const T *frame);
+        template <typename T> void store(const T *frame);
+        template <typename T> void reduceWindow();
+        template <typename T> void finishSum(T *out);
+        template <typename T> void finishMean(T *out);
+
+        // Run job over [0, mRows) in row blocks on the pool and the calling thread.
+        void parallelRows(const RowJob &job);
+
+        Mode mMode {MODE_INTEGRATE};
+        int mWindow {5};
+        float mSigma {2.5f};
+        Mode mActiveMode {MODE_INTEGRATE};
+        int mActiveWindow {5};
+
+        size_t mWidth {0};
+        size_t mRows {0};
+        int mBPP {8};
+
+        std::vector<uint32_t> mSum;
+        std::vector<float> mMean;
+        // Ring of the last mActiveWindow frames, mWindowNext is the slot the next frame goes to
+        std::vector<uint8_t> mWindowFrames;
+        int mWindowFill {0};
+        int mWindowNext {0};
+        // Window positions added into mMean
+        uint32_t mMeanWeight {0};
+
+        uint32_t mFrames {0};
+        uint32_t mMaxFrames {0};
+        bool mSaturated {false};
+        std::chrono::steady_clock::time_point mStart;
+
+        BlockPool mPool;
+        size_t mBlockRows {0};
+};
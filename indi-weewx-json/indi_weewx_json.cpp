@@ -25,35 +25,10 @@
 #include "indi_weewx_json.h"
 #include "config.h"
 
-#include <curl/curl.h>
-
 #include <memory>
 #include <cstring>
 #include <string>
 
-struct response_t
-{
-    char *response;
-    size_t size;
-};
-
-static size_t cb(void *data, size_t size, size_t nmemb, void *userp)
-{
-    size_t realsize        = size * nmemb;
-    struct response_t *mem = (struct response_t *)userp;
-
-    char *ptr = (char *)realloc(mem->response, mem->size + realsize + 1);
-    if (ptr == NULL)
-        return 0; /* out of memory! */
-
-    mem->response = ptr;
-    memcpy(&(mem->response[mem->size]), data, realsize);
-    mem->size += realsize;
-    mem->response[mem->size] = 0;
-
-    return realsize;
-}
-
 // We declare an auto pointer to WeewxJSON.
 std::unique_ptr<WeewxJSON> weewx_json(new WeewxJSON());
 
@@ -64,7 +39,10 @@ WeewxJSON::WeewxJSON()
     setWeatherConnection(CONNECTION_NONE);
 }
 
-WeewxJSON::~WeewxJSON() {}
+WeewxJSON::~WeewxJSON()
+{
+    weewxFeed.stop();
+}
 
 const char *WeewxJSON::getDefaultName()
 {
@@ -73,11 +51,13 @@ const char *WeewxJSON::getDefaultName()
 
 bool WeewxJSON::Connect()
 {
+    weewxFeed.start();
     return true;
 }
 
 bool WeewxJSON::Disconnect()
 {
+    weewxFeed.stop();
     return true;
 }
 
@@ -89,6 +69,10 @@ bool WeewxJSON::initProperties()
 
     weewxJsonUrl.fill(getDeviceName(), "WEEWX_URL", "Weewx", OPTIONS_TAB, IP_RW, 60, IPS_IDLE);
 
+    weewxLatency[LATENCY_LAST].fill("LATENCY_LAST", "Last (ms)", "%.1f", 0, 60000, 0, 0);
+    weewxLatency[LATENCY_AVERAGE].fill("LATENCY_AVERAGE", "Average (ms)", "%.1f", 0, 60000, 0, 0);
+    weewxLatency.fill(getDeviceName(), "HTTP_LATENCY", "Request latency", OPTIONS_TAB, IP_RO, 60, IPS_IDLE);
+
     addParameter("WEATHER_TEMPERATURE", "Temperature (C)", -10, 30, 15);
     addParameter("WEATHER_DEW_POINT", "Dew Point (C)", -20, 35, 15);
     addParameter("WEATHER_HUMIDITY", "Humidity %", 0, 100, 15);
@@ -129,11 +113,13 @@ bool WeewxJSON::updateProperties()
     if (isConnected())
     {
         defineProperty(weewxJsonUrl);
+        defineProperty(weewxLatency);
         SetTimer(getCurrentPollingPeriod());
     }
     else
     {
         deleteProperty(weewxJsonUrl.getName());
+        deleteProperty(weewxLatency.getName());
     }
 
     return true;
@@ -252,54 +238,68 @@ void WeewxJSON::handleWeatherData(json value)
         handleRainRateData(value["rain rate"], "WEATHER_RAIN_RATE");
 }
 
+bool WeewxJSON::parseReport(const std::string &body, json &current, std::string &error)
+{
+    try
+    {
+        json report = json::parse(body);
+
+        if (!report.contains("current"))
+        {
+            error = "No current weather data found in report.";
+            return false;
+        }
+
+        current = std::move(report["current"]);
+        return true;
+    }
+    catch (json::exception &e)
+    {
+        error = e.what();
+        return false;
+    }
+}
+
 IPState WeewxJSON::updateWeather()
 {
     if (isDebug())
         IDLog("%s: updateWeather()\n", getDeviceName());
 
-    CURL *curl;
-    CURLcode res;
-
-    curl = curl_easy_init();
-    if (curl)
+    const char *url = weewxJsonUrl[WEEWX_URL].getText();
+    if (url == nullptr || url[0] == '\0')
     {
-        struct response_t chunk = { .response = nullptr, .size = 0 };
+        LOG_ERROR("No Weewx JSON URL set.");
+        return IPS_ALERT;
+    }
 
-        curl_easy_setopt(curl, CURLOPT_URL, weewxJsonUrl[WEEWX_URL].text);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, cb);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &chunk);
+    // The report is fetched in the background, until it is back the update stays busy
+    HttpFeed<json>::Result result;
+    if (!weewxFeed.take(result))
+    {
+        weewxFeed.request(url);
+        return IPS_BUSY;
+    }
+    // The next report is fetched in time for the next update
+    weewxFeed.request(url);
 
-        res = curl_easy_perform(curl);
-        curl_easy_cleanup(curl);
+    HttpPoller::Stats stats = weewxFeed.stats();
+    weewxLatency[LATENCY_LAST].setValue(stats.lastMs);
+    weewxLatency[LATENCY_AVERAGE].setValue(stats.averageMs);
+    weewxLatency.setState(result.error.empty() ? IPS_OK : IPS_ALERT);
+    weewxLatency.apply();
 
-        if (res == CURLcode::CURLE_OK)
-        {
-            nlohmann::json report = nlohmann::json::parse(chunk.response);
-
-            if (report.contains("current"))
-            {
-                handleWeatherData(report["current"]);
-            }
-            else
-            {
-                LOG_ERROR("No current weather data found in report.");
-                return IPS_ALERT;
-            }
-
-            return IPS_OK;
-        }
-        else
-        {
-            LOGF_ERROR("HTTP request to %s failed.", weewxJsonUrl[WEEWX_URL].text);
-            return IPS_ALERT;
-        }
-    }
-    else
+    if (!result.error.empty())
     {
-        LOGF_ERROR("Cannot initialize CURL, connection to HTTP server %s failed.", weewxJsonUrl[WEEWX_URL].text);
+        LOGF_ERROR("Reading weather report from %s failed: %s", url, result.error.c_str());
         return IPS_ALERT;
     }
 
+    // Not modified since the last update, the current values still stand
+    if (result.value)
+        handleWeatherData(*result.value);
+    else
+        LOG_DEBUG("Weather report unchanged.");
+
     return IPS_OK;
 }
 
@@ -27,12 +27,15 @@
 
 #include <libindi/indiweather.h>
 #include <libindi/indipropertytext.h>
+#include <libindi/indipropertynumber.h>
 #ifdef _USE_SYSTEM_JSONLIB
 #include <nlohmann/json.hpp>
 #else
 #include <indijson.hpp>
 #endif
 
+#include "httppoller.h"
+
 using json = nlohmann::json;
 
 class WeewxJSON : public INDI::Weather
@@ -52,6 +55,8 @@ class WeewxJSON : public INDI::Weather
     virtual bool ISNewText(const char *dev, const char *name, char *texts[], char *names[], int n) override;
 
   protected:
+    static bool parseReport(const std::string &body, json &current, std::string &error);
+
     void handleTemperatureData(json value, std::string key);
     void handleRawData(json value, std::string key);
     void handleBarometerData(json value, std::string key);
@@ -69,4 +74,14 @@ class WeewxJSON : public INDI::Weather
     {
         WEEWX_URL,
     };
+
+    INDI::PropertyNumber weewxLatency{ 2 };
+    enum
+    {
+        LATENCY_LAST,
+        LATENCY_AVERAGE,
+    };
+
+    // Fetches and parses the report off the INDI thread
+    HttpFeed<json> weewxFeed{ parseReport };
 };
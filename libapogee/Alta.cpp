@@ -478,6 +478,23 @@ Apg::Status Alta::GetImagingStatus()
 //////////////////////////// 
 // GET  IMAGE 
 void Alta::GetImage( std::vector<uint16_t> & out )
+{
+    uint16_t r=0, c = 0;
+    ExposureAndGetImgRC( r, c );
+    const size_t count = static_cast<size_t>( r ) * GetImageZ() * GetRoiNumCols();
+
+    if( count != out.size() )
+    {
+        out.clear();
+        out.resize( count );
+    }
+
+    GetImage( &(*out.begin()), out.size() );
+}
+
+//////////////////////////// 
+// GET  IMAGE 
+void Alta::GetImage( uint16_t * out, const size_t count )
 {
 #ifdef DEBUGGING_CAMERA
     apgHelper::DebugMsg( "Alta::GetImage -> BEGINNING" );
@@ -521,15 +538,19 @@ void Alta::GetImage( std::vector<uint16_t> & out )
     uint16_t r=0, c = 0;
     ExposureAndGetImgRC( r, c );
     const uint16_t z = GetImageZ();
-    std::vector<uint16_t> datafromCam( r*c*z, 0 ); 
+    std::vector<uint16_t> & datafromCam = m_ImgFromCam;
+    datafromCam.resize( r*c*z );
 
     const int32_t dataLen = r*z;
     const int32_t numCols = GetRoiNumCols();  
 
-    if( dataLen*numCols != apgHelper::SizeT2Int32( out.size() ) )
+    if( static_cast<size_t>( dataLen*numCols ) > count )
     {
-        out.clear();
-        out.resize( dataLen*numCols );
+        std::stringstream msg;
+        msg << "Output buffer of " << count << " pixels is too small for ";
+        msg << dataLen*numCols << " pixels of image data.";
+        apgHelper::throwRuntimeException( m_fileName, msg.str(), 
+            __LINE__, Apg::ErrorType_InvalidUsage );
     }
 
     try
@@ -955,7 +976,7 @@ Apg::FanMode Alta::GetFanMode()
 //////////////////////////// 
 //      FIX      IMG        FROM          CAMERA
 void Alta::FixImgFromCamera( const std::vector<uint16_t> & data,
-                              std::vector<uint16_t> & out,  const int32_t rows, 
+                              uint16_t * out,  const int32_t rows, 
                               const int32_t cols )
 {
     const int32_t offset = m_CcdAcqSettings->GetPixelShift();
@@ -20,6 +20,7 @@
 #include "ApgLogger.h"
 #include "helpers.h"
 #include "CamHelpers.h"
+#include "ImgFix.h"
 
 namespace
 {
@@ -328,38 +329,28 @@ void AltaEthernetIo::GetImageData(std::vector<uint16_t> &ImageData)
     //grab the data
     std::string fullUrl = m_url + "/UE/image.bin";
 
+    // written straight into the pixel buffer, no intermediate copy
     CLibCurlWrap theCurl;
-    std::string result;
-    theCurl.HttpGet( fullUrl, result );
+    size_t received = 0;
+    theCurl.HttpGet( fullUrl, reinterpret_cast<uint8_t *>( &(*ImageData.begin()) ),
+        NumBytesExpected, received );
 
-    if( NumBytesExpected !=  apgHelper::SizeT2Int32( result.size() ) )
+    if( NumBytesExpected !=  apgHelper::SizeT2Int32( received ) )
     {
-        std::stringstream received;
-        received <<  result.size();
+        std::stringstream got;
+        got <<  received;
 
         std::stringstream requested;
         requested << NumBytesExpected;
 
         std::string errMsg = fullUrl + " error - " + requested.str() \
-                             + " bytes requested " + received.str() + " bytes received.";
+                             + " bytes requested " + got.str() + " bytes received.";
         apgHelper::throwRuntimeException( m_fileName, errMsg,
                                           __LINE__, Apg::ErrorType_Critical );
     }
 
-    std::string::iterator strIter;
-    std::string::iterator strIterNext;
-    int32_t i = 0;
-
-    for(strIter = result.begin(); strIter != result.end(); strIter += 2, ++i)
-    {
-        strIterNext = strIter + 1;
-        uint8_t a = (*strIter);
-        uint8_t b = (*strIterNext);
-
-        //TODO verify this works on mac...
-        uint16_t v = ((a << 8) | b);
-        ImageData.at(i) = v;
-    }
+    // the camera sends big endian pixels
+    ImgFix::BigEndianToHost( &(*ImageData.begin()), ImageData.size() );
 }
 
 ////////////////////////////
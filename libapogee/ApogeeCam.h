@@ -1166,6 +1166,16 @@ class DLL_EXPORT ApogeeCam
          */
         virtual void GetImage( std::vector<uint16_t> & out ) = 0;
 
+        /*! 
+         * Downloads the image data from the camera into a caller owned buffer,
+         * e.g. the frame buffer of an application, without an extra copy.
+         * \param [out] out Buffer that will recieve the image data
+         * \param [in] count Size of out in pixels, it must hold at least
+         * GetRoiNumRows() * GetRoiNumCols() pixels per image.
+         * \exception std::runtime_error
+         */
+        virtual void GetImage( uint16_t * out, size_t count ) = 0;
+
         /*! 
          * This method halts an in progress exposure. If this method is called 
          * and there is no exposure in progress a std::runtime_error exception is thrown.
@@ -1284,7 +1294,7 @@ class DLL_EXPORT ApogeeCam
         virtual uint16_t GetImageZ() = 0;
         virtual uint16_t GetIlluminationMask() = 0;
         virtual void FixImgFromCamera( const std::vector<uint16_t> & data,
-            std::vector<uint16_t> & out,  int32_t rows, int32_t cols) = 0;
+            uint16_t * out,  int32_t rows, int32_t cols) = 0;
                 
 //this code removes vc++ compiler warning C4251
 //from http://www.unknownroad.com/rtfm/VisualStudio/warningC4251.html
@@ -1312,6 +1322,9 @@ class DLL_EXPORT ApogeeCam
         uint16_t m_Id;
         uint16_t m_NumImgsDownloaded;
         bool m_ImageInProgress;
+        // camera data before the latency pixels are stripped, kept between
+        // images so a download does not allocate and clear a whole frame
+        std::vector<uint16_t> m_ImgFromCam;
         bool m_IsPreFlashOn;
         bool m_IsInitialized;
         bool m_IsConnected;
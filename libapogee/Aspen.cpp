@@ -230,7 +230,7 @@ void Aspen::UpdateCfgWithStrDbInfo()
 //////////////////////////// 
 //      FIX      IMG        FROM          CAMERA
 void Aspen::FixImgFromCamera( const std::vector<uint16_t> & data,
-                           std::vector<uint16_t> & out,  const int32_t rows, 
+                           uint16_t * out,  const int32_t rows, 
                            const int32_t cols )
 {
      int32_t offset = 0; 
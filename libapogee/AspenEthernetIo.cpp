@@ -206,27 +206,23 @@ void AspenEthernetIo::GetImageData(std::vector<uint16_t> & ImageData)
     //grab the data
     std::string fullUrl = m_url + "/aspen.bin?keyval=" + m_sessionKey;
     
-    std::vector<uint8_t> result;
-	// set container capacity so it doesn't waste time
-	// dynamically allocating space
-	result.reserve( NumBytesExpected );
+    // written straight into the pixel buffer, no intermediate copy
+    size_t received = 0;
 	m_libcurl->setTimeout( 60 + getLastExposureTime() ); // set extended timeout
-    m_libcurl->HttpGet( fullUrl, result );
+    m_libcurl->HttpGet( fullUrl, reinterpret_cast<uint8_t *>( &(*ImageData.begin()) ),
+        NumBytesExpected, received );
 	m_libcurl->setTimeout( -1 ); // restore default timeout
 
-    if( NumBytesExpected !=  apgHelper::SizeT2Int32( result.size() ) )
+    if( NumBytesExpected !=  apgHelper::SizeT2Int32( received ) )
     {
         std::stringstream msg;
         msg <<  fullUrl.c_str() << " error -  requested ";
         msg << NumBytesExpected << " bytes, but received ";
-        msg << result.size() << " bytes.";
+        msg << received << " bytes.";
 
         apgHelper::throwRuntimeException( m_fileName, msg.str() , 
             __LINE__, Apg::ErrorType_Critical );
     }
-
-    //faster than for loop
-    memcpy(&(*ImageData.begin()), &(*result.begin()), NumBytesExpected);
 }
 
 
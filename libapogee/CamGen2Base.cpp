@@ -316,6 +316,23 @@ Apg::Status CamGen2Base::GetImagingStatus()
 //////////////////////////// 
 // GET  IMAGE 
 void CamGen2Base::GetImage( std::vector<uint16_t> & out )
+{
+    uint16_t r=0, c = 0;
+    ExposureAndGetImgRC( r, c );
+    const size_t count = static_cast<size_t>( r ) * GetImageZ() * GetRoiNumCols();
+
+    if( count != out.size() )
+    {
+        out.clear();
+        out.resize( count );
+    }
+
+    GetImage( &(*out.begin()), out.size() );
+}
+
+//////////////////////////// 
+// GET  IMAGE 
+void CamGen2Base::GetImage( uint16_t * out, const size_t count )
 {
 #ifdef DEBUGGING_CAMERA
     apgHelper::DebugMsg( "CamGen2Base::GetImage -> BEGIN" );
@@ -351,15 +368,19 @@ void CamGen2Base::GetImage( std::vector<uint16_t> & out )
     uint16_t r=0, c= 0;
     ExposureAndGetImgRC( r, c );
     const uint16_t z = GetImageZ();
-    std::vector<uint16_t>  datafromCam( r*c*z );
+    std::vector<uint16_t> & datafromCam = m_ImgFromCam;
+    datafromCam.resize( r*c*z );
 
     const int32_t dataLen = r*z;
     const int32_t numCols = GetRoiNumCols();
     
-    if( dataLen*numCols != apgHelper::SizeT2Int32( out.size() ) )
+    if( static_cast<size_t>( dataLen*numCols ) > count )
     {
-        out.clear();
-        out.resize( dataLen*numCols );
+        std::stringstream msg;
+        msg << "Output buffer of " << count << " pixels is too small for ";
+        msg << dataLen*numCols << " pixels of image data.";
+        apgHelper::throwRuntimeException( m_fileName, msg.str(), 
+            __LINE__, Apg::ErrorType_InvalidUsage );
     }
 
     try
@@ -91,10 +91,19 @@ void HiC::Get4kby4kImage( std::vector<uint16_t> & out )
     uint16_t r=0, c= 0;
     ExposureAndGetImgRC( r, c );
     const uint16_t z = GetImageZ();
-    std::vector<uint16_t>  datafromCam( r*c*z );
+    std::vector<uint16_t> & datafromCam = m_ImgFromCam;
+    datafromCam.resize( r*c*z );
 
     const int32_t dataLen = GetRoiNumRows()*z;
     const int32_t numCols = GetRoiNumCols();
+
+    const uint16_t HIC_ROWS = 4096;
+    const uint16_t HIC_COLS = 4096;
+    if( HIC_ROWS*HIC_COLS != out.size() )
+    {
+        out.clear();
+        out.resize( HIC_ROWS*HIC_COLS );
+    }
     
     try
     {
@@ -108,7 +117,7 @@ void HiC::Get4kby4kImage( std::vector<uint16_t> & out )
         ApgLogger::Instance().Write(ApgLogger::LEVEL_RELEASE,"error",
         apgHelper::mkMsg( m_fileName, msg, __LINE__) );
 
-        FixImgFromCamera( datafromCam, out, dataLen, numCols );
+        FixImgFromCamera( datafromCam, &(*out.begin()), dataLen, numCols );
         throw;
     }
         
@@ -123,15 +132,6 @@ void HiC::Get4kby4kImage( std::vector<uint16_t> & out )
         m_ImageInProgress = false;
     }
     
-    // at a minimum removing the AD garbage pixels at the end of every row
-    const uint16_t HIC_ROWS = 4096;
-    const uint16_t HIC_COLS = 4096;
-    if( HIC_ROWS*HIC_COLS != out.size() )
-    {
-        out.clear();
-        out.resize( HIC_ROWS*HIC_COLS );
-    }
-
     // first see if the buffer from the camera is a good size
     // and the number of columns is good.  if either of these conditions
     // fail then just get as much data out as you can and then throw
@@ -167,14 +167,14 @@ void HiC::Get4kby4kImage( std::vector<uint16_t> & out )
     const int32_t OUTPUT_OFFSET =  
     ( (m_CamCfgData->m_MetaData.ImagingRows - r) / 2 ) * numCols;
 
-    ImgFix::QuadOuputCopy( datafromCam, out, dataLen, 
+    ImgFix::QuadOuputCopy( datafromCam, &(*out.begin()), dataLen, 
         numCols, LATENCY_PIXELS, OUTPUT_OFFSET );
 
     if( IsPixelReorderOn() )
     {
         std::vector<uint16_t> temp = out;
         //already removed latency pixels above
-        ImgFix::QuadOuputFix( temp, out, dataLen, numCols, 0 );
+        ImgFix::QuadOuputFix( temp, &(*out.begin()), dataLen, numCols, 0 );
     }
    
    ApgLogger::Instance().Write(ApgLogger::LEVEL_DEBUG,"info","Get Image Completed.");
@@ -12,6 +12,131 @@
 #include "ImgFix.h" 
 #include <algorithm>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define IMGFIX_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define IMGFIX_NEON
+#endif
+
+//////////////////////////// 
+// LOCAL     NAMESPACE
+namespace
+{
+#if defined(IMGFIX_SSE2)
+    // reverses the order of the 8 pixels in v
+    inline __m128i Reverse8( __m128i v )
+    {
+        v = _mm_shufflelo_epi16( v, _MM_SHUFFLE(0,1,2,3) );
+        v = _mm_shufflehi_epi16( v, _MM_SHUFFLE(0,1,2,3) );
+        return _mm_shuffle_epi32( v, _MM_SHUFFLE(1,0,3,2) );
+    }
+
+    // splits the 16 pixels in a and b into the even and the odd ones
+    inline void Deinterleave( __m128i a, __m128i b, __m128i & even, __m128i & odd )
+    {
+        // sse2 only has a signed saturating pack, so shift the pixels
+        // into the signed range and back to keep every value intact
+        const __m128i bias = _mm_set1_epi16( static_cast<short>(0x8000) );
+        a = _mm_xor_si128( a, bias );
+        b = _mm_xor_si128( b, bias );
+
+        even = _mm_packs_epi32( _mm_srai_epi32( _mm_slli_epi32( a, 16 ), 16 ),
+                                _mm_srai_epi32( _mm_slli_epi32( b, 16 ), 16 ) );
+        odd = _mm_packs_epi32( _mm_srai_epi32( a, 16 ), _mm_srai_epi32( b, 16 ) );
+
+        even = _mm_xor_si128( even, bias );
+        odd = _mm_xor_si128( odd, bias );
+    }
+#elif defined(IMGFIX_NEON)
+    inline uint16x8_t Reverse8( uint16x8_t v )
+    {
+        v = vrev64q_u16( v );
+        return vcombine_u16( vget_high_u16( v ), vget_low_u16( v ) );
+    }
+#endif
+
+    ////////////////////////////
+    //      DUAL       ROW
+    // the two outputs are interleaved, the right one reads out mirrored
+    void DualRow( const uint16_t * in, uint16_t * left, uint16_t * right, const int32_t halfCols )
+    {
+        int32_t c = 0;
+
+#if defined(IMGFIX_SSE2)
+        for( ; c + 8 <= halfCols; c += 8 )
+        {
+            __m128i ur, ul;
+            Deinterleave( _mm_loadu_si128( reinterpret_cast<const __m128i *>(in + 2*c) ),
+                          _mm_loadu_si128( reinterpret_cast<const __m128i *>(in + 2*c + 8) ), ur, ul );
+
+            _mm_storeu_si128( reinterpret_cast<__m128i *>(left + c), ul );
+            _mm_storeu_si128( reinterpret_cast<__m128i *>(right - c - 7), Reverse8( ur ) );
+        }
+#elif defined(IMGFIX_NEON)
+        for( ; c + 8 <= halfCols; c += 8 )
+        {
+            uint16x8x2_t px = vld2q_u16( in + 2*c );
+            vst1q_u16( left + c, px.val[1] );
+            vst1q_u16( right - c - 7, Reverse8( px.val[0] ) );
+        }
+#endif
+
+        for( ; c < halfCols; ++c )
+        {
+            right[-c] = in[2*c];
+            left[c] = in[2*c + 1];
+        }
+    }
+
+    ////////////////////////////
+    //      QUAD       ROWS
+    // one pixel from each quadrant in turn: upper left, upper right,
+    // lower right, lower left, with the right hand outputs mirrored
+    void QuadRows( const uint16_t * in, uint16_t * ul, uint16_t * ur,
+        uint16_t * lr, uint16_t * ll, const int32_t halfCols )
+    {
+        int32_t c = 0;
+
+#if defined(IMGFIX_SSE2)
+        for( ; c + 8 <= halfCols; c += 8 )
+        {
+            const __m128i * src = reinterpret_cast<const __m128i *>(in + 4*c);
+            __m128i e0, o0, e1, o1, vul, vur, vlr, vll;
+
+            // first pass pairs up (ul,lr) and (ur,ll), the second splits them
+            Deinterleave( _mm_loadu_si128( src ), _mm_loadu_si128( src + 1 ), e0, o0 );
+            Deinterleave( _mm_loadu_si128( src + 2 ), _mm_loadu_si128( src + 3 ), e1, o1 );
+            Deinterleave( e0, e1, vul, vlr );
+            Deinterleave( o0, o1, vur, vll );
+
+            _mm_storeu_si128( reinterpret_cast<__m128i *>(ul + c), vul );
+            _mm_storeu_si128( reinterpret_cast<__m128i *>(ur - c - 7), Reverse8( vur ) );
+            _mm_storeu_si128( reinterpret_cast<__m128i *>(lr - c - 7), Reverse8( vlr ) );
+            _mm_storeu_si128( reinterpret_cast<__m128i *>(ll + c), vll );
+        }
+#elif defined(IMGFIX_NEON)
+        for( ; c + 8 <= halfCols; c += 8 )
+        {
+            uint16x8x4_t px = vld4q_u16( in + 4*c );
+            vst1q_u16( ul + c, px.val[0] );
+            vst1q_u16( ur - c - 7, Reverse8( px.val[1] ) );
+            vst1q_u16( lr - c - 7, Reverse8( px.val[2] ) );
+            vst1q_u16( ll + c, px.val[3] );
+        }
+#endif
+
+        for( ; c < halfCols; ++c )
+        {
+            ul[c] = in[4*c];
+            ur[-c] = in[4*c + 1];
+            lr[-c] = in[4*c + 2];
+            ll[c] = in[4*c + 3];
+        }
+    }
+}
+
 //////////////////////////// 
 //      SINGLE       OUPUT       ERASE
 void ImgFix::SingleOuputErase( std::vector<uint16_t> & data, const int32_t rows,  
@@ -29,7 +154,7 @@ void ImgFix::SingleOuputErase( std::vector<uint16_t> & data, const int32_t rows,
 //////////////////////////// 
 //      SINGLE       OUPUT       COPY
 void ImgFix::SingleOuputCopy( const std::vector<uint16_t> & data, 
-      std::vector<uint16_t> & out, const int32_t rows,  const int32_t numImgCols,  
+      uint16_t * out, const int32_t rows,  const int32_t numImgCols,  
       const int32_t numLatencyPixels )
 {
 
@@ -41,8 +166,7 @@ void ImgFix::SingleOuputCopy( const std::vector<uint16_t> & data,
     {
         std::vector<uint16_t>::const_iterator start = data.begin()+actColsOffset;
         std::vector<uint16_t>::const_iterator end = start + numImgCols;
-        std::vector<uint16_t>::iterator outStart = out.begin() + outColsOffset;
-        std::copy( start, end, outStart );
+        std::copy( start, end, out + outColsOffset );
     }
 }
 
@@ -50,7 +174,7 @@ void ImgFix::SingleOuputCopy( const std::vector<uint16_t> & data,
 //////////////////////////// 
 //      QUAD      OUPUT       COPY
 void ImgFix::QuadOuputCopy( const std::vector<uint16_t> & data, 
-      std::vector<uint16_t> & out, const int32_t rows,  const int32_t cols,  
+      uint16_t * out, const int32_t rows,  const int32_t cols,  
       const int32_t numLatencyPixels, const int32_t outputBuffOffset )
 {
     int32_t numGood =  ( cols / 2 ) * 4;
@@ -67,8 +191,7 @@ void ImgFix::QuadOuputCopy( const std::vector<uint16_t> & data,
 
         std::vector<uint16_t>::const_iterator start = data.begin()+badStart;
         std::vector<uint16_t>::const_iterator end = start + len;
-        std::vector<uint16_t>::iterator outStart = out.begin() + outputBuffOffset + goodStart;
-        std::copy( start, end, outStart );
+        std::copy( start, end, out + outputBuffOffset + goodStart );
 
          goodStart += len;
          badStart += (len + numBad);
@@ -79,7 +202,7 @@ void ImgFix::QuadOuputCopy( const std::vector<uint16_t> & data,
 //////////////////////////// 
 //      QUAD       OUPUT       FIX
 void ImgFix::QuadOuputFix( const std::vector<uint16_t> & data, 
-                                             std::vector<uint16_t> & out,
+                                             uint16_t * out,
                                              const int32_t rows,  const int32_t cols,
                                              const int32_t numLatencyPixels)
 {
@@ -93,25 +216,11 @@ void ImgFix::QuadOuputFix( const std::vector<uint16_t> & data,
         int32_t topOffset = cols*r;
         int32_t bottomOffset = (cols*(rows-(r+1)));
 
-        for( int32_t c=0; c < HALF_COLS; ++c)
-        {
-            int32_t ul = topOffset + c;
-            out[ul] = data[index];
-
-            int32_t ur =  topOffset + (cols-(c+1) );
-            ++index;
-            out[ur] = data[index];
-            
-            int32_t lr = bottomOffset + (cols-(c+1) );
-            ++index;
-            out[lr] = data[index];
-
-            int32_t ll = bottomOffset+c;
-            ++index;
-            out[ll] = data[index];
-
-            ++index;
-        }
+        // each row of input fills the same row pair from both ends
+        QuadRows( &data[index], out + topOffset, out + topOffset + cols - 1,
+            out + bottomOffset + cols - 1, out + bottomOffset, HALF_COLS );
+
+        index += HALF_COLS*4;
 
         //skip the latency pixels
         index += numLatencyPixels*2;
@@ -121,7 +230,7 @@ void ImgFix::QuadOuputFix( const std::vector<uint16_t> & data,
 //////////////////////////// 
 //      DUAL       OUPUT       FIX
 void ImgFix::DualOuputFix( const std::vector<uint16_t> & data, 
-                                             std::vector<uint16_t> & out,
+                                             uint16_t * out,
                                              const int32_t rows,  const int32_t cols,
                                              const int32_t numLatencyPixels)
 {
@@ -138,20 +247,46 @@ void ImgFix::DualOuputFix( const std::vector<uint16_t> & data,
     {
         int32_t topOffset = cols*r;
 
-        for( int32_t c=0; c < HALF_COLS; ++c)
-        {
-            // skip odd col if need with oddAdjust
-            int32_t ur =  topOffset + (START_UR_COL-(c+1) ) - oddAdjust;
-            out[ur] = data[index];
-
-           int32_t ul = topOffset + c;
-            ++index;
-            out[ul] = data[index];
-            
-            ++index;
-        }
+        // skip odd col if need with oddAdjust
+        DualRow( &data[index], out + topOffset,
+            out + topOffset + (START_UR_COL-1) - oddAdjust, HALF_COLS );
+
+        index += HALF_COLS*2;
 
         //skip the latency pixels
         index += numLatencyPixels;
     }
 }
+
+//////////////////////////// 
+//      BIG     ENDIAN     TO      HOST
+void ImgFix::BigEndianToHost( uint16_t * data, const size_t count )
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    // already in host order
+    (void) data;
+    (void) count;
+#else
+    size_t i = 0;
+
+#if defined(IMGFIX_SSE2)
+    for( ; i + 8 <= count; i += 8 )
+    {
+        __m128i * p = reinterpret_cast<__m128i *>(data + i);
+        const __m128i v = _mm_loadu_si128( p );
+        _mm_storeu_si128( p, _mm_or_si128( _mm_slli_epi16( v, 8 ), _mm_srli_epi16( v, 8 ) ) );
+    }
+#elif defined(IMGFIX_NEON)
+    for( ; i + 8 <= count; i += 8 )
+    {
+        const uint8x16_t v = vreinterpretq_u8_u16( vld1q_u16( data + i ) );
+        vst1q_u16( data + i, vreinterpretq_u16_u8( vrev16q_u8( v ) ) );
+    }
+#endif
+
+    for( ; i < count; ++i )
+    {
+        data[i] = static_cast<uint16_t>( (data[i] >> 8) | (data[i] << 8) );
+    }
+#endif
+}
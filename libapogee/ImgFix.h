@@ -14,6 +14,7 @@
 #define IMGFIX_INCLUDE_H__ 
 
 #include <vector>
+#include <cstddef>
 #include "stdint.h"
 
 namespace ImgFix 
@@ -22,22 +23,25 @@ namespace ImgFix
         int32_t numImgCols,  int32_t numLatencyPixels );
 
     void SingleOuputCopy( const std::vector<uint16_t> & data,   
-        std::vector<uint16_t> & out, int32_t rows, int32_t numImgCols,  
+        uint16_t * out, int32_t rows, int32_t numImgCols,  
         int32_t numLatencyPixels );
 
     void QuadOuputCopy( const std::vector<uint16_t> & data, 
-        std::vector<uint16_t> & out, int32_t rows,  
+        uint16_t * out, int32_t rows,  
         int32_t cols,  int32_t numLatencyPixels, int32_t outputBuffOffset=0 );
 
     void QuadOuputFix( const std::vector<uint16_t> & data, 
-                                     std::vector<uint16_t> & out,
+                                     uint16_t * out,
                                      const int32_t rows,  const int32_t cols,
                                      const int32_t numLatencyPixels );
 
     void DualOuputFix( const std::vector<uint16_t> & data, 
-                                     std::vector<uint16_t> & out,
+                                     uint16_t * out,
                                      const int32_t rows,  const int32_t cols,
                                      const int32_t numLatencyPixels );
+
+    // in place conversion of big endian pixels from the camera to host order
+    void BigEndianToHost( uint16_t * data, size_t count );
 }; 
 
 #endif
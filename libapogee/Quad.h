@@ -52,7 +52,7 @@ class DLL_EXPORT Quad: public CamGen2Base
              const std::string & DeviceAddr);
         
         void FixImgFromCamera( const std::vector<uint16_t> & data,
-            std::vector<uint16_t> & out,  int32_t rows, int32_t cols );
+            uint16_t * out,  int32_t rows, int32_t cols );
 
         void CreateCamIo(const std::string & ioType,
             const std::string & DeviceAddr);
@@ -11,6 +11,7 @@
 
 #include "libCurlWrap.h" 
 #include <stdexcept>
+#include <cstring>
 
 #include "apgHelper.h" 
 
@@ -44,11 +45,40 @@ static int32_t strWriter(char *data, size_t size, size_t nmemb,
     return apgHelper::SizeT2Int32( numBytes );
 }
 
+//////////////////////////// 
+// BUFFER WRITER
+struct BufferWrite
+{
+    uint8_t * data;
+    size_t size;
+    size_t received;
+};
+
+static size_t bufferWriter(char *data, size_t size, size_t nmemb,
+                  BufferWrite *buffer)
+{
+    const size_t numBytes = size * nmemb;
+
+    // keep the transfer going on overflow so the caller can report the
+    // actual size, only copy what fits
+    if( buffer->received < buffer->size )
+    {
+        const size_t avail = buffer->size - buffer->received;
+        memcpy( buffer->data + buffer->received, data, numBytes < avail ? numBytes : avail );
+    }
+    buffer->received += numBytes;
+
+    return numBytes;
+}
+
 //////////////////////////// 
 // LOCAL     NAMESPACE
 namespace
 {
     const long OPERATION_TIMEOUT = (60*1);  //60 seconds * the number of minutes
+    // larger socket reads for image downloads, fewer writer calls
+    const long IMAGE_BUFFER_SIZE = 512*1024;
+    const long DEFAULT_BUFFER_SIZE = CURL_MAX_WRITE_SIZE;
 }
 
 //////////////////////////// 
@@ -93,6 +123,35 @@ void CLibCurlWrap::HttpGet(const std::string & url,
     ExecuteVect( result );
 }
 
+//////////////////////////// 
+// HTTP GET 
+void CLibCurlWrap::HttpGet(const std::string & url,
+            uint8_t * buffer, const size_t size, size_t & received)
+{
+    BufferWrite writer = { buffer, size, 0 };
+
+    curl_easy_setopt(m_curlHandle, CURLOPT_ERRORBUFFER, errorBuffer);  
+    curl_easy_setopt(m_curlHandle, CURLOPT_URL, url.c_str());  
+    curl_easy_setopt(m_curlHandle, CURLOPT_WRITEFUNCTION, bufferWriter);  
+    curl_easy_setopt(m_curlHandle, CURLOPT_WRITEDATA, &writer); 
+    curl_easy_setopt(m_curlHandle, CURLOPT_TIMEOUT, m_timeout);
+    curl_easy_setopt(m_curlHandle, CURLOPT_BUFFERSIZE, IMAGE_BUFFER_SIZE);
+
+    const CURLcode returnCode = curl_easy_perform(m_curlHandle);
+
+    // the handle is reused for small requests
+    curl_easy_setopt(m_curlHandle, CURLOPT_BUFFERSIZE, DEFAULT_BUFFER_SIZE);
+    received = writer.received;
+
+    if( CURLE_OK != returnCode )
+    {
+        std::string curlError( errorBuffer );
+
+        apgHelper::throwRuntimeException( m_fileName, curlError, 
+            __LINE__, Apg::ErrorType_Critical );
+    }
+}
+
 //////////////////////////// 
 // HTTP POST 
 void CLibCurlWrap::HttpPost(const std::string & url,
@@ -30,6 +30,11 @@ class CLibCurlWrap
         void HttpGet(const std::string & url,
             std::vector<uint8_t> & result);
 
+        // receives the response straight into buffer, received is the
+        // size of the whole response even if it did not fit
+        void HttpGet(const std::string & url,
+            uint8_t * buffer, size_t size, size_t & received);
+
         void HttpPost(const std::string & url,
             const std::string & postFields, 
             std::string & result);
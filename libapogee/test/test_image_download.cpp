@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "ImgFix.h"
+#include "libCurlWrap.h"
+
+namespace
+{
+
+/**
+ * Stands in for the camera's image server: answers every request on 127.0.0.1
+ * with the same body, one request per connection.
+ */
+class ImageServer
+{
+public:
+    explicit ImageServer(const std::vector<uint8_t> &body) : m_body(body)
+    {
+        m_listen = socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(m_listen, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(m_listen, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+        listen(m_listen, 4);
+
+        socklen_t len = sizeof(addr);
+        getsockname(m_listen, reinterpret_cast<sockaddr *>(&addr), &len);
+        m_port = ntohs(addr.sin_port);
+
+        m_running = true;
+        m_thread = std::thread(&ImageServer::serve, this);
+    }
+
+    ~ImageServer()
+    {
+        m_running = false;
+        m_thread.join();
+        close(m_listen);
+    }
+
+    std::string url() const
+    {
+        return "http://127.0.0.1:" + std::to_string(m_port) + "/camimage";
+    }
+
+private:
+    void serve()
+    {
+        while (m_running)
+        {
+            pollfd pfd { m_listen, POLLIN, 0 };
+            if (poll(&pfd, 1, 50) <= 0)
+                continue;
+            int fd = accept(m_listen, nullptr, nullptr);
+            if (fd < 0)
+                continue;
+
+            std::string request;
+            char buffer[1024];
+            while (request.find("\r\n\r\n") == std::string::npos)
+            {
+                ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+                if (n <= 0)
+                    break;
+                request.append(buffer, n);
+            }
+
+            std::string headers = "HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\nContent-Length: " +
+                                  std::to_string(m_body.size()) + "\r\nConnection: close\r\n\r\n";
+            sendAll(fd, headers.data(), headers.size());
+            sendAll(fd, m_body.data(), m_body.size());
+            close(fd);
+        }
+    }
+
+    static void sendAll(int fd, const void *data, size_t len)
+    {
+        const uint8_t *p = static_cast<const uint8_t *>(data);
+        while (len > 0)
+        {
+            ssize_t n = send(fd, p, len, MSG_NOSIGNAL);
+            if (n <= 0)
+                return;
+            p += n;
+            len -= n;
+        }
+    }
+
+    std::vector<uint8_t> m_body;
+    int m_listen {-1};
+    int m_port {0};
+    std::atomic<bool> m_running {false};
+    std::thread m_thread;
+};
+
+// A recorded frame as the camera sends it: 16 bit pixels, big endian
+std::vector<uint8_t> bigEndianFrame(const std::vector<uint16_t> &pixels)
+{
+    std::vector<uint8_t> frame(pixels.size() * 2);
+    for (size_t i = 0; i < pixels.size(); i++)
+    {
+        frame[2 * i] = pixels[i] >> 8;
+        frame[2 * i + 1] = pixels[i] & 0xff;
+    }
+    return frame;
+}
+
+std::vector<uint16_t> randomPixels(size_t count)
+{
+    std::vector<uint16_t> pixels(count);
+    for (auto &pixel : pixels)
+        pixel = static_cast<uint16_t>(rand());
+    return pixels;
+}
+
+// The per pixel re-ordering the vectorized fix-ups replaced, kept as the reference
+void referenceQuadFix(const std::vector<uint16_t> &data, std::vector<uint16_t> &out, int32_t rows, int32_t cols,
+                      int32_t numLatencyPixels)
+{
+    int32_t index = numLatencyPixels * 2;
+    for (int32_t r = 0; r < rows / 2; ++r)
+    {
+        int32_t topOffset = cols * r;
+        int32_t bottomOffset = cols * (rows - (r + 1));
+        for (int32_t c = 0; c < cols / 2; ++c)
+        {
+            out[topOffset + c] = data[index++];
+            out[topOffset + (cols - (c + 1))] = data[index++];
+            out[bottomOffset + (cols - (c + 1))] = data[index++];
+            out[bottomOffset + c] = data[index++];
+        }
+        index += numLatencyPixels * 2;
+    }
+}
+
+void referenceDualFix(const std::vector<uint16_t> &data, std::vector<uint16_t> &out, int32_t rows, int32_t cols,
+                      int32_t numLatencyPixels)
+{
+    const int32_t oddAdjust = (cols % 2) ? 1 : 0;
+    int32_t index = numLatencyPixels;
+    for (int32_t r = 0; r < rows; ++r)
+    {
+        int32_t topOffset = cols * r;
+        for (int32_t c = 0; c < cols / 2; ++c)
+        {
+            out[topOffset + (cols - (c + 1)) - oddAdjust] = data[index++];
+            out[topOffset + c] = data[index++];
+        }
+        index += numLatencyPixels;
+    }
+}
+
+}
+
+TEST(ImageDownload, ReceivesFrameInPlace)
+{
+    std::vector<uint16_t> pixels = randomPixels(1000 * 1000);
+    ImageServer server(bigEndianFrame(pixels));
+
+    std::vector<uint16_t> image(pixels.size());
+    size_t received = 0;
+    CLibCurlWrap curl;
+    curl.HttpGet(server.url(), reinterpret_cast<uint8_t *>(image.data()), image.size() * 2, received);
+    ASSERT_EQ(received, pixels.size() * 2);
+
+    ImgFix::BigEndianToHost(image.data(), image.size());
+    EXPECT_EQ(image, pixels);
+}
+
+TEST(ImageDownload, ReportsOversizedResponse)
+{
+    std::vector<uint16_t> pixels = randomPixels(4096);
+    ImageServer server(bigEndianFrame(pixels));
+
+    // Room for half the frame, the guard words after it must stay untouched
+    const size_t fits = pixels.size() / 2;
+    std::vector<uint16_t> image(fits + 16, 0x5a5a);
+    size_t received = 0;
+    CLibCurlWrap curl;
+    curl.HttpGet(server.url(), reinterpret_cast<uint8_t *>(image.data()), fits * 2, received);
+    EXPECT_EQ(received, pixels.size() * 2);
+
+    for (size_t i = fits; i < image.size(); i++)
+        ASSERT_EQ(image[i], 0x5a5a) << "overflow at " << i;
+
+    ImgFix::BigEndianToHost(image.data(), fits);
+    for (size_t i = 0; i < fits; i++)
+        ASSERT_EQ(image[i], pixels[i]) << "pixel " << i;
+}
+
+TEST(ImgFix, BigEndianToHostSwapsEveryPixel)
+{
+    for (size_t count : { 0, 1, 7, 8, 9, 31, 1000 })
+    {
+        std::vector<uint16_t> pixels = randomPixels(count);
+        std::vector<uint8_t> frame = bigEndianFrame(pixels);
+        std::vector<uint16_t> image(count);
+        memcpy(image.data(), frame.data(), frame.size());
+        ImgFix::BigEndianToHost(image.data(), count);
+        EXPECT_EQ(image, pixels) << count << " pixels";
+    }
+}
+
+TEST(ImgFix, DualOutputFixMatchesReference)
+{
+    srand(1);
+    for (int trial = 0; trial < 200; trial++)
+    {
+        int32_t rows = 1 + rand() % 40, cols = 1 + rand() % 70, latency = rand() % 9;
+        std::vector<uint16_t> data = randomPixels(rows * (cols + latency) + latency + 16);
+
+        std::vector<uint16_t> expected(rows * cols, 7), actual(rows * cols, 7);
+        referenceDualFix(data, expected, rows, cols, latency);
+        ImgFix::DualOuputFix(data, actual.data(), rows, cols, latency);
+        ASSERT_EQ(actual, expected) << rows << "x" << cols << " latency " << latency;
+    }
+}
+
+TEST(ImgFix, QuadOutputFixMatchesReference)
+{
+    srand(2);
+    for (int trial = 0; trial < 200; trial++)
+    {
+        int32_t rows = 2 * (1 + rand() % 20), cols = 1 + rand() % 70, latency = rand() % 9;
+        std::vector<uint16_t> data = randomPixels(rows / 2 * (2 * cols + 4 * latency) + 4 * latency + 32);
+
+        std::vector<uint16_t> expected(rows * cols, 7), actual(rows * cols, 7);
+        referenceQuadFix(data, expected, rows, cols, latency);
+        ImgFix::QuadOuputFix(data, actual.data(), rows, cols, latency);
+        ASSERT_EQ(actual, expected) << rows << "x" << cols << " latency " << latency;
+    }
+}
@@ -1814,6 +1814,162 @@ long fli_camera_usb_start_video_mode(flidev_t dev)
 //	return 0;
 //}
 
+/* Rows requested per FLI_USBCAM_SENDROW by fli_camera_usb_grab_frame(), same
+ * limit as the row batches of fli_camera_usb_grab_row() */
+#define GRAB_FRAME_BATCH_ROWS (64)
+
+/* Reads and discards what is left of a SENDROW reply after a short or failed
+ * read, otherwise the next command would get pixels as its reply */
+static void fli_camera_usb_drain_rows(flidev_t dev, long bytes)
+{
+	flicamdata_t *cam = DEVICE->device_data;
+
+	while (bytes > 0)
+	{
+		long rlen = MIN(bytes, (long) cam->gbuf_siz);
+
+		if ((usb_bulktransfer(dev, 0x82, cam->gbuf, &rlen) != 0) || (rlen <= 0))
+		{
+			debug(FLIDEBUG_WARN, "Could not drain %d bytes of row data.", bytes);
+			break;
+		}
+		bytes -= rlen;
+	}
+}
+
+long fli_camera_usb_grab_frame(flidev_t dev, void *buff, size_t size, size_t *grabbed)
+{
+  flicamdata_t *cam = DEVICE->device_data;
+	long width = cam->image_area.lr.x - cam->image_area.ul.x;
+	long rowsleft, rows, r;
+	unsigned short *row = (unsigned short *) buff;
+
+	*grabbed = 0;
+
+	if (width <= 0)
+		return -EINVAL;
+
+	if (cam->gbuf == NULL)
+		return -ENOMEM;
+
+	switch (DEVICE->devinfo.devid)
+	{
+		case FLIUSB_CAM_ID:
+			rowsleft = cam->grabrowcounttot - cam->grabrowindex;
+			break;
+
+		case FLIUSB_PROLINE_ID:
+			rowsleft = cam->grabrowcount - cam->grabrowindex;
+			break;
+
+		default:
+			return -EINVAL;
+	}
+
+	if (rowsleft <= 0)
+		return 0;
+
+	rows = MIN(rowsleft, (long) (size / (width * sizeof(unsigned short))));
+	if (rows <= 0)
+	{
+		debug(FLIDEBUG_FAIL, "Buffer not large enough to receive a row.");
+		return -ENOMEM;
+	}
+
+	debug(FLIDEBUG_INFO, "Grab Frame, %d of %d rows of width %d.", rows, rowsleft, width);
+
+	if ((DEVICE->devinfo.devid == FLIUSB_CAM_ID) && (cam->grabrowwidth == width))
+	{
+		/* Rows still held from a previous FLIGrabRow() batch come first */
+		while ((rows > 0) && (cam->grabrowbufferindex < cam->grabrowbatchsize))
+		{
+			if ((r = fli_camera_usb_grab_row(dev, row, width)))
+				return r;
+			row += width;
+			rows--;
+		}
+
+		if ((rows > 0) && (cam->flushcountbeforefirstrow > 0))
+		{
+			debug(FLIDEBUG_INFO, "Flushing %d rows before image download.", cam->flushcountbeforefirstrow);
+			if ((r = fli_camera_usb_flush_rows(dev, cam->flushcountbeforefirstrow, 1)))
+				return r;
+
+			cam->flushcountbeforefirstrow = 0;
+		}
+
+		/* Read whole batches straight into the caller's buffer, the
+		 * request is built in gbuf since a narrow batch may not hold its six bytes */
+		while (rows > 0)
+		{
+			long batch = MIN(rows, GRAB_FRAME_BATCH_ROWS);
+			long rlen = 0, wlen = 6, expected = width * 2 * batch, x;
+
+			cam->gbuf[0] = htons(FLI_USBCAM_SENDROW);
+			cam->gbuf[1] = htons((unsigned short) width);
+			cam->gbuf[2] = htons((unsigned short) batch);
+			IO(dev, cam->gbuf, &wlen, &rlen);
+
+			rlen = expected;
+			if ((usb_bulktransfer(dev, 0x82, row, &rlen) != 0) || (rlen != expected))
+			{
+				debug(FLIDEBUG_FAIL, "Short read, %d of %d bytes.", rlen, expected);
+				fli_camera_usb_drain_rows(dev, (rlen > 0) ? expected - rlen : expected);
+				return -EIO;
+			}
+
+			if ((DEVICE->devinfo.hwrev & 0xff00) == 0x0100)
+			{
+				for (x = 0; x < width * batch; x++)
+					row[x] = ntohs(row[x]) + 32768;
+			}
+			else
+			{
+				for (x = 0; x < width * batch; x++)
+					row[x] = ntohs(row[x]);
+			}
+
+			row += width * batch;
+			rows -= batch;
+			cam->grabrowindex += batch;
+
+			if (cam->grabrowcount > 0)
+			{
+				cam->grabrowcount -= batch;
+				if (cam->grabrowcount <= 0)
+				{
+					cam->grabrowcount = 0;
+					if (cam->flushcountafterlastrow > 0)
+					{
+						debug(FLIDEBUG_INFO, "Flushing %d rows after image download.", cam->flushcountafterlastrow);
+						if ((r = fli_camera_usb_flush_rows(dev, cam->flushcountafterlastrow, 1)))
+							return r;
+					}
+
+					cam->flushcountafterlastrow = 0;
+					cam->grabrowbatchsize = 1;
+					cam->grabrowbufferindex = 1;
+				}
+			}
+		}
+	}
+	else
+	{
+		/* Proline/Microline data is already streamed in max_usb_xfer blocks
+		 * and reassembled per row, hand the rows out directly */
+		while (rows > 0)
+		{
+			if ((r = fli_camera_usb_grab_row(dev, row, width)))
+				return r;
+			row += width;
+			rows--;
+		}
+	}
+
+	*grabbed = (row - (unsigned short *) buff) * sizeof(unsigned short);
+	return 0;
+}
+
 long fli_camera_usb_grab_video_frame(flidev_t dev, void *buff, size_t size)
 {
   flicamdata_t *cam = DEVICE->device_data;
@@ -717,6 +717,31 @@ long fli_camera_command(flidev_t dev, int cmd, int argc, ...)
 			}
 			break;
 
+		case FLI_GRAB_FRAME:
+			if (argc != 3)
+				r = -EINVAL;
+			else
+			{
+				void *buf;
+				size_t size;
+				size_t *grabbed;
+
+				buf = va_arg(ap, void *);
+				size = *va_arg(ap, size_t *);
+				grabbed = va_arg(ap, size_t *);
+
+				switch (DEVICE->domain)
+				{
+					case FLIDOMAIN_USB:
+						r = fli_camera_usb_grab_frame(dev, buf, size, grabbed);
+						break;
+
+					default:
+						r = -EINVAL;
+				}
+			}
+			break;
+
 		case FLI_GRAB_VIDEO_FRAME:
 			if (argc != 2)
 				r = -EINVAL;
@@ -225,14 +225,40 @@ LIBFLIAPI FLIUsbBulkIO(flidev_t dev, int ep, void *buf, long *len)
 	return usb_bulktransfer(dev, ep, buf, len);
 }
 
+/**
+   Grab image rows from a camera in as few transfers as possible.  This
+   function grabs as many whole rows of the current image as fit in
+   \texttt{buffsize} bytes, starting with the next row not yet grabbed,
+   and stores them contiguously in \texttt{buff}.  A buffer large enough
+   for the image grabs the whole frame at once.  With a smaller buffer
+   the function can be called repeatedly to download the image in parts,
+   e.g. to report progress, until \texttt{bytesgrabbed} is zero.  It can
+   be mixed with FLIGrabRow.
+
+   @param dev Camera whose image to grab.
+
+   @param buff Buffer to place the rows in.
+
+   @param buffsize Size of \texttt{buff} in bytes.
+
+   @param bytesgrabbed Receives the number of bytes stored in \texttt{buff}.
+
+   @return Zero on success.
+   @return Non-zero on failure, -EINVAL if the camera does not support it.
+
+   @see FLIGrabRow
+   @see FLIExposeFrame
+*/
 LIBFLIAPI FLIGrabFrame(flidev_t dev, void* buff,
 		       size_t buffsize, size_t* bytesgrabbed)
 {
-  INDI_UNUSED(dev);
-  INDI_UNUSED(buff);
-  INDI_UNUSED(buffsize);
-  INDI_UNUSED(bytesgrabbed);
-	return -EINVAL;
+  CHKDEVICE(dev);
+
+  if (bytesgrabbed == NULL)
+    return -EINVAL;
+
+  *bytesgrabbed = 0;
+  return DEVICE->fli_command(dev, FLI_GRAB_FRAME, 3, buff, &buffsize, bytesgrabbed);
 }
 
 /**
@@ -1913,4 +1939,4 @@ LIBFLIAPI FLIWriteUserEEPROM(flidev_t dev, long loc, long address, long length,
 	r = DEVICE->fli_command(dev, FLI_WRITE_EEPROM, 4, &loc, &address, &length, wbuf);
 
 	return r;
-}
\ No newline at end of file
+}
\ No newline at end of file